@@ -41,6 +41,18 @@
 #include "src/rules/rules.h"
 
 #include "webfunctions.h"
+#include "mqttqueue.h"
+#include "pollscheduler.h"
+#include "serialframer.h"
+#include "proxy.h"
+#include "uartrx.h"
+#include "busmetrics.h"
+#include "recorder.h"
+#include "history.h"
+#include "persist.h"
+#include "settingsstore.h"
+#include "bootprofile.h"
+#include "ottrace.h"
 #include "decode.h"
 #include "commands.h"
 #include "rules.h"
@@ -61,8 +73,8 @@ settingsStruct heishamonSettings;
 
 uint32_t neoPixelState = 0; //running neoPixelState
 bool inSetup; //bool to check if still booting
+bool bootDeferPending = false; //a fast boot left the 1wire scan, rules and ntp for after the first read
 volatile bool sending = false; // mutex for sending data
-bool mqttcallbackinprogress = false; // mutex for processing mqtt callback
 
 bool extraDataBlockAvailable = false; // this will be set to true if, during boot, heishamon detects this heatpump has extra data block (like K and L series do)
 
@@ -79,7 +91,6 @@ unsigned long lastRunTime = 0;
 
 #ifdef ESP8266
 unsigned long lastOptionalPCBRunTime = 0;
-unsigned long lastOptionalPCBSave = 0;
 #endif
 volatile unsigned long sendCommandReadTime = 0; //set to millis value during send, allow to wait millis for answer
 
@@ -95,18 +106,18 @@ static int uploadpercentage = 0;
 
 // instead of passing array pointers between functions we just define this in the global scope
 #define MAXDATASIZE 255
-char data[MAXDATASIZE] = { '\0' };
-byte data_length = 0;
+serialFramerStruct heatpumpFramer;
+unsigned long frameStartTime = 0; //arrival of the first byte of the frame being parsed
 
 #ifdef ESP32
 //for received proxied data
-char proxydata[MAXDATASIZE] = { '\0' };
-byte proxydata_length = 0;
+serialFramerStruct proxyFramer;
 //for the neopixel
 Adafruit_NeoPixel pixels(1, LEDPIN);
 //for the vTask
 QueueHandle_t pcbQueue = NULL;
 QueueHandle_t cmdQueue = NULL;
+QueueHandle_t proxyQueue = NULL; //frames of the CZ-TAW1 for the heatpump
 QueueHandle_t logQueue = NULL;
 #endif
 
@@ -114,6 +125,8 @@ QueueHandle_t logQueue = NULL;
 char actData[DATASIZE] = { '\0' };
 char actDataExtra[DATASIZE] = { '\0' };
 char actOptData[OPTDATASIZE]  = { '\0' };
+unsigned long actDataTime = 0; //millis of the last received main block
+unsigned long actDataExtraTime = 0;
 
 // log message to sprintf to
 #define LOG_MSG_SIZE 256
@@ -132,10 +145,16 @@ unsigned long dallasMqttRestoreStart = 0;
 // can't have too much in buffer due to memory shortage
 #define MAXCOMMANDSINBUFFER 10
 
+#define MQTT_BUFFER_SIZE 1024 // PubSubClient buffer, the header, topic and payload of one message
+#define STATS_PAYLOAD_SIZE 512 // of the stats and of each group on its own stats topic
+#define STATS_VALUE_LEN 11 // longest printed value, an unsigned long or a float with 2 decimals
+static_assert(5 + 2 + sizeof(heishamonSettings.mqtt_topic_base) + sizeof("/stats/recorder") + STATS_PAYLOAD_SIZE <= MQTT_BUFFER_SIZE, "a stats message does not fit in the MQTT buffer");
+
 // buffer for commands to send
 struct cmdbuffer_t {
   uint8_t length;
   byte data[128];
+  unsigned long queued; // millis when the command was queued
 } cmdbuffer[MAXCOMMANDSINBUFFER];
 
 static uint8_t cmdstart = 0;
@@ -249,6 +268,7 @@ void check_wifi() {
 
     if (firstConnectSinceBoot) {  // this should start only when softap is down or else it will not work properly so run after the routine to disable softap
       firstConnectSinceBoot = false;
+      bootMark(BOOT_NETWORK);
       lastMqttReconnectAttempt = 0;  //initiate mqtt connection asap
       setupOTA();
       MDNS.begin(heishamonSettings.wifi_hostname);
@@ -259,9 +279,7 @@ void check_wifi() {
         log_message(_F("WiFi connected without SSID and password in settings. Must come from persistent memory. Storing in settings."));
         WiFi.SSID().toCharArray(heishamonSettings.wifi_ssid, 40);
         WiFi.psk().toCharArray(heishamonSettings.wifi_password, 40);
-        JsonDocument jsonDoc;
-        settingsToJson(jsonDoc, &heishamonSettings);  //stores current settings in a json document
-        saveJsonToFile(jsonDoc, "config.json");     //save to config file
+        settingsSave(&heishamonSettings);
       }
 
       ntpReload(&heishamonSettings);
@@ -315,6 +333,7 @@ void check_wifi() {
 
     if (firstConnectSinceBoot) {
       firstConnectSinceBoot = false;
+      bootMark(BOOT_NETWORK);
 
       lastMqttReconnectAttempt = 0;
       setupOTA();
@@ -326,9 +345,7 @@ void check_wifi() {
         log_message(_F("Storing WiFi credentials from persistent memory"));
         WiFi.SSID().toCharArray(heishamonSettings.wifi_ssid, 40);
         WiFi.psk().toCharArray(heishamonSettings.wifi_password, 40);
-        JsonDocument jsonDoc;
-        settingsToJson(jsonDoc, &heishamonSettings);
-        saveJsonToFile(jsonDoc, "config.json");
+        settingsSave(&heishamonSettings);
       }
 
       ntpReload(&heishamonSettings);
@@ -471,6 +488,7 @@ void mqtt_reconnect()
     if (mqtt_client.connect(heishamonSettings.wifi_hostname, heishamonSettings.mqtt_username, heishamonSettings.mqtt_password, topic, 1, true, "Offline"))
     {
       mqttReconnects++;
+      bootMark(BOOT_MQTT);
       if (heishamonSettings.opentherm) {
         sprintf(topic, "%s/%s/#", heishamonSettings.mqtt_topic_base, mqtt_topic_opentherm_read);
         mqtt_client.subscribe(topic);
@@ -495,10 +513,11 @@ void mqtt_reconnect()
 #endif
 
       if (heishamonSettings.use_s0) { // connect to s0 topic to retrieve older watttotal from mqtt
-        sprintf_P(mqtt_topic, PSTR("%s/%s/WatthourTotal/1"), heishamonSettings.mqtt_topic_base, mqtt_topic_s0);
-        mqtt_client.subscribe(mqtt_topic);
-        sprintf_P(mqtt_topic, PSTR("%s/%s/WatthourTotal/2"), heishamonSettings.mqtt_topic_base, mqtt_topic_s0);
-        mqtt_client.subscribe(mqtt_topic);
+        for (int i = 1; i <= NUM_S0_COUNTERS; i++) {
+          if (!s0PortEnabled(i)) continue;
+          sprintf_P(mqtt_topic, PSTR("%s/%s/%s/%d"), heishamonSettings.mqtt_topic_base, mqtt_topic_s0, s0ValueName(i, S0_VALUE_TOTAL), i);
+          mqtt_client.subscribe(mqtt_topic);
+        }
       }
       if (heishamonSettings.use_1wire && mqttReconnects == 1) { // only on first connect: retrieve previously known 1wire sensors from their retained mqtt topics
         sprintf_P(mqtt_topic, PSTR("%s/%s/+"), heishamonSettings.mqtt_topic_base, mqtt_topic_1wire);
@@ -508,6 +527,7 @@ void mqtt_reconnect()
       }
       if (mqttReconnects == 1) { //only resend all data on first connect to mqtt so a data bomb like and bad mqtt server will not cause a reconnect bomb everytime
         if (heishamonSettings.use_1wire) resetlastalldatatime_dallas(); //resend all 1wire values to mqtt
+        resetlastalldatatime_gpio(); //resend all gpio input states to mqtt
         resetlastalldatatime(); //resend all heatpump values to mqtt
       }
       //use this to receive valid heishamon raw data from other heishamon to debug this OT code
@@ -569,14 +589,7 @@ void log_message(char* string)
     char log_topic[256];
     sprintf(log_topic, "%s/%s", heishamonSettings.mqtt_topic_base, mqtt_logtopic);
 
-    if (!mqtt_client.publish(log_topic, log_line)) {
-      if (heishamonSettings.logSerial1) {
-        loggingSerial.print(millis());
-        loggingSerial.print(F(": "));
-        loggingSerial.println(F("MQTT publish log message failed!"));
-      }
-      mqtt_client.disconnect();
-    }
+    mqttQueuePublish(log_topic, log_line, MQTT_QUEUE_LOW);
   }
   //send log message to websocket
   snprintf(log_line, len+12, "{\"logMsg\":\"%s (%lu): %s\"}", timestring, millis(), string);
@@ -606,7 +619,7 @@ void mqttPublish(char* topic, char* subtopic, char* value) {
 void mqttPublish(char* topic, char* subtopic, char* value, bool retain) {
   char mqtt_topic[256];
   sprintf_P(mqtt_topic, PSTR("%s/%s/%s"), heishamonSettings.mqtt_topic_base, topic, subtopic);
-  mqtt_client.publish(mqtt_topic, value, retain);
+  mqttQueuePublish(mqtt_topic, value, MQTT_QUEUE_COALESCE | (retain ? MQTT_QUEUE_RETAIN : 0));
 }
 
 
@@ -620,198 +633,199 @@ byte calcChecksum(byte* command, int length) {
   return chk;
 }
 
-bool isValidReceiveChecksum(char* check_data, byte check_length) {
-  byte chk = 0;
-  for ( int i = 0; i < check_length; i++)  {
-    chk += check_data[i];
+#ifdef ESP32
+// Queue a frame for the heatpump on behalf of the CZ-TAW1, false if it was not queued
+bool queueProxyFrame(byte *frame, int length) {
+  if (heishamonSettings.listenonly) {
+    log_message(_F("PROXY Not forwarding. Heishamon in listen only mode!"));
+    return false;
+  }
+  struct cmdbuffer_t cmd;
+  if (length > (int)sizeof(cmd.data)) {
+    log_message(_F("PROXY Frame too long to forward. Ignoring this one."));
+    return false;
+  }
+  cmd.length = length;
+  memcpy(&cmd.data, frame, length);
+  if (xQueueSend(proxyQueue, &cmd, 0) != pdTRUE) {
+    log_message(_F("PROXY Too many frames waiting for the heatpump. Ignoring this one."));
+    return false;
+  }
+  return true;
+}
+
+// Answer a data block read of the CZ-TAW1 from the cache, if there is data
+void writeProxyBlock(byte block) {
+  char *cached = (block == 0x21) ? actDataExtra : actData;
+  if ((cached[0] == 0x71) && (cached[1] == 0xc8) && (cached[2] == 0x01)) { //don't answer if we don't have data
+    proxySerial.write(cached, DATASIZE); //should contain valid checksum also
+  }
+}
+
+// Handle one complete frame with a valid checksum from the CZ-TAW1 on the proxy port
+void handleProxyFrame(char *proxydata, byte proxydata_length) {
+  sprintf_P(log_msg, PSTR("PROXY Received %i bytes"), proxydata_length); log_message(log_msg);
+  if (heishamonSettings.logHexdump) logHex(proxydata, proxydata_length);
+  log_message(_F("PROXY Checksum and header received ok!"));
+  if ((proxydata[0] == 0x71) && (proxydata_length == (PANASONICQUERYSIZE + 1)) && ((proxydata[3] == 0x10) || (proxydata[3] == 0x21))) { //data block read from cztaw on proxy port
+    byte block = proxydata[3];
+    unsigned long age = millis() - ((block == 0x21) ? actDataExtraTime : actDataTime);
+    switch (proxyRead(block, age)) {
+      case PROXY_READ_CACHED:
+        log_message(_F("PROXY requests data, answering from cache"));
+        writeProxyBlock(block);
+        break;
+      case PROXY_READ_WAIT:
+        log_message(_F("PROXY requests data, answering with the read in progress"));
+        break;
+      default: {
+        log_message(_F("PROXY requests data, reading it from heatpump"));
+        byte query[PANASONICQUERYSIZE]; //panasonicQuery is also used by the serial task
+        memcpy(query, panasonicQuery, PANASONICQUERYSIZE);
+        query[3] = block;
+        queueProxyFrame(query, PANASONICQUERYSIZE);
+      } break;
+    }
+  } else {
+    //write queries, startup messages and anything unknown go to the heatpump and its answer back
+    log_message(_F("PROXY forwarding message to heatpump"));
+    if (queueProxyFrame((byte *)proxydata, proxydata_length - 1)) { //strip CRC, will be calculated again when sent
+      proxyForward(); //the answer is relayed back, a polled read is answered by proxyRead() instead
+    }
   }
-  return (chk == 0); //all received bytes + checksum should result in 0
 }
 
-#ifdef ESP32
 void readProxy()
 {
   int proxylen = 0;
-  while ((proxySerial.available()) && ((proxydata_length + proxylen) < MAXDATASIZE)) {
-    proxydata[proxydata_length + proxylen] = proxySerial.read(); //read available data and place it after the last received data
-    proxylen++;
-    if ((proxydata[0] != 0x71) and  (proxydata[0] != 0x31) and  (proxydata[0] != 0xF1)) { //wrong header received!
-      log_message(_F("PROXY Received bad header. Ignoring this data!"));
-      if (heishamonSettings.logHexdump) logHex(proxydata, proxylen);
-      proxydata_length = 0;
-      return; //return so this while loop does not loop forever if there happens to be a continous invalid data stream
+  while (proxylen < MAXDATASIZE) {
+    byte result = serialFramerParse(&proxyFramer, SERIAL_FRAMER_WRITES);
+    if (result == SERIAL_FRAME_INCOMPLETE) {
+      if (!proxySerial.available()) {
+        break;
+      }
+      serialFramerPut(&proxyFramer, proxySerial.read());
+      proxylen++;
+    } else if (result == SERIAL_FRAME_OK) {
+      handleProxyFrame((char *)proxyFramer.data, proxyFramer.frameLength);
+      serialFramerConsume(&proxyFramer);
+    } else if (result == SERIAL_FRAME_BADCRC) {
+      log_message(_F("PROXY Checksum received false! Searching for the next frame start."));
+    } else if (result == SERIAL_FRAME_BADLENGTH) {
+      log_message(_F("PROXY Received bad frame length. Searching for the next frame start."));
+    } else {
+      log_message(_F("PROXY Received bad header. Skipped data until the next frame start."));
     }
   }
-  //if ((proxylen > 0) && (proxydata_length == 0 )) proxy_totalreads++; //this is the start of a new read
-  proxydata_length +=  proxylen;
-  if (proxydata_length > 1 ) { //should have received length part of header now
-    if ((proxydata_length > ( proxydata[1] + 3)) || (proxydata_length >= MAXDATASIZE)) {
-      sprintf_P(log_msg, PSTR("PROXY Received %i bytes proxy %i\n"), proxydata_length, proxydata[1]);
-      log_message(log_msg);
-      log_message(_F("PROXY Received more data than header suggests! Ignoring this as this is bad data."));
-      proxydata_length = 0;
-      if (heishamonSettings.logHexdump) logHex(proxydata, proxydata_length);
-      return;
-    }
-    if (proxydata_length == (proxydata[1] + 3)) { //we received all data (serial2_data[1] is header length field)
-      sprintf_P(log_msg, PSTR("PROXY Received %i bytes"), proxydata_length); log_message(log_msg);
-      if (heishamonSettings.logHexdump) logHex(proxydata, proxydata_length);
-      if (! isValidReceiveChecksum(proxydata,proxydata_length) ) {
-        log_message(_F("PROXY Checksum received false!"));
-        proxydata_length = 0; //for next attempt
-        return;
-      }      
-      log_message(_F("PROXY Checksum and header received ok!"));
-      if ((proxydata[0]==0x71 or proxydata[0]==0xF1) and proxydata_length == (PANASONICQUERYSIZE+1)) { //this is a query from cztaw on proxy port
-        if (proxydata[0]==0xf1) {  //this is a write query, just pass this message forward as new command
-          log_message(_F("PROXY received write query, copy message forward to heatpump"));
-          send_command((byte*)proxydata,proxydata_length-1); //strip CRC, will be calculated again in send_command
-          //then just reply with the current settings, for read and write it is the same as the write is only acknowledged in the next read
-          //so we just run to the next if statement
-        }
-        if (proxydata[3] == 0x10) {
-          log_message(_F("PROXY requests basic data"));
-          if ((actData[0] == 0x71) && (actData[1] == 0xc8) && (actData[2] == 0x01)) { //don't answer if we don't have data
-            proxySerial.write(actData,DATASIZE); //should contain valid checksum also
-          }
-        } else if (proxydata[3] == 0x21 ) {
-          log_message(_F("PROXY requests extra data"));
-          if ((actDataExtra[0] == 0x71) && (actDataExtra[1] == 0xc8) && (actDataExtra[2] == 0x01)) { //don't answer if we don't have data
-            proxySerial.write(actDataExtra,DATASIZE); //should contain valid checksum also
-          }
-        } else {
-          log_message(_F("PROXY has sent unknown query! Forwarding to heatpump!"));
-          send_command((byte *)proxydata, proxydata_length-1); //strip CRC from end as send_command wil recalculate it
-        }
-        proxydata_length = 0;
-        return;
-      } else if (proxydata[0]==0x31) {
-        log_message(_F("PROXY received startup message, forwarding to heatpump!"));
-        send_command((byte *)proxydata, proxydata_length-1); //strip CRC from end as send_command wil recalculate it
-        proxydata_length = 0;
-        return;
-      } else {
-        log_message(_F("PROXY received unknown message, forwarding it to heatpump anyway!"));
-        send_command((byte *)proxydata, proxydata_length-1); //strip CRC from end as send_command wil recalculate it
-        proxydata_length = 0;
-        return;
+  //never let the cztaw wait into its timeout, a stale block is better than none
+  byte block = proxyExpired();
+  if (block != 0) {
+    log_message(_F("PROXY read took too long, answering from cache"));
+    writeProxyBlock(block);
+  }
+}
+#endif
+
+// Handle one complete frame with a valid checksum from the heatpump line
+bool handleHeatpumpFrame(char *data, byte data_length) {
+  sprintf_P(log_msg, PSTR("Received %d bytes data"), data_length); log_message(log_msg);
+  if (heishamonSettings.logHexdump) logHex(data, data_length);
+  log_message(_F("Checksum and header received ok!"));
+  goodreads++;
+  bootMark(BOOT_FIRST_FRAME);
+
+  if (data_length == DATASIZE)  {  //receive a full data block
+    if  (data[3] == 0x10) { //decode the normal data block
+      decode_heatpump_data(data, actData, mqtt_client, log_message, heishamonSettings.mqtt_topic_base, heishamonSettings.updateAllTime);
+      actDataTime = millis();
+      pollUpdateState(actData);
+      if ( (!extraDataBlockAvailable) && ((actData[0] == 0x71) && (actData[0xc7] >= 3)) ) { //do we have valid header and byte 0xc7 is more or equal 3 then assume K&L and more series
+        log_message(_F("Extra data available on this heatpump"));
+        extraDataBlockAvailable = true; //request for extra data next run
       }
+      #ifdef RAWDEBUG
+      {
+        char mqtt_topic[256];
+        sprintf(mqtt_topic, "%s/raw/data", heishamonSettings.mqtt_topic_base);
+        mqttQueuePublish(mqtt_topic, (const uint8_t *)actData, DATASIZE, MQTT_QUEUE_COALESCE); //do not retain this raw data
+      }
+      #endif
+      return true;
+    } else if (data[3] == 0x21) { //decode the new model extra data block
+      extraDataBlockAvailable = true; //set the flag to true so we know we can request this data always
+      decode_heatpump_data_extra(data, actDataExtra, mqtt_client, log_message, heishamonSettings.mqtt_topic_base, heishamonSettings.updateAllTime);
+      actDataExtraTime = millis();
+      #ifdef RAWDEBUG
+      {
+        char mqtt_topic[256];
+        sprintf(mqtt_topic, "%s/raw/dataextra", heishamonSettings.mqtt_topic_base);
+        mqttQueuePublish(mqtt_topic, (const uint8_t *)actDataExtra, DATASIZE, MQTT_QUEUE_COALESCE); //do not retain this raw data
+      }
+      #endif
+      return true;
+    } else {
+      log_message(_F("Received an unknown full size datagram. Can't decode this yet."));
+      return false;
     }
   }
+  else if (data_length == OPTDATASIZE ) { //optional pcb acknowledge answer
+    log_message(_F("Received optional PCB ack answer. Decoding this in OPT topics."));
+    decode_optional_heatpump_data(data, actOptData, mqtt_client, log_message, heishamonSettings.mqtt_topic_base, heishamonSettings.updateAllTime);
+    return true;
+  }
+  else {
+    log_message(_F("Received a shorter datagram. Can't decode this yet."));
+    return false;
+  }
 }
-#endif
 
 bool readSerial()
 {
+  bool decoded = false;
   int len = 0;
-  while ((heatpumpSerial.available()) && ((data_length + len) < MAXDATASIZE)) {
-    data[data_length + len] = heatpumpSerial.read(); //read available data and place it after the last received data
-    len++;
-  }
-
-  if ((len > 0) && (data_length == 0 )) totalreads++; //this is the start of a new read
-  data_length += len;
-
-  if (data_length > 3) { //should have received length part of header now
 
-    if (((data[0] != 0x71) && (data[0] != 0x31)) || (data[2] != 0x01))  { //wrong header received!
-      if (heishamonSettings.logHexdump) {
-        log_message(_F("Received bad header. Ignoring this data!"));
-        logHex(data, len);
+  //parse byte by byte so a bad byte only costs the frame it is in, bounded to one frame worth of bytes per call
+  while (len < MAXDATASIZE) {
+    byte result = serialFramerParse(&heatpumpFramer, SERIAL_FRAMER_STRICT);
+    if (result == SERIAL_FRAME_INCOMPLETE) {
+      byte value;
+      unsigned long time;
+      if (!uartRxRead(&value, &time)) {
+        break;
       }
-      badheaderread++;
-      data_length = 0;
-      return false;
-    }
-
-    if ((data_length > (data[1] + 3)) || (data_length >= MAXDATASIZE) ) {
-      log_message(_F("Received more data than header suggests! Ignoring this as this is bad data."));
-      if (heishamonSettings.logHexdump) logHex(data, data_length);
-      data_length = 0;
-      toolongread++;
-      return false;
-    }
-
-    if (data_length == (data[1] + 3)) { //we received all data (data[1] is header length field)
-      sprintf_P(log_msg, PSTR("Received %d bytes data"), data_length); log_message(log_msg);
+      if (heatpumpFramer.length == 0) frameStartTime = time;
+      serialFramerPut(&heatpumpFramer, value);
+      len++;
+    } else if (result == SERIAL_FRAME_OK) {
+      totalreads++;
       sending = false; //we received an answer after our last command so from now on we can start a new send request again
-      if (heishamonSettings.logHexdump) logHex(data, data_length);
-      if (! isValidReceiveChecksum(data, data_length) ) {
-        log_message(_F("Checksum received false!"));
-        data_length = 0; //for next attempt
-        badcrcread++;
-        return false;
-      }
-      log_message(_F("Checksum and header received ok!"));
-      goodreads++;
-
-      if (data_length == DATASIZE)  {  //receive a full data block
-        if  (data[3] == 0x10) { //decode the normal data block
-          decode_heatpump_data(data, actData, mqtt_client, log_message, heishamonSettings.mqtt_topic_base, heishamonSettings.updateAllTime);
-          if ( (!extraDataBlockAvailable) && ((actData[0] == 0x71) && (actData[0xc7] >= 3)) ) { //do we have valid header and byte 0xc7 is more or equal 3 then assume K&L and more series
-            log_message(_F("Extra data available on this heatpump"));
-            extraDataBlockAvailable = true; //request for extra data next run
-          }
-          #ifdef RAWDEBUG
-          {
-            char mqtt_topic[256];
-            sprintf(mqtt_topic, "%s/raw/data", heishamonSettings.mqtt_topic_base);
-            mqtt_client.publish(mqtt_topic, (const uint8_t *)actData, DATASIZE, false); //do not retain this raw data
-          }
-          #endif
-          data_length = 0;
-          return true;
-        } else if (data[3] == 0x21) { //decode the new model extra data block
-          extraDataBlockAvailable = true; //set the flag to true so we know we can request this data always
-          decode_heatpump_data_extra(data, actDataExtra, mqtt_client, log_message, heishamonSettings.mqtt_topic_base, heishamonSettings.updateAllTime);
-          #ifdef RAWDEBUG
-          {
-            char mqtt_topic[256];
-            sprintf(mqtt_topic, "%s/raw/dataextra", heishamonSettings.mqtt_topic_base);
-            mqtt_client.publish(mqtt_topic, (const uint8_t *)actDataExtra, DATASIZE, false); //do not retain this raw data
-          }
-          #endif
-          data_length = 0;
-          return true;
-        } else {
-#ifdef ESP8266
-          log_message(_F("Received an unknown full size datagram. Can't decode this yet."));
-#else 
-          log_message(_F("Received a full size datagram but not for me. Forwarding to proxy port."));
-          proxySerial.write(data,data_length);
-#endif               
-          data_length = 0;
-          return false;
-        }
-      }
-      else if (data_length == OPTDATASIZE ) { //optional pcb acknowledge answer
-        log_message(_F("Received optional PCB ack answer. Decoding this in OPT topics."));
-        decode_optional_heatpump_data(data, actOptData, mqtt_client, log_message, heishamonSettings.mqtt_topic_base, heishamonSettings.updateAllTime);
-        data_length = 0;
-        return true;
-      }
-      else {
-#ifdef ESP8266
-        log_message(_F("Received a shorter datagram. Can't decode this yet."));
-#else
-        log_message(_F("Received a shorter datagram but not for me. Forwarding to proxy port."));
-        proxySerial.write(data,data_length);
-#endif           
-        data_length = 0;
-        return false;
+      pollFrameReceived(frameStartTime);
+      recorderFrame(false, heatpumpFramer.data, heatpumpFramer.frameLength);
+      bool handled = handleHeatpumpFrame((char *)heatpumpFramer.data, heatpumpFramer.frameLength);
+#ifdef ESP32
+      //answers the CZ-TAW1 waits for, and anything that is not for us
+      if (heishamonSettings.proxy && (proxyAnswer(heatpumpFramer.data, heatpumpFramer.frameLength) || !handled)) {
+        log_message(_F("Forwarding this datagram to proxy port."));
+        proxySerial.write(heatpumpFramer.data, heatpumpFramer.frameLength);
       }
+#endif
+      decoded |= handled;
+      serialFramerConsume(&heatpumpFramer);
+    } else if (result == SERIAL_FRAME_BADCRC) {
+      log_message(_F("Checksum received false! Searching for the next frame start."));
+      totalreads++;
+      badcrcread++;
+      sending = false; //the answer is complete, even if it is broken
+    } else if (result == SERIAL_FRAME_BADLENGTH) {
+      log_message(_F("Received bad frame length. Searching for the next frame start."));
+      toolongread++;
+    } else {
+      if (heishamonSettings.logHexdump) log_message(_F("Received bad header. Skipped data until the next frame start."));
+      badheaderread++;
     }
   }
-  return false;
-}
-
-void popCommandBuffer() {
-  // to make sure we can pop a command from the buffer
-  if ((!sending) && cmdnrel > 0) {
-    send_command(cmdbuffer[cmdstart].data, cmdbuffer[cmdstart].length);
-    cmdstart = (cmdstart + 1) % (MAXCOMMANDSINBUFFER);
-    cmdnrel--;
-  }
+  pollBytesReceived(len);
+  return decoded;
 }
 
 void pushCommandBuffer(byte* command, int length) {
@@ -821,6 +835,7 @@ void pushCommandBuffer(byte* command, int length) {
   }
   cmdbuffer[cmdend].length = length;
   memcpy(&cmdbuffer[cmdend].data, command, length);
+  cmdbuffer[cmdend].queued = millis();
   cmdend = (cmdend + 1) % (MAXCOMMANDSINBUFFER);
   cmdnrel++;
 }
@@ -828,9 +843,7 @@ void pushCommandBuffer(byte* command, int length) {
 #ifdef ESP32
 void serialTXTask(void *pvParameters) {
   unsigned long lastPCBSendTime = 0;
-  unsigned long lastHPSendTime = 0;
-  unsigned long lastHPExtraSendTime = 0;
-  unsigned long lastPCBSaveTime = 0;
+  bool proxyServedLast = false; //proxy frames and own queries take turns
   char local_log_msg[LOG_MSG_SIZE];
 
   byte localPCBQuery[OPTIONALPCBQUERYSIZE] = {0xF1, 0x11, 0x01, 0x50, 0x00, 0x00, 0x40, 0xFF, 0xFF, 0xE5, 0xFF, 0xFF, 0x00, 0xFF, 0xEB, 0xFF, 0xFF, 0x00, 0x00};
@@ -854,40 +867,64 @@ void serialTXTask(void *pvParameters) {
         byte chk = calcChecksum(localPCBQuery, OPTIONALPCBQUERYSIZE);
         heatpumpSerial.write(localPCBQuery, OPTIONALPCBQUERYSIZE);
         heatpumpSerial.write(chk);
+        pollFrameSent(localPCBQuery, OPTIONALPCBQUERYSIZE);
+        recorderFrame(true, localPCBQuery, OPTIONALPCBQUERYSIZE);
+        proxyFrameSent(localPCBQuery, OPTIONALPCBQUERYSIZE, false);
         sprintf_P(local_log_msg, PSTR("optional PCB datagram sent bytes: %d"), OPTIONALPCBQUERYSIZE + 1);
         xQueueSend(logQueue,local_log_msg,0);
       }
-      // save to flash periodically
-      if ((unsigned long)(now - lastPCBSaveTime) >= (1000 * OPTIONALPCBSAVETIME)) {
-        lastPCBSaveTime = now;
-        saveOptionalPCB(localPCBQuery, OPTIONALPCBQUERYSIZE);
+      // the persist task writes it to flash when it changed
+      saveOptionalPCB(localPCBQuery, OPTIONALPCBQUERYSIZE);
+    }
+
+    // second priority: frames of the CZ-TAW1, taking turns with our own queries below
+    if ((!sending) && (!heishamonSettings.listenonly) && (!proxyServedLast)) {
+      struct cmdbuffer_t cmd;
+      if (xQueueReceive(proxyQueue, &cmd, 0) == pdTRUE) {
+        sending = true;
+        sendCommandReadTime = now;
+        byte chk = calcChecksum(cmd.data, cmd.length);
+        heatpumpSerial.write(cmd.data, cmd.length);
+        heatpumpSerial.write(chk);
+        pollFrameSent(cmd.data, cmd.length);
+        recorderFrame(true, cmd.data, cmd.length);
+        proxyFrameSent(cmd.data, cmd.length, true);
+        proxyServedLast = true;
+        sprintf_P(local_log_msg, PSTR("PROXY datagram sent bytes: %d"), cmd.length + 1);
+        xQueueSend(logQueue,local_log_msg,0);
       }
     }
 
-    // second priority: static heatpump query every waitTime seconds
+    // third priority: heatpump query at the rate of the heatpump state, or a read back after a write
     if ((!sending) && (!heishamonSettings.listenonly)) {
-      if ((unsigned long)(now - lastHPSendTime) >= (1000 * heishamonSettings.waitTime)) {
+      if (pollMainDue(heishamonSettings.waitTime, heishamonSettings.waitTimeIdle)) {
         sending = true;
         sendCommandReadTime = now;
-        lastHPSendTime = now;
         byte chk = calcChecksum(panasonicQuery, PANASONICQUERYSIZE);
         heatpumpSerial.write(panasonicQuery, PANASONICQUERYSIZE);
         heatpumpSerial.write(chk);
+        pollFrameSent(panasonicQuery, PANASONICQUERYSIZE);
+        recorderFrame(true, panasonicQuery, PANASONICQUERYSIZE);
+        proxyFrameSent(panasonicQuery, PANASONICQUERYSIZE, false);
+        proxyServedLast = false;
         sprintf_P(local_log_msg, PSTR("heatpump request query sent bytes: %d"), PANASONICQUERYSIZE + 1);
         xQueueSend(logQueue,local_log_msg,0);    
       }
     }
 
-    // third priority: extra data block query every waitTime seconds (offset from basic query)
+    // fourth priority: extra data block query at its own rate
     if ((!sending) && (!heishamonSettings.listenonly) && extraDataBlockAvailable) {
-      if ((unsigned long)(now - lastHPExtraSendTime) >= (1000 * heishamonSettings.waitTime)) {
-        lastHPExtraSendTime = now;
+      if (pollExtraDue(heishamonSettings.waitTime, heishamonSettings.waitTimeIdle, heishamonSettings.waitTimeExtra)) {
         sending = true;
         sendCommandReadTime = now;
         panasonicQuery[3] = 0x21;
         byte chk = calcChecksum(panasonicQuery, PANASONICQUERYSIZE);
         heatpumpSerial.write(panasonicQuery, PANASONICQUERYSIZE);
         heatpumpSerial.write(chk);
+        pollFrameSent(panasonicQuery, PANASONICQUERYSIZE);
+        recorderFrame(true, panasonicQuery, PANASONICQUERYSIZE);
+        proxyFrameSent(panasonicQuery, PANASONICQUERYSIZE, false);
+        proxyServedLast = false;
         panasonicQuery[3] = 0x10;
         xQueueSend(logQueue, (void*)"heatpump extra query sent", 0);
       }
@@ -899,14 +936,22 @@ void serialTXTask(void *pvParameters) {
       if (xQueueReceive(cmdQueue, &cmd, 0) == pdTRUE) {
         sending = true;
         sendCommandReadTime = now;
+        busMetricsObserve(BUS_HIST_QUEUE_WAIT, now - cmd.queued);
         byte chk = calcChecksum(cmd.data, cmd.length);
         heatpumpSerial.write(cmd.data, cmd.length);
         heatpumpSerial.write(chk);
+        pollFrameSent(cmd.data, cmd.length);
+        recorderFrame(true, cmd.data, cmd.length);
+        proxyFrameSent(cmd.data, cmd.length, false);
+        proxyServedLast = false;
         sprintf_P(local_log_msg, PSTR("Command datagram sent bytes: %d"), cmd.length + 1);
         xQueueSend(logQueue,local_log_msg,0);      
       }
     }
 
+    // nothing of our own to send, the proxy may go again
+    if (!sending) proxyServedLast = false;
+
     vTaskDelay(1 / portTICK_PERIOD_MS);
   }
 }
@@ -918,105 +963,122 @@ bool send_command(byte* command, int length) {
   struct cmdbuffer_t cmd;
   cmd.length = length;
   memcpy(&cmd.data, command, length);
+  cmd.queued = millis();
   xQueueSend(cmdQueue, &cmd, 0);
   return true;
 }
 
 #else
 
-bool send_command(byte* command, int length) {
-  if ( heishamonSettings.listenonly ) {
-    log_message(_F("Not sending this command. Heishamon in listen only mode!"));
-    return false;
-  }
-  if ( sending ) {
-    log_message(_F("Already sending data. Buffering this send request"));
-    pushCommandBuffer(command, length);
-    return false;
-  }
+void transmit_command(byte* command, int length, unsigned long queued) {
   sending = true; //simple semaphore to only allow one send command at a time, semaphore ends when answered data is received
+  if (pollFrameType(command, length) == POLL_FRAME_COMMAND) { //the queries are not queued
+    busMetricsObserve(BUS_HIST_QUEUE_WAIT, millis() - queued);
+  }
 
   byte chk = calcChecksum(command, length);
   int bytesSent = heatpumpSerial.write(command, length); //first send command
   bytesSent += heatpumpSerial.write(chk); //then calculcated checksum byte afterwards
+  pollFrameSent(command, length);
+  recorderFrame(true, command, length);
   sprintf_P(log_msg, PSTR("sent bytes: %d including checksum value: %d "), bytesSent, int(chk));
   log_message(log_msg);
 
   if (heishamonSettings.logHexdump) logHex((char*)command, length);
   sendCommandReadTime = millis(); //set sendCommandReadTime when to timeout the answer of this command
+}
+
+bool send_command(byte* command, int length) {
+  if ( heishamonSettings.listenonly ) {
+    log_message(_F("Not sending this command. Heishamon in listen only mode!"));
+    return false;
+  }
+  if ( sending ) {
+    log_message(_F("Already sending data. Buffering this send request"));
+    pushCommandBuffer(command, length);
+    return false;
+  }
+  transmit_command(command, length, millis());
   return true;
 }
+
+void popCommandBuffer() {
+  // to make sure we can pop a command from the buffer
+  if ((!sending) && cmdnrel > 0) {
+    transmit_command(cmdbuffer[cmdstart].data, cmdbuffer[cmdstart].length, cmdbuffer[cmdstart].queued);
+    cmdstart = (cmdstart + 1) % (MAXCOMMANDSINBUFFER);
+    cmdnrel--;
+  }
+}
 #endif
 
+// For the frames of the set_* commands only, these are merged into one write
+// frame and sent from loop() together with the other pending settings
+bool send_setting_command(byte* command, int length) {
+  if ((!heishamonSettings.listenonly) && mergeWriteCommand(command, length)) {
+    return true;
+  }
+  return send_command(command, length);
+}
+
 // Callback function that is called when a message has been pushed to one of your topics.
 void mqtt_callback(char* topic, byte* payload, unsigned int length) {
-  if (mqttcallbackinprogress) {
-    log_message(_F("Already processing another mqtt callback. Ignoring this one"));
-  }
-  else {
-    mqttcallbackinprogress = true; //simple semaphore to make sure we don't have two callbacks at the same time
-    char msg[length + 1];
-    for (unsigned int i = 0; i < length; i++) {
-      msg[i] = (char)payload[i];
+  char* topic_command = topic + strlen(heishamonSettings.mqtt_topic_base) + 1; //strip base plus seperator from topic
+
+  // heatpump commands are queued and sent from the main loop
+  if (strncmp(topic_command, mqtt_topic_commands, strlen(mqtt_topic_commands)) == 0) {
+    char* topic_sendcommand = topic_command + strlen(mqtt_topic_commands) + 1; //strip the first 9 "commands/" from the topic to get what we need
+    if (commandInboxPush(topic_sendcommand, payload, length, heishamonSettings.optionalPCB)) {
+      return;
     }
-    msg[length] = '\0';
+  }
+
+  char msg[length + 1];
+  for (unsigned int i = 0; i < length; i++) {
+    msg[i] = (char)payload[i];
+  }
+  msg[length] = '\0';
 
-    // copy topic to the heap so a later mqtt publish can't clobber PubSubClient's buffer
-    char* topiccopy = (char*) malloc(strlen(topic) + 1);
-    if (topiccopy) {
-      memcpy(topiccopy, topic, strlen(topic) + 1);
-      topic = topiccopy;	
+  if (strcmp(topic_command, mqtt_send_raw_value_topic) == 0)
+  { // send a raw hex string
+    sprintf_P(log_msg, PSTR("sending raw value"));
+    log_message(log_msg);
+    send_command((byte *)msg, length);
+  } else if (strncmp(topic_command, mqtt_topic_s0, strlen(mqtt_topic_s0)) == 0)  // this is a s0 topic, check for watthour topic and restore it
+  {
+    char* topic_s0_watthour_port = strrchr(topic_command, '/') + 1; //the s0 port is the last level of "s0/WatthourTotal/1"
+    int s0Port = String(topic_s0_watthour_port).toInt();
+    float watthour = String(msg).toFloat();
+    restore_s0_Watthour(s0Port, watthour);
+    //unsubscribe after restoring the watthour values
+    char mqtt_topic[256];
+    sprintf(mqtt_topic, "%s", topic);
+    if (mqtt_client.unsubscribe(mqtt_topic)) {
+      log_message(_F("Unsubscribed from S0 watthour restore topic"));
     }
-	  
-	char* topic_command = topic + strlen(heishamonSettings.mqtt_topic_base) + 1; //strip base plus seperator from topic
-    if (strcmp(topic_command, mqtt_send_raw_value_topic) == 0)
-    { // send a raw hex string
-      byte *rawcommand;
-      rawcommand = (byte *) malloc(length);
-      memcpy(rawcommand, msg, length);
-
-      sprintf_P(log_msg, PSTR("sending raw value"));
-      log_message(log_msg);
-      send_command(rawcommand, length);
-      free(rawcommand);
-    } else if (strncmp(topic_command, mqtt_topic_s0, strlen(mqtt_topic_s0)) == 0)  // this is a s0 topic, check for watthour topic and restore it
-    {
-      char* topic_s0_watthour_port = topic_command + strlen(mqtt_topic_s0) + 15; //strip the first 17 "s0/WatthourTotal/" from the topic to get the s0 port
-      int s0Port = String(topic_s0_watthour_port).toInt();
-      float watthour = String(msg).toFloat();
-      restore_s0_Watthour(s0Port, watthour);
-      //unsubscribe after restoring the watthour values
-      char mqtt_topic[256];
-      sprintf(mqtt_topic, "%s", topic);
-      if (mqtt_client.unsubscribe(mqtt_topic)) {
-        log_message(_F("Unsubscribed from S0 watthour restore topic"));
-      }
-    } else if (strncmp(topic_command, mqtt_topic_commands, strlen(mqtt_topic_commands)) == 0)  // check for commands to heishamon
-    {
-      char* topic_sendcommand = topic_command + strlen(mqtt_topic_commands) + 1; //strip the first 9 "commands/" from the topic to get what we need
-      send_heatpump_command(topic_sendcommand, msg, send_command, log_message, heishamonSettings.optionalPCB);
-    //use this to receive valid heishamon raw data from other heishamon to debug this OT code
+  } else if (strncmp(topic_command, mqtt_topic_commands, strlen(mqtt_topic_commands)) == 0)  // commands that did not fit in the inbox
+  {
+    char* topic_sendcommand = topic_command + strlen(mqtt_topic_commands) + 1; //strip the first 9 "commands/" from the topic to get what we need
+    send_heatpump_command(topic_sendcommand, msg, send_setting_command, log_message, heishamonSettings.optionalPCB);
+  //use this to receive valid heishamon raw data from other heishamon to debug this OT code
 #ifdef RAWDEBUG
-    } else if (strcmp((char*)"panasonic_heat_pump/raw/data", topic) == 0) {  // check for raw heatpump input
-      sprintf_P(log_msg, PSTR("Received raw heatpump data from MQTT"));
-      log_message(log_msg);
-      decode_heatpump_data(msg, actData, mqtt_client, log_message, heishamonSettings.mqtt_topic_base, heishamonSettings.updateAllTime);
-      memcpy(actData, msg, DATASIZE);
+  } else if (strcmp((char*)"panasonic_heat_pump/raw/data", topic) == 0) {  // check for raw heatpump input
+    sprintf_P(log_msg, PSTR("Received raw heatpump data from MQTT"));
+    log_message(log_msg);
+    decode_heatpump_data(msg, actData, mqtt_client, log_message, heishamonSettings.mqtt_topic_base, heishamonSettings.updateAllTime);
+    memcpy(actData, msg, DATASIZE);
 #endif
-    } else if (strncmp(topic_command, mqtt_topic_opentherm_read, strlen(mqtt_topic_opentherm_read)) == 0)  {
-      char* topic_otcommand = topic_command + strlen(mqtt_topic_opentherm_read) + 1; //strip the opentherm subtopic from the topic
-      mqttOTCallback(topic_otcommand, msg);
-    } else if (strncmp(topic_command, mqtt_topic_gpio, strlen(mqtt_topic_gpio)) == 0)  {
-      char* topic_gpiocommand = topic_command + strlen(mqtt_topic_gpio) + 1; //strip the gpio subtopic from the topic
-      mqttGPIOCallback(topic_gpiocommand, msg);
-    } else if (strncmp(topic_command, mqtt_topic_1wire, strlen(mqtt_topic_1wire)) == 0) { //this is a 1wire address topic, restore its retained value at boot
-      char* topic_1wire_address = topic_command + strlen(mqtt_topic_1wire) + 1; //strip the "1wire/" from the topic to get the sensor address
-      if ((strchr(topic_1wire_address, '/') == NULL) && (length > 0)) { //only handle the address topic itself (not .../alias) and skip empty (cleared) retained messages
-        restoreDallasFromMqtt(topic_1wire_address, String(msg).toFloat(), log_message);
-      }
+  } else if (strncmp(topic_command, mqtt_topic_opentherm_read, strlen(mqtt_topic_opentherm_read)) == 0)  {
+    char* topic_otcommand = topic_command + strlen(mqtt_topic_opentherm_read) + 1; //strip the opentherm subtopic from the topic
+    mqttOTCallback(topic_otcommand, msg);
+  } else if (strncmp(topic_command, mqtt_topic_gpio, strlen(mqtt_topic_gpio)) == 0)  {
+    char* topic_gpiocommand = topic_command + strlen(mqtt_topic_gpio) + 1; //strip the gpio subtopic from the topic
+    mqttGPIOCallback(topic_gpiocommand, msg);
+  } else if (strncmp(topic_command, mqtt_topic_1wire, strlen(mqtt_topic_1wire)) == 0) { //this is a 1wire address topic, restore its retained value at boot
+    char* topic_1wire_address = topic_command + strlen(mqtt_topic_1wire) + 1; //strip the "1wire/" from the topic to get the sensor address
+    if ((strchr(topic_1wire_address, '/') == NULL) && (length > 0)) { //only handle the address topic itself (not .../alias) and skip empty (cleared) retained messages
+      restoreDallasFromMqtt(topic_1wire_address, String(msg).toFloat(), log_message);
     }
-    free(topiccopy);
-    mqttcallbackinprogress = false;
   }
 }
 
@@ -1045,313 +1107,225 @@ void setupOTA() {
 
 
 
-int8_t webserver_cb(struct webserver_t *client, void *dat) {
-  
+static int8_t routeNotFound(struct webserver_t *client, void *dat) {
+  if ((client->step == WEBSERVER_CLIENT_WRITE) && (client->content == 0)) {
+    webserver_send(client, 404, (char *)"text/plain", 13);
+    webserver_send_content_P(client, PSTR("404 Not found"), 13);
+  }
+  return 0;
+}
+
+static int8_t routeRoot(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    return handleRoot(client, readpercentage, mqttReconnects, &heishamonSettings);
+  }
+  return 0;
+}
+
+static int8_t routeToggleLog(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_REQUEST_URI) {
+    log_message(_F("Toggled mqtt log flag"));
+    heishamonSettings.logMqtt ^= true;
+    client->route = ROUTE_ROOT;
+  }
+  return 0;
+}
+
+static int8_t routeToggleHexdump(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_REQUEST_URI) {
+    log_message(_F("Toggled hexdump log flag"));
+    heishamonSettings.logHexdump ^= true;
+    client->route = ROUTE_ROOT;
+  }
+  return 0;
+}
+
+static int8_t routeJson(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    return handleJsonOutput(client, actData, actDataExtra, actOptData, &heishamonSettings, extraDataBlockAvailable);
+  }
+  return 0;
+}
+
+static int8_t routeReboot(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    return handleReboot(client);
+  }
+  return 0;
+}
+
+static int8_t routeDebug(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_REQUEST_URI) {
+    log_message(_F("Debug URL requested"));
+  } else if (client->step == WEBSERVER_CLIENT_WRITE) {
+    if (client->content == 0) {
+      webserver_send(client, 200, (char *)"text/plain", 0);
+    } else if (client->content == 1) {
+      webserver_send_content_P(client, PSTR("-- heatpump data --\n"), 20);
+      handleDebug(client, (char *)actData, 203);
+    } else if ((client->content == 2) && extraDataBlockAvailable) {
+      webserver_send_content_P(client, PSTR("-- extra data --\n"), 17);
+      handleDebug(client, (char *)actDataExtra, 203);
+    }
+  }
+  return 0;
+}
+
+static int8_t routeWifiScan(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    return handleWifiScan(client);
+  }
+  return 0;
+}
+
+static int8_t routeDallasAlias(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_ARGS) {
+    struct arguments_t *args = (struct arguments_t *)dat;
+    sprintf_P(log_msg, PSTR("Dallas alias changed address %s to alias %s"), args->name, args->value);
+    log_message(log_msg);
+    changeDallasAlias((char *)args->name, (char *)args->value);
+  } else if (client->step == WEBSERVER_CLIENT_CREATE_HEADER) {
+    struct header_t *header = (struct header_t *)dat;
+    header->ptr += sprintf_P((char *)header->buffer, PSTR("Location: /"));
+    return -1;
+  }
+  return 0;
+}
+
+static int8_t routeRemoveDallas(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_ARGS) {
+    struct arguments_t *args = (struct arguments_t *)dat;
+    removeDallasSensor(mqtt_client, heishamonSettings.mqtt_topic_base, (char *)args->name, log_message);
+  } else if (client->step == WEBSERVER_CLIENT_CREATE_HEADER) {
+    struct header_t *header = (struct header_t *)dat;
+    header->ptr += sprintf_P((char *)header->buffer, PSTR("Location: /"));
+    return -1;
+  }
+  return 0;
+}
+
+static int8_t routeCaptivePortal(struct webserver_t *client, void *dat) {
+  if ((client->step == WEBSERVER_CLIENT_WRITE) && (client->content == 0)) {
+    webserver_send(client, 302, (char *)"text/html", 0);
+  } else if (client->step == WEBSERVER_CLIENT_CREATE_HEADER) {
+    struct header_t *header = (struct header_t *)dat;
+    header->ptr += sprintf_P((char *)header->buffer, PSTR("Location: http://192.168.4.1/settings"));
+    return -1;
+  }
+  return 0;
+}
+
+static int8_t routeCaptivePortalApple(struct webserver_t *client, void *dat) {
+  if ((client->step == WEBSERVER_CLIENT_WRITE) && (client->content == 0)) {
+    static const char body[] PROGMEM =
+      "<HTML><HEAD><TITLE>HeishaMon Setup</TITLE>"
+      "<META name='viewport' content='width=device-width,initial-scale=1'>"
+      "</HEAD><BODY>"
+      "<h2>HeishaMon Setup</h2>"
+      "<p><a href='http://192.168.4.1/settings'>Open Settings</a></p>"
+      "</BODY></HTML>";
+    webserver_send(client, 200, (char *)"text/html", strlen(body));
+    webserver_send_content_P(client, body, strlen(body));
+  }
+  return 0;
+}
+
+static int8_t routeFactoryReset(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    return handleFactoryReset(client);
+  }
+  return 0;
+}
 
+static int8_t routeCommand(struct webserver_t *client, void *dat) {
   switch (client->step) {
-    case WEBSERVER_CLIENT_REQUEST_METHOD: {
-        if (strcmp_P((char *)dat, PSTR("POST")) == 0) {
-          client->route = 110;
+    case WEBSERVER_CLIENT_REQUEST_URI: {
+        if ((client->userdata = malloc(1)) == NULL) {
+          loggingSerial.printf(PSTR("Out of memory %s:#%d\n"), __FUNCTION__, __LINE__);
+          ESP.restart();
+          exit(-1);
         }
-        return 0;
+        ((char *)client->userdata)[0] = 0;
       } break;
-    case WEBSERVER_CLIENT_REQUEST_URI: {
-        if (strcmp_P((char *)dat, PSTR("/")) == 0) {
-          client->route = 1;
-        } else if (strcmp_P((char *)dat, PSTR("/json")) == 0) {
-          client->route = 20;
-        } else if (strcmp_P((char *)dat, PSTR("/reboot")) == 0) {
-          client->route = 30;
-        } else if (strcmp_P((char *)dat, PSTR("/debug")) == 0) {
-          client->route = 40;
-          log_message(_F("Debug URL requested"));
-        } else if (strcmp_P((char *)dat, PSTR("/wifiscan")) == 0) {
-          client->route = 50;
-        } else if (strcmp((char *)dat, "/dallasalias") == 0) {
-          client->route = 60;
-        } else if (strcmp((char *)dat, "/removedallas") == 0) {
-          client->route = 190;
-        } else if (strcmp((char *)dat, "/togglelog") == 0) {
-          client->route = 1;
-          log_message(_F("Toggled mqtt log flag"));
-          heishamonSettings.logMqtt ^= true;
-        } else if (strcmp_P((char *)dat, PSTR("/togglehexdump")) == 0) {
-          client->route = 1;
-          log_message(_F("Toggled hexdump log flag"));
-          heishamonSettings.logHexdump ^= true;
-        } else if (strcmp_P((char *)dat, PSTR("/connecttest.txt")) == 0 ||
-                   strcmp_P((char *)dat, PSTR("/ncsi.txt")) == 0 ||
-                   strcmp_P((char *)dat, PSTR("/redirect")) == 0 ||
-                   strcmp_P((char *)dat, PSTR("/fwlink")) == 0 ||
-                   strcmp_P((char *)dat, PSTR("/generate_204")) == 0 ||
-                   strcmp_P((char *)dat, PSTR("/gen_204")) == 0 ||
-                   strcmp_P((char *)dat, PSTR("/popup")) == 0) {
-          client->route = 80; //for Android/Windows devices
-        } else if (strcmp_P((char *)dat, PSTR("/hotspot-detect.html")) == 0 ) {
-          client->route = 81;  //for Apple devices
-        } else if (strcmp_P((char *)dat, PSTR("/factoryreset")) == 0) {
-          client->route = 90;
-        } else if (strcmp_P((char *)dat, PSTR("/command")) == 0) {
-          if ((client->userdata = malloc(1)) == NULL) {
-            loggingSerial.printf(PSTR("Out of memory %s:#%d\n"), __FUNCTION__, __LINE__);
-            ESP.restart();
-            exit(-1);
-          }
-          ((char *)client->userdata)[0] = 0;
-          client->route = 100;
-        } else if (client->route == 110) {
-          // Only accept settings POST requests
-          if (strcmp_P((char *)dat, PSTR("/savesettings")) == 0) {
-            client->route = 110;
-          } else if (strcmp_P((char *)dat, PSTR("/saverules")) == 0) {
-            client->route = 170;
-            if (LittleFS.begin()) {
-              LittleFS.remove("/rules.new");
-              client->userdata = new File(LittleFS.open("/rules.new", "a+"));
-            }
-#ifdef TLS_SUPPORT
-        } else if (strcmp_P((char *)dat, PSTR("/cacert")) == 0) {
-          client->route = 165; 
-          if (LittleFS.begin()) {
-            LittleFS.remove("/ca.tmp");
-            File cf = LittleFS.open("/ca.tmp", "w");
-            if (cf) {
-              client->userdata = new File(cf);
-            }
-            new_ca_stored = true;
-          }
-#endif
-          } else if (strcmp_P((char *)dat, PSTR("/firmware")) == 0) {
-            if (!Update.isRunning()) {
-#ifdef ESP8266
-              Update.runAsync(true);
-#endif
-              if (!Update.begin((ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000)) {
-                Update.printError(loggingSerial);
-                return -1;
-              } else {
-                client->route = 150;
-              }
-            } else {
-              loggingSerial.println(PSTR("New firmware update client, while previous isn't finished yet! Assume broken connection, abort!"));
-              Update.end();
-              return -1;
+    case WEBSERVER_CLIENT_ARGS: {
+        struct arguments_t *args = (struct arguments_t *)dat;
+        unsigned char cmd[256] = { 0 };
+        char cpy[args->len + 1];
+        char log_msg[256] = { 0 };
+        unsigned int len = 0;
+
+        memset(&cpy, 0, args->len + 1);
+        snprintf((char *)&cpy, args->len + 1, "%.*s", args->len, args->value);
+
+        for (uint8_t x = 0; x < sizeof(commands) / sizeof(commands[0]); x++) {
+          cmdStruct tmp;
+          memcpy_P(&tmp, &commands[x], sizeof(tmp));
+          if (strcmp((char *)args->name, tmp.name) == 0) {
+            len = tmp.func(cpy, cmd, log_msg);
+            if ((client->userdata = realloc(client->userdata, strlen((char *)client->userdata) + strlen(log_msg) + 2)) == NULL) {
+              loggingSerial.printf(PSTR("Out of memory %s:#%d\n"), __FUNCTION__, __LINE__);
+              ESP.restart();
+              exit(-1);
             }
-          } else {
-            return -1;
+            strcat((char *)client->userdata, log_msg);
+            strcat((char *)client->userdata, "\n");
+            log_message(log_msg);
+            send_setting_command(cmd, len);
           }
-        } else if (strcmp_P((char *)dat, PSTR("/settings")) == 0) {
-          client->route = 120;
-        } else if (strcmp_P((char *)dat, PSTR("/getsettings")) == 0) {
-          client->route = 130;
-        } else if (strcmp_P((char *)dat, PSTR("/firmware")) == 0) {
-          client->route = 140;
-        } else if (strcmp_P((char *)dat, PSTR("/rules")) == 0) {
-          client->route = 160;
-#ifdef TLS_SUPPORT
-        } else if (strcmp_P((char *)dat, PSTR("/cacert")) == 0) {
-          client->route = 166; 
-#endif
-        } else if (strcmp_P((char *)dat, PSTR("/scandallas")) == 0) {
-          client->route = 180;          
-        } else {
-          client->route = 0;
         }
 
-        return 0;
-      } break;
-    case WEBSERVER_CLIENT_ARGS: {
-        struct arguments_t *args = (struct arguments_t *)dat;
-        switch (client->route) {
-          case 60: {
-              sprintf_P(log_msg, PSTR("Dallas alias changed address %s to alias %s"), args->name, args->value);
-              log_message(log_msg);
-              changeDallasAlias((char *)args->name, (char *)args->value);
-              return 0;
-            } break;
-          case 190: {
-              removeDallasSensor(mqtt_client, heishamonSettings.mqtt_topic_base, (char *)args->name, log_message);
-              return 0;
-            } break;
-          case 100: {
-              unsigned char cmd[256] = { 0 };
-              char cpy[args->len + 1];
-              char log_msg[256] = { 0 };
-              unsigned int len = 0;
-
-              memset(&cpy, 0, args->len + 1);
-              snprintf((char *)&cpy, args->len + 1, "%.*s", args->len, args->value);
-
-              for (uint8_t x = 0; x < sizeof(commands) / sizeof(commands[0]); x++) {
-                cmdStruct tmp;
-                memcpy_P(&tmp, &commands[x], sizeof(tmp));
-                if (strcmp((char *)args->name, tmp.name) == 0) {
-                  len = tmp.func(cpy, cmd, log_msg);
-                  if ((client->userdata = realloc(client->userdata, strlen((char *)client->userdata) + strlen(log_msg) + 2)) == NULL) {
-                    loggingSerial.printf(PSTR("Out of memory %s:#%d\n"), __FUNCTION__, __LINE__);
-                    ESP.restart();
-                    exit(-1);
-                  }
-                  strcat((char *)client->userdata, log_msg);
-                  strcat((char *)client->userdata, "\n");
-                  log_message(log_msg);
-                  send_command(cmd, len);
-                }
+        memset(&cmd, 0, 256);
+        memset(&log_msg, 0, 256);
+
+        if (heishamonSettings.optionalPCB) {
+          //optional commands
+          for (uint8_t x = 0; x < sizeof(optionalCommands) / sizeof(optionalCommands[0]); x++) {
+            optCmdStruct tmp;
+            memcpy_P(&tmp, &optionalCommands[x], sizeof(tmp));
+            if (strcmp((char *)args->name, tmp.name) == 0) {
+              len = tmp.func(cpy, log_msg);
+              if ((client->userdata = realloc(client->userdata, strlen((char *)client->userdata) + strlen(log_msg) + 2)) == NULL) {
+                loggingSerial.printf(PSTR("Out of memory %s:#%d\n"), __FUNCTION__, __LINE__);
+                ESP.restart();
+                exit(-1);
               }
-
-              memset(&cmd, 0, 256);
-              memset(&log_msg, 0, 256);
-
-              if (heishamonSettings.optionalPCB) {
-                //optional commands
-                for (uint8_t x = 0; x < sizeof(optionalCommands) / sizeof(optionalCommands[0]); x++) {
-                  optCmdStruct tmp;
-                  memcpy_P(&tmp, &optionalCommands[x], sizeof(tmp));
-                  if (strcmp((char *)args->name, tmp.name) == 0) {
-                    len = tmp.func(cpy, log_msg);
-                    if ((client->userdata = realloc(client->userdata, strlen((char *)client->userdata) + strlen(log_msg) + 2)) == NULL) {
-                      loggingSerial.printf(PSTR("Out of memory %s:#%d\n"), __FUNCTION__, __LINE__);
-                      ESP.restart();
-                      exit(-1);
-                    }
-                    strcat((char *)client->userdata, log_msg);
-                    strcat((char *)client->userdata, "\n");
-                    log_message(log_msg);
+              strcat((char *)client->userdata, log_msg);
+              strcat((char *)client->userdata, "\n");
+              log_message(log_msg);
 #ifdef ESP32
-                    xQueueOverwrite(pcbQueue, optionalPCBQuery);
-#endif
-                  }
-                }
-              }
-            } break;
-          case 110: {
-              return cacheSettings(client, args);
-            } break;
-          case 150: {
-              if (Update.isRunning() && (!Update.hasError())) {
-                if ((strcmp((char *)args->name, "md5") == 0) && (args->len > 0)) {
-                  char md5[args->len + 1];
-                  memset(&md5, 0, args->len + 1);
-                  snprintf((char *)&md5, args->len + 1, "%.*s", args->len, args->value);
-                  sprintf_P(log_msg, PSTR("Firmware MD5 expected: %s"), md5);
-                  log_message(log_msg);
-                  if (!Update.setMD5(md5)) {
-                    log_message(_F("Failed to set expected update file MD5!"));
-                    Update.end(false);
-                  }
-                } else if (strcmp((char *)args->name, "firmware") == 0) {
-                  if (Update.write((uint8_t *)args->value, args->len) != args->len) {
-                    Update.printError(loggingSerial);
-                    Update.end(false);
-                  } else {
-                    if (uploadpercentage != (unsigned int)(((float)client->readlen / (float)client->totallen) * 20)) {
-                      uploadpercentage = (unsigned int)(((float)client->readlen / (float)client->totallen) * 20);
-                      sprintf_P(log_msg, PSTR("Uploading new firmware: %d%%"), uploadpercentage * 5);
-                      log_message(log_msg);
-                    }
-                  }
-                }
-              } else {
-                log_message((char*)"New firmware POST data but update not running anymore!");
-              }
-            } break;
-          case 170: {
-              File *f = (File *)client->userdata;
-              if (!f || !*f) {
-                client->route = 160;
-              } else {
-                f->write(args->value, args->len);
-              }
-            } break;
-#ifdef TLS_SUPPORT            
-          case 165: {
-              File *f = (File *)client->userdata;
-              if (f && *f && args->len > 0) {
-                  f->write((const uint8_t*)args->value, (size_t)args->len);
-              }
-              return 0;
-            } break;
+              xQueueOverwrite(pcbQueue, optionalPCBQuery);
 #endif
+            }
+          }
         }
       } break;
-    case WEBSERVER_CLIENT_HEADER: {
-        struct arguments_t *args = (struct arguments_t *)dat;
-        return 0;
-      } break;
     case WEBSERVER_CLIENT_WRITE: {
-        switch (client->route) {
-          case 0: {
-              if (client->content == 0) {
-                webserver_send(client, 404, (char *)"text/plain", 13);
-                webserver_send_content_P(client, PSTR("404 Not found"), 13);
-              }
-              return 0;
-            } break;
-          case 1: {
-              return handleRoot(client, readpercentage, mqttReconnects, &heishamonSettings);
-            } break;
-          case 20: {
-              return handleJsonOutput(client, actData, actDataExtra, actOptData, &heishamonSettings, extraDataBlockAvailable);
-            } break;
-          case 30: {
-              return handleReboot(client);
-            } break;
-          case 40: {
-              if (client->content == 0) {
-                webserver_send(client, 200, (char *)"text/plain", 0);
-              } else if (client->content == 1) {
-                webserver_send_content_P(client, PSTR("-- heatpump data --\n"), 20);
-                handleDebug(client, (char *)actData, 203);
-              } else if ((client->content == 2) && extraDataBlockAvailable) {
-                webserver_send_content_P(client, PSTR("-- extra data --\n"), 17);
-                handleDebug(client, (char *)actDataExtra, 203);
-              }
-              return 0;
-            } break;
-          case 50: {
-              return handleWifiScan(client);
-            } break;
-          case 60: {
-              return 0;
-            } break;
-          case 190: {
-              return 0;
-            } break;
-          case 80: {
-              if (client->content == 0) {
-                webserver_send(client, 302, (char *)"text/html", 0);
-              }
-              return 0;
-            } break;
-          case 81: {
-              if (client->content == 0) {
-                static const char body[] PROGMEM =
-                  "<HTML><HEAD><TITLE>HeishaMon Setup</TITLE>"
-                  "<META name='viewport' content='width=device-width,initial-scale=1'>"
-                  "</HEAD><BODY>"
-                  "<h2>HeishaMon Setup</h2>"
-                  "<p><a href='http://192.168.4.1/settings'>Open Settings</a></p>"
-                  "</BODY></HTML>";
-                webserver_send(client, 200, (char *)"text/html", strlen(body));
-                webserver_send_content_P(client, body, strlen(body));
-              }
-              return 0;
-            } break;            
-          case 90: {
-              return handleFactoryReset(client);
-            } break;
-          case 100: {
-              if (client->content == 0) {
-                webserver_send(client, 200, (char *)"text/plain", 0);
-                char *RESTmsg = (char *)client->userdata;
-                webserver_send_content(client, (char *)RESTmsg, strlen(RESTmsg));
-                free(RESTmsg);
-                client->userdata = NULL;
-              }
-              return 0;
-            } break;
-          case 110: {
-              int ret = saveSettings(client, &heishamonSettings);
+        if (client->content == 0) {
+          webserver_send(client, 200, (char *)"text/plain", 0);
+          char *RESTmsg = (char *)client->userdata;
+          webserver_send_content(client, (char *)RESTmsg, strlen(RESTmsg));
+          free(RESTmsg);
+          client->userdata = NULL;
+        }
+      } break;
+    case WEBSERVER_CLIENT_CLOSE: {
+        if (client->userdata != NULL) {
+          free(client->userdata);
+        }
+      } break;
+  }
+  return 0;
+}
+
+static int8_t routeSaveSettings(struct webserver_t *client, void *dat) {
+  switch (client->step) {
+    case WEBSERVER_CLIENT_ARGS: {
+        return cacheSettings(client, (struct arguments_t *)dat, &heishamonSettings);
+      } break;
+    case WEBSERVER_CLIENT_WRITE: {
+        switch (client->route) {
+          case ROUTE_SAVESETTINGS: {
+              saveSettings(client, &heishamonSettings);
               #ifdef ESP8266
               if ((!heishamonSettings.opentherm) && (heishamonSettings.listenonly)) {
                 //make sure we disable TX to heatpump-RX using the mosfet so this line is floating and will not disturb cz-taw1
@@ -1373,80 +1347,24 @@ int8_t webserver_cb(struct webserver_t *client, void *dat) {
               }
               #endif
               switch (client->route) {
-                case 111: {
+                case ROUTE_SAVESETTINGS_WRONGPASSWORD: {
                     return settingsNewPassword(client, &heishamonSettings);
                   } break;
-                case 112: {
+                case ROUTE_SAVESETTINGS_RECONNECTWIFI: {
                     return settingsReconnectWifi(client, &heishamonSettings);
                   } break;
-                case 113: {
+                case ROUTE_SAVESETTINGS_DONE: {
                     webserver_send(client, 301, (char *)"text/plain", 0);
                   } break;
               }
               return 0;
             } break;
-          case 111: {
+          case ROUTE_SAVESETTINGS_WRONGPASSWORD: {
               return settingsNewPassword(client, &heishamonSettings);
             } break;
-          case 112: {
+          case ROUTE_SAVESETTINGS_RECONNECTWIFI: {
               return settingsReconnectWifi(client, &heishamonSettings);
             } break;
-          case 120: {
-              return handleSettings(client);
-            } break;
-          case 130: {
-              return getSettings(client, &heishamonSettings);
-            } break;
-          case 140: {
-              return showFirmware(client);
-            } break;
-          case 150: {
-              log_message((char*)"In /firmware client write part");
-              if (Update.isRunning()) {
-                if (Update.end(true)) {
-                  log_message((char*)"Firmware update success");
-                  timerqueue_insert(2, 0, -2); // Start reboot sequence
-                  return showFirmwareSuccess(client);
-                } else {
-                  Update.printError(loggingSerial);
-                  return showFirmwareFail(client);
-                }
-              }
-              return 0;
-            } break;
-          case 160: {
-              return showRules(client);
-            } break;
-#ifdef TLS_SUPPORT
-        case 165: {
-          if (client->userdata) {
-            File *pf = (File *)client->userdata;
-            pf->close();
-            delete pf;
-            client->userdata = NULL;
-          }
-          return handleCACert(client);
-        } break;
-        case 166: {
-          return showCACert(client);
-        } break; 
-#endif  
-          case 170: {
-              File *f = (File *)client->userdata;
-              if (f) {
-                if (*f) {
-                  f->close();
-                }
-                delete f;
-              }
-              client->userdata = NULL;
-              timerqueue_insert(0, 1, -4);
-              webserver_send(client, 301, (char *)"text/plain", 0);
-
-            } break;
-          case 180: {
-              if (heishamonSettings.use_1wire) rescanDallasSensors(log_message, heishamonSettings.dallasResolution);
-            } break;
           default: {
               webserver_send(client, 301, (char *)"text/plain", 0);
             } break;
@@ -1454,82 +1372,582 @@ int8_t webserver_cb(struct webserver_t *client, void *dat) {
         return -1;
       } break;
     case WEBSERVER_CLIENT_CREATE_HEADER: {
-        struct header_t *header = (struct header_t *)dat;
-        switch (client->route) {
-          case 113: {
-              header->ptr += sprintf_P((char *)header->buffer, PSTR("Location: /settings"));
-              return -1;
-            } break;
-          case 60:
-          case 70:
-          case 190: {
-              header->ptr += sprintf_P((char *)header->buffer, PSTR("Location: /"));
-              return -1;
-            } break;
-          case 80: {
-              header->ptr += sprintf_P((char *)header->buffer, 
-              PSTR("Location: http://192.168.4.1/settings"));
-              return -1;
-            } break;            
-          case 170: {
-              header->ptr += sprintf_P((char *)header->buffer, PSTR("Location: /rules"));
-              return -1;
-            } break;
-          default: {
-              if (client->route != 0) {
-                header->ptr += sprintf_P((char *)header->buffer, PSTR("Access-Control-Allow-Origin: *"));
-              }
-            } break;
+        if (client->route == ROUTE_SAVESETTINGS_DONE) {
+          struct header_t *header = (struct header_t *)dat;
+          header->ptr += sprintf_P((char *)header->buffer, PSTR("Location: /settings"));
+          return -1;
         }
-        return 0;
       } break;
     case WEBSERVER_CLIENT_CLOSE: {
-        switch (client->route) {
-          case 100: {
-              if (client->userdata != NULL) {
-                free(client->userdata);
-              }
-            } break;
-          case 110: {
-              struct websettings_t *tmp = NULL;
-              while (client->userdata) {
-                tmp = (struct websettings_t *)client->userdata;
-                client->userdata = ((struct websettings_t *)(client->userdata))->next;
-                free(tmp);
-              }
-            } break;
-          case 160:
-#ifdef TLS_SUPPORT
-          case 165:
+        if (client->userdata != NULL) { //the form was not saved
+          delete (struct websettings_t *)client->userdata;
+          client->userdata = NULL;
+        }
+      } break;
+  }
+  return 0;
+}
+
+static int8_t routeSettings(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    return handleSettings(client);
+  }
+  return 0;
+}
+
+static int8_t routeGetSettings(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    return getSettings(client, &heishamonSettings);
+  }
+  return 0;
+}
+
+static int8_t routeFirmware(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    return showFirmware(client);
+  }
+  return 0;
+}
+
+static int8_t routeFirmwareUpload(struct webserver_t *client, void *dat) {
+  switch (client->step) {
+    case WEBSERVER_CLIENT_REQUEST_URI: {
+        if (!Update.isRunning()) {
+#ifdef ESP8266
+          Update.runAsync(true);
 #endif
-          case 170: {
-              if (client->userdata != NULL) {
-                File *f = (File *)client->userdata;
-                if (f) {
-                  if (*f) {
-                    f->close();
-                  }
-                  delete f;
-                }
+          if (!Update.begin((ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000)) {
+            Update.printError(loggingSerial);
+            return -1;
+          }
+        } else {
+          loggingSerial.println(PSTR("New firmware update client, while previous isn't finished yet! Assume broken connection, abort!"));
+          Update.end();
+          return -1;
+        }
+      } break;
+    case WEBSERVER_CLIENT_ARGS: {
+        struct arguments_t *args = (struct arguments_t *)dat;
+        if (Update.isRunning() && (!Update.hasError())) {
+          if ((strcmp((char *)args->name, "md5") == 0) && (args->len > 0)) {
+            char md5[args->len + 1];
+            memset(&md5, 0, args->len + 1);
+            snprintf((char *)&md5, args->len + 1, "%.*s", args->len, args->value);
+            sprintf_P(log_msg, PSTR("Firmware MD5 expected: %s"), md5);
+            log_message(log_msg);
+            if (!Update.setMD5(md5)) {
+              log_message(_F("Failed to set expected update file MD5!"));
+              Update.end(false);
+            }
+          } else if (strcmp((char *)args->name, "firmware") == 0) {
+            if (Update.write((uint8_t *)args->value, args->len) != args->len) {
+              Update.printError(loggingSerial);
+              Update.end(false);
+            } else {
+              if (uploadpercentage != (unsigned int)(((float)client->readlen / (float)client->totallen) * 20)) {
+                uploadpercentage = (unsigned int)(((float)client->readlen / (float)client->totallen) * 20);
+                sprintf_P(log_msg, PSTR("Uploading new firmware: %d%%"), uploadpercentage * 5);
+                log_message(log_msg);
               }
-            } break;
+            }
+          }
+        } else {
+          log_message((char*)"New firmware POST data but update not running anymore!");
+        }
+      } break;
+    case WEBSERVER_CLIENT_WRITE: {
+        log_message((char*)"In /firmware client write part");
+        if (Update.isRunning()) {
+          if (Update.end(true)) {
+            log_message((char*)"Firmware update success");
+            timerqueue_insert(2, 0, -2); // Start reboot sequence
+            return showFirmwareSuccess(client);
+          } else {
+            Update.printError(loggingSerial);
+            return showFirmwareFail(client);
+          }
+        }
+      } break;
+  }
+  return 0;
+}
+
+static int8_t routeRules(struct webserver_t *client, void *dat) {
+  switch (client->step) {
+    case WEBSERVER_CLIENT_WRITE: {
+        return showRules(client);
+      } break;
+    case WEBSERVER_CLIENT_CLOSE: {
+        // reached from /saverules when the upload file could not be opened
+        File *f = (File *)client->userdata;
+        if (f) {
+          if (*f) {
+            f->close();
+          }
+          delete f;
+        }
+      } break;
+  }
+  return 0;
+}
+
+static int8_t routeSaveRules(struct webserver_t *client, void *dat) {
+  switch (client->step) {
+    case WEBSERVER_CLIENT_REQUEST_URI: {
+        if (persistMount()) {
+          LittleFS.remove("/rules.new");
+          client->userdata = new File(LittleFS.open("/rules.new", "a+"));
+        }
+      } break;
+    case WEBSERVER_CLIENT_ARGS: {
+        struct arguments_t *args = (struct arguments_t *)dat;
+        File *f = (File *)client->userdata;
+        if (!f || !*f) {
+          client->route = ROUTE_RULES;
+        } else {
+          f->write(args->value, args->len);
+        }
+      } break;
+    case WEBSERVER_CLIENT_WRITE: {
+        File *f = (File *)client->userdata;
+        if (f) {
+          if (*f) {
+            f->close();
+          }
+          delete f;
         }
         client->userdata = NULL;
+        timerqueue_insert(0, 1, -4);
+        webserver_send(client, 301, (char *)"text/plain", 0);
+        return -1;
       } break;
-      default: {
-        return 0;
+    case WEBSERVER_CLIENT_CREATE_HEADER: {
+        struct header_t *header = (struct header_t *)dat;
+        header->ptr += sprintf_P((char *)header->buffer, PSTR("Location: /rules"));
+        return -1;
+      } break;
+    case WEBSERVER_CLIENT_CLOSE: {
+        File *f = (File *)client->userdata;
+        if (f) {
+          if (*f) {
+            f->close();
+          }
+          delete f;
+        }
       } break;
   }
+  return 0;
+}
 
+#ifdef TLS_SUPPORT
+static int8_t routeCACertUpload(struct webserver_t *client, void *dat) {
+  switch (client->step) {
+    case WEBSERVER_CLIENT_REQUEST_URI: {
+        if (persistMount()) {
+          LittleFS.remove("/ca.tmp");
+          File cf = LittleFS.open("/ca.tmp", "w");
+          if (cf) {
+            client->userdata = new File(cf);
+          }
+          new_ca_stored = true;
+        }
+      } break;
+    case WEBSERVER_CLIENT_ARGS: {
+        struct arguments_t *args = (struct arguments_t *)dat;
+        File *f = (File *)client->userdata;
+        if (f && *f && args->len > 0) {
+          f->write((const uint8_t*)args->value, (size_t)args->len);
+        }
+      } break;
+    case WEBSERVER_CLIENT_WRITE: {
+        if (client->userdata) {
+          File *pf = (File *)client->userdata;
+          pf->close();
+          delete pf;
+          client->userdata = NULL;
+        }
+        return handleCACert(client);
+      } break;
+    case WEBSERVER_CLIENT_CLOSE: {
+        File *f = (File *)client->userdata;
+        if (f) {
+          if (*f) {
+            f->close();
+          }
+          delete f;
+        }
+      } break;
+  }
+  return 0;
+}
+
+static int8_t routeCACert(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    return showCACert(client);
+  }
+  return 0;
+}
+#endif
+
+static int8_t routeScanDallas(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    if (heishamonSettings.use_1wire) rescanDallasSensors(log_message, heishamonSettings.dallasResolution);
+    return -1;
+  }
   return 0;
 }
 
+// serial line counters and latency histograms in prometheus text format
+static int8_t routeMetrics(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    if (client->content == 0) {
+      webserver_send(client, 200, (char *)"text/plain; version=0.0.4", 0);
+    } else if (client->content == 1) {
+      String metrics;
+      metrics.reserve(1024);
+      metrics += F("# TYPE heishamon_uptime_seconds gauge\nheishamon_uptime_seconds ");
+      metrics += millis() / 1000;
+      metrics += F("\n# TYPE heishamon_serial_reads_total counter\nheishamon_serial_reads_total{result=\"good\"} ");
+      metrics += goodreads;
+      metrics += F("\nheishamon_serial_reads_total{result=\"bad_crc\"} ");
+      metrics += badcrcread;
+      metrics += F("\nheishamon_serial_reads_total{result=\"bad_header\"} ");
+      metrics += badheaderread;
+      metrics += F("\nheishamon_serial_reads_total{result=\"too_short\"} ");
+      metrics += tooshortread;
+      metrics += F("\nheishamon_serial_reads_total{result=\"too_long\"} ");
+      metrics += toolongread;
+      metrics += F("\nheishamon_serial_reads_total{result=\"timeout\"} ");
+      metrics += timeoutread;
+      metrics += F("\n# TYPE heishamon_serial_resyncs_total counter\nheishamon_serial_resyncs_total ");
+      metrics += heatpumpFramer.resyncs;
+      metrics += F("\n# TYPE heishamon_serial_queries_total counter\nheishamon_serial_queries_total{frame=\"main\"} ");
+      metrics += pollStats.mainQueries;
+      metrics += F("\nheishamon_serial_queries_total{frame=\"extra\"} ");
+      metrics += pollStats.extraQueries;
+      metrics += F("\n# TYPE heishamon_serial_bytes_total counter\nheishamon_serial_bytes_total{direction=\"tx\"} ");
+      metrics += pollStats.txBytes;
+      metrics += F("\nheishamon_serial_bytes_total{direction=\"rx\"} ");
+      metrics += pollStats.rxBytes;
+      metrics += F("\n# HELP heishamon_bus_busy_seconds_total Time the heatpump line carried data\n# TYPE heishamon_bus_busy_seconds_total counter\nheishamon_bus_busy_seconds_total ");
+      metrics += (float)(pollStats.txBytes + pollStats.rxBytes) * POLL_BYTE_TIME / 1000000.0;
+      metrics += F("\n# HELP heishamon_bus_busy_ratio Fraction of the last stats interval the heatpump line was busy\n# TYPE heishamon_bus_busy_ratio gauge\nheishamon_bus_busy_ratio ");
+      metrics += pollStats.utilisation / 100;
+      metrics += F("\n# TYPE heishamon_bus_idle_ratio gauge\nheishamon_bus_idle_ratio ");
+      metrics += 1 - pollStats.utilisation / 100;
+      metrics += F("\n# TYPE heishamon_uart_overruns_total counter\nheishamon_uart_overruns_total ");
+      metrics += uartRxStats.overruns;
+      metrics += F("\n");
+      webserver_send_content(client, (char *)metrics.c_str(), metrics.length());
+    } else if ((client->content - 2) < BUS_HISTOGRAMS) {
+      String metrics = busMetricsPrometheus(client->content - 2);
+      webserver_send_content(client, (char *)metrics.c_str(), metrics.length());
+    }
+  }
+  return 0;
+}
+
+// recorded raw frames, all segments oldest first
+static int8_t routeRawFrames(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_WRITE) {
+    if (client->content == 0) {
+      recorderFlush(); //include the frames still in memory
+      webserver_send(client, 200, (char *)"application/octet-stream", 0);
+    } else {
+      byte *chunk = (byte *)malloc(RECORDER_CHUNK_SIZE);
+      if (chunk != NULL) {
+        int length = recorderRead((unsigned long)(client->content - 1) * RECORDER_CHUNK_SIZE, chunk, RECORDER_CHUNK_SIZE);
+        if (length > 0) {
+          webserver_send_content(client, (char *)chunk, length);
+        }
+        free(chunk);
+      }
+    }
+  }
+  return 0;
+}
+
+struct historyQueryStruct {
+  int8_t topic;
+  int8_t tier; // -1 selects the tier reaching back to from
+  uint32_t from;
+  bool empty; // no block written yet
+  uint8_t block; // next block to write
+  bool done; // closing bracket written
+};
+
+// /history?topic=TOP5&from=<time>&tier=<0-2>, from below 0 is relative to now
+static int8_t routeHistory(struct webserver_t *client, void *dat) {
+  struct historyQueryStruct *query = (struct historyQueryStruct *)client->userdata;
+  switch (client->step) {
+    case WEBSERVER_CLIENT_REQUEST_URI: {
+        if ((client->userdata = malloc(sizeof(struct historyQueryStruct))) == NULL) {
+          loggingSerial.printf(PSTR("Out of memory %s:#%d\n"), __FUNCTION__, __LINE__);
+          ESP.restart();
+          exit(-1);
+        }
+        query = (struct historyQueryStruct *)client->userdata;
+        query->topic = -1;
+        query->tier = -1;
+        query->from = 0;
+        query->empty = true;
+        query->block = 0;
+        query->done = false;
+      } break;
+    case WEBSERVER_CLIENT_ARGS: {
+        struct arguments_t *args = (struct arguments_t *)dat;
+        char value[16];
+        snprintf(value, sizeof(value), "%.*s", args->len, args->value);
+        if (strcmp((char *)args->name, "topic") == 0) {
+          query->topic = historyTopic(value);
+        } else if (strcmp((char *)args->name, "from") == 0) {
+          long from = atol(value);
+          query->from = (from < 0) ? historyNow() + from : from;
+        } else if (strcmp((char *)args->name, "tier") == 0) {
+          query->tier = constrain(atoi(value), 0, HISTORY_TIERS - 1);
+        }
+      } break;
+    case WEBSERVER_CLIENT_WRITE: {
+        if (query->topic < 0) {
+          if (client->content == 0) {
+            webserver_send(client, 404, (char *)"text/plain", 13);
+            webserver_send_content_P(client, PSTR("Unknown topic"), 13);
+          }
+          break;
+        }
+        if (query->tier < 0) {
+          query->tier = historyTier(query->topic, query->from);
+        }
+        String text;
+        if (client->content == 0) {
+          webserver_send(client, 200, (char *)"application/json", 0);
+          text = F("{\"tier\":");
+          text += query->tier;
+          text += F(",\"interval\":");
+          text += historyInterval(query->tier);
+          text += F(",\"time\":");
+          text += historyNow();
+          text += F(",\"blocks\":[");
+        } else if (!query->done) {
+          // a step which sends nothing ends the response, so skip the unused blocks here
+          while ((text.length() == 0) && (query->block < historyBlockCount())) {
+            text = historyBlock(query->topic, query->tier, query->block++, query->from);
+          }
+          if (text.length() > 0) {
+            if (!query->empty) {
+              webserver_send_content_P(client, PSTR(","), 1);
+            }
+            query->empty = false;
+          } else {
+            text = F("]}");
+            query->done = true;
+          }
+        }
+        if (text.length() > 0) {
+          webserver_send_content(client, (char *)text.c_str(), text.length());
+        }
+      } break;
+    case WEBSERVER_CLIENT_CLOSE: {
+        if (client->userdata != NULL) {
+          free(client->userdata);
+          client->userdata = NULL;
+        }
+      } break;
+  }
+  return 0;
+}
+
+struct otTraceQueryStruct {
+  unsigned long next; // frame number to write next
+  unsigned long last; // frame count at the start of the request
+  bool empty; // no frame written yet
+  bool done; // closing bracket written
+};
+
+// recent OpenTherm frames with the time to handle and to answer them
+static int8_t routeOpenthermTrace(struct webserver_t *client, void *dat) {
+  struct otTraceQueryStruct *query = (struct otTraceQueryStruct *)client->userdata;
+  switch (client->step) {
+    case WEBSERVER_CLIENT_REQUEST_URI: {
+        if ((client->userdata = malloc(sizeof(struct otTraceQueryStruct))) == NULL) {
+          loggingSerial.printf(PSTR("Out of memory %s:#%d\n"), __FUNCTION__, __LINE__);
+          ESP.restart();
+          exit(-1);
+        }
+        query = (struct otTraceQueryStruct *)client->userdata;
+        query->last = otTraceCount();
+        query->next = (query->last > OTTRACE_SIZE) ? query->last - OTTRACE_SIZE : 0;
+        query->empty = true;
+        query->done = false;
+      } break;
+    case WEBSERVER_CLIENT_WRITE: {
+        String text;
+        if (client->content == 0) {
+          webserver_send(client, 200, (char *)"application/json", 0);
+          text = F("{");
+          text += otTraceJsonStats();
+          text += F(",\"frames\":[");
+          webserver_send_content(client, (char *)text.c_str(), text.length());
+          break;
+        }
+        if (query->done) {
+          break;
+        }
+        // a step which sends nothing ends the response, frames overwritten
+        // during the request are skipped here
+        unsigned long count = otTraceCount();
+        unsigned long oldest = (count > OTTRACE_SIZE) ? count - OTTRACE_SIZE : 0;
+        if (query->next < oldest) {
+          query->next = oldest;
+        }
+        while ((text.length() == 0) && (query->next < query->last)) {
+          unsigned long to = min(query->next + OTTRACE_CHUNK, query->last);
+          text = otTraceJsonFrames(query->next, to);
+          query->next = to;
+        }
+        if (text.length() > 0) {
+          if (!query->empty) {
+            webserver_send_content_P(client, PSTR(","), 1);
+          }
+          query->empty = false;
+        } else {
+          text = F("]}");
+          query->done = true;
+        }
+        if (text.length() > 0) {
+          webserver_send_content(client, (char *)text.c_str(), text.length());
+        }
+      } break;
+    case WEBSERVER_CLIENT_CLOSE: {
+        if (client->userdata != NULL) {
+          free(client->userdata);
+          client->userdata = NULL;
+        }
+      } break;
+  }
+  return 0;
+}
+
+static int8_t routeWebAsset(struct webserver_t *client, void *dat) {
+  switch (client->step) {
+    case WEBSERVER_CLIENT_REQUEST_URI: {
+        client->userdata = (void *)findWebAsset((char *)dat);
+        if (client->userdata == NULL) {
+          client->route = ROUTE_NOTFOUND;
+        }
+      } break;
+    case WEBSERVER_CLIENT_HEADER: {
+        if ((client->route == ROUTE_WEBASSET) && webAssetNotModified(client->userdata, (struct arguments_t *)dat)) {
+          client->route = ROUTE_WEBASSET_NOTMODIFIED; //browser has the current version cached, answer 304
+        }
+      } break;
+    case WEBSERVER_CLIENT_WRITE: {
+        return handleWebAsset(client);
+      } break;
+    case WEBSERVER_CLIENT_CREATE_HEADER: {
+        return webAssetHeaders(client, (struct header_t *)dat);
+      } break;
+  }
+  return 0;
+}
+
+// Every url the webserver answers. Routes without methods are only reached when a
+// handler moves the client to them while handling the request.
+static const webRouteStruct webRoutes[] PROGMEM = {
+  WEBROUTE("", WEBROUTE_INTERNAL, ROUTE_NOTFOUND, 0, routeNotFound),
+  WEBROUTE("/", WEBROUTE_ANY, ROUTE_ROOT, WEBROUTE_CORS, routeRoot),
+  WEBROUTE("/togglelog", WEBROUTE_ANY, ROUTE_TOGGLELOG, WEBROUTE_CORS, routeToggleLog),
+  WEBROUTE("/togglehexdump", WEBROUTE_ANY, ROUTE_TOGGLEHEXDUMP, WEBROUTE_CORS, routeToggleHexdump),
+  WEBROUTE("/json", WEBROUTE_ANY, ROUTE_JSON, WEBROUTE_CORS, routeJson),
+  WEBROUTE("/reboot", WEBROUTE_ANY, ROUTE_REBOOT, WEBROUTE_CORS, routeReboot),
+  WEBROUTE("/debug", WEBROUTE_ANY, ROUTE_DEBUG, WEBROUTE_CORS, routeDebug),
+  WEBROUTE("/wifiscan", WEBROUTE_ANY, ROUTE_WIFISCAN, WEBROUTE_CORS, routeWifiScan),
+  WEBROUTE("/dallasalias", WEBROUTE_ANY, ROUTE_DALLASALIAS, 0, routeDallasAlias),
+  WEBROUTE("/removedallas", WEBROUTE_ANY, ROUTE_REMOVEDALLAS, 0, routeRemoveDallas),
+  //for Android/Windows devices
+  WEBROUTE("/connecttest.txt", WEBROUTE_ANY, ROUTE_CAPTIVEPORTAL, 0, routeCaptivePortal),
+  WEBROUTE("/ncsi.txt", WEBROUTE_ANY, ROUTE_CAPTIVEPORTAL, 0, routeCaptivePortal),
+  WEBROUTE("/redirect", WEBROUTE_ANY, ROUTE_CAPTIVEPORTAL, 0, routeCaptivePortal),
+  WEBROUTE("/fwlink", WEBROUTE_ANY, ROUTE_CAPTIVEPORTAL, 0, routeCaptivePortal),
+  WEBROUTE("/generate_204", WEBROUTE_ANY, ROUTE_CAPTIVEPORTAL, 0, routeCaptivePortal),
+  WEBROUTE("/gen_204", WEBROUTE_ANY, ROUTE_CAPTIVEPORTAL, 0, routeCaptivePortal),
+  WEBROUTE("/popup", WEBROUTE_ANY, ROUTE_CAPTIVEPORTAL, 0, routeCaptivePortal),
+  //for Apple devices
+  WEBROUTE("/hotspot-detect.html", WEBROUTE_ANY, ROUTE_CAPTIVEPORTAL_APPLE, WEBROUTE_CORS, routeCaptivePortalApple),
+  WEBROUTE("/factoryreset", WEBROUTE_ANY, ROUTE_FACTORYRESET, WEBROUTE_CORS, routeFactoryReset),
+  WEBROUTE("/command", WEBROUTE_ANY, ROUTE_COMMAND, WEBROUTE_CORS, routeCommand),
+  WEBROUTE("/savesettings", WEBROUTE_POST, ROUTE_SAVESETTINGS, WEBROUTE_CORS, routeSaveSettings),
+  WEBROUTE("", WEBROUTE_INTERNAL, ROUTE_SAVESETTINGS_WRONGPASSWORD, WEBROUTE_CORS, routeSaveSettings),
+  WEBROUTE("", WEBROUTE_INTERNAL, ROUTE_SAVESETTINGS_RECONNECTWIFI, WEBROUTE_CORS, routeSaveSettings),
+  WEBROUTE("", WEBROUTE_INTERNAL, ROUTE_SAVESETTINGS_DONE, 0, routeSaveSettings),
+  WEBROUTE("/saverules", WEBROUTE_POST, ROUTE_SAVERULES, 0, routeSaveRules),
+  WEBROUTE("/firmware", WEBROUTE_POST, ROUTE_FIRMWARE_UPLOAD, WEBROUTE_CORS, routeFirmwareUpload),
+  WEBROUTE("/firmware", WEBROUTE_GET, ROUTE_FIRMWARE, WEBROUTE_CORS, routeFirmware),
+  WEBROUTE("/settings", WEBROUTE_GET, ROUTE_SETTINGS, WEBROUTE_CORS, routeSettings),
+  WEBROUTE("/getsettings", WEBROUTE_GET, ROUTE_GETSETTINGS, WEBROUTE_CORS, routeGetSettings),
+  WEBROUTE("/rules", WEBROUTE_GET, ROUTE_RULES, WEBROUTE_CORS, routeRules),
+#ifdef TLS_SUPPORT
+  WEBROUTE("/cacert", WEBROUTE_POST, ROUTE_CACERT_UPLOAD, WEBROUTE_CORS, routeCACertUpload),
+  WEBROUTE("/cacert", WEBROUTE_GET, ROUTE_CACERT, WEBROUTE_CORS, routeCACert),
+#endif
+  WEBROUTE("/scandallas", WEBROUTE_GET, ROUTE_SCANDALLAS, WEBROUTE_CORS, routeScanDallas),
+  WEBROUTE("/metrics", WEBROUTE_GET, ROUTE_METRICS, WEBROUTE_CORS, routeMetrics),
+  WEBROUTE("/rawframes", WEBROUTE_GET, ROUTE_RAWFRAMES, 0, routeRawFrames),
+  WEBROUTE("/history", WEBROUTE_GET, ROUTE_HISTORY, WEBROUTE_CORS, routeHistory),
+  WEBROUTE("/opentherm/trace", WEBROUTE_GET, ROUTE_OPENTHERM_TRACE, WEBROUTE_CORS, routeOpenthermTrace),
+  WEBROUTE("/static/", WEBROUTE_GET, ROUTE_WEBASSET, WEBROUTE_PREFIX, routeWebAsset),
+  WEBROUTE("", WEBROUTE_INTERNAL, ROUTE_WEBASSET_NOTMODIFIED, 0, routeWebAsset),
+};
+
+#define NUMBER_OF_WEBROUTES (sizeof(webRoutes) / sizeof(webRoutes[0]))
+static_assert(NUMBER_OF_WEBROUTES <= WEBROUTE_MAX, "raise WEBROUTE_MAX");
+
+static webRouteIndexStruct webRouteIndex;
+
+int8_t webserver_cb(struct webserver_t *client, void *dat) {
+  if (client->step == WEBSERVER_CLIENT_REQUEST_URI) {
+    client->routeidx = findWebRoute(webRoutes, &webRouteIndex, client->method, (char *)dat);
+    if (client->routeidx == WEBROUTE_NONE) {
+      client->route = ROUTE_NOTFOUND;
+      // a request body is only accepted by the POST routes
+      return (client->method == 1) ? -1 : 0;
+    }
+    client->route = pgm_read_byte(&webRoutes[client->routeidx].route);
+  } else if ((client->routeidx >= NUMBER_OF_WEBROUTES) || (pgm_read_byte(&webRoutes[client->routeidx].route) != client->route)) {
+    // the handler moved the client to another route
+    client->routeidx = findWebRouteById(webRoutes, NUMBER_OF_WEBROUTES, client->route);
+    if (client->routeidx == WEBROUTE_NONE) {
+      if (client->step == WEBSERVER_CLIENT_WRITE) {
+        webserver_send(client, 301, (char *)"text/plain", 0);
+        return -1;
+      }
+      return 0;
+    }
+  }
+
+  const webRouteStruct *route = &webRoutes[client->routeidx];
+  if ((client->step == WEBSERVER_CLIENT_CREATE_HEADER) && (pgm_read_byte(&route->flags) & WEBROUTE_CORS)) {
+    struct header_t *header = (struct header_t *)dat;
+    header->ptr += sprintf_P((char *)header->buffer, PSTR("Access-Control-Allow-Origin: *"));
+    return 0;
+  }
+
+  webRouteHandler_t *handler = (webRouteHandler_t *)pgm_read_ptr(&route->handler);
+  int8_t ret = handler(client, dat);
+  if (client->step == WEBSERVER_CLIENT_CLOSE) {
+    client->userdata = NULL;
+  }
+  return ret;
+}
+
 void setupHttp() {
+  buildWebRouteIndex(webRoutes, NUMBER_OF_WEBROUTES, &webRouteIndex);
   webserver_start(80, &webserver_cb, 0);
 }
 
 void factoryReset() {
     loggingSerial.println("Factory reset request detected, clearing config."); 
+    persistDiscard();
     LittleFS.format();
     //create first boot file
     File startupFile = LittleFS.open("/heishamon", "w");
@@ -1601,6 +2019,7 @@ void switchSerial() {
   //serial to cn-cnt
   heatpumpSerial.flush();
   heatpumpSerial.end();
+  heatpumpSerial.setRxBufferSize(UART_RX_DRIVER_SIZE); //hold the bytes arriving while loop() is busy
   heatpumpSerial.begin(9600, SERIAL_8E1); //on normal tx/rx esp8266
   heatpumpSerial.flush();
   //swap to gpio13 (D7) and gpio15 (D8)
@@ -1612,6 +2031,7 @@ void switchSerial() {
   // need to create new serial startup config for ESP32
   heatpumpSerial.flush();
   heatpumpSerial.end();
+  heatpumpSerial.setRxBufferSize(UART_RX_DRIVER_SIZE);
   heatpumpSerial.begin(9600, SERIAL_8E1,HEATPUMPRX,HEATPUMPTX);
   heatpumpSerial.flush();
   proxySerial.flush();
@@ -1620,7 +2040,9 @@ void switchSerial() {
   proxySerial.flush();  
 #endif
 
-  setupGPIO(heishamonSettings.gpioSettings); //switch extra GPIOs to configured mode
+  uartRxBegin(heatpumpSerial);
+
+  setupGPIO(heishamonSettings.gpioSettings, heishamonSettings.opentherm); //switch extra GPIOs to configured mode
 
   //mosfet output enable
   pinMode(ENABLEPIN, OUTPUT);
@@ -1632,7 +2054,7 @@ void switchSerial() {
 
   //try to detect if cz-taw1 is connected in parallel
   if (!heishamonSettings.listenonly) {
-    if (heatpumpSerial.available() > 0) {
+    if ((heatpumpSerial.available() > 0) || (uartRxAvailable() > 0)) {
       log_message(_F("There is data on the line without asking for it. Switching to listen only mode."));
       heishamonSettings.listenonly = true;
     }
@@ -1645,7 +2067,8 @@ void switchSerial() {
 }
 
 void setupMqtt() {
-  mqtt_client.setBufferSize(1024);
+  mqtt_client.setBufferSize(MQTT_BUFFER_SIZE);
+  mqttQueueSetBase(heishamonSettings.mqtt_topic_base);
 #ifdef TLS_SUPPORT
   mqtt_client.setSocketTimeout(8); mqtt_client.setKeepAlive(30); //fast timeout, any slower than 10s will block the main loop too long (8s might be even safer to avoid reboots on bad wifi); short keepalive may lead to problems with TLS
   if (heishamonSettings.mqtt_tls_enabled) {
@@ -1668,10 +2091,19 @@ void setupMqtt() {
 }
 
 void setupConditionals() {
+  //flash writes wait for a quiet heatpump line
+  persistBegin(persistBusy);
+
+  //continue the raw frame recording behind the segments already in flash
+  recorderBegin(heishamonSettings.recordFrames);
+
+  //on-device history of the configured topics
+  historyBegin(heishamonSettings.historyTopics, heishamonSettings.historyFlush);
 
 #ifdef ESP32
   pcbQueue = xQueueCreate(1, OPTIONALPCBQUERYSIZE);
   cmdQueue = xQueueCreate(MAXCOMMANDSINBUFFER, sizeof(cmdbuffer_t));
+  proxyQueue = xQueueCreate(PROXY_QUEUE_SIZE, sizeof(cmdbuffer_t));
   logQueue = xQueueCreate(4, LOG_MSG_SIZE);
   
   xTaskCreatePinnedToCore(
@@ -1699,14 +2131,18 @@ void setupConditionals() {
     //insert on task queue
     xQueueOverwrite(pcbQueue, optionalPCBQuery);
 #else
-    delay(1500); //need 1.5 sec delay before sending first datagram
-    send_optionalpcb_query(); //send one datagram already at start
-    lastOptionalPCBRunTime = millis();
+    if (heishamonSettings.fastBoot) {
+      lastOptionalPCBRunTime = millis() + 1500 - OPTIONALPCBQUERYTIME; //loop() sends the first datagram after the 1.5 sec delay
+    } else {
+      delay(1500); //need 1.5 sec delay before sending first datagram
+      send_optionalpcb_query(); //send one datagram already at start
+      lastOptionalPCBRunTime = millis();
+    }
 #endif
   }
 
   //these two after optional pcb because it needs to send a datagram fast after boot
-  if (heishamonSettings.use_1wire) initDallasSensors(log_message, heishamonSettings.updataAllDallasTime, heishamonSettings.waitDallasTime, heishamonSettings.dallasResolution);
+  if (heishamonSettings.use_1wire) initDallasSensors(log_message, heishamonSettings.updataAllDallasTime, heishamonSettings.waitDallasTime, heishamonSettings.dallasResolution, !bootDeferPending);
   if (heishamonSettings.use_s0) initS0Sensors(heishamonSettings.s0Settings);
 
 
@@ -1718,6 +2154,7 @@ void timer_cb(int nr) {
   } else {
     switch (nr) {
       case -1: {
+          persistDiscard(); //queued files must not end up in the formatted flash
           LittleFS.begin();
           LittleFS.format();
           //create first boot file
@@ -1727,6 +2164,7 @@ void timer_cb(int nr) {
           timerqueue_insert(1, 0, -2);
         } break;
       case -2: {
+          persistFlush(NULL); //queued files first, nothing after a factory reset
           ESP.restart();
         } break;
       case -3: {
@@ -1743,7 +2181,7 @@ void timer_cb(int nr) {
             log_message(_F("Failed to load new rules, reverting back to older rules!"));
             rules_parse((char*)"/rules.txt");
           } else {
-            if (LittleFS.begin()) {
+            if (persistMount()) {
               LittleFS.rename("/rules.new", "/rules.txt");
             }
           }
@@ -1796,7 +2234,7 @@ void setup() {
   //first boot check, to visually confirm good flash
   //this also formats the littlefs if necessary
 #if defined(ESP8266)
-  if (LittleFS.begin()) {
+  if (persistMount()) {
 #else
   loggingSerial.println(F("Starting littlefs..."));
   if (LittleFS.begin(true)) {
@@ -1838,6 +2276,7 @@ void setup() {
 #endif      
     }
   }
+  bootMark(BOOT_FS);
   //double reset detect from start - removed, using boot button now
   //loggingSerial.println(F("Check for double reset..."));
   //doubleResetDetect();
@@ -1849,6 +2288,18 @@ void setup() {
 
   loggingSerial.println(F("Loading config from flash..."));
   loadSettings(&heishamonSettings);
+  bootMark(BOOT_SETTINGS);
+
+  //a fast boot reads the heatpump before the network is set up
+  bootStats.fastBoot = heishamonSettings.fastBoot;
+  bootDeferPending = heishamonSettings.fastBoot;
+  if (heishamonSettings.fastBoot) {
+    loggingSerial.println(F("Fast boot, switch serial..."));
+    switchSerial(); //switch serial to gpio13/gpio15
+    bootMark(BOOT_SERIAL);
+    setupConditionals();
+    bootMark(BOOT_CONDITIONALS);
+  }
 
   loggingSerial.println(F("Setup wifi..."));
   setupWifi(&heishamonSettings);
@@ -1858,26 +2309,32 @@ void setup() {
   loggingSerial.println(F("Setup ethernet module..."));
   setupETH();
 #endif
+  bootMark(BOOT_WIFI);
 
   loggingSerial.println(F("Setup HTTP..."));
   setupHttp();
+  bootMark(BOOT_HTTP);
 
-  loggingSerial.println(F("Setup SNTP..."));
-  sntp_stop();
-  sntp_setoperatingmode(SNTP_OPMODE_POLL);
-  sntp_init();
+  if (!bootDeferPending) {
+    setupSNTP();
+  }
 
   loggingSerial.println(F("Setup MQTT..."));
   setupMqtt();
+  bootMark(BOOT_MQTT_SETUP);
 
-  loggingSerial.println(F("Switch serial..."));
-  switchSerial(); //switch serial to gpio13/gpio15
+  if (!heishamonSettings.fastBoot) {
+    loggingSerial.println(F("Switch serial..."));
+    switchSerial(); //switch serial to gpio13/gpio15
+    bootMark(BOOT_SERIAL);
 
-  loggingSerial.println(F("Sending new wifi diag..."));
-  WiFi.printDiag(loggingSerial);
+    loggingSerial.println(F("Sending new wifi diag..."));
+    WiFi.printDiag(loggingSerial);
 
-  loggingSerial.println(F("Settings conditionals..."));
-  setupConditionals(); //setup for routines based on settings
+    loggingSerial.println(F("Settings conditionals..."));
+    setupConditionals(); //setup for routines based on settings
+    bootMark(BOOT_CONDITIONALS);
+  }
 
   loggingSerial.println(F("Settings DNS..."));
   dnsServer.setErrorReplyCode(DNSReplyCode::NoError);
@@ -1894,8 +2351,36 @@ void setup() {
     digitalWrite(ENABLEOTPIN, HIGH);
     #endif
     HeishaOTSetup();
+    bootMark(BOOT_OPENTHERM);
   }
 
+  if (!bootDeferPending) {
+    setupRules();
+    delay(200); //small delay to allow double reset
+  }
+  #ifdef ESP32
+  //turn off neopixel to indicate end of setup
+  neoPixelState = pixels.Color(0,0,0);
+  pixels.setPixelColor(0, neoPixelState);
+  pixels.show(); 
+  #endif
+  //end of setup, clear double reset flag
+  //loggingSerial.println(F("Clearing double reset flag.."));
+  //LittleFS.remove("/doublereset");  
+  //loggingSerial.println(F("End of setup.."));
+
+  inSetup = false;
+  bootMark(BOOT_SETUP);
+}
+
+void setupSNTP() {
+  loggingSerial.println(F("Setup SNTP..."));
+  sntp_stop();
+  sntp_setoperatingmode(SNTP_OPMODE_POLL);
+  sntp_init();
+}
+
+void setupRules() {
   loggingSerial.println(F("Enabling rules.."));
   if (heishamonSettings.force_rules == false) {
 #if defined(ESP8266)
@@ -1916,20 +2401,39 @@ void setup() {
     rules_parse((char *)"/rules.txt");
     rules_boot();
   }
+  bootMark(BOOT_RULES);
+}
 
-  delay(200); //small delay to allow double reset
-  #ifdef ESP32
-  //turn off neopixel to indicate end of setup
-  neoPixelState = pixels.Color(0,0,0);
-  pixels.setPixelColor(0, neoPixelState);
-  pixels.show(); 
-  #endif
-  //end of setup, clear double reset flag
-  //loggingSerial.println(F("Clearing double reset flag.."));
-  //LittleFS.remove("/doublereset");  
-  //loggingSerial.println(F("End of setup.."));
+// The work a fast boot left for later, done after the first heatpump read
+// or after BOOT_DEFER_TIMEOUT if none arrives
+void bootDeferredSetup() {
+  bootDeferPending = false;
+  log_message(_F("Fast boot: running the deferred setup"));
+  if (heishamonSettings.use_1wire) rescanDallasSensors(log_message, heishamonSettings.dallasResolution);
+  setupRules();
+  if (!bootReached(BOOT_NETWORK)) setupSNTP(); //ntpReload already did this on the first connect
+  bootMark(BOOT_DEFERRED);
+}
 
-  inSetup = false;
+// a frame waits for its answer, flash writes would delay it
+bool persistBusy() {
+  return sending;
+}
+
+// value of a topic for the history, only while its data block is fresh
+bool historyValue(bool extra, uint8_t topic, float *value) {
+  if (extra) {
+    if ((topic >= NUMBER_OF_TOPICS_EXTRA) || (actDataExtra[0] != 0x71) || ((unsigned long)(millis() - actDataExtraTime) > HISTORY_STALE)) {
+      return false;
+    }
+    *value = getDataValueExtra(actDataExtra, topic).toFloat();
+  } else {
+    if ((topic >= NUMBER_OF_TOPICS) || (actData[0] != 0x71) || ((unsigned long)(millis() - actDataTime) > HISTORY_STALE)) {
+      return false;
+    }
+    *value = getDataValue(actData, topic).toFloat();
+  }
+  return true;
 }
 
 void send_initial_query() {
@@ -1941,13 +2445,14 @@ void send_initial_query() {
 void send_panasonic_query() {
   log_message(_F("Requesting new panasonic data"));
   send_command(panasonicQuery, PANASONICQUERYSIZE);
-  // rest is for the new data block on new models
-  if (extraDataBlockAvailable) {
-    log_message(_F("Requesting new panasonic extra data"));
-    panasonicQuery[3] = 0x21; //setting 4th byte to 0x21 is a request for extra block
-    send_command(panasonicQuery, PANASONICQUERYSIZE);
-    panasonicQuery[3] = 0x10; //setting 4th back to 0x10 for normal data request next time
-  }
+}
+
+// the new data block on new models
+void send_panasonic_extra_query() {
+  log_message(_F("Requesting new panasonic extra data"));
+  panasonicQuery[3] = 0x21; //setting 4th byte to 0x21 is a request for extra block
+  send_command(panasonicQuery, PANASONICQUERYSIZE);
+  panasonicQuery[3] = 0x10; //setting 4th back to 0x10 for normal data request next time
 }
 
 #ifdef ESP8266
@@ -1960,19 +2465,24 @@ void send_optionalpcb_query() {
 void readHeatpump() {
   if (sending && ((unsigned long)(millis() - sendCommandReadTime) > SERIALTIMEOUT)) {
     log_message(_F("Previous read data attempt failed due to timeout!"));
-    sprintf_P(log_msg, PSTR("Received %d bytes data"), data_length);
+    sprintf_P(log_msg, PSTR("Received %d bytes data"), heatpumpFramer.length);
     log_message(log_msg);
-    if (heishamonSettings.logHexdump) logHex(data, data_length);
-    if (data_length == 0) {
+    if (heishamonSettings.logHexdump) logHex((char *)heatpumpFramer.data, heatpumpFramer.length);
+    if (heatpumpFramer.length == 0) {
       timeoutread++;
       totalreads++; //at at timeout we didn't receive anything but did expect it so need to increase this for the stats
     } else {
+      totalreads++;
       tooshortread++;
     }
-    data_length = 0; //clear any data in array
+    serialFramerReset(&heatpumpFramer); //clear any data in array
     sending = false; //receiving the answer from the send command timed out, so we are allowed to send a new command
   }
-  if ( (heishamonSettings.listenonly || sending) && (heatpumpSerial.available() > 0)) readSerial();
+#ifdef ESP8266
+  uartRxFill(heatpumpSerial); //the ESP32 fills the ring from the uart event task
+#endif
+  //unsolicited data is parsed too, it would otherwise be the start of the next answer
+  if (uartRxAvailable() > 0) readSerial();
 }
 
 void checkBootButton() {
@@ -1986,6 +2496,64 @@ void checkBootButton() {
   }
 }
 
+// Each counter group has its own stats topic, so every message stays below
+// STATS_PAYLOAD_SIZE. The formats are checked against it with all values at
+// their longest.
+#define STATS_FITS(format, values) static_assert(sizeof(format) + (values) * STATS_VALUE_LEN <= STATS_PAYLOAD_SIZE, "stats group too long")
+
+#define STATS_FORMAT_MQTT "{\"mqtt queue length\":%u,\"mqtt queue peak bytes\":%u,\"mqtt coalesced\":%lu,\"mqtt dropped\":%lu,\"mqtt failed\":%lu,\"mqtt max latency\":%lu,\"mqtt avg latency\":%lu,\"mqtt commands\":%lu,\"mqtt commands coalesced\":%lu,\"mqtt command max latency\":%lu}"
+STATS_FITS(STATS_FORMAT_MQTT, 10);
+#define STATS_FORMAT_POLL "{\"poll state\":%u,\"main queries\":%lu,\"extra queries\":%lu,\"read backs\":%lu,\"state transitions\":%lu,\"bus utilisation\":%.2f,\"merged settings\":%lu,\"write frames\":%lu,\"resyncs\":%lu,\"uart overruns\":%lu,\"uart peak\":%u,\"rtt main\":%lu,\"rtt extra\":%lu,\"rtt optional pcb\":%lu,\"rtt command\":%lu}"
+STATS_FITS(STATS_FORMAT_POLL, 15);
+#define STATS_FORMAT_FLASH "{\"flash writes\":%lu,\"flash unchanged\":%lu,\"flash deferred\":%lu,\"flash max write time\":%lu,\"history memory\":%lu}"
+STATS_FITS(STATS_FORMAT_FLASH, 5);
+#define STATS_FORMAT_GPIO "{\"gpio events\":%lu,\"gpio edges\":%lu,\"gpio max latency\":%lu}"
+STATS_FITS(STATS_FORMAT_GPIO, 3);
+#define STATS_FORMAT_1WIRE "{\"1wire sensors\":%u,\"1wire conversion time\":%lu,\"1wire max slice\":%lu}"
+STATS_FITS(STATS_FORMAT_1WIRE, 3);
+#define STATS_FORMAT_RECORDER "{\"recorded frames\":%lu,\"recorded bytes\":%lu,\"recorder flash bytes\":%lu,\"recorder dropped\":%lu}"
+STATS_FITS(STATS_FORMAT_RECORDER, 4);
+#define STATS_FORMAT_PROXY "{\"proxy reads\":%lu,\"proxy cached\":%lu,\"proxy deduplicated\":%lu,\"proxy polled\":%lu,\"proxy late\":%lu,\"proxy forwarded\":%lu,\"proxy timeouts\":%lu,\"proxy max latency\":%lu,\"proxy avg latency\":%lu}"
+STATS_FITS(STATS_FORMAT_PROXY, 9);
+
+static void publishStatsGroup(const char *group, const char *payload) {
+  char topic[sizeof(heishamonSettings.mqtt_topic_base) + 16];
+  snprintf_P(topic, sizeof(topic), PSTR("%s/stats/%s"), heishamonSettings.mqtt_topic_base, group);
+  mqttQueuePublish(topic, payload, MQTT_QUEUE_COALESCE | MQTT_QUEUE_LOW | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
+}
+
+void publishStatsGroups() {
+  char payload[STATS_PAYLOAD_SIZE];
+  snprintf_P(payload, sizeof(payload), PSTR(STATS_FORMAT_MQTT), mqttQueueStats.length, mqttQueueStats.peakBytes,
+    mqttQueueStats.coalesced, mqttQueueStats.dropped, mqttQueueStats.failed, mqttQueueStats.maxLatency, mqttQueueStats.avgLatency,
+    commandInboxStats.received, commandInboxStats.coalesced, commandInboxStats.maxLatency);
+  publishStatsGroup("mqtt", payload);
+  snprintf_P(payload, sizeof(payload), PSTR(STATS_FORMAT_POLL), (unsigned int)pollStats.state, pollStats.mainQueries,
+    pollStats.extraQueries, pollStats.readbacks, pollStats.transitions, pollStats.utilisation,
+    writeMergeStats.settings, writeMergeStats.frames, heatpumpFramer.resyncs, uartRxStats.overruns, uartRxStats.peak,
+    pollStats.rtt[POLL_FRAME_MAIN].avg, pollStats.rtt[POLL_FRAME_EXTRA].avg, pollStats.rtt[POLL_FRAME_PCB].avg, pollStats.rtt[POLL_FRAME_COMMAND].avg);
+  publishStatsGroup("poll", payload);
+  snprintf_P(payload, sizeof(payload), PSTR(STATS_FORMAT_FLASH), persistStats.writes, persistStats.unchanged,
+    persistStats.deferred, persistStats.maxTime, historyStats.memory);
+  publishStatsGroup("flash", payload);
+  snprintf_P(payload, sizeof(payload), PSTR(STATS_FORMAT_GPIO), gpioStats.events, gpioStats.edges, gpioStats.maxLatency);
+  publishStatsGroup("gpio", payload);
+  if (heishamonSettings.use_1wire) {
+    snprintf_P(payload, sizeof(payload), PSTR(STATS_FORMAT_1WIRE), dallasStats.sensors, dallasStats.lastConversion, dallasStats.maxSlice);
+    publishStatsGroup("1wire", payload);
+  }
+  if (heishamonSettings.recordFrames) {
+    snprintf_P(payload, sizeof(payload), PSTR(STATS_FORMAT_RECORDER), recorderStats.frames, recorderStats.bytes,
+      recorderStats.written, recorderStats.dropped);
+    publishStatsGroup("recorder", payload);
+  }
+#ifdef ESP32
+  snprintf_P(payload, sizeof(payload), PSTR(STATS_FORMAT_PROXY), proxyStats.reads, proxyStats.cached, proxyStats.deduplicated,
+    proxyStats.polled, proxyStats.late, proxyStats.forwarded, proxyStats.timeouts, proxyStats.maxLatency, proxyStats.avgLatency);
+  publishStatsGroup("proxy", payload);
+#endif
+}
+
 void loop() {
   //check boot button state
   checkBootButton();
@@ -1995,10 +2563,16 @@ void loop() {
 
   // check wifi
   check_wifi();
+  //a fast boot connects to mqtt as soon as the network is up instead of at the next housekeeping run
+  if (bootStats.fastBoot && (lastMqttReconnectAttempt == 0) && bootReached(BOOT_NETWORK) && (strlen(heishamonSettings.mqtt_server) > 0)) mqtt_reconnect();
   // Handle OTA first.s
   ArduinoOTA.handle();
 
   mqtt_client.loop();
+  mqttQueueLoop(mqtt_client, MQTT_QUEUE_LOOP_BUDGET);
+  recorderLoop();
+  historyLoop(historyValue);
+  persistLoop();
 
   if (heishamonSettings.opentherm) {
     HeishaOTLoop(actData, mqtt_client, heishamonSettings.mqtt_topic_base);
@@ -2016,6 +2590,26 @@ void loop() {
   }
 #endif
 
+  //handle the queued mqtt commands and send the merged settings once the line is free
+  commandInboxLoop(send_setting_command, log_message);
+  {
+    byte writeCommand[PANASONICQUERYSIZE];
+    unsigned long queued;
+#ifdef ESP8266
+    if ((!sending) && takeWriteCommand(writeCommand, &queued)) {
+      transmit_command(writeCommand, PANASONICQUERYSIZE, queued);
+    }
+#else
+    if ((uxQueueMessagesWaiting(cmdQueue) == 0) && takeWriteCommand(writeCommand, &queued)) {
+      struct cmdbuffer_t cmd;
+      cmd.length = PANASONICQUERYSIZE;
+      memcpy(&cmd.data, writeCommand, PANASONICQUERYSIZE);
+      cmd.queued = queued;
+      xQueueSend(cmdQueue, &cmd, 0);
+    }
+#endif
+  }
+
 #ifdef ESP8266
   if ((!sending) && (cmdnrel > 0)) { //check if there is a send command in the buffer
     log_message(_F("Sending command from buffer"));
@@ -2034,25 +2628,37 @@ void loop() {
 
   if (heishamonSettings.use_s0) s0Loop(mqtt_client, log_message, heishamonSettings.mqtt_topic_base, heishamonSettings.s0Settings);
 
+  gpioLoop(heishamonSettings.mqtt_topic_base);
+
+  if (bootDeferPending && ((goodreads > 0) || (millis() > BOOT_DEFER_TIMEOUT))) bootDeferredSetup();
+  bootLoop(mqtt_client, heishamonSettings.mqtt_topic_base);
+
 #ifdef ESP8266
 //this only runs on ESP8266, the ESP32 does this in vTask
   if ((!sending) && (!heishamonSettings.listenonly) && (heishamonSettings.optionalPCB) && ((unsigned long)(millis() - lastOptionalPCBRunTime) > OPTIONALPCBQUERYTIME) ) {
     lastOptionalPCBRunTime = millis();
     send_optionalpcb_query();
-    if ((unsigned long)(millis() - lastOptionalPCBSave) > (1000 * OPTIONALPCBSAVETIME)) {  // only save each 5 minutes
-      lastOptionalPCBSave = millis();
-      if (saveOptionalPCB(optionalPCBQuery, OPTIONALPCBQUERYSIZE)) {
-        log_message((char*)"Succesfully saved optional PCB data to flash!");
-      } else {
-        log_message((char*)"Failed to save optional PCB data to flash!");
-      }
+    if (!saveOptionalPCB(optionalPCBQuery, OPTIONALPCBQUERYSIZE)) {  // written to flash when changed, at most each 5 minutes
+      log_message((char*)"Failed to queue optional PCB data for flash!");
+    }
+  }
+#endif
+
+#ifdef ESP8266
+  //query the heatpump at the rate of its current state, the ESP32 does this in vTask
+  if ((!sending) && (!heishamonSettings.listenonly) && (cmdnrel == 0)) {
+    if (pollMainDue(heishamonSettings.waitTime, heishamonSettings.waitTimeIdle)) {
+      send_panasonic_query();
+    } else if (extraDataBlockAvailable && pollExtraDue(heishamonSettings.waitTime, heishamonSettings.waitTimeIdle, heishamonSettings.waitTimeExtra)) {
+      send_panasonic_extra_query();
     }
   }
 #endif
 
-  // run the data query only each WAITTIME
+  // run the housekeeping only each WAITTIME
   if ((unsigned long)(millis() - lastRunTime) > (1000 * heishamonSettings.waitTime)) {
     lastRunTime = millis();
+    pollUpdateUtilisation();
     //check mqtt
   #ifdef ESP8266
     if ( WiFi.isConnected() && (!mqtt_client.connected()) )
@@ -2168,7 +2774,14 @@ void loop() {
     stats += nrrules;
     stats += F("}");
     sprintf_P(mqtt_topic, PSTR("%s/stats"), heishamonSettings.mqtt_topic_base);
-    mqtt_client.publish(mqtt_topic, stats.c_str(), MQTT_RETAIN_VALUES);
+    if (stats.length() <= STATS_PAYLOAD_SIZE) {
+      mqttQueuePublish(mqtt_topic, stats.c_str(), MQTT_QUEUE_COALESCE | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
+    } else {
+      log_message(_F("Stats do not fit in one MQTT message"));
+    }
+    publishStatsGroups();
+    sprintf_P(mqtt_topic, PSTR("%s/stats/bus"), heishamonSettings.mqtt_topic_base);
+    mqttQueuePublish(mqtt_topic, busMetricsCompact().c_str(), MQTT_QUEUE_COALESCE | MQTT_QUEUE_LOW | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
 
     //websocket stats
 #ifdef ESP32
@@ -2199,14 +2812,9 @@ void loop() {
     
     websocket_write_all(log_msg, strlen(log_msg));        
 
-#ifdef ESP8266
-    //get new data
-    if (!heishamonSettings.listenonly) send_panasonic_query();
-#endif
-
     //Make sure the LWT is set to Online, even if the broker have marked it dead.
     sprintf_P(mqtt_topic, PSTR("%s/%s"), heishamonSettings.mqtt_topic_base, mqtt_willtopic);
-    mqtt_client.publish(mqtt_topic, "Online");
+    mqttQueuePublish(mqtt_topic, "Online", MQTT_QUEUE_COALESCE);
 
 #ifdef ESP8266
     if (WiFi.isConnected()) {
@@ -1,8 +1,7 @@
 #include "src/opentherm/opentherm.h"
 #include "HeishaOT.h"
-#include "decode.h"
+#include "ottrace.h"
 #include "rules.h"
-#include "webfunctions.h"
 #include "src/common/stricmp.h"
 #include "src/common/progmem.h"
 
@@ -48,630 +47,363 @@ struct heishaOTDataStruct_t heishaOTDataStruct[] = {
 
 void mqttPublish(char* topic, char* subtopic, char* value, bool retain);
 void mqttPublish(char* topic, char* subtopic, char* value);
+void log_message(char* string);
 
-struct heishaOTDataStruct_t *getOTStructMember(const char *name) {
-  int i = 0;
-  while(heishaOTDataStruct[i].name != NULL) {
-    if(strcmp(heishaOTDataStruct[i].name, name) == 0) {
-      return &heishaOTDataStruct[i];
+#define OT_READ 1 // the thermostat reads the data id
+#define OT_WRITE 2 // the thermostat writes the data id
+#define OT_CODEC_F88 0 // value slot as signed 8.8 fixed point
+#define OT_CODEC_S8S8 1 // two value slots as signed bytes, high and low
+#define OT_CODEC_CUSTOM 2 // data built by a handler
+
+// Slot of a value by its name, for mqtt
+int8_t otValueSlot(const char *name) {
+  for (uint8_t i = 0; i < OT_VALUES; i++) {
+    if (strcmp(heishaOTDataStruct[i].name, name) == 0) {
+      return i;
     }
-    i++;
   }
-  return NULL;
+  return -1;
 }
 
-void processOTRequest(unsigned long request, OpenThermResponseStatus status) {
- if (status != OpenThermResponseStatus::SUCCESS) {
-    log_message(_F("OpenTherm: Request invalid!"));
-    char log_msg[512];
-    sprintf_P(log_msg, PSTR("OpenTherm: Unknown data ID: %u (%#010lx)"), (unsigned int)ot.getDataID(request), request);
-    log_message(log_msg);    
- } else {
-  char log_msg[512];
-  {
-    //only for debugging OT messages
-    //char str[200];
-    //sprintf_P(str, PSTR("%#010x"), request);
-    //mqttPublish((char*)mqtt_topic_opentherm_write, _F("raw"), str, false);
+static void otValueString(uint8_t slot, char *str, uint8_t decimals) {
+  switch (heishaOTDataStruct[slot].type) {
+    case TBOOL: strcpy_P(str, heishaOTDataStruct[slot].value.b ? PSTR("true") : PSTR("false")); break;
+    case TFLOAT: sprintf_P(str, PSTR("%.*f"), decimals, heishaOTDataStruct[slot].value.f); break;
+    case TINT8: sprintf_P(str, PSTR("%d"), heishaOTDataStruct[slot].value.s8); break;
   }
-  switch (ot.getDataID(request)) {
-    case OpenThermMessageID::Status: { //mandatory
-        unsigned long data = ot.getUInt(request);
-        unsigned int CHEnable = (data >> 8) & (1 << 0);
-        unsigned int DHWEnable = ((data >> 8) & (1 << 1)) >> 1;
-        unsigned int Cooling = ((data >> 8) & (1 << 2)) >> 2;
-        unsigned int OTCEnable = ((data >> 8) & (1 << 3)) >> 3;
-        unsigned int CH2Enable = ((data >> 8) & (1 << 4)) >> 4;
-        unsigned int SWMode = ((data >> 8) & (1 << 5)) >> 5;
-        unsigned int DHWBlock = ((data >> 8) & (1 << 6)) >> 6;
-
-        if ((bool)CHEnable != getOTStructMember(_F("chEnable"))->value.b) { //only publish if changed
-          getOTStructMember(_F("chEnable"))->value.b = (bool)CHEnable;
-          CHEnable ? mqttPublish((char*)mqtt_topic_opentherm_write, _F("chEnable"), _F("true")) : mqttPublish((char*)mqtt_topic_opentherm_write, _F("chEnable"), _F("false")) ;
-          sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %s}}}"), _F("chEnable"), CHEnable ? _F("true") : _F("false"));
-          websocket_write_all(log_msg, strlen(log_msg));
-        }
-        if ((bool)DHWEnable != getOTStructMember(_F("dhwEnable"))->value.b) { //only publish if changed
-          getOTStructMember(_F("dhwEnable"))->value.b = (bool)DHWEnable;
-          DHWEnable ? mqttPublish((char*)mqtt_topic_opentherm_write, _F("dhwEnable"), _F("true")) : mqttPublish((char*)mqtt_topic_opentherm_write, _F("dhwEnable"), _F("false")) ;
-          sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %s}}}"), _F("dhwEnable"), DHWEnable ? _F("true") : _F("false"));
-          websocket_write_all(log_msg, strlen(log_msg));
-        }
-        if ((bool)Cooling != getOTStructMember(_F("coolingEnable"))->value.b) { //only publish if changed
-          getOTStructMember(_F("coolingEnable"))->value.b = (bool)Cooling;
-          Cooling ? mqttPublish((char*)mqtt_topic_opentherm_write, _F("coolingEnable"), _F("true")) : mqttPublish((char*)mqtt_topic_opentherm_write, _F("coolingEnable"), _F("false")) ;
-          sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %s}}}"), _F("coolingEnable"), Cooling ? _F("true") : _F("false"));
-          websocket_write_all(log_msg, strlen(log_msg));
-        }
-
-        sprintf_P(log_msg, PSTR(
-                "OpenTherm: Received status check: %lu, CH: %u, DHW: %u, Cooling, %u, OTC: %u, CH2: %u, SWMode: %u, DHWBlock: %u"),
-                data >> 8, CHEnable, DHWEnable, Cooling, OTCEnable, CH2Enable, SWMode, DHWBlock
-               );
-        log_message(log_msg);
-        //clean slave bits from 2-byte data
-        data = ((data >> 8) << 8);
-
-        unsigned int FaultInd = false;
-        unsigned int CHMode = (unsigned int)getOTStructMember(_F("chState"))->value.b;
-        unsigned int FlameStatus = (unsigned int)getOTStructMember(_F("flameState"))->value.b;
-        unsigned int DHWMode = (unsigned int)getOTStructMember(_F("dhwState"))->value.b;
-        unsigned int CoolingStatus = (unsigned int)getOTStructMember(_F("coolingState"))->value.b;;
-        unsigned int CH2 = false;
-        unsigned int DiagInd = false;
-        sprintf_P(log_msg,
-                PSTR("OpenTherm: Send status: CH: %d, Flame:%d, DHW: %d"),
-                CHMode, FlameStatus, DHWMode
-               );
-        log_message(log_msg);
-        unsigned int responsedata = FaultInd | (CHMode << 1) | (DHWMode << 2) | (FlameStatus << 3) | (CoolingStatus << 4) | (CH2 << 5) | (DiagInd << 6);
-        otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::Status, (data |= responsedata));
-        rules_event_cb(_F("?"), _F("chEnable"));
-        rules_event_cb(_F("?"), _F("dhwEnable"));
-        rules_event_cb(_F("?"), _F("coolingEnable"));
-      } break;
-    case OpenThermMessageID::TSet: { //mandatory
-        char str[200];
-        sprintf_P((char *)&str, PSTR("%.*f"), 4, ot.getFloat(request));
-        sprintf_P(log_msg, PSTR("OpenTherm: control setpoint TSet: %s"), str);
-        log_message(log_msg);
-        if (getOTStructMember(_F("chSetpoint"))->value.f != ot.getFloat(request)) { //only publish if changed
-          getOTStructMember(_F("chSetpoint"))->value.f = ot.getFloat(request);
-          mqttPublish((char*)mqtt_topic_opentherm_write, _F("chSetpoint"), str);
-          sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("chSetpoint"), getOTStructMember(_F("chSetpoint"))->value.f);
-          websocket_write_all(log_msg, strlen(log_msg));
-        }
-        otResponse = ot.buildResponse(OpenThermMessageType::WRITE_ACK, OpenThermMessageID::TSet, request & 0xffff);
-        rules_event_cb(_F("?"), _F("chsetpoint"));
-      } break;
-      case OpenThermMessageID::MConfigMMemberIDcode: {
-      unsigned long data = ot.getUInt(request);
-      unsigned int SmartPower = (data >> 8) & (1 << 0);
-      data &= ~(1 << 8); //disable smartpower for now, we don't support it yet
-      sprintf_P(log_msg,
-			  PSTR("OpenTherm: Received master config: %u, Smartpower: %u"),
-              data >> 8, SmartPower
-             );
-      log_message(log_msg);
-      otResponse = ot.buildResponse(OpenThermMessageType::WRITE_ACK, OpenThermMessageID::MConfigMMemberIDcode, data);
-      //ot.setSmartPower((bool)SmartPower); not working correctly yet
-      } break;
-    case OpenThermMessageID::SConfigSMemberIDcode: { //mandatory
-        log_message(_F("OpenTherm: Received read slave config"));
-        unsigned int DHW = true;
-        unsigned int ModulationOrOnOff = false; //false means modulation according to specification v2.2
-        unsigned int Cool = true;
-        unsigned int DHWConf = false;
-        unsigned int Pump = false;
-        unsigned int CH2 = false; // no 2nd zone yet
-
-        unsigned int data = DHW | (ModulationOrOnOff << 1) | (Cool << 2) | (DHWConf << 3) | (Pump << 4) | (CH2 << 5);
-        data <<= 8;
-        otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::SConfigSMemberIDcode, data);
-
-      } break;
-    case OpenThermMessageID::MaxRelModLevelSetting: { //mandatory
-        char str[200];
-        sprintf_P((char *)&str, PSTR("%.*f"), 4, ot.getFloat(request));
-        sprintf_P(log_msg, PSTR("OpenTherm: Max relative modulation  requested: %s"), str);
-        log_message(log_msg);
-        if (getOTStructMember(_F("maxRelativeModulation"))->value.f != ot.getFloat(request)) {
-          getOTStructMember(_F("maxRelativeModulation"))->value.f = ot.getFloat(request);
-          if ( getOTStructMember(_F("relativeModulation"))->value.f > getOTStructMember(_F("maxRelativeModulation"))->value.f) { //need to change the relative modulation on the fly to comply with max requested
-            getOTStructMember(_F("relativeModulation"))->value.f = getOTStructMember(_F("maxRelativeModulation"))->value.f;
-          }
-          mqttPublish((char*)mqtt_topic_opentherm_write, _F("maxRelativeModulation"), str);
-          sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("maxRelativeModulation"), getOTStructMember(_F("maxRelativeModulation"))->value.f);
-          websocket_write_all(log_msg, strlen(log_msg));          
-        }
-        otResponse = ot.buildResponse(OpenThermMessageType::WRITE_ACK, OpenThermMessageID::MaxRelModLevelSetting, request & 0xffff); //ACK for mandatory fields
-      } break;
-    case OpenThermMessageID::RelModLevel: { //mandatory
-        log_message(_F("OpenTherm: Received read relative modulation level"));
-        if ((getOTStructMember(_F("relativeModulation"))->value.f >= 0) && (getOTStructMember(_F("relativeModulation"))->value.f <= 100) ) {
-          unsigned long data = ot.temperatureToData(getOTStructMember(_F("relativeModulation"))->value.f);
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::RelModLevel, data);
-
-        } else {
-          otResponse = ot.buildResponse(OpenThermMessageType::DATA_INVALID, OpenThermMessageID::RelModLevel, request & 0xffff);
-        }        
-      } break;
-    case OpenThermMessageID::Tboiler: { //mandatory
-        log_message(_F("OpenTherm: Received read boiler flow temp (outlet)"));
-        if (getOTStructMember(_F("outletTemp"))->value.f > -99) {
-          unsigned long data = ot.temperatureToData(getOTStructMember(_F("outletTemp"))->value.f);
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::Tboiler, data);
-
-        } else {
-          otResponse = ot.buildResponse(OpenThermMessageType::DATA_INVALID, OpenThermMessageID::Tboiler, request & 0xffff);
-        }
-      } break;
-    // now adding some more useful, not mandatory, types
-    case OpenThermMessageID::RBPflags: { //Pre-Defined Remote Boiler Parameters
-        log_message(_F("OpenTherm: Received Remote Boiler parameters request"));
-        //fixed settings for now
-        const unsigned int DHWsetTransfer = true;
-        const unsigned int maxCHsetTransfer = true;
-        const unsigned int DHWsetReadWrite = true;
-        const unsigned int maxCHsetReadWrite = true;
-        const unsigned int responsedata = DHWsetReadWrite | (maxCHsetReadWrite << 1) | (DHWsetTransfer << 8) | (maxCHsetTransfer << 9);
-        otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::RBPflags, responsedata);
-      } break;
-    case OpenThermMessageID::CoolingControl: { //mandatory
-        char str[200];
-        sprintf_P((char *)&str, PSTR("%.*f"), 4, ot.getFloat(request));
-        sprintf_P(log_msg, PSTR("OpenTherm: cooling control amount requested: %s"), str);
-        log_message(log_msg);
-        if (getOTStructMember(_F("coolingControl"))->value.f != ot.getFloat(request)) {
-          getOTStructMember(_F("coolingControl"))->value.f = ot.getFloat(request);  
-          mqttPublish((char*)mqtt_topic_opentherm_write, _F("coolingControl"), str);
-          sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("coolingControl"), getOTStructMember(_F("coolingControl"))->value.f);
-          websocket_write_all(log_msg, strlen(log_msg));
-        }
-        otResponse = ot.buildResponse(OpenThermMessageType::WRITE_ACK, OpenThermMessageID::CoolingControl, request & 0xffff);
-        rules_event_cb(_F("?"), _F("coolingControl"));
-      } break;
-    case OpenThermMessageID::TdhwSetUBTdhwSetLB : { //DHW boundaries
-        log_message(_F("OpenTherm: Received DHW set boundaries request"));
-        uint16_t result = 0;
-        result |= ((getOTStructMember(_F("dhwSetUppBound"))->value.s8 & 0xFF) << 8); 
-        result |= (getOTStructMember(_F("dhwSetLowBound"))->value.s8 & 0xFF);
-        otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::TdhwSetUBTdhwSetLB, result);
-      } break;
-    case OpenThermMessageID::MaxTSetUBMaxTSetLB  : { //CHset boundaries
-        log_message(_F("OpenTherm: Received CH set boundaries request"));
-        uint16_t result = 0;
-        result |= ((getOTStructMember(_F("chSetUppBound"))->value.s8 & 0xFF) << 8); 
-        result |= (getOTStructMember(_F("chSetLowBound"))->value.s8 & 0xFF);     
-        otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::MaxTSetUBMaxTSetLB, result);
-      } break;
-    case OpenThermMessageID::Tr: {
-        char str[200];
-        sprintf_P((char *)&str, PSTR("%.*f"), 4, ot.getFloat(request));
-        sprintf_P(log_msg, PSTR("OpenTherm: Room temp: %s"), str);
-        log_message(log_msg);
-        if (getOTStructMember(_F("roomTemp"))->value.f != ot.getFloat(request)) {
-          mqttPublish((char*)mqtt_topic_opentherm_write, _F("roomTemp"), str);
-          getOTStructMember(_F("roomTemp"))->value.f = ot.getFloat(request);
-          sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("roomTemp"), getOTStructMember(_F("roomTemp"))->value.f);
-          websocket_write_all(log_msg, strlen(log_msg));
-        }
-        otResponse = ot.buildResponse(OpenThermMessageType::WRITE_ACK, OpenThermMessageID::Tr, request & 0xffff);
-        rules_event_cb(_F("?"), _F("roomtemp"));
-      } break;
-    case OpenThermMessageID::TrSet: {
-        char str[200];
-        sprintf_P((char *)&str, PSTR("%.*f"), 4, ot.getFloat(request));
-        sprintf_P(log_msg, PSTR("OpenTherm: Room setpoint: %s"), str);
-        log_message(log_msg);
-        if (getOTStructMember(_F("roomTempSet"))->value.f != ot.getFloat(request)) {
-          getOTStructMember(_F("roomTempSet"))->value.f = ot.getFloat(request);
-          mqttPublish((char*)mqtt_topic_opentherm_write, _F("roomTempSet"), str);
-          sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("roomTempSet"), getOTStructMember(_F("roomTempSet"))->value.f);
-          websocket_write_all(log_msg, strlen(log_msg));          
-        }
-        otResponse = ot.buildResponse(OpenThermMessageType::WRITE_ACK, OpenThermMessageID::TrSet, request & 0xffff);
-        rules_event_cb(_F("?"), _F("roomtempset"));
-      } break;
-    case OpenThermMessageID::TdhwSet: {
-        if (ot.getMessageType(request) == OpenThermMessageType::WRITE_DATA) {
-          char str[200];
-          sprintf_P((char *)&str, PSTR("%.*f"), 4, ot.getFloat(request));
-          sprintf_P(log_msg, PSTR("OpenTherm: Write request DHW setpoint: %s"), str);
-          log_message(log_msg);
-          if (getOTStructMember(_F("dhwSetpoint"))->value.f != ot.getFloat(request)) {
-            getOTStructMember(_F("dhwSetpoint"))->value.f = ot.getFloat(request);
-            mqttPublish((char*)mqtt_topic_opentherm_write, _F("dhwSetpoint"), str);    
-            sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("dhwSetpoint"), getOTStructMember(_F("dhwSetpoint"))->value.f);
-            websocket_write_all(log_msg, strlen(log_msg));                      
-          }
-          otResponse = ot.buildResponse(OpenThermMessageType::WRITE_ACK, OpenThermMessageID::TdhwSet, ot.temperatureToData(getOTStructMember(_F("dhwSetpoint"))->value.f));
-        } else { //READ_DATA
-          sprintf_P(log_msg, PSTR("OpenTherm: Read request DHW setpoint"));
-          log_message(log_msg);
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::TdhwSet, ot.temperatureToData(getOTStructMember(_F("dhwSetpoint"))->value.f));
-          rules_event_cb(_F("?"), _F("dhwsetpoint"));
-        } 
-      } break;
-    case OpenThermMessageID::MaxTSet: {
-        if (ot.getMessageType(request) == OpenThermMessageType::WRITE_DATA) {
-          char str[200];
-          sprintf_P((char *)&str, PSTR("%.*f"), 4, ot.getFloat(request));
-          sprintf_P(log_msg, PSTR("OpenTherm: Write request Max Ta-set setpoint: %s"), str);
-          log_message(log_msg);
-          if (getOTStructMember(_F("maxTSet"))->value.f != ot.getFloat(request)) {
-            getOTStructMember(_F("maxTSet"))->value.f = ot.getFloat(request);
-            mqttPublish((char*)mqtt_topic_opentherm_write, _F("maxTSet"), str);
-            sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("maxTSet"), getOTStructMember(_F("maxTSet"))->value.f);
-            websocket_write_all(log_msg, strlen(log_msg));                       
-          }
-          otResponse = ot.buildResponse(OpenThermMessageType::WRITE_ACK, OpenThermMessageID::MaxTSet, ot.temperatureToData(getOTStructMember(_F("maxTSet"))->value.f));
-        } else { //READ_DATA
-          sprintf_P(log_msg, PSTR("OpenTherm: Read request Max Ta-set setpoint"));
-          log_message(log_msg);
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::MaxTSet, ot.temperatureToData(getOTStructMember(_F("maxTSet"))->value.f));
-          rules_event_cb(_F("?"), _F("maxtset"));
-        }
-      } break;
-    case OpenThermMessageID::Tret: {
-        log_message(_F("OpenTherm: Received read boiler flow temp (inlet)"));
-        if (getOTStructMember(_F("inletTemp"))->value.f > -99) {
-          unsigned long data = ot.temperatureToData(getOTStructMember(_F("inletTemp"))->value.f);
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::Tret, data);
-        } else {
-          otResponse = ot.buildResponse(OpenThermMessageType::DATA_INVALID, OpenThermMessageID::Tret, request & 0xffff);
-        }
-      } break;
-    case OpenThermMessageID::Tdhw: {
-        log_message(_F("OpenTherm: Received read DHW temp"));
-        if (getOTStructMember(_F("dhwTemp"))->value.f > -99) {
-          unsigned long data = ot.temperatureToData(getOTStructMember(_F("dhwTemp"))->value.f);
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::Tdhw, data);
-        } else {
-          otResponse = ot.buildResponse(OpenThermMessageType::DATA_INVALID, OpenThermMessageID::Tdhw, request & 0xffff);
-        }
-      } break;
-    case OpenThermMessageID::CHPressure: {
-        log_message(_F("OpenTherm: Received read water pressure"));
-        if (getOTStructMember(_F("chPressure"))->value.f > -99) {
-          unsigned long data = ot.temperatureToData(getOTStructMember(_F("chPressure"))->value.f);
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::CHPressure, data);
-
-        } else {
-          otResponse = ot.buildResponse(OpenThermMessageType::DATA_INVALID, OpenThermMessageID::CHPressure, request & 0xffff);
-        }
-      } break;      
-    case OpenThermMessageID::Toutside: {
-        log_message(_F("OpenTherm: Received read outside temp"));
-        if (getOTStructMember(_F("outsideTemp"))->value.f > -99) {
-          unsigned long data = ot.temperatureToData(getOTStructMember(_F("outsideTemp"))->value.f);
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::Toutside, data);
-
-        } else {
-          otResponse = ot.buildResponse(OpenThermMessageType::DATA_INVALID, OpenThermMessageID::Toutside, request & 0xffff);
-        }
-      } break;
-    case OpenThermMessageID::TrOverride: {
-        log_message(_F("OpenTherm: Received read room set override temp"));
-        if (getOTStructMember(_F("roomSetOverride"))->value.f > -99) {
-          unsigned long data = ot.temperatureToData(getOTStructMember(_F("roomSetOverride"))->value.f);
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::TrOverride, data);
-
-        } else {
-          otResponse = ot.buildResponse(OpenThermMessageType::DATA_INVALID, OpenThermMessageID::TrOverride, request & 0xffff);
-        }
-      } break;
-    //for date/time requests we don't store anything, just answer the time we know from heishamon  
-    //still need to confirm this works correctly. Haven't seen a thermostat which does ask for the time and use it
-    case OpenThermMessageID::DayTime: {
-        if (ot.getMessageType(request) == OpenThermMessageType::READ_DATA) {
-          log_message(_F("OpenTherm: Received time request"));
-          time_t rawtime;
-          rawtime = time(NULL);
-          struct tm *timeinfo = localtime(&rawtime);
-          uint16_t result = 0;
-          result |= ((((timeinfo->tm_wday + 6) % 7 + 1) & 0x07) << 13);  // Set weekday in the leftmost 3 bits (16 - 3 = 13).  Opentherm counting monday=1, sunday=7
-          result |= ((timeinfo->tm_hour & 0x1F) << 8);     // Set hours in the next 5 bits (13 - 5 = 8)
-          result |= (timeinfo->tm_min & 0xFF);          // Set minutes in the rightmost 8 bits
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::DayTime, result);
-        } else {
-          log_message(_F("OpenTherm: Ignore time information set"));
-          otResponse = ot.buildResponse(OpenThermMessageType::WRITE_ACK, ot.getDataID(request), 0);
-        }
-      } break;    
-    case OpenThermMessageID::Date: {
-        if (ot.getMessageType(request) == OpenThermMessageType::READ_DATA) {
-          log_message(_F("OpenTherm: Received date request"));
-          time_t rawtime;
-          rawtime = time(NULL);
-          struct tm *timeinfo = localtime(&rawtime);
-          uint16_t result = 0;
-          result |= (((timeinfo->tm_mon + 1) & 0xFF) << 8);  // Set month in the leftmost 8 bits. Month + 1 for opentherm counting from 1=january
-          result |= (timeinfo->tm_mday & 0xFF);        // Set day of month in the rightmost 8 bits
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::Date, result);
-        } else {
-          log_message(_F("OpenTherm: Ignore date information set"));
-          otResponse = ot.buildResponse(OpenThermMessageType::WRITE_ACK, ot.getDataID(request), 0);
-        }
-      } break;
-    case OpenThermMessageID::Year: {
-        if (ot.getMessageType(request) == OpenThermMessageType::READ_DATA) {
-          log_message(_F("OpenTherm: Received year request"));
-          time_t rawtime;
-          rawtime = time(NULL);
-          struct tm *timeinfo = localtime(&rawtime);
-          uint16_t result = timeinfo->tm_year + 1900; //plus 1900 makes it the real year
-          otResponse = ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::Year, result);
-        } else {
-          log_message(_F("OpenTherm: Ignore year information set"));
-          otResponse = ot.buildResponse(OpenThermMessageType::WRITE_ACK, ot.getDataID(request), 0);
-        }
-      } break;    
-    default: {
-        sprintf_P(log_msg, PSTR("OpenTherm: Unknown data ID: %u (%#010lx)"), (unsigned int)ot.getDataID(request), request);
-        log_message(log_msg);
-        otResponse = ot.buildResponse(OpenThermMessageType::UNKNOWN_DATA_ID, ot.getDataID(request), 0);
-      } break;
+}
+
+static void otWebsocketValue(uint8_t slot) {
+  char str[48];
+  char msg[128];
+  otValueString(slot, str, 2);
+  sprintf_P(msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %s}}}"), heishaOTDataStruct[slot].name, str);
+  websocket_write_all(msg, strlen(msg));
+}
+
+static void otPublishValue(uint8_t slot) {
+  char str[48];
+  otValueString(slot, str, 4);
+  mqttPublish((char*)mqtt_topic_opentherm_write, (char*)heishaOTDataStruct[slot].name, str);
+  otWebsocketValue(slot);
+}
+
+// Keeps values within the bounds given by other values
+static void otClampValue(uint8_t slot) {
+  heishaOTDataStruct_t *v = heishaOTDataStruct;
+  switch (slot) {
+    case OT_RELATIVE_MODULATION:
+    case OT_MAX_RELATIVE_MODULATION: //need to change the relative modulation on the fly to comply with max requested
+      if ((v[OT_MAX_RELATIVE_MODULATION].value.f > -99) && (v[OT_RELATIVE_MODULATION].value.f > v[OT_MAX_RELATIVE_MODULATION].value.f)) {
+        v[OT_RELATIVE_MODULATION].value.f = v[OT_MAX_RELATIVE_MODULATION].value.f;
+      }
+      break;
+    case OT_MAX_TSET:
+      if (v[OT_MAX_TSET].value.f > v[OT_CH_SET_UPP_BOUND].value.s8) {
+        v[OT_MAX_TSET].value.f = v[OT_CH_SET_UPP_BOUND].value.s8;
+      } else if (v[OT_MAX_TSET].value.f < v[OT_CH_SET_LOW_BOUND].value.s8) {
+        v[OT_MAX_TSET].value.f = v[OT_CH_SET_LOW_BOUND].value.s8;
+      }
+      break;
+    case OT_DHW_SET_UPP_BOUND:
+      if (v[OT_DHW_SET_UPP_BOUND].value.s8 < v[OT_DHW_SET_LOW_BOUND].value.s8) v[OT_DHW_SET_UPP_BOUND].value.s8 = v[OT_DHW_SET_LOW_BOUND].value.s8;
+      break;
+    case OT_DHW_SET_LOW_BOUND:
+      if (v[OT_DHW_SET_LOW_BOUND].value.s8 > v[OT_DHW_SET_UPP_BOUND].value.s8) v[OT_DHW_SET_LOW_BOUND].value.s8 = v[OT_DHW_SET_UPP_BOUND].value.s8;
+      break;
+    case OT_CH_SET_UPP_BOUND:
+      if (v[OT_CH_SET_UPP_BOUND].value.s8 < v[OT_CH_SET_LOW_BOUND].value.s8) v[OT_CH_SET_UPP_BOUND].value.s8 = v[OT_CH_SET_LOW_BOUND].value.s8;
+      break;
+    case OT_CH_SET_LOW_BOUND:
+      if (v[OT_CH_SET_LOW_BOUND].value.s8 > v[OT_CH_SET_UPP_BOUND].value.s8) v[OT_CH_SET_LOW_BOUND].value.s8 = v[OT_CH_SET_UPP_BOUND].value.s8;
+      break;
   }
- }
 }
 
-void IRAM_ATTR handleOTInterrupt() {
-  ot.handleInterrupt();
+// the thermostat only gets values we know
+static bool otValueValid(uint8_t slot) {
+  float value = heishaOTDataStruct[slot].value.f;
+  if (slot == OT_RELATIVE_MODULATION) {
+    return (value >= 0) && (value <= 100);
+  }
+  return value > -99;
 }
 
-void HeishaOTSetup() {
-  ot.begin(handleOTInterrupt, processOTRequest);
+// f8.8 with sign, so an outside temperature below zero is sent as such
+static unsigned int otFloatToData(float value) {
+  long data = lround(value * 256);
+  if (data > 32767) data = 32767;
+  if (data < -32768) data = -32768;
+  return (uint16_t)data;
 }
 
-void HeishaOTLoop(char * actData, PubSubClient &mqtt_client, char* mqtt_topic_base) {
-  // opentherm loop
-  if (otResponse && ot.isReady()) {
-    ot.sendResponse(otResponse);
-    otResponse = 0;
+static void otWriteFlag(uint8_t slot, bool value) {
+  if (heishaOTDataStruct[slot].value.b != value) { //only publish if changed
+    heishaOTDataStruct[slot].value.b = value;
+    otPublishValue(slot);
   }
-  ot.process();
 }
 
-void mqttOTCallback(char* topic, char* value) {
-  char log_msg[512];
-  if (strcmp_P(topic,PSTR("chPressure")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'chPressure'"));
-    getOTStructMember(_F("chPressure"))->value.f = String(value).toFloat();
-    rules_event_cb(_F("?"), topic);
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("chPressure"), getOTStructMember(_F("chPressure"))->value.f); websocket_write_all(log_msg, strlen(log_msg));    
+static unsigned long otStatus(unsigned long request) {
+  char log_msg[256];
+  unsigned long data = ot.getUInt(request);
+  unsigned int CHEnable = (data >> 8) & (1 << 0);
+  unsigned int DHWEnable = ((data >> 8) & (1 << 1)) >> 1;
+  unsigned int Cooling = ((data >> 8) & (1 << 2)) >> 2;
+  unsigned int OTCEnable = ((data >> 8) & (1 << 3)) >> 3;
+  unsigned int CH2Enable = ((data >> 8) & (1 << 4)) >> 4;
+  unsigned int SWMode = ((data >> 8) & (1 << 5)) >> 5;
+  unsigned int DHWBlock = ((data >> 8) & (1 << 6)) >> 6;
+
+  otWriteFlag(OT_CH_ENABLE, CHEnable);
+  otWriteFlag(OT_DHW_ENABLE, DHWEnable);
+  otWriteFlag(OT_COOLING_ENABLE, Cooling);
+
+  sprintf_P(log_msg, PSTR(
+          "OpenTherm: Received status check: %lu, CH: %u, DHW: %u, Cooling, %u, OTC: %u, CH2: %u, SWMode: %u, DHWBlock: %u"),
+          data >> 8, CHEnable, DHWEnable, Cooling, OTCEnable, CH2Enable, SWMode, DHWBlock
+         );
+  log_message(log_msg);
+  //clean slave bits from 2-byte data
+  data = ((data >> 8) << 8);
+
+  unsigned int FaultInd = false;
+  unsigned int CHMode = (unsigned int)heishaOTDataStruct[OT_CH_STATE].value.b;
+  unsigned int FlameStatus = (unsigned int)heishaOTDataStruct[OT_FLAME_STATE].value.b;
+  unsigned int DHWMode = (unsigned int)heishaOTDataStruct[OT_DHW_STATE].value.b;
+  unsigned int CoolingStatus = (unsigned int)heishaOTDataStruct[OT_COOLING_STATE].value.b;
+  unsigned int CH2 = false;
+  unsigned int DiagInd = false;
+  sprintf_P(log_msg,
+          PSTR("OpenTherm: Send status: CH: %d, Flame:%d, DHW: %d"),
+          CHMode, FlameStatus, DHWMode
+         );
+  log_message(log_msg);
+  unsigned int responsedata = FaultInd | (CHMode << 1) | (DHWMode << 2) | (FlameStatus << 3) | (CoolingStatus << 4) | (CH2 << 5) | (DiagInd << 6);
+  rules_event_cb(_F("?"), heishaOTDataStruct[OT_CH_ENABLE].name);
+  rules_event_cb(_F("?"), heishaOTDataStruct[OT_DHW_ENABLE].name);
+  rules_event_cb(_F("?"), heishaOTDataStruct[OT_COOLING_ENABLE].name);
+  return ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::Status, (data |= responsedata));
+}
+
+static unsigned long otMasterConfig(unsigned long request) {
+  char log_msg[128];
+  unsigned long data = ot.getUInt(request);
+  unsigned int SmartPower = (data >> 8) & (1 << 0);
+  data &= ~(1 << 8); //disable smartpower for now, we don't support it yet
+  sprintf_P(log_msg, PSTR("OpenTherm: Received master config: %u, Smartpower: %u"), (unsigned int)(data >> 8), SmartPower);
+  log_message(log_msg);
+  //ot.setSmartPower((bool)SmartPower); not working correctly yet
+  return ot.buildResponse(OpenThermMessageType::WRITE_ACK, OpenThermMessageID::MConfigMMemberIDcode, data);
+}
+
+static unsigned long otSlaveConfig(unsigned long request) {
+  log_message(_F("OpenTherm: Received read slave config"));
+  unsigned int DHW = true;
+  unsigned int ModulationOrOnOff = false; //false means modulation according to specification v2.2
+  unsigned int Cool = true;
+  unsigned int DHWConf = false;
+  unsigned int Pump = false;
+  unsigned int CH2 = false; // no 2nd zone yet
+
+  unsigned int data = DHW | (ModulationOrOnOff << 1) | (Cool << 2) | (DHWConf << 3) | (Pump << 4) | (CH2 << 5);
+  data <<= 8;
+  return ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::SConfigSMemberIDcode, data);
+}
+
+static unsigned long otRemoteParameters(unsigned long request) { //Pre-Defined Remote Boiler Parameters
+  log_message(_F("OpenTherm: Received Remote Boiler parameters request"));
+  //fixed settings for now
+  const unsigned int DHWsetTransfer = true;
+  const unsigned int maxCHsetTransfer = true;
+  const unsigned int DHWsetReadWrite = true;
+  const unsigned int maxCHsetReadWrite = true;
+  const unsigned int responsedata = DHWsetReadWrite | (maxCHsetReadWrite << 1) | (DHWsetTransfer << 8) | (maxCHsetTransfer << 9);
+  return ot.buildResponse(OpenThermMessageType::READ_ACK, OpenThermMessageID::RBPflags, responsedata);
+}
+
+//for date/time requests we don't store anything, just answer the time we know from heishamon
+//still need to confirm this works correctly. Haven't seen a thermostat which does ask for the time and use it
+static unsigned long otDateTime(unsigned long request) {
+  OpenThermMessageID id = ot.getDataID(request);
+  if (ot.getMessageType(request) != OpenThermMessageType::READ_DATA) {
+    log_message(_F("OpenTherm: Ignore date/time information set"));
+    return ot.buildResponse(OpenThermMessageType::WRITE_ACK, id, 0);
   }
-  else if (strcmp_P(topic,PSTR("outsideTemp")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'outsideTemp'"));
-    getOTStructMember(_F("outsideTemp"))->value.f = String(value).toFloat();
-    rules_event_cb(_F("?"), topic);
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("outsideTemp"), getOTStructMember(_F("outsideTemp"))->value.f); websocket_write_all(log_msg, strlen(log_msg));
+  log_message(_F("OpenTherm: Received date/time request"));
+  time_t rawtime = time(NULL);
+  struct tm *timeinfo = localtime(&rawtime);
+  uint16_t result = 0;
+  if (id == OpenThermMessageID::DayTime) {
+    result |= ((((timeinfo->tm_wday + 6) % 7 + 1) & 0x07) << 13);  // Set weekday in the leftmost 3 bits (16 - 3 = 13).  Opentherm counting monday=1, sunday=7
+    result |= ((timeinfo->tm_hour & 0x1F) << 8);     // Set hours in the next 5 bits (13 - 5 = 8)
+    result |= (timeinfo->tm_min & 0xFF);          // Set minutes in the rightmost 8 bits
+  } else if (id == OpenThermMessageID::Date) {
+    result |= (((timeinfo->tm_mon + 1) & 0xFF) << 8);  // Set month in the leftmost 8 bits. Month + 1 for opentherm counting from 1=january
+    result |= (timeinfo->tm_mday & 0xFF);        // Set day of month in the rightmost 8 bits
+  } else {
+    result = timeinfo->tm_year + 1900; //plus 1900 makes it the real year
   }
-  else if (strcmp_P(topic,PSTR("inletTemp")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'inletTemp'"));
-    getOTStructMember(_F("inletTemp"))->value.f = String(value).toFloat();
-    rules_event_cb(_F("?"), topic);
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("inletTemp"), getOTStructMember(_F("inletTemp"))->value.f); websocket_write_all(log_msg, strlen(log_msg));
+  return ot.buildResponse(OpenThermMessageType::READ_ACK, id, result);
+}
+
+struct otDataIdStruct_t {
+  uint8_t id;
+  uint8_t codec;
+  uint8_t access; // a data id which is only read or only written ignores the message type
+  int8_t value; // heishaOTDataStruct slot, the high byte for OT_CODEC_S8S8
+  int8_t value2; // the low byte for OT_CODEC_S8S8
+  bool event; // run the rules event of the value
+  unsigned long (*handler)(unsigned long request); // for OT_CODEC_CUSTOM
+};
+
+static const otDataIdStruct_t otDataIds[] PROGMEM = {
+  { OpenThermMessageID::Status, OT_CODEC_CUSTOM, OT_READ, -1, -1, false, otStatus }, //mandatory
+  { OpenThermMessageID::TSet, OT_CODEC_F88, OT_WRITE, OT_CH_SETPOINT, -1, true, NULL }, //mandatory
+  { OpenThermMessageID::MConfigMMemberIDcode, OT_CODEC_CUSTOM, OT_WRITE, -1, -1, false, otMasterConfig },
+  { OpenThermMessageID::SConfigSMemberIDcode, OT_CODEC_CUSTOM, OT_READ, -1, -1, false, otSlaveConfig }, //mandatory
+  { OpenThermMessageID::MaxRelModLevelSetting, OT_CODEC_F88, OT_WRITE, OT_MAX_RELATIVE_MODULATION, -1, false, NULL }, //mandatory
+  { OpenThermMessageID::RelModLevel, OT_CODEC_F88, OT_READ, OT_RELATIVE_MODULATION, -1, false, NULL }, //mandatory
+  { OpenThermMessageID::Tboiler, OT_CODEC_F88, OT_READ, OT_OUTLET_TEMP, -1, false, NULL }, //mandatory
+  { OpenThermMessageID::CoolingControl, OT_CODEC_F88, OT_WRITE, OT_COOLING_CONTROL, -1, true, NULL }, //mandatory
+  // now adding some more useful, not mandatory, types
+  { OpenThermMessageID::RBPflags, OT_CODEC_CUSTOM, OT_READ, -1, -1, false, otRemoteParameters },
+  { OpenThermMessageID::TdhwSetUBTdhwSetLB, OT_CODEC_S8S8, OT_READ, OT_DHW_SET_UPP_BOUND, OT_DHW_SET_LOW_BOUND, false, NULL },
+  { OpenThermMessageID::MaxTSetUBMaxTSetLB, OT_CODEC_S8S8, OT_READ, OT_CH_SET_UPP_BOUND, OT_CH_SET_LOW_BOUND, false, NULL },
+  { OpenThermMessageID::Tr, OT_CODEC_F88, OT_WRITE, OT_ROOM_TEMP, -1, true, NULL },
+  { OpenThermMessageID::TrSet, OT_CODEC_F88, OT_WRITE, OT_ROOM_TEMP_SET, -1, true, NULL },
+  { OpenThermMessageID::TdhwSet, OT_CODEC_F88, OT_READ | OT_WRITE, OT_DHW_SETPOINT, -1, true, NULL },
+  { OpenThermMessageID::MaxTSet, OT_CODEC_F88, OT_READ | OT_WRITE, OT_MAX_TSET, -1, true, NULL },
+  { OpenThermMessageID::Tret, OT_CODEC_F88, OT_READ, OT_INLET_TEMP, -1, false, NULL },
+  { OpenThermMessageID::Tdhw, OT_CODEC_F88, OT_READ, OT_DHW_TEMP, -1, false, NULL },
+  { OpenThermMessageID::CHPressure, OT_CODEC_F88, OT_READ, OT_CH_PRESSURE, -1, false, NULL },
+  { OpenThermMessageID::Toutside, OT_CODEC_F88, OT_READ, OT_OUTSIDE_TEMP, -1, false, NULL },
+  { OpenThermMessageID::TrOverride, OT_CODEC_F88, OT_READ, OT_ROOM_SET_OVERRIDE, -1, false, NULL },
+  { OpenThermMessageID::DayTime, OT_CODEC_CUSTOM, OT_READ | OT_WRITE, -1, -1, false, otDateTime },
+  { OpenThermMessageID::Date, OT_CODEC_CUSTOM, OT_READ | OT_WRITE, -1, -1, false, otDateTime },
+  { OpenThermMessageID::Year, OT_CODEC_CUSTOM, OT_READ | OT_WRITE, -1, -1, false, otDateTime },
+};
+
+static int8_t otDataIdIndex[256]; // entry of otDataIds[] for each data id, -1 if unknown
+
+static unsigned long otHandleValue(const otDataIdStruct_t *entry, unsigned long request) {
+  char log_msg[128];
+  char str[48];
+  OpenThermMessageID id = (OpenThermMessageID)entry->id;
+  const char *name = heishaOTDataStruct[entry->value].name;
+  if (entry->codec == OT_CODEC_S8S8) {
+    sprintf_P(log_msg, PSTR("OpenTherm: Received read %s/%s"), name, heishaOTDataStruct[entry->value2].name);
+    log_message(log_msg);
+    uint16_t result = ((heishaOTDataStruct[entry->value].value.s8 & 0xFF) << 8) | (heishaOTDataStruct[entry->value2].value.s8 & 0xFF);
+    return ot.buildResponse(OpenThermMessageType::READ_ACK, id, result);
   }
-  else if (strcmp_P(topic, PSTR("outletTemp")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'outletTemp'"));
-    getOTStructMember(_F("outletTemp"))->value.f = String(value).toFloat();
-    rules_event_cb(_F("?"), topic);
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("outletTemp"), getOTStructMember(_F("outletTemp"))->value.f); websocket_write_all(log_msg, strlen(log_msg));
+  bool write = (entry->access == OT_WRITE) || ((entry->access & OT_WRITE) && (ot.getMessageType(request) == OpenThermMessageType::WRITE_DATA));
+  if (write) {
+    float value = ot.getFloat(request);
+    sprintf_P(str, PSTR("%.*f"), 4, value);
+    sprintf_P(log_msg, PSTR("OpenTherm: Received write %s: %s"), name, str);
+    log_message(log_msg);
+    if (heishaOTDataStruct[entry->value].value.f != value) { //only publish if changed
+      heishaOTDataStruct[entry->value].value.f = value;
+      otClampValue(entry->value);
+      otPublishValue(entry->value);
+    }
+    //acknowledge the value as stored, the thermostat sees when it was clamped
+    return ot.buildResponse(OpenThermMessageType::WRITE_ACK, id, otFloatToData(heishaOTDataStruct[entry->value].value.f));
   }
-  else if (strcmp_P(topic, PSTR("dhwTemp")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'dhwTemp'"));
-    getOTStructMember(_F("dhwTemp"))->value.f = String(value).toFloat();
-    rules_event_cb(_F("?"), topic);
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("dhwTemp"), getOTStructMember(_F("dhwTemp"))->value.f); websocket_write_all(log_msg, strlen(log_msg));
+  sprintf_P(log_msg, PSTR("OpenTherm: Received read %s"), name);
+  log_message(log_msg);
+  if (otValueValid(entry->value)) {
+    return ot.buildResponse(OpenThermMessageType::READ_ACK, id, otFloatToData(heishaOTDataStruct[entry->value].value.f));
   }
-  else if (strcmp_P(topic, PSTR("dhwSetpoint")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'dhwSetpoint'"));
-    getOTStructMember(_F("dhwSetpoint"))->value.f = String(value).toFloat();
-    rules_event_cb(_F("?"), topic);
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("dhwSetpoint"), getOTStructMember(_F("dhwSetpoint"))->value.f); websocket_write_all(log_msg, strlen(log_msg));
+  return ot.buildResponse(OpenThermMessageType::DATA_INVALID, id, request & 0xffff);
+}
+
+static void handleOTRequest(unsigned long request, OpenThermResponseStatus status) {
+  char log_msg[128];
+  if (status != OpenThermResponseStatus::SUCCESS) {
+    log_message(_F("OpenTherm: Request invalid!"));
+    sprintf_P(log_msg, PSTR("OpenTherm: Unknown data ID: %u (%#010lx)"), (unsigned int)ot.getDataID(request), request);
+    log_message(log_msg);
+    return;
   }
-  else if (strcmp_P(topic, PSTR("relativeModulation")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'relativeModulation'"));
-    getOTStructMember(_F("relativeModulation"))->value.f = String(value).toFloat();
-    if ((getOTStructMember(_F("relativeModulation"))->value.f > getOTStructMember(_F("maxRelativeModulation"))->value.f) && ( getOTStructMember(_F("maxRelativeModulation"))->value.f > -99)) { //need to change the relative modulation on the fly to comply with max requested
-        getOTStructMember(_F("relativeModulation"))->value.f = getOTStructMember(_F("maxRelativeModulation"))->value.f;
-    }
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("relativeModulation"), getOTStructMember(_F("relativeModulation"))->value.f); websocket_write_all(log_msg, strlen(log_msg));
-    rules_event_cb(_F("?"), topic);
-  }  
-  else if (strcmp_P(topic, PSTR("maxTSet")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'maxTSet'"));
-    getOTStructMember(_F("maxTSet"))->value.f = String(value).toFloat();
-    if ((getOTStructMember(_F("maxTSet"))->value.f > getOTStructMember(_F("chSetUppBound"))->value.s8)) { 
-        getOTStructMember(_F("maxTSet"))->value.f = getOTStructMember(_F("chSetUppBound"))->value.s8;
-    } else if ((getOTStructMember(_F("maxTSet"))->value.f < getOTStructMember(_F("chSetLowBound"))->value.s8)) { 
-        getOTStructMember(_F("maxTSet"))->value.f = getOTStructMember(_F("chSetLowBound"))->value.s8;
-    }           
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %.2f}}}"), _F("maxTSet"), getOTStructMember(_F("maxTSet"))->value.f); websocket_write_all(log_msg, strlen(log_msg));
-    rules_event_cb(_F("?"), topic);
+  uint8_t id = ot.getDataID(request);
+  if (otDataIdIndex[id] < 0) {
+    sprintf_P(log_msg, PSTR("OpenTherm: Unknown data ID: %u (%#010lx)"), (unsigned int)id, request);
+    log_message(log_msg);
+    otResponse = ot.buildResponse(OpenThermMessageType::UNKNOWN_DATA_ID, (OpenThermMessageID)id, 0);
+    return;
   }
-  else if (strcmp_P(topic, PSTR("flameState")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'flameState'"));
-    getOTStructMember(_F("flameState"))->value.b = ((stricmp((char*)"true", value) == 0) || (stricmp((char*)"on", value) == 0) || (String(value).toInt() == 1 ));
-    rules_event_cb(_F("?"), topic);
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %s}}}"), _F("flameState"), getOTStructMember(_F("flameState"))->value.b ? _F("true") : _F("false")); websocket_write_all(log_msg, strlen(log_msg));
+  otDataIdStruct_t entry;
+  memcpy_P(&entry, &otDataIds[otDataIdIndex[id]], sizeof(entry));
+  if (entry.codec == OT_CODEC_CUSTOM) {
+    otResponse = entry.handler(request);
+  } else {
+    otResponse = otHandleValue(&entry, request);
   }
-  else if (strcmp_P(topic, PSTR("chState")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'chState'"));
-    getOTStructMember(_F("chState"))->value.b = ((stricmp((char*)"true", value) == 0) || (stricmp((char*)"on", value) == 0) || (String(value).toInt() == 1 ));
-    rules_event_cb(_F("?"), topic);
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %s}}}"), _F("chState"), getOTStructMember(_F("chState"))->value.b ? _F("true") : _F("false")); websocket_write_all(log_msg, strlen(log_msg));
+  if (entry.event) {
+    rules_event_cb(_F("?"), heishaOTDataStruct[entry.value].name);
   }
-  else if (strcmp_P(topic, PSTR("dhwState")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'dhwState'"));
-    getOTStructMember(_F("dhwState"))->value.b = ((stricmp((char*)"true", value) == 0) || (stricmp((char*)"on", value) == 0) || (String(value).toInt() == 1 ));
-    rules_event_cb(_F("?"), topic);
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %s}}}"), _F("dhwState"), getOTStructMember(_F("dhwState"))->value.b ? _F("true") : _F("false")); websocket_write_all(log_msg, strlen(log_msg));
+}
+
+void processOTRequest(unsigned long request, OpenThermResponseStatus status) {
+  otTraceRequest(request, status, ot.getLastFrameTime());
+  otResponse = 0; //an answer which is still waiting belongs to the previous request
+  handleOTRequest(request, status);
+  otTraceHandled(otResponse);
+}
+
+void IRAM_ATTR handleOTInterrupt() {
+  ot.handleInterrupt();
+}
+
+void HeishaOTSetup() {
+  memset(otDataIdIndex, -1, sizeof(otDataIdIndex));
+  for (uint8_t i = 0; i < sizeof(otDataIds) / sizeof(otDataIds[0]); i++) {
+    otDataIdIndex[pgm_read_byte(&otDataIds[i].id)] = i;
   }
-  else if (strcmp_P(topic, PSTR("coolingState")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'coolingState'"));
-    getOTStructMember(_F("coolingState"))->value.b = ((stricmp((char*)"true", value) == 0) || (stricmp((char*)"on", value) == 0) || (String(value).toInt() == 1 ));
-    rules_event_cb(_F("?"), topic);
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %s}}}"), _F("coolingState"), getOTStructMember(_F("coolingState"))->value.b ? _F("true") : _F("false")); websocket_write_all(log_msg, strlen(log_msg));
-  }  
-  
-  else if (strcmp_P(topic, PSTR("dhwSetUppBound")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'dhwSetUppBound'"));
-    getOTStructMember(_F("dhwSetUppBound"))->value.s8 = String(value).toInt();
-    if ((getOTStructMember(_F("dhwSetUppBound"))->value.s8 < getOTStructMember(_F("dhwSetLowBound"))->value.s8)) { 
-        getOTStructMember(_F("dhwSetUppBound"))->value.s8 = getOTStructMember(_F("dhwSetLowBound"))->value.s8;
+  ot.begin(handleOTInterrupt, processOTRequest);
+}
+
+void HeishaOTLoop(char * actData, PubSubClient &mqtt_client, char* mqtt_topic_base) {
+  // opentherm loop
+  if (otResponse && ot.isReady()) {
+    if (ot.sendResponse(otResponse)) {
+      otTraceSent(otResponse);
     }
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %d}}}"), _F("dhwSetUppBound"), getOTStructMember(_F("dhwSetUppBound"))->value.s8); websocket_write_all(log_msg, strlen(log_msg));        
-    rules_event_cb(_F("?"), topic);
+    otResponse = 0;
   }
-  else if (strcmp_P(topic, PSTR("dhwSetLowBound")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'dhwSetLowBound'"));
-    getOTStructMember(_F("dhwSetLowBound"))->value.s8 = String(value).toInt();
-    if ((getOTStructMember(_F("dhwSetLowBound"))->value.s8 > getOTStructMember(_F("dhwSetUppBound"))->value.s8)) { 
-        getOTStructMember(_F("dhwSetLowBound"))->value.s8 = getOTStructMember(_F("dhwSetUppBound"))->value.s8;
-    }
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %d}}}"), _F("dhwSetLowBound"), getOTStructMember(_F("dhwSetLowBound"))->value.s8); websocket_write_all(log_msg, strlen(log_msg));      
-    rules_event_cb(_F("?"), topic);
-  }   
- 
-  else if (strcmp_P(topic, PSTR("chSetUppBound")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'chSetUppBound'"));
-    getOTStructMember(_F("chSetUppBound"))->value.s8 = String(value).toInt();
-    if ((getOTStructMember(_F("chSetUppBound"))->value.s8 < getOTStructMember(_F("chSetLowBound"))->value.s8)) { 
-        getOTStructMember(_F("chSetUppBound"))->value.s8 = getOTStructMember(_F("chSetLowBound"))->value.s8;
-    }    
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %d}}}"), _F("chSetUppBound"), getOTStructMember(_F("chSetUppBound"))->value.s8); websocket_write_all(log_msg, strlen(log_msg));
-    rules_event_cb(_F("?"), topic);
+  ot.process();
+}
+
+// Values the thermostat reads are set from mqtt, not the ones it writes
+void mqttOTCallback(char* topic, char* value) {
+  char log_msg[128];
+  int8_t slot = otValueSlot(topic);
+  if ((slot < 0) || (heishaOTDataStruct[slot].rw > 2)) {
+    return;
   }
-  else if (strcmp_P(topic, PSTR("chSetLowBound")) == 0) {
-    log_message(_F("OpenTherm: MQTT message received 'chSetLowBound'"));
-    getOTStructMember(_F("chSetLowBound"))->value.s8 = String(value).toInt();
-    if ((getOTStructMember(_F("chSetLowBound"))->value.s8 > getOTStructMember(_F("chSetUppBound"))->value.s8)) { 
-        getOTStructMember(_F("chSetLowBound"))->value.s8 = getOTStructMember(_F("chSetUppBound"))->value.s8;
-    }
-    sprintf_P(log_msg, PSTR("{\"data\": {\"opentherm\": {\"name\": \"%s\", \"value\": %d}}}"), _F("chSetLowBound"), getOTStructMember(_F("chSetLowBound"))->value.s8); websocket_write_all(log_msg, strlen(log_msg));        
-    rules_event_cb(_F("?"), topic);
+  sprintf_P(log_msg, PSTR("OpenTherm: MQTT message received '%s'"), heishaOTDataStruct[slot].name);
+  log_message(log_msg);
+  switch (heishaOTDataStruct[slot].type) {
+    case TBOOL: heishaOTDataStruct[slot].value.b = ((stricmp((char*)"true", value) == 0) || (stricmp((char*)"on", value) == 0) || (atoi(value) == 1)); break;
+    case TFLOAT: heishaOTDataStruct[slot].value.f = atof(value); break;
+    case TINT8: heishaOTDataStruct[slot].value.s8 = atoi(value); break;
   }
+  otClampValue(slot);
+  otWebsocketValue(slot);
+  rules_event_cb(_F("?"), topic);
 }
 
 void openthermJsonOutput(struct webserver_t *client) {
-  webserver_send_content_P(client, PSTR("{"), 1);
-
-  char str[64];
-
-  //chEnable
-  webserver_send_content_P(client, PSTR("\"chEnable\":{\"type\": \"W\",\"value\":"), 32);
-  getOTStructMember(_F("chEnable"))->value.b ? webserver_send_content_P(client, PSTR("true"), 4) : webserver_send_content_P(client, PSTR("false"), 5);
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //dhwEnable
-  webserver_send_content_P(client, PSTR("\"dhwEnable\":{\"type\": \"W\",\"value\":"), 33);
-  getOTStructMember(_F("dhwEnable"))->value.b ? webserver_send_content_P(client, PSTR("true"), 4) : webserver_send_content_P(client, PSTR("false"), 5);
-  webserver_send_content_P(client, PSTR("},"), 2);  
-  //coolingEnable
-  webserver_send_content_P(client, PSTR("\"coolingEnable\":{\"type\": \"W\",\"value\":"), 37);
-  getOTStructMember(_F("coolingEnable"))->value.b ? webserver_send_content_P(client, PSTR("true"), 4) : webserver_send_content_P(client, PSTR("false"), 5);
-  webserver_send_content_P(client, PSTR("},"), 2);  
-  //roomtemp
-  webserver_send_content_P(client, PSTR("\"roomTemp\":{\"type\": \"W\",\"value\":"), 32);
-  dtostrf( getOTStructMember(_F("roomTemp"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //roomtempset
-  webserver_send_content_P(client, PSTR("\"roomTempSet\":{\"type\": \"W\",\"value\":"), 35);
-  dtostrf( getOTStructMember(_F("roomTempSet"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //chSetpoint
-  webserver_send_content_P(client, PSTR("\"chSetpoint\":{\"type\": \"W\",\"value\":"), 34);
-  dtostrf( getOTStructMember(_F("chSetpoint"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //maxRelativeModulation
-  webserver_send_content_P(client, PSTR("\"maxRelativeModulation\":{\"type\": \"W\",\"value\":"), 45);
-  dtostrf( getOTStructMember(_F("maxRelativeModulation"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);  
-  //coolingControl
-  webserver_send_content_P(client, PSTR("\"coolingControl\":{\"type\": \"W\",\"value\":"), 38);
-  dtostrf( getOTStructMember(_F("coolingControl"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);  
-  //dhwSetpoint
-  webserver_send_content_P(client, PSTR("\"dhwSetpoint\":{\"type\": \"RW\",\"value\":"), 36);
-  dtostrf( getOTStructMember(_F("dhwSetpoint"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //maxTSet
-  webserver_send_content_P(client, PSTR("\"maxTSet\":{\"type\": \"RW\",\"value\":"), 32);
-  dtostrf( getOTStructMember(_F("maxTSet"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //chPressure
-  webserver_send_content_P(client, PSTR("\"chPressure\":{\"type\": \"R\",\"value\":"), 34);
-  dtostrf( getOTStructMember(_F("chPressure"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);  
-  //outsideTemp
-  webserver_send_content_P(client, PSTR("\"outsideTemp\":{\"type\": \"R\",\"value\":"), 35);
-  dtostrf( getOTStructMember(_F("outsideTemp"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //inletTemp
-  webserver_send_content_P(client, PSTR("\"inletTemp\":{\"type\": \"R\",\"value\":"), 33);
-  dtostrf( getOTStructMember(_F("inletTemp"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //outletTemp
-  webserver_send_content_P(client, PSTR("\"outletTemp\":{\"type\": \"R\",\"value\":"), 34);
-  dtostrf( getOTStructMember(_F("outletTemp"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //dhwTemp
-  webserver_send_content_P(client, PSTR("\"dhwTemp\":{\"type\": \"R\",\"value\":"), 31);
-  dtostrf( getOTStructMember(_F("dhwTemp"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //relativeModulation
-  webserver_send_content_P(client, PSTR("\"relativeModulation\":{\"type\": \"R\",\"value\":"), 42);
-  dtostrf( getOTStructMember(_F("relativeModulation"))->value.f, 0, 2, str);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);  
-  //flameState
-  webserver_send_content_P(client, PSTR("\"flameState\":{\"type\": \"R\",\"value\":"), 34);
-  getOTStructMember(_F("flameState"))->value.b ? webserver_send_content_P(client, PSTR("true"), 4) : webserver_send_content_P(client, PSTR("false"), 5);
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //chState
-  webserver_send_content_P(client, PSTR("\"chState\":{\"type\": \"R\",\"value\":"), 31);
-  getOTStructMember(_F("chState"))->value.b ? webserver_send_content_P(client, PSTR("true"), 4) : webserver_send_content_P(client, PSTR("false"), 5);
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //dhwState
-  webserver_send_content_P(client, PSTR("\"dhwState\":{\"type\": \"R\",\"value\":"), 32);
-  getOTStructMember(_F("dhwState"))->value.b ? webserver_send_content_P(client, PSTR("true"), 4) : webserver_send_content_P(client, PSTR("false"), 5);
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //coolingState
-  webserver_send_content_P(client, PSTR("\"coolingState\":{\"type\": \"R\",\"value\":"), 36);
-  getOTStructMember(_F("coolingState"))->value.b ? webserver_send_content_P(client, PSTR("true"), 4) : webserver_send_content_P(client, PSTR("false"), 5);
-  webserver_send_content_P(client, PSTR("},"), 2);  
-  //dhwSetUppBound
-  webserver_send_content_P(client, PSTR("\"dhwSetUppBound\":{\"type\": \"R\",\"value\":"), 38);
-  itoa( getOTStructMember(_F("dhwSetUppBound"))->value.s8, str, 10);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //dhwSetLowBound
-  webserver_send_content_P(client, PSTR("\"dhwSetLowBound\":{\"type\": \"R\",\"value\":"), 38);
-  itoa( getOTStructMember(_F("dhwSetLowBound"))->value.s8, str, 10);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //chSetUppBound
-  webserver_send_content_P(client, PSTR("\"chSetUppBound\":{\"type\": \"R\",\"value\":"), 37);
-  itoa( getOTStructMember(_F("chSetUppBound"))->value.s8, str, 10);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("},"), 2);
-  //chSetLowBound
-  webserver_send_content_P(client, PSTR("\"chSetLowBound\":{\"type\": \"R\",\"value\":"), 37);
-  itoa( getOTStructMember(_F("chSetLowBound"))->value.s8, str, 10);
-  webserver_send_content(client, str, strlen(str));
-  webserver_send_content_P(client, PSTR("}}"), 2);       //this is the last line in JSON, keep this at the end 
+  char str[80];
+  for (uint8_t i = 0; i < OT_VALUES; i++) {
+    const char *type = (heishaOTDataStruct[i].rw == 3) ? "W" : ((heishaOTDataStruct[i].rw == 2) ? "RW" : "R");
+    int len = sprintf_P(str, PSTR("%c\"%s\":{\"type\": \"%s\",\"value\":"), (i == 0) ? '{' : ',', heishaOTDataStruct[i].name, type);
+    webserver_send_content(client, str, len);
+    otValueString(i, str, 2);
+    webserver_send_content(client, str, strlen(str));
+    webserver_send_content_P(client, PSTR("}"), 1);
+  }
+  webserver_send_content_P(client, PSTR("}"), 1); //this is the last line in JSON, keep this at the end
 }
-
@@ -35,6 +35,36 @@ typedef struct heishaOTDataStruct_t {
 
 extern struct heishaOTDataStruct_t heishaOTDataStruct[];
 
+// slots of heishaOTDataStruct[], in the same order
+enum heishaOTValue_t {
+  OT_CH_ENABLE,
+  OT_DHW_ENABLE,
+  OT_COOLING_ENABLE,
+  OT_ROOM_TEMP,
+  OT_ROOM_TEMP_SET,
+  OT_CH_SETPOINT,
+  OT_MAX_RELATIVE_MODULATION,
+  OT_COOLING_CONTROL,
+  OT_DHW_SETPOINT,
+  OT_MAX_TSET,
+  OT_CH_PRESSURE,
+  OT_RELATIVE_MODULATION,
+  OT_OUTSIDE_TEMP,
+  OT_INLET_TEMP,
+  OT_OUTLET_TEMP,
+  OT_DHW_TEMP,
+  OT_FLAME_STATE,
+  OT_CH_STATE,
+  OT_DHW_STATE,
+  OT_COOLING_STATE,
+  OT_ROOM_SET_OVERRIDE,
+  OT_DHW_SET_UPP_BOUND,
+  OT_DHW_SET_LOW_BOUND,
+  OT_CH_SET_UPP_BOUND,
+  OT_CH_SET_LOW_BOUND,
+  OT_VALUES
+};
+
 void HeishaOTSetup();
 void HeishaOTLoop(char *actDat, PubSubClient &mqtt_client, char* mqtt_topic_base);
 void mqttOTCallback(char* topic, char* value);
@@ -0,0 +1,56 @@
+#include "bootprofile.h"
+#include "mqttqueue.h"
+
+void log_message(char* string);
+
+const char* mqtt_topic_boot PROGMEM = "stats/boot";
+
+bootStatsStruct bootStats;
+
+static const char bootPhaseNames[BOOT_PHASES][14] PROGMEM = {
+  "fs", "settings", "serial", "conditionals", "wifi", "http", "mqtt setup", "opentherm",
+  "rules", "setup", "network", "mqtt", "first frame", "first publish", "deferred"
+};
+
+void bootMark(uint8_t phase) {
+  if ((phase < BOOT_PHASES) && (bootStats.phase[phase] == 0)) {
+    bootStats.phase[phase] = max(millis(), 1UL);
+  }
+}
+
+bool bootReached(uint8_t phase) {
+  return (phase < BOOT_PHASES) && (bootStats.phase[phase] != 0);
+}
+
+// The boot times are published once, retained, when the first heatpump
+// values reached the broker. Phases not reached are left out.
+void bootLoop(PubSubClient &mqtt_client, char* mqtt_topic_base) {
+  if (bootStats.published || !mqtt_client.connected()) {
+    return;
+  }
+  if (bootReached(BOOT_FIRST_FRAME) && (mqttQueueStats.length == 0)) {
+    bootMark(BOOT_FIRST_PUBLISH);
+  }
+  if (!bootReached(BOOT_FIRST_PUBLISH) && (millis() < BOOT_REPORT_TIMEOUT)) {
+    return;
+  }
+  bootStats.published = true;
+
+  char report[448];
+  int len = snprintf_P(report, sizeof(report), PSTR("{\"fast boot\":%s"), bootStats.fastBoot ? "true" : "false");
+  for (uint8_t i = 0; i < BOOT_PHASES; i++) {
+    if (bootReached(i) && (len < (int)sizeof(report))) {
+      char name[14];
+      strcpy_P(name, bootPhaseNames[i]);
+      len += snprintf_P(&report[len], sizeof(report) - len, PSTR(",\"%s\":%lu"), name, bootStats.phase[i]);
+    }
+  }
+  if (len < (int)sizeof(report)) {
+    snprintf_P(&report[len], sizeof(report) - len, PSTR("}"));
+  }
+  log_message(report);
+
+  char mqtt_topic[256];
+  sprintf_P(mqtt_topic, PSTR("%s/%s"), mqtt_topic_base, mqtt_topic_boot);
+  mqttQueuePublish(mqtt_topic, report, MQTT_QUEUE_RETAIN);
+}
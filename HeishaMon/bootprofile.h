@@ -0,0 +1,42 @@
+#ifndef _BOOTPROFILE_H_
+#define _BOOTPROFILE_H_
+
+#include <Arduino.h>
+#include <PubSubClient.h>
+
+// Milestones of the boot, each stored once as millis() when it is reached
+#define BOOT_FS 0
+#define BOOT_SETTINGS 1
+#define BOOT_SERIAL 2 // heatpump serial switched over
+#define BOOT_CONDITIONALS 3
+#define BOOT_WIFI 4
+#define BOOT_HTTP 5
+#define BOOT_MQTT_SETUP 6
+#define BOOT_OPENTHERM 7
+#define BOOT_RULES 8
+#define BOOT_SETUP 9 // end of setup()
+#define BOOT_NETWORK 10 // first wifi or ethernet connection
+#define BOOT_MQTT 11 // first mqtt connection
+#define BOOT_FIRST_FRAME 12 // first good heatpump frame
+#define BOOT_FIRST_PUBLISH 13 // the values of that frame are sent to the broker
+#define BOOT_DEFERRED 14 // work a fast boot left for later is done
+#define BOOT_PHASES 15
+
+#define BOOT_DEFER_TIMEOUT 30000 // ms a fast boot waits for the first frame before it does the deferred work anyway
+#define BOOT_REPORT_TIMEOUT 120000 // ms after which the boot times are published without a first frame
+
+extern const char* mqtt_topic_boot;
+
+struct bootStatsStruct {
+  unsigned long phase[BOOT_PHASES] = {0}; // ms since power on, 0 if not reached
+  bool fastBoot = false;
+  bool published = false;
+};
+
+extern bootStatsStruct bootStats;
+
+void bootMark(uint8_t phase);
+bool bootReached(uint8_t phase);
+void bootLoop(PubSubClient &mqtt_client, char* mqtt_topic_base);
+
+#endif
@@ -0,0 +1,132 @@
+#include "busmetrics.h"
+
+busHistogramStruct busHistograms[BUS_HISTOGRAMS];
+
+static const uint16_t busMetricsBounds[BUS_METRICS_BOUNDS] PROGMEM = { 50, 100, 200, 300, 500, 750, 1000, 1500, 2000 };
+
+static const char histName0[] PROGMEM = "main";
+static const char histName1[] PROGMEM = "extra";
+static const char histName2[] PROGMEM = "optional_pcb";
+static const char histName3[] PROGMEM = "command";
+static const char histName4[] PROGMEM = "queue_wait";
+static const char *const histNames[BUS_HISTOGRAMS] PROGMEM = { histName0, histName1, histName2, histName3, histName4 };
+
+void busMetricsObserve(uint8_t histogram, unsigned long ms) {
+  if (histogram >= BUS_HISTOGRAMS) {
+    return;
+  }
+  busHistogramStruct *h = &busHistograms[histogram];
+  uint8_t i = 0;
+  while ((i < BUS_METRICS_BOUNDS) && (ms > pgm_read_word(&busMetricsBounds[i]))) {
+    i++;
+  }
+  h->buckets[i]++;
+  h->count++;
+  h->sum += ms;
+}
+
+// ms as seconds with three decimals, prometheus wants base units
+static void addSeconds(String &text, unsigned long ms) {
+  char str[16];
+  sprintf_P(str, PSTR("%lu.%03lu"), ms / 1000, ms % 1000);
+  text += str;
+}
+
+// One histogram in prometheus text format. The answer latencies share one
+// metric with a frame label, its HELP and TYPE lines come with the first.
+String busMetricsPrometheus(uint8_t histogram) {
+  String text;
+  if (histogram >= BUS_HISTOGRAMS) {
+    return text;
+  }
+  String metric;
+  String label;
+  if (histogram == BUS_HIST_QUEUE_WAIT) {
+    metric = F("heishamon_command_queue_wait_seconds");
+    text += F("# HELP heishamon_command_queue_wait_seconds Time a command waited before it was sent to the heatpump\n");
+    text += F("# TYPE heishamon_command_queue_wait_seconds histogram\n");
+  } else {
+    metric = F("heishamon_serial_answer_seconds");
+    label = F("frame=\"");
+    label += FPSTR((PGM_P)pgm_read_ptr(&histNames[histogram]));
+    label += F("\"");
+    if (histogram == 0) {
+      text += F("# HELP heishamon_serial_answer_seconds Time from sending a frame to the first byte of its answer\n");
+      text += F("# TYPE heishamon_serial_answer_seconds histogram\n");
+    }
+  }
+  text.reserve(text.length() + 64 * (BUS_METRICS_BOUNDS + 3));
+
+  busHistogramStruct *h = &busHistograms[histogram];
+  unsigned long cumulative = 0;
+  for (uint8_t i = 0; i <= BUS_METRICS_BOUNDS; i++) {
+    cumulative += h->buckets[i];
+    text += metric;
+    text += F("_bucket{");
+    if (label.length() > 0) {
+      text += label;
+      text += ',';
+    }
+    text += F("le=\"");
+    if (i < BUS_METRICS_BOUNDS) {
+      addSeconds(text, pgm_read_word(&busMetricsBounds[i]));
+    } else {
+      text += F("+Inf");
+    }
+    text += F("\"} ");
+    text += cumulative;
+    text += '\n';
+  }
+  text += metric;
+  text += F("_sum");
+  if (label.length() > 0) {
+    text += '{';
+    text += label;
+    text += '}';
+  }
+  text += ' ';
+  addSeconds(text, h->sum);
+  text += '\n';
+  text += metric;
+  text += F("_count");
+  if (label.length() > 0) {
+    text += '{';
+    text += label;
+    text += '}';
+  }
+  text += ' ';
+  text += h->count;
+  text += '\n';
+  return text;
+}
+
+// All histograms for mqtt: the bucket bounds in ms once, then per histogram
+// the bucket counts (not cumulative) followed by the sum in ms
+String busMetricsCompact() {
+  String text;
+  text.reserve(64 + BUS_HISTOGRAMS * 16 * (BUS_METRICS_BOUNDS + 2));
+  text += F("{\"le\":[");
+  for (uint8_t i = 0; i < BUS_METRICS_BOUNDS; i++) {
+    if (i > 0) text += ',';
+    text += pgm_read_word(&busMetricsBounds[i]);
+  }
+  text += ']';
+  for (uint8_t histogram = 0; histogram < BUS_HISTOGRAMS; histogram++) {
+    busHistogramStruct *h = &busHistograms[histogram];
+    text += F(",\"");
+    text += FPSTR((PGM_P)pgm_read_ptr(&histNames[histogram]));
+    text += F("\":[");
+    for (uint8_t i = 0; i <= BUS_METRICS_BOUNDS; i++) {
+      text += h->buckets[i];
+      text += ',';
+    }
+    text += h->sum;
+    text += ']';
+  }
+  text += F(",\"busy\":");
+  text += pollStats.utilisation;
+  text += F(",\"idle\":");
+  text += 100 - pollStats.utilisation;
+  text += '}';
+  return text;
+}
@@ -0,0 +1,25 @@
+#ifndef _BUSMETRICS_H_
+#define _BUSMETRICS_H_
+
+#include <Arduino.h>
+#include "pollscheduler.h"
+
+// histograms, the first ones follow the POLL_FRAME_* answer latencies
+#define BUS_HIST_QUEUE_WAIT POLL_FRAME_TYPES // ms a command waited before it was sent
+#define BUS_HISTOGRAMS (POLL_FRAME_TYPES + 1)
+
+#define BUS_METRICS_BOUNDS 9 // upper bounds in ms, see busMetricsBounds
+
+struct busHistogramStruct {
+  unsigned long buckets[BUS_METRICS_BOUNDS + 1] = {}; // not cumulative, the last one counts everything above the highest bound
+  unsigned long count = 0;
+  unsigned long sum = 0; // ms
+};
+
+extern busHistogramStruct busHistograms[BUS_HISTOGRAMS];
+
+void busMetricsObserve(uint8_t histogram, unsigned long ms);
+String busMetricsPrometheus(uint8_t histogram);
+String busMetricsCompact();
+
+#endif
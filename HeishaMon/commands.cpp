@@ -1,5 +1,6 @@
 #include "commands.h"
 #include <LittleFS.h>
+#include "persist.h"
 
 //removed checksum from default query, is calculated in send_command
 byte initialQuery[] = {0x31, 0x05, 0x10, 0x01, 0x00, 0x00, 0x00};
@@ -1222,53 +1223,276 @@ unsigned int set_solar_temp(char *msg, char *log_msg) {
 
 
 
-void send_heatpump_command(char* topic, char *msg, bool (*send_command)(byte*, int), void (*log_message)(char*), bool optionalPCB) {
+static void run_heatpump_command(unsigned int id, char *msg, bool (*send_command)(byte*, int), void (*log_message)(char*)) {
   unsigned char cmd[256] = { 0 };
   char log_msg[256] = { 0 };
-  unsigned int len = 0;
+  cmdStruct tmp;
+  memcpy_P(&tmp, &commands[id], sizeof(tmp));
+  unsigned int len = tmp.func(msg, cmd, log_msg);
+  log_message(log_msg);
+  if (len > 0) send_command(cmd, len);
+}
+
+static void run_optional_command(unsigned int id, char *msg, void (*log_message)(char*)) {
+  char log_msg[256] = { 0 };
+  optCmdStruct tmp;
+  memcpy_P(&tmp, &optionalCommands[id], sizeof(tmp));
+  tmp.func(msg, log_msg);
+  log_message(log_msg);
+#ifdef ESP32
+  xQueueOverwrite(pcbQueue, optionalPCBQuery);
+#endif
+}
 
+void send_heatpump_command(char* topic, char *msg, bool (*send_command)(byte*, int), void (*log_message)(char*), bool optionalPCB) {
   for (unsigned int i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
-    cmdStruct tmp;
-    memcpy_P(&tmp, &commands[i], sizeof(tmp));
-    if (strcmp(topic, tmp.name) == 0) {
-      len = tmp.func(msg, cmd, log_msg);
-      log_message(log_msg);
-      if (len > 0) send_command(cmd, len);
+    if (strcmp_P(topic, commands[i].name) == 0) {
+      run_heatpump_command(i, msg, send_command, log_message);
     }
   }
 
   if (optionalPCB) {
     //run for optional pcb commands
     for (unsigned int i = 0; i < sizeof(optionalCommands) / sizeof(optionalCommands[0]); i++) {
-      optCmdStruct tmp;
-      memcpy_P(&tmp, &optionalCommands[i], sizeof(tmp));
-      if (strcmp(topic, tmp.name) == 0) {
-        len = tmp.func(msg, log_msg);
-        log_message(log_msg);
-#ifdef ESP32        
-       xQueueOverwrite(pcbQueue, optionalPCBQuery);
-#endif          
+      if (strcmp_P(topic, optionalCommands[i].name) == 0) {
+        run_optional_command(i, msg, log_message);
       }
     }
   }
 
 }
 
+struct commandInboxStruct {
+  unsigned long received;
+  uint8_t id; // index in commands[] or optionalCommands[]
+  bool optional;
+  uint8_t decimals; // of value as received
+  int32_t value; // the number times 10^decimals
+};
+
+commandInboxStatsStruct commandInboxStats;
+
+static commandInboxStruct commandInbox[COMMAND_INBOX_SIZE];
+static uint8_t commandInboxStart = 0;
+static uint8_t commandInboxCount = 0;
+
+// Plain decimal numbers only, anything else is left to the command itself.
+// The value is kept as an integer with the number of decimals it was sent
+// with, so it is handed to the command exactly as received.
+static bool parseInboxValue(const byte *payload, unsigned int length, int32_t *value, uint8_t *decimals) {
+  unsigned int i = 0;
+  bool negative = false;
+  bool digits = false;
+  bool fraction = false;
+  int64_t result = 0;
+  *decimals = 0;
+  if ((length > 0) && ((payload[0] == '-') || (payload[0] == '+'))) {
+    negative = (payload[0] == '-');
+    i++;
+  }
+  for (; i < length; i++) {
+    if ((payload[i] >= '0') && (payload[i] <= '9')) {
+      digits = true;
+      if (fraction) {
+        if (*decimals == COMMAND_INBOX_DECIMALS) {
+          return false;
+        }
+        (*decimals)++;
+      }
+      result = result * 10 + (payload[i] - '0');
+      if (result > INT32_MAX) {
+        return false;
+      }
+    } else if ((payload[i] == '.') && !fraction) {
+      fraction = true;
+    } else {
+      return false;
+    }
+  }
+  *value = negative ? -result : result;
+  return digits;
+}
 
-bool saveOptionalPCB(byte* command, int length) {
-  if (LittleFS.begin()) {
-    File pcbfile = LittleFS.open("/optionalpcb.raw", "w");
-    if (pcbfile) {
-      pcbfile.write(command, length);
-      pcbfile.close();
+// The text of an inbox value, e.g. 215 with 1 decimal is "21.5"
+static void formatInboxValue(char *msg, size_t size, int32_t value, uint8_t decimals) {
+  uint32_t magnitude = (value < 0) ? -(int64_t)value : value;
+  uint32_t scale = 1;
+  for (uint8_t i = 0; i < decimals; i++) {
+    scale *= 10;
+  }
+  if (decimals == 0) {
+    snprintf_P(msg, size, PSTR("%s%lu"), (value < 0) ? "-" : "", (unsigned long)magnitude);
+  } else {
+    snprintf_P(msg, size, PSTR("%s%lu.%0*lu"), (value < 0) ? "-" : "", (unsigned long)(magnitude / scale), decimals, (unsigned long)(magnitude % scale));
+  }
+}
+
+// Called from the mqtt callback, so no allocation and no sending here. The
+// value is parsed here, returns false if the command could not be queued, the
+// caller then handles it directly.
+bool commandInboxPush(const char *name, const byte *payload, unsigned int length, bool optionalPCB) {
+  int id = -1;
+  bool optional = false;
+  int32_t value;
+  uint8_t decimals;
+
+  for (unsigned int i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+    if (strcmp_P(name, commands[i].name) == 0) {
+      id = i;
+      break;
+    }
+  }
+  if ((id == -1) && optionalPCB) {
+    for (unsigned int i = 0; i < sizeof(optionalCommands) / sizeof(optionalCommands[0]); i++) {
+      if (strcmp_P(name, optionalCommands[i].name) == 0) {
+        id = i;
+        optional = true;
+        break;
+      }
+    }
+  }
+  if ((id == -1) || (length > COMMAND_INBOX_NUMBER_LEN) || !parseInboxValue(payload, length, &value, &decimals)) {
+    commandInboxStats.direct++;
+    return false;
+  }
+
+  // a newer value for a setting that is still pending replaces the older one
+  for (uint8_t i = 0; i < commandInboxCount; i++) {
+    commandInboxStruct *entry = &commandInbox[(commandInboxStart + i) % COMMAND_INBOX_SIZE];
+    if ((entry->id == id) && (entry->optional == optional)) {
+      entry->value = value;
+      entry->decimals = decimals;
+      commandInboxStats.received++;
+      commandInboxStats.coalesced++;
       return true;
     }
+  }
 
+  if (commandInboxCount == COMMAND_INBOX_SIZE) {
+    commandInboxStats.direct++;
+    return false;
+  }
+  commandInboxStruct *entry = &commandInbox[(commandInboxStart + commandInboxCount) % COMMAND_INBOX_SIZE];
+  entry->received = millis();
+  entry->id = id;
+  entry->optional = optional;
+  entry->value = value;
+  entry->decimals = decimals;
+  commandInboxCount++;
+  commandInboxStats.received++;
+  return true;
+}
+
+// Handle the pending commands. Heatpump set commands end up in the write frame
+// merger, so they don't fill the serial command buffer.
+void commandInboxLoop(bool (*send_command)(byte*, int), void (*log_message)(char*)) {
+  while (commandInboxCount > 0) {
+    commandInboxStruct *entry = &commandInbox[commandInboxStart];
+    char msg[24];
+    formatInboxValue(msg, sizeof(msg), entry->value, entry->decimals);
+    if (entry->optional) {
+      run_optional_command(entry->id, msg, log_message);
+    } else {
+      run_heatpump_command(entry->id, msg, send_command, log_message);
+    }
+    unsigned long latency = millis() - entry->received;
+    if (latency > commandInboxStats.maxLatency) {
+      commandInboxStats.maxLatency = latency;
+    }
+    commandInboxStart = (commandInboxStart + 1) % COMMAND_INBOX_SIZE;
+    commandInboxCount--;
+  }
+}
+
+// Bytes of a write frame holding more than one setting. A zero field means no
+// change, so a field is only taken over when the newer command sets it.
+struct writeFieldStruct {
+  uint8_t pos;
+  uint8_t masks[3];
+};
+
+static const writeFieldStruct writeFields[] PROGMEM = {
+  { 4, { 0x03, 0x30, 0xC0 } }, // heatpump state, pump, force DHW
+  { 5, { 0x30, 0xC0, 0x00 } }, // holiday mode, main schedule
+  { 6, { 0x3F, 0xC0, 0x00 } }, // operation mode, zones
+  { 7, { 0x07, 0x38, 0x00 } }, // powerful mode, quiet mode
+  { 8, { 0x01, 0x02, 0x04 } }, // reset, force defrost, force sterilization
+  { 26, { 0x03, 0x0C, 0x00 } }, // bivalent control, bivalent mode
+};
+
+writeMergeStatsStruct writeMergeStats;
+
+static byte writeFrame[PANASONICQUERYSIZE];
+static bool writePending = false;
+static unsigned long writeFirstMerge = 0;
+static unsigned long writeLastMerge = 0;
+
+static void mergeWriteByte(unsigned int pos, byte value) {
+  for (unsigned int i = 0; i < sizeof(writeFields) / sizeof(writeFields[0]); i++) {
+    if (pgm_read_byte(&writeFields[i].pos) != pos) {
+      continue;
+    }
+    byte rest = 0xFF;
+    for (unsigned int j = 0; j < sizeof(writeFields[i].masks); j++) {
+      byte mask = pgm_read_byte(&writeFields[i].masks[j]);
+      rest &= ~mask;
+      if (value & mask) {
+        writeFrame[pos] = (writeFrame[pos] & ~mask) | (value & mask);
+      }
+    }
+    writeFrame[pos] |= value & rest;
+    return;
   }
-  return false;
+  writeFrame[pos] = value;
+}
+
+// Take over a write frame built from panasonicSendQuery, settings of later
+// commands win. Only given the frames of the set_* commands, returns false
+// for the ones which are no write frame.
+bool mergeWriteCommand(const byte *command, int length) {
+  if ((length != PANASONICQUERYSIZE) || (memcmp_P(command, panasonicSendQuery, 4) != 0)) {
+    return false;
+  }
+  if (!writePending) {
+    memcpy_P(writeFrame, panasonicSendQuery, PANASONICQUERYSIZE);
+    writePending = true;
+    writeFirstMerge = millis();
+  }
+  for (unsigned int pos = 4; pos < PANASONICQUERYSIZE; pos++) {
+    if (command[pos] != 0) {
+      mergeWriteByte(pos, command[pos]);
+    }
+  }
+  writeLastMerge = millis();
+  writeMergeStats.settings++;
+  return true;
+}
+
+// Copy the merged write frame once no new setting arrived for WRITE_MERGE_WAIT
+// or the oldest setting waited WRITE_MERGE_MAX_WAIT. queued is set to the
+// time the oldest setting arrived.
+bool takeWriteCommand(byte *command, unsigned long *queued) {
+  if (!writePending) {
+    return false;
+  }
+  unsigned long now = millis();
+  if (((unsigned long)(now - writeLastMerge) < WRITE_MERGE_WAIT) && ((unsigned long)(now - writeFirstMerge) < WRITE_MERGE_MAX_WAIT)) {
+    return false;
+  }
+  memcpy(command, writeFrame, PANASONICQUERYSIZE);
+  *queued = writeFirstMerge;
+  writePending = false;
+  writeMergeStats.frames++;
+  return true;
+}
+
+
+// Queued for the flash, written only when changed and at most each OPTIONALPCBSAVETIME
+bool saveOptionalPCB(byte* command, int length) {
+  return persistWrite("/optionalpcb.raw", command, length, 1000UL * OPTIONALPCBSAVETIME);
 }
 bool loadOptionalPCB(byte* command, int length) {
-  if (LittleFS.begin()) {
+  if (persistMount()) {
     if (LittleFS.exists("/optionalpcb.raw")) {
       File pcbfile = LittleFS.open("/optionalpcb.raw", "r");
       if (pcbfile) {
@@ -13,7 +13,7 @@ extern byte panasonicQuery[PANASONICQUERYSIZE];
 #define OPTDATASIZE 20
 #define OPTIONALPCBQUERYTIME 1000 //send optional pcb query each second
 #define OPTIONALPCBQUERYSIZE 19
-#define OPTIONALPCBSAVETIME 300 //save each 5 minutes the current optional pcb state into flash to have valid values during reboot
+#define OPTIONALPCBSAVETIME 300 //save a changed optional pcb state at most each 5 minutes into flash to have valid values during reboot
 extern byte optionalPCBQuery[OPTIONALPCBQUERYSIZE];
 
 
@@ -195,5 +195,34 @@ const optCmdStruct optionalCommands[] PROGMEM = {
 };
 
 void send_heatpump_command(char* topic, char *msg, bool (*send_command)(byte*, int), void (*log_message)(char*), bool optionalPCB);
+
+// commands received over mqtt wait here until the main loop can send them to the heatpump
+#define COMMAND_INBOX_SIZE 16
+#define COMMAND_INBOX_NUMBER_LEN 12 // longer values and values which are no plain number (e.g. SetCurves json) are handled directly
+#define COMMAND_INBOX_DECIMALS 6 // decimals kept of a value
+
+struct commandInboxStatsStruct {
+  unsigned long received = 0; // accepted by the inbox
+  unsigned long coalesced = 0; // replaced the value of a pending command for the same setting
+  unsigned long direct = 0; // no plain number or no free slot, handled immediately
+  unsigned long maxLatency = 0; // ms between receiving and handling a command
+};
+extern commandInboxStatsStruct commandInboxStats;
+
+bool commandInboxPush(const char *name, const byte *payload, unsigned int length, bool optionalPCB);
+void commandInboxLoop(bool (*send_command)(byte*, int), void (*log_message)(char*));
+
+// set commands waiting for the serial line are merged into one write frame
+#define WRITE_MERGE_WAIT 100 // ms without new settings before the merged frame is sent
+#define WRITE_MERGE_MAX_WAIT 1000 // ms a setting may wait for more settings at most
+
+struct writeMergeStatsStruct {
+  unsigned long settings = 0; // set commands that went through the merger
+  unsigned long frames = 0; // write frames sent to the heatpump
+};
+extern writeMergeStatsStruct writeMergeStats;
+
+bool mergeWriteCommand(const byte *command, int length);
+bool takeWriteCommand(byte *command, unsigned long *queued);
 bool saveOptionalPCB(byte* command, int length);
 bool loadOptionalPCB(byte* command, int length);
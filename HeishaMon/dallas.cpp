@@ -3,6 +3,8 @@
 #include <PubSubClient.h>
 #include "commands.h"
 #include "dallas.h"
+#include "mqttqueue.h"
+#include "persist.h"
 #include "rules.h"
 #include "src/common/progmem.h"
 #include <ArduinoJson.h>
@@ -12,216 +14,363 @@
 
 #define MAXTEMPDIFFPERSEC 0.5 // what is the allowed temp difference per second which is allowed (to filter bad values)
 
-#define DALLASASYNC 1 //async dallas yes or no (default yes)
+// one conversion for all sensors, after it one scratchpad is read per loop
+#define DALLAS_STATE_IDLE 0
+#define DALLAS_STATE_CONVERTING 1
+#define DALLAS_STATE_READING 2
 
-OneWire oneWire(ONE_WIRE_BUS);
-DallasTemperature DS18B20(&oneWire);
+#define DALLAS_INDEX_EMPTY 0xFF // free bucket in the registry index
 
-//global array for 1wire data - fixed size so known sensors survive across rescans
-dallasDataStruct* actDallasData = 0;
-int dallasDevicecount = 0; // kept as the array length (MAX_DALLAS_SENSORS) for external callers; iterate using the "known" flag
+static const uint8_t dallasBusPins[] = ONE_WIRE_BUSES;
+#define DALLAS_BUSES (sizeof(dallasBusPins) / sizeof(dallasBusPins[0]))
 
+static OneWire oneWire[DALLAS_BUSES];
+static DallasTemperature DS18B20[DALLAS_BUSES];
+
+//registry of known sensors (seen on a bus and/or restored from mqtt), kept across rescans
+//the entries are packed, the index maps the hash of a ROM code to its entry
+static dallasDataStruct* dallasSensors = NULL;
+static uint8_t dallasCount = 0;
+static uint8_t dallasCapacity = 0;
+static uint8_t* dallasIndex = NULL;
+static uint16_t dallasIndexMask = 0; // buckets - 1, the index has twice the capacity in buckets
 
 unsigned long lastalldatatime_dallas = 0;
 
+dallasStatsStruct dallasStats;
+
 unsigned long dallasTimer = 0;
-unsigned long dallasTimer1 = 0;
+static uint8_t dallasState = DALLAS_STATE_IDLE;
+static unsigned long conversionTime = 750; // ms, from the resolution
+static bool pollConversion = false;
+static unsigned long lastConversionPoll = 0;
+static int readIndex = 0;
+static bool updateAll = false; // publish every sensor in this round
 unsigned int updateAllDallasTime = 30000; // will be set using heishmonSettings
 unsigned int dallasTimerWait = 30000; // will be set using heishmonSettings
 void loadDallasAlias();
 void saveDallasAliasFile();
 
-static int findDallasSlot(const char* address) {
-  for (int i = 0; i < MAX_DALLAS_SENSORS; i++) {
-    if (actDallasData[i].known && strcmp(actDallasData[i].address, address) == 0) return i;
+// the address as 16 hex chars, as used in the mqtt topics, the alias file and the rules
+static void dallasAddressString(const uint8_t* rom, char* out) {
+  for (int x = 0; x < 8; x++) {
+    sprintf(&out[x * 2], "%02x", rom[x]);
   }
+  out[16] = '\0';
+}
+
+static int8_t hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
   return -1;
 }
 
-static int findFreeDallasSlot() {
-  for (int i = 0; i < MAX_DALLAS_SENSORS; i++) {
-    if (!actDallasData[i].known) return i;
+// parses the first 16 hex chars of an address back into a ROM code
+static bool parseDallasAddress(const char* addrStr, DeviceAddress out) {
+  for (int x = 0; x < 8; x++) {
+    int8_t hi = hexValue(addrStr[x * 2]);
+    if (hi < 0) return false;
+    int8_t lo = hexValue(addrStr[x * 2 + 1]);
+    if (lo < 0) return false;
+    out[x] = (hi << 4) | lo;
   }
-  return -1;
+  return true;
 }
 
-// parses a 16 hex char address string (as produced/stored in .address) back into a DeviceAddress,
-// so sensors restored purely from mqtt can still be addressed directly on the bus without a rescan
-static void parseDallasAddress(const char* addrStr, DeviceAddress out) {
+static uint16_t dallasHash(const uint8_t* rom) {
+  uint32_t hash = 2166136261UL; //FNV-1a
   for (int x = 0; x < 8; x++) {
-    char byteStr[3] = { addrStr[x * 2], addrStr[x * 2 + 1], '\0' };
-    out[x] = (uint8_t) strtoul(byteStr, NULL, 16);
+    hash = (hash ^ rom[x]) * 16777619UL;
+  }
+  return (hash ^ (hash >> 16)) & dallasIndexMask;
+}
+
+static int findDallasSensor(const uint8_t* rom) {
+  if (dallasIndex == NULL) return -1;
+  for (uint16_t bucket = dallasHash(rom); dallasIndex[bucket] != DALLAS_INDEX_EMPTY; bucket = (bucket + 1) & dallasIndexMask) {
+    if (memcmp(dallasSensors[dallasIndex[bucket]].sensor, rom, sizeof(DeviceAddress)) == 0) return dallasIndex[bucket];
+  }
+  return -1;
+}
+
+static void indexDallasSensors() {
+  memset(dallasIndex, DALLAS_INDEX_EMPTY, dallasIndexMask + 1);
+  for (uint8_t i = 0; i < dallasCount; i++) {
+    uint16_t bucket = dallasHash(dallasSensors[i].sensor);
+    while (dallasIndex[bucket] != DALLAS_INDEX_EMPTY) {
+      bucket = (bucket + 1) & dallasIndexMask;
+    }
+    dallasIndex[bucket] = i;
   }
 }
 
+// grows the registry by doubling it, the index is rebuilt at its new size
+static bool growDallasSensors() {
+  if (dallasCapacity >= MAX_DALLAS_SENSORS) return false;
+  uint16_t capacity = (dallasCapacity == 0) ? DALLAS_INITIAL_SENSORS : dallasCapacity * 2;
+  if (capacity > MAX_DALLAS_SENSORS) capacity = MAX_DALLAS_SENSORS;
+  uint16_t buckets = 1;
+  while (buckets < capacity * 2) buckets <<= 1;
+
+  dallasDataStruct* sensors = new (std::nothrow) dallasDataStruct [capacity];
+  uint8_t* index = new (std::nothrow) uint8_t [buckets];
+  if (sensors == NULL || index == NULL) {
+    delete [] sensors;
+    delete [] index;
+    return false;
+  }
+  for (uint8_t i = 0; i < dallasCount; i++) {
+    sensors[i] = dallasSensors[i];
+  }
+  delete [] dallasSensors;
+  delete [] dallasIndex;
+  dallasSensors = sensors;
+  dallasIndex = index;
+  dallasCapacity = capacity;
+  dallasIndexMask = buckets - 1;
+  indexDallasSensors();
+  return true;
+}
+
+// returns the entry of a new sensor, or -1 when the registry is full
+static int addDallasSensor(const uint8_t* rom) {
+  if (dallasCount == dallasCapacity && !growDallasSensors()) return -1;
+  int i = dallasCount++;
+  dallasSensors[i] = dallasDataStruct();
+  memcpy(dallasSensors[i].sensor, rom, sizeof(DeviceAddress));
+  uint16_t bucket = dallasHash(rom);
+  while (dallasIndex[bucket] != DALLAS_INDEX_EMPTY) {
+    bucket = (bucket + 1) & dallasIndexMask;
+  }
+  dallasIndex[bucket] = i;
+  dallasStats.sensors = dallasCount;
+  return i;
+}
+
+// the last entry takes the place of the removed one
+static void removeDallasEntry(int i) {
+  dallasCount--;
+  if (i != dallasCount) {
+    //readIndex stays, a moved entry behind it is read in the next round
+    dallasSensors[i] = dallasSensors[dallasCount];
+  }
+  indexDallasSensors();
+  dallasStats.sensors = dallasCount;
+}
+
 void rescanDallasSensors(void (*log_message)(char*), unsigned int dallasResolution) {
   char log_msg[256];
-  DS18B20.begin(); // re-search the bus so newly attached sensors are actually detected
-  int found = DS18B20.getDeviceCount();
-  sprintf_P(log_msg, PSTR("Number of 1wire sensors on bus: %d"), found); log_message(log_msg);
+  char addrStr[17];
+  bool parasite = false;
 
   //assume known sensors are gone until the scan below re-affirms them
-  for (int i = 0; i < MAX_DALLAS_SENSORS; i++) {
-    if (actDallasData[i].known) actDallasData[i].present = false;
+  for (uint8_t i = 0; i < dallasCount; i++) {
+    dallasSensors[i].present = false;
   }
 
-  for (int j = 0; j < found; j++) {
+  for (uint8_t bus = 0; bus < DALLAS_BUSES; bus++) {
+    DS18B20[bus].begin(); // re-search the bus so newly attached sensors are actually detected
+    parasite |= DS18B20[bus].isParasitePowerMode();
+    sprintf_P(log_msg, PSTR("Number of 1wire sensors on bus %d (pin %d): %d"), bus, dallasBusPins[bus], DS18B20[bus].getDeviceCount()); log_message(log_msg);
+
+    //one pass over the bus, getAddress() would search it again for every sensor
     DeviceAddress addr;
-    if (!DS18B20.getAddress(addr, j)) continue;
-    char addrStr[17];
-    addrStr[16] = '\0';
-    for (int x = 0; x < 8; x++) {
-      sprintf(&addrStr[x * 2], "%02x", addr[x]);
-    }
+    oneWire[bus].reset_search();
+    while (oneWire[bus].search(addr)) {
+      if (!DS18B20[bus].validAddress(addr) || !DS18B20[bus].validFamily(addr)) continue;
+      dallasAddressString(addr, addrStr);
 
-    int slot = findDallasSlot(addrStr);
-    if (slot < 0) {
-      slot = findFreeDallasSlot();
+      int slot = findDallasSensor(addr);
       if (slot < 0) {
-        sprintf_P(log_msg, PSTR("Reached max 1wire sensor count (%d). Ignoring sensor: %s"), MAX_DALLAS_SENSORS, addrStr);
-        log_message(log_msg);
-        continue;
+        slot = addDallasSensor(addr);
+        if (slot < 0) {
+          sprintf_P(log_msg, PSTR("Reached max 1wire sensor count (%d). Ignoring sensor: %s"), dallasCount, addrStr);
+          log_message(log_msg);
+          continue;
+        }
+        sprintf_P(log_msg, PSTR("Found new 1wire sensor: %s"), addrStr); log_message(log_msg);
+        sprintf_P(log_msg, PSTR("{\"data\": {\"dallasRescan\": true}}")); websocket_write_all(log_msg, strlen(log_msg)); // tell open browser tabs to reload the sensor table
       }
-      actDallasData[slot].known = true;
-      strlcpy(actDallasData[slot].address, addrStr, sizeof(actDallasData[slot].address));
-      actDallasData[slot].temperature = -127.0;
-      actDallasData[slot].lastgoodtime = 0;
-      strlcpy(actDallasData[slot].alias, "NOT SET", sizeof(actDallasData[slot].alias));
-      sprintf_P(log_msg, PSTR("Found new 1wire sensor: %s"), addrStr); log_message(log_msg);
-      sprintf_P(log_msg, PSTR("{\"data\": {\"dallasRescan\": true}}")); websocket_write_all(log_msg, strlen(log_msg)); // tell open browser tabs to reload the sensor table
+      dallasSensors[slot].bus = bus;
+      dallasSensors[slot].present = true;
+      DS18B20[bus].setResolution(addr, dallasResolution);
     }
-    memcpy(actDallasData[slot].sensor, addr, sizeof(DeviceAddress));
-    actDallasData[slot].present = true;
-    DS18B20.setResolution(addr, dallasResolution);
+    DS18B20[bus].setWaitForConversion(false); //conversion is waited for in dallasLoop
   }
 
-  for (int i = 0; i < MAX_DALLAS_SENSORS; i++) {
-    if (actDallasData[i].known && !actDallasData[i].present) {
-      sprintf_P(log_msg, PSTR("Known 1wire sensor not responding: %s"), actDallasData[i].address); log_message(log_msg);
+  for (uint8_t i = 0; i < dallasCount; i++) {
+    if (!dallasSensors[i].present) {
+      dallasAddressString(dallasSensors[i].sensor, addrStr);
+      sprintf_P(log_msg, PSTR("Known 1wire sensor not responding: %s"), addrStr); log_message(log_msg);
     }
   }
 
-  if (DALLASASYNC) DS18B20.setWaitForConversion(false); //async 1wire during next loops
+  conversionTime = DS18B20[0].millisToWaitForConversion(dallasResolution); //94 ms at 9 bit up to 750 ms at 12 bit
+  pollConversion = DALLAS_POLL_CONVERSION && !parasite;
+  dallasState = DALLAS_STATE_IDLE; //the search above ended a running conversion
   loadDallasAlias();
 }
 
-void initDallasSensors(void (*log_message)(char*), unsigned int updateAllDallasTimeSettings, unsigned int dallasTimerWaitSettings, unsigned int dallasResolution) {
+// A fast boot sets up the buses now and scans them later with rescanDallasSensors
+void initDallasSensors(void (*log_message)(char*), unsigned int updateAllDallasTimeSettings, unsigned int dallasTimerWaitSettings, unsigned int dallasResolution, bool scan) {
   updateAllDallasTime = updateAllDallasTimeSettings;
   dallasTimerWait = dallasTimerWaitSettings;
 
-  if (!actDallasData) {
-    actDallasData = new dallasDataStruct [MAX_DALLAS_SENSORS];
-    dallasDevicecount = MAX_DALLAS_SENSORS;
+  if (dallasSensors == NULL) {
+    for (uint8_t bus = 0; bus < DALLAS_BUSES; bus++) {
+      oneWire[bus].begin(dallasBusPins[bus]);
+      DS18B20[bus].setOneWire(&oneWire[bus]);
+    }
+    growDallasSensors();
   }
 
-  rescanDallasSensors(log_message, dallasResolution);
+  if (scan) rescanDallasSensors(log_message, dallasResolution);
 }
 
 void resetlastalldatatime_dallas() {
   lastalldatatime_dallas = 0;
 }
 
-void readNewDallasTemp(PubSubClient &mqtt_client, void (*log_message)(char*), char* mqtt_topic_base) {
+static void dallasSlice(unsigned long start) {
+  unsigned long elapsed = micros() - start;
+  if (elapsed > dallasStats.maxSlice) {
+    dallasStats.maxSlice = elapsed;
+  }
+}
+
+// Handles the temperature read from the sensor in slot i
+static void handleDallasTemp(int i, float temp, void (*log_message)(char*), char* mqtt_topic_base) {
   char log_msg[256];
   char mqtt_topic[256];
   char valueStr[80];
-  bool updatenow = false;
-
-  if ((lastalldatatime_dallas == 0) || ((unsigned long)(millis() - lastalldatatime_dallas) >  (1000 * updateAllDallasTime))) {
-    updatenow = true;
-    lastalldatatime_dallas = millis();
-  }
-  if (!(DALLASASYNC)) DS18B20.requestTemperatures();
-  for (int i = 0; i < dallasDevicecount; i++) {
-    if (!actDallasData[i].known) continue; // query every known sensor, even ones currently marked offline, so they can be marked online again once they respond
-    float temp = DS18B20.getTempC(actDallasData[i].sensor);
-    bool wasPresent = actDallasData[i].present;
-    if (temp < -120.0) {
-      actDallasData[i].present = false;
-      if (wasPresent) {
-        sprintf_P(log_msg, PSTR("1wire sensor went offline: %s"), actDallasData[i].address); log_message(log_msg);
-        sprintf_P(log_msg, PSTR("{\"data\": {\"dallasvalues\": {\"sensorID\": \"%s\", \"present\": false}}}"), actDallasData[i].address);
-        websocket_write_all(log_msg, strlen(log_msg));
-      }
+  char address[17];
+  dallasDataStruct &data = dallasSensors[i];
+  dallasAddressString(data.sensor, address);
+  bool wasPresent = data.present;
+  if (temp < -120.0) {
+    data.present = false;
+    if (wasPresent) {
+      sprintf_P(log_msg, PSTR("1wire sensor went offline: %s"), address); log_message(log_msg);
+      sprintf_P(log_msg, PSTR("{\"data\": {\"dallasvalues\": {\"sensorID\": \"%s\", \"present\": false}}}"), address);
+      websocket_write_all(log_msg, strlen(log_msg));
+    }
+  } else {
+    data.present = true;
+    if (!wasPresent) {
+      sprintf_P(log_msg, PSTR("1wire sensor back online: %s"), address); log_message(log_msg);
+      sprintf_P(log_msg, PSTR("{\"data\": {\"dallasvalues\": {\"sensorID\": \"%s\", \"present\": true}}}"), address);
+      websocket_write_all(log_msg, strlen(log_msg));
+    }
+    float allowedtempdiff = (((millis() - data.lastgoodtime)) / 1000.0) * MAXTEMPDIFFPERSEC;
+    if (fabs(temp - 85.0) < 0.0001) { // 85.0C is the DS18B20 power-on reset default, not a real reading; sensor is online, just not converted yet
+      sprintf_P(log_msg, PSTR("Ignoring 1wire sensor power-on-reset value (85.00): %s"), address);
+      log_message(log_msg);
+    } else if ((data.temperature != -127.0) and ((temp > (data.temperature + allowedtempdiff)) or (temp < (data.temperature - allowedtempdiff)))) {
+      sprintf_P(log_msg, PSTR("Filtering 1wire sensor temperature (%s). Delta to high. Current: %.2f Last: %.2f"), address, temp, data.temperature);
+      log_message(log_msg);
     } else {
-      actDallasData[i].present = true;
-      if (!wasPresent) {
-        sprintf_P(log_msg, PSTR("1wire sensor back online: %s"), actDallasData[i].address); log_message(log_msg);
-        sprintf_P(log_msg, PSTR("{\"data\": {\"dallasvalues\": {\"sensorID\": \"%s\", \"present\": true}}}"), actDallasData[i].address);
-        websocket_write_all(log_msg, strlen(log_msg));
-      }
-      float allowedtempdiff = (((millis() - actDallasData[i].lastgoodtime)) / 1000.0) * MAXTEMPDIFFPERSEC;
-      if (fabs(temp - 85.0) < 0.0001) { // 85.0C is the DS18B20 power-on reset default, not a real reading; sensor is online, just not converted yet
-        sprintf_P(log_msg, PSTR("Ignoring 1wire sensor power-on-reset value (85.00): %s"), actDallasData[i].address);
+      data.lastgoodtime = millis();
+      if ((updateAll) || (data.temperature != temp )) {  //only update mqtt topic if temp changed or after each update timer
+        data.temperature = temp;
+        sprintf(log_msg, PSTR("Received 1wire sensor temperature (%s): %.2f"), address, data.temperature);
         log_message(log_msg);
-      } else if ((actDallasData[i].temperature != -127.0) and ((temp > (actDallasData[i].temperature + allowedtempdiff)) or (temp < (actDallasData[i].temperature - allowedtempdiff)))) {
-        sprintf_P(log_msg, PSTR("Filtering 1wire sensor temperature (%s). Delta to high. Current: %.2f Last: %.2f"), actDallasData[i].address, temp, actDallasData[i].temperature);
-        log_message(log_msg);
-      } else {
-        actDallasData[i].lastgoodtime = millis();
-        if ((updatenow) || (actDallasData[i].temperature != temp )) {  //only update mqtt topic if temp changed or after each update timer
-          actDallasData[i].temperature = temp;
-          sprintf(log_msg, PSTR("Received 1wire sensor temperature (%s): %.2f"), actDallasData[i].address, actDallasData[i].temperature);
-          log_message(log_msg);
-          if (true) {
-            sprintf_P(valueStr, PSTR("%.2f"), actDallasData[i].temperature);
-            sprintf_P(mqtt_topic, PSTR("%s/%s/%s"), mqtt_topic_base, mqtt_topic_1wire, actDallasData[i].address); mqtt_client.publish(mqtt_topic, valueStr, MQTT_RETAIN_VALUES);
-            sprintf_P(valueStr, PSTR("%s"), actDallasData[i].alias);
-            sprintf_P(mqtt_topic, PSTR("%s/%s/%s/alias"), mqtt_topic_base, mqtt_topic_1wire, actDallasData[i].address); mqtt_client.publish(mqtt_topic, valueStr, MQTT_RETAIN_VALUES);
-          } else {
-            sprintf_P(valueStr, PSTR("{\"Temperature\":%.2f,\"Alias\":\"%s\"}"), actDallasData[i].temperature, actDallasData[i].alias);
-            sprintf_P(mqtt_topic, PSTR("%s/%s/%s"), mqtt_topic_base, mqtt_topic_1wire, actDallasData[i].address); mqtt_client.publish(mqtt_topic, valueStr, MQTT_RETAIN_VALUES);
-          }
-          sprintf_P(log_msg, PSTR("{\"data\": {\"dallasvalues\": {\"sensorID\": \"%s\", \"value\": %.2f}}}"), actDallasData[i].address, actDallasData[i].temperature);
-          websocket_write_all(log_msg, strlen(log_msg));          
-          rules_event_cb(_F("ds18b20#"), actDallasData[i].address);
+        if (true) {
+          sprintf_P(valueStr, PSTR("%.2f"), data.temperature);
+          sprintf_P(mqtt_topic, PSTR("%s/%s/%s"), mqtt_topic_base, mqtt_topic_1wire, address); mqttQueuePublish(mqtt_topic, valueStr, MQTT_QUEUE_COALESCE | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
+          sprintf_P(valueStr, PSTR("%s"), data.alias);
+          sprintf_P(mqtt_topic, PSTR("%s/%s/%s/alias"), mqtt_topic_base, mqtt_topic_1wire, address); mqttQueuePublish(mqtt_topic, valueStr, MQTT_QUEUE_COALESCE | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
+        } else {
+          sprintf_P(valueStr, PSTR("{\"Temperature\":%.2f,\"Alias\":\"%s\"}"), data.temperature, data.alias);
+          sprintf_P(mqtt_topic, PSTR("%s/%s/%s"), mqtt_topic_base, mqtt_topic_1wire, address); mqttQueuePublish(mqtt_topic, valueStr, MQTT_QUEUE_COALESCE | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
         }
+        sprintf_P(log_msg, PSTR("{\"data\": {\"dallasvalues\": {\"sensorID\": \"%s\", \"value\": %.2f}}}"), address, data.temperature);
+        websocket_write_all(log_msg, strlen(log_msg));          
+        rules_event_cb(_F("ds18b20#"), address);
       }
     }
   }
 }
 
+// Reads the sensors after the conversion, one per call so a full bus does
+// not hold up the loop. Every step is short, the longest is one scratchpad.
 void dallasLoop(PubSubClient &mqtt_client, void (*log_message)(char*), char* mqtt_topic_base) {
-  if ((unsigned long)(millis() - dallasTimer) > (1000 * dallasTimerWait)) {
-    log_message((char*)"Requesting new 1wire temperatures");
-    dallasTimer = millis();
-    if (DALLASASYNC){
-      DS18B20.requestTemperatures();
-      dallasTimer1=millis();
-    }else{
-      readNewDallasTemp(mqtt_client, log_message, mqtt_topic_base);
-    }
+  unsigned long now = millis();
+  switch (dallasState) {
+    case DALLAS_STATE_IDLE: {
+        if ((unsigned long)(now - dallasTimer) > (1000 * dallasTimerWait)) {
+          log_message((char*)"Requesting new 1wire temperatures");
+          dallasTimer = now;
+          lastConversionPoll = now;
+          unsigned long start = micros();
+          for (uint8_t bus = 0; bus < DALLAS_BUSES; bus++) {
+            DS18B20[bus].requestTemperatures(); //all sensors of the bus at once
+          }
+          dallasSlice(start);
+          dallasState = DALLAS_STATE_CONVERTING;
+        }
+      } break;
+    case DALLAS_STATE_CONVERTING: {
+        unsigned long elapsed = now - dallasTimer;
+        bool done = (elapsed >= conversionTime);
+        if (!done && pollConversion && ((unsigned long)(now - lastConversionPoll) >= DALLAS_POLL_INTERVAL)) {
+          lastConversionPoll = now;
+          done = true;
+          for (uint8_t bus = 0; bus < DALLAS_BUSES; bus++) {
+            done &= DS18B20[bus].isConversionComplete();
+          }
+        }
+        if (done) {
+          dallasStats.conversions++;
+          dallasStats.lastConversion = elapsed;
+          if ((lastalldatatime_dallas == 0) || ((unsigned long)(now - lastalldatatime_dallas) > (1000 * updateAllDallasTime))) {
+            updateAll = true;
+            lastalldatatime_dallas = now;
+          } else {
+            updateAll = false;
+          }
+          readIndex = 0;
+          dallasState = DALLAS_STATE_READING;
+        }
+      } break;
+    case DALLAS_STATE_READING: {
+        // query every known sensor, even ones currently marked offline, so they can be marked online again once they respond
+        if (readIndex >= dallasCount) {
+          dallasState = DALLAS_STATE_IDLE;
+          break;
+        }
+        unsigned long start = micros();
+        float temp = DS18B20[dallasSensors[readIndex].bus].getTempC(dallasSensors[readIndex].sensor);
+        dallasSlice(start);
+        dallasStats.reads++;
+        handleDallasTemp(readIndex, temp, log_message, mqtt_topic_base);
+        readIndex++;
+      } break;
   }
-  if ((dallasTimer1!=0) && ((millis() - dallasTimer1)>750)){
-    dallasTimer1=0;
-    readNewDallasTemp(mqtt_client, log_message, mqtt_topic_base);
-  }   
 }
 
 void dallasJsonOutput(struct webserver_t *client) {
   webserver_send_content_P(client, PSTR("["), 1);
 
-  bool first = true;
-  for (int i = 0; i < dallasDevicecount; i++) {
-    if (!actDallasData[i].known) continue;
-    if (!first) webserver_send_content_P(client, PSTR(","), 1);
-    first = false;
+  char str[64];
+  for (uint8_t i = 0; i < dallasCount; i++) {
+    if (i > 0) webserver_send_content_P(client, PSTR(","), 1);
     webserver_send_content_P(client, PSTR("{\"Sensor\":\""), 11);
-    webserver_send_content(client, actDallasData[i].address, strlen(actDallasData[i].address));
+    dallasAddressString(dallasSensors[i].sensor, str);
+    webserver_send_content(client, str, 16);
     webserver_send_content_P(client, PSTR("\",\"Temperature\":"), 16);
-    char str[64];
-    dtostrf(actDallasData[i].temperature, 0, 2, str);
+    dtostrf(dallasSensors[i].temperature, 0, 2, str);
     webserver_send_content(client, str, strlen(str));
     webserver_send_content_P(client, PSTR(",\"Alias\":\""), 10);
-    webserver_send_content(client, actDallasData[i].alias, strlen(actDallasData[i].alias));
+    webserver_send_content(client, dallasSensors[i].alias, strlen(dallasSensors[i].alias));
     webserver_send_content_P(client, PSTR("\",\"Present\":"), 12);
-    if (actDallasData[i].present) {
+    if (dallasSensors[i].present) {
       webserver_send_content_P(client, PSTR("true"), 4);
     } else {
       webserver_send_content_P(client, PSTR("false"), 5);
     }
     webserver_send_content_P(client, PSTR(",\"LastSeenSeconds\":"), 19);
-    long lastSeenSeconds = (actDallasData[i].lastgoodtime == 0) ? -1 : (long)((millis() - actDallasData[i].lastgoodtime) / 1000);
+    long lastSeenSeconds = (dallasSensors[i].lastgoodtime == 0) ? -1 : (long)((millis() - dallasSensors[i].lastgoodtime) / 1000);
     sprintf(str, "%ld", lastSeenSeconds);
     webserver_send_content(client, str, strlen(str));
     webserver_send_content_P(client, PSTR("}"), 1);
@@ -231,65 +380,74 @@ void dallasJsonOutput(struct webserver_t *client) {
 
 void saveDallasAliasFile() {
   JsonDocument jsonDoc;
-  for (int i = 0 ; i < dallasDevicecount; i++) {
-    if (!actDallasData[i].known) continue;
-    jsonDoc[actDallasData[i].address] = actDallasData[i].alias;
-  }
-  if (LittleFS.begin()) {
-    File configFile = LittleFS.open("/dallas.json", "w");
-    if (configFile) {
-      serializeJson(jsonDoc, configFile);
-      configFile.close();
-    }
+  char address[17];
+  for (uint8_t i = 0 ; i < dallasCount; i++) {
+    dallasAddressString(dallasSensors[i].sensor, address);
+    jsonDoc[address] = dallasSensors[i].alias;
   }
+  String json;
+  serializeJson(jsonDoc, json);
+  persistWrite("/dallas.json", json.c_str(), json.length(), 0); //alias edits in a row end up in one write
+}
+
+// the entry of a sensor by its hex address, -1 if unknown
+static int findDallasAddress(const char* address) {
+  DeviceAddress rom;
+  if (!parseDallasAddress(address, rom)) return -1;
+  return findDallasSensor(rom);
 }
 
 void changeDallasAlias(char* address, char* alias) {
-  int slot = findDallasSlot(address);
+  int slot = findDallasAddress(address);
   if (slot < 0) return;
-  strlcpy(actDallasData[slot].alias, alias, sizeof(actDallasData[slot].alias));
+  strlcpy(dallasSensors[slot].alias, alias, sizeof(dallasSensors[slot].alias));
   saveDallasAliasFile();
 }
 
 void removeDallasSensor(PubSubClient &mqtt_client, char* mqtt_topic_base, char* address, void (*log_message)(char*)) {
   char log_msg[256];
-  int slot = findDallasSlot(address);
+  int slot = findDallasAddress(address);
   if (slot < 0) return;
 
   char mqtt_topic[256];
   // publishing an empty retained payload clears the previously retained message on the broker
-  sprintf_P(mqtt_topic, PSTR("%s/%s/%s"), mqtt_topic_base, mqtt_topic_1wire, address); mqtt_client.publish(mqtt_topic, "", true);
-  sprintf_P(mqtt_topic, PSTR("%s/%s/%s/alias"), mqtt_topic_base, mqtt_topic_1wire, address); mqtt_client.publish(mqtt_topic, "", true);
+  sprintf_P(mqtt_topic, PSTR("%s/%s/%s"), mqtt_topic_base, mqtt_topic_1wire, address); mqttQueuePublish(mqtt_topic, "", MQTT_QUEUE_COALESCE | MQTT_QUEUE_RETAIN);
+  sprintf_P(mqtt_topic, PSTR("%s/%s/%s/alias"), mqtt_topic_base, mqtt_topic_1wire, address); mqttQueuePublish(mqtt_topic, "", MQTT_QUEUE_COALESCE | MQTT_QUEUE_RETAIN);
 
   sprintf_P(log_msg, PSTR("Removed 1wire sensor: %s"), address); log_message(log_msg);
 
-  actDallasData[slot] = dallasDataStruct();
+  removeDallasEntry(slot);
   saveDallasAliasFile();
   sprintf_P(log_msg, PSTR("{\"data\": {\"dallasRescan\": true}}")); websocket_write_all(log_msg, strlen(log_msg)); // tell open browser tabs to reload the sensor table
 }
 
 void restoreDallasFromMqtt(char* address, float temperature, void (*log_message)(char*)) {
   char log_msg[256];
-  int slot = findDallasSlot(address);
+  DeviceAddress rom;
+  if (strlen(address) != 16 || !parseDallasAddress(address, rom)) return; //not a sensor address
+  int slot = findDallasSensor(rom);
   if (slot < 0) {
-    slot = findFreeDallasSlot();
+    slot = addDallasSensor(rom); // the ROM code allows this sensor to be polled directly without waiting for a bus rescan
     if (slot < 0) return; //no room left, ignore
-    actDallasData[slot].known = true;
-    actDallasData[slot].present = false;
-    strlcpy(actDallasData[slot].address, address, sizeof(actDallasData[slot].address));
-    if (strlen(address) == 16) parseDallasAddress(address, actDallasData[slot].sensor); // allows this sensor to be polled directly without waiting for a bus rescan
-    strlcpy(actDallasData[slot].alias, "NOT SET", sizeof(actDallasData[slot].alias));
     sprintf_P(log_msg, PSTR("Restored previously known 1wire sensor from mqtt: %s"), address); log_message(log_msg);
     loadDallasAlias();
     sprintf_P(log_msg, PSTR("{\"data\": {\"dallasRescan\": true}}")); websocket_write_all(log_msg, strlen(log_msg)); // tell open browser tabs to reload the sensor table
   }
-  if (actDallasData[slot].lastgoodtime == 0) { //only backfill if we haven't taken a real reading yet this boot
-    actDallasData[slot].temperature = temperature;
+  if (dallasSensors[slot].lastgoodtime == 0) { //only backfill if we haven't taken a real reading yet this boot
+    dallasSensors[slot].temperature = temperature;
   }
 }
 
+bool getDallasTemperature(const char* address, float* temperature) {
+  int slot = findDallasAddress(address);
+  if (slot < 0) return false;
+  *temperature = dallasSensors[slot].temperature;
+  return true;
+}
+
 void loadDallasAlias() {
-  if (LittleFS.begin()) {
+  if (persistMount()) {
+    persistFlush("/dallas.json"); //an alias edit may still be queued
     if (LittleFS.exists("/dallas.json")) {
       File configFile = LittleFS.open("/dallas.json", "r");
       if (configFile) {
@@ -297,11 +455,11 @@ void loadDallasAlias() {
         std::unique_ptr<char[]> buf(new char[size]);
         configFile.readBytes(buf.get(), size);
         JsonDocument jsonDoc;
-        DeserializationError error = deserializeJson(jsonDoc, buf.get());
+        DeserializationError error = deserializeJson(jsonDoc, buf.get(), size);
         if (!error) {
-          for (int i = 0 ; i < dallasDevicecount; i++) {
-            if (!actDallasData[i].known) continue;
-            if ( jsonDoc[actDallasData[i].address] ) strncpy(actDallasData[i].alias, jsonDoc[actDallasData[i].address], sizeof(actDallasData[i].alias));
+          for (JsonPair alias : jsonDoc.as<JsonObject>()) {
+            int slot = findDallasAddress(alias.key().c_str());
+            if (slot >= 0 && alias.value().is<const char*>()) strlcpy(dallasSensors[slot].alias, alias.value().as<const char*>(), sizeof(dallasSensors[slot].alias));
           }
         }
       }
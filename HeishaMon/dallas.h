@@ -6,30 +6,48 @@
 #include <DallasTemperature.h>
 #include "src/common/webserver.h"
 
-#define MAX_DALLAS_SENSORS 15
+#define DALLAS_POLL_CONVERSION 1 // end the conversion wait on the done bit, only without parasite powered sensors
+#define DALLAS_POLL_INTERVAL 10 // ms between reads of the conversion done bit
+#define DALLAS_INITIAL_SENSORS 8 // registry size at boot, doubled when a bus has more sensors
 #if defined(ESP8266)
-#define ONE_WIRE_BUS 4
+#define MAX_DALLAS_SENSORS 64
+#ifndef ONE_WIRE_BUSES
+#define ONE_WIRE_BUSES { 4 } // pins with a 1-wire bus, the first is the connector on the board
+#endif
 #elif defined(ESP32)
-#define ONE_WIRE_BUS 3
+#define MAX_DALLAS_SENSORS 128
+#ifndef ONE_WIRE_BUSES
+#define ONE_WIRE_BUSES { 3 } // pins with a 1-wire bus, the first is the connector on the board
+#endif
 #endif
 
 struct dallasDataStruct {
   float temperature = -127.0;
   unsigned long lastgoodtime = 0;
-  bool known = false;   // slot is in use (sensor has been seen on the bus and/or restored from mqtt)
   bool present = false; // sensor was found on the 1-wire bus during the last scan
-  DeviceAddress sensor;
-  char address[17] = "";
+  uint8_t bus = 0; // index in ONE_WIRE_BUSES
+  DeviceAddress sensor; // ROM code, the key of the registry
   char alias[32] = "NOT SET";
 };
 
+struct dallasStatsStruct {
+  unsigned long conversions = 0;
+  unsigned long reads = 0; // scratchpads read, one per loop
+  unsigned long lastConversion = 0; // ms from the convert command until all sensors were done
+  unsigned long maxSlice = 0; // us of the longest 1-wire transaction in one loop
+  unsigned int sensors = 0;
+};
+
+extern dallasStatsStruct dallasStats;
+
 void resetlastalldatatime_dallas();
 void dallasLoop(PubSubClient &mqtt_client, void (*log_message)(char*), char* mqtt_topic_base);
-void initDallasSensors(void (*log_message)(char*), unsigned int updataAllDallasTimeSettings, unsigned int dallasTimerWaitSettings, unsigned int dallasResolution);
+void initDallasSensors(void (*log_message)(char*), unsigned int updataAllDallasTimeSettings, unsigned int dallasTimerWaitSettings, unsigned int dallasResolution, bool scan);
 void rescanDallasSensors(void (*log_message)(char*), unsigned int dallasResolution);
 void dallasJsonOutput(struct webserver_t *client);
 void changeDallasAlias(char* address, char* alias);
 void removeDallasSensor(PubSubClient &mqtt_client, char* mqtt_topic_base, char* address, void (*log_message)(char*));
 void restoreDallasFromMqtt(char* address, float temperature, void (*log_message)(char*));
+bool getDallasTemperature(const char* address, float* temperature);
 
 #endif
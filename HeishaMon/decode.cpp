@@ -1,6 +1,7 @@
 #include "decode.h"
 #include "commands.h"
 #include "rules.h"
+#include "mqttqueue.h"
 #include "src/common/progmem.h"
 
 void websocket_write_all(char *data, uint16_t data_len);
@@ -311,7 +312,7 @@ void decode_heatpump_data(char* data, char* actData, PubSubClient &mqtt_client,
       sprintf_P(log_msg, PSTR("received TOP%d %s: %s"), Topic_Number, topics[Topic_Number], Topic_Value.c_str());
       log_message(log_msg);
       sprintf_P(mqtt_topic, PSTR("%s/%s/%s"), mqtt_topic_base, mqtt_topic_values, topics[Topic_Number]);
-      mqtt_client.publish(mqtt_topic, Topic_Value.c_str(), MQTT_RETAIN_VALUES);
+      mqttQueuePublish(mqtt_topic, Topic_Value.c_str(), MQTT_QUEUE_COALESCE | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
     }
   }
   memcpy(actData, data, DATASIZE);
@@ -357,7 +358,7 @@ void decode_heatpump_data_extra(char* data, char* actDataExtra, PubSubClient &mq
       sprintf_P(log_msg, PSTR("received XTOP%d %s: %s"), Topic_Number, xtopics[Topic_Number], Topic_Value.c_str());
       log_message(log_msg);
       sprintf_P(mqtt_topic, PSTR("%s/%s/%s"), mqtt_topic_base, mqtt_topic_xvalues, xtopics[Topic_Number]);
-      mqtt_client.publish(mqtt_topic, Topic_Value.c_str(), MQTT_RETAIN_VALUES);
+      mqttQueuePublish(mqtt_topic, Topic_Value.c_str(), MQTT_QUEUE_COALESCE | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
     }
   }
   memcpy(actDataExtra, data, DATASIZE);
@@ -399,7 +400,7 @@ void decode_optional_heatpump_data(char* data, char* actOptData, PubSubClient &
       sprintf_P(log_msg, PSTR("received OPT%d %s: %s"), Topic_Number, optTopics[Topic_Number], Topic_Value.c_str());
       log_message(log_msg);
       sprintf_P(mqtt_topic, PSTR("%s/%s/%s"), mqtt_topic_base, mqtt_topic_pcbvalues, optTopics[Topic_Number]);
-      mqtt_client.publish(mqtt_topic, Topic_Value.c_str(), MQTT_RETAIN_VALUES);
+      mqttQueuePublish(mqtt_topic, Topic_Value.c_str(), MQTT_QUEUE_COALESCE | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
 
     }
   }
@@ -1,13 +1,153 @@
 #include "gpio.h"
+#include "mqttqueue.h"
+#include "rules.h"
+#include "HeishaOT.h"
 #include "src/common/progmem.h"
 #include "src/common/stricmp.h"
 const char* mqtt_topic_gpio PROGMEM = "gpio";
+const char* mqtt_topic_gpio_input PROGMEM = "gpio_input";
 
 void log_message(char* string);
 
-void setupGPIO(gpioSettingsStruct gpioSettings) {
+gpioStatsStruct gpioStats;
+
+struct gpioInputStruct {
+  uint8_t pin = 255; // 255 if this gpio is not an input
+  bool polled = false; // no interrupt on this pin, sampled in gpioLoop
+  bool pending = false; // changed, waiting until it is stable
+  uint8_t state = 0; // debounced level
+  uint8_t sampled = 0; // last level read by polling
+  unsigned long firstEdge = 0;
+};
+
+static gpioInputStruct gpioInputs[NUMGPIO];
+static bool gpioPublishAll = true;
+
+// Written by the interrupt, the head last so the loop only sees complete entries
+static volatile uint32_t gpioRingHead = 0;
+static volatile uint32_t gpioRingTail = 0;
+static volatile unsigned long gpioRingTime[GPIO_RING_SIZE];
+static volatile uint8_t gpioRingInput[GPIO_RING_SIZE];
+static volatile unsigned long gpioLastEdge[NUMGPIO];
+static volatile bool gpioRingOverflow = false;
+
+IRAM_ATTR void onGPIOChange(void* input) {
+  unsigned long now = millis();
+  int i = (int)(intptr_t)input;
+  gpioLastEdge[i] = now;
+  uint32_t head = gpioRingHead;
+  if ((head - gpioRingTail) >= GPIO_RING_SIZE) {
+    gpioRingOverflow = true;
+    return;
+  }
+  gpioRingTime[head % GPIO_RING_SIZE] = now;
+  gpioRingInput[head % GPIO_RING_SIZE] = i;
+  gpioRingHead = head + 1;
+}
+
+// The opentherm pins are left alone when opentherm is used, on ESP8266 these
+// are gpio 1 and 3 of the default list
+void setupGPIO(gpioSettingsStruct gpioSettings, bool opentherm) {
   for (int i = 0 ;  i < NUMGPIO ; i++) {
+    if (opentherm && ((gpioSettings.gpioPin[i] == inOTPin) || (gpioSettings.gpioPin[i] == outOTPin))) continue;
     pinMode(gpioSettings.gpioPin[i], gpioSettings.gpioMode[i]);
+    if (gpioSettings.gpioMode[i] == OUTPUT) continue;
+
+    gpioInputs[i].pin = gpioSettings.gpioPin[i];
+    gpioInputs[i].state = digitalRead(gpioInputs[i].pin);
+    gpioInputs[i].sampled = gpioInputs[i].state;
+#if defined(ESP8266)
+    gpioInputs[i].polled = (gpioInputs[i].pin == 16); //gpio16 has no interrupt
+#endif
+    if (!gpioInputs[i].polled) {
+      attachInterruptArg(digitalPinToInterrupt(gpioInputs[i].pin), onGPIOChange, (void*)(intptr_t)i, CHANGE);
+    }
+  }
+}
+
+// resend all input states to mqtt
+void resetlastalldatatime_gpio() {
+  gpioPublishAll = true;
+}
+
+// the debounced level of an input gpio, -1 if the pin is no input
+int gpioInputState(int pin) {
+  for (int i = 0 ; i < NUMGPIO ; i++) {
+    if (gpioInputs[i].pin == pin) return gpioInputs[i].state;
+  }
+  return -1;
+}
+
+static void publishGPIOInput(int i, char* mqtt_topic_base) {
+  char mqtt_topic[256];
+  sprintf_P(mqtt_topic, PSTR("%s/%s/%d"), mqtt_topic_base, mqtt_topic_gpio_input, gpioInputs[i].pin);
+  mqttQueuePublish(mqtt_topic, gpioInputs[i].state ? "1" : "0", MQTT_QUEUE_COALESCE | MQTT_QUEUE_RETAIN);
+}
+
+// Takes the edges from the interrupt and handles the inputs that are stable
+// again: a changed level is published and raises the rules event gpio#<pin>.
+void gpioLoop(char* mqtt_topic_base) {
+  unsigned long now = millis();
+
+  uint32_t head = gpioRingHead;
+  while (gpioRingTail != head) {
+    gpioInputStruct* input = &gpioInputs[gpioRingInput[gpioRingTail % GPIO_RING_SIZE]];
+    if (!input->pending) {
+      input->pending = true;
+      input->firstEdge = gpioRingTime[gpioRingTail % GPIO_RING_SIZE];
+    }
+    gpioStats.edges++;
+    gpioRingTail++;
+  }
+  if (gpioRingOverflow) { //look at all inputs again, the edges are lost
+    gpioRingOverflow = false;
+    gpioStats.overflows++;
+    for (int i = 0 ; i < NUMGPIO ; i++) {
+      if ((gpioInputs[i].pin != 255) && !gpioInputs[i].pending) {
+        gpioInputs[i].pending = true;
+        gpioInputs[i].firstEdge = now;
+      }
+    }
+  }
+
+  char log_msg[256];
+  for (int i = 0 ; i < NUMGPIO ; i++) {
+    gpioInputStruct* input = &gpioInputs[i];
+    if (input->pin == 255) continue;
+    if (input->polled) {
+      uint8_t level = digitalRead(input->pin);
+      if (level != input->sampled) {
+        input->sampled = level;
+        gpioLastEdge[i] = now;
+        if (!input->pending) {
+          input->pending = true;
+          input->firstEdge = now;
+        }
+      }
+    }
+    if (input->pending && ((unsigned long)(now - gpioLastEdge[i]) >= GPIO_DEBOUNCE)) {
+      input->pending = false;
+      uint8_t level = digitalRead(input->pin);
+      if (level != input->state) { //a bounce that ends on the old level is no change
+        input->state = level;
+        unsigned long latency = now - input->firstEdge;
+        if (latency > gpioStats.maxLatency) gpioStats.maxLatency = latency;
+        gpioStats.events++;
+        sprintf_P(log_msg, PSTR("GPIO: input %d changed to %d"), input->pin, level);
+        log_message(log_msg);
+        publishGPIOInput(i, mqtt_topic_base);
+        char pin[4];
+        itoa(input->pin, pin, 10);
+        rules_event_cb(_F("gpio#"), pin);
+      }
+    }
+  }
+
+  if (gpioPublishAll) {
+    gpioPublishAll = false;
+    for (int i = 0 ; i < NUMGPIO ; i++) {
+      if (gpioInputs[i].pin != 255) publishGPIOInput(i, mqtt_topic_base);
+    }
   }
 }
 
@@ -1,3 +1,6 @@
+#ifndef _GPIO_H_
+#define _GPIO_H_
+
 #if defined(ESP8266)
 #define NUMGPIO 3
 #include <ESP8266WiFi.h>
@@ -11,7 +14,11 @@
 #define relayTwoPin 47
 #endif
 
+#define GPIO_DEBOUNCE 25 // ms an input has to be stable before its change counts
+#define GPIO_RING_SIZE 32 // input edges kept until the next loop, a power of two
+
 extern const char* mqtt_topic_gpio;
+extern const char* mqtt_topic_gpio_input;
 
 struct gpioSettingsStruct {
 #if defined(ESP8266)
@@ -23,7 +30,19 @@ struct gpioSettingsStruct {
 #endif
 };
 
-void setupGPIO(gpioSettingsStruct gpioSettings);
-void mqttGPIOCallback(char* topic, char* value);
+struct gpioStatsStruct {
+  unsigned long edges = 0; // seen by the interrupt, bounces included
+  unsigned long events = 0; // debounced changes
+  unsigned long overflows = 0; // edges lost because the ring was full
+  unsigned long maxLatency = 0; // ms from the first edge until the change was handled
+};
 
+extern gpioStatsStruct gpioStats;
 
+void setupGPIO(gpioSettingsStruct gpioSettings, bool opentherm);
+void gpioLoop(char* mqtt_topic_base);
+void resetlastalldatatime_gpio();
+int gpioInputState(int pin);
+void mqttGPIOCallback(char* topic, char* value);
+
+#endif
@@ -0,0 +1,379 @@
+#include "history.h"
+#include <LittleFS.h>
+#include "persist.h"
+#include <time.h>
+
+#define HISTORY_MAGIC "HMHS"
+#define HISTORY_VERSION 1
+#define HISTORY_UNIX_MIN 1600000000UL // times below are uptime seconds before the clock was set
+
+historyStatsStruct historyStats;
+
+static const uint16_t tierInterval[HISTORY_TIERS] PROGMEM = {
+  HISTORY_RAW_INTERVAL,
+  HISTORY_RAW_INTERVAL * HISTORY_MINUTE_SAMPLES,
+  HISTORY_RAW_INTERVAL * HISTORY_MINUTE_SAMPLES * HISTORY_QUARTER_SAMPLES,
+};
+
+static char topicList[64];
+static uint8_t topicCount = 0;
+static bool topicExtra[HISTORY_TOPICS];
+static uint8_t topicNumber[HISTORY_TOPICS];
+
+static byte *store = NULL;
+static uint8_t blocks = HISTORY_BLOCKS;
+static uint16_t blockSize = HISTORY_BLOCK_SIZE;
+static uint8_t head[HISTORY_TOPICS][HISTORY_TIERS]; // block receiving samples
+
+// averages for the 1 and 15 minute tiers
+static int32_t minuteSum[HISTORY_TOPICS];
+static uint8_t minuteCount[HISTORY_TOPICS];
+static uint32_t minuteStart[HISTORY_TOPICS];
+static int32_t quarterSum[HISTORY_TOPICS];
+static uint8_t quarterCount[HISTORY_TOPICS];
+static uint32_t quarterStart[HISTORY_TOPICS];
+
+static uint32_t baseTime = 0; // time of the first tick
+static uint32_t tick = 0;
+static unsigned long lastTick = 0;
+static bool clockSet = false;
+static bool flushEnabled = false;
+static unsigned long lastFlush = 0;
+
+static struct historyBlockStruct *getBlock(uint8_t topic, uint8_t tier, uint8_t block) {
+  return (struct historyBlockStruct *)(store + (((unsigned long)topic * HISTORY_TIERS + tier) * blocks + block) * (sizeof(historyBlockStruct) + blockSize));
+}
+
+static byte *blockData(struct historyBlockStruct *b) {
+  return (byte *)(b + 1);
+}
+
+uint16_t historyInterval(uint8_t tier) {
+  return pgm_read_word(&tierInterval[tier]);
+}
+
+uint32_t historyNow() {
+  return baseTime + tick * HISTORY_RAW_INTERVAL;
+}
+
+static void startBlock(struct historyBlockStruct *b, uint32_t time, int32_t value) {
+  b->start = time;
+  b->first = value;
+  b->last = value;
+  b->count = 1;
+  b->used = 0;
+}
+
+// A sample which does not follow the previous one at the interval of the
+// tier, or whose delta does not fit, starts the next block
+static void append(uint8_t topic, uint8_t tier, uint32_t time, int32_t value) {
+  struct historyBlockStruct *b = getBlock(topic, tier, head[topic][tier]);
+  historyStats.samples++;
+  if (b->count > 0) {
+    if (time == b->start + (uint32_t)b->count * historyInterval(tier)) {
+      byte bytes[5];
+      uint8_t len = 0;
+      int32_t delta = value - b->last;
+      uint32_t zigzag = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+      do {
+        bytes[len++] = (zigzag & 0x7F) | ((zigzag > 0x7F) ? 0x80 : 0);
+        zigzag >>= 7;
+      } while (zigzag > 0);
+      if ((b->used + len <= blockSize) && (b->count < 0xFFFF)) {
+        memcpy(blockData(b) + b->used, bytes, len);
+        b->used += len;
+        b->count++;
+        b->last = value;
+        return;
+      }
+    }
+    head[topic][tier] = (head[topic][tier] + 1) % blocks;
+    b = getBlock(topic, tier, head[topic][tier]);
+  }
+  startBlock(b, time, value);
+}
+
+static void parseTopics(const char *topics) {
+  strlcpy(topicList, topics, sizeof(topicList));
+  topicCount = 0;
+  const char *p = topics;
+  while ((*p != '\0') && (topicCount < HISTORY_TOPICS)) {
+    while ((*p == ',') || (*p == ' ')) p++;
+    bool extra = (strncmp_P(p, PSTR("XTOP"), 4) == 0);
+    if (extra || (strncmp_P(p, PSTR("TOP"), 3) == 0)) {
+      const char *number = p + (extra ? 4 : 3);
+      if (isdigit(*number)) {
+        topicExtra[topicCount] = extra;
+        topicNumber[topicCount] = atoi(number);
+        topicCount++;
+      }
+    }
+    while ((*p != '\0') && (*p != ',')) p++;
+  }
+}
+
+int8_t historyTopic(const char *name) {
+  bool extra = (strncmp_P(name, PSTR("XTOP"), 4) == 0);
+  if (!extra && (strncmp_P(name, PSTR("TOP"), 3) != 0)) {
+    return -1;
+  }
+  const char *number = name + (extra ? 4 : 3);
+  if (!isdigit(*number)) {
+    return -1;
+  }
+  for (uint8_t i = 0; i < topicCount; i++) {
+    if ((topicExtra[i] == extra) && (topicNumber[i] == atoi(number))) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// The 15 minute tier survives a reboot, when the topics stay the same
+static void loadQuarterTier() {
+  File file = LittleFS.open(HISTORY_FILE, "r");
+  if (!file) {
+    return;
+  }
+  byte header[8];
+  char topics[sizeof(topicList)];
+  if ((file.read(header, sizeof(header)) == sizeof(header)) && (memcmp(header, HISTORY_MAGIC, 4) == 0) && (header[4] == HISTORY_VERSION)
+      && (header[5] == blocks) && ((header[6] | (header[7] << 8)) == blockSize)
+      && (file.read((byte *)topics, sizeof(topics)) == sizeof(topics)) && (strncmp(topics, topicList, sizeof(topics)) == 0)) {
+    for (uint8_t topic = 0; topic < topicCount; topic++) {
+      file.read((byte *)getBlock(topic, 2, 0), (sizeof(historyBlockStruct) + blockSize) * blocks);
+      file.read(&head[topic][2], 1);
+      head[topic][2] %= blocks;
+    }
+  }
+  file.close();
+}
+
+// Too large to queue in persist, written directly once the line is idle.
+// Returns false to try again later.
+static bool saveQuarterTier() {
+  if (!persistDirectBegin(false)) {
+    return false;
+  }
+  size_t written = 0;
+  File file = LittleFS.open(HISTORY_FILE, "w");
+  if (file) {
+    byte header[8] = { 'H', 'M', 'H', 'S', HISTORY_VERSION, blocks, (byte)(blockSize & 0xFF), (byte)(blockSize >> 8) };
+    written += file.write(header, sizeof(header));
+    written += file.write((const byte *)topicList, sizeof(topicList));
+    for (uint8_t topic = 0; topic < topicCount; topic++) {
+      written += file.write((const byte *)getBlock(topic, 2, 0), (sizeof(historyBlockStruct) + blockSize) * blocks);
+      written += file.write(&head[topic][2], 1);
+    }
+    file.close();
+  }
+  persistDirectEnd(written);
+  return true;
+}
+
+void historyBegin(const char *topics, bool flush) {
+  parseTopics(topics);
+  historyStats.topics = topicCount;
+  flushEnabled = flush;
+  if ((topicCount == 0) || (store != NULL)) {
+    return;
+  }
+#if defined(ESP32)
+  if (psramFound()) {
+    blocks = HISTORY_BLOCKS_PSRAM;
+    blockSize = HISTORY_BLOCK_SIZE_PSRAM;
+  }
+  historyStats.memory = (unsigned long)topicCount * HISTORY_TIERS * blocks * (sizeof(historyBlockStruct) + blockSize);
+  store = (byte *)(psramFound() ? ps_calloc(historyStats.memory, 1) : calloc(historyStats.memory, 1));
+#else
+  historyStats.memory = (unsigned long)topicCount * HISTORY_TIERS * blocks * (sizeof(historyBlockStruct) + blockSize);
+  store = (byte *)calloc(historyStats.memory, 1);
+#endif
+  if (store == NULL) {
+    historyStats.memory = 0;
+    return;
+  }
+  memset(head, 0, sizeof(head));
+  baseTime = millis() / 1000;
+  lastTick = millis();
+  if (flushEnabled && persistMount()) {
+    loadQuarterTier();
+  }
+}
+
+// Samples the topics every HISTORY_RAW_INTERVAL, getValue returns false if
+// the topic has no fresh value
+void historyLoop(bool (*getValue)(bool extra, uint8_t topic, float *value)) {
+  if (store == NULL) {
+    return;
+  }
+  if (!clockSet && (time(NULL) > (time_t)HISTORY_UNIX_MIN)) {
+    // move the samples taken so far from uptime to the clock
+    uint32_t shift = (uint32_t)time(NULL) - tick * HISTORY_RAW_INTERVAL - baseTime;
+    baseTime += shift;
+    for (uint8_t topic = 0; topic < topicCount; topic++) {
+      for (uint8_t tier = 0; tier < HISTORY_TIERS; tier++) {
+        for (uint8_t i = 0; i < blocks; i++) {
+          struct historyBlockStruct *b = getBlock(topic, tier, i);
+          if ((b->count > 0) && (b->start < HISTORY_UNIX_MIN)) {
+            b->start += shift;
+          }
+        }
+      }
+      minuteStart[topic] += shift;
+      quarterStart[topic] += shift;
+    }
+    clockSet = true;
+  }
+  if ((unsigned long)(millis() - lastTick) < 1000UL * HISTORY_RAW_INTERVAL) {
+    return;
+  }
+  lastTick += 1000UL * HISTORY_RAW_INTERVAL;
+
+  uint32_t now = historyNow();
+  uint8_t minutePhase = tick % HISTORY_MINUTE_SAMPLES;
+  uint8_t quarterPhase = (tick / HISTORY_MINUTE_SAMPLES) % HISTORY_QUARTER_SAMPLES;
+  tick++;
+  for (uint8_t topic = 0; topic < topicCount; topic++) {
+    float value;
+    bool valid = getValue(topicExtra[topic], topicNumber[topic], &value);
+    int32_t scaled = valid ? lroundf(value * HISTORY_SCALE) : 0;
+    if (valid) {
+      append(topic, 0, now, scaled);
+    } else {
+      historyStats.gaps++;
+    }
+
+    if (minutePhase == 0) {
+      minuteStart[topic] = now;
+      minuteSum[topic] = 0;
+      minuteCount[topic] = 0;
+    }
+    if (valid) {
+      minuteSum[topic] += scaled;
+      minuteCount[topic]++;
+    }
+    if (minutePhase < HISTORY_MINUTE_SAMPLES - 1) {
+      continue;
+    }
+    if (quarterPhase == 0) {
+      quarterStart[topic] = minuteStart[topic];
+      quarterSum[topic] = 0;
+      quarterCount[topic] = 0;
+    }
+    if (minuteCount[topic] > 0) {
+      int32_t average = minuteSum[topic] / minuteCount[topic];
+      append(topic, 1, minuteStart[topic], average);
+      quarterSum[topic] += average;
+      quarterCount[topic]++;
+    }
+    if ((quarterPhase == HISTORY_QUARTER_SAMPLES - 1) && (quarterCount[topic] > 0)) {
+      append(topic, 2, quarterStart[topic], quarterSum[topic] / quarterCount[topic]);
+    }
+  }
+
+  if (flushEnabled && clockSet && ((unsigned long)(millis() - lastFlush) >= HISTORY_FLUSH_TIME) && saveQuarterTier()) {
+    lastFlush = millis();
+  }
+}
+
+static uint8_t oldestBlock(int8_t topic, uint8_t tier) {
+  uint8_t oldest = (head[topic][tier] + 1) % blocks;
+  while ((oldest != head[topic][tier]) && (getBlock(topic, tier, oldest)->count == 0)) {
+    oldest = (oldest + 1) % blocks;
+  }
+  return oldest;
+}
+
+// The finest tier which reaches back to from, otherwise the one reaching
+// back furthest
+uint8_t historyTier(int8_t topic, uint32_t from) {
+  uint8_t best = 0;
+  uint32_t bestStart = 0xFFFFFFFF;
+  if ((store == NULL) || (topic < 0) || (topic >= topicCount)) {
+    return 0;
+  }
+  for (uint8_t tier = 0; tier < HISTORY_TIERS; tier++) {
+    struct historyBlockStruct *b = getBlock(topic, tier, oldestBlock(topic, tier));
+    if (b->count == 0) {
+      continue;
+    }
+    if (b->start <= from) {
+      return tier;
+    }
+    if (b->start < bestStart) {
+      bestStart = b->start;
+      best = tier;
+    }
+  }
+  return best;
+}
+
+static void addValue(String &text, int32_t value) {
+  char str[16];
+  uint32_t abs = (value < 0) ? -value : value;
+  if (abs % HISTORY_SCALE == 0) {
+    sprintf_P(str, PSTR("%s%u"), (value < 0) ? "-" : "", (unsigned int)(abs / HISTORY_SCALE));
+  } else {
+    sprintf_P(str, PSTR("%s%u.%02u"), (value < 0) ? "-" : "", (unsigned int)(abs / HISTORY_SCALE), (unsigned int)(abs % HISTORY_SCALE));
+  }
+  text += str;
+}
+
+// The n-th block, oldest first, as {"t":time,"v":[values]} from time from on.
+// Empty if the block has no samples in that range.
+String historyBlock(int8_t topic, uint8_t tier, uint8_t n, uint32_t from) {
+  String text;
+  if ((store == NULL) || (topic < 0) || (topic >= topicCount) || (tier >= HISTORY_TIERS) || (n >= blocks)) {
+    return text;
+  }
+  uint8_t oldest = oldestBlock(topic, tier);
+  if (n > (head[topic][tier] + blocks - oldest) % blocks) {
+    return text; // behind the newest block
+  }
+  struct historyBlockStruct *b = getBlock(topic, tier, (oldest + n) % blocks);
+  uint16_t interval = historyInterval(tier);
+  if ((b->count == 0) || (b->start + (uint32_t)(b->count - 1) * interval < from)) {
+    return text;
+  }
+  text.reserve(16 + b->count * 6);
+  int32_t value = b->first;
+  uint32_t time = b->start;
+  const byte *data = blockData(b);
+  uint16_t pos = 0;
+  bool started = false;
+  for (uint16_t i = 0; i < b->count; i++) {
+    if (i > 0) {
+      uint32_t zigzag = 0;
+      uint8_t shift = 0;
+      while (pos < b->used) {
+        byte c = data[pos++];
+        zigzag |= (uint32_t)(c & 0x7F) << shift;
+        shift += 7;
+        if ((c & 0x80) == 0) {
+          break;
+        }
+      }
+      value += (int32_t)((zigzag >> 1) ^ -(int32_t)(zigzag & 1));
+      time += interval;
+    }
+    if (time < from) {
+      continue;
+    }
+    if (!started) {
+      text += F("{\"t\":");
+      text += time;
+      text += F(",\"v\":[");
+      started = true;
+    } else {
+      text += ',';
+    }
+    addValue(text, value);
+  }
+  text += F("]}");
+  return text;
+}
+
+uint8_t historyBlockCount() {
+  return blocks;
+}
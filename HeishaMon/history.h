@@ -0,0 +1,55 @@
+#ifndef _HISTORY_H_
+#define _HISTORY_H_
+
+#include <Arduino.h>
+
+// Time series of a few topics kept on the device, in three tiers of fixed
+// intervals. A series is a ring of blocks, a block holds the first value
+// and the zigzag varint deltas of the following samples at its interval.
+#define HISTORY_TOPICS 8 // topics at most
+#define HISTORY_TIERS 3
+#define HISTORY_RAW_INTERVAL 10 // s between raw samples
+#define HISTORY_MINUTE_SAMPLES 6 // raw samples averaged in a 1 minute sample
+#define HISTORY_QUARTER_SAMPLES 15 // 1 minute samples averaged in a 15 minute sample
+#define HISTORY_SCALE 100 // values are stored as integer hundredths
+#if defined(ESP8266)
+#define HISTORY_BLOCKS 2 // blocks per series
+#define HISTORY_BLOCK_SIZE 64 // delta bytes per block
+#else
+#define HISTORY_BLOCKS 8
+#define HISTORY_BLOCK_SIZE 128
+#define HISTORY_BLOCKS_PSRAM 32 // with PSRAM
+#define HISTORY_BLOCK_SIZE_PSRAM 256
+#endif
+#define HISTORY_STALE 300000 // ms a data block is sampled after it was read
+#define HISTORY_FLUSH_TIME 14400000 // ms between writes of the 15 minute tier to flash
+#define HISTORY_FILE "/history.bin"
+
+struct historyBlockStruct {
+  uint32_t start = 0; // time of the first sample
+  int32_t first = 0;
+  int32_t last = 0;
+  uint16_t count = 0; // samples, 0 if the block is unused
+  uint16_t used = 0; // delta bytes
+  // followed by the delta bytes
+};
+
+struct historyStatsStruct {
+  uint8_t topics = 0;
+  unsigned long samples = 0;
+  unsigned long gaps = 0; // raw samples without a fresh value
+  unsigned long memory = 0; // bytes of all series
+};
+
+extern historyStatsStruct historyStats;
+
+void historyBegin(const char *topics, bool flush);
+void historyLoop(bool (*getValue)(bool extra, uint8_t topic, float *value));
+int8_t historyTopic(const char *name);
+uint8_t historyTier(int8_t topic, uint32_t from);
+uint16_t historyInterval(uint8_t tier);
+uint32_t historyNow();
+uint8_t historyBlockCount();
+String historyBlock(int8_t topic, uint8_t tier, uint8_t block, uint32_t from);
+
+#endif
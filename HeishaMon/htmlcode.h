@@ -5,618 +5,14 @@
 #endif
 
 // ─────────────────────────────────────────────────────────────────────────────
-// SHARED CSS
+// SHARED CSS AND JS
+// The static stylesheet and scripts live in webui/ and are served gzipped from
+// /static/. webassets.h is generated from them by scripts/build_webui.py and
+// defines webCSS, menuJS, websocketJS, selectJS, refreshJS, consoleTogglesJS,
+// settingsJS, changewifissidJS, populatescanwifiJS and rulesJS as the
+// <link>/<script src> tags that reference them.
 // ─────────────────────────────────────────────────────────────────────────────
-static const char webCSS[] FLASHPROG = R"====(
-<style>
-
-/* ═══════════════════════════════════════════════════════════════════════
-   LIGHT MODE (DEFAULT)
-   ═══════════════════════════════════════════════════════════════════════ */
-:root {
-  --bg-base:#f8f9fa;
-  --bg-surface:#ffffff;
-  --bg-elevated:#f1f3f5;
-  --bg-hover:#e9ecef;
-  --border:#dee2e6;
-  --border-focus:#3a7bd5;
-  --text-primary:#212529;
-  --text-secondary:#495057;
-  --text-muted:#6c757d;
-  --accent:#3a7bd5;
-  --accent-glow:rgba(58,123,213,0.15);
-  --accent-hover:#5a9be8;
-  --red:#dc3545;
-  --red-glow:rgba(220,53,69,0.15);
-  --green:#28a745;
-  --green-glow:rgba(40,167,69,0.15);
-  --orange:#fd7e14;
-  --radius:8px;
-  --radius-sm:5px;
-  --radius-lg:12px;
-}
-
-/* ═══════════════════════════════════════════════════════════════════════
-   DARK MODE
-   ═══════════════════════════════════════════════════════════════════════ */
-html.dark-mode {
-  --bg-base:#0f1117;
-  --bg-surface:#161922;
-  --bg-elevated:#1e2230;
-  --bg-hover:#262b3a;
-  --border:#2a3040;
-  --border-focus:#3a7bd5;
-  --text-primary:#eef0f4;
-  --text-secondary:#7b8597;
-  --text-muted:#7b8597;
-  --accent:#3a7bd5;
-  --accent-glow:rgba(58,123,213,0.25);
-  --accent-hover:#5a9be8;
-  --red:#e74c5e;
-  --red-glow:rgba(231,76,94,0.25);
-  --green:#2ecc94;
-  --green-glow:rgba(46,204,148,0.2);
-  --orange:#f0a500;
-}
-
-/* ═══════════════════════════════════════════════════════════════════════
-   BASE STYLES (remain unchanged)
-   ═══════════════════════════════════════════════════════════════════════ */
-*{box-sizing:border-box;margin:0;padding:0}
-html{font-size:15px;-webkit-text-size-adjust:100%}
-body{
-  font-family:'Sora',sans-serif;
-  background:var(--bg-base);
-  color:var(--text-primary);
-  min-height:100vh;
-  line-height:1.5;
-  transition:background 0.3s, color 0.3s;
-}
-
-.topbar{
-  display:flex;
-  align-items:center;
-  justify-content:space-between;
-  background:var(--bg-surface);
-  border-bottom:1px solid var(--border);
-  padding:0 24px;
-  height:56px;
-  position:sticky;
-  top:0;z-index:100;
-}
-.topbar-left{display:flex;align-items:center;gap:16px}
-.topbar-logo{
-  font-family:'JetBrains Mono',monospace;
-  font-size:18px;font-weight:500;
-  color:var(--accent);
-  letter-spacing:-0.5px;
-  text-decoration:none;
-}
-.topbar-logo span{color:var(--text-secondary);font-weight:400}
-.hamburger{
-  background:none;border:none;
-  color:var(--text-secondary);
-  font-size:20px;cursor:pointer;
-  padding:6px;border-radius:var(--radius-sm);
-  transition:background .2s,color .2s;
-}
-.hamburger:hover{background:var(--bg-elevated);color:var(--text-primary)}
-.sidemenu{
-  position:fixed;top:0;left:-240px;width:240px;height:100%;
-  background:var(--bg-surface);
-  border-right:1px solid var(--border);
-  z-index:200;
-  transition:left .3s cubic-bezier(.4,0,.2,1);
-  display:flex;flex-direction:column;
-  overflow-y:auto;
-}
-.sidemenu.open{left:0}
-.sidemenu-overlay{
-  display:none;position:fixed;inset:0;
-  background:rgba(0,0,0,.45);z-index:199;
-}
-.sidemenu-overlay.open{display:block}
-.sidemenu-header{
-  padding:24px 20px 16px;
-  border-bottom:1px solid var(--border);
-}
-.sidemenu-header h2{
-  font-family:'JetBrains Mono',monospace;
-  font-size:15px;color:var(--accent);font-weight:500;
-}
-.sidemenu-header p{font-size:11px;color:var(--text-muted);margin-top:2px}
-.sidemenu-nav{padding:8px 12px;flex:1}
-.sidemenu-nav a{
-  display:flex;align-items:center;gap:10px;
-  padding:10px 12px;
-  color:var(--text-secondary);
-  text-decoration:none;border-radius:var(--radius);
-  font-size:13px;font-weight:400;
-  transition:background .18s,color .18s;
-  margin-bottom:2px;
-}
-.sidemenu-nav a:hover{background:var(--bg-elevated);color:var(--text-primary)}
-.sidemenu-nav a.danger{color:var(--red)}
-.sidemenu-nav a.danger:hover{background:var(--red-glow)}
-.sidemenu-nav .nav-icon{width:16px;text-align:center;opacity:.7}
-.sidemenu-footer{
-  padding:16px 20px;
-  border-top:1px solid var(--border);
-  font-size:11px;color:var(--text-muted);
-}
-.sidemenu-footer a{color:var(--accent);text-decoration:none}
-.sidemenu-footer a:hover{text-decoration:underline}
-.tabnav{
-  display:flex;gap:4px;
-  padding:12px 24px 0;
-  background:var(--bg-base);
-  flex-wrap:wrap;
-}
-.tabnav button{
-  background:none;border:none;
-  color:var(--text-muted);
-  font-family:'Sora',sans-serif;
-  font-size:14px;font-weight:500;
-  padding:10px 20px;
-  border-radius:var(--radius-sm) var(--radius-sm) 0 0;
-  cursor:pointer;
-  transition:color .2s,background .2s;
-  letter-spacing:.3px;text-transform:uppercase;
-  position:relative;
-}
-.tabnav button::after{
-  content:'';position:absolute;
-  bottom:0;left:16px;right:16px;height:2px;
-  background:transparent;
-  border-radius:1px;
-  transition:background .25s;
-}
-.tabnav button:hover{color:var(--text-secondary);background:var(--bg-elevated)}
-.tabnav button.active{color:var(--accent)}
-.tabnav button.active::after{background:var(--accent)}
-.main-content{padding:20px 24px 40px}
-.statusbar{
-  display:flex;flex-wrap:wrap;gap:12px;
-  margin-bottom:20px;
-}
-.status-chip{
-  display:flex;align-items:center;gap:8px;
-  background:var(--bg-surface);
-  border:1px solid var(--border);
-  border-radius:20px;
-  padding:6px 14px;
-  font-size:12px;color:var(--text-secondary);
-}
-.status-chip .chip-label{color:var(--text-muted);font-size:10.5px;text-transform:uppercase;letter-spacing:.5px}
-.status-chip .chip-value{color:var(--text-primary);font-family:'JetBrains Mono',monospace;font-size:12px;font-weight:500}
-.status-chip.listen-only{border-color:var(--orange);background:rgba(240,165,0,.08)}
-.status-chip.listen-only .chip-value{color:var(--orange)}
-.status-chip.rules-active {background:linear-gradient(135deg,rgba(33,150,243,0.08),rgba(33,150,243,0.12));border-color:rgba(33,150,243,0.2);}
-.status-chip.rules-active .chip-value {color:#2196F3;font-weight:600;}
-.status-chip.rules-inactive {background:linear-gradient(135deg,rgba(158,158,158,0.05),rgba(158,158,158,0.08));border-color:rgba(158,158,158,0.15);}
-.status-chip.rules-inactive .chip-value {color:#9e9e9e;font-weight:500;}
-.status-dot{width:8px;height:8px;border-radius:50%;margin-right:8px;transition:background 0.3s;}
-.status-dot.excellent{background:#2ecc94;}
-.status-dot.good{background:#3a7bd5;}
-.status-dot.fair{background:#f0a500;}
-.status-dot.poor{background:#e74c5e;}
-.status-dot.disconnected{background:#6b7280;}
-.panel{
-  background:var(--bg-surface);
-  border:1px solid var(--border);
-  border-radius:var(--radius-lg);
-  overflow:hidden;
-}
-.panel-header{
-  padding:14px 20px;
-  border-bottom:1px solid var(--border);
-  display:flex;align-items:center;justify-content:space-between;
-}
-.panel-header h3{font-size:13px;font-weight:500;color:var(--text-primary);letter-spacing:.2px}
-.panel-header .panel-meta{font-size:11px;color:var(--text-muted)}
-table{
-  width:100%;border-collapse:collapse;
-  font-size:12.5px;
-}
-thead th{
-  text-align:left;
-  padding:10px 16px;
-  color:var(--text-muted);
-  font-size:10.5px;font-weight:600;
-  text-transform:uppercase;letter-spacing:.7px;
-  background:var(--bg-base);
-  border-bottom:1px solid var(--border);
-  position:sticky;top:56px;
-}
-tbody tr{
-  border-bottom:1px solid rgba(42,48,64,.5);
-  transition:background .15s;
-}
-tbody tr:hover{background:var(--bg-elevated)}
-tbody tr:last-child{border-bottom:none}
-tbody td{
-  padding:9px 16px;
-  color:var(--text-secondary);
-}
-tbody td:first-child{color:var(--text-primary);font-family:'JetBrains Mono',monospace;font-size:11.5px}
-.update-effect{
-  animation:flash-update 1.2s ease-out;
-}
-@keyframes flash-update {
-  0% {color: var(--accent);text-shadow: 0 0 10px var(--accent-glow), 0 0 24px var(--accent-glow);transform: scale(1.08);}
-  50% {transform: scale(1);}:
-  100% {color: var(--text-secondary);text-shadow: none;}
-}
-#cli{
-  width:100%;
-  background:#0a0c0f;
-  color:#6ee7b7;
-  border:1px solid var(--border);
-  border-radius:var(--radius);
-  padding:14px 16px;
-  font-family:'JetBrains Mono',monospace;
-  font-size:11.5px;
-  resize:none;  /* Changed from vertical to none since we're auto-sizing */
-  outline:none;
-  line-height:1.6;
-}
-
-#cli:focus{border-color:var(--border-focus);box-shadow:0 0 0 3px var(--accent-glow)}
-
-.console-toggle-compact {
-  display:flex;
-  align-items:center;
-  gap:6px;
-}
-.console-toggle-label-compact {
-  font-size:11px;
-  color:var(--text-muted);
-  font-weight:400;
-  text-transform:uppercase;
-  letter-spacing:0.3px;
-}
-.theme-switch-compact {
-  position:relative;
-  width:32px;
-  height:18px;
-}
-.theme-switch-compact input {
-  opacity:0;
-  width:0;
-  height:0;
-}
-.theme-slider-compact {
-  position:absolute;
-  cursor:pointer;
-  top:0;
-  left:0;
-  right:0;
-  bottom:0;
-  background:var(--border);
-  transition:0.3s;
-  border-radius:18px;
-}
-.theme-slider-compact:before {
-  position:absolute;
-  content:"";
-  height:14px;
-  width:14px;
-  left:2px;
-  bottom:2px;
-  background:white;
-  transition:0.3s;
-  border-radius:50%;
-}
-input:checked + .theme-slider-compact {
-  background:var(--accent);
-}
-input:checked + .theme-slider-compact:before {
-  transform:translateX(14px);
-}
-input:disabled + .theme-slider-compact {
-  opacity:0.4;
-  cursor:not-allowed;
-}
-
-.alias-edit{
-  outline:none;
-  border:1px solid transparent;
-  border-radius:var(--radius-sm);
-  padding:3px 6px;
-  min-width:80px;
-  font-size:12.5px;
-  color:var(--text-secondary);
-  background:transparent;
-  transition:border-color .2s,background .2s;
-}
-.alias-edit:hover,.alias-edit:focus{
-  border-color:var(--border);
-  background:var(--bg-elevated);
-}
-.alias-edit:focus{border-color:var(--border-focus);box-shadow:0 0 0 2px var(--accent-glow)}
-.tab-pane{display:none}
-.tab-pane.active{display:block}
-.settings-grid{
-  display:grid;
-  gap:0;
-}
-.setting-row{
-  display:grid;
-  grid-template-columns:280px 1fr;
-  align-items:center;
-  padding:12px 20px;
-  border-bottom:1px solid rgba(42,48,64,.4);
-  gap:16px;
-}
-@media(max-width:480px){
-  .setting-row{grid-template-columns:1fr}
-  .setting-label{text-align:left}
-}
-.setting-row:last-child{border-bottom:none}
-.setting-row:hover{background:rgba(30,34,48,.4)}
-.setting-label{
-  font-size:12.5px;
-  color:var(--text-secondary);
-  text-align:right;
-  font-weight:400;
-}
-.setting-input{
-  background:var(--bg-base);
-  border:1px solid var(--border);
-  color:var(--text-primary);
-  font-family:'Sora',sans-serif;
-  font-size:12.5px;
-  padding:7px 10px;
-  border-radius:var(--radius-sm);
-  outline:none;
-  transition:border-color .2s,box-shadow .2s;
-  width:100%;max-width:320px;
-}
-.setting-input:focus{border-color:var(--border-focus);box-shadow:0 0 0 3px var(--accent-glow)}
-.setting-input[type=password]{letter-spacing:2px}
-select.setting-input{appearance:auto}
-.setting-hint{font-size:11px;color:var(--text-muted);margin-left:8px}
-.setting-row .checkbox-wrap{display:flex;align-items:center;gap:8px}
-.checkbox-wrap input[type=checkbox]{width:17px;height:17px;accent-color:var(--accent);cursor:pointer}
-.radio-group{display:flex;gap:16px;flex-wrap:wrap}
-.radio-group label{display:flex;align-items:center;gap:6px;font-size:12px;color:var(--text-secondary);cursor:pointer}
-.radio-group input[type=radio]{accent-color:var(--accent)}
-.section-divider{
-  padding:10px 20px 4px;
-  font-size:10.5px;font-weight:600;
-  color:var(--text-muted);
-  text-transform:uppercase;letter-spacing:.8px;
-  background:var(--bg-base);
-}
-.btn{
-  display:inline-flex;align-items:center;justify-content:center;
-  padding:8px 20px;
-  border-radius:var(--radius-sm);
-  font-family:'Sora',sans-serif;
-  font-size:12.5px;font-weight:500;
-  cursor:pointer;border:none;
-  transition:background .2s,box-shadow .2s,transform .1s;
-  text-decoration:none;
-  letter-spacing:.3px;
-}
-.btn:active{transform:scale(.97)}
-.btn-primary{background:var(--accent);color:#fff}
-.btn-primary:hover{background:var(--accent-hover);box-shadow:0 4px 14px var(--accent-glow)}
-.btn-danger{background:var(--red);color:#fff}
-.btn-danger:hover{background:#d63a4d;box-shadow:0 4px 14px var(--red-glow)}
-.btn-ghost{
-  background:transparent;
-  color:var(--text-secondary);
-  border:1px solid var(--border);
-}
-.btn-ghost:hover{background:var(--bg-elevated);color:var(--text-primary)}
-.btn:disabled{opacity:.4;cursor:not-allowed;transform:none}
-.form-actions{padding:20px;display:flex;gap:12px;align-items:center}
-.loading-overlay{
-  display:flex;align-items:center;justify-content:center;
-  padding:60px 20px;
-  color:var(--text-muted);
-  font-size:13px;
-}
-.spinner{
-  width:20px;height:20px;
-  border:2px solid var(--border);
-  border-top-color:var(--accent);
-  border-radius:50%;
-  animation:spin .7s linear infinite;
-  margin-right:10px;
-}
-@keyframes spin{to{transform:rotate(360deg)}}
-.firmware-container{max-width:620px;margin:0 auto;padding:40px 24px}
-.firmware-warning{
-  background:rgba(231,76,94,.08);
-  border:1px solid rgba(231,76,94,.25);
-  border-radius:var(--radius);
-  padding:14px 18px;
-  font-size:12px;
-  color:var(--red);
-  margin-top:20px;line-height:1.6;
-}
-.firmware-warning strong{color:var(--text-primary)}
-.firmware-info{
-  background:rgba(58,123,213,.08);
-  border:1px solid rgba(58,123,213,.25);
-  border-radius:var(--radius);
-  padding:16px 20px;
-  font-size:12.5px;
-  color:var(--text-secondary);
-  margin-bottom:20px;line-height:1.8;
-}
-.firmware-info strong{color:var(--text-primary)}
-.firmware-info a{color:var(--accent)}
-progress{
-  width:100%;height:6px;
-  appearance:none;
-  border-radius:3px;
-  background:var(--bg-elevated);
-  margin-top:12px;
-  overflow:hidden;
-}
-progress::-webkit-progress-bar{background:var(--bg-elevated);border-radius:3px}
-progress::-webkit-progress-value{background:var(--accent);border-radius:3px;transition:width .2s}
-#status{font-size:12px;color:var(--text-muted);margin-top:8px;min-height:18px}
-.file-input-wrap{position:relative;margin-top:12px}
-.file-input-wrap input[type=file]{
-  font-size:12px;color:var(--text-secondary);
-  font-family:'Sora',sans-serif;
-}
-.rules-editor{background:#0f1117;color:#e4e7eb;padding:12px;border:1px solid #2d3748;border-radius:6px;font-family:'JetBrains Mono',monospace;font-size:14px;line-height:1.5;min-height:400px;white-space:pre;overflow:auto;}
-.rules-editor:focus{outline:none;border-color:#3a7bd5;}
-.keyword{color:#c792ea;}
-.operator{color:#89ddff;}
-.number{color:#f78c6c;}
-.string{color:#c3e88d;}
-.comment{color:#546e7a;font-style:italic;}
-.variable{color:#82aaff;}
-.function{color:#ffcb6b;}
-.at-param{color:#f07178;}
-.percent-param{color:#c3e88d;}
-.question-param{color:#89ddff;}
-.ds18b20{color:#ff5370;}
-.rules-error{border:2px solid #e74c5e!important;box-shadow:0 0 0 3px rgba(231,76,94,0.2)!important;}
-.rules-valid{border:2px solid #2ecc94!important;box-shadow:0 0 0 3px rgba(46,204,148,0.2)!important;}
-.validation-feedback{margin-top:8px;padding:10px 14px;border-radius:6px;font-size:13px;line-height:1.4;}
-.validation-feedback.error{background:rgba(231,76,94,0.1);border:1px solid #e74c5e;color:#ff9999;}
-.validation-feedback.success{background:rgba(46,204,148,0.1);border:1px solid #2ecc94;color:#6ee7b7;}
-.validation-feedback.warning{background:rgba(240,165,0,0.1);border:1px solid #f0a500;color:#ffd54f;}
-.line-numbers{background:#0a0c10;color:#4a5568;padding:12px 8px;border:1px solid #2d3748;border-right:none;border-radius:6px 0 0 6px;font-family:'JetBrains Mono',monospace;font-size:14px;line-height:1.5;text-align:right;user-select:none;min-width:40px;white-space:pre;}
-.rules-editor{flex:1;background:#0f1117;color:#e4e7eb;padding:12px;border:1px solid #2d3748;border-radius:0 6px 6px 0;font-family:'JetBrains Mono',monospace;font-size:14px;line-height:1.5;min-height:400px;white-space:pre;overflow:auto;}
-.msg-box{
-  max-width:520px;margin:80px auto;text-align:center;
-  padding:48px 32px;
-  background:var(--bg-surface);
-  border:1px solid var(--border);
-  border-radius:var(--radius-lg);
-}
-.msg-box h2{font-size:18px;color:var(--text-primary);margin-bottom:10px;font-weight:500}
-.msg-box p{font-size:13px;color:var(--text-muted);line-height:1.7}
-.msg-box.warning h2{color:var(--orange)}
-.msg-box.danger h2{color:var(--red)}
-.msg-box.success h2{color:var(--green)}
-@media(max-width:600px){
-  .setting-row{grid-template-columns:1fr;gap:4px}
-  .setting-label{text-align:left}
-  .tabnav{padding:10px 12px 0;gap:2px}
-  .tabnav button{padding:9px 14px;font-size:13px}
-  .main-content{padding:16px 12px 32px}
-  .topbar{padding:0 12px}
-  thead th,tbody td{padding:8px 10px;font-size:11.5px}
-  .panel-header {
-    flex-direction:column;
-    align-items:flex-start;
-    gap:8px;
-  }
-  .panel-header > div {
-    flex-wrap:wrap;
-  }  
-}
-select#wifi_ssid_select{
-  display:none;
-  background:var(--bg-base);
-  border:1px solid var(--border);
-  color:var(--text-primary);
-  font-family:'Sora',sans-serif;
-  font-size:12px;
-  padding:7px 10px;
-  border-radius:var(--radius-sm);
-  max-width:320px;width:100%;
-}
-
-/* ═══════════════════════════════════════════════════════════════════════
-   DARK MODE TOGGLE SWITCH
-   ═══════════════════════════════════════════════════════════════════════ */
-.theme-toggle {
-  display:flex;
-  align-items:center;
-  justify-content:space-between;
-  padding:12px 12px;
-  margin:8px 12px;
-  background:var(--bg-elevated);
-  border-radius:var(--radius);
-  border:1px solid var(--border);
-}
-.theme-toggle-label {
-  font-size:13px;
-  color:var(--text-secondary);
-  font-weight:400;
-  display:flex;
-  align-items:center;
-  gap:8px;
-}
-.theme-toggle-label .nav-icon {
-  width:16px;
-  text-align:center;
-  opacity:0.7;
-}
-.theme-switch {
-  position:relative;
-  width:44px;
-  height:24px;
-}
-.theme-switch input {
-  opacity:0;
-  width:0;
-  height:0;
-}
-.theme-slider {
-  position:absolute;
-  cursor:pointer;
-  top:0;
-  left:0;
-  right:0;
-  bottom:0;
-  background:var(--border);
-  transition:0.3s;
-  border-radius:24px;
-}
-.theme-slider:before {
-  position:absolute;
-  content:"";
-  height:18px;
-  width:18px;
-  left:3px;
-  bottom:3px;
-  background:white;
-  transition:0.3s;
-  border-radius:50%;
-}
-input:checked + .theme-slider {
-  background:var(--accent);
-}
-input:checked + .theme-slider:before {
-  transform:translateX(20px);
-}
-
-
-
-/* ═══════════════════════════════════════════════════════════════════════
-   DARK MODE SPECIFIC OVERRIDES
-   ═══════════════════════════════════════════════════════════════════════ */
-html.dark-mode #cli {
-  background:#0a0c0f;
-  color:#6ee7b7;
-}
-
-html.dark-mode .rules-editor {
-  background:#0f1117;
-  color:#e4e7eb;
-  border-color:#2d3748;
-}
-
-html.dark-mode .line-numbers {
-  background:#0a0c10;
-  color:#4a5568;
-  border-color:#2d3748;
-}
-
-</style>
-)====";
-
+#include "webassets.h"
 
 // ─────────────────────────────────────────────────────────────────────────────
 // HTML HEAD
@@ -744,483 +140,6 @@ static const char webBodyStart[] FLASHPROG = R"====(
 
 static const char webFooter[] FLASHPROG = "</body></html>";
 
-// ─────────────────────────────────────────────────────────────────────────────
-// MENU & WEBSOCKET JS (shared across pages)
-// ─────────────────────────────────────────────────────────────────────────────
-static const char menuJS[] FLASHPROG = R"====(
-<script>
-function toggleMenu(){
-  var m=document.getElementById('sideMenu');
-  var o=document.getElementById('menuOverlay');
-  m.classList.toggle('open');
-  o.classList.toggle('open');
-}
-function closeMenu(){
-  document.getElementById('sideMenu').classList.remove('open');
-  document.getElementById('menuOverlay').classList.remove('open');
-}
-
-function setCookie(name, value, days) {
-  var expires = "";
-  if (days) {
-    var date = new Date();
-    date.setTime(date.getTime() + (days * 24 * 60 * 60 * 1000));
-    expires = "; expires=" + date.toUTCString();
-  }
-  document.cookie = name + "=" + (value || "") + expires + "; path=/";
-}
-
-function getCookie(name) {
-  var nameEQ = name + "=";
-  var ca = document.cookie.split(';');
-  for(var i = 0; i < ca.length; i++) {
-    var c = ca[i];
-    while (c.charAt(0) == ' ') c = c.substring(1, c.length);
-    if (c.indexOf(nameEQ) == 0) return c.substring(nameEQ.length, c.length);
-  }
-  return null;
-}
-
-function toggleDarkMode() {
-  var toggle = document.getElementById('darkModeToggle');
-  var html = document.documentElement;
-  
-  if (toggle.checked) {
-    html.classList.add('dark-mode');
-    setCookie('darkMode', 'true', 365);
-  } else {
-    html.classList.remove('dark-mode');
-    setCookie('darkMode', 'false', 365);
-  }
-}
-
-function initDarkMode() {
-  var darkMode = getCookie('darkMode');
-  var toggle = document.getElementById('darkModeToggle');
-  var html = document.documentElement;
-  
-  // Remove the temporary loading class
-  html.classList.remove('dark-mode-loading');
-  
-  // Apply proper dark mode
-  if (darkMode === 'true') {
-    html.classList.add('dark-mode');
-    if (toggle) toggle.checked = true;
-  } else {
-    html.classList.remove('dark-mode');
-    if (toggle) toggle.checked = false;
-  }
-}
-
-// Initialize immediately when DOM is ready
-if (document.readyState === 'loading') {
-  document.addEventListener('DOMContentLoaded', initDarkMode);
-} else {
-  initDarkMode();
-}
-</script>
-)====";
-
-static const char websocketJS[] FLASHPROG = R"====(
-<script>
-var bConnected=false;
-var inactivityTimeout=5000;
-var lastActivityTime=Date.now();
-function monitorWebSocket(){
-  setInterval(function(){
-    if(Date.now()-lastActivityTime>inactivityTimeout&&oWebsocket.readyState===WebSocket.OPEN){
-      console.log('Inactivity detected, reconnecting...');
-      oWebsocket.close();
-    }
-  },inactivityTimeout);
-}
-function attemptReconnect(){
-  if(!bConnected){console.log('Reconnecting...');startWebsockets();}
-}
-function startWebsockets(){
-  if(typeof MozWebSocket!='undefined'){
-    oWebsocket=new MozWebSocket('ws://'+location.host);
-  } else if(typeof WebSocket!='undefined'){
-    oWebsocket=new WebSocket('ws://'+location.host+'/ws');
-  }
-  if(oWebsocket){
-    oWebsocket.onopen=function(){bConnected=true;};
-    oWebsocket.onclose=function(){bConnected=false;attemptReconnect();};
-    oWebsocket.onerror=function(e){console.log('WS error:',e);};
-    oWebsocket.onmessage=function(evt){
-      lastActivityTime=Date.now();
-      if(evt.data.startsWith('{')){
-        var j=JSON.parse(evt.data);
-        if(j.logMsg!=null){
-          var obj=document.getElementById('cli');
-          if(!obj)return;
-          var chk=document.getElementById('autoscroll');
-          obj.value+=j.logMsg+'\n';
-          if(chk&&chk.checked)obj.scrollTop=obj.scrollHeight;
-        } else if(j.data){
-          if(j.data.stats){
-            updStat('wifi',j.data.stats.wifi);
-            updStat('ethernet',j.data.stats.ethernet);
-            updStat('memory',j.data.stats.memory);
-            updStat('correct',j.data.stats.correct);
-            updStat('mqtt',j.data.stats.mqtt);
-            updStat('uptime',j.data.stats.uptime);
-            updStat('rules',j.data.stats.rules);
-          } else if(j.data.heishavalues){
-            updCell(j.data.heishavalues.topic+'-Value',j.data.heishavalues.value);
-            updCell(j.data.heishavalues.topic+'-Description',j.data.heishavalues.description);
-          } else if(j.data.dallasvalues){
-            var dID=j.data.dallasvalues.sensorID;
-            if(j.data.dallasvalues.value!==undefined)updCell('SensorID-'+dID+'-Temperature',j.data.dallasvalues.value);
-            if(j.data.dallasvalues.present!==undefined)updDallasPresence(dID,j.data.dallasvalues.present);
-          } else if(j.data.s0values){
-            updCell('s0port-'+j.data.s0values.s0port+'-Watt',j.data.s0values.Watt);
-            updCell('s0port-'+j.data.s0values.s0port+'-Watthour',j.data.s0values.Watthour);
-            updCell('s0port-'+j.data.s0values.s0port+'-WatthourTotal',j.data.s0values.WatthourTotal);
-          } else if(j.data.opentherm){
-            updCell(j.data.opentherm.name+'-value',j.data.opentherm.value);
-          } else if(j.data.dallasRescan){
-            refreshDallasTable();
-          }
-        }
-      } else {
-        var obj=document.getElementById('cli');
-        if(!obj)return;
-        var chk=document.getElementById('autoscroll');
-        obj.value+=evt.data+'\n';
-        if(chk&&chk.checked)obj.scrollTop=obj.scrollHeight;
-      }
-    };
-  }
-}
-function updStat(id,val){
-  var el=document.getElementById(id);
-  if(el){
-    // Special handling for WiFi disconnected state
-    if(id === 'wifi' && (val === -1 || val === '-1' || parseInt(val) < 0)){
-      el.textContent = 'not connected';
-      // Remove the % symbol that follows
-      var percentSpan = el.nextElementSibling;
-      if(percentSpan && percentSpan.textContent === '%'){
-        percentSpan.style.display = 'none';
-      }
-    } else {
-      el.textContent = val != null ? val : '';
-      // Show % symbol again if it was hidden
-      var percentSpan = el.nextElementSibling;
-      if(percentSpan && percentSpan.textContent === '%'){
-        percentSpan.style.display = '';
-      }
-    }
-  }
-  
-  if ((el) && (id == 'wifi') && (val!==undefined)){
-    var w=parseInt(val);
-    var label=el.previousElementSibling;
-    var dot=label.previousElementSibling;
-    if(dot&&dot.classList.contains('status-dot')){
-      dot.className='status-dot';
-      if(w===-1||w<0)dot.classList.add('disconnected');
-      else if(w>=75)dot.classList.add('excellent');
-      else if(w>=50)dot.classList.add('good');
-      else if(w>=25)dot.classList.add('fair');
-      else dot.classList.add('poor');
-    }
-  }
-
-  if (id === 'rules') {
-    var chip = document.getElementById('rulesChip');
-    if (chip) {
-      var count = parseInt(val);
-      var valueEl = chip.querySelector('.chip-value');
-      if (count > 0) {
-        chip.className = 'status-chip rules-active';
-        valueEl.textContent = 'ACTIVE';
-      } else {
-        chip.className = 'status-chip rules-inactive';
-        valueEl.textContent = 'INACTIVE';
-      }
-    }
-    return;
-  }
-}
-
-function updCell(id,val){
-  var el=document.getElementById(id);
-  if(el&&el.textContent!==val){
-    el.classList.remove('update-effect');
-    void el.offsetWidth;
-    el.textContent=val;
-    el.classList.add('update-effect');
-  }
-}
-
-function updDallasPresence(sID,present){
-  var statusCell=document.getElementById('SensorID-'+sID+'-Status');
-  if(!statusCell)return;
-  var row=statusCell.parentElement;
-  if(row)row.style.opacity=present?'':'0.6';
-  statusCell.style.color=present?'':'var(--danger,#f44336)';
-  if(present){
-    delete statusCell.dataset.offlineSince;
-    statusCell.classList.remove('offline-duration');
-    statusCell.textContent='OK';
-  } else {
-    statusCell.dataset.offlineSince=Date.now();
-    statusCell.classList.add('offline-duration');
-    statusCell.textContent=formatOfflineDuration(false,0);
-  }
-}
-
-function formatOfflineDuration(present,lastSeenSeconds){
-  if(present)return'OK';
-  if(lastSeenSeconds==null||lastSeenSeconds<0)return'Offline (never seen)';
-  var s=lastSeenSeconds;
-  if(s<60)return'Offline for '+s+'s';
-  if(s<3600)return'Offline for '+Math.floor(s/60)+'m';
-  if(s<86400)return'Offline for '+Math.floor(s/3600)+'h';
-  return'Offline for '+Math.floor(s/86400)+'d';
-}
-
-setInterval(function(){
-  document.querySelectorAll('.offline-duration[data-offline-since]').forEach(function(cell){
-    var seconds=Math.floor((Date.now()-cell.dataset.offlineSince)/1000);
-    cell.textContent=formatOfflineDuration(false,seconds);
-  });
-},15000);
-</script>
-)====";
-
-// ─────────────────────────────────────────────────────────────────────────────
-// ROOT PAGE: tab switching + data refresh JS
-// ─────────────────────────────────────────────────────────────────────────────
-static const char selectJS[] FLASHPROG = R"====(
-<script>
-function openTable(name){
-  var panes=document.getElementsByClassName('tab-pane');
-  for(var i=0;i<panes.length;i++)panes[i].classList.remove('active');
-  var target=document.getElementById(name);
-  if(target)target.classList.add('active');
-  var tabs=document.querySelectorAll('.tabnav button');
-  tabs.forEach(function(b){b.classList.toggle('active',b.dataset.tab===name);});
-}
-</script>
-)====";
-
-static const char refreshJS[] FLASHPROG = R"====(
-<script>
-var isEditing=false;
-document.body.onload=function(){
-  openTable('Heatpump');
-  document.getElementById('cli').value='';
-  startWebsockets();
-  monitorWebSocket();
-  refreshTable();
-};
-var dallasAliasEdit=function(){
-  isEditing=false;
-  var addr=this.getAttribute('data-address');
-  var alias=this.innerText.substring(0,30);
-  var xhr=new XMLHttpRequest();
-  xhr.open('GET','/dallasalias?'+addr+'='+alias,true);
-  xhr.send();
-};
-function rescanDallas(){
-  var xhr=new XMLHttpRequest();
-  xhr.open('GET','/scandallas',true);
-  xhr.onload=function(){refreshTable();};
-  xhr.send();
-}
-function removeDallas(addr){
-  if(!confirm('Remove sensor '+addr+'? This also clears its retained mqtt value.'))return;
-  var xhr=new XMLHttpRequest();
-  xhr.open('GET','/removedallas?'+addr+'=1',true);
-  xhr.onload=function(){refreshTable();};
-  xhr.send();
-}
-function renderDallasTable(d){
-  if(!(d&&d['1wire']&&Array.isArray(d['1wire'])))return;
-  var tb=document.getElementById('dallasvalues');tb.innerHTML='';
-  d['1wire'].forEach(function(item){
-    var row=document.createElement('tr');
-    var sID=item['Sensor'];
-    if(!item.Present)row.style.opacity='0.6';
-    ['Sensor','Temperature','Alias'].forEach(function(k){
-      var cell=document.createElement('td');
-      cell.id='SensorID-'+sID+'-'+k;
-      if(k==='Alias'){
-        var div=document.createElement('div');
-        div.textContent=item[k];
-        div.classList.add('alias-edit');
-        div.contentEditable='true';
-        div.setAttribute('data-address',item.Sensor);
-        div.addEventListener('focus',function(){isEditing=true;});
-        div.addEventListener('blur',dallasAliasEdit);
-        cell.appendChild(div);
-      } else {cell.textContent=item[k];}
-      row.appendChild(cell);
-    });
-    var statusCell=document.createElement('td');
-    statusCell.id='SensorID-'+sID+'-Status';
-    if(!item.Present){
-      statusCell.style.color='var(--danger,#f44336)';
-      statusCell.classList.add('offline-duration');
-      if(item.LastSeenSeconds>=0)statusCell.dataset.offlineSince=Date.now()-item.LastSeenSeconds*1000;
-    }
-    statusCell.textContent=formatOfflineDuration(item.Present,item.LastSeenSeconds);
-    row.appendChild(statusCell);
-    var actionCell=document.createElement('td');
-    var removeBtn=document.createElement('button');
-    removeBtn.textContent='Remove';
-    removeBtn.className='btn btn-ghost';
-    removeBtn.style.cssText='padding:2px 8px;font-size:11px;height:22px;';
-    removeBtn.onclick=function(){removeDallas(sID);};
-    actionCell.appendChild(removeBtn);
-    row.appendChild(actionCell);
-    tb.appendChild(row);
-  });
-}
-async function refreshDallasTable(){
-  try{
-    if(isEditing)return;
-    var res=await fetch('/json');
-    var d=await res.json();
-    renderDallasTable(d);
-  }catch(e){}
-}
-async function refreshTable(){
-  try{
-    if(isEditing)return;
-    var res=await fetch('/json');
-    var d=await res.json();
-    if(d&&d.heatpump&&Array.isArray(d.heatpump)){
-      var tb=document.getElementById('heishavalues');tb.innerHTML='';
-      d.heatpump.forEach(function(item){tb.appendChild(buildRow(item,'Topic'));});
-    }
-    if(d&&d['heatpump extra']&&Array.isArray(d['heatpump extra'])){
-      var tb=document.getElementById('heishavalues');
-      d['heatpump extra'].forEach(function(item){tb.appendChild(buildRow(item,'Topic'));});
-    }
-    if(d&&d['heatpump optional']&&Array.isArray(d['heatpump optional'])){
-      var tb=document.getElementById('heishavalues');
-      d['heatpump optional'].forEach(function(item){tb.appendChild(buildRow(item,'Topic'));});
-    }
-    renderDallasTable(d);
-    if(d&&d.s0&&Array.isArray(d.s0)){
-      var tb=document.getElementById('s0values');tb.innerHTML='';
-      d.s0.forEach(function(item){
-        var row=document.createElement('tr');
-        var port=item['S0 port'];
-        for(var k in item){if(Object.hasOwn(item,k)){
-          var cell=document.createElement('td');
-          cell.id='s0port-'+port+'-'+k;
-          cell.textContent=item[k];
-          row.appendChild(cell);
-        }}
-        tb.appendChild(row);
-      });
-    }
-    if(d&&d.opentherm&&typeof d.opentherm==='object'){
-      var tb=document.getElementById('openthermvalues');tb.innerHTML='';
-      for(var key in d.opentherm){if(Object.hasOwn(d.opentherm,key)){
-        var row=document.createElement('tr');
-        var nc=document.createElement('td');nc.id=key;nc.textContent=key;
-        var tc=document.createElement('td');tc.id=key+'-type';tc.textContent=d.opentherm[key].type;
-        var vc=document.createElement('td');vc.id=key+'-value';vc.textContent=d.opentherm[key].value;
-        row.appendChild(nc);row.appendChild(tc);row.appendChild(vc);
-        tb.appendChild(row);
-      }}
-    }
-  } catch(e){console.error(e);}
-}
-function buildRow(item,idKey){
-  var row=document.createElement('tr');
-  var topic=item[idKey];
-  for(var k in item){if(Object.hasOwn(item,k)){
-    var cell=document.createElement('td');
-    cell.id=topic+'-'+k;
-    cell.textContent=item[k];
-    row.appendChild(cell);
-  }}
-  return row;
-}
-</script>
-)====";
-
-static const char consoleTogglesJS[] FLASHPROG = R"====(
-<script>
-// Refresh both console toggles from the live device state.
-// The device's runtime flags are the source of truth: they reset on reboot to
-// the "from start" settings and are flipped by /togglelog and /togglehexdump.
-// Reading /getsettings after every change keeps the switches in sync with the
-// device instead of with a (possibly stale) browser-side cache.
-function refreshConsoleToggles() {
-  return fetch('/getsettings')
-    .then(function(response) { return response.json(); })
-    .then(function(data) {
-      var mqttEnabled = (data.logMqtt === 'enabled' || data.logMqtt === 1);
-      var hexdumpEnabled = (data.logHexdump === 'enabled' || data.logHexdump === 1);
-      document.getElementById('mqttLogToggle').checked = mqttEnabled;
-      document.getElementById('hexdumpToggle').checked = hexdumpEnabled;
-    })
-    .catch(function(err) {
-      console.error('Failed to fetch settings:', err);
-    });
-}
-
-function initConsoleToggles() {
-  refreshConsoleToggles();
-}
-
-// Toggle MQTT log, then re-read the device state so the switch reflects the
-// actual resulting position (the endpoint flips the flag server-side).
-function toggleMqttLog() {
-  fetch('/togglelog')
-    .then(function() { refreshConsoleToggles(); })
-    .catch(function(err) {
-      console.error('Error toggling MQTT log:', err);
-      refreshConsoleToggles();
-    });
-}
-
-// Toggle Hexdump log, then re-read the device state (see toggleMqttLog).
-function toggleHexdump() {
-  fetch('/togglehexdump')
-    .then(function() { refreshConsoleToggles(); })
-    .catch(function(err) {
-      console.error('Error toggling hexdump:', err);
-      refreshConsoleToggles();
-    });
-}
-
-function downloadConsole() {
-  var text = document.getElementById('cli').value;
-  if (!text) return;
-  var blob = new Blob([text], { type: 'text/plain' });
-  var url = URL.createObjectURL(blob);
-  var a = document.createElement('a');
-  var now = new Date();
-  var ts = now.getFullYear()
-    + '-' + String(now.getMonth()+1).padStart(2,'0')
-    + '-' + String(now.getDate()).padStart(2,'0')
-    + '_' + String(now.getHours()).padStart(2,'0')
-    + String(now.getMinutes()).padStart(2,'0')
-    + String(now.getSeconds()).padStart(2,'0');
-  a.href = url;
-  a.download = 'heishamon-console-' + ts + '.txt';
-  a.click();
-  URL.revokeObjectURL(url);
-}
-
-// Initialize on page load
-document.addEventListener('DOMContentLoaded', function() {
-  if (document.getElementById('mqttLogToggle')) {
-    initConsoleToggles();
-  }
-});
-</script>
-)====";
-
 // ─────────────────────────────────────────────────────────────────────────────
 // ROOT PAGE BODY FRAGMENTS
 // ─────────────────────────────────────────────────────────────────────────────
@@ -1319,9 +238,9 @@ static const char webBodyRootDallasValues[] FLASHPROG = R"====(
 static const char webBodyRootS0Values[] FLASHPROG = R"====(
 <div id='S0' class='tab-pane'>
 <div class='panel'>
-  <div class='panel-header'><h3>S0 kWh Meters</h3><span class='panel-meta'>Live</span></div>
+  <div class='panel-header'><h3>S0 Meters</h3><span class='panel-meta'>Live</span></div>
   <table><thead><tr>
-    <th>Port</th><th>Watt</th><th>Wh</th><th>Wh Total</th><th>Pulse Quality</th><th>Avg Pulse Width</th>
+    <th>Port</th><th>W or l/h</th><th>Wh or l</th><th>Total</th><th>Pulse Quality</th><th>Avg Pulse Width</th>
   </tr></thead><tbody id='s0values'>
     <tr><td colspan='6' style='color:var(--text-muted);padding:24px;text-align:center'>Loading…</td></tr>
   </tbody></table>
@@ -1379,22 +298,6 @@ static const char webBodyRootConsole[] FLASHPROG = R"====(
 // ─────────────────────────────────────────────────────────────────────────────
 // SETTINGS PAGE
 // ─────────────────────────────────────────────────────────────────────────────
-static const char settingsJS[] FLASHPROG = R"====(
-<script>
-function ShowHideDallasTable(cb){
-  document.getElementById('dallassettings').style.display=cb.checked?'block':'none';
-}
-function ShowHideS0Table(cb){
-  document.getElementById('s0settings').style.display=cb.checked?'block':'none';
-}
-function changeMinWatt(port){
-  var ppkwh=document.getElementById('s0_ppkwh_'+port).value;
-  var interval=document.getElementById('s0_interval_'+port).value;
-  document.getElementById('s0_minwatt_'+port).innerHTML=Math.round((3600*1000/ppkwh)/interval);
-}
-</script>
-)====";
-
 #ifdef TLS_SUPPORT 
 static const char caUploadJS[] PROGMEM = R"====(
   <script>
@@ -1572,7 +475,21 @@ static const char settingsForm2[] FLASHPROG = R"====(
       <label class='setting-label'>Heatpump poll interval</label>
       <div style='display:flex;align-items:center;gap:8px'>
         <input type='number' name='waitTime' class='setting-input' value='' style='width:80px'>
-        <span class='setting-hint'>seconds (min 5)</span>
+        <span class='setting-hint'>seconds while running (min 5)</span>
+      </div>
+    </div>
+    <div class='setting-row'>
+      <label class='setting-label'>Heatpump idle poll interval</label>
+      <div style='display:flex;align-items:center;gap:8px'>
+        <input type='number' name='waitTimeIdle' class='setting-input' value='' style='width:80px'>
+        <span class='setting-hint'>seconds while compressor is off</span>
+      </div>
+    </div>
+    <div class='setting-row'>
+      <label class='setting-label'>Extra data poll interval</label>
+      <div style='display:flex;align-items:center;gap:8px'>
+        <input type='number' name='waitTimeExtra' class='setting-input' value='' style='width:80px'>
+        <span class='setting-hint'>seconds (0 = with heatpump poll)</span>
       </div>
     </div>
     <div class='setting-row'>
@@ -1589,10 +506,17 @@ static const char settingsForm2[] FLASHPROG = R"====(
     <div class='setting-row'><label class='setting-label'>WiFi hotspot when disconnected</label><div class='checkbox-wrap'><input type='checkbox' name='hotspot' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Debug log to MQTT from start</label><div class='checkbox-wrap'><input type='checkbox' name='logMqtt' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Debug hexdump from start</label><div class='checkbox-wrap'><input type='checkbox' name='logHexdump' value='enabled'></div></div>
+    <div class='setting-row'><label class='setting-label'>Record raw frames to flash</label><div style='display:flex;align-items:center;gap:10px'><div class='checkbox-wrap'><input type='checkbox' name='recordFrames' value='enabled'></div><span class='setting-hint' style='display:block;margin-top:4px'>Download them at /rawframes</span></div></div>
+    <div class='setting-row'>
+      <label class='setting-label'>History topics</label>
+      <input type='text' name='historyTopics' maxlength='63' class='setting-input' value='' placeholder='e.g. TOP5,TOP6,XTOP0'>
+    </div>
+    <div class='setting-row'><label class='setting-label'>Keep 15 minute history over reboot</label><div class='checkbox-wrap'><input type='checkbox' name='historyFlush' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Debug log to serial1 (GPIO2)</label><div class='checkbox-wrap'><input type='checkbox' name='logSerial1' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Emulate optional PCB</label><div class='checkbox-wrap'><input type='checkbox' name='optionalPCB' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Enable Opentherm processing</label><div class='checkbox-wrap'><input type='checkbox' name='opentherm' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Force load rules on boot</label><div style='display:flex;align-items:center;gap:10px'><div class='checkbox-wrap'><input type='checkbox' name='force_rules' value='enabled'></div><span class='setting-hint' style='display:block;margin-top:4px'>Rules load normally, but skip after crashes to prevent boot loops. Enable to override.</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Fast boot</label><div style='display:flex;align-items:center;gap:10px'><div class='checkbox-wrap'><input type='checkbox' name='fastBoot' value='enabled'></div><span class='setting-hint' style='display:block;margin-top:4px'>Read the heatpump before the network is up, the 1-wire scan, rules and NTP wait for the first read.</span></div></div>
   </div></div>
   <div class='panel' style='margin-bottom:16px'>
   <div class='panel-header'><h3>Listen Only</h3></div>
@@ -1638,15 +562,19 @@ static const char settingsForm2[] FLASHPROG = R"====(
   </div>
   <div id='s0settings' style='display:none'>
   <div class='settings-grid'>
+    <div class='setting-row'><label class='setting-label'>Port 1 meter</label><select name='s0_1_unit' class='setting-input'><option value='0'>Electricity (imp/kWh)</option><option value='1'>Water or gas (imp/m&sup3;)</option></select></div>
     <div class='setting-row'><label class='setting-label'>Port 1 imp/kWh</label><input type='number' id='s0_ppkwh_1' onchange='changeMinWatt(1)' name='s0_1_ppkwh' class='setting-input' value=''></div>
     <div class='setting-row'><label class='setting-label'>Port 1 standby interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_interval_1' onchange='changeMinWatt(1)' name='s0_1_interval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 1 min pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_minpulsewidth_1' name='s0_1_minpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 1 max pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_maxpulsewidth_1' name='s0_1_maxpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 1 report interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' min='1' id='s0_reportinterval_1' name='s0_1_reportinterval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 1 standby threshold</label><span style='font-size:12px;color:var(--text-muted)'><span id='s0_minwatt_1'>—</span> W</span></div>
+    <div class='setting-row'><label class='setting-label'>Port 2 meter</label><select name='s0_2_unit' class='setting-input'><option value='0'>Electricity (imp/kWh)</option><option value='1'>Water or gas (imp/m&sup3;)</option></select></div>
     <div class='setting-row'><label class='setting-label'>Port 2 imp/kWh</label><input type='number' id='s0_ppkwh_2' onchange='changeMinWatt(2)' name='s0_2_ppkwh' class='setting-input' value=''></div>
     <div class='setting-row'><label class='setting-label'>Port 2 standby interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_interval_2' onchange='changeMinWatt(2)' name='s0_2_interval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 2 min pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_minpulsewidth_2' name='s0_2_minpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 2 max pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_maxpulsewidth_2' name='s0_2_maxpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 2 report interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' min='1' id='s0_reportinterval_2' name='s0_2_reportinterval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 2 standby threshold</label><span style='font-size:12px;color:var(--text-muted)'><span id='s0_minwatt_2'>—</span> W</span></div>
   </div></div>
   </div>
@@ -1673,7 +601,21 @@ static const char settingsForm2[] FLASHPROG = R"====(
       <label class='setting-label'>Heatpump poll interval</label>
       <div style='display:flex;align-items:center;gap:8px'>
         <input type='number' name='waitTime' class='setting-input' value='' style='width:80px'>
-        <span class='setting-hint'>seconds (min 5)</span>
+        <span class='setting-hint'>seconds while running (min 5)</span>
+      </div>
+    </div>
+    <div class='setting-row'>
+      <label class='setting-label'>Heatpump idle poll interval</label>
+      <div style='display:flex;align-items:center;gap:8px'>
+        <input type='number' name='waitTimeIdle' class='setting-input' value='' style='width:80px'>
+        <span class='setting-hint'>seconds while compressor is off</span>
+      </div>
+    </div>
+    <div class='setting-row'>
+      <label class='setting-label'>Extra data poll interval</label>
+      <div style='display:flex;align-items:center;gap:8px'>
+        <input type='number' name='waitTimeExtra' class='setting-input' value='' style='width:80px'>
+        <span class='setting-hint'>seconds (0 = with heatpump poll)</span>
       </div>
     </div>
     <div class='setting-row'>
@@ -1690,11 +632,18 @@ static const char settingsForm2[] FLASHPROG = R"====(
     <div class='setting-row'><label class='setting-label'>WiFi hotspot when disconnected</label><div class='checkbox-wrap'><input type='checkbox' name='hotspot' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Debug log to MQTT from start</label><div class='checkbox-wrap'><input type='checkbox' name='logMqtt' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Debug hexdump from start</label><div class='checkbox-wrap'><input type='checkbox' name='logHexdump' value='enabled'></div></div>
+    <div class='setting-row'><label class='setting-label'>Record raw frames to flash</label><div style='display:flex;align-items:center;gap:10px'><div class='checkbox-wrap'><input type='checkbox' name='recordFrames' value='enabled'></div><span class='setting-hint' style='display:block;margin-top:4px'>Download them at /rawframes</span></div></div>
+    <div class='setting-row'>
+      <label class='setting-label'>History topics</label>
+      <input type='text' name='historyTopics' maxlength='63' class='setting-input' value='' placeholder='e.g. TOP5,TOP6,XTOP0'>
+    </div>
+    <div class='setting-row'><label class='setting-label'>Keep 15 minute history over reboot</label><div class='checkbox-wrap'><input type='checkbox' name='historyFlush' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Debug log USB</label><div class='checkbox-wrap'><input type='checkbox' name='logSerial1' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Emulate optional PCB</label><div class='checkbox-wrap'><input type='checkbox' name='optionalPCB' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Enable Opentherm processing</label><div class='checkbox-wrap'><input type='checkbox' name='opentherm' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Enable CZ-TAW1 proxy port</label><div class='checkbox-wrap'><input type='checkbox' name='proxy' value='enabled'></div></div>
     <div class='setting-row'><label class='setting-label'>Force rules on boot</label><div class='checkbox-wrap'><input type='checkbox' name='force_rules' value='enabled'></div></div>
+    <div class='setting-row'><label class='setting-label'>Fast boot</label><div class='checkbox-wrap'><input type='checkbox' name='fastBoot' value='enabled'></div></div>
   </div></div>
   <div class='panel' style='margin-bottom:16px'>
   <div class='panel-header'><h3>Listen Only</h3></div>
@@ -1740,16 +689,36 @@ static const char settingsForm2[] FLASHPROG = R"====(
   </div>
   <div id='s0settings' style='display:none'>
   <div class='settings-grid'>
+    <div class='setting-row'><label class='setting-label'>Port 1 meter</label><select name='s0_1_unit' class='setting-input'><option value='0'>Electricity (imp/kWh)</option><option value='1'>Water or gas (imp/m&sup3;)</option></select></div>
     <div class='setting-row'><label class='setting-label'>Port 1 imp/kWh</label><input type='number' id='s0_ppkwh_1' onchange='changeMinWatt(1)' name='s0_1_ppkwh' class='setting-input' value=''></div>
     <div class='setting-row'><label class='setting-label'>Port 1 standby interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_interval_1' onchange='changeMinWatt(1)' name='s0_1_interval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 1 min pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_minpulsewidth_1' name='s0_1_minpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 1 max pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_maxpulsewidth_1' name='s0_1_maxpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 1 report interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' min='1' id='s0_reportinterval_1' name='s0_1_reportinterval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 1 standby threshold</label><span style='font-size:12px;color:var(--text-muted)'><span id='s0_minwatt_1'>—</span> W</span></div>
+    <div class='setting-row'><label class='setting-label'>Port 2 meter</label><select name='s0_2_unit' class='setting-input'><option value='0'>Electricity (imp/kWh)</option><option value='1'>Water or gas (imp/m&sup3;)</option></select></div>
     <div class='setting-row'><label class='setting-label'>Port 2 imp/kWh</label><input type='number' id='s0_ppkwh_2' onchange='changeMinWatt(2)' name='s0_2_ppkwh' class='setting-input' value=''></div>
     <div class='setting-row'><label class='setting-label'>Port 2 standby interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_interval_2' onchange='changeMinWatt(2)' name='s0_2_interval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 2 min pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_minpulsewidth_2' name='s0_2_minpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 2 max pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_maxpulsewidth_2' name='s0_2_maxpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 2 report interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' min='1' id='s0_reportinterval_2' name='s0_2_reportinterval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
     <div class='setting-row'><label class='setting-label'>Port 2 standby threshold</label><span style='font-size:12px;color:var(--text-muted)'><span id='s0_minwatt_2'>—</span> W</span></div>
+    <div class='setting-row'><label class='setting-label'>Port 3 gpio</label><div style='display:flex;align-items:center;gap:8px'><input type='number' name='s0_3_gpio' class='setting-input' value='' style='width:80px'><span class='setting-hint'>255 is off</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 3 meter</label><select name='s0_3_unit' class='setting-input'><option value='0'>Electricity (imp/kWh)</option><option value='1'>Water or gas (imp/m&sup3;)</option></select></div>
+    <div class='setting-row'><label class='setting-label'>Port 3 imp/kWh</label><input type='number' id='s0_ppkwh_3' onchange='changeMinWatt(3)' name='s0_3_ppkwh' class='setting-input' value=''></div>
+    <div class='setting-row'><label class='setting-label'>Port 3 standby interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_interval_3' onchange='changeMinWatt(3)' name='s0_3_interval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 3 min pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_minpulsewidth_3' name='s0_3_minpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 3 max pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_maxpulsewidth_3' name='s0_3_maxpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 3 report interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' min='1' id='s0_reportinterval_3' name='s0_3_reportinterval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 3 standby threshold</label><span style='font-size:12px;color:var(--text-muted)'><span id='s0_minwatt_3'>—</span> W</span></div>
+    <div class='setting-row'><label class='setting-label'>Port 4 gpio</label><div style='display:flex;align-items:center;gap:8px'><input type='number' name='s0_4_gpio' class='setting-input' value='' style='width:80px'><span class='setting-hint'>255 is off</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 4 meter</label><select name='s0_4_unit' class='setting-input'><option value='0'>Electricity (imp/kWh)</option><option value='1'>Water or gas (imp/m&sup3;)</option></select></div>
+    <div class='setting-row'><label class='setting-label'>Port 4 imp/kWh</label><input type='number' id='s0_ppkwh_4' onchange='changeMinWatt(4)' name='s0_4_ppkwh' class='setting-input' value=''></div>
+    <div class='setting-row'><label class='setting-label'>Port 4 standby interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_interval_4' onchange='changeMinWatt(4)' name='s0_4_interval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 4 min pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_minpulsewidth_4' name='s0_4_minpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 4 max pulse width</label><div style='display:flex;align-items:center;gap:8px'><input type='number' id='s0_maxpulsewidth_4' name='s0_4_maxpulsewidth' class='setting-input' value='' style='width:80px'><span class='setting-hint'>ms</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 4 report interval</label><div style='display:flex;align-items:center;gap:8px'><input type='number' min='1' id='s0_reportinterval_4' name='s0_4_reportinterval' class='setting-input' value='' style='width:80px'><span class='setting-hint'>seconds</span></div></div>
+    <div class='setting-row'><label class='setting-label'>Port 4 standby threshold</label><span style='font-size:12px;color:var(--text-muted)'><span id='s0_minwatt_4'>—</span> W</span></div>
   </div></div>
   </div>
   <div class='form-actions'>
@@ -1797,7 +766,7 @@ R"====(
       }
       document.getElementById('loading_settings').style.display='none';
       document.getElementById('settings_form').style.display='block';
-      changeMinWatt(1);changeMinWatt(2);
+      for(var p=1;document.getElementById('s0_ppkwh_'+p);p++)changeMinWatt(p);
     }
   };
   req.open('GET','/getsettings',true);
@@ -1807,43 +776,6 @@ getSettings();
 </script>
 )====";
 
-static const char changewifissidJS[] FLASHPROG = R"====(
-<script>
-function changewifissid(){
-  document.getElementById('wifi_ssid_id').value=document.getElementById('wifi_ssid_select').value;
-}
-</script>
-)====";
-
-static const char populatescanwifiJS[] FLASHPROG = R"====(
-<script>
-var refreshWifiScan=function(){
-  var sel=document.getElementById('wifi_ssid_select');
-  var req=new XMLHttpRequest();
-  req.onreadystatechange=function(){
-    if(req.readyState===4&&req.status===200){
-      var list=JSON.parse(req.responseText);
-      sel.innerHTML='';
-      var def=document.createElement('option');
-      def.value='';def.text='Select SSID';def.selected=true;def.hidden=true;
-      sel.appendChild(def);
-      list.forEach(function(item){
-        var opt=document.createElement('option');
-        opt.value=item.ssid;
-        opt.text=item.ssid+' ('+item.rssi+' dBm)';
-        sel.appendChild(opt);
-      });
-      sel.style.display='block';
-    }
-  };
-  req.open('GET','/wifiscan',true);
-  req.send();
-  setTimeout(refreshWifiScan,30000);
-};
-setTimeout(refreshWifiScan,500);
-</script>
-)====";
-
 // ─────────────────────────────────────────────────────────────────────────────
 // RULES PAGE
 // ─────────────────────────────────────────────────────────────────────────────
@@ -1875,434 +807,6 @@ static const char showRulesPage2[] FLASHPROG = R"====(</div>
   <div id='validation-result'></div>
 )====";
 
-static const char rulesJS[] FLASHPROG = R"=====(
-<script>
-const KEYWORDS = ['on','then','end','if','else','elseif','NULL'];
-const OPERATORS = ['&&','||','==','>=','<=','!=','>','<','+','-','*','/','%','^','='];
-const FUNCTIONS = ['coalesce','max','min','isset','round','floor','ceil','setTimer','print','concat','gpio'];
-
-function highlightRules() {
-  const editor = document.getElementById('rules');
-  const cursorPos = saveCursorPosition(editor);
-  
-  let text = editor.textContent;
-  let html = '';
-  let i = 0;
-  
-  while(i < text.length) {
-    let matched = false;
-    
-    // Comments
-    if(text.substr(i,2) === '//') {
-      let end = text.indexOf('\n', i);
-      if(end === -1) end = text.length;
-      html += '<span class="comment">' + escapeHtml(text.substring(i,end)) + '</span>';
-      i = end;
-      matched = true;
-    }
-    
-    // Strings
-    if(!matched && (text[i] === "'" || text[i] === '"')) {
-      const quote = text[i];
-      let end = i + 1;
-      while(end < text.length && text[end] !== quote) {
-        if(text[end] === '\\') end++;
-        end++;
-      }
-      if(end < text.length) end++;
-      html += '<span class="string">' + escapeHtml(text.substring(i,end)) + '</span>';
-      i = end;
-      matched = true;
-    }
-    
-    // Numbers
-    if(!matched && /\d/.test(text[i])) {
-      let end = i;
-      while(end < text.length && /[\d.]/.test(text[end])) end++;
-      html += '<span class="number">' + text.substring(i,end) + '</span>';
-      i = end;
-      matched = true;
-    }
-    
-    // Keywords
-    if(!matched && /[a-zA-Z]/.test(text[i])) {
-      for(let k of KEYWORDS) {
-        if(text.substr(i,k.length) === k && (i===0 || !/\w/.test(text[i-1])) && (i+k.length>=text.length || !/\w/.test(text[i+k.length]))) {
-          html += '<span class="keyword">' + k + '</span>';
-          i += k.length;
-          matched = true;
-          break;
-        }
-      }
-    }
-    
-    // Functions
-    if(!matched && /[a-zA-Z]/.test(text[i])) {
-      for(let f of FUNCTIONS) {
-        if(text.substr(i,f.length+1) === f+'(' && (i===0 || !/\w/.test(text[i-1]))) {
-          html += '<span class="function">' + f + '</span>(';
-          i += f.length + 1;
-          matched = true;
-          break;
-        }
-      }
-    }
-    
-    // Heatpump params (@)
-    if(!matched && text[i] === '@') {
-      let end = i + 1;
-      while(end < text.length && /\w/.test(text[end])) end++;
-      html += '<span class="at-param">' + text.substring(i,end) + '</span>';
-      i = end;
-      matched = true;
-    }
-    
-    // DateTime params (%)
-    if(!matched && text[i] === '%') {
-      let end = i + 1;
-      while(end < text.length && /\w/.test(text[end])) end++;
-      html += '<span class="percent-param">' + text.substring(i,end) + '</span>';
-      i = end;
-      matched = true;
-    }
-    
-    // Thermostat params (?)
-    if(!matched && text[i] === '?') {
-      let end = i + 1;
-      while(end < text.length && /\w/.test(text[end])) end++;
-      html += '<span class="question-param">' + text.substring(i,end) + '</span>';
-      i = end;
-      matched = true;
-    }
-    
-    // Dallas sensors
-    if(!matched && text.substr(i,8) === 'ds18b20#') {
-      let end = i + 8;
-      while(end < text.length && /[0-9A-Fa-f]/.test(text[end])) end++;
-      html += '<span class="ds18b20">' + text.substring(i,end) + '</span>';
-      i = end;
-      matched = true;
-    }
-    
-    // Variables (# and $)
-    if(!matched && (text[i] === '#' || text[i] === '$')) {
-      let end = i + 1;
-      while(end < text.length && /\w/.test(text[end])) end++;
-      html += '<span class="variable">' + text.substring(i,end) + '</span>';
-      i = end;
-      matched = true;
-    }
-    
-    // Operators (check longer ones first)
-    if(!matched) {
-      const sortedOps = OPERATORS.slice().sort((a,b) => b.length - a.length);
-      for(let o of sortedOps) {
-        if(text.substr(i,o.length) === o) {
-          html += '<span class="operator">' + escapeHtml(o) + '</span>';
-          i += o.length;
-          matched = true;
-          break;
-        }
-      }
-    }
-    
-    // Default character
-    if(!matched) {
-      html += escapeHtml(text[i]);
-      i++;
-    }
-  }
-  
-  editor.innerHTML = html;
-  restoreCursorPosition(editor, cursorPos);
-}
-
-function escapeHtml(text) {
-  return text.replace(/[&<>]/g, m => ({'&':'&amp;','<':'&lt;','>':'&gt;'}[m]));
-}
-
-function saveCursorPosition(el) {
-  const sel = window.getSelection();
-  if(sel.rangeCount === 0) return null;
-  const range = sel.getRangeAt(0);
-  const preCaretRange = range.cloneRange();
-  preCaretRange.selectNodeContents(el);
-  preCaretRange.setEnd(range.endContainer, range.endOffset);
-  return preCaretRange.toString().length;
-}
-
-function restoreCursorPosition(el, pos) {
-  if(pos === null) return;
-  const sel = window.getSelection();
-  let charCount = 0;
-  const nodeStack = [el];
-  let node, foundStart = false;
-  const range = document.createRange();
-  range.setStart(el, 0);
-  range.collapse(true);
-  
-  while(!foundStart && (node = nodeStack.pop())) {
-    if(node.nodeType === 3) {
-      const nextCharCount = charCount + node.length;
-      if(pos <= nextCharCount) {
-        range.setStart(node, pos - charCount);
-        foundStart = true;
-      }
-      charCount = nextCharCount;
-    } else {
-      let i = node.childNodes.length;
-      while(i--) {
-        nodeStack.push(node.childNodes[i]);
-      }
-    }
-  }
-  
-  sel.removeAllRanges();
-  sel.addRange(range);
-}
-
-function updateLineNumbers() {
-  const editor = document.getElementById('rules');
-  const lineNumbers = document.getElementById('line-numbers');
-  const lines = editor.textContent.split('\n');
-  const lineCount = lines.length;
-  
-  let html = '';
-  for(let i = 1; i <= lineCount; i++) {
-    html += i + '\n';
-  }
-  
-  lineNumbers.textContent = html;
-}
-
-function validateRules() {
-  const editor = document.getElementById('rules');
-  const result = document.getElementById('validation-result');
-  const code = editor.textContent.trim();
-  
-  if(!code) {
-    result.innerHTML = '<div class="validation-feedback warning">Rules are empty.</div>';
-    return;
-  }
-  
-  const errors = [];
-  const warnings = [];
-  const blockStack = [];
-  
-  let cleanCode = code.replace(/\/\/.*$/gm, '');
-  cleanCode = cleanCode.replace(/'[^']*'/g, '""').replace(/"[^"]*"/g, '""');
-  
-  const lines = cleanCode.split('\n');
-  
-  for(let lineNum = 0; lineNum < lines.length; lineNum++) {
-    const line = lines[lineNum];
-    const trimmed = line.trim();
-    
-    if(!trimmed) continue;
-    
-    const statements = trimmed.split(/;|\bthen\b/).map(s => s.trim()).filter(s => s);
-    
-    for(let stmt of statements) {
-      if(/^on\s+/.test(stmt)) {
-        blockStack.push({type: 'on', line: lineNum + 1});
-      }
-      else if(/^if\s+/.test(stmt)) {
-        blockStack.push({type: 'if', line: lineNum + 1, hasElse: false});
-      }
-      else if(/^elseif\s+/.test(stmt)) {
-        if(blockStack.length === 0 || blockStack[blockStack.length-1].type !== 'if') {
-          errors.push('Line ' + (lineNum+1) + ': "elseif" without matching "if"');
-        } else if(blockStack[blockStack.length-1].hasElse) {
-          errors.push('Line ' + (lineNum+1) + ': "elseif" after "else"');
-        }
-      }
-      else if(/^else$/.test(stmt)) {
-        if(blockStack.length === 0 || blockStack[blockStack.length-1].type !== 'if') {
-          errors.push('Line ' + (lineNum+1) + ': "else" without matching "if"');
-        } else if(blockStack[blockStack.length-1].hasElse) {
-          errors.push('Line ' + (lineNum+1) + ': Multiple "else" for same "if"');
-        } else {
-          blockStack[blockStack.length-1].hasElse = true;
-        }
-      }
-      else if(/^end$/.test(stmt)) {
-        if(blockStack.length === 0) {
-          errors.push('Line ' + (lineNum+1) + ': "end" without matching block');
-        } else {
-          blockStack.pop();
-        }
-      }
-    }
-    
-    // Check for missing semicolons - CORRECTED VERSION
-    const origTrimmed = code.split('\n')[lineNum].trim();
-    if(origTrimmed && !origTrimmed.startsWith('//')) {
-      const needsSemicolon = !origTrimmed.endsWith(';') && 
-                             !origTrimmed.endsWith('then') && 
-                             !origTrimmed.endsWith('end') &&
-                             origTrimmed !== 'else' &&
-                             origTrimmed !== 'end' &&
-                             !/^(on|if|elseif)\s/.test(origTrimmed);
-      
-      if(needsSemicolon) {
-        warnings.push('Line ' + (lineNum+1) + ': Missing semicolon');
-      }
-    }
-  }
-  
-  if(blockStack.length > 0) {
-    const unclosed = blockStack.map(b => b.type + ' (line ' + b.line + ')');
-    errors.push('Unclosed block(s): ' + unclosed.join(', '));
-  }
-  
-  editor.classList.remove('rules-error', 'rules-valid');
-  
-  if(errors.length > 0) {
-    editor.classList.add('rules-error');
-    result.innerHTML = '<div class="validation-feedback error"><strong>Errors:</strong><br>' + errors.join('<br>') + '</div>';
-  } else if(warnings.length > 0) {
-    editor.classList.add('rules-valid');
-    result.innerHTML = '<div class="validation-feedback warning"><strong>Warnings:</strong><br>' + warnings.join('<br>') + '</div>';
-  } else {
-    editor.classList.add('rules-valid');
-    result.innerHTML = '<div class="validation-feedback success"><strong>✓ Rules are valid!</strong><br>No syntax errors detected.</div>';
-  }
-}
-
-function saveRules() {
-  const editor = document.getElementById('rules');
-  const rulesText = editor.textContent.trim();
-  
-  // Use fetch with explicit body control
-  fetch('/saverules', {
-    method: 'POST',
-    headers: {
-      'Content-Type': 'application/x-www-form-urlencoded'
-    },
-    body: 'rules=' + encodeURIComponent(rulesText)
-  })
-  .then(function(response) {
-    if (response.ok) {
-      // Reload the page to show saved rules
-      window.location.href = '/rules';
-    } else {
-      alert('Failed to save rules');
-    }
-  })
-  .catch(function(err) {
-    console.error('Error saving rules:', err);
-    alert('Error saving rules');
-  });
-}
-
-function clearRules() {
-  if(confirm('Are you sure you want to clear all rules? This cannot be undone.')) {
-    const editor = document.getElementById('rules');
-    editor.textContent = '';
-    
-    // Save the empty rules
-    const formData = new FormData();
-    formData.append('rules', '');
-    
-    fetch('/saverules', {
-      method: 'POST',
-      body: formData
-    })
-    .then(function(response) {
-      if (response.ok) {
-        window.location.href = '/rules';
-      } else {
-        alert('Failed to clear rules');
-      }
-    })
-    .catch(function(err) {
-      console.error('Error clearing rules:', err);
-      alert('Error clearing rules');
-    });
-  }
-}
-
-document.addEventListener('DOMContentLoaded', function() {
-  const editor = document.getElementById('rules');
-  if(editor) {
-    editor.textContent = editor.textContent.trim();
-    editor.addEventListener('keydown', function(e) {
-      if(e.key === 'Enter') {
-        e.preventDefault();
-        const sel = window.getSelection();
-        const range = sel.getRangeAt(0);
-        const lines = editor.textContent.substring(0, getCursorPosition()).split('\n');
-        const currentLine = lines[lines.length - 1];
-        const indentMatch = currentLine.match(/^[\t ]*/);
-        let indent = indentMatch ? indentMatch[0] : '';
-        const trimmedLine = currentLine.trim();
-        if(trimmedLine.endsWith('then')) {
-          indent += '\t';
-        }
-        range.deleteContents();
-        const textNode = document.createTextNode('\n' + indent);
-        range.insertNode(textNode);
-        range.setStartAfter(textNode);
-        range.setEndAfter(textNode);
-        sel.removeAllRanges();
-        sel.addRange(range);
-        highlightRules();
-        updateLineNumbers();
-      }
-      if(e.key === 'Tab') {
-        e.preventDefault();
-        const sel = window.getSelection();
-        const range = sel.getRangeAt(0);
-        range.deleteContents();
-        const textNode = document.createTextNode('\t');
-        range.insertNode(textNode);
-        range.setStartAfter(textNode);
-        range.setEndAfter(textNode);
-        sel.removeAllRanges();
-        sel.addRange(range);
-        highlightRules();
-        updateLineNumbers();
-      }
-      if(e.key === 'Backspace') {
-        const sel = window.getSelection();
-        if(sel.rangeCount === 0) return;
-        const range = sel.getRangeAt(0);
-        const textBeforeCursor = editor.textContent.substring(0, getCursorPosition());
-        const lines = textBeforeCursor.split('\n');
-        const currentLine = lines[lines.length - 1];
-        if(currentLine.match(/^[\t ]+$/) && range.collapsed) {
-          e.preventDefault();
-          const newIndent = currentLine.substring(0, currentLine.length - 1);
-          const lineStart = textBeforeCursor.length - currentLine.length;
-          const beforeLine = editor.textContent.substring(0, lineStart);
-          const afterLine = editor.textContent.substring(textBeforeCursor.length);
-          editor.textContent = beforeLine + newIndent + afterLine;
-          restoreCursorPosition(editor, lineStart + newIndent.length);
-          highlightRules();
-          updateLineNumbers();
-        }
-      }
-    });
-    
-    editor.addEventListener('input', highlightRules);
-    highlightRules();
-    updateLineNumbers();
-  }
-});
-
-function getCursorPosition() {
-  const sel = window.getSelection();
-  if(sel.rangeCount === 0) return 0;
-  const range = sel.getRangeAt(0);
-  const preCaretRange = range.cloneRange();
-  preCaretRange.selectNodeContents(document.getElementById('rules'));
-  preCaretRange.setEnd(range.endContainer, range.endOffset);
-  return preCaretRange.toString().length;
-}
-
-</script>
-)=====";
-
 // ─────────────────────────────────────────────────────────────────────────────
 // FIRMWARE PAGE
 // ─────────────────────────────────────────────────────────────────────────────
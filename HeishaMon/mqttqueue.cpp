@@ -0,0 +1,173 @@
+#include "mqttqueue.h"
+
+#define MQTT_QUEUE_RELATIVE 0x80 // topic is stored without the topic base
+
+struct mqttQueueEntry {
+  struct mqttQueueEntry *next;
+  unsigned long queued;
+  uint32_t hash;
+  uint16_t len;
+  uint8_t flags;
+  uint8_t topiclen;
+  char data[]; // topic, 0 terminated, followed by the payload
+};
+
+mqttQueueStatsStruct mqttQueueStats;
+
+static struct mqttQueueEntry *queueHead = NULL;
+static struct mqttQueueEntry *queueTail = NULL;
+static const char *queueBase = NULL;
+static size_t queueBaseLen = 0;
+
+static uint32_t topicHash(const char *topic) {
+  uint32_t hash = 2166136261UL;
+  while (*topic != 0) {
+    hash = (hash ^ (uint8_t)*topic++) * 16777619UL;
+  }
+  return hash;
+}
+
+static unsigned int entrySize(unsigned int topiclen, unsigned int len) {
+  return sizeof(struct mqttQueueEntry) + topiclen + 1 + len;
+}
+
+// Most topics start with the topic base, which then is not stored for every message
+void mqttQueueSetBase(const char *mqtt_topic_base) {
+  queueBase = mqtt_topic_base;
+  queueBaseLen = strlen(mqtt_topic_base);
+}
+
+bool mqttQueuePublish(const char *topic, const char *payload, uint8_t flags) {
+  return mqttQueuePublish(topic, (const uint8_t *)payload, strlen(payload), flags);
+}
+
+bool mqttQueuePublish(const char *topic, const uint8_t *payload, unsigned int len, uint8_t flags) {
+  if ((queueBase != NULL) && (queueBaseLen > 0) && (strncmp(topic, queueBase, queueBaseLen) == 0) && (topic[queueBaseLen] == '/')) {
+    topic += queueBaseLen + 1;
+    flags |= MQTT_QUEUE_RELATIVE;
+  }
+  unsigned int topiclen = strlen(topic);
+  unsigned int limit = (flags & MQTT_QUEUE_LOW) ? MQTT_QUEUE_SIZE / 2 : MQTT_QUEUE_SIZE;
+  if ((topiclen > 255) || (len > 0xFFFF)) {
+    mqttQueueStats.dropped++;
+    return false;
+  }
+  uint32_t hash = topicHash(topic);
+
+  if (flags & MQTT_QUEUE_COALESCE) {
+    struct mqttQueueEntry *prev = NULL;
+    for (struct mqttQueueEntry *entry = queueHead; entry != NULL; prev = entry, entry = entry->next) {
+      if ((entry->hash != hash) || ((entry->flags & (MQTT_QUEUE_COALESCE | MQTT_QUEUE_RELATIVE)) != (flags & (MQTT_QUEUE_COALESCE | MQTT_QUEUE_RELATIVE))) || (strcmp(entry->data, topic) != 0)) {
+        continue;
+      }
+      // keep the position and age in the queue, only the value is replaced
+      if (entry->len != len) {
+        if (mqttQueueStats.bytes - entrySize(topiclen, entry->len) + entrySize(topiclen, len) > limit) {
+          mqttQueueStats.dropped++;
+          return false;
+        }
+        struct mqttQueueEntry *node = (struct mqttQueueEntry *)realloc(entry, entrySize(topiclen, len));
+        if (node == NULL) {
+          mqttQueueStats.dropped++;
+          return false;
+        }
+        mqttQueueStats.bytes = mqttQueueStats.bytes - entrySize(topiclen, node->len) + entrySize(topiclen, len);
+        entry = node;
+        if (prev == NULL) {
+          queueHead = entry;
+        } else {
+          prev->next = entry;
+        }
+        if (entry->next == NULL) {
+          queueTail = entry;
+        }
+        entry->len = len;
+      }
+      memcpy(&entry->data[topiclen + 1], payload, len);
+      entry->flags = flags;
+      mqttQueueStats.coalesced++;
+      if (mqttQueueStats.bytes > mqttQueueStats.peakBytes) {
+        mqttQueueStats.peakBytes = mqttQueueStats.bytes;
+      }
+      return true;
+    }
+  }
+
+  unsigned int size = entrySize(topiclen, len);
+  if (mqttQueueStats.bytes + size > limit) {
+    mqttQueueStats.dropped++;
+    return false;
+  }
+  struct mqttQueueEntry *entry = (struct mqttQueueEntry *)malloc(size);
+  if (entry == NULL) {
+    mqttQueueStats.dropped++;
+    return false;
+  }
+  entry->next = NULL;
+  entry->queued = millis();
+  entry->hash = hash;
+  entry->len = len;
+  entry->flags = flags;
+  entry->topiclen = topiclen;
+  memcpy(entry->data, topic, topiclen + 1);
+  memcpy(&entry->data[topiclen + 1], payload, len);
+
+  if (queueTail == NULL) {
+    queueHead = entry;
+  } else {
+    queueTail->next = entry;
+  }
+  queueTail = entry;
+
+  mqttQueueStats.queued++;
+  mqttQueueStats.length++;
+  mqttQueueStats.bytes += size;
+  if (mqttQueueStats.bytes > mqttQueueStats.peakBytes) {
+    mqttQueueStats.peakBytes = mqttQueueStats.bytes;
+  }
+  return true;
+}
+
+static void popEntry() {
+  struct mqttQueueEntry *entry = queueHead;
+  queueHead = entry->next;
+  if (queueHead == NULL) {
+    queueTail = NULL;
+  }
+  mqttQueueStats.bytes -= entrySize(entry->topiclen, entry->len);
+  mqttQueueStats.length--;
+  free(entry);
+}
+
+// Hand queued messages to the mqtt client until the byte budget of this loop
+// iteration is used. Messages stay queued while the client is disconnected.
+void mqttQueueLoop(PubSubClient &mqtt_client, unsigned int budget) {
+  unsigned int sent = 0;
+  char topic[256];
+
+  while ((queueHead != NULL) && (sent < budget) && mqtt_client.connected()) {
+    struct mqttQueueEntry *entry = queueHead;
+    const char *fulltopic = entry->data;
+    if (entry->flags & MQTT_QUEUE_RELATIVE) {
+      snprintf(topic, sizeof(topic), "%s/%s", queueBase, entry->data);
+      fulltopic = topic;
+    }
+    bool ok = mqtt_client.publish(fulltopic, (const uint8_t *)&entry->data[entry->topiclen + 1], entry->len, (entry->flags & MQTT_QUEUE_RETAIN) != 0);
+    sent += entry->topiclen + entry->len;
+    if (ok) {
+      unsigned long latency = millis() - entry->queued;
+      mqttQueueStats.published++;
+      if (latency > mqttQueueStats.maxLatency) {
+        mqttQueueStats.maxLatency = latency;
+      }
+      mqttQueueStats.avgLatency = (mqttQueueStats.avgLatency * 7 + latency) / 8;
+    } else {
+      mqttQueueStats.failed++;
+    }
+    popEntry();
+    if (!ok) {
+      // don't keep writing to a connection that just failed, continue next loop
+      break;
+    }
+  }
+}
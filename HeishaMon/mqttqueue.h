@@ -0,0 +1,41 @@
+#ifndef _MQTTQUEUE_H_
+#define _MQTTQUEUE_H_
+
+#include <Arduino.h>
+#include <PubSubClient.h>
+
+// heap the queued messages may use together
+#if defined(ESP8266)
+#define MQTT_QUEUE_SIZE 8192
+#else
+#define MQTT_QUEUE_SIZE 32768
+#endif
+// bytes handed to the mqtt client per loop() iteration
+#define MQTT_QUEUE_LOOP_BUDGET 1024
+
+// publish flags
+#define MQTT_QUEUE_RETAIN   0x01
+#define MQTT_QUEUE_COALESCE 0x02 // replace the queued value of the same topic instead of appending
+#define MQTT_QUEUE_LOW      0x04 // may only use half of the queue, e.g. log lines
+
+struct mqttQueueStatsStruct {
+  unsigned long queued = 0; // messages accepted
+  unsigned long coalesced = 0; // messages that replaced a queued value of the same topic
+  unsigned long published = 0;
+  unsigned long dropped = 0; // rejected because the queue was full
+  unsigned long failed = 0; // publish returned an error, message discarded
+  unsigned long maxLatency = 0; // ms between queueing and publishing
+  unsigned long avgLatency = 0;
+  unsigned int bytes = 0; // heap currently used by the queue
+  unsigned int peakBytes = 0;
+  unsigned int length = 0;
+};
+
+extern mqttQueueStatsStruct mqttQueueStats;
+
+void mqttQueueSetBase(const char *mqtt_topic_base);
+bool mqttQueuePublish(const char *topic, const uint8_t *payload, unsigned int len, uint8_t flags);
+bool mqttQueuePublish(const char *topic, const char *payload, uint8_t flags);
+void mqttQueueLoop(PubSubClient &mqtt_client, unsigned int budget);
+
+#endif
@@ -0,0 +1,191 @@
+#include "ottrace.h"
+
+otTraceStatsStruct otTraceStats;
+
+// All calls come from loop(): the requests from ot.process() in HeishaOTLoop,
+// the answers right after ot.sendResponse().
+static otTraceFrameStruct frames[OTTRACE_SIZE];
+static unsigned long count = 0; // frames traced since boot, the newest is frames[(count - 1) % OTTRACE_SIZE]
+static unsigned long frameEndTime = 0; // micros at the end of the newest request
+static unsigned long handlerStart = 0;
+static bool waiting = false; // the newest request has an answer which is not sent yet
+
+static otTraceFrameStruct *newestFrame() {
+  return &frames[(count - 1) % OTTRACE_SIZE];
+}
+
+static otTraceIdStruct *idStats(uint8_t id, bool add) {
+  for (uint8_t i = 0; i < OTTRACE_IDS; i++) {
+    if (otTraceStats.ids[i].id == id) {
+      return &otTraceStats.ids[i];
+    }
+    if (otTraceStats.ids[i].id < 0) {
+      if (!add) {
+        break;
+      }
+      otTraceStats.ids[i].id = id;
+      return &otTraceStats.ids[i];
+    }
+  }
+  return NULL;
+}
+
+// A request was received, called before it is handled
+void otTraceRequest(unsigned long request, OpenThermResponseStatus status, unsigned long frameEnd) {
+  if (waiting) {
+    newestFrame()->flags |= OTTRACE_DROPPED;
+    otTraceStats.dropped++;
+    waiting = false;
+  }
+  otTraceFrameStruct *frame = &frames[count % OTTRACE_SIZE];
+  count++;
+  *frame = otTraceFrameStruct();
+  frame->time = millis();
+  frame->request = request;
+  otTraceStats.requests++;
+  if (status == OpenThermResponseStatus::TIMEOUT) {
+    frame->flags = OTTRACE_TIMEOUT;
+    otTraceStats.timeouts++;
+  } else if (status != OpenThermResponseStatus::SUCCESS) {
+    frame->flags = OTTRACE_INVALID;
+    otTraceStats.invalid++;
+  } else {
+    otTraceIdStruct *ids = idStats((request >> 16) & 0xFF, true);
+    if (ids != NULL) {
+      ids->requests++;
+    } else {
+      otTraceStats.untracked++;
+    }
+  }
+  frameEndTime = frameEnd;
+  handlerStart = micros();
+}
+
+// The request was handled, response is the answer waiting to be sent or 0
+void otTraceHandled(unsigned long response) {
+  unsigned long elapsed = micros() - handlerStart;
+  uint16_t handler = (elapsed > 65535) ? 65535 : elapsed;
+  otTraceFrameStruct *frame = newestFrame();
+  frame->handler = handler;
+  frame->response = response;
+  waiting = (response != 0);
+  if (handler > otTraceStats.handlerMax) {
+    otTraceStats.handlerMax = handler;
+  }
+  otTraceIdStruct *ids = (frame->flags == 0) ? idStats((frame->request >> 16) & 0xFF, false) : NULL;
+  if (ids != NULL) {
+    ids->handlerSum += handler;
+    if (handler > ids->handlerMax) {
+      ids->handlerMax = handler;
+    }
+  }
+}
+
+// The answer of the newest request started to go out
+void otTraceSent(unsigned long response) {
+  otTraceFrameStruct *frame = newestFrame();
+  if (!waiting || (frame->response != response)) {
+    return;
+  }
+  waiting = false;
+  unsigned long ms = (micros() - frameEndTime) / 1000;
+  frame->latency = (ms > 65535) ? 65535 : ms;
+  frame->flags |= OTTRACE_ANSWERED;
+  otTraceStats.answered++;
+  bool late = (ms < OTTRACE_WINDOW_MIN) || (ms > OTTRACE_WINDOW_MAX);
+  if (late) {
+    frame->flags |= OTTRACE_LATE;
+    otTraceStats.late++;
+  }
+  otTraceIdStruct *ids = idStats((frame->request >> 16) & 0xFF, false);
+  if (ids != NULL) {
+    ids->answered++;
+    ids->latencySum += frame->latency;
+    if (frame->latency > ids->latencyMax) {
+      ids->latencyMax = frame->latency;
+    }
+    if (late) {
+      ids->late++;
+    }
+  }
+}
+
+unsigned long otTraceCount() {
+  return count;
+}
+
+// The counters and the stats per data id as JSON members, without braces
+String otTraceJsonStats() {
+  String text;
+  text.reserve(192 + OTTRACE_IDS * 128);
+  text += F("\"requests\":");
+  text += otTraceStats.requests;
+  text += F(",\"invalid\":");
+  text += otTraceStats.invalid;
+  text += F(",\"timeouts\":");
+  text += otTraceStats.timeouts;
+  text += F(",\"answered\":");
+  text += otTraceStats.answered;
+  text += F(",\"dropped\":");
+  text += otTraceStats.dropped;
+  text += F(",\"late\":");
+  text += otTraceStats.late;
+  text += F(",\"untracked\":");
+  text += otTraceStats.untracked;
+  text += F(",\"handlerMax\":");
+  text += otTraceStats.handlerMax;
+  text += F(",\"window\":[");
+  text += OTTRACE_WINDOW_MIN;
+  text += ',';
+  text += OTTRACE_WINDOW_MAX;
+  text += F("],\"ids\":[");
+  for (uint8_t i = 0; (i < OTTRACE_IDS) && (otTraceStats.ids[i].id >= 0); i++) {
+    otTraceIdStruct *ids = &otTraceStats.ids[i];
+    if (i > 0) {
+      text += ',';
+    }
+    text += F("{\"id\":");
+    text += ids->id;
+    text += F(",\"requests\":");
+    text += ids->requests;
+    text += F(",\"answered\":");
+    text += ids->answered;
+    text += F(",\"late\":");
+    text += ids->late;
+    text += F(",\"latencyAvg\":");
+    text += (ids->answered > 0) ? ids->latencySum / ids->answered : 0;
+    text += F(",\"latencyMax\":");
+    text += ids->latencyMax;
+    text += F(",\"handlerAvg\":");
+    text += (ids->requests > 0) ? ids->handlerSum / ids->requests : 0;
+    text += F(",\"handlerMax\":");
+    text += ids->handlerMax;
+    text += '}';
+  }
+  text += ']';
+  return text;
+}
+
+// Frames from up to to, numbered since boot, which are still kept
+String otTraceJsonFrames(unsigned long from, unsigned long to) {
+  String text;
+  if (count > OTTRACE_SIZE && from < count - OTTRACE_SIZE) {
+    from = count - OTTRACE_SIZE;
+  }
+  if (to > count) {
+    to = count;
+  }
+  if (from >= to) {
+    return text;
+  }
+  text.reserve((to - from) * 112);
+  char str[112];
+  for (unsigned long n = from; n < to; n++) {
+    otTraceFrameStruct *frame = &frames[n % OTTRACE_SIZE];
+    sprintf_P(str, PSTR("%s{\"n\":%lu,\"time\":%lu,\"request\":\"%08lx\",\"response\":\"%08lx\",\"handler\":%u,\"latency\":%u,\"flags\":%u}"),
+              (n > from) ? "," : "", n, frame->time, (unsigned long)frame->request, (unsigned long)frame->response,
+              frame->handler, frame->latency, frame->flags);
+    text += str;
+  }
+  return text;
+}
@@ -0,0 +1,68 @@
+#ifndef _OTTRACE_H_
+#define _OTTRACE_H_
+
+#include <Arduino.h>
+#include "src/opentherm/opentherm.h"
+
+// The last OpenTherm requests with their answers and the time it took to
+// handle and to answer them, for /opentherm/trace
+#if defined(ESP8266)
+#define OTTRACE_SIZE 32 // frames kept
+#define OTTRACE_IDS 16 // data ids with their own stats
+#else
+#define OTTRACE_SIZE 64
+#define OTTRACE_IDS 32
+#endif
+#define OTTRACE_CHUNK 16 // frames per part of the /opentherm/trace answer
+#define OTTRACE_WINDOW_MIN 20 // ms after the request the OpenTherm spec allows the answer to start
+#define OTTRACE_WINDOW_MAX 800 // ms after the request the answer must have started
+
+// frame flags
+#define OTTRACE_INVALID 0x01 // parity or manchester error
+#define OTTRACE_TIMEOUT 0x02 // the request was not completed
+#define OTTRACE_ANSWERED 0x04
+#define OTTRACE_DROPPED 0x08 // the answer was not sent before the next request came in
+#define OTTRACE_LATE 0x10 // answered outside the window of the spec
+
+struct otTraceFrameStruct {
+  unsigned long time = 0; // millis when the request was received
+  uint32_t request = 0;
+  uint32_t response = 0; // 0 if there is none
+  uint16_t handler = 0; // us in processOTRequest
+  uint16_t latency = 0; // ms from the end of the request to the start of the answer
+  uint8_t flags = 0;
+};
+
+struct otTraceIdStruct {
+  int16_t id = -1; // -1 if unused
+  unsigned long requests = 0;
+  unsigned long answered = 0;
+  unsigned long late = 0;
+  unsigned long latencySum = 0; // ms
+  uint16_t latencyMax = 0;
+  unsigned long handlerSum = 0; // us
+  uint16_t handlerMax = 0;
+};
+
+struct otTraceStatsStruct {
+  unsigned long requests = 0;
+  unsigned long invalid = 0;
+  unsigned long timeouts = 0;
+  unsigned long answered = 0;
+  unsigned long dropped = 0;
+  unsigned long late = 0;
+  unsigned long untracked = 0; // valid requests of data ids beyond OTTRACE_IDS
+  uint16_t handlerMax = 0; // us
+  otTraceIdStruct ids[OTTRACE_IDS];
+};
+
+extern otTraceStatsStruct otTraceStats;
+
+void otTraceRequest(unsigned long request, OpenThermResponseStatus status, unsigned long frameEnd);
+void otTraceHandled(unsigned long response);
+void otTraceSent(unsigned long response);
+unsigned long otTraceCount();
+String otTraceJsonStats();
+String otTraceJsonFrames(unsigned long from, unsigned long to);
+
+#endif
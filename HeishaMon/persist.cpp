@@ -0,0 +1,351 @@
+#include "persist.h"
+#include <LittleFS.h>
+
+persistStatsStruct persistStats;
+
+struct persistSlotStruct {
+  char path[PERSIST_PATH_SIZE]; // set once, a slot keeps its file
+  uint32_t hash = 0; // of the content in flash
+  bool hashKnown = false;
+  byte *data = NULL; // content waiting for the flash, NULL if none
+  size_t length = 0;
+  uint32_t dataHash = 0;
+  unsigned long due = 0;
+  unsigned long written = 0; // millis of the last flash write
+  bool everWritten = false;
+  bool held = false; // due but waiting for the write budget
+};
+
+static persistSlotStruct slots[PERSIST_SLOTS];
+static bool mounted = false;
+static bool (*busyCallback)() = NULL; // true while the heatpump line waits for an answer
+static uint8_t budget = PERSIST_BURST;
+static unsigned long budgetTime = 0;
+static unsigned long directStart = 0; // millis when the direct write began
+static volatile bool discarded = false; // by a factory reset, nothing is written until the restart
+
+// Files are queued from loop() and on ESP32 also from serialTXTask, the
+// flash writes are done by their own task which holds the write lock
+#if defined(ESP32)
+static portMUX_TYPE persistMux = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t writeMutex = NULL;
+#define PERSIST_LOCK() portENTER_CRITICAL(&persistMux)
+#define PERSIST_UNLOCK() portEXIT_CRITICAL(&persistMux)
+#define PERSIST_WRITE_LOCK() if (writeMutex) xSemaphoreTake(writeMutex, portMAX_DELAY)
+#define PERSIST_WRITE_UNLOCK() if (writeMutex) xSemaphoreGive(writeMutex)
+#else
+#define PERSIST_LOCK()
+#define PERSIST_UNLOCK()
+#define PERSIST_WRITE_LOCK()
+#define PERSIST_WRITE_UNLOCK()
+#endif
+
+#define PERSIST_HASH_BASIS 2166136261UL // FNV-1a
+
+static uint32_t hashUpdate(uint32_t hash, const byte *data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ data[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+static bool fileHash(const char *path, uint32_t *hash) {
+  File file = LittleFS.open(path, "r");
+  if (!file) {
+    return false;
+  }
+  byte buf[64];
+  uint32_t h = PERSIST_HASH_BASIS;
+  int n;
+  while ((n = file.read(buf, sizeof(buf))) > 0) {
+    h = hashUpdate(h, buf, n);
+  }
+  file.close();
+  *hash = h;
+  return true;
+}
+
+// Older code saves "config.json" next to "/config.json", both are the same file
+static void pathName(char *name, const char *path) {
+  if (path[0] == '/') {
+    strlcpy(name, path, PERSIST_PATH_SIZE);
+  } else {
+    snprintf(name, PERSIST_PATH_SIZE, "/%s", path);
+  }
+}
+
+// LittleFS is mounted once, the ESP8266 remounts on every begin()
+bool persistMount() {
+  if (!mounted) {
+    mounted = LittleFS.begin();
+  }
+  return mounted;
+}
+
+static persistSlotStruct *findSlot(const char *name) {
+  for (int i = 0; i < PERSIST_SLOTS; i++) {
+    if (strcmp(slots[i].path, name) == 0) {
+      return &slots[i];
+    }
+  }
+  for (int i = 0; i < PERSIST_SLOTS; i++) {
+    if (slots[i].path[0] == '\0') {
+      strlcpy(slots[i].path, name, PERSIST_PATH_SIZE);
+      return &slots[i];
+    }
+  }
+  return NULL;
+}
+
+// Queues the content of a file. It is written once nothing newer arrived for
+// PERSIST_SETTLE ms, but not earlier than holdoff ms after its previous write.
+bool persistWrite(const char *path, const void *data, size_t length, unsigned long holdoff) {
+  if (discarded) {
+    return false;
+  }
+  char name[PERSIST_PATH_SIZE];
+  pathName(name, path);
+  uint32_t hash = hashUpdate(PERSIST_HASH_BASIS, (const byte *)data, length);
+  byte *copy = (byte *)malloc(length > 0 ? length : 1);
+  if (copy == NULL) {
+    persistStats.failed++;
+    return false;
+  }
+  memcpy(copy, data, length);
+  unsigned long now = millis();
+  byte *old = NULL;
+  PERSIST_LOCK();
+  persistStats.requests++;
+  persistSlotStruct *slot = findSlot(name);
+  if (slot == NULL) {
+    old = copy;
+  } else if ((slot->data != NULL) ? (slot->dataHash == hash) : (slot->hashKnown && (slot->hash == hash))) {
+    persistStats.unchanged++;
+    old = copy;
+  } else {
+    if (slot->data != NULL) {
+      persistStats.coalesced++; // keeps its due time, a file changing all the time is still written
+      old = slot->data;
+    } else {
+      slot->due = now + PERSIST_SETTLE;
+      if (slot->everWritten && ((unsigned long)(now - slot->written) < holdoff)) {
+        slot->due = slot->written + holdoff;
+      }
+    }
+    slot->data = copy;
+    slot->length = length;
+    slot->dataHash = hash;
+  }
+  PERSIST_UNLOCK();
+  free(old);
+  if (slot == NULL) {
+    persistStats.failed++;
+    return false;
+  }
+  return true;
+}
+
+// Writes the queued content of a slot, called with the write lock held.
+// Returns true if the flash was written.
+static bool writeSlot(persistSlotStruct *slot) {
+  PERSIST_LOCK();
+  byte *data = slot->data;
+  size_t length = slot->length;
+  uint32_t hash = slot->dataHash;
+  bool known = slot->hashKnown;
+  uint32_t flashHash = slot->hash;
+  slot->data = NULL;
+  slot->held = false;
+  PERSIST_UNLOCK();
+  if (data == NULL) {
+    return false;
+  }
+  if (!known) {
+    known = fileHash(slot->path, &flashHash);
+  }
+  bool ok = true;
+  bool written = false;
+  if (known && (flashHash == hash)) {
+    persistStats.unchanged++;
+  } else {
+    unsigned long start = millis();
+    File file = persistMount() ? LittleFS.open(slot->path, "w") : File();
+    ok = file && (file.write(data, length) == length);
+    if (file) {
+      file.close();
+    }
+    unsigned long elapsed = millis() - start;
+    if (elapsed > persistStats.maxTime) {
+      persistStats.maxTime = elapsed;
+    }
+    if (ok) {
+      persistStats.writes++;
+      persistStats.bytes += length;
+      written = true;
+    }
+  }
+  PERSIST_LOCK();
+  if (ok) {
+    slot->hash = hash;
+    slot->hashKnown = true;
+    if (written) {
+      slot->written = millis();
+      slot->everWritten = true;
+    }
+  } else {
+    persistStats.failed++;
+    slot->hashKnown = false;
+    if (slot->data == NULL) { // try again later unless newer content arrived
+      slot->data = data;
+      slot->due = millis() + PERSIST_RETRY;
+      data = NULL;
+    }
+  }
+  PERSIST_UNLOCK();
+  free(data);
+  return written;
+}
+
+// The burst allows a few writes back to back, after that one per refill time
+static void refillBudget(unsigned long now) {
+  if (budget >= PERSIST_BURST) {
+    budgetTime = now;
+    return;
+  }
+  while ((budget < PERSIST_BURST) && ((unsigned long)(now - budgetTime) >= PERSIST_REFILL)) {
+    budget++;
+    budgetTime += PERSIST_REFILL;
+  }
+}
+
+// Writes one file which is due, never while a frame waits for its answer
+static void persistRun() {
+  if (discarded || ((busyCallback != NULL) && busyCallback())) {
+    return;
+  }
+  unsigned long now = millis();
+  PERSIST_WRITE_LOCK();
+  refillBudget(now);
+  persistSlotStruct *due = NULL;
+  PERSIST_LOCK();
+  for (int i = 0; i < PERSIST_SLOTS; i++) {
+    if ((slots[i].data == NULL) || ((long)(now - slots[i].due) < 0)) {
+      continue;
+    }
+    if (budget > 0) {
+      due = &slots[i];
+      break;
+    }
+    if (!slots[i].held) {
+      slots[i].held = true;
+      persistStats.deferred++;
+    }
+  }
+  PERSIST_UNLOCK();
+  if ((due != NULL) && writeSlot(due)) {
+    budget--;
+  }
+  PERSIST_WRITE_UNLOCK();
+}
+
+#if defined(ESP32)
+static void persistTask(void *param) {
+  while (!discarded) {
+    persistRun();
+    vTaskDelay(PERSIST_TASK_INTERVAL / portTICK_PERIOD_MS);
+  }
+  vTaskDelete(NULL);
+}
+#endif
+
+void persistBegin(bool (*busy)()) {
+  busyCallback = busy;
+  persistMount();
+#if defined(ESP32)
+  if (writeMutex == NULL) {
+    writeMutex = xSemaphoreCreateMutex();
+    xTaskCreatePinnedToCore(persistTask, "persistTask", 4096, NULL, 1, NULL, 1);
+  }
+#endif
+}
+
+// On ESP8266 the queued files are written from loop(), the ESP32 has a task
+void persistLoop() {
+#if !defined(ESP32)
+  persistRun();
+#endif
+}
+
+// Writes the queued content now, for a file read back right away or before
+// a restart. A NULL path writes all files.
+void persistFlush(const char *path) {
+  char name[PERSIST_PATH_SIZE];
+  if (path != NULL) {
+    pathName(name, path);
+  }
+  PERSIST_WRITE_LOCK();
+  for (int i = 0; (i < PERSIST_SLOTS) && !discarded; i++) {
+    if ((path != NULL) && (strcmp(slots[i].path, name) != 0)) {
+      continue;
+    }
+    if (writeSlot(&slots[i]) && (budget > 0)) {
+      budget--;
+    }
+  }
+  PERSIST_WRITE_UNLOCK();
+}
+
+// For files too large to queue or written in parts. Returns false while a
+// frame waits for its answer, unless forced, else the write lock is held
+// until persistDirectEnd(). The write uses the budget but is never held back.
+bool persistDirectBegin(bool force) {
+  if (discarded || (!force && (busyCallback != NULL) && busyCallback())) {
+    return false;
+  }
+  if (!persistMount()) {
+    return false;
+  }
+  PERSIST_WRITE_LOCK();
+  if (discarded) {
+    PERSIST_WRITE_UNLOCK();
+    return false;
+  }
+  directStart = millis();
+  refillBudget(directStart);
+  return true;
+}
+
+void persistDirectEnd(size_t written) {
+  unsigned long elapsed = millis() - directStart;
+  PERSIST_LOCK();
+  persistStats.requests++;
+  if (written > 0) {
+    persistStats.writes++;
+    persistStats.bytes += written;
+  } else {
+    persistStats.failed++;
+  }
+  if (elapsed > persistStats.maxTime) {
+    persistStats.maxTime = elapsed;
+  }
+  PERSIST_UNLOCK();
+  if ((written > 0) && (budget > 0)) {
+    budget--;
+  }
+  PERSIST_WRITE_UNLOCK();
+}
+
+// Drops the queued files before a factory reset formats the flash, no file
+// is written after this until the restart. Waits for a write in progress.
+void persistDiscard() {
+  PERSIST_WRITE_LOCK();
+  discarded = true;
+  for (int i = 0; i < PERSIST_SLOTS; i++) {
+    PERSIST_LOCK();
+    byte *data = slots[i].data;
+    slots[i].data = NULL;
+    PERSIST_UNLOCK();
+    free(data);
+  }
+  PERSIST_WRITE_UNLOCK();
+}
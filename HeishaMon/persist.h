@@ -0,0 +1,38 @@
+#ifndef _PERSIST_H_
+#define _PERSIST_H_
+
+#include <Arduino.h>
+
+// Small files are queued in memory and written to LittleFS later, only if
+// their content differs from what is in flash
+#define PERSIST_SLOTS 6 // files which can wait for a write at the same time
+#define PERSIST_PATH_SIZE 24
+#define PERSIST_SETTLE 1000 // ms a queued file waits for newer content before it is written
+#define PERSIST_RETRY 60000 // ms before a failed write is tried again
+#define PERSIST_BURST 8 // writes allowed back to back
+#define PERSIST_REFILL 60000 // ms to earn one more write once the burst is used
+#define PERSIST_TASK_INTERVAL 200 // ms between checks of the write task on ESP32
+
+struct persistStatsStruct {
+  unsigned long requests = 0;
+  unsigned long writes = 0;
+  unsigned long unchanged = 0; // requests equal to the content in flash or already queued
+  unsigned long coalesced = 0; // queued content replaced before it was written
+  unsigned long deferred = 0; // writes held back by the write budget
+  unsigned long failed = 0;
+  unsigned long bytes = 0; // written to flash
+  unsigned long maxTime = 0; // ms of the slowest write
+};
+
+extern persistStatsStruct persistStats;
+
+bool persistMount();
+void persistBegin(bool (*busy)());
+bool persistWrite(const char *path, const void *data, size_t length, unsigned long holdoff);
+void persistLoop();
+void persistFlush(const char *path);
+bool persistDirectBegin(bool force);
+void persistDirectEnd(size_t written);
+void persistDiscard();
+
+#endif
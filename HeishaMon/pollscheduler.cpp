@@ -0,0 +1,176 @@
+#include "pollscheduler.h"
+#include "busmetrics.h"
+
+pollStatsStruct pollStats;
+
+// On ESP32 the query side runs in serialTXTask and the receive side in loop().
+// The transition and the frame in flight are changed by both, they are only
+// used with the lock held. The other variables are written by one side only.
+#if defined(ESP32)
+static portMUX_TYPE pollMux = portMUX_INITIALIZER_UNLOCKED;
+#define POLL_LOCK() portENTER_CRITICAL(&pollMux)
+#define POLL_UNLOCK() portEXIT_CRITICAL(&pollMux)
+#else
+#define POLL_LOCK()
+#define POLL_UNLOCK()
+#endif
+
+static volatile unsigned long lastMainTime = 0;
+static volatile unsigned long lastExtraTime = 0;
+static volatile unsigned long readbackTime = 0;
+static volatile bool readbackPending = false;
+static volatile bool mainSent = false;
+static volatile bool extraSent = false;
+static volatile unsigned long transitionStart = 0;
+static volatile bool transition = false;
+static volatile int8_t inflightType = -1; // frame waiting for its answer
+static volatile unsigned long inflightTime = 0;
+
+static unsigned long utilisationTime = 0;
+static unsigned long utilisationBytes = 0;
+
+static void startTransition(unsigned long now) {
+  POLL_LOCK();
+  transitionStart = now;
+  transition = true;
+  POLL_UNLOCK();
+}
+
+static bool inTransition(unsigned long now) {
+  POLL_LOCK();
+  if (transition && ((unsigned long)(now - transitionStart) >= POLL_TRANSITION_TIME)) {
+    transition = false;
+  }
+  bool result = transition;
+  POLL_UNLOCK();
+  return result;
+}
+
+// interval of the state, without the faster transition rate
+static unsigned long stateInterval(uint16_t waitTime, uint16_t waitTimeIdle) {
+  if ((pollStats.state == POLL_STATE_RUNNING) || (pollStats.state == POLL_STATE_DEFROST)) {
+    return 1000UL * waitTime;
+  }
+  return 1000UL * (waitTimeIdle > waitTime ? waitTimeIdle : waitTime);
+}
+
+// Called with every decoded main block. A compressor start or stop and the
+// begin or end of a defrost switch to the fast rate for a while.
+void pollUpdateState(const byte *data) {
+  uint8_t state = POLL_STATE_IDLE;
+  if (((data[111] >> 2) & 0b11) == 2) { //TOP26 defrosting
+    state = POLL_STATE_DEFROST;
+  } else if (data[166] > 1) { //TOP8 compressor frequency above 0
+    state = POLL_STATE_RUNNING;
+  }
+  if ((pollStats.state != POLL_STATE_UNKNOWN) && (pollStats.state != state)) {
+    pollStats.transitions++;
+    startTransition(millis());
+  }
+  pollStats.state = state;
+}
+
+// Kind of frame, every frame which is no query counts as a command
+uint8_t pollFrameType(const byte *frame, int length) {
+  if (length < 4) {
+    return POLL_FRAME_COMMAND;
+  }
+  if ((frame[0] == 0x71) && (frame[3] == 0x10)) {
+    return POLL_FRAME_MAIN;
+  }
+  if ((frame[0] == 0x71) && (frame[3] == 0x21)) {
+    return POLL_FRAME_EXTRA;
+  }
+  if ((frame[0] == 0xF1) && (frame[1] == 0x11)) {
+    return POLL_FRAME_PCB;
+  }
+  return POLL_FRAME_COMMAND;
+}
+
+// Every frame written to the heatpump passes here, the frame type tells which
+// query was sent or if the settings were changed.
+void pollFrameSent(const byte *frame, int length) {
+  unsigned long now = millis();
+  uint8_t type = pollFrameType(frame, length);
+  pollStats.txBytes += length + 1; //including checksum
+  POLL_LOCK();
+  inflightTime = now;
+  inflightType = type;
+  POLL_UNLOCK();
+  if (type == POLL_FRAME_MAIN) {
+    if (readbackPending) {
+      readbackPending = false;
+      pollStats.readbacks++;
+    }
+    pollStats.mainQueries++;
+    lastMainTime = now;
+    mainSent = true;
+  } else if (type == POLL_FRAME_EXTRA) {
+    pollStats.extraQueries++;
+    lastExtraTime = now;
+    extraSent = true;
+  } else if ((length > 1) && (frame[0] == 0xF1) && (frame[1] == 0x6C)) {
+    // read back the written settings soon and follow the heatpump reacting on them
+    readbackTime = now;
+    readbackPending = true;
+    startTransition(now);
+  }
+}
+
+void pollBytesReceived(unsigned int bytes) {
+  pollStats.rxBytes += bytes;
+}
+
+// A complete answer was received, its first byte arrived at firstByteTime
+void pollFrameReceived(unsigned long firstByteTime) {
+  POLL_LOCK();
+  int8_t type = inflightType;
+  unsigned long sent = inflightTime;
+  inflightType = -1;
+  POLL_UNLOCK();
+  if ((type < 0) || ((long)(firstByteTime - sent) < 0)) {
+    return; //unsolicited or older than the last frame sent
+  }
+  pollRttStruct *rtt = &pollStats.rtt[type];
+  rtt->last = firstByteTime - sent;
+  rtt->avg = (rtt->avg == 0) ? rtt->last : (rtt->avg * 7 + rtt->last) / 8;
+  if (rtt->last > rtt->max) {
+    rtt->max = rtt->last;
+  }
+  busMetricsObserve(type, rtt->last);
+}
+
+bool pollMainDue(uint16_t waitTime, uint16_t waitTimeIdle) {
+  unsigned long now = millis();
+  if (!mainSent) {
+    return true;
+  }
+  if (readbackPending && ((unsigned long)(now - readbackTime) >= POLL_READBACK_DELAY)) {
+    return true;
+  }
+  unsigned long interval = inTransition(now) ? POLL_TRANSITION_INTERVAL : stateInterval(waitTime, waitTimeIdle);
+  return (unsigned long)(now - lastMainTime) >= interval;
+}
+
+// The extra block holds slow changing values, it keeps its own interval and
+// follows the state interval when none is set
+bool pollExtraDue(uint16_t waitTime, uint16_t waitTimeIdle, uint16_t waitTimeExtra) {
+  if (!extraSent) {
+    return true;
+  }
+  unsigned long interval = (waitTimeExtra > 0) ? 1000UL * waitTimeExtra : stateInterval(waitTime, waitTimeIdle);
+  return (unsigned long)(millis() - lastExtraTime) >= interval;
+}
+
+// Bus utilisation from the bytes sent and received since the previous call
+void pollUpdateUtilisation() {
+  unsigned long now = millis();
+  unsigned long bytes = pollStats.txBytes + pollStats.rxBytes;
+  unsigned long elapsed = now - utilisationTime;
+  if (elapsed > 0) {
+    pollStats.utilisation = (float)(bytes - utilisationBytes) * POLL_BYTE_TIME / (elapsed * 10.0);
+    if (pollStats.utilisation > 100) pollStats.utilisation = 100;
+  }
+  utilisationTime = now;
+  utilisationBytes = bytes;
+}
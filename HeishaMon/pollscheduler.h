@@ -0,0 +1,53 @@
+#ifndef _POLLSCHEDULER_H_
+#define _POLLSCHEDULER_H_
+
+#include <Arduino.h>
+
+#define POLL_TRANSITION_INTERVAL 2000 // ms between main block queries during a transition
+#define POLL_TRANSITION_TIME 20000 // ms the fast rate is kept after a state change or a write
+#define POLL_READBACK_DELAY 300 // ms after a write frame before its result is read back
+#define POLL_BYTE_TIME 1146 // us per byte on the 9600 baud 8E1 heatpump line (11 bits)
+
+// frame types a round trip time is kept for
+#define POLL_FRAME_MAIN 0
+#define POLL_FRAME_EXTRA 1
+#define POLL_FRAME_PCB 2
+#define POLL_FRAME_COMMAND 3
+#define POLL_FRAME_TYPES 4
+
+struct pollRttStruct {
+  unsigned long last = 0; // ms from sending a frame to the first byte of its answer
+  unsigned long avg = 0;
+  unsigned long max = 0;
+};
+
+// heatpump states which select the polling rate
+#define POLL_STATE_UNKNOWN 0
+#define POLL_STATE_IDLE 1
+#define POLL_STATE_RUNNING 2
+#define POLL_STATE_DEFROST 3
+
+struct pollStatsStruct {
+  unsigned long mainQueries = 0;
+  unsigned long extraQueries = 0;
+  unsigned long readbacks = 0; // main block queries brought forward by a write frame
+  unsigned long transitions = 0; // compressor start/stop and defrost start/end
+  unsigned long txBytes = 0;
+  unsigned long rxBytes = 0;
+  float utilisation = 0; // % of time the heatpump line carried data since the previous update
+  uint8_t state = POLL_STATE_UNKNOWN;
+  pollRttStruct rtt[POLL_FRAME_TYPES];
+};
+
+extern pollStatsStruct pollStats;
+
+void pollUpdateState(const byte *data);
+uint8_t pollFrameType(const byte *frame, int length);
+void pollFrameSent(const byte *frame, int length);
+void pollBytesReceived(unsigned int bytes);
+void pollFrameReceived(unsigned long firstByteTime);
+bool pollMainDue(uint16_t waitTime, uint16_t waitTimeIdle);
+bool pollExtraDue(uint16_t waitTime, uint16_t waitTimeIdle, uint16_t waitTimeExtra);
+void pollUpdateUtilisation();
+
+#endif
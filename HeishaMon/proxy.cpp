@@ -0,0 +1,104 @@
+#include "proxy.h"
+
+proxyStatsStruct proxyStats;
+
+// Frame on the heatpump line, written by serialTXTask, read by loop()
+static volatile byte inflightBlock = 0; // 0x10 or 0x21 for a data block query
+static volatile bool inflightProxy = false;
+static volatile unsigned long inflightTime = 0;
+
+// CZ-TAW1 reads and forwarded frames waiting for an answer, loop() only
+static bool readPending[2] = { false, false }; // main, extra block
+static unsigned long readSince[2] = { 0, 0 };
+static bool forwardPending = false;
+static unsigned long forwardSince = 0;
+
+static int blockIndex(byte block) {
+  return (block == 0x21) ? 1 : 0;
+}
+
+static void recordLatency(unsigned long since) {
+  unsigned long latency = millis() - since;
+  if (latency > proxyStats.maxLatency) {
+    proxyStats.maxLatency = latency;
+  }
+  proxyStats.avgLatency = (proxyStats.avgLatency * 7 + latency) / 8;
+}
+
+// Every frame written to the heatpump passes here, so an answer can be
+// matched to who asked for it
+void proxyFrameSent(const byte *frame, int length, bool fromProxy) {
+  inflightBlock = ((length > 3) && (frame[0] == 0x71)) ? frame[3] : 0;
+  inflightProxy = fromProxy;
+  inflightTime = millis();
+}
+
+// A read of the main (0x10) or extra (0x21) block by the CZ-TAW1
+uint8_t proxyRead(byte block, unsigned long cacheAge) {
+  int i = blockIndex(block);
+  proxyStats.reads++;
+  if (cacheAge < PROXY_CACHE_FRESH) {
+    proxyStats.cached++;
+    recordLatency(millis());
+    readPending[i] = false; //answered, a read still on the line is not sent again
+    return PROXY_READ_CACHED;
+  }
+  readPending[i] = true;
+  readSince[i] = millis();
+  if ((inflightBlock == block) && ((unsigned long)(millis() - inflightTime) < PROXY_ANSWER_TIMEOUT)) {
+    proxyStats.deduplicated++;
+    return PROXY_READ_WAIT;
+  }
+  proxyStats.polled++;
+  return PROXY_READ_POLL;
+}
+
+// A frame of the CZ-TAW1 other than a data block read is queued for the
+// heatpump, its answer goes back
+void proxyForward() {
+  proxyStats.forwarded++;
+  forwardPending = true;
+  forwardSince = millis();
+}
+
+// Called with every complete frame from the heatpump. Returns true if the
+// CZ-TAW1 waits for it.
+bool proxyAnswer(const byte *frame, int length) {
+  bool forward = false;
+  bool blockRead = (inflightBlock == 0x10) || (inflightBlock == 0x21); // a polled read, answered below
+  if (inflightProxy && forwardPending && !blockRead) {
+    forwardPending = false;
+    recordLatency(forwardSince);
+    forward = true;
+  }
+  if ((length > 3) && (frame[0] == 0x71)) {
+    int i = blockIndex(frame[3]);
+    if (((frame[3] == 0x10) || (frame[3] == 0x21)) && readPending[i]) {
+      readPending[i] = false;
+      recordLatency(readSince[i]);
+      forward = true;
+    }
+  }
+  inflightBlock = 0;
+  inflightProxy = false;
+  return forward;
+}
+
+// Returns the block of a CZ-TAW1 read that waited too long and is answered
+// from the cache now, 0 if none. Forwarded frames without answer are dropped.
+byte proxyExpired() {
+  unsigned long now = millis();
+  if (forwardPending && ((unsigned long)(now - forwardSince) > PROXY_ANSWER_TIMEOUT)) {
+    forwardPending = false;
+    proxyStats.timeouts++;
+  }
+  for (int i = 0; i < 2; i++) {
+    if (readPending[i] && ((unsigned long)(now - readSince[i]) > PROXY_MAX_WAIT)) {
+      readPending[i] = false;
+      proxyStats.late++;
+      recordLatency(readSince[i]);
+      return (i == 1) ? 0x21 : 0x10;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,36 @@
+#ifndef _PROXY_H_
+#define _PROXY_H_
+
+#include <Arduino.h>
+
+#define PROXY_QUEUE_SIZE 4 // frames of the CZ-TAW1 waiting for the heatpump line
+#define PROXY_CACHE_FRESH 3000 // ms a cached data block is answered to a CZ-TAW1 read at once
+#define PROXY_MAX_WAIT 1000 // ms a CZ-TAW1 read waits for a fresh block before the cache is answered
+#define PROXY_ANSWER_TIMEOUT 2000 // ms a forwarded frame waits for the heatpump, same as SERIALTIMEOUT
+
+// what to do with a CZ-TAW1 read of a data block
+#define PROXY_READ_CACHED 0 // answer the cached block now
+#define PROXY_READ_WAIT   1 // a read of the block is on the line, its answer goes to the CZ-TAW1 too
+#define PROXY_READ_POLL   2 // queue a query for the block, its answer goes to the CZ-TAW1
+
+struct proxyStatsStruct {
+  unsigned long reads = 0; // data block reads of the CZ-TAW1
+  unsigned long cached = 0; // answered from a fresh cached block
+  unsigned long deduplicated = 0; // answered by a read that was already on the line
+  unsigned long polled = 0; // needed an own query
+  unsigned long late = 0; // answered from the cache after PROXY_MAX_WAIT
+  unsigned long forwarded = 0; // other frames sent to the heatpump
+  unsigned long timeouts = 0; // forwarded frames the heatpump did not answer
+  unsigned long maxLatency = 0; // ms between receiving from and answering to the CZ-TAW1
+  unsigned long avgLatency = 0;
+};
+
+extern proxyStatsStruct proxyStats;
+
+void proxyFrameSent(const byte *frame, int length, bool fromProxy);
+uint8_t proxyRead(byte block, unsigned long cacheAge);
+void proxyForward();
+bool proxyAnswer(const byte *frame, int length);
+byte proxyExpired();
+
+#endif
@@ -0,0 +1,194 @@
+#include "rawframes.h"
+
+// Runs of changed bytes closer than this are joined, a run costs 2 bytes
+#define RAWFRAMES_RUN_GAP 2
+
+static uint8_t frameKind(bool tx, const byte *frame, int length) {
+  if (length < 4) {
+    return RAWFRAMES_OTHER;
+  }
+  if ((frame[0] == 0x71) && (frame[3] == 0x10)) {
+    return RAWFRAMES_MAIN; // query and answer of the main block
+  }
+  if ((frame[0] == 0x71) && (frame[3] == 0x21)) {
+    return RAWFRAMES_EXTRA;
+  }
+  if (tx ? ((frame[0] == 0xF1) && (frame[1] == 0x11)) : ((frame[0] == 0x71) && (frame[3] == 0x50))) {
+    return RAWFRAMES_PCB;
+  }
+  return RAWFRAMES_OTHER;
+}
+
+static void put32(byte *out, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out[i] = (value >> (8 * i)) & 0xFF;
+  }
+}
+
+static uint32_t get32(const byte *in) {
+  return in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+void rawFramesReset(struct rawFramesStruct *state, unsigned long time) {
+  memset(state->prevLength, 0, sizeof(state->prevLength));
+  state->lastTime = time;
+}
+
+int rawFramesHeader(byte *out, const struct rawFramesHeaderStruct *header) {
+  memcpy(out, RAWFRAMES_MAGIC, 4);
+  out[4] = RAWFRAMES_VERSION;
+  out[5] = out[6] = out[7] = 0;
+  put32(&out[8], header->sequence);
+  put32(&out[12], header->millis);
+  put32(&out[16], header->unixTime);
+  return RAWFRAMES_HEADER_SIZE;
+}
+
+bool rawFramesParseHeader(const byte *in, int length, struct rawFramesHeaderStruct *header) {
+  if ((length < RAWFRAMES_HEADER_SIZE) || (memcmp(in, RAWFRAMES_MAGIC, 4) != 0) || (in[4] != RAWFRAMES_VERSION)) {
+    return false;
+  }
+  header->sequence = get32(&in[8]);
+  header->millis = get32(&in[12]);
+  header->unixTime = get32(&in[16]);
+  return true;
+}
+
+// Writes one record to out (room for RAWFRAMES_RECORD_MAX) and returns its size
+int rawFramesEncode(struct rawFramesStruct *state, byte *out, bool tx, const byte *frame, int length, unsigned long time) {
+  if ((length <= 0) || (length > RAWFRAMES_MAX_FRAME)) {
+    return 0;
+  }
+  uint8_t kind = frameKind(tx, frame, length);
+  uint8_t slot = (tx ? 4 : 0) + kind;
+  byte *prev = state->prev[slot];
+  int pos = 1;
+
+  unsigned long delta = time - state->lastTime;
+  state->lastTime = time;
+  do {
+    out[pos++] = (delta & 0x7F) | ((delta > 0x7F) ? 0x80 : 0);
+    delta >>= 7;
+  } while (delta > 0);
+
+  bool full = true;
+  if (state->prevLength[slot] == length) {
+    // the runs go behind a run count, which is filled in at the end
+    int start = pos++;
+    int runs = 0;
+    int i = 0;
+    while (i < length) {
+      if (frame[i] == prev[i]) {
+        i++;
+        continue;
+      }
+      int end = i + 1;
+      int same = 0;
+      while ((end + same < length) && (same <= RAWFRAMES_RUN_GAP)) {
+        if (frame[end + same] != prev[end + same]) {
+          end += same + 1;
+          same = 0;
+        } else {
+          same++;
+        }
+      }
+      if (pos + 2 + (end - i) > start + 1 + length) {
+        break; // not smaller than the full frame
+      }
+      out[pos++] = i;
+      out[pos++] = end - i;
+      memcpy(&out[pos], &frame[i], end - i);
+      pos += end - i;
+      runs++;
+      i = end;
+    }
+    if (i >= length) {
+      out[start] = runs;
+      full = false;
+    } else {
+      pos = start;
+    }
+  }
+  if (full) {
+    out[pos++] = length;
+    memcpy(&out[pos], frame, length);
+    pos += length;
+  }
+  out[0] = (tx ? RAWFRAMES_TX : 0) | (kind << 4) | (full ? RAWFRAMES_FULL : 0);
+  memcpy(prev, frame, length);
+  state->prevLength[slot] = length;
+  return pos;
+}
+
+// Reads one record, returns the bytes used, 0 if the record is not complete
+// yet or -1 if the data is not a valid record
+int rawFramesDecode(struct rawFramesStruct *state, const byte *in, int length, bool *tx, byte *frame, int *frameLength, unsigned long *time) {
+  if (length < 3) {
+    return 0;
+  }
+  byte head = in[0];
+  uint8_t kind = (head >> 4) & 0x07;
+  if ((head & 0x07) || (kind > RAWFRAMES_OTHER)) {
+    return -1;
+  }
+  uint8_t slot = ((head & RAWFRAMES_TX) ? 4 : 0) + kind;
+  int pos = 1;
+  unsigned long delta = 0;
+  for (int shift = 0;; shift += 7) {
+    if (pos >= length) {
+      return 0;
+    }
+    if (shift > 28) {
+      return -1;
+    }
+    delta |= (unsigned long)(in[pos] & 0x7F) << shift;
+    if ((in[pos++] & 0x80) == 0) {
+      break;
+    }
+  }
+  if (pos >= length) {
+    return 0;
+  }
+  byte *prev = state->prev[slot];
+  if (head & RAWFRAMES_FULL) {
+    int size = in[pos++];
+    if (size == 0) {
+      return -1;
+    }
+    if (pos + size > length) {
+      return 0;
+    }
+    memcpy(prev, &in[pos], size);
+    pos += size;
+    state->prevLength[slot] = size;
+  } else {
+    if (state->prevLength[slot] == 0) {
+      return -1; // delta without a frame to apply it to
+    }
+    int runs = in[pos++];
+    // check the whole record before the frame is changed
+    int check = pos;
+    for (int run = 0; run < runs; run++) {
+      if (check + 2 > length) {
+        return 0;
+      }
+      if (in[check] + in[check + 1] > state->prevLength[slot]) {
+        return -1;
+      }
+      check += 2 + in[check + 1];
+      if (check > length) {
+        return 0;
+      }
+    }
+    for (int run = 0; run < runs; run++) {
+      memcpy(&prev[in[pos]], &in[pos + 2], in[pos + 1]);
+      pos += 2 + in[pos + 1];
+    }
+  }
+  state->lastTime += delta;
+  *tx = (head & RAWFRAMES_TX) != 0;
+  *frameLength = state->prevLength[slot];
+  memcpy(frame, prev, *frameLength);
+  *time = state->lastTime;
+  return pos;
+}
@@ -0,0 +1,49 @@
+#ifndef _RAWFRAMES_H_
+#define _RAWFRAMES_H_
+
+#include <Arduino.h>
+
+// Compact format of recorded heatpump frames. A segment starts with a header,
+// every record after it holds one frame:
+//   head     bit 7 sent by us, bits 6-4 frame kind, bit 3 full frame
+//   time     ms since the previous record (or the header), LEB128
+//   full     length, frame bytes
+//   delta    run count, per run: offset, length, bytes
+// A delta holds the bytes which changed since the previous frame of the same
+// direction and kind, which must have the same length.
+#define RAWFRAMES_MAGIC "HMRF"
+#define RAWFRAMES_VERSION 1
+#define RAWFRAMES_HEADER_SIZE 20 // magic, version, 3 reserved, sequence, millis, unix time
+#define RAWFRAMES_MAX_FRAME 255
+#define RAWFRAMES_RECORD_MAX (1 + 5 + 1 + RAWFRAMES_MAX_FRAME) // a full frame
+#define RAWFRAMES_SLOTS 8 // direction * frame kinds
+
+#define RAWFRAMES_TX   0x80
+#define RAWFRAMES_FULL 0x08
+
+// frame kinds
+#define RAWFRAMES_MAIN  0
+#define RAWFRAMES_EXTRA 1
+#define RAWFRAMES_PCB   2
+#define RAWFRAMES_OTHER 3
+
+// Encoder or decoder state, the last frame of each slot
+struct rawFramesStruct {
+  byte prev[RAWFRAMES_SLOTS][RAWFRAMES_MAX_FRAME];
+  uint8_t prevLength[RAWFRAMES_SLOTS] = {}; // 0 if the slot has no frame yet
+  unsigned long lastTime = 0;
+};
+
+struct rawFramesHeaderStruct {
+  uint32_t sequence = 0; // counts the segments written
+  uint32_t millis = 0; // uptime the segment was started
+  uint32_t unixTime = 0; // 0 if the clock was not set
+};
+
+void rawFramesReset(struct rawFramesStruct *state, unsigned long time);
+int rawFramesHeader(byte *out, const struct rawFramesHeaderStruct *header);
+bool rawFramesParseHeader(const byte *in, int length, struct rawFramesHeaderStruct *header);
+int rawFramesEncode(struct rawFramesStruct *state, byte *out, bool tx, const byte *frame, int length, unsigned long time);
+int rawFramesDecode(struct rawFramesStruct *state, const byte *in, int length, bool *tx, byte *frame, int *frameLength, unsigned long *time);
+
+#endif
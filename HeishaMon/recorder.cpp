@@ -0,0 +1,216 @@
+#include "recorder.h"
+#include <LittleFS.h>
+#include "persist.h"
+#include <time.h>
+
+recorderStatsStruct recorderStats;
+
+// Frames are encoded into the buffer by loop() and on ESP32 also by
+// serialTXTask, loop() writes the buffer to flash through persistDirectBegin()
+#if defined(ESP32)
+static portMUX_TYPE recorderMux = portMUX_INITIALIZER_UNLOCKED;
+#define RECORDER_LOCK() portENTER_CRITICAL(&recorderMux)
+#define RECORDER_UNLOCK() portEXIT_CRITICAL(&recorderMux)
+#else
+#define RECORDER_LOCK()
+#define RECORDER_UNLOCK()
+#endif
+
+// only allocated while recording
+static struct rawFramesStruct *encoder = NULL;
+static byte *buffer = NULL; // encoded records
+static byte *flushData = NULL; // copy of the buffer being written to flash
+static int fill = 0;
+static int segmentBreak = -1; // position of a new segment header in the buffer
+static unsigned long segmentUsed = RECORDER_SEGMENT_SIZE; // full, so the first frame starts a segment
+static uint32_t sequence = 0; // of the segment being encoded
+static uint32_t writeSequence = 0; // of the segment being written to flash
+static uint32_t segmentSequence[RECORDER_SEGMENTS];
+static bool segmentExists[RECORDER_SEGMENTS];
+static unsigned long lastFlush = 0;
+
+static void segmentName(char *name, uint32_t seq) {
+  sprintf_P(name, PSTR("/rawframes%u.bin"), (unsigned int)(seq % RECORDER_SEGMENTS));
+}
+
+// Finds the segments of earlier runs, recording continues behind the newest
+void recorderBegin(bool enable) {
+  if (!persistMount()) {
+    return;
+  }
+  uint32_t newest = 0;
+  bool found = false;
+  for (uint32_t i = 0; i < RECORDER_SEGMENTS; i++) {
+    char name[24];
+    segmentName(name, i);
+    segmentExists[i] = false;
+    File file = LittleFS.open(name, "r");
+    if (!file) {
+      continue;
+    }
+    byte data[RAWFRAMES_HEADER_SIZE];
+    struct rawFramesHeaderStruct header;
+    if ((file.read(data, sizeof(data)) == sizeof(data)) && rawFramesParseHeader(data, sizeof(data), &header) && ((header.sequence % RECORDER_SEGMENTS) == i)) {
+      segmentExists[i] = true;
+      segmentSequence[i] = header.sequence;
+      if (!found || ((int32_t)(header.sequence - newest) > 0)) {
+        newest = header.sequence;
+        found = true;
+      }
+    }
+    file.close();
+  }
+  sequence = found ? newest : (uint32_t)-1;
+  writeSequence = sequence;
+  segmentUsed = RECORDER_SEGMENT_SIZE; // start a new segment with the next frame
+  if (enable && (encoder == NULL)) {
+    buffer = (byte *)malloc(RECORDER_BUFFER_SIZE);
+    flushData = (byte *)malloc(RECORDER_BUFFER_SIZE);
+    if ((buffer == NULL) || (flushData == NULL)) {
+      free(buffer);
+      free(flushData);
+      buffer = NULL;
+      flushData = NULL;
+      return;
+    }
+    encoder = new rawFramesStruct;
+  }
+}
+
+// Called with every frame sent to or received from the heatpump
+void recorderFrame(bool tx, const byte *frame, int length) {
+  if (encoder == NULL) {
+    return;
+  }
+  unsigned long now = millis();
+  time_t unixTime = time(NULL);
+  RECORDER_LOCK();
+  int needed = RAWFRAMES_RECORD_MAX;
+  bool newSegment = (segmentUsed + RAWFRAMES_RECORD_MAX > RECORDER_SEGMENT_SIZE);
+  if (newSegment) {
+    needed += RAWFRAMES_HEADER_SIZE;
+  }
+  if ((fill + needed > RECORDER_BUFFER_SIZE) || (newSegment && (segmentBreak >= 0))) {
+    recorderStats.dropped++; // the encoder did not see it, the records stay consistent
+    RECORDER_UNLOCK();
+    return;
+  }
+  if (newSegment) {
+    struct rawFramesHeaderStruct header;
+    header.sequence = ++sequence;
+    header.millis = now;
+    header.unixTime = (unixTime > 1600000000) ? (uint32_t)unixTime : 0; // clock set by ntp
+    segmentBreak = fill;
+    fill += rawFramesHeader(&buffer[fill], &header);
+    segmentUsed = RAWFRAMES_HEADER_SIZE;
+    rawFramesReset(encoder, now); // a segment can be decoded without the previous ones
+  }
+  int size = rawFramesEncode(encoder, &buffer[fill], tx, frame, length, now);
+  fill += size;
+  segmentUsed += size;
+  recorderStats.frames++;
+  recorderStats.bytes += length;
+  RECORDER_UNLOCK();
+}
+
+static void writeSegment(const byte *data, int length, bool create) {
+  if (length <= 0) {
+    return;
+  }
+  char name[24];
+  segmentName(name, writeSequence);
+  File file = LittleFS.open(name, create ? "w" : "a");
+  if (!file) {
+    return;
+  }
+  recorderStats.written += file.write(data, length);
+  file.close();
+  if (create) {
+    segmentExists[writeSequence % RECORDER_SEGMENTS] = true;
+    segmentSequence[writeSequence % RECORDER_SEGMENTS] = writeSequence;
+  }
+}
+
+// Write the buffered records, a started segment replaces the oldest file
+static void flushBuffer(bool force) {
+  byte *data = flushData;
+  if (fill == 0) {
+    lastFlush = millis();
+    return;
+  }
+  if (!persistDirectBegin(force)) {
+    return; // the line is busy, try again with the next loop
+  }
+  RECORDER_LOCK();
+  int length = fill;
+  int split = segmentBreak;
+  memcpy(data, buffer, length);
+  fill = 0;
+  segmentBreak = -1;
+  RECORDER_UNLOCK();
+  lastFlush = millis();
+  unsigned long written = recorderStats.written;
+  if (split < 0) {
+    writeSegment(data, length, false);
+  } else {
+    writeSegment(data, split, false);
+    struct rawFramesHeaderStruct header;
+    rawFramesParseHeader(&data[split], length - split, &header);
+    writeSequence = header.sequence;
+    writeSegment(&data[split], length - split, true);
+  }
+  persistDirectEnd(recorderStats.written - written);
+  recorderStats.flushes++;
+}
+
+void recorderFlush() {
+  flushBuffer(true);
+}
+
+// Few large writes spare the flash, the buffer is written once it is nearly
+// full or a while after the previous write
+void recorderLoop() {
+  if ((encoder == NULL) || (fill == 0)) {
+    return;
+  }
+  if ((fill >= RECORDER_FLUSH_SIZE) || ((unsigned long)(millis() - lastFlush) >= RECORDER_FLUSH_TIME)) {
+    flushBuffer(false);
+  }
+}
+
+// Reads the segments as one stream, oldest first. Returns the bytes read,
+// 0 at the end.
+int recorderRead(unsigned long offset, byte *buf, int size) {
+  uint8_t order[RECORDER_SEGMENTS];
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < RECORDER_SEGMENTS; i++) {
+    if (!segmentExists[i]) {
+      continue;
+    }
+    uint8_t pos = count++;
+    while ((pos > 0) && ((int32_t)(segmentSequence[order[pos - 1]] - segmentSequence[i]) > 0)) {
+      order[pos] = order[pos - 1];
+      pos--;
+    }
+    order[pos] = i;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    char name[24];
+    segmentName(name, segmentSequence[order[i]]);
+    File file = LittleFS.open(name, "r");
+    if (!file) {
+      continue;
+    }
+    unsigned long fileSize = file.size();
+    if (offset >= fileSize) {
+      offset -= fileSize;
+      file.close();
+      continue;
+    }
+    file.seek(offset);
+    int length = file.read(buf, size);
+    file.close();
+    return (length > 0) ? length : 0;
+  }
+  return 0;
+}
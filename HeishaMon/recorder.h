@@ -0,0 +1,35 @@
+#ifndef _RECORDER_H_
+#define _RECORDER_H_
+
+#include <Arduino.h>
+#include "rawframes.h"
+
+// Raw frames on the heatpump line are recorded to rotating LittleFS segments
+#define RECORDER_SEGMENTS 4
+#if defined(ESP8266)
+#define RECORDER_SEGMENT_SIZE 32768 // bytes per segment file
+#else
+#define RECORDER_SEGMENT_SIZE 65536
+#endif
+#define RECORDER_BUFFER_SIZE 1024 // encoded records waiting for the flash
+#define RECORDER_FLUSH_SIZE (RECORDER_BUFFER_SIZE - 2 * RAWFRAMES_RECORD_MAX) // buffered bytes which start a flash write
+#define RECORDER_FLUSH_TIME 300000 // ms at most between flash writes
+#define RECORDER_CHUNK_SIZE 512 // bytes per webserver loop for the download
+
+struct recorderStatsStruct {
+  unsigned long frames = 0;
+  unsigned long bytes = 0; // frame bytes recorded
+  unsigned long written = 0; // bytes written to flash
+  unsigned long flushes = 0;
+  unsigned long dropped = 0; // frames lost because the buffer was full
+};
+
+extern recorderStatsStruct recorderStats;
+
+void recorderBegin(bool enable);
+void recorderFrame(bool tx, const byte *frame, int length);
+void recorderLoop();
+void recorderFlush();
+int recorderRead(unsigned long offset, byte *buf, int size);
+
+#endif
@@ -27,23 +27,20 @@
 #include "decode.h"
 #include "HeishaOT.h"
 #include "commands.h"
+#include "persist.h"
 
 #define MAXCOMMANDSINBUFFER 10
 #define OPTDATASIZE 20
 
-bool send_command(byte* command, int length);
+bool send_setting_command(byte* command, int length);
 #ifdef ESP32
 extern QueueHandle_t pcbQueue;
 #endif
 
-extern int dallasDevicecount;
-extern dallasDataStruct *actDallasData;
 extern settingsStruct heishamonSettings;
 extern char actData[DATASIZE];
 extern char actOptData[OPTDATASIZE];
 extern char actDataExtra[DATASIZE];
-extern volatile s0DataStruct actS0Data[];
-extern volatile s0SettingsStruct actS0Settings[];
 
 extern String openTherm[2];
 static uint8_t parsing = 0;
@@ -123,18 +120,16 @@ static int8_t is_variable(char *text, uint16_t size) {
 
   if(size == strlen_P(PSTR("ds18b20#2800000000000000")) && strncmp_P(text, PSTR("ds18b20#"), 8) == 0) {
     return 24;
-  } else if(strncmp_P(text, PSTR("s0#"), 3) == 0) {
-    if((size == strlen_P(PSTR("s0#watt_1")) && strncmp_P(&text[3], PSTR("watt_"), 5) == 0) ||
-       (size == strlen_P(PSTR("s0#watt_2")) && strncmp_P(&text[3], PSTR("watt_"), 5) == 0)) {
-        return size;
-    }
-    if((size == strlen_P(PSTR("s0#watthour_1")) && strncmp_P(&text[3], PSTR("watthour_"), 9) == 0) ||
-       (size == strlen_P(PSTR("s0#watthour_2")) && strncmp_P(&text[3], PSTR("watthour_"), 9) == 0)) {
-        return size;
+  } else if(size > 5 && size < 9 && strncmp_P(text, PSTR("gpio#"), 5) == 0) {
+    for(x=5;x<size;x++) {
+      if(!isdigit(text[x])) {
+        return -1;
+      }
     }
-    if((size == strlen_P(PSTR("s0#watthourtotal_1")) && strncmp_P(&text[3], PSTR("watthourtotal_"), 14) == 0) ||
-       (size == strlen_P(PSTR("s0#watthourtotal_2")) && strncmp_P(&text[3], PSTR("watthourtotal_"), 14) == 0)) {
-        return size;
+    return size;
+  } else if(strncmp_P(text, PSTR("s0#"), 3) == 0) {
+    if(s0RulesVariable(text, size) > 0) {
+      return size;
     }
   } else if(text[0] == '$' || text[0] == '#' || text[0] == '@' || text[0] == '%' || text[0] == '?') {
     while(isalnum(text[i])) {
@@ -341,13 +336,9 @@ static int8_t is_event(char *text, uint16_t size) {
     return 24;
   }
 
-if(strncmp(text, "s0#", 3) == 0 && (size == 9 || size == 13 || size == 18)) {
-    char port = text[size - 1];  // last char is the port digit
-    if(port != '1' && port != '2') return -1;
-    if(size == 9  && strnicmp(&text[3], "watt_", 5) == 0)          return size;
-    if(size == 13 && strnicmp(&text[3], "watthour_", 9) == 0)      return size;
-    if(size == 18 && strnicmp(&text[3], "watthourtotal_", 14) == 0) return size;
-}
+  if(strncmp(text, "s0#", 3) == 0 && s0RulesVariable(text, size) > 0) {
+    return size;
+  }
 
 // Custom event. Make sure it is in a valid format
   if(isalpha(text[0]) || text[0] == '_') {
@@ -460,36 +451,26 @@ static int8_t vm_value_get(struct rules_t *obj) {
       return 0;
     }
   } else if(strnicmp((const char *)key, _F("ds18b20#"), 8) == 0) {
-    uint8_t i = 0;
-    for(i=0;i<dallasDevicecount;i++) {
-      if(strncmp(actDallasData[i].address, (const char *)&key[8], 16) == 0) {
-        rules_pushfloat(actDallasData[i].temperature);
-        return 0;
-      }
+    float temperature = 0;
+    if(getDallasTemperature((const char *)&key[8], &temperature)) {
+      rules_pushfloat(temperature);
+      return 0;
     }
     rules_pushnil();
     return 0;
-} else if(strnicmp((const char *)key, "s0#", 3) == 0) {
-    // Port digit is last character; valid sizes are 9, 13, 18
-    size_t klen = strlen(key);
-    if(klen != 9 && klen != 13 && klen != 18) { rules_pushnil(); return 0; }
-
-    char portChar = key[klen - 1];
-    if(portChar != '1' && portChar != '2') { rules_pushnil(); return 0; }
-    uint8_t idx = portChar - '1';  // '1'->0, '2'->1
-
-    if(klen == 9 && strnicmp(&key[3], "watt_", 5) == 0) {
-
-        rules_pushfloat((float)actS0Data[idx].watt);
-        return 0;
-    }
-    if(klen == 13 && strnicmp(&key[3], "watthour_", 9) == 0) {
-        rules_pushfloat(actS0Data[idx].pulses * (1000.0 / actS0Settings[idx].ppkwh));
-        return 0;
+  } else if(strnicmp((const char *)key, _F("gpio#"), 5) == 0) {
+    int state = gpioInputState(atoi(&key[5]));
+    if(state >= 0) {
+      rules_pushinteger(state);
+      return 0;
     }
-    if(klen == 18 && strnicmp(&key[3], "watthourtotal_", 14) == 0) {
-        rules_pushfloat(actS0Data[idx].pulsesTotal * (1000.0 / actS0Settings[idx].ppkwh));
-        return 0;
+    rules_pushnil();
+    return 0;
+  } else if(strnicmp((const char *)key, "s0#", 3) == 0) {
+    float value = 0;
+    if(s0RulesValue((const char *)key, strlen(key), &value)) {
+      rules_pushfloat(value);
+      return 0;
     }
     rules_pushnil();
     return 0;
@@ -677,7 +658,7 @@ static int8_t vm_value_set(struct rules_t *obj) {
         if(stricmp((char *)&key[1], tmp.name) == 0) {
           uint16_t len = tmp.func(payload, cmd, log_msg);
           log_message(log_msg);
-          send_command(cmd, len);
+          send_setting_command(cmd, len);
           break;
         }
       }
@@ -896,7 +877,7 @@ void rules_timer_cb(int nr) {
 }
 
 void rules_setup(void) {
-  if(!LittleFS.begin()) {
+  if(!persistMount()) {
     return;
   }
     if (rule_options.event_cb == NULL) { //check if not initialized before
@@ -927,7 +908,7 @@ void rules_setup(void) {
 }
 
 bool existsRulesFile(char *file) {
-  if (LittleFS.begin() && (LittleFS.exists(file))) {
+  if (persistMount() && (LittleFS.exists(file))) {
     File f = LittleFS.open(file, "r");
     if ((f) && (f.size() > 0)) {
       f.close();
@@ -2,122 +2,198 @@
 #include "commands.h"
 #include "s0.h"
 #include "rules.h"
+#include "mqttqueue.h"
 
 #define MQTT_RETAIN_VALUES 1 // do we retain 1wire values?
 
-#define MINREPORTEDS0TIME 5000 // how often s0 Watts are reported (not faster than this)
-
 //global array for s0 data
-volatile s0DataStruct actS0Data[NUM_S0_COUNTERS];
+s0DataStruct actS0Data[NUM_S0_COUNTERS];
 
 //global array for s0 Settings
-volatile s0SettingsStruct actS0Settings[NUM_S0_COUNTERS];
+s0SettingsStruct actS0Settings[NUM_S0_COUNTERS];
 
+//pulses seen by the interrupt routines, taken from it in s0Loop
+volatile s0RingStruct s0Ring[NUM_S0_COUNTERS];
 
 //These are the interrupt routines. Make them as short as possible so we don't block main code
 volatile unsigned long lastEdgeS0[NUM_S0_COUNTERS] = {0, 0};
 volatile bool badEdge[NUM_S0_COUNTERS] = {0, 0}; //two edges is a pulse, so store as bool
 
-//for debug
-/*
-  volatile unsigned long allLastEdgeS0[2][20];
-  volatile int allLastEdgeS0Index[2] = {0, 0};
-*/
-
 IRAM_ATTR void countPulse(int i) {
-  volatile unsigned long newEdgeS0 = millis();
-  volatile unsigned long curPulseWidth = newEdgeS0 - lastEdgeS0[i];
-  // debug
-  /*
-    if (allLastEdgeS0Index[i] < 20) {
-    allLastEdgeS0[i][allLastEdgeS0Index[i]] = curPulseWidth;
-    allLastEdgeS0Index[i]++;
-    }
-  */
-  // end debug
+  unsigned long newEdgeS0 = millis();
+  unsigned long curPulseWidth = newEdgeS0 - lastEdgeS0[i];
   if ((curPulseWidth >=  actS0Settings[i].minimalPulseWidth) && (curPulseWidth <= actS0Settings[i].maximalPulseWidth) ) {
-    if (actS0Data[i].lastPulse > 0) { //Do not calculate watt for the first pulse since reboot because we will always report a too high watt. Better to show 0 watt at first pulse.
-      volatile unsigned long pulseInterval = newEdgeS0 - actS0Data[i].lastPulse; //calculate the interval between last valid pulse edge and this edge
-      actS0Data[i].watt = (3600000000.0 / pulseInterval) / actS0Settings[i].ppkwh;
-      if ((unsigned long)(actS0Data[i].nextReport - newEdgeS0) > MINREPORTEDS0TIME) { //pulse seen in standby interval so report directly
-        actS0Data[i].nextReport = 0; // report now
-      }
-    }
-    actS0Data[i].lastPulse = newEdgeS0; // store this edge to compare in next pulses for valid pulse and calculate watt
-    actS0Data[i].pulses++;
-    actS0Data[i].pulsesTotal++;
-    actS0Data[i].goodPulses++;
-    actS0Data[i].avgPulseWidth = ((actS0Data[i].avgPulseWidth * (actS0Data[i].goodPulses - 1)) + curPulseWidth ) / actS0Data[i].goodPulses;
+    uint32_t head = s0Ring[i].head;
+    s0Ring[i].time[head % S0_RING_SIZE] = newEdgeS0;
+    s0Ring[i].width[head % S0_RING_SIZE] = curPulseWidth;
+    s0Ring[i].head = head + 1; //publish the entry after it is written
     badEdge[i] = false; //set it to false again to allow to count two bad edges as a new bad pulse because we know we had a good pulse now
   } else {
-    if (badEdge[i]) actS0Data[i].badPulses++; //there was already an edge before so count this one as a bad pulse
+    if (badEdge[i]) s0Ring[i].badPulses++; //there was already an edge before so count this one as a bad pulse
     badEdge[i] = !badEdge[i]; //for now count it as a bad edge (if it is a edge for a good pulse, this will reset to false a few lines above). The bool is for not counting each edge as a bad pulse, but only two bad edges.
   }
   lastEdgeS0[i] = newEdgeS0; //store this edge time for next use
 }
 
-IRAM_ATTR void onS0Pulse1Change() {
-  countPulse(0); //port 1, index 0 of array
+//one interrupt routine for all ports, the port index is its argument
+IRAM_ATTR void onS0PulseChange(void* port) {
+  countPulse((int)(intptr_t)port);
+}
+
+// Takes the new pulses of port i from the ring
+static void takeS0Pulses(int i, unsigned long now) {
+  uint32_t head = s0Ring[i].head;
+  if (head == actS0Data[i].tail) return;
+  if ((head - actS0Data[i].tail) > S0_RING_SIZE) { //only the timestamps are lost, the pulses still count
+    unsigned int lost = (head - actS0Data[i].tail) - S0_RING_SIZE;
+    actS0Data[i].pulses += lost;
+    actS0Data[i].pulsesTotal += lost;
+    actS0Data[i].goodPulses += lost;
+    actS0Data[i].tail = head - S0_RING_SIZE;
+  }
+  while (actS0Data[i].tail != head) {
+    unsigned int width = s0Ring[i].width[actS0Data[i].tail % S0_RING_SIZE];
+    actS0Data[i].lastPulse = s0Ring[i].time[actS0Data[i].tail % S0_RING_SIZE];
+    actS0Data[i].pulses++;
+    actS0Data[i].pulsesTotal++;
+    actS0Data[i].goodPulses++;
+    actS0Data[i].avgPulseWidth += ((long)width - (long)actS0Data[i].avgPulseWidth) / (long)actS0Data[i].goodPulses;
+    actS0Data[i].tail++;
+  }
+  actS0Data[i].badPulses = s0Ring[i].badPulses;
+  unsigned long reportInterval = 1000UL * actS0Settings[i].reportInterval;
+  if ((actS0Data[i].goodPulses > 1) && ((unsigned long)(actS0Data[i].nextReport - now) > reportInterval)) { //pulse seen in standby interval so report directly
+    actS0Data[i].nextReport = now; // report now
+  }
 }
 
-IRAM_ATTR void onS0Pulse2Change() {
-  countPulse(1); //port 2, index 1 of array
+// The power from the pulses of the last S0_WINDOW ms, at least the last two.
+// The pulse interval is the least squares slope of the pulse times against
+// their number, so a single late or early pulse moves it only a little.
+static unsigned int s0WindowWatt(int i, unsigned long now) {
+  uint32_t head = actS0Data[i].tail; //all pulses up to here are taken
+  uint32_t available = (head > S0_RING_SIZE) ? S0_RING_SIZE : head;
+  uint32_t n = 0;
+  while ((n < available) && ((n < 2) || ((unsigned long)(now - s0Ring[i].time[(head - n - 1) % S0_RING_SIZE]) <= S0_WINDOW))) {
+    n++;
+  }
+  if (n < 2) return 0; //Do not calculate watt for the first pulse since reboot because we will always report a too high watt. Better to show 0 watt at first pulse.
+
+  uint32_t first = head - n;
+  unsigned long firstTime = s0Ring[i].time[first % S0_RING_SIZE];
+  float middle = (n - 1) / 2.0;
+  float sum = 0;
+  for (uint32_t k = 0; k < n; k++) {
+    sum += (k - middle) * (float)(s0Ring[i].time[(first + k) % S0_RING_SIZE] - firstTime);
+  }
+  float pulseInterval = sum * 12.0 / ((float)n * ((float)n * n - 1)); //ms per pulse
+  if (pulseInterval < 1.0) pulseInterval = 1.0;
+  return (3600000000.0 / pulseInterval) / actS0Settings[i].ppkwh;
 }
 
+static const uint8_t s0BoardPins[NUM_S0_COUNTERS] = DEFAULT_S0_PINS;
+
+// names of the mqtt topics per unit, the rules use them in lower case
+const char* const s0ValueNames[S0_UNITS][3] = {
+  { "Watt", "Watthour", "WatthourTotal" }, //S0_UNIT_ENERGY
+  { "Flow", "Litre", "LitreTotal" }, //S0_UNIT_VOLUME
+};
 
 void initS0Sensors(s0SettingsStruct s0Settings[]) {
-  //setup s0 port 1
-
-  //TODO: check if this is still necessary
-  //actS0Settings[0].gpiopin = s0Settings[0].gpiopin;
-  actS0Settings[0].gpiopin = DEFAULT_S0_PIN_1;
-  actS0Settings[0].ppkwh = s0Settings[0].ppkwh;
-  actS0Settings[0].lowerPowerInterval = s0Settings[0].lowerPowerInterval;
-  actS0Settings[0].minimalPulseWidth = s0Settings[0].minimalPulseWidth;
-  actS0Settings[0].maximalPulseWidth = s0Settings[0].maximalPulseWidth;
-
-  pinMode(actS0Settings[0].gpiopin, INPUT_PULLUP);
-  attachInterrupt(digitalPinToInterrupt(actS0Settings[0].gpiopin), onS0Pulse1Change, CHANGE);
-  actS0Data[0].nextReport = millis() + MINREPORTEDS0TIME; //initial report after interval, not directly at boot
-
-  //setup s0 port 2
-
-  //TODO: check if this is still necessary
-  //actS0Settings[1].gpiopin = s0Settings[1].gpiopin; 
-  actS0Settings[1].gpiopin = DEFAULT_S0_PIN_2;
-  actS0Settings[1].ppkwh = s0Settings[1].ppkwh;
-  actS0Settings[1].lowerPowerInterval = s0Settings[1].lowerPowerInterval;
-  actS0Settings[1].minimalPulseWidth = s0Settings[1].minimalPulseWidth;
-  actS0Settings[1].maximalPulseWidth = s0Settings[1].maximalPulseWidth;
-
-  pinMode(actS0Settings[1].gpiopin, INPUT_PULLUP);
-  attachInterrupt(digitalPinToInterrupt(actS0Settings[1].gpiopin), onS0Pulse2Change, CHANGE);
-  actS0Data[1].nextReport = millis() + MINREPORTEDS0TIME; //initial report after interval, not directly at boot
+  for (int i = 0 ; i < NUM_S0_COUNTERS ; i++) {
+    actS0Settings[i].gpiopin = (s0BoardPins[i] != 255) ? s0BoardPins[i] : s0Settings[i].gpiopin;
+    actS0Settings[i].unit = (s0Settings[i].unit < S0_UNITS) ? s0Settings[i].unit : S0_UNIT_ENERGY;
+    actS0Settings[i].ppkwh = (s0Settings[i].ppkwh < 1) ? 1 : s0Settings[i].ppkwh;
+    actS0Settings[i].lowerPowerInterval = (s0Settings[i].lowerPowerInterval < 1) ? 1 : s0Settings[i].lowerPowerInterval;
+    actS0Settings[i].minimalPulseWidth = s0Settings[i].minimalPulseWidth;
+    actS0Settings[i].maximalPulseWidth = s0Settings[i].maximalPulseWidth;
+    actS0Settings[i].reportInterval = (s0Settings[i].reportInterval < 1) ? 1 : s0Settings[i].reportInterval;
+    if (actS0Settings[i].gpiopin == 255) continue; //port not in use
+
+    pinMode(actS0Settings[i].gpiopin, INPUT_PULLUP);
+    attachInterruptArg(digitalPinToInterrupt(actS0Settings[i].gpiopin), onS0PulseChange, (void*)(intptr_t)i, CHANGE);
+    actS0Data[i].nextReport = millis() + 1000UL * actS0Settings[i].reportInterval; //initial report after interval, not directly at boot
+  }
+}
+
+bool s0PortEnabled(int s0Port) {
+  return (s0Port >= 1) && (s0Port <= NUM_S0_COUNTERS) && (actS0Settings[s0Port - 1].gpiopin != 255);
+}
+
+// the mqtt topic name of a value of port s0Port (1 based)
+const char* s0ValueName(int s0Port, uint8_t value) {
+  return s0ValueNames[actS0Settings[s0Port - 1].unit][value];
 }
 
 void restore_s0_Watthour(int s0Port, float watthour) {
-  if ((s0Port == 1) || (s0Port == 2)) {
+  if (s0PortEnabled(s0Port)) {
     unsigned long newTotal = (unsigned long)(watthour * (actS0Settings[s0Port - 1].ppkwh / 1000.0));
     if (newTotal > actS0Data[s0Port - 1].pulsesTotal) {
-      noInterrupts();
       actS0Data[s0Port - 1].pulsesTotal = newTotal;
-      interrupts();
     }
   }
 }
 
+// Parses s0#<value>_<port>, with a value name of any unit. Returns the
+// value and sets the port (0 based), or -1 if it is not such a name.
+static int8_t parseS0Variable(const char* name, uint16_t size, int* port) {
+  if ((size < 6) || (strncasecmp(name, "s0#", 3) != 0)) return -1;
+  uint16_t sep = size;
+  while ((sep > 3) && (name[sep - 1] != '_')) sep--;
+  if ((sep <= 4) || (sep == size)) return -1;
+  int nr = 0;
+  for (uint16_t x = sep; x < size; x++) {
+    if (!isdigit(name[x])) return -1;
+    nr = nr * 10 + (name[x] - '0');
+    if (nr > NUM_S0_COUNTERS) return -1;
+  }
+  if (nr < 1) return -1;
+  for (uint8_t unit = 0; unit < S0_UNITS; unit++) {
+    for (uint8_t value = 0; value < 3; value++) {
+      const char* valueName = s0ValueNames[unit][value];
+      if ((strlen(valueName) == (size_t)(sep - 4)) && (strncasecmp(&name[3], valueName, sep - 4) == 0)) {
+        *port = nr - 1;
+        return value;
+      }
+    }
+  }
+  return -1;
+}
 
+// the length of a valid s0 rules variable, -1 otherwise
+int16_t s0RulesVariable(const char* name, uint16_t size) {
+  int port = 0;
+  return (parseS0Variable(name, size, &port) < 0) ? -1 : size;
+}
+
+bool s0RulesValue(const char* name, uint16_t size, float* value) {
+  int port = 0;
+  switch (parseS0Variable(name, size, &port)) {
+    case S0_VALUE_RATE:
+      *value = actS0Data[port].watt;
+      return true;
+    case S0_VALUE_AMOUNT:
+      *value = actS0Data[port].pulses * (1000.0 / actS0Settings[port].ppkwh);
+      return true;
+    case S0_VALUE_TOTAL:
+      *value = actS0Data[port].pulsesTotal * (1000.0 / actS0Settings[port].ppkwh);
+      return true;
+  }
+  return false;
+}
 
 void s0Loop(PubSubClient &mqtt_client, void (*log_message)(char*), char* mqtt_topic_base, s0SettingsStruct s0Settings[]) {
 
   unsigned long millisThisLoop = millis();
 
   for (int i = 0 ; i < NUM_S0_COUNTERS ; i++) {
-    char tmp_log_msg[256];
+    if (actS0Settings[i].gpiopin == 255) continue;
+    takeS0Pulses(i, millisThisLoop);
 
     //report after nextReport
-    if (millisThisLoop > actS0Data[i].nextReport) {
+    if ((long)(millisThisLoop - actS0Data[i].nextReport) >= 0) {
 
+      actS0Data[i].watt = s0WindowWatt(i, millisThisLoop);
       unsigned long lastPulseInterval = millisThisLoop - actS0Data[i].lastPulse;
       unsigned long calcMaxWatt = (3600000000.0 / lastPulseInterval) / actS0Settings[i].ppkwh; //calculate the maximum watt was is possible without receiving pulses during the report interval
 
@@ -127,8 +203,8 @@ void s0Loop(PubSubClient &mqtt_client, void (*log_message)(char*), char* mqtt_to
           actS0Data[i].watt = calcMaxWatt / 2;
         }
       }
-      else { // we are in normal counting mode, report each MINREPORTEDS0TIME
-        actS0Data[i].nextReport = millisThisLoop + MINREPORTEDS0TIME;
+      else { // we are in normal counting mode, report each report interval
+        actS0Data[i].nextReport = millisThisLoop + 1000UL * actS0Settings[i].reportInterval;
         if (actS0Data[i].watt > calcMaxWatt) { //last known watt is higher than possible since last report, so bring it down to wat is possible
           actS0Data[i].watt = calcMaxWatt;
         }
@@ -137,60 +213,45 @@ void s0Loop(PubSubClient &mqtt_client, void (*log_message)(char*), char* mqtt_to
       float Watthour = (actS0Data[i].pulses * ( 1000.0 / actS0Settings[i].ppkwh));
       float WatthourTotal = (actS0Data[i].pulsesTotal * ( 1000.0 / actS0Settings[i].ppkwh));
 
-      noInterrupts();
       actS0Data[i].pulses = 0; //per message we report new wattHour, so pulses should be zero at start new message
-      interrupts();
 
       //report using mqtt
       char log_msg[256];
       char mqtt_topic[256];
       char valueStr[20];
 
-      //debug
-      /*
-        noInterrupts();
-        int j = 0;
-        while (allLastEdgeS0Index[i] > 0) {
-        allLastEdgeS0Index[i]--;
-        sprintf_P(log_msg, PSTR("Pulse widths seen on S0 port %d: Width: %lu"), (i + 1),  allLastEdgeS0[i][j] );
-        //log_message(log_msg);
-        Serial1.println(log_msg);
-        j++;
-        }
-        interrupts();
-      */
-      //end debug
-
       sprintf_P(log_msg, PSTR("Pulses seen on S0 port %d: Good: %lu Bad: %lu Average good pulse width: %i"), (i + 1),  actS0Data[i].goodPulses, actS0Data[i].badPulses, actS0Data[i].avgPulseWidth);
       log_message(log_msg);
 
-      sprintf_P(log_msg, PSTR("Measured Watthour on S0 port %d: %.2f"), (i + 1),  Watthour );
+      const char* const* names = s0ValueNames[actS0Settings[i].unit];
+      sprintf_P(log_msg, PSTR("Measured %s on S0 port %d: %.2f"), names[S0_VALUE_AMOUNT], (i + 1),  Watthour );
       log_message(log_msg);
       sprintf(valueStr, "%.2f", Watthour);
-      sprintf_P(mqtt_topic, PSTR("%s/%s/Watthour/%d"), mqtt_topic_base, mqtt_topic_s0, (i + 1));
-      mqtt_client.publish(mqtt_topic, valueStr, MQTT_RETAIN_VALUES);
+      sprintf_P(mqtt_topic, PSTR("%s/%s/%s/%d"), mqtt_topic_base, mqtt_topic_s0, names[S0_VALUE_AMOUNT], (i + 1));
+      mqttQueuePublish(mqtt_topic, valueStr, MQTT_QUEUE_COALESCE | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
 
-      sprintf(log_msg, PSTR("Measured total Watthour on S0 port %d: %.2f"), (i + 1),  WatthourTotal );
+      sprintf_P(log_msg, PSTR("Measured %s on S0 port %d: %.2f"), names[S0_VALUE_TOTAL], (i + 1),  WatthourTotal );
       log_message(log_msg);
       sprintf(valueStr, "%.2f", WatthourTotal);
-      sprintf(mqtt_topic, PSTR("%s/%s/WatthourTotal/%d"), mqtt_topic_base, mqtt_topic_s0, (i + 1));
-      mqtt_client.publish(mqtt_topic, valueStr, MQTT_RETAIN_VALUES);
-      sprintf(log_msg, PSTR("Calculated Watt on S0 port %d: %u"), (i + 1), actS0Data[i].watt);
+      sprintf_P(mqtt_topic, PSTR("%s/%s/%s/%d"), mqtt_topic_base, mqtt_topic_s0, names[S0_VALUE_TOTAL], (i + 1));
+      mqttQueuePublish(mqtt_topic, valueStr, MQTT_QUEUE_COALESCE | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
+      sprintf_P(log_msg, PSTR("Calculated %s on S0 port %d: %u"), names[S0_VALUE_RATE], (i + 1), actS0Data[i].watt);
       log_message(log_msg);
       sprintf(valueStr, "%u",  actS0Data[i].watt);
-      sprintf(mqtt_topic, PSTR("%s/%s/Watt/%d"), mqtt_topic_base, mqtt_topic_s0, (i + 1));
-      mqtt_client.publish(mqtt_topic, valueStr, MQTT_RETAIN_VALUES);
+      sprintf_P(mqtt_topic, PSTR("%s/%s/%s/%d"), mqtt_topic_base, mqtt_topic_s0, names[S0_VALUE_RATE], (i + 1));
+      mqttQueuePublish(mqtt_topic, valueStr, MQTT_QUEUE_COALESCE | (MQTT_RETAIN_VALUES ? MQTT_QUEUE_RETAIN : 0));
       //update GUI over websocket
       sprintf_P(log_msg, PSTR("{\"data\": {\"s0values\": {\"s0port\": %d, \"Watt\": %u, \"Watthour\": %.2f, \"WatthourTotal\": %.2f}}}"), i+1, actS0Data[i].watt,Watthour,WatthourTotal);
       websocket_write_all(log_msg, strlen(log_msg));         
-      //send rules events
+      //send rules events, s0#watt_1 and so on
       char s0_event[32];
-      snprintf_P(s0_event, sizeof(s0_event), PSTR("s0#watt_%d"), i + 1);
-      rules_event_cb("", s0_event);
-      snprintf_P(s0_event, sizeof(s0_event), PSTR("s0#watthour_%d"), i + 1);
-      rules_event_cb("", s0_event);
-      snprintf_P(s0_event, sizeof(s0_event), PSTR("s0#watthourtotal_%d"), i + 1);
-      rules_event_cb("", s0_event);
+      for (uint8_t value = 0; value < 3; value++) {
+        int len = snprintf_P(s0_event, sizeof(s0_event), PSTR("s0#%s_%d"), names[value], i + 1);
+        for (int x = 3; x < len; x++) {
+          s0_event[x] = tolower(s0_event[x]);
+        }
+        rules_event_cb("", s0_event);
+      }
     }
   }
 }
@@ -199,7 +260,11 @@ unsigned long jsonPulses[NUM_S0_COUNTERS];
 
 void s0JsonOutput(struct webserver_t *client) {
   webserver_send_content_P(client, PSTR("["), 1);
+  bool first = true;
   for (int i = 0; i < NUM_S0_COUNTERS; i++) {
+    if (actS0Settings[i].gpiopin == 255) continue;
+    if (!first) webserver_send_content_P(client, PSTR(","), 1);
+    first = false;
     webserver_send_content_P(client, PSTR("{\"S0 port\":"), 11);
 
     char str[12];
@@ -233,11 +298,7 @@ void s0JsonOutput(struct webserver_t *client) {
     itoa(actS0Data[i].avgPulseWidth, str, 10);
     webserver_send_content(client, str, strlen(str));
 
-    if (i < NUM_S0_COUNTERS - 1) {
-      webserver_send_content_P(client, PSTR("},"), 2);
-    } else {
-      webserver_send_content_P(client, PSTR("}"), 1);
-    }
+    webserver_send_content_P(client, PSTR("}"), 1);
   }
   webserver_send_content_P(client, PSTR("]"), 1);
 }
@@ -1,35 +1,65 @@
 #include <PubSubClient.h>
 #include "src/common/webserver.h"
 
-#define NUM_S0_COUNTERS 2
 #if defined(ESP8266)
-#define DEFAULT_S0_PIN_1 12 
-#define DEFAULT_S0_PIN_2 14 
+#define NUM_S0_COUNTERS 2
+#define DEFAULT_S0_PINS { 12, 14 } // ports on the board
 #elif defined(ESP32)
-#define DEFAULT_S0_PIN_1 1
-#define DEFAULT_S0_PIN_2 2 
+#define NUM_S0_COUNTERS 4
+#define DEFAULT_S0_PINS { 1, 2, 255, 255 } // ports on the board, 255 takes the gpio from the settings
+#endif
+#define S0_UNIT_ENERGY 0 // pulses per kWh, reported in W, Wh
+#define S0_UNIT_VOLUME 1 // pulses per m3 of water or gas, reported in l/h, l
+#define S0_UNITS 2
+#define S0_VALUE_RATE 0 // names of the values in s0ValueNames
+#define S0_VALUE_AMOUNT 1
+#define S0_VALUE_TOTAL 2
+#if defined(ESP8266)
+#define S0_RING_SIZE 32 // pulse timestamps kept per port, a power of two
+#else
+#define S0_RING_SIZE 64 // pulse timestamps kept per port, a power of two
 #endif
+#define S0_WINDOW 30000 // ms of pulses the power is calculated over
+#define S0_DEFAULT_REPORT_INTERVAL 5 // seconds between reports while power is drawn
 
 struct s0SettingsStruct {
-  byte gpiopin = 255;
-  unsigned int ppkwh = 1000; //pulses per Wh of the connected meter
+  byte gpiopin = 255; //only used by ports without a pin on the board
+  byte unit = S0_UNIT_ENERGY;
+  unsigned int ppkwh = 1000; //pulses per kWh (or per m3) of the connected meter
   unsigned int lowerPowerInterval = 60; //configurabel low power interval
   unsigned int minimalPulseWidth = 25; //configurabel minimal s0 pulse width
   unsigned int maximalPulseWidth = 100; //configurabel maximal s0 pulse width
+  unsigned int reportInterval = S0_DEFAULT_REPORT_INTERVAL; //configurable report interval, 1 second at least
+};
+
+// Filled by the interrupt, read by s0Loop. The interrupt only writes head
+// and the entry it points to, so no locking is needed.
+struct s0RingStruct {
+  uint32_t head = 0; //good pulses since boot, the next entry is head % S0_RING_SIZE
+  uint32_t badPulses = 0;
+  uint32_t time[S0_RING_SIZE]; //millis of the pulse end
+  uint16_t width[S0_RING_SIZE]; //ms
 };
 
 struct s0DataStruct {
   unsigned int pulses = 0; //number of pulses since last report
   unsigned int pulsesTotal = 0; //total pulses measured from begin
-  unsigned int watt = 0; //calculated average power
+  unsigned int watt = 0; //power over the last pulses, see s0WindowWatt()
   unsigned long lastPulse = 0; //last pulse in millis
+  uint32_t tail = 0; //next pulse of the ring to take
   unsigned long nextReport = 0; //next time we reported the s0 value in millis
   unsigned long goodPulses = 0;
   unsigned long badPulses = 0;
   unsigned int avgPulseWidth = 0;
 };
 
+extern const char* const s0ValueNames[S0_UNITS][3];
+
 void initS0Sensors(s0SettingsStruct s0Settings[]);
+bool s0PortEnabled(int s0Port);
+const char* s0ValueName(int s0Port, uint8_t value);
 void restore_s0_Watthour(int s0Port, float watthour);
+int16_t s0RulesVariable(const char* name, uint16_t size);
+bool s0RulesValue(const char* name, uint16_t size, float* value);
 void s0Loop(PubSubClient &mqtt_client, void (*log_message)(char*), char* mqtt_topic_base, s0SettingsStruct s0Settings[]);
 void s0JsonOutput(struct webserver_t *client);
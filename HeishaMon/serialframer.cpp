@@ -0,0 +1,80 @@
+#include "serialframer.h"
+
+static bool isFrameStart(byte value, uint8_t flags) {
+  return (value == 0x71) || (value == 0x31) || ((flags & SERIAL_FRAMER_WRITES) && (value == 0xF1));
+}
+
+// Drop the first count bytes and everything up to the next possible frame start
+static void serialFramerSkip(struct serialFramerStruct *framer, uint8_t count, uint8_t flags) {
+  while ((count < framer->length) && !isFrameStart(framer->data[count], flags)) {
+    count++;
+  }
+  framer->length -= count;
+  memmove(framer->data, &framer->data[count], framer->length);
+  framer->frameLength = 0;
+  framer->summed = 0;
+  framer->chk = 0;
+}
+
+void serialFramerReset(struct serialFramerStruct *framer) {
+  framer->length = 0;
+  framer->frameLength = 0;
+  framer->summed = 0;
+  framer->chk = 0;
+}
+
+// Parse must be called after each byte, so a full buffer is always a broken frame
+bool serialFramerPut(struct serialFramerStruct *framer, byte value) {
+  if (framer->length >= SERIAL_FRAMER_SIZE) {
+    return false;
+  }
+  framer->data[framer->length++] = value;
+  return true;
+}
+
+// Check the buffered bytes as far as they go. On an error the first byte is
+// discarded and the buffer is rescanned from the next frame start, so a frame
+// following noise is still found without waiting for a timeout. Call again
+// until SERIAL_FRAME_INCOMPLETE is returned.
+uint8_t serialFramerParse(struct serialFramerStruct *framer, uint8_t flags) {
+  if (framer->length == 0) {
+    return SERIAL_FRAME_INCOMPLETE;
+  }
+  if (!isFrameStart(framer->data[0], flags)) {
+    serialFramerSkip(framer, 1, flags);
+    return SERIAL_FRAME_BADHEADER;
+  }
+  if (framer->frameLength == 0) {
+    if (framer->length < 3) {
+      return SERIAL_FRAME_INCOMPLETE;
+    }
+    if ((framer->data[1] == 0) || (framer->data[1] > SERIAL_FRAMER_SIZE - 3) || ((flags & SERIAL_FRAMER_STRICT) && (framer->data[2] != 0x01))) {
+      serialFramerSkip(framer, 1, flags);
+      framer->resyncs++;
+      return SERIAL_FRAME_BADLENGTH;
+    }
+    framer->frameLength = framer->data[1] + 3;
+  }
+  while ((framer->summed < framer->length) && (framer->summed < framer->frameLength)) {
+    framer->chk += framer->data[framer->summed++];
+  }
+  if (framer->summed < framer->frameLength) {
+    return SERIAL_FRAME_INCOMPLETE;
+  }
+  if (framer->chk != 0) { //all received bytes + checksum should result in 0
+    serialFramerSkip(framer, 1, flags);
+    framer->resyncs++;
+    return SERIAL_FRAME_BADCRC;
+  }
+  return SERIAL_FRAME_OK;
+}
+
+// Remove the frame returned by parse, bytes after it stay buffered
+void serialFramerConsume(struct serialFramerStruct *framer) {
+  uint8_t count = framer->frameLength;
+  framer->length -= count;
+  memmove(framer->data, &framer->data[count], framer->length);
+  framer->frameLength = 0;
+  framer->summed = 0;
+  framer->chk = 0;
+}
@@ -0,0 +1,35 @@
+#ifndef _SERIALFRAMER_H_
+#define _SERIALFRAMER_H_
+
+#include <Arduino.h>
+
+#define SERIAL_FRAMER_SIZE 255 // largest frame, the length byte + 3
+
+// parse results
+#define SERIAL_FRAME_INCOMPLETE 0
+#define SERIAL_FRAME_OK         1 // data[0..frameLength) holds a frame with a valid checksum
+#define SERIAL_FRAME_BADHEADER  2 // bytes before the next frame start were skipped
+#define SERIAL_FRAME_BADLENGTH  3 // header with an impossible length, resynchronised
+#define SERIAL_FRAME_BADCRC     4 // complete frame with a wrong checksum, resynchronised
+
+// parse flags
+#define SERIAL_FRAMER_WRITES    0x01 // 0xF1 write frames are valid frame starts
+#define SERIAL_FRAMER_STRICT    0x02 // third header byte must be 0x01 (heatpump answers)
+
+// Streaming parser for the 0x71/0x31/0xF1 framing: header, length byte,
+// payload and a checksum which makes the sum of all bytes 0.
+struct serialFramerStruct {
+  byte data[SERIAL_FRAMER_SIZE];
+  uint8_t length = 0; // bytes buffered
+  uint8_t frameLength = 0; // length of the frame at data[0] once known
+  uint8_t summed = 0; // bytes already added to chk
+  byte chk = 0;
+  unsigned long resyncs = 0; // frame starts found again inside discarded data
+};
+
+void serialFramerReset(struct serialFramerStruct *framer);
+bool serialFramerPut(struct serialFramerStruct *framer, byte value);
+uint8_t serialFramerParse(struct serialFramerStruct *framer, uint8_t flags);
+void serialFramerConsume(struct serialFramerStruct *framer);
+
+#endif
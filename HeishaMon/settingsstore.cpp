@@ -0,0 +1,404 @@
+#include "settingsstore.h"
+#include "persist.h"
+#include "src/common/progmem.h"
+#include <stddef.h>
+
+struct settingDefStruct {
+  char name[20]; // json and form name, '#' is the port number of settings with a count
+  uint8_t id; // record id, never reuse the id of a removed setting
+  uint8_t type;
+  uint8_t flags;
+  uint8_t count; // instances, stride bytes apart, with the ids id to id + count - 1
+  uint16_t offset;
+  uint16_t size;
+  uint16_t stride;
+};
+
+#define SETTING(name, id, type, flags, field) { name, id, type, flags, 1, offsetof(settingsStruct, field), sizeof(((settingsStruct *)0)->field), 0 }
+#define S0_SETTING(name, id, type, field) { name, id, type, 0, NUM_S0_COUNTERS, offsetof(settingsStruct, s0Settings) + offsetof(s0SettingsStruct, field), sizeof(((s0SettingsStruct *)0)->field), sizeof(s0SettingsStruct) }
+#define S0_SETTING_IDS 8 // ids kept for the ports of each s0 setting
+
+static_assert(NUM_S0_COUNTERS <= S0_SETTING_IDS, "not enough s0 setting ids");
+
+// Records are written in this order, keep it when adding settings
+static const settingDefStruct settingDefs[] PROGMEM = {
+  SETTING("wifi_ssid", 1, SETTING_STRING, SETTING_KEEPEMPTY, wifi_ssid),
+  SETTING("wifi_password", 2, SETTING_STRING, SETTING_SECRET, wifi_password),
+  SETTING("wifi_hostname", 3, SETTING_STRING, 0, wifi_hostname),
+  SETTING("ota_password", 4, SETTING_STRING, SETTING_NOFORM, ota_password),
+  SETTING("mqtt_topic_base", 5, SETTING_STRING, 0, mqtt_topic_base),
+  SETTING("mqtt_server", 6, SETTING_STRING, 0, mqtt_server),
+  SETTING("mqtt_port", 7, SETTING_STRING, 0, mqtt_port),
+  SETTING("mqtt_username", 8, SETTING_STRING, 0, mqtt_username),
+  SETTING("mqtt_password", 9, SETTING_STRING, SETTING_SECRET, mqtt_password),
+  SETTING("ntp_servers", 10, SETTING_STRING, 0, ntp_servers),
+  SETTING("timezone", 11, SETTING_UINT, 0, timezone),
+#ifdef TLS_SUPPORT
+  SETTING("mqtt_tls_enabled", 12, SETTING_BOOL, 0, mqtt_tls_enabled),
+#endif
+  SETTING("force_rules", 13, SETTING_BOOL, 0, force_rules),
+  SETTING("use_1wire", 14, SETTING_BOOL, 0, use_1wire),
+  SETTING("use_s0", 15, SETTING_BOOL, 0, use_s0),
+  SETTING("hotspot", 16, SETTING_BOOL, 0, hotspot),
+  SETTING("listenonly", 17, SETTING_BOOL, 0, listenonly),
+  SETTING("logMqtt", 18, SETTING_BOOL, 0, logMqtt),
+  SETTING("logHexdump", 19, SETTING_BOOL, 0, logHexdump),
+  SETTING("recordFrames", 20, SETTING_BOOL, 0, recordFrames),
+  SETTING("historyTopics", 21, SETTING_STRING, 0, historyTopics),
+  SETTING("historyFlush", 22, SETTING_BOOL, 0, historyFlush),
+  SETTING("logSerial1", 23, SETTING_BOOL, 0, logSerial1),
+  SETTING("optionalPCB", 24, SETTING_BOOL, 0, optionalPCB),
+  SETTING("opentherm", 25, SETTING_BOOL, 0, opentherm),
+#ifdef ESP32
+  SETTING("proxy", 26, SETTING_BOOL, 0, proxy),
+#endif
+  SETTING("waitTime", 27, SETTING_UINT, 0, waitTime),
+  SETTING("waitTimeIdle", 28, SETTING_UINT, 0, waitTimeIdle),
+  SETTING("waitTimeExtra", 29, SETTING_UINT, 0, waitTimeExtra),
+  SETTING("waitDallasTime", 30, SETTING_UINT, 0, waitDallasTime),
+  SETTING("dallasResolution", 31, SETTING_UINT, 0, dallasResolution),
+  SETTING("updateAllTime", 32, SETTING_UINT, 0, updateAllTime),
+  SETTING("updataAllDallasTime", 33, SETTING_UINT, 0, updataAllDallasTime),
+  SETTING("fastBoot", 34, SETTING_BOOL, 0, fastBoot),
+  S0_SETTING("s0_#_gpio", 64, SETTING_UINT, gpiopin),
+  S0_SETTING("s0_#_unit", 64 + 1 * S0_SETTING_IDS, SETTING_UINT, unit),
+  S0_SETTING("s0_#_ppkwh", 64 + 2 * S0_SETTING_IDS, SETTING_UINT, ppkwh),
+  S0_SETTING("s0_#_interval", 64 + 3 * S0_SETTING_IDS, SETTING_UINT, lowerPowerInterval),
+  S0_SETTING("s0_#_minpulsewidth", 64 + 4 * S0_SETTING_IDS, SETTING_UINT, minimalPulseWidth),
+  S0_SETTING("s0_#_maxpulsewidth", 64 + 5 * S0_SETTING_IDS, SETTING_UINT, maximalPulseWidth),
+  S0_SETTING("s0_#_reportinterval", 64 + 6 * S0_SETTING_IDS, SETTING_UINT, reportInterval),
+};
+
+#define SETTING_DEFS (sizeof(settingDefs) / sizeof(settingDefs[0]))
+
+static void readDef(size_t i, settingDefStruct *def) {
+  memcpy_P(def, &settingDefs[i], sizeof(settingDefStruct));
+}
+
+static uint8_t *settingField(settingsStruct *settings, const settingDefStruct *def, uint8_t index) {
+  return (uint8_t *)settings + def->offset + index * def->stride;
+}
+
+static uint32_t getUint(const uint8_t *field, uint16_t size) {
+  switch (size) {
+    case 1: return *field;
+    case 2: return *(const uint16_t *)field;
+    default: return *(const uint32_t *)field;
+  }
+}
+
+static void setUint(uint8_t *field, uint16_t size, uint32_t value) {
+  switch (size) {
+    case 1: *field = value; break;
+    case 2: *(uint16_t *)field = value; break;
+    default: *(uint32_t *)field = value; break;
+  }
+}
+
+// Copies a value of len bytes into a string field, behind what is already
+// there if append is set. Values longer than the field are cut.
+static void setString(uint8_t *field, uint16_t size, const char *value, size_t len, bool append) {
+  size_t used = append ? strlen((char *)field) : 0;
+  if (len > (size_t)(size - 1 - used)) {
+    len = size - 1 - used;
+  }
+  memcpy(field + used, value, len);
+  field[used + len] = '\0';
+}
+
+// The json name of a setting, with the port number filled in
+static void settingName(const settingDefStruct *def, uint8_t index, char *name) {
+  const char *hash = strchr(def->name, '#');
+  if (hash == NULL) {
+    strlcpy(name, def->name, SETTINGS_KEY_SIZE);
+  } else {
+    snprintf_P(name, SETTINGS_KEY_SIZE, PSTR("%.*s%d%s"), (int)(hash - def->name), def->name, index + 1, hash + 1);
+  }
+}
+
+static bool settingMatch(const settingDefStruct *def, const char *name, uint8_t *index) {
+  const char *pattern = def->name;
+  *index = 0;
+  while (*pattern != '\0') {
+    if (*pattern == '#') {
+      if ((*name < '1') || (*name > '9')) {
+        return false;
+      }
+      unsigned int port = 0;
+      while ((*name >= '0') && (*name <= '9')) {
+        port = port * 10 + (*name++ - '0');
+      }
+      if (port > def->count) {
+        return false;
+      }
+      *index = port - 1;
+      pattern++;
+    } else if (*pattern++ != *name++) {
+      return false;
+    }
+  }
+  return *name == '\0';
+}
+
+static bool findSetting(const char *name, settingDefStruct *def, uint8_t *index) {
+  for (size_t i = 0; i < SETTING_DEFS; i++) {
+    readDef(i, def);
+    if (settingMatch(def, name, index)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static uint32_t crc32(const uint8_t *data, size_t length) {
+  uint32_t crc = 0xFFFFFFFFUL;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+static size_t valueLength(const settingDefStruct *def, uint8_t *field) {
+  switch (def->type) {
+    case SETTING_STRING: return strlen((char *)field);
+    case SETTING_BOOL: return 1;
+    default: return def->size;
+  }
+}
+
+static void applyRecord(settingsStruct *settings, const settingDefStruct *def, uint8_t index, const uint8_t *value, uint8_t len) {
+  uint8_t *field = settingField(settings, def, index);
+  switch (def->type) {
+    case SETTING_STRING: {
+        setString(field, def->size, (const char *)value, len, false);
+      } break;
+    case SETTING_BOOL: {
+        *(bool *)field = (len > 0) && (value[0] != 0);
+      } break;
+    case SETTING_UINT: {
+        uint32_t number = 0;
+        for (int i = ((len > 4) ? 4 : len) - 1; i >= 0; i--) {
+          number = (number << 8) | value[i];
+        }
+        setUint(field, def->size, number);
+      } break;
+  }
+}
+
+// The file is read with one read into a buffer of its size. The records
+// are written in the order of settingDefs, so the search for the setting
+// of the next record starts behind the previous one.
+bool settingsLoad(settingsStruct *settings) {
+  File file = LittleFS.open(SETTINGS_FILE, "r");
+  if (!file) {
+    return false;
+  }
+  size_t size = file.size();
+  if ((size < sizeof(settingsHeaderStruct)) || (size > SETTINGS_MAX_SIZE)) {
+    file.close();
+    log_message(_F("Settings file has a wrong size"));
+    return false;
+  }
+  std::unique_ptr<uint8_t[]> blob(new uint8_t[size]);
+  bool ok = (file.read(blob.get(), size) == size);
+  file.close();
+  settingsHeaderStruct header;
+  memcpy(&header, blob.get(), sizeof(header));
+  const uint8_t *records = blob.get() + sizeof(header);
+  if (!ok || (header.magic != SETTINGS_MAGIC) || (header.version > SETTINGS_VERSION) || (header.length != size - sizeof(header)) || (crc32(records, header.length) != header.crc)) {
+    log_message(_F("Settings file is damaged or from a newer firmware"));
+    return false;
+  }
+
+  size_t next = 0;
+  size_t pos = 0;
+  while (pos + 2 <= header.length) {
+    uint8_t id = records[pos];
+    uint8_t len = records[pos + 1];
+    if (pos + 2 + len > header.length) {
+      break;
+    }
+    settingDefStruct def;
+    for (size_t n = 0; n < SETTING_DEFS; n++) {
+      size_t i = (next + n) % SETTING_DEFS;
+      readDef(i, &def);
+      if ((id >= def.id) && (id < def.id + def.count)) {
+        applyRecord(settings, &def, id - def.id, &records[pos + 2], len);
+        next = i;
+        break;
+      }
+    }
+    pos += 2 + len;
+  }
+  return true;
+}
+
+bool settingsSave(settingsStruct *settings) {
+  settingDefStruct def;
+  size_t length = 0;
+  for (size_t i = 0; i < SETTING_DEFS; i++) {
+    readDef(i, &def);
+    for (uint8_t index = 0; index < def.count; index++) {
+      length += 2 + valueLength(&def, settingField(settings, &def, index));
+    }
+  }
+  std::unique_ptr<uint8_t[]> blob(new uint8_t[sizeof(settingsHeaderStruct) + length]);
+  uint8_t *records = blob.get() + sizeof(settingsHeaderStruct);
+  size_t pos = 0;
+  for (size_t i = 0; i < SETTING_DEFS; i++) {
+    readDef(i, &def);
+    for (uint8_t index = 0; index < def.count; index++) {
+      uint8_t *field = settingField(settings, &def, index);
+      size_t len = valueLength(&def, field);
+      records[pos++] = def.id + index;
+      records[pos++] = len;
+      if (def.type == SETTING_UINT) {
+        uint32_t number = getUint(field, def.size);
+        for (size_t b = 0; b < len; b++) {
+          records[pos++] = number & 0xFF;
+          number >>= 8;
+        }
+      } else {
+        memcpy(&records[pos], field, len);
+        pos += len;
+      }
+    }
+  }
+  settingsHeaderStruct header;
+  header.magic = SETTINGS_MAGIC;
+  header.version = SETTINGS_VERSION;
+  header.length = length;
+  header.crc = crc32(records, length);
+  memcpy(blob.get(), &header, sizeof(header));
+
+  // Written now, a reboot may follow
+  if (!persistWrite(SETTINGS_FILE, blob.get(), sizeof(header) + length, 0)) {
+    return false;
+  }
+  persistFlush(SETTINGS_FILE);
+  return true;
+}
+
+void settingsValidate(settingsStruct *settings) {
+  if (settings->waitTime < 5) settings->waitTime = 5;
+  if (settings->waitTimeIdle < settings->waitTime) settings->waitTimeIdle = settings->waitTime;
+  if ((settings->waitTimeExtra > 0) && (settings->waitTimeExtra < 5)) settings->waitTimeExtra = 5;
+  if (settings->waitDallasTime < 5) settings->waitDallasTime = 5;
+  if ((settings->dallasResolution < 9) || (settings->dallasResolution > 12)) settings->dallasResolution = 12;
+  if (settings->updateAllTime < settings->waitTime) settings->updateAllTime = settings->waitTime;
+  if (settings->updataAllDallasTime < settings->waitDallasTime) settings->updataAllDallasTime = settings->waitDallasTime;
+}
+
+void settingsToJson(JsonDocument &jsonDoc, settingsStruct *settings) {
+  settingDefStruct def;
+  char name[SETTINGS_KEY_SIZE];
+  for (size_t i = 0; i < SETTING_DEFS; i++) {
+    readDef(i, &def);
+    for (uint8_t index = 0; index < def.count; index++) {
+      uint8_t *field = settingField(settings, &def, index);
+      settingName(&def, index, name);
+      switch (def.type) {
+        case SETTING_STRING: jsonDoc[name] = (char *)field; break;
+        case SETTING_BOOL: jsonDoc[name] = *(bool *)field ? "enabled" : "disabled"; break;
+        case SETTING_UINT: jsonDoc[name] = getUint(field, def.size); break;
+      }
+    }
+  }
+}
+
+// Settings missing in the document keep their value
+void settingsFromJson(JsonDocument &jsonDoc, settingsStruct *settings) {
+  settingDefStruct def;
+  char name[SETTINGS_KEY_SIZE];
+  for (size_t i = 0; i < SETTING_DEFS; i++) {
+    readDef(i, &def);
+    for (uint8_t index = 0; index < def.count; index++) {
+      settingName(&def, index, name);
+      JsonVariant value = jsonDoc[name];
+      if (value.isNull()) {
+        continue;
+      }
+      uint8_t *field = settingField(settings, &def, index);
+      if (value.is<const char *>()) {
+        const char *text = value.as<const char *>();
+        if (def.type == SETTING_STRING) {
+          setString(field, def.size, text, strlen(text), false);
+        } else if (def.type == SETTING_BOOL) {
+          *(bool *)field = (strcmp_P(text, PSTR("enabled")) == 0);
+        } else if (text[0] != '\0') {
+          setUint(field, def.size, strtoul(text, NULL, 10));
+        }
+      } else if (def.type == SETTING_BOOL) {
+        *(bool *)field = value.as<bool>();
+      } else if (def.type == SETTING_UINT) {
+        setUint(field, def.size, value.as<uint32_t>());
+      }
+    }
+  }
+}
+
+// Sets a setting from the settings form. Long values arrive in parts, the
+// parts after the first are passed with append set.
+bool settingsSet(settingsStruct *settings, const char *name, const char *value, size_t len, bool append) {
+  settingDefStruct def;
+  uint8_t index;
+  if (!findSetting(name, &def, &index) || (def.flags & SETTING_NOFORM)) {
+    return false;
+  }
+  uint8_t *field = settingField(settings, &def, index);
+  switch (def.type) {
+    case SETTING_STRING: {
+        setString(field, def.size, value, len, append);
+      } break;
+    case SETTING_BOOL: {
+        *(bool *)field = (len == 7) && (strncmp_P(value, PSTR("enabled"), 7) == 0);
+      } break;
+    case SETTING_UINT: {
+        char number[12];
+        if ((len == 0) || (len >= sizeof(number))) {
+          return false;
+        }
+        memcpy(number, value, len);
+        number[len] = '\0';
+        setUint(field, def.size, strtoul(number, NULL, 10));
+      } break;
+  }
+  return true;
+}
+
+// The form does not post a checkbox which is off
+void settingsClearCheckboxes(settingsStruct *settings) {
+  settingDefStruct def;
+  for (size_t i = 0; i < SETTING_DEFS; i++) {
+    readDef(i, &def);
+    if (def.type == SETTING_BOOL) {
+      for (uint8_t index = 0; index < def.count; index++) {
+        *(bool *)settingField(settings, &def, index) = false;
+      }
+    }
+  }
+}
+
+// Puts back the stored value of masked passwords and of an ssid left empty
+void settingsKeepUnchanged(settingsStruct *settings, const settingsStruct *stored) {
+  settingDefStruct def;
+  for (size_t i = 0; i < SETTING_DEFS; i++) {
+    readDef(i, &def);
+    if (!(def.flags & (SETTING_SECRET | SETTING_KEEPEMPTY))) {
+      continue;
+    }
+    for (uint8_t index = 0; index < def.count; index++) {
+      char *field = (char *)settingField(settings, &def, index);
+      bool keep = (field[0] == '\0');
+      if (def.flags & SETTING_SECRET) {
+        keep = (strspn(field, "*") == strlen(field));
+      }
+      if (keep) {
+        memcpy(field, settingField((settingsStruct *)stored, &def, index), def.size);
+      }
+    }
+  }
+}
@@ -0,0 +1,42 @@
+#ifndef _SETTINGSSTORE_H_
+#define _SETTINGSSTORE_H_
+
+#include "webfunctions.h"
+
+// The settings are kept in flash as a header followed by one record per
+// setting: the id of the setting, the length and the value. Records of an
+// unknown id are skipped, so settings can be added or grow without a
+// conversion. The json form is only used by the web pages and to import the
+// config.json of older firmware.
+#define SETTINGS_FILE "/config.bin"
+#define SETTINGS_JSON_FILE "/config.json" // older firmware, imported when there is no valid SETTINGS_FILE
+#define SETTINGS_MAGIC 0x46434D48UL // "HMCF"
+#define SETTINGS_VERSION 1 // raise when the meaning of an existing id changes
+#define SETTINGS_MAX_SIZE 2048 // larger files are not read
+#define SETTINGS_KEY_SIZE 32
+
+#define SETTING_STRING 0
+#define SETTING_BOOL 1 // "enabled" or "disabled" in the form and in json
+#define SETTING_UINT 2
+
+#define SETTING_SECRET 0x01 // masked on the web page, a value of only '*' keeps the stored one
+#define SETTING_KEEPEMPTY 0x02 // an empty value from the form keeps the stored one
+#define SETTING_NOFORM 0x04 // not set by the settings form
+
+struct settingsHeaderStruct {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t length; // of the records
+  uint32_t crc; // crc32 of the records
+};
+
+bool settingsLoad(settingsStruct *settings);
+bool settingsSave(settingsStruct *settings);
+void settingsValidate(settingsStruct *settings);
+void settingsToJson(JsonDocument &jsonDoc, settingsStruct *settings);
+void settingsFromJson(JsonDocument &jsonDoc, settingsStruct *settings);
+bool settingsSet(settingsStruct *settings, const char *name, const char *value, size_t len, bool append);
+void settingsClearCheckboxes(settingsStruct *settings);
+void settingsKeepUnchanged(settingsStruct *settings, const settingsStruct *stored);
+
+#endif
@@ -295,7 +295,6 @@ static int webserver_parse_post(struct webserver_t *client, uint16_t size) {
         }
       }
 
-      memmove(&client->buffer[0], &client->buffer[size], size);
       client->ptr = 0;
       client->buffer[client->ptr] = 0;
 
@@ -433,7 +432,7 @@ static int webserver_parse_post(struct webserver_t *client, uint16_t size) {
            * The size that was read until now must be decreased
            * as well.
            */
-          memmove(&client->buffer[pos+pos3], &client->buffer[pos1], client->ptr-(pos3+pos));
+          memmove(&client->buffer[pos+pos3], &client->buffer[pos1], size-pos1);
           size -= (pos1-(pos3+pos));
           pos1 = (pos+pos3);
           client->buffer[pos1] = d;
@@ -488,7 +487,6 @@ static int webserver_parse_post(struct webserver_t *client, uint16_t size) {
           client->buffer[pos] = c;
         }
 
-        memmove(&client->buffer[pos+1], &client->buffer[size], size-(pos+1));
         client->ptr = (pos+1);
 
         client->buffer[client->ptr] = 0;
@@ -542,8 +540,23 @@ static int webserver_parse_post(struct webserver_t *client, uint16_t size) {
 
 int8_t http_parse_request(struct webserver_t *client, uint8_t **buf, uint16_t *len) {
   uint16_t hasread = MIN(WEBSERVER_BUFFER_SIZE-client->ptr, *len);
+  uint16_t lastptr = WEBSERVER_BUFFER_SIZE+1;
+  uint8_t laststep = 0xFF;
   while((*len > 0) || (strnstr(client->buffer, "\r\n\r\n", client->ptr) != NULL)) {
     hasread = MIN(WEBSERVER_BUFFER_SIZE-client->ptr, (*len));
+
+    /*
+     * Nothing new fits in the buffer and the previous
+     * round didn't consume anything either. The request
+     * can't be parsed (unsupported method, malformed
+     * or too long line), so stop instead of looping
+     * forever.
+     */
+    if(hasread == 0 && client->ptr == lastptr && client->substep == laststep) {
+      return -1;
+    }
+    lastptr = client->ptr;
+    laststep = client->substep;
     memcpy(&client->buffer[client->ptr], &(*buf)[0], hasread);
 
     client->ptr += hasread;
@@ -684,6 +697,10 @@ int8_t http_parse_request(struct webserver_t *client, uint8_t **buf, uint16_t *l
       while(ptr != NULL) {
         struct arguments_t args;
         uint16_t i = ptr-client->buffer, x = 0;
+        if(i == 0) {
+          // header without a name
+          return -1;
+        }
         client->buffer[i] = 0;
         args.name = &client->buffer[0];
         args.value = NULL;
@@ -719,6 +736,9 @@ int8_t http_parse_request(struct webserver_t *client, uint8_t **buf, uint16_t *l
               char tmp[args.len+1];
               memset(&tmp, 0, args.len+1);
               memcpy(tmp, &client->buffer[x+1], args.len);
+              if(client->data.websockkey != NULL) {
+                free(client->data.websockkey);
+              }
               if((client->data.websockkey = strdup(tmp)) == NULL) {
 #if defined(ESP8266) || defined(ESP32)
                 loggingSerial.printf("Out of memory %s:#%d\n", __FUNCTION__, __LINE__);
@@ -735,9 +755,16 @@ int8_t http_parse_request(struct webserver_t *client, uint8_t **buf, uint16_t *l
                 memcpy(tmp, &client->buffer[x+1], args.len);
                 {
                   char *ptr = strstr(tmp, "boundary=");
+                  if(ptr == NULL) {
+                    // multipart without a boundary can't be parsed
+                    return -1;
+                  }
                   uint8_t pos = (ptr-tmp)+strlen("boundary=");
                   memmove(&tmp[0], &tmp[pos], args.len-pos);
                   tmp[args.len-pos] = 0;
+                  if(client->data.boundary != NULL) {
+                    free(client->data.boundary);
+                  }
                   if((client->data.boundary = strdup(tmp)) == NULL) {
 #if defined(ESP8266) || defined(ESP32)
                     loggingSerial.printf("Out of memory %s:#%d\n", __FUNCTION__, __LINE__);
@@ -803,6 +830,7 @@ int http_parse_body(struct webserver_t *client, char *buf, uint16_t len) {
   uint16_t pos = 0;
 
   while(1) {
+    hasread = 0;
     if(pos < len) {
       hasread = MIN(WEBSERVER_BUFFER_SIZE-client->ptr, len-pos);;
       memcpy(&client->buffer[client->ptr], &buf[pos], hasread);
@@ -822,6 +850,14 @@ int http_parse_body(struct webserver_t *client, char *buf, uint16_t len) {
     if(ret == 0) {
       break;
     }
+    /*
+     * Nothing was added to the buffer and nothing
+     * was parsed from it, so the argument in the
+     * buffer can't be handled
+     */
+    if(hasread == 0 && client->ptr == toread) {
+      return -1;
+    }
   }
 
   return 0;
@@ -848,14 +884,44 @@ char *strnstr(const char *haystack, const char *needle, size_t len) {
 int http_parse_multipart_body(struct webserver_t *client, unsigned char *buf, uint16_t len) {
   uint16_t hasread = MIN(WEBSERVER_BUFFER_SIZE-client->ptr, len);
   uint16_t rpos = 0, loop = 1;
+  if(client->data.boundary == NULL) {
+    // no (more) multipart data expected
+    return -1;
+  }
+  uint16_t lastptr = WEBSERVER_BUFFER_SIZE+1;
+  uint8_t laststep = 0xFF;
   while((rpos < len) || ((loop == 1) && (client->ptr > 0))) {
     hasread = MIN(WEBSERVER_BUFFER_SIZE-client->ptr, len-rpos);
+    /*
+     * The buffer is full and the previous round
+     * couldn't parse anything from it, so the
+     * part header doesn't fit or is malformed
+     */
+    if(hasread == 0 && client->ptr == lastptr && client->substep == laststep) {
+      return -1;
+    }
+    lastptr = client->ptr;
+    laststep = client->substep;
     memcpy(&client->buffer[client->ptr], &buf[rpos], hasread);
     client->ptr += hasread;
     rpos += hasread;
     loop = 1;
-	
+
+    uint16_t spinptr = client->ptr;
+    uint8_t spins = 0;
     while(loop) {
+      /*
+       * Every step either consumes part of the buffer or
+       * hands over to the next one. Malformed part headers
+       * can make the steps bounce between each other
+       * without consuming anything, so bail out then.
+       */
+      if(client->ptr != spinptr) {
+        spinptr = client->ptr;
+        spins = 0;
+      } else if(++spins > 16) {
+        return -1;
+      }
       switch(client->substep) {
         // Boundary
         case 0: {
@@ -1045,7 +1111,8 @@ int http_parse_multipart_body(struct webserver_t *client, unsigned char *buf, ui
               if(ptr1 != NULL) {
                 uint16_t pos1 = (ptr1-client->buffer)+4;
                 uint16_t newlen = client->ptr-(pos1-pos);
-                memmove(&client->buffer[pos], &client->buffer[pos1], newlen);
+                // See case 4 for why this copies client->ptr-pos1 bytes
+                memmove(&client->buffer[pos], &client->buffer[pos1], client->ptr-pos1);
                 client->ptr = newlen;
                 client->readlen += (pos1-pos);
                 client->substep = 7;
@@ -1110,7 +1177,8 @@ int http_parse_multipart_body(struct webserver_t *client, unsigned char *buf, ui
           unsigned char *ptr = strnstr(client->buffer, "\r\n--", client->ptr);
           if(ptr != NULL && client->substep != 8) {
             uint16_t pos = (ptr-client->buffer);
-            ptr = (unsigned char *)memchr(client->buffer, '=', client->ptr);
+            // the name marker must precede the end of the value
+            ptr = (unsigned char *)memchr(client->buffer, '=', pos);
             uint16_t vlen = 0;
 
             if(ptr != NULL) {
@@ -1813,7 +1881,11 @@ void webserver_send_content(struct webserver_t *client, char *buf, uint16_t size
 
 int8_t webserver_send(struct webserver_t *client, uint16_t code, char *mimetype, uint16_t data_len) {
   uint16_t i = 0;
-  if(data_len == 0) {
+  /*
+   * A 304 Not Modified never has a body,
+   * so it must not be sent chunked
+   */
+  if(data_len == 0 && code != 304) {
     unsigned char buffer[512], *p = buffer;
     memset(buffer, '\0', sizeof(buffer));
 
@@ -2044,6 +2116,10 @@ int websocket_read(struct webserver_t *client, unsigned char *buf, ssize_t buf_l
   int index_first_data_byte = 0;
   int opcode = buf[0] & 0xF;
 
+  if(buf_len < 2) {
+    return -1;
+  }
+
   memset(&mask, '\0', 4);
   packet_length = ((unsigned char)buf[1]) & 0x7F;
 
@@ -2062,8 +2138,15 @@ int websocket_read(struct webserver_t *client, unsigned char *buf, ssize_t buf_l
     }
     index_first_mask = 10;
   }
-  memcpy(mask, &buf[index_first_mask], 4);
   index_first_data_byte = index_first_mask + 4;
+  /*
+   * The whole frame must be in the buffer,
+   * fragmented frames are not supported
+   */
+  if(buf_len < index_first_data_byte || packet_length > (uint32_t)(buf_len - index_first_data_byte)) {
+    return -1;
+  }
+  memcpy(mask, &buf[index_first_mask], 4);
 
   for(i = index_first_data_byte, j = 0; i < buf_len && i < packet_length + index_first_data_byte; i++, j++) {
     buf[j] = buf[i] ^ mask[j % 4];
@@ -2102,7 +2185,12 @@ int websocket_read(struct webserver_t *client, unsigned char *buf, ssize_t buf_l
 
 uint8_t webserver_sync_receive(struct webserver_t *client, uint8_t *rbuffer, uint16_t size) {
   if(client->step == WEBSERVER_CLIENT_READ_HEADER) {
-    if(http_parse_request(client, &rbuffer, &size) == 0) {
+    int8_t ret = http_parse_request(client, &rbuffer, &size);
+    if(ret == -1) {
+      client->step = WEBSERVER_CLIENT_CLOSE;
+      return 0;
+    }
+    if(ret == 0) {
       if(client->is_websocket == 1 && client->data.websockkey != NULL) {
         client->is_websocket = 1;
         client->lastping = millis();
@@ -2262,6 +2350,7 @@ void webserver_reset_client(struct webserver_t *client) {
   client->chunked = 0;
   client->ptr = 0;
   client->route = 0;
+  client->routeidx = 0;
   client->lastseen = 0;
   client->lastping = 0;
   client->content = 0;
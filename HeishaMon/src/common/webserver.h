@@ -98,14 +98,14 @@ typedef struct sendlist_t {
 
 #if !defined(ESP8266) && !defined(ESP32)
 struct WiFiClient {
-  int (*write)(unsigned char *, int i);
+  int (*write)(const unsigned char *, int i);
   int (*write_P)(const char *, int i);
   int (*available)();
   int (*connected)();
   void (*stop)();
   int (*read)(uint8_t *buffer, int size);
 };
-  #define PGM_P unsigned char *
+  #define PGM_P const char *
 #endif
 
 typedef struct webserver_t {
@@ -125,6 +125,7 @@ typedef struct webserver_t {
   uint32_t readlen;
   uint16_t content;
   uint8_t route;
+  uint8_t routeidx;
 #if WEBSERVER_MAX_SENDLIST == 0
   struct sendlist_t *sendlist;
   struct sendlist_t *sendlist_head;
@@ -132,7 +133,11 @@ typedef struct webserver_t {
   struct sendlist_t sendlist[WEBSERVER_MAX_SENDLIST];
 #endif
   webserver_cb_t *callback;
-  unsigned char buffer[WEBSERVER_BUFFER_SIZE];
+  /*
+   * One extra byte, the parsers terminate the
+   * buffered data with a 0 at buffer[ptr]
+   */
+  unsigned char buffer[WEBSERVER_BUFFER_SIZE+1];
   union {
     char *boundary;
     char *websockkey;
@@ -5,6 +5,8 @@
 
 #include "opentherm.h"
 
+OpenTherm *OpenTherm::transmitter = NULL;
+
 OpenTherm::OpenTherm(int inPin, int outPin, bool isSlave)
   : status(OpenThermStatus::NOT_INITIALIZED),
     inPin(inPin),
@@ -13,6 +15,12 @@ OpenTherm::OpenTherm(int inPin, int outPin, bool isSlave)
     response(0),
     responseStatus(OpenThermResponseStatus::NONE),
     responseTimestamp(0),
+    sendBits(0),
+    sendIndex(0),
+    sendDoneStatus(OpenThermStatus::READY),
+#if defined(ESP32)
+    sendTimer(NULL),
+#endif
     handleInterruptCallback(NULL),
     processResponseCallback(NULL) {
 }
@@ -24,6 +32,14 @@ void OpenTherm::begin(void (*handleInterruptCallback)(void), void (*processRespo
     this->handleInterruptCallback = handleInterruptCallback;
     attachInterrupt(digitalPinToInterrupt(inPin), handleInterruptCallback, CHANGE);
   }
+#if defined(ESP32)
+  if (sendTimer == NULL) {
+    sendTimer = timerBegin(1000000); // 1 MHz, a tick per us
+    timerAttachInterrupt(sendTimer, transmitInterrupt);
+    timerAlarm(sendTimer, OT_HALF_BIT_TIME, true, 0);
+    timerStop(sendTimer);
+  }
+#endif
   activateBoiler();
   status = OpenThermStatus::READY;
   this->processResponseCallback = processResponseCallback;
@@ -41,11 +57,11 @@ int IRAM_ATTR OpenTherm::readState() {
   return digitalRead(inPin);
 }
 
-void OpenTherm::setActiveState() {
+void IRAM_ATTR OpenTherm::setActiveState() {
   digitalWrite(outPin, !logicalSendHigh);
 }
 
-void OpenTherm::setIdleState() {
+void IRAM_ATTR OpenTherm::setIdleState() {
   digitalWrite(outPin, logicalSendHigh);
 }
 
@@ -54,13 +70,66 @@ void OpenTherm::activateBoiler() {
   delay(1000);
 }
 
-void OpenTherm::sendBit(bool high) {
-  if (high) setActiveState();
+// The frame is encoded once with its start and stop bit, a timer interrupt
+// each half bit drives the output. The ESP8266 uses timer1, which is free as
+// long as analogWrite, tone and Servo are not used.
+bool OpenTherm::startSending(unsigned long frame, OpenThermStatus doneStatus) {
+  noInterrupts();
+  const bool busy = (status == OpenThermStatus::REQUEST_SENDING);
+  if (!busy) {
+    status = OpenThermStatus::REQUEST_SENDING;
+  }
+  interrupts();
+  if (busy)
+    return false;
+
+  response = 0;
+  responseStatus = OpenThermResponseStatus::NONE;
+  responseTimestamp = micros();
+  sendBits = (1ULL << 33) | ((uint64_t)(frame & 0xFFFFFFFFUL) << 1) | 1ULL;
+  sendIndex = 0;
+  sendDoneStatus = doneStatus;
+  transmitter = this;
+
+  handleTransmitInterrupt(); //first half of the start bit right away
+#if defined(ESP32)
+  timerWrite(sendTimer, 0);
+  timerStart(sendTimer);
+#else
+  timer1_attachInterrupt(transmitInterrupt);
+  timer1_enable(TIM_DIV16, TIM_EDGE, TIM_LOOP); //5 MHz
+  timer1_write(OT_HALF_BIT_TIME * 5);
+#endif
+  return true;
+}
+
+void IRAM_ATTR OpenTherm::stopTimer() {
+#if defined(ESP32)
+  timerStop(sendTimer);
+#else
+  timer1_disable();
+#endif
+}
+
+void IRAM_ATTR OpenTherm::transmitInterrupt() {
+  if (transmitter != NULL) {
+    transmitter->handleTransmitInterrupt();
+  }
+}
+
+void IRAM_ATTR OpenTherm::handleTransmitInterrupt() {
+  if (sendIndex >= OT_FRAME_HALF_BITS) { //stop bit sent
+    stopTimer();
+    setIdleState();
+    responseTimestamp = micros();
+    status = sendDoneStatus;
+    return;
+  }
+  bool high = (sendBits >> (33 - sendIndex / 2)) & 1;
+  bool firstHalf = !(sendIndex & 1);
+  if (high == firstHalf) setActiveState();
   else setIdleState();
-  delayMicroseconds(500);
-  if (high) setIdleState();
-  else setActiveState();
-  delayMicroseconds(500);
+  sendIndex = sendIndex + 1;
 }
 
 bool OpenTherm::sendRequestAync(unsigned long request) {
@@ -72,20 +141,7 @@ bool OpenTherm::sendRequestAync(unsigned long request) {
   if (!ready)
     return false;
 
-  status = OpenThermStatus::REQUEST_SENDING;
-  response = 0;
-  responseStatus = OpenThermResponseStatus::NONE;
-
-  sendBit(HIGH);  //start bit
-  for (int i = 31; i >= 0; i--) {
-    sendBit(bitRead(request, i));
-  }
-  sendBit(HIGH);  //stop bit
-  setIdleState();
-
-  status = OpenThermStatus::RECEIVE_WAITING;
-  responseTimestamp = micros();
-  return true;
+  return startSending(request, OpenThermStatus::RECEIVE_WAITING);
 }
 
 unsigned long OpenTherm::sendRequest(unsigned long request) {
@@ -97,25 +153,19 @@ unsigned long OpenTherm::sendRequest(unsigned long request) {
   return response;
 }
 
+// Returns right away, isReady() is true again once the frame is sent
 bool OpenTherm::sendResponse(unsigned long request) {
-  status = OpenThermStatus::REQUEST_SENDING;
-  response = 0;
-  responseStatus = OpenThermResponseStatus::NONE;
-
-  sendBit(HIGH);  //start bit
-  for (int i = 31; i >= 0; i--) {
-    sendBit(bitRead(request, i));
-  }
-  sendBit(HIGH);  //stop bit
-  setIdleState();
-  status = OpenThermStatus::READY;
-  return true;
+  return startSending(request, OpenThermStatus::READY);
 }
 
 OpenThermResponseStatus OpenTherm::getLastResponseStatus() {
   return responseStatus;
 }
 
+unsigned long OpenTherm::getLastFrameTime() {
+  return responseTimestamp;
+}
+
 void IRAM_ATTR OpenTherm::handleInterrupt() {
   unsigned long newTs = micros();
 
@@ -159,6 +209,7 @@ void IRAM_ATTR OpenTherm::handleInterrupt() {
       status = OpenThermStatus::RECEIVE_DATA;
       responseTimestamp = newTs;
       responseBitIndex = 0;
+      response = 0; //unsigned long can be wider than the frame, e.g. on a host build
     } else {
       status = OpenThermStatus::RECEIVE_INVALID;
       responseTimestamp = newTs;
@@ -185,6 +236,8 @@ void OpenTherm::process() {
 
   unsigned long newTs = micros();
 
+  if (st == OpenThermStatus::REQUEST_SENDING) return; //the timer interrupt ends it
+
   if (st == OpenThermStatus::RECEIVE_START_BIT && (readState() == LOW) && ((newTs - ts) > 5000000)) {  //short circuit detected, act as on/off
     //Serial.println("Short circuit, switch to on/off");
     status = OpenThermStatus::ON_OFF;
@@ -289,17 +342,22 @@ unsigned long OpenTherm::buildResponse(OpenThermMessageType type, OpenThermMessa
 
 bool OpenTherm::isValidResponse(unsigned long response) {
   if (parity(response)) return false;
-  byte msgType = (response << 1) >> 29;
+  byte msgType = (response >> 28) & 7;
   return msgType == READ_ACK || msgType == WRITE_ACK;
 }
 
 bool OpenTherm::isValidRequest(unsigned long request) {
   if (parity(request)) return false;
-  byte msgType = (request << 1) >> 29;
+  byte msgType = (request >> 28) & 7;
   return msgType == READ_DATA || msgType == WRITE_DATA;
 }
 
 void OpenTherm::end() {
+  if (status == OpenThermStatus::REQUEST_SENDING) {
+    stopTimer();
+    setIdleState();
+    status = OpenThermStatus::READY;
+  }
   if (this->handleInterruptCallback != NULL) {
     detachInterrupt(digitalPinToInterrupt(inPin));
   }
@@ -16,6 +16,9 @@
 #include <stdint.h>
 #include <Arduino.h>
 
+#define OT_HALF_BIT_TIME 500 // us per half of a manchester coded bit
+#define OT_FRAME_HALF_BITS 68 // start bit, 32 data bits and stop bit
+
 enum OpenThermResponseStatus {
   NONE,
   SUCCESS,
@@ -133,6 +136,7 @@ class OpenTherm
     unsigned long buildRequest(OpenThermMessageType type, OpenThermMessageID id, unsigned int data);
     unsigned long buildResponse(OpenThermMessageType type, OpenThermMessageID id, unsigned int data);
     OpenThermResponseStatus getLastResponseStatus();
+    unsigned long getLastFrameTime(); // micros at the end of the last received frame, valid in the response callback
     //const char *statusToString(OpenThermResponseStatus status);
     void handleInterrupt();
     void process();
@@ -190,12 +194,24 @@ class OpenTherm
     bool logicalReceiveHigh = HIGH;
     bool logicalSendHigh = HIGH;
 
+    // frame being clocked out by the timer interrupt
+    volatile uint64_t sendBits;
+    volatile uint8_t sendIndex;
+    volatile OpenThermStatus sendDoneStatus;
+#if defined(ESP32)
+    hw_timer_t *sendTimer;
+#endif
+    static OpenTherm *transmitter;
+
     int readState();
     void setActiveState();
     void setIdleState();
     void activateBoiler();
 
-    void sendBit(bool high);
+    bool startSending(unsigned long frame, OpenThermStatus doneStatus);
+    void stopTimer();
+    void handleTransmitInterrupt();
+    static void transmitInterrupt();
     void(*handleInterruptCallback)();
     void(*processResponseCallback)(unsigned long, OpenThermResponseStatus);
 };
@@ -0,0 +1,66 @@
+#include "uartrx.h"
+
+uartRxStatsStruct uartRxStats;
+
+// Single producer (uart event task on ESP32, loop() on ESP8266), single
+// consumer (loop()), each index is only written by one side
+static byte ring[UART_RX_RING_SIZE];
+static uint16_t stamps[UART_RX_RING_SIZE]; // low 16 bits of the arrival millis
+static volatile uint16_t head = 0;
+static volatile uint16_t tail = 0;
+
+// Move everything the uart driver holds into the ring. The bytes arrived
+// back to back before now, so each gets its time on the line subtracted.
+void uartRxFill(HardwareSerial &serial) {
+  int count = serial.available();
+  unsigned long now = millis();
+  uint16_t h = head;
+  for (int i = 0; i < count; i++) {
+    int value = serial.read();
+    if (value < 0) {
+      break;
+    }
+    if ((uint16_t)(h - tail) >= UART_RX_RING_SIZE) {
+      uartRxStats.overruns++;
+      continue;
+    }
+    ring[h & (UART_RX_RING_SIZE - 1)] = value;
+    stamps[h & (UART_RX_RING_SIZE - 1)] = now - ((unsigned long)(count - 1 - i) * UART_RX_BYTE_TIME) / 1000;
+    h++;
+    uartRxStats.bytes++;
+  }
+  __sync_synchronize();
+  head = h;
+  if ((uint16_t)(h - tail) > uartRxStats.peak) {
+    uartRxStats.peak = (uint16_t)(h - tail);
+  }
+}
+
+// On ESP32 the uart event task fills the ring as soon as bytes arrive, on
+// ESP8266 the core isr buffers them and loop() fills the ring
+void uartRxBegin(HardwareSerial &serial) {
+#if defined(ESP32)
+  serial.setRxTimeout(2); // report a frame gap after 2 idle symbols
+  serial.onReceive([&serial]() {
+    uartRxFill(serial);
+  }, false);
+#endif
+}
+
+unsigned int uartRxAvailable() {
+  return (uint16_t)(head - tail);
+}
+
+bool uartRxRead(byte *value, unsigned long *time) {
+  uint16_t t = tail;
+  if (t == head) {
+    return false;
+  }
+  *value = ring[t & (UART_RX_RING_SIZE - 1)];
+  uint16_t stamp = stamps[t & (UART_RX_RING_SIZE - 1)];
+  unsigned long now = millis();
+  *time = now - (uint16_t)((uint16_t)now - stamp);
+  __sync_synchronize();
+  tail = t + 1;
+  return true;
+}
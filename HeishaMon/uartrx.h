@@ -0,0 +1,29 @@
+#ifndef _UARTRX_H_
+#define _UARTRX_H_
+
+#include <Arduino.h>
+
+// received bytes waiting for the frame parser, must be a power of 2
+#if defined(ESP8266)
+#define UART_RX_RING_SIZE 256
+#define UART_RX_DRIVER_SIZE 512 // rx buffer of the core uart isr, filled while loop() is busy
+#else
+#define UART_RX_RING_SIZE 1024
+#define UART_RX_DRIVER_SIZE 256
+#endif
+#define UART_RX_BYTE_TIME 1146 // us per byte on the 9600 baud 8E1 heatpump line (11 bits)
+
+struct uartRxStatsStruct {
+  unsigned long bytes = 0;
+  unsigned long overruns = 0; // bytes lost because the ring was full
+  unsigned int peak = 0; // highest ring fill
+};
+
+extern uartRxStatsStruct uartRxStats;
+
+void uartRxBegin(HardwareSerial &serial);
+void uartRxFill(HardwareSerial &serial);
+unsigned int uartRxAvailable();
+bool uartRxRead(byte *value, unsigned long *time);
+
+#endif
@@ -0,0 +1,937 @@
+// Generated by scripts/build_webui.py from the files in webui/. Do not edit.
+#ifndef _WEBASSETS_H_
+#define _WEBASSETS_H_
+
+struct webAssetStruct {
+  char path[32];
+  char mimetype[24];
+  char etag[9];
+  const uint8_t *data;
+  uint16_t len;
+};
+
+// heishamon.css: 19734 bytes, 4323 gzipped
+static const uint8_t webasset_heishamon_css[] FLASHPROG = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xe5,0x1c,0xd9,0x8e,0xe3,0xc6,
+  0xf1,0x7d,0xbe,0x82,0xc9,0xc0,0xd8,0x91,0x23,0xca,0xbc,0x24,0x51,0x14,0x12,0xc4,
+  0xc7,0xda,0xd9,0xc4,0x86,0x03,0xef,0xe6,0x42,0x60,0x04,0x14,0xd9,0x94,0x98,0xa5,
+  0x48,0x85,0xa4,0xe6,0xb0,0x30,0xff,0x90,0x97,0xfc,0x60,0xbe,0x24,0x55,0x7d,0x50,
+  0xdd,0xcd,0xa6,0xa4,0x99,0x5d,0x23,0xc6,0x7a,0x8f,0x59,0xa9,0xd9,0x5d,0xdd,0x55,
+  0x5d,0x77,0x15,0xf7,0x93,0x8f,0xad,0xff,0xfe,0xe7,0xdf,0x1f,0xde,0x9f,0x2b,0xcb,
+  0xb2,0xbe,0x7e,0xf5,0xd5,0xef,0xde,0x58,0xdf,0x7c,0xfb,0xc5,0x4b,0xeb,0xe6,0x8b,
+  0x97,0x5f,0x7e,0xfa,0xa7,0xaf,0xdf,0x8c,0x70,0xfc,0x83,0x44,0xd8,0xfa,0xf8,0x93,
+  0xab,0xa8,0xae,0xaa,0xd6,0x3a,0x00,0x8e,0xb6,0xbd,0x5a,0xdb,0xab,0xb8,0x21,0xd1,
+  0x75,0x16,0x66,0x8b,0x2c,0x5e,0x8a,0xc1,0x66,0x5f,0x67,0x71,0x82,0xe3,0xf4,0x57,
+  0x37,0x4e,0x0a,0x72,0x1b,0xb7,0x24,0x85,0x07,0x6e,0xe6,0x67,0xd3,0xee,0xc1,0xa6,
+  0xba,0x25,0x75,0x74,0x4d,0x16,0x24,0x21,0x62,0x7a,0x55,0xa7,0x38,0x96,0x12,0xe2,
+  0x91,0x99,0x3c,0x66,0x67,0x55,0xb2,0x6f,0xa2,0x6b,0x3f,0x9e,0xaf,0x52,0x0e,0xa3,
+  0x25,0xf7,0xad,0xbd,0xab,0xf3,0x6d,0x5c,0x3f,0x44,0xd7,0x9e,0xeb,0x4d,0xbd,0x85,
+  0xf4,0xa4,0x21,0x49,0x55,0xa6,0xf4,0x59,0xb0,0x98,0x3a,0xd3,0xb9,0xf4,0x6c,0xbb,
+  0xa7,0x27,0x9a,0x25,0xf3,0xe9,0x3c,0x65,0xe3,0x71,0x92,0x90,0xb2,0x55,0x77,0x60,
+  0x63,0xf6,0xba,0xa8,0xee,0xa2,0x7a,0xbd,0x8a,0x6f,0xa6,0xe1,0xd8,0xf5,0xfc,0xb1,
+  0xe7,0xfa,0x63,0x67,0xe2,0x4e,0x47,0xca,0x34,0x8e,0xd0,0x34,0x5e,0xac,0x48,0xc8,
+  0x9e,0xd4,0xb8,0x4b,0x9a,0xf8,0xd3,0x60,0xda,0x0d,0x48,0xe0,0x3c,0xcf,0x19,0x4f,
+  0xfd,0xf1,0x6c,0x21,0x43,0x5b,0xd7,0x84,0x94,0x80,0x4f,0x18,0xcf,0xc5,0x2a,0x3a,
+  0x24,0xad,0x0b,0x9c,0xb1,0x3b,0x9b,0x6b,0xeb,0xaa,0x3a,0x2e,0xd7,0x48,0xff,0x74,
+  0x4e,0xdc,0x80,0x6f,0x17,0xa7,0x39,0x90,0x2d,0xdc,0xdd,0xcb,0xdf,0xed,0x66,0x1b,
+  0x4d,0xb5,0xa1,0x62,0x1d,0xb9,0x1e,0x8e,0x3d,0x5e,0x5d,0x7d,0xf2,0x01,0xcb,0xee,
+  0x17,0x9f,0x7e,0xf7,0x07,0x2a,0xba,0x1f,0xb4,0xc0,0x6e,0xda,0x6d,0x31,0x01,0xde,
+  0x7f,0x6b,0x6f,0xab,0x94,0xe8,0x92,0xeb,0x64,0xae,0xeb,0xce,0xfb,0x92,0xeb,0xce,
+  0xdc,0x85,0xe7,0x19,0x24,0xd7,0x25,0x9e,0xe7,0x3b,0xba,0xe4,0x7a,0x33,0x6f,0xe5,
+  0xc7,0xaa,0xe4,0x7a,0xb1,0xef,0x04,0xce,0xd3,0x24,0x97,0x90,0xcc,0xc9,0x02,0xb3,
+  0xe4,0xce,0x57,0xe1,0x74,0x61,0x90,0x5c,0x79,0xfc,0xe9,0x92,0xeb,0x5d,0x28,0xb9,
+  0x64,0x1e,0x24,0x53,0x62,0x94,0x5c,0xdf,0x1d,0xcf,0x67,0xe3,0x45,0x20,0x43,0x13,
+  0x92,0x4b,0x92,0x64,0x11,0x0c,0x48,0xee,0x6c,0xec,0x39,0xc1,0xd8,0x0d,0x42,0x5c,
+  0xa8,0x4b,0xae,0x13,0x4f,0x1d,0xe7,0x83,0x17,0xc1,0xcf,0x3e,0x7d,0xfd,0xd2,0x7a,
+  0xfd,0xe6,0x6f,0x5f,0xbf,0x7c,0x6d,0xdd,0xd4,0x64,0x1b,0xe7,0xa5,0xb5,0x2f,0x93,
+  0x0d,0x12,0x21,0xfd,0xb0,0x0d,0xe9,0xc7,0x87,0x55,0x75,0x6f,0x37,0xf9,0x0f,0x79,
+  0xb9,0x8e,0xb8,0x7c,0xc0,0xc8,0x12,0x04,0x61,0x9d,0x97,0x91,0xb3,0xdc,0xc5,0x69,
+  0x8a,0xcf,0x9c,0x47,0x2a,0xc3,0x87,0xac,0x02,0xf6,0x84,0xf9,0x24,0x72,0x51,0x63,
+  0xdb,0x77,0x64,0xf5,0x36,0x6f,0xb9,0x98,0xc0,0xb0,0x1d,0xa7,0xff,0xdc,0x37,0x6d,
+  0xe4,0x3a,0xce,0x47,0x8f,0x57,0xab,0x2a,0x7d,0x40,0x59,0xa7,0xab,0xb2,0x78,0x9b,
+  0x17,0x0f,0xd1,0x8b,0xd7,0xc0,0x5e,0x2f,0xc6,0x4d,0x5c,0x82,0xde,0x27,0x75,0x4e,
+  0x4d,0xed,0x2a,0x4e,0xde,0xae,0xeb,0x6a,0x5f,0xa6,0xd1,0x6d,0x5c,0xdf,0x74,0xba,
+  0x81,0x32,0x64,0x52,0x15,0x55,0xcd,0xc7,0x65,0x49,0xa5,0x0f,0xb7,0x79,0x69,0x6f,
+  0x48,0xbe,0xde,0xd0,0x3d,0x6f,0x37,0x38,0x56,0xe4,0x25,0xe9,0x06,0x27,0x54,0x02,
+  0x5b,0x60,0xe9,0x26,0x6f,0xf3,0xaa,0x8c,0x8e,0x7b,0x59,0xce,0xc4,0x6f,0xc6,0x0c,
+  0x3e,0xfd,0x4c,0x59,0x7d,0xd2,0x56,0xbb,0x55,0x5c,0xe3,0xb9,0xd3,0xbc,0xd9,0x15,
+  0xf1,0x43,0x94,0x15,0x84,0x5a,0xa7,0xb8,0xc8,0xd7,0xa5,0x9d,0xb7,0x64,0xdb,0x44,
+  0x28,0xa8,0xa4,0xc6,0x51,0x44,0x38,0xcf,0x1e,0x6c,0x50,0x12,0x2d,0x0a,0x7e,0xb3,
+  0x03,0xed,0x65,0xaf,0x48,0x7b,0x07,0xb2,0x36,0x84,0x1d,0x57,0x72,0x14,0x87,0x8e,
+  0xf0,0x6d,0x5b,0x6d,0x23,0x77,0x77,0x6f,0x35,0x55,0x91,0xa7,0x16,0x9f,0x4c,0x9f,
+  0xd2,0x89,0xdd,0x6d,0x58,0x5e,0xc0,0xec,0x25,0xc7,0x72,0x3a,0x63,0x5f,0x77,0x15,
+  0x47,0x12,0x4e,0x94,0xbc,0x7d,0xa0,0x98,0x57,0x3b,0xb8,0xc7,0x1f,0xec,0xbc,0x4c,
+  0xc9,0x3d,0xd2,0x08,0x91,0xe4,0x38,0xda,0x05,0xc9,0xda,0x83,0x82,0xa5,0x01,0xc5,
+  0x75,0xbc,0x8b,0x5c,0xd8,0x40,0x5a,0x56,0xad,0xab,0xde,0xbd,0xfe,0x9e,0xb4,0x9f,
+  0xd5,0x20,0x3b,0x8d,0xf5,0x4d,0x55,0x56,0x2f,0xc6,0x5b,0xf8,0x49,0x49,0xb1,0x14,
+  0x33,0x19,0xdf,0xa0,0xf1,0xa7,0x5f,0xef,0xf8,0xd9,0x1d,0x47,0xbf,0x65,0xa6,0x06,
+  0x29,0xca,0x05,0x69,0xe1,0x0c,0x36,0x02,0x42,0xcc,0x6d,0x67,0xc2,0x3d,0x05,0xca,
+  0x09,0x29,0x68,0xe6,0x3a,0xa6,0x18,0x97,0x55,0x49,0x14,0xd4,0xe0,0x8c,0x16,0x2c,
+  0x2b,0x0f,0x3d,0xfe,0xe9,0xf4,0xf9,0x48,0x39,0x48,0xe0,0x00,0x97,0x4f,0x36,0xf1,
+  0x76,0xb5,0xaf,0xd7,0x84,0x32,0x80,0x74,0x73,0x14,0x3e,0x37,0x2b,0x6c,0x2f,0x03,
+  0x67,0x4a,0x90,0x15,0xa4,0x3d,0x07,0x0e,0x9d,0xec,0xeb,0x06,0xa6,0xef,0xaa,0x5c,
+  0x70,0x8e,0xb8,0x4f,0xbc,0x3d,0xce,0x04,0xdc,0x43,0x62,0x30,0x3b,0xf7,0x68,0x34,
+  0xcc,0xc3,0x13,0xaf,0x19,0x33,0x0e,0x86,0x4f,0x94,0x00,0x1d,0x06,0x11,0xb5,0x23,
+  0x07,0x13,0xfb,0x09,0x5b,0x3a,0x5a,0x0e,0x4a,0x17,0x40,0x6a,0xf2,0x94,0x6c,0x49,
+  0xb9,0x3f,0xc8,0xac,0x95,0xe5,0xf7,0x24,0x5d,0x32,0xb6,0x42,0xfe,0x89,0x6c,0x2f,
+  0x40,0xf4,0xee,0xf2,0xb4,0xdd,0x44,0xec,0xf3,0x51,0x22,0x3f,0x7a,0x82,0x00,0xd4,
+  0x6c,0xd1,0x30,0xff,0x0b,0x2e,0xf6,0x18,0xcb,0x48,0x04,0xc1,0x83,0x58,0x20,0xc1,
+  0x56,0xb2,0x5f,0xe5,0x09,0x08,0xdf,0x0f,0x39,0xa9,0x6f,0x26,0x60,0x0e,0xc7,0x13,
+  0x6f,0xec,0xd2,0xd5,0x0a,0x9f,0xe3,0x0f,0x3b,0xcd,0x6b,0x92,0xd0,0xf5,0x40,0x85,
+  0xfd,0x96,0x0a,0x2b,0x92,0x2c,0x03,0xfb,0x68,0x3f,0x44,0xf1,0xbe,0xad,0x28,0x45,
+  0x05,0x1d,0x26,0xd5,0x8e,0x94,0x07,0x8a,0xb4,0x23,0x0d,0xdb,0xb8,0x06,0x20,0xcb,
+  0x2a,0x83,0xb2,0x88,0x46,0x33,0x90,0x0d,0x02,0x2b,0x35,0x8a,0x50,0x3b,0xec,0x8c,
+  0xf1,0xf7,0x24,0x00,0xd3,0xdd,0x89,0xea,0x62,0xa1,0x6c,0x2e,0x76,0x61,0x87,0x10,
+  0xfb,0xac,0x8a,0x2a,0x79,0x2b,0xcf,0xda,0x90,0x38,0x65,0xcc,0x2b,0xb8,0x0b,0x75,
+  0x85,0x85,0x1c,0x68,0xb9,0x5c,0x4d,0x5c,0xa8,0x70,0xfa,0x60,0xad,0x8d,0xf7,0x6c,
+  0xb9,0x47,0xb9,0x35,0x09,0x79,0x4f,0x17,0x18,0xb6,0xdd,0xc9,0x86,0xc7,0xd5,0x00,
+  0x1d,0xfd,0xb0,0x11,0x37,0x5c,0x36,0x72,0xa7,0x47,0x35,0x56,0x07,0xa9,0x8c,0x6f,
+  0x0f,0x82,0x22,0x21,0xd2,0x02,0xa3,0x0b,0xe4,0x82,0xc8,0xd5,0xa6,0x59,0x71,0x4f,
+  0xf7,0x0f,0x69,0x45,0x87,0xab,0x5d,0x0e,0xd7,0x75,0x04,0xe0,0xf3,0xca,0xc1,0xa8,
+  0xbf,0x86,0x95,0x80,0xa6,0x50,0x5c,0x5f,0xd3,0xa2,0x41,0x4f,0x24,0x64,0x1d,0xe1,
+  0x86,0x9d,0x92,0x80,0x8f,0xd4,0x6e,0x32,0x42,0x71,0x16,0xe0,0x91,0x96,0x46,0x86,
+  0xf7,0xa6,0x3f,0x18,0x38,0x08,0x00,0x4a,0xd4,0xab,0xf2,0x0a,0xf0,0x62,0x07,0x27,
+  0x0e,0x6d,0x2f,0x3c,0xdf,0xde,0xc2,0x09,0xfc,0xb0,0x73,0x20,0xf2,0x81,0xe9,0x22,
+  0xca,0xee,0xf4,0x4c,0xf4,0xfe,0xc4,0xcd,0x55,0x68,0x4b,0xda,0x87,0x68,0x32,0x97,
+  0x01,0x64,0x55,0xd5,0xaa,0x72,0x83,0xcb,0xa9,0xdc,0x48,0x22,0x83,0x8c,0x75,0x42,
+  0x41,0x5d,0xc8,0xa5,0x57,0xfd,0x8d,0x81,0xe9,0x4c,0xc2,0x61,0xe2,0x12,0xd3,0x62,
+  0x4e,0x2b,0x7d,0x3a,0x10,0x0d,0x74,0x46,0x4e,0xd7,0xb4,0xf1,0x0a,0x65,0x40,0x67,
+  0x6d,0xe4,0xe3,0x40,0x63,0x63,0x0f,0x11,0x47,0xad,0xe1,0x9c,0x75,0xce,0xa8,0x1e,
+  0xbd,0xab,0x01,0x08,0xfe,0x60,0x06,0x98,0x6e,0x64,0xad,0xf6,0xc0,0x5a,0xe5,0x73,
+  0xac,0xa8,0xa0,0xd2,0x05,0x8e,0xa3,0x44,0xf0,0xc0,0xec,0x57,0x28,0xb2,0xa9,0xdd,
+  0xe6,0x80,0xb1,0xb5,0x7a,0x03,0x0e,0xa3,0x44,0xdf,0x82,0x4b,0xf2,0xd6,0x19,0xe1,
+  0xb1,0x6a,0x9d,0x0d,0x5e,0xcc,0xc4,0x17,0x8c,0x49,0xd7,0x67,0x55,0xbd,0x8d,0xf6,
+  0xbb,0x1d,0xa9,0x13,0x20,0xab,0xe2,0xc7,0xd5,0xa4,0x80,0x9b,0xbc,0x25,0x7d,0xc2,
+  0x46,0x51,0x9c,0x71,0x86,0x15,0x8e,0xe7,0x8b,0x17,0x47,0x8b,0x13,0xaf,0x80,0x45,
+  0x81,0x8e,0x0c,0x5b,0x2a,0xe4,0xdc,0x5c,0x53,0xa9,0xe0,0xa6,0x76,0x76,0xb4,0xd5,
+  0x5c,0x6b,0x49,0x77,0x45,0xcf,0xb6,0x8b,0x6b,0x00,0xdd,0xa7,0x99,0xcb,0xbd,0xb0,
+  0x01,0x9f,0x64,0xda,0x18,0x4e,0xcc,0x78,0xf4,0x94,0x5e,0x3c,0xa9,0x6a,0x74,0x78,
+  0x93,0x38,0x41,0xd2,0x98,0xe4,0x66,0x60,0xaa,0xa0,0x59,0x6f,0x9b,0xe3,0x32,0x8c,
+  0xfe,0x84,0x27,0xdf,0xd9,0x0b,0x6a,0x3c,0xa9,0x40,0xa0,0x77,0x83,0xf2,0xd7,0xc6,
+  0xed,0xbe,0x31,0x45,0x09,0x9a,0x3c,0x50,0x2b,0xc1,0x49,0xab,0xa9,0x5c,0x47,0xe8,
+  0x5c,0x0a,0xcb,0x4e,0x36,0xf9,0xee,0x52,0xbb,0x13,0xf6,0xee,0xea,0x84,0x5b,0x75,
+  0x4a,0x5f,0xa9,0x77,0xea,0x69,0xe6,0x0c,0xf5,0x9f,0xcb,0x75,0x83,0x24,0x68,0x9e,
+  0x49,0xb3,0xc9,0xc6,0x4d,0x45,0xca,0x9a,0xe0,0x4f,0xbb,0x88,0x57,0xa4,0x38,0x0c,
+  0xc9,0xba,0x04,0x9e,0x79,0xf8,0x83,0xd2,0xa1,0x8b,0xd2,0x54,0xba,0x10,0x79,0xbf,
+  0xdb,0xb8,0xd8,0x93,0xc3,0x70,0xec,0x78,0xa1,0x0f,0xa3,0xe1,0xad,0x29,0x18,0x75,
+  0xe7,0x49,0x91,0x37,0xc0,0x37,0x76,0x55,0x16,0x0f,0x07,0x4e,0x5a,0xf9,0x00,0x2c,
+  0xaf,0xa2,0x70,0x39,0x4b,0xde,0xd0,0xfc,0xe9,0x14,0x1d,0x40,0x27,0x1c,0x0d,0xc3,
+  0x1c,0xc4,0x8c,0x03,0xd6,0x56,0xd6,0xfb,0x82,0x34,0x36,0xe3,0x7c,0x4b,0xe6,0x79,
+  0x34,0x08,0x10,0x21,0xad,0xf1,0xda,0x81,0xa9,0x6e,0x5c,0x7f,0x9a,0x92,0xf5,0x98,
+  0x9e,0xc5,0xf7,0xc7,0xee,0xd4,0x19,0x7b,0x01,0xe6,0xa5,0xe0,0x34,0x86,0x51,0xd7,
+  0x1b,0x8d,0x96,0x0a,0x7a,0xfd,0x39,0xde,0x68,0x79,0xea,0x34,0x12,0x22,0x16,0xc7,
+  0xe4,0xda,0x73,0x17,0xb3,0x2f,0x7d,0x85,0xc2,0x33,0x50,0xe1,0x46,0x30,0x79,0xf9,
+  0x44,0xb4,0x5c,0xcc,0xb7,0xf1,0xbf,0x80,0xd7,0x74,0x64,0x1c,0x0e,0x8d,0x88,0xa9,
+  0x93,0x30,0xbf,0x7d,0xfa,0x4c,0x26,0xe4,0x16,0x04,0x7f,0xf7,0xec,0xd3,0x11,0x50,
+  0x5a,0xb5,0xdc,0x6b,0x09,0x8f,0x3a,0x39,0xec,0xc5,0x85,0x53,0x08,0xa8,0xb8,0x1e,
+  0xa9,0xbb,0x29,0xc3,0xc9,0x0d,0x75,0x83,0x09,0xb9,0x4f,0x48,0x51,0xa0,0x66,0x93,
+  0xc8,0x26,0xf2,0x83,0xea,0xd4,0x75,0x55,0xa5,0xca,0x2c,0x9e,0xcd,0x54,0x67,0x65,
+  0x71,0xae,0x68,0x53,0x91,0x32,0x54,0x67,0xed,0xaa,0x4a,0x9d,0xc5,0xf3,0x98,0xea,
+  0x2c,0x50,0x7c,0xa0,0x42,0x4a,0x08,0xc8,0x88,0xba,0xf3,0x6c,0x35,0xf7,0x42,0x0a,
+  0x13,0xa2,0x79,0xd0,0x21,0x3f,0x82,0xe6,0x53,0x0c,0x7e,0xb1,0x1e,0xc9,0x81,0x60,
+  0xb4,0xc9,0xd3,0x14,0x13,0x39,0xe2,0x00,0x86,0x10,0xcb,0x0d,0xfa,0xce,0xc5,0xf9,
+  0x74,0xce,0x39,0x55,0x7f,0x26,0xb1,0xa4,0x9d,0xc7,0xda,0xf8,0x87,0x13,0x01,0x02,
+  0x5e,0xcb,0xb0,0x36,0xd4,0xb5,0x2a,0x0b,0x9e,0x14,0xf0,0xfc,0xdb,0x96,0xb4,0xf1,
+  0x85,0xd1,0xd8,0xe3,0x15,0x18,0xe1,0x82,0x20,0xa1,0xb8,0x43,0x8e,0xf9,0x80,0xa3,
+  0x80,0x15,0xf1,0xae,0x21,0x91,0xf8,0xa0,0x5b,0x19,0x96,0xe8,0x01,0x18,0xb8,0xbf,
+  0xd5,0x6e,0x0e,0x22,0x68,0x62,0xce,0x3c,0xfa,0x32,0xfd,0xd8,0x6b,0x36,0x10,0x7b,
+  0x69,0x2e,0xa5,0x6c,0x69,0x74,0x85,0x23,0xb6,0xb9,0xc4,0xf8,0xcc,0x87,0x0d,0x71,
+  0xe7,0x21,0x5f,0x9e,0xdd,0xd3,0x92,0x77,0x18,0x6b,0xb0,0xc4,0x1e,0x10,0x01,0x53,
+  0xa9,0xe0,0x6d,0x1d,0x4e,0x00,0x64,0x09,0x7d,0x6f,0x1c,0x84,0xe3,0x59,0x30,0x9e,
+  0x4c,0x4f,0x25,0x8d,0x5c,0xe6,0xa0,0x09,0xb0,0x97,0x44,0x7a,0xd2,0xec,0x22,0x6e,
+  0x5a,0x54,0x7d,0x45,0x7a,0x50,0x0f,0xc3,0xc2,0x13,0x3e,0x2f,0x95,0x25,0x64,0x71,
+  0xea,0x76,0x54,0xe7,0x41,0x2c,0x8f,0xb2,0xbc,0xee,0xf6,0x79,0x9f,0x86,0xdc,0xe5,
+  0x4e,0xc3,0x7e,0x97,0x02,0x66,0x36,0xc9,0x32,0x50,0x3a,0x78,0xd8,0xb8,0x04,0x98,
+  0x2c,0x61,0x03,0x28,0x6e,0x6c,0x36,0xc1,0x72,0xc1,0x8b,0xb7,0x08,0xdc,0xa7,0x5d,
+  0xed,0x5b,0x3c,0xe1,0x6f,0xdf,0x92,0x87,0xac,0x8e,0xb7,0xa4,0xb1,0x94,0x89,0x08,
+  0xc3,0xf9,0x48,0x28,0x7d,0xcb,0x10,0xca,0x35,0x9b,0x38,0x05,0x95,0x82,0x01,0x85,
+  0x45,0x39,0x56,0x9e,0xc3,0xa2,0xda,0x31,0x7d,0x48,0xbd,0xcd,0xfe,0xc3,0xe5,0x91,
+  0x2b,0xad,0x26,0x89,0x0b,0x72,0xe3,0xa2,0xd9,0x02,0xe5,0x68,0x59,0x53,0xdc,0xba,
+  0xff,0x1c,0x1e,0x46,0xf0,0x14,0x65,0x4f,0x3b,0x99,0x4e,0x7b,0xe5,0x84,0x34,0x3a,
+  0x7b,0x04,0x64,0xaf,0x93,0x22,0xd7,0x44,0x58,0x65,0xf9,0x6b,0x27,0x76,0x12,0x27,
+  0x3b,0xde,0xec,0xf5,0x8c,0x90,0xf9,0x6a,0xfe,0xae,0x8a,0x58,0x49,0x79,0x53,0x0d,
+  0x2b,0x18,0xe8,0x59,0xf9,0x27,0x57,0x64,0x8e,0x6b,0x42,0x07,0x28,0x82,0x96,0xf5,
+  0xc9,0xc7,0xd6,0xe7,0xac,0xd4,0x63,0x65,0x75,0xb5,0xb5,0x40,0x0e,0x40,0xfc,0xe2,
+  0xc2,0x6a,0x2b,0x4a,0x03,0xab,0xc9,0xcb,0x84,0x58,0x77,0xe4,0x45,0x4d,0x2c,0xcc,
+  0x08,0xf2,0x72,0x09,0x96,0x4f,0xc0,0x48,0xec,0x5b,0x74,0x3b,0xba,0x58,0x56,0x2d,
+  0x3d,0xcc,0x68,0x41,0x01,0x09,0x18,0xd1,0xaa,0xa3,0xc9,0x29,0x94,0xab,0x92,0xe8,
+  0x7d,0xdc,0x8b,0x1b,0x70,0x28,0x1f,0xf8,0x46,0x36,0xc0,0x32,0x05,0x5c,0x1b,0x90,
+  0x94,0xd8,0x6d,0xb5,0x5e,0xc3,0x3f,0x49,0xb5,0x05,0xa4,0x59,0x57,0xc4,0x65,0x75,
+  0x0b,0x8c,0x24,0xb8,0x7a,0xd1,0x81,0x51,0x67,0x5d,0x01,0xa9,0x69,0xfc,0x0b,0x74,
+  0xac,0x96,0x98,0x3a,0x11,0xed,0x6a,0x5a,0xd5,0xa1,0xe1,0x31,0x0d,0x1f,0x37,0x64,
+  0x4b,0xec,0xe6,0x2e,0x6f,0x93,0x8d,0x72,0x1a,0x43,0x7c,0x2c,0x18,0xd4,0xf7,0x94,
+  0xca,0x08,0x2d,0x37,0x0c,0xc2,0xca,0xcb,0xdd,0x9e,0x41,0x14,0x49,0x21,0xe7,0x08,
+  0xc9,0x91,0xc0,0x38,0x32,0x0c,0xe0,0x63,0x7a,0x89,0x86,0xf3,0xc8,0x61,0xb7,0x21,
+  0x5b,0x40,0x93,0xe6,0x14,0xe3,0x8c,0x27,0x82,0x6b,0x01,0x5e,0x0a,0xd3,0x8d,0x16,
+  0xe5,0x28,0x31,0x92,0x4a,0x67,0x45,0xab,0x5e,0x6c,0xae,0xe1,0xac,0x9c,0x37,0x5a,
+  0x11,0xb8,0x01,0x72,0xe2,0xd8,0xdc,0xdb,0xf8,0xe5,0x2f,0x65,0x32,0xf2,0x30,0x90,
+  0x2b,0x01,0xfe,0x8d,0xa2,0x21,0x12,0x07,0x52,0x26,0x51,0x39,0xff,0xdd,0x26,0x67,
+  0x80,0xcf,0x9e,0x1b,0x9d,0x5b,0x38,0x36,0xbd,0x94,0x28,0xd9,0x90,0xe4,0x2d,0x08,
+  0xe5,0xaf,0xac,0x61,0xb2,0x0f,0xc5,0xf1,0x17,0x43,0x91,0x89,0x71,0x64,0x4e,0xfa,
+  0x09,0xf8,0x8a,0xfc,0xf5,0x06,0x31,0x95,0xc0,0x81,0x60,0xa1,0x47,0x73,0xfa,0x54,
+  0x1d,0x2b,0x4d,0x02,0x89,0x0d,0xca,0x0a,0x3d,0x17,0x10,0x5e,0x92,0xb2,0x32,0x23,
+  0x08,0x65,0xdc,0xd8,0x24,0xcd,0xa9,0xe9,0xd1,0x15,0x49,0x4f,0x71,0x9e,0xcc,0xc6,
+  0x98,0xca,0x45,0x42,0x73,0xa2,0x06,0xe1,0x7a,0x13,0x8b,0xa5,0x3c,0xc8,0x70,0xfa,
+  0x61,0xbd,0xd0,0x8f,0x67,0x12,0xd7,0xc3,0x19,0x22,0xd9,0xd7,0x90,0x14,0x9d,0x31,
+  0x27,0xf6,0x28,0x13,0x80,0xb9,0x1f,0x63,0x79,0x84,0xe9,0xcb,0x23,0xa2,0x7d,0x95,
+  0x39,0x1a,0xf2,0xbc,0x8e,0xb9,0x69,0x6d,0x97,0xe7,0xea,0x60,0x6f,0x40,0x07,0x63,
+  0x8e,0xc9,0x46,0xaf,0xf8,0x20,0x57,0x7d,0xa4,0x71,0x91,0xa1,0xea,0x15,0x6b,0x40,
+  0xe1,0xc1,0xd5,0x34,0x10,0xab,0xe6,0xa9,0xac,0xb0,0xf1,0xbb,0x50,0xcd,0xbc,0x12,
+  0xc2,0xa6,0xda,0x75,0x75,0x67,0x9c,0x08,0xff,0xc2,0x25,0x6d,0x77,0xc8,0xae,0x36,
+  0xab,0x62,0x35,0x91,0x17,0x52,0x67,0x38,0xab,0x87,0x95,0xbf,0x9a,0xeb,0x3d,0x13,
+  0xb9,0x68,0x9e,0x65,0x30,0x12,0x67,0x74,0xb9,0xfd,0xf8,0xed,0x16,0x08,0x1c,0xdf,
+  0x6c,0xe3,0x7b,0xce,0x5f,0x01,0x9e,0x60,0x84,0x27,0x56,0x30,0x30,0x1f,0x17,0x0e,
+  0xfa,0x28,0xcf,0x64,0xa9,0x22,0xcd,0xd7,0x7f,0xd4,0xa8,0x71,0xce,0x09,0x55,0xe6,
+  0xf6,0xdc,0x5b,0x96,0xb1,0x70,0xc6,0x7e,0x80,0x48,0x01,0x46,0xd2,0x02,0xb6,0xfd,
+  0xf3,0x84,0x43,0x3a,0x34,0xd5,0xec,0x46,0x6b,0x28,0xed,0x45,0xd5,0xca,0xe1,0xb2,
+  0x10,0xe2,0x94,0x17,0x75,0xb2,0x47,0xe2,0x29,0x59,0xf4,0x0e,0x51,0xc1,0x20,0x73,
+  0xe4,0xa4,0x8b,0xd2,0xe6,0x4b,0x83,0x1a,0x3b,0xa9,0x12,0x3a,0x39,0x13,0x69,0x72,
+  0xc9,0xc5,0x3c,0xb2,0x92,0x7f,0xcc,0x94,0xca,0x44,0x7b,0xef,0x1e,0x95,0x0a,0xfe,
+  0xef,0xed,0xc3,0x8e,0xfc,0x7a,0x17,0x37,0xcd,0x1d,0x80,0xfb,0xfe,0xa0,0xf9,0x28,
+  0x34,0x3e,0x6e,0x40,0xd3,0x24,0xad,0x76,0x97,0x31,0x78,0x36,0x31,0x60,0x9d,0x10,
+  0x5a,0x3f,0x96,0xe0,0x6e,0xc0,0x0f,0x78,0x62,0x1d,0x93,0x1a,0xd8,0x90,0x65,0x38,
+  0x8f,0xec,0x8c,0x19,0x26,0x30,0x6b,0x88,0x19,0x26,0x99,0x0f,0x17,0xa6,0x8c,0xd1,
+  0xcd,0x93,0xd7,0x59,0x12,0xa2,0xe2,0xc1,0xf7,0xa2,0x74,0x36,0x97,0xaa,0xf8,0xf8,
+  0x99,0xd3,0xca,0x54,0xa3,0x52,0xfd,0x1c,0xd8,0x05,0x59,0xa2,0xb2,0x91,0x9b,0xb5,
+  0xb3,0x75,0x2a,0x43,0xcd,0x92,0xab,0x4b,0x2c,0x26,0x7f,0x97,0x20,0x35,0x13,0xe1,
+  0xfb,0x65,0x89,0xe9,0x53,0x07,0x95,0x89,0x41,0x87,0xbf,0x3f,0x0c,0xa3,0x4c,0xaf,
+  0x83,0x36,0x0e,0xd8,0x69,0x7e,0x9b,0xeb,0xc9,0x20,0x51,0x69,0xb2,0xfa,0xb9,0xf3,
+  0xc1,0x94,0xc3,0x09,0x6f,0xfa,0xe2,0x6c,0x44,0x78,0x36,0x1b,0x01,0x07,0x5f,0xb5,
+  0xa5,0x6c,0x48,0xf2,0x92,0x86,0x2c,0x97,0xa6,0xa0,0xfa,0x06,0x24,0xbc,0xb8,0xac,
+  0xf6,0x3c,0x55,0x64,0x6a,0x15,0x52,0x1d,0x6b,0xad,0x9c,0x38,0xdc,0x26,0xa3,0x2a,
+  0x9c,0x71,0x47,0x52,0x6b,0xe2,0x36,0xc3,0x2d,0x45,0xe6,0xea,0x1d,0x27,0x65,0xc4,
+  0x2d,0xfc,0xf1,0x7a,0x58,0xd4,0x3d,0x59,0xcc,0x47,0x6c,0x86,0xd0,0xc4,0x83,0x45,
+  0x27,0xce,0xb2,0xd8,0xa7,0xae,0xae,0x18,0x4a,0xca,0xc8,0x4d,0xa2,0x9a,0x7e,0x0b,
+  0x78,0xc5,0xc6,0xac,0xe0,0x10,0x36,0xaf,0xc1,0x9b,0x8a,0xea,0x86,0x93,0x0c,0x15,
+  0xe2,0xaf,0xd3,0x99,0x1f,0x07,0xe9,0xc9,0xcd,0xe5,0x32,0x3d,0xc2,0x5a,0x6f,0xaa,
+  0x46,0x37,0x75,0x9a,0x03,0x79,0xce,0xf3,0x3c,0x63,0x06,0xe5,0x8d,0xde,0xb9,0x77,
+  0x01,0x2f,0x57,0xb8,0xfb,0x87,0xae,0x65,0x20,0x58,0x1a,0xdc,0xf9,0xe3,0xe5,0x73,
+  0xd7,0x03,0x3f,0xd3,0x52,0x07,0x44,0xd5,0x4a,0x11,0x71,0xd9,0x57,0x87,0xa8,0xb4,
+  0xfa,0x82,0x07,0x40,0x8a,0x2a,0xc6,0x75,0xa6,0xe6,0xa2,0xe7,0x4b,0xeb,0x4c,0xae,
+  0x82,0x5f,0x96,0x25,0x15,0xdc,0xde,0xec,0xf2,0xb2,0x64,0x9a,0x8e,0xb7,0x7a,0x49,
+  0x9d,0x5e,0xaa,0x06,0x40,0xf3,0x78,0x26,0xdf,0x03,0xa1,0xb0,0x3d,0xd0,0xf2,0x67,
+  0x08,0x0a,0xe5,0xd4,0x1c,0x9e,0xc3,0x9a,0xcc,0x1b,0x8b,0xd5,0x7b,0x40,0x71,0x67,
+  0x79,0xc9,0x43,0x4c,0xa5,0x34,0xe2,0x72,0xbf,0x41,0xca,0xd6,0xe1,0xda,0x43,0x5b,
+  0x49,0xe2,0x5a,0x57,0x2d,0xf0,0xc2,0x8d,0x3f,0x73,0x52,0xb2,0x1e,0x3d,0xe2,0xe5,
+  0xe5,0xf5,0xf6,0x0e,0x58,0x92,0x52,0x31,0xce,0x11,0xe5,0xa3,0x33,0x32,0xa3,0x88,
+  0x8a,0xf6,0x58,0x9a,0x0f,0xea,0x7a,0x64,0x03,0x51,0x25,0x96,0x81,0xc0,0x8f,0x12,
+  0x1e,0x1e,0x0c,0x3d,0x5f,0xc7,0x9e,0x6d,0x9a,0xc2,0x33,0x31,0xb8,0x3e,0x8f,0xb7,
+  0x76,0x3f,0x29,0x67,0x16,0x1a,0x0b,0xb8,0xda,0xf5,0xd7,0xfc,0xde,0xe5,0xfe,0x29,
+  0xc4,0xd4,0x90,0xcf,0xea,0xe1,0x66,0x35,0x6d,0x5d,0x01,0x8a,0xa7,0xa4,0xa9,0x5b,
+  0x03,0xb7,0x55,0x99,0x88,0x21,0xf5,0xc3,0x9f,0xa6,0x86,0x3c,0xf1,0x89,0xe4,0x90,
+  0xfb,0x79,0x9e,0xe1,0xdb,0x1b,0xea,0xf7,0x2a,0x79,0x42,0x95,0x3c,0x88,0xea,0x93,
+  0x69,0x63,0xee,0x03,0x7a,0xbc,0xda,0xd5,0xd5,0xba,0x26,0x4d,0xa3,0x65,0x62,0xf9,
+  0xde,0x3c,0xbe,0x97,0x7c,0x4f,0x35,0x8f,0x20,0x68,0xe3,0x0f,0x7b,0x08,0x52,0xd4,
+  0xac,0xb0,0x81,0xe0,0x16,0x43,0x39,0x4c,0x9c,0x29,0x8a,0x44,0x1f,0xb8,0x18,0xb1,
+  0xb1,0x35,0xe2,0xf4,0x2e,0xbd,0x83,0x9d,0x84,0xc7,0x6a,0xde,0x83,0x26,0xb4,0x8f,
+  0xa5,0xe4,0x05,0x50,0x72,0xa1,0xc5,0x7f,0xbc,0xba,0x66,0xf5,0xc6,0xc3,0x39,0xa7,
+  0xb1,0xdf,0x4d,0x88,0x52,0x24,0xf7,0x9a,0x87,0x5c,0xcc,0x0b,0xc2,0xfc,0x7e,0xe6,
+  0x89,0xf7,0xf3,0x92,0x1a,0x25,0xfb,0x6b,0x64,0xc7,0x13,0x1f,0x7d,0x7f,0x78,0x62,
+  0xb7,0xc5,0x59,0xa7,0x0a,0x1d,0x5d,0x5a,0xa1,0xc6,0x24,0x88,0x56,0x89,0xe5,0xaf,
+  0xde,0x70,0xc3,0x4f,0x02,0x32,0x27,0xab,0xa5,0x9c,0x1b,0x58,0xf6,0xa4,0xf0,0xda,
+  0x4b,0xfd,0x79,0x10,0x6a,0x34,0xef,0x5c,0xf1,0x27,0x55,0x62,0x82,0x9e,0x0c,0x4d,
+  0x65,0x2a,0x43,0xb4,0x8c,0x8d,0xc5,0x98,0x40,0xa4,0xde,0x17,0x89,0x76,0x35,0x59,
+  0x76,0x9c,0x48,0xb5,0xaf,0x86,0x1d,0x0f,0x0b,0x95,0x38,0x54,0x89,0x11,0xa5,0x42,
+  0x36,0xd8,0x05,0x0c,0xee,0x44,0x8d,0x3e,0x99,0x2f,0x3c,0x12,0xe3,0x83,0x0a,0x3c,
+  0xec,0x18,0x49,0xc5,0x9f,0x84,0x8b,0x34,0xcd,0x32,0x7c,0x52,0xee,0xb7,0xab,0xae,
+  0x87,0xe9,0x3a,0x9b,0x87,0xc9,0x2c,0x61,0x75,0xec,0x3a,0xef,0xc4,0xfc,0x3a,0xf1,
+  0x49,0x18,0xa6,0x4b,0x9a,0x57,0xdf,0x6e,0xb1,0xde,0xce,0x1f,0x4c,0x83,0x19,0x99,
+  0xc7,0x9c,0x02,0xed,0x43,0x41,0xa2,0xbc,0x05,0x3b,0x4e,0x41,0xc0,0xf5,0xe6,0xb4,
+  0x5c,0x2a,0x36,0xf5,0xe2,0x98,0x6d,0x9a,0xed,0x4b,0xea,0x4b,0x74,0xdb,0x66,0xc9,
+  0x6a,0xb6,0xc2,0x27,0x31,0x88,0x08,0x08,0xfc,0xb6,0x7b,0xe2,0xcc,0xdd,0x79,0x48,
+  0x4b,0xe5,0x10,0x23,0xa0,0xef,0xa7,0x3c,0x3e,0x9e,0xeb,0x5f,0x7b,0xd2,0xd0,0xf8,
+  0x45,0x79,0x7e,0xc4,0x33,0x6d,0xdc,0x70,0xe5,0x39,0xc7,0x1d,0xa7,0xfe,0xdc,0x91,
+  0x68,0x5d,0xd7,0xc8,0x48,0xba,0xb1,0xe7,0x85,0xfd,0x5f,0xe4,0xdb,0x5d,0x55,0xb7,
+  0x31,0x38,0x75,0xc6,0xe8,0xbb,0xff,0xc6,0xd2,0x48,0x5a,0xd2,0x6d,0x02,0x32,0x9f,
+  0xa7,0x86,0x4d,0x58,0xbf,0xc2,0x45,0x9b,0x68,0xaf,0x37,0xa9,0xbb,0x50,0xf8,0xd4,
+  0xa7,0xb0,0x33,0x42,0x52,0x14,0x8b,0x83,0x26,0xf1,0x6a,0x71,0x39,0xe8,0xb5,0x63,
+  0x68,0x01,0xa8,0xdf,0x63,0xe7,0x60,0x60,0xa3,0x09,0xa7,0xe0,0xa0,0x4b,0xe0,0x4c,
+  0xdc,0x91,0x41,0xf6,0x78,0xe7,0x44,0x77,0x2d,0x0b,0xf8,0x35,0xb4,0x45,0xb3,0x07,
+  0xed,0x08,0x16,0x43,0xdf,0x44,0x21,0x8a,0x71,0x17,0xde,0x11,0xa2,0x56,0xf3,0x06,
+  0x76,0x11,0x0e,0xce,0x70,0x53,0xd3,0xc0,0x26,0xbc,0x55,0xa4,0x43,0x25,0x9d,0x06,
+  0x94,0xf5,0x28,0x01,0x99,0x9c,0x35,0x07,0xbd,0xcc,0xe8,0x76,0x0b,0x82,0x78,0x3a,
+  0x9d,0x85,0x8a,0xae,0xb2,0xc2,0x4b,0xf4,0x15,0xbd,0x19,0x43,0xb7,0x35,0x7a,0x07,
+  0xc8,0x3c,0xef,0x4f,0x93,0xf5,0x92,0x81,0xfb,0x06,0xc3,0x48,0x9a,0x35,0x62,0x27,
+  0x38,0x26,0xe4,0x03,0x93,0xa6,0xd3,0x35,0x37,0x6b,0x57,0x5f,0xfe,0x28,0x0a,0x9c,
+  0x22,0x4e,0xff,0x3a,0xff,0x37,0x45,0xbe,0x6d,0xd6,0xf8,0xfa,0xd9,0x81,0x7a,0x20,
+  0xc2,0xe5,0x9e,0xca,0x2e,0x37,0x4d,0x6c,0xd3,0xe9,0xfd,0xbe,0x6e,0xc9,0xd5,0x0b,
+  0x30,0x2b,0xe1,0x7b,0x3f,0x4e,0x9b,0x64,0xbf,0x59,0xe8,0x78,0x74,0x7c,0x41,0x42,
+  0x7b,0xd7,0x69,0x38,0x35,0xab,0x3a,0x94,0x34,0x5c,0xe9,0xf7,0x17,0x0a,0xc0,0x3b,
+  0xbd,0xb9,0x67,0xc8,0x69,0x51,0xaf,0x61,0x7e,0x04,0x21,0x44,0x15,0xcf,0x68,0xee,
+  0x1e,0x14,0x13,0x59,0xd8,0xaf,0xcf,0xe3,0xbd,0xfa,0x62,0x12,0x57,0x2f,0xfa,0x2c,
+  0xfa,0x86,0xe9,0xc8,0x50,0x12,0x98,0x39,0x4f,0x2b,0x09,0x88,0xce,0xf4,0x4b,0x4a,
+  0x03,0x30,0x83,0xb7,0xb7,0xf7,0x5e,0xc5,0x00,0x76,0x46,0x40,0x1e,0x07,0xa4,0x36,
+  0xa7,0x2b,0xdd,0x29,0x41,0x4f,0x99,0xd3,0x15,0xc6,0x8e,0x60,0x1a,0x4b,0x50,0xf0,
+  0x7e,0x07,0x99,0xbd,0x36,0x78,0x7c,0x47,0xcf,0xe5,0x4f,0x44,0x03,0xd3,0xb8,0xeb,
+  0x8b,0x51,0xde,0x43,0x71,0xd4,0x6d,0x79,0x73,0x8a,0x65,0xa9,0xdd,0x57,0x48,0x37,
+  0xde,0x6d,0x6f,0x7a,0x6b,0x49,0x2d,0xf3,0xd0,0x69,0xe0,0xea,0xd6,0x2d,0x7b,0x26,
+  0xf5,0x0c,0xf7,0x21,0xff,0xc6,0x4a,0xf3,0x5b,0x19,0xbe,0xd4,0xcd,0x0f,0xf3,0x2d,
+  0xeb,0x4a,0x64,0xba,0xaf,0xef,0xf2,0x2c,0xff,0x47,0xd3,0xe4,0xe9,0x3f,0xd8,0x40,
+  0xef,0x85,0xa7,0x9f,0x52,0x21,0xe3,0x5d,0xca,0x18,0x7a,0xf5,0x41,0xee,0x7d,0xf9,
+  0xb9,0xfc,0x87,0x04,0xd6,0x9b,0x6f,0xbf,0xfa,0xea,0xeb,0x97,0xd6,0xeb,0xbf,0xbc,
+  0x7a,0xf3,0xf9,0xef,0x3e,0xe8,0xd7,0xa0,0x79,0x2d,0x9f,0x35,0xbf,0x58,0xef,0xf1,
+  0xcd,0x5f,0xc5,0x3b,0x51,0xdf,0x03,0x38,0xbe,0x84,0x76,0x49,0x40,0x7e,0x26,0xc5,
+  0x71,0x41,0x66,0x54,0x46,0x91,0xa9,0x51,0xbd,0xaf,0xc7,0xbf,0x28,0x0b,0x62,0xe8,
+  0xed,0xb9,0xbc,0xdd,0x48,0x6d,0x4c,0x51,0x0e,0xd3,0xbd,0xbc,0x65,0x49,0x29,0x8e,
+  0x99,0xf4,0xae,0xaf,0x6e,0xeb,0x8f,0x6d,0x16,0xf3,0x5e,0x83,0xcf,0xb9,0x26,0xa1,
+  0x40,0x7d,0x7d,0x9a,0xbd,0x4d,0xad,0xc3,0x78,0x87,0xe6,0xa0,0x9f,0x60,0x53,0x90,
+  0x8e,0x23,0x3d,0xe7,0x33,0x9b,0x81,0x42,0xa5,0x19,0x28,0x94,0x9a,0x81,0x7c,0xa5,
+  0x19,0xc8,0xff,0x91,0x9b,0x81,0xde,0xad,0x09,0xe8,0x6c,0xf3,0x0f,0xaa,0x7e,0x0a,
+  0xe6,0xea,0xe7,0xa2,0xf2,0x5f,0xff,0xf1,0xe5,0xe7,0xaf,0xbe,0x7c,0xf5,0xb9,0xf5,
+  0xed,0x9f,0x5f,0x7e,0xf7,0xdd,0xab,0x2f,0x5e,0xbe,0xfe,0x39,0xfd,0xb7,0x34,0xd8,
+  0xa8,0xa9,0xb3,0xd4,0x70,0x73,0x2b,0xb0,0x85,0xb6,0x5e,0x09,0xd6,0xfa,0x80,0xba,
+  0xff,0xe5,0x46,0x0d,0xd6,0xf4,0x1e,0x27,0x11,0x9e,0x99,0x36,0x90,0x63,0x63,0xe3,
+  0x49,0x5d,0xa9,0x98,0x2c,0x42,0xe4,0x13,0x1b,0xfc,0x0f,0x75,0x4a,0x79,0x1f,0x16,
+  0x4d,0x00,0x00,
+};
+static const char webCSS[] FLASHPROG = "<link rel='stylesheet' href='/static/heishamon.css?v=ad358e1f'>\n";
+
+// menu.js: 1929 bytes, 704 gzipped
+static const uint8_t webasset_menu_js[] FLASHPROG = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xb5,0x55,0x4d,0x53,0xdb,0x30,
+  0x10,0xbd,0xe7,0x57,0xec,0xe4,0x62,0xb9,0x01,0x13,0xfa,0xc1,0x25,0xcd,0x81,0x02,
+  0x07,0x66,0xca,0x30,0x2d,0xf4,0xd4,0xe9,0x41,0xb5,0x36,0x8e,0x06,0x59,0xf2,0xc8,
+  0x72,0x20,0x2d,0xfc,0xf7,0xae,0x24,0x3b,0xb6,0x19,0x4a,0x69,0x67,0x7a,0x48,0x2c,
+  0xc9,0xbb,0x6f,0xf7,0xbd,0xdd,0x95,0x57,0x8d,0xce,0x9d,0x34,0x1a,0x9c,0x29,0x0a,
+  0x85,0x17,0xa8,0x1b,0x96,0xfe,0x9c,0x00,0x6c,0xb8,0x85,0x72,0x29,0x4c,0xde,0x94,
+  0xa8,0x5d,0x56,0xa0,0x3b,0x53,0xe8,0x97,0x1f,0xb6,0xe7,0x82,0x25,0xb5,0x14,0xc1,
+  0x38,0x49,0x17,0xad,0xb1,0xf9,0xbd,0x31,0xad,0x9a,0xcb,0x0d,0x5a,0xc5,0xb7,0xd1,
+  0xbe,0xcc,0x72,0xc5,0xeb,0xfa,0xa3,0xac,0x5d,0x16,0x03,0xb3,0xc4,0x54,0xa8,0xe3,
+  0x5b,0xf3,0xcc,0xdb,0x87,0xc9,0xaa,0xcb,0x38,0x57,0xa6,0x1e,0x24,0xfc,0x82,0x54,
+  0x07,0xb8,0x16,0x4b,0xb3,0x19,0x45,0x7d,0x59,0xf6,0xcf,0x40,0x3c,0x4c,0xfa,0xdc,
+  0x6a,0x74,0x27,0xc6,0xdc,0x48,0x64,0x9a,0x97,0xb8,0x47,0x02,0xa9,0x86,0x1e,0x82,
+  0x6f,0xeb,0x14,0x3a,0x79,0xf1,0xae,0x92,0x16,0x6b,0x58,0xc2,0x74,0xea,0x33,0x90,
+  0x2b,0x60,0xbd,0x45,0xb4,0x11,0xdc,0x21,0x19,0x68,0xbc,0x85,0x53,0x5a,0xb2,0x90,
+  0x2a,0x84,0xe3,0x8c,0x82,0x5c,0xcb,0x12,0x59,0xd8,0x14,0xed,0x26,0x85,0x59,0x44,
+  0x81,0x57,0xf0,0xfa,0x2d,0xfd,0x1d,0xcd,0xbb,0xbf,0xc3,0xf9,0x7c,0x9e,0xb6,0x00,
+  0x83,0xd8,0x8b,0x6e,0xb3,0x9c,0x92,0x6f,0x00,0x73,0xe6,0xcb,0xf5,0xc9,0x95,0xb3,
+  0x52,0x17,0x31,0xe2,0xc3,0x50,0xa0,0x3c,0x30,0xf3,0x59,0x11,0x37,0x72,0x99,0x06,
+  0x47,0x16,0x38,0xc2,0xfd,0x3d,0xb1,0xf1,0x49,0x74,0x11,0x66,0x3e,0x42,0xc5,0xdd,
+  0x7a,0x79,0x30,0x1d,0x8b,0x54,0x8c,0x44,0xea,0x75,0xf1,0xbb,0xb3,0x4f,0x23,0xfc,
+  0xae,0xc9,0x72,0x4e,0xc7,0x8f,0x12,0xc9,0xea,0x4a,0x49,0xc7,0x92,0x45,0xac,0xe3,
+  0xca,0x58,0xe6,0x4d,0x25,0x59,0xce,0x17,0xf4,0x78,0x4f,0x5e,0x99,0x42,0x5d,0xb8,
+  0x35,0x6d,0x67,0xb3,0xa1,0xbc,0x39,0x19,0xe5,0xfc,0xab,0xfc,0x16,0x55,0xb9,0x5d,
+  0x4b,0x85,0xc0,0xf2,0x2c,0x5f,0x73,0x7b,0xec,0xd8,0x3c,0x85,0xe5,0x12,0x12,0x48,
+  0xd2,0x68,0x99,0xd5,0xcd,0xf7,0x3a,0xca,0x72,0xb8,0x47,0xdb,0x88,0xda,0x4a,0xea,
+  0xcb,0x97,0x67,0x52,0x0b,0xbc,0xbb,0x5c,0xb1,0x48,0x22,0xf8,0x13,0x8a,0x45,0xd7,
+  0x58,0x3d,0x02,0x88,0x06,0x2d,0xc4,0x23,0x30,0x2f,0x77,0xeb,0xa2,0x1b,0xa5,0xc6,
+  0xb2,0xc5,0x91,0x38,0xe5,0xf6,0xe6,0xc2,0x08,0x5f,0xf0,0x4e,0xb7,0xf8,0x62,0x28,
+  0xd0,0xe3,0x56,0x16,0xad,0xd3,0x75,0xb0,0xec,0x67,0x77,0xed,0x4a,0x35,0xf4,0xeb,
+  0x16,0xad,0xb3,0x37,0x6b,0xfb,0x33,0xc6,0x20,0x7d,0x30,0xbf,0x41,0xd1,0x49,0xe9,
+  0xfd,0x07,0x93,0xc1,0x45,0x1b,0x6b,0xbf,0xa4,0x60,0x49,0xab,0x4f,0x3f,0x13,0xbb,
+  0x3c,0x92,0x3d,0x48,0x9c,0x6d,0xfc,0xf3,0xcd,0xd1,0xbb,0x48,0x1d,0x50,0xd5,0xf8,
+  0x34,0x6e,0x37,0x71,0x2f,0x85,0x5e,0x71,0x82,0x1a,0x62,0x8f,0x74,0x94,0x5a,0xba,
+  0x27,0x54,0xec,0x00,0x48,0x8f,0xe2,0x09,0xd8,0x9d,0x66,0xff,0x5b,0xed,0x83,0x03,
+  0xf8,0x1c,0xf8,0x82,0x5b,0xd3,0x0f,0xcb,0xca,0x58,0x6e,0xb7,0xa0,0x0c,0x17,0xd4,
+  0x3f,0x10,0x64,0x99,0xfc,0x59,0xa3,0xfd,0xd6,0x21,0xc6,0x8f,0xc0,0xc7,0x55,0xa5,
+  0xb6,0x50,0x59,0xba,0xba,0x22,0x61,0xf0,0x96,0xbb,0x2b,0xa8,0x13,0xc0,0xf7,0x7e,
+  0x28,0xcf,0x5f,0xd5,0xb9,0x6f,0x93,0x14,0xc6,0xed,0x42,0xa4,0x3d,0xdc,0x3f,0x97,
+  0xf9,0x59,0xe4,0x50,0xec,0x5d,0x95,0x89,0xe4,0x39,0xd5,0x57,0x72,0x25,0x7f,0x20,
+  0xc8,0xb2,0x44,0x21,0xe9,0x66,0x23,0xd6,0xb7,0x6b,0xd4,0x70,0x7a,0x79,0x01,0xb2,
+  0xa6,0x19,0xe3,0x62,0x3b,0x09,0xa4,0xbb,0x62,0x84,0xa3,0x2b,0x17,0xae,0x5d,0xcf,
+  0x7f,0xa7,0x1e,0x8c,0x3e,0x32,0x44,0xfd,0x6c,0x43,0x0b,0x9f,0x30,0x6a,0xb4,0x2c,
+  0x21,0xc8,0x13,0xa3,0x9d,0x3f,0x23,0x17,0x14,0xd4,0x77,0xc3,0x0e,0xf3,0x1f,0x88,
+  0x9e,0xf3,0xb8,0xf7,0xfc,0x7c,0xff,0x02,0xc4,0xf2,0x6f,0xb7,0x89,0x07,0x00,0x00,
+};
+static const char menuJS[] FLASHPROG = "<script src='/static/menu.js?v=1a832117'></script>\n";
+
+// websocket.js: 6159 bytes, 1865 gzipped
+static const uint8_t webasset_websocket_js[] FLASHPROG = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xcd,0x58,0x4b,0x73,0xdc,0x36,
+  0x12,0xbe,0xeb,0x57,0x40,0x95,0xca,0x80,0xac,0x99,0xa1,0x46,0x6b,0x5b,0xbb,0x65,
+  0x99,0x4e,0x79,0x2d,0xa5,0x56,0x9b,0xb5,0x9d,0xf2,0xa8,0xa2,0x43,0x76,0x0f,0x10,
+  0xd9,0x1c,0x52,0xe1,0x10,0x0c,0x01,0xce,0x64,0x56,0xd2,0x7f,0xdf,0x06,0xc0,0x07,
+  0xf8,0x92,0x65,0xe7,0xb2,0x07,0x8f,0x45,0xa2,0xfb,0xeb,0x07,0x3e,0x74,0x37,0xb1,
+  0x63,0x05,0xb9,0x7d,0xcf,0xb3,0x0c,0x02,0x09,0xa1,0x1f,0xb1,0x54,0xc0,0xf9,0xd1,
+  0x0e,0xdf,0x26,0x19,0x0b,0x64,0xb2,0x4b,0xe4,0xe1,0x3a,0xd9,0x02,0x2f,0xa5,0xff,
+  0x6a,0xb5,0x5a,0x99,0xb5,0x94,0x09,0xf9,0xce,0x5a,0xf5,0x2f,0x98,0x04,0x2f,0xe3,
+  0x7b,0xc7,0x3d,0x3f,0x8a,0xca,0x0c,0x97,0x78,0x46,0xb6,0x3c,0x4b,0x24,0x2f,0x6e,
+  0xe0,0x76,0xcd,0x83,0xdf,0x40,0x3a,0xee,0xfd,0x11,0x21,0x02,0xe4,0x55,0x26,0xa1,
+  0xd8,0xb1,0xd4,0xa9,0x45,0xcd,0x0a,0x21,0x49,0xe4,0xb4,0x48,0xcb,0xbe,0x95,0xb7,
+  0x03,0x97,0x66,0x33,0x8e,0xe8,0x42,0xa3,0x7b,0x05,0xb0,0xf0,0xb0,0x96,0xa8,0xef,
+  0xfb,0x7e,0x63,0xd4,0xfb,0xf4,0xf3,0xe5,0xc7,0x0a,0x9e,0x90,0x80,0x67,0x82,0xa7,
+  0xe0,0xa5,0x7c,0xe3,0xd0,0xab,0x06,0x8e,0x84,0x20,0x75,0x02,0x16,0xa4,0x80,0xc0,
+  0x64,0x23,0xc9,0x36,0x9e,0xe7,0x51,0x0c,0xc8,0xa8,0x5a,0x96,0x82,0x94,0x0b,0x70,
+  0xaa,0x95,0x47,0xfc,0x7d,0x5c,0x0c,0x5c,0xc3,0xd5,0xc7,0x36,0x15,0x4c,0x4a,0xd8,
+  0xe6,0xf2,0x73,0x0d,0x6e,0x02,0xc6,0x70,0x8f,0xdb,0xe4,0xbb,0xf7,0x1d,0xef,0x3e,
+  0x0f,0x1c,0x11,0x92,0x15,0xb2,0xf1,0x42,0xa0,0x03,0x8f,0xb6,0x8d,0xc1,0x72,0x65,
+  0x42,0x1e,0x72,0xe0,0x11,0xf9,0xc0,0xff,0xdb,0x24,0xe5,0xd8,0xa7,0x65,0x16,0x42,
+  0x94,0x64,0x10,0xd2,0x2a,0x39,0x6d,0x7c,0x7e,0x06,0xfb,0x8e,0xb8,0x43,0xf7,0xe2,
+  0xf5,0xc9,0x09,0x9d,0xa7,0x3c,0x60,0xca,0x96,0x17,0x73,0x21,0x75,0xfc,0x8f,0x04,
+  0x90,0x31,0x96,0x99,0xaf,0xb1,0xf1,0x05,0x03,0x73,0x7a,0xb2,0x17,0x66,0x03,0x1e,
+  0x4d,0x28,0xad,0xfe,0x00,0xd0,0xe3,0x19,0xcf,0x21,0xf3,0x2d,0x4a,0x59,0xbc,0x96,
+  0x45,0x09,0xe7,0x8f,0xe7,0x43,0x1d,0xbd,0x95,0x13,0x4a,0xe6,0x30,0x0c,0xb7,0x6e,
+  0x14,0x08,0x8a,0x82,0x17,0x2d,0x10,0xf4,0x76,0xf3,0x66,0x4d,0xb4,0xc4,0x6b,0xba,
+  0x80,0x71,0x80,0x2d,0x08,0xc1,0x36,0x96,0x2f,0xb0,0x93,0x0d,0x6f,0x9f,0x3c,0x70,
+  0x46,0x04,0xd3,0x83,0x1a,0x5e,0xc8,0x24,0xf3,0x34,0x15,0xc4,0x4d,0x22,0x63,0x87,
+  0xde,0x53,0xb7,0x81,0x21,0x44,0x9d,0xde,0x3b,0xff,0x9f,0xeb,0x4f,0x1f,0xbd,0x9c,
+  0x15,0xc8,0xe2,0x5a,0xa7,0xc1,0xd1,0x48,0x77,0xca,0xeb,0x0f,0x62,0x73,0xec,0x67,
+  0x65,0x9a,0x5a,0xfa,0x06,0x81,0xdf,0xde,0xf9,0x21,0x0f,0xca,0x2d,0x64,0xd2,0xdb,
+  0x80,0xbc,0x4c,0x41,0xfd,0xf9,0xf7,0xc3,0x55,0xe8,0xd0,0x20,0x4d,0xa8,0x85,0x66,
+  0x68,0x8e,0x1a,0x6e,0x01,0xb2,0x2c,0xb2,0xf3,0x1e,0x56,0x10,0xff,0x36,0x8d,0xc5,
+  0x4a,0xc9,0x45,0x50,0xf0,0x34,0xed,0x42,0x22,0x9c,0x87,0x05,0xa4,0x84,0xb9,0x5f,
+  0xbb,0x3a,0xa7,0xff,0xce,0x68,0xcf,0x2c,0x62,0xcf,0x66,0xf8,0xe3,0x05,0x31,0x60,
+  0x9a,0x43,0x57,0xe9,0x19,0xbc,0x6b,0x9e,0xfb,0xed,0xd3,0x3f,0x20,0xd9,0xc4,0xb2,
+  0xd5,0x6e,0x69,0x7d,0x67,0xb2,0x73,0xdf,0x05,0xbe,0x6b,0xf2,0x2c,0x45,0x67,0x8d,
+  0x90,0x32,0x0f,0x55,0x11,0x42,0x4a,0x27,0x51,0x42,0x17,0xb6,0xa4,0xa7,0x5e,0x75,
+  0xe2,0xb0,0xc4,0x41,0xc6,0x50,0x64,0x20,0x7b,0x2a,0xf5,0xeb,0x29,0xb5,0x2d,0x6c,
+  0x79,0x71,0xe8,0x29,0x99,0x97,0x53,0x2a,0x01,0x2f,0xb0,0xca,0xf5,0x0d,0x55,0x6f,
+  0x27,0xed,0xfc,0x2e,0xfb,0x1a,0xea,0xd5,0x94,0x78,0x99,0x4b,0xa4,0x69,0x4f,0xc1,
+  0xbc,0x9c,0x52,0x29,0xca,0x14,0x44,0x4f,0x43,0xbf,0xeb,0x28,0xf4,0x77,0xc6,0x8b,
+  0x21,0x11,0x31,0xd3,0x64,0x18,0xd9,0x8a,0xf7,0x90,0xa6,0x63,0x92,0x9e,0xe4,0x79,
+  0x12,0xcc,0xe9,0xf2,0x17,0xf5,0xd8,0x58,0xed,0x88,0xe8,0xff,0x86,0xde,0x7e,0x11,
+  0xf2,0x02,0x90,0x54,0x49,0xae,0x0e,0xf1,0x38,0x70,0xd8,0x0a,0x3c,0x1d,0x5b,0xc8,
+  0x52,0x3c,0xf9,0xa3,0xb1,0xa9,0xa3,0x13,0x5e,0x5d,0xf8,0x23,0x92,0x9e,0x00,0xac,
+  0x3c,0xc5,0xd5,0x45,0xd7,0xf5,0x71,0x58,0x13,0xe5,0xb1,0xef,0x37,0xc5,0xda,0xad,
+  0x63,0xa4,0xeb,0x0a,0x67,0x49,0xe7,0x68,0x0a,0x23,0xbb,0xc6,0x4a,0x08,0x05,0xc3,
+  0x63,0xdc,0xa6,0x6c,0x08,0xe6,0x3e,0xcb,0x6e,0x5e,0x00,0xfa,0x29,0xfb,0x96,0x2f,
+  0xb4,0xcc,0xcf,0x7a,0x31,0x00,0x07,0xed,0x2e,0x9e,0xd0,0x7e,0x3a,0x7d,0x62,0xf5,
+  0x24,0x2d,0xa8,0x58,0xe5,0xbc,0x90,0x18,0x5d,0x4f,0xde,0x33,0x0b,0x18,0xf0,0x0d,
+  0xb3,0x59,0x5f,0x2f,0xab,0xb7,0x13,0xbc,0x78,0x26,0x66,0xcc,0xcb,0x62,0x1c,0x57,
+  0xad,0xfc,0x79,0xec,0x6b,0x2e,0x59,0x3a,0x6d,0x40,0x2f,0x3f,0x9d,0x3b,0xd5,0x4c,
+  0x55,0xe9,0xd9,0x3e,0x7d,0xa6,0x1a,0x31,0x2f,0x63,0x5b,0x40,0x0f,0x76,0x9d,0xf3,
+  0xd4,0x2e,0x0f,0x99,0x31,0xc1,0xf6,0xcf,0x78,0x38,0x58,0xd6,0xb3,0x5a,0x40,0x84,
+  0x1b,0x1e,0x1b,0x72,0x5c,0xb3,0xdb,0x14,0x9c,0x2e,0xd6,0x51,0xff,0xaf,0x0a,0xbd,
+  0xdb,0xf9,0xbe,0xa6,0x6f,0x4d,0x75,0xad,0x6f,0xec,0x59,0x56,0xc7,0xaa,0x5b,0x6e,
+  0xaf,0x63,0x7d,0x7b,0xbf,0x32,0x31,0x3f,0x9a,0x41,0xc9,0x9a,0x08,0xeb,0xd2,0x9a,
+  0x84,0x0b,0x34,0xad,0x53,0xaa,0xbc,0x87,0x74,0xd2,0xf9,0x24,0xd4,0x2e,0xab,0x59,
+  0xa2,0xee,0xfa,0x27,0x27,0x64,0x9d,0x43,0x90,0xb0,0x94,0xc4,0x2c,0x0b,0x53,0x1c,
+  0x47,0x49,0xc4,0x0b,0x72,0x93,0xfc,0x98,0x90,0x30,0x11,0x41,0x3d,0x2f,0xa9,0x01,
+  0x54,0x42,0x3d,0xc7,0x27,0x21,0xc1,0x31,0x9c,0x98,0x2e,0x48,0x66,0x33,0xe2,0xa0,
+  0x0b,0xfa,0xd5,0xf2,0x94,0x3c,0x3c,0x90,0xfa,0x89,0x2e,0x4f,0xa9,0x7a,0xd6,0xd3,
+  0x08,0x7e,0x18,0x28,0x31,0x97,0xbc,0x21,0xab,0x76,0x6a,0x81,0xd4,0x93,0xf0,0x87,
+  0xc4,0xc1,0x4c,0xa2,0x9f,0x04,0x75,0x32,0x2e,0x49,0x63,0xb7,0x49,0x21,0x7a,0xfa,
+  0x19,0x1b,0xdf,0x0e,0x08,0x52,0x8e,0x7c,0x4f,0xc4,0x61,0x7b,0xcb,0x53,0x7c,0x60,
+  0x12,0x3d,0x4e,0x53,0xbe,0x17,0x47,0xed,0x1e,0x62,0x21,0x0b,0x10,0x6e,0x9d,0xb3,
+  0x0c,0x21,0xd1,0x46,0x86,0x36,0xaa,0x5c,0xac,0x93,0x5b,0x15,0xa7,0x35,0x5a,0xd9,
+  0xd2,0x18,0x8c,0xf5,0xd8,0xf5,0x4d,0x45,0xf4,0x3d,0xb5,0xd8,0x6b,0x4b,0x0a,0x79,
+  0xc0,0x79,0x10,0x73,0x96,0xa7,0xec,0x60,0xe2,0xc8,0x80,0xf6,0x76,0xb1,0xcb,0xdb,
+  0x41,0xec,0x2a,0x6f,0xc7,0x3e,0x51,0x63,0x19,0xf9,0x41,0x3f,0xbd,0x26,0xd4,0x4e,
+  0xc1,0x3a,0xe6,0xfb,0x36,0x78,0xb6,0x61,0x49,0x86,0x01,0x90,0x44,0x92,0x3d,0x13,
+  0x24,0x4e,0xc2,0x10,0xb2,0xff,0xb3,0x34,0xf4,0x53,0x50,0x0d,0xfc,0x9a,0x88,0xc4,
+  0x51,0x54,0xd4,0x04,0xd2,0x94,0xaa,0x18,0xe5,0xd6,0x94,0xea,0xf4,0x8f,0xca,0xa0,
+  0x8a,0x6b,0xef,0x77,0x18,0x75,0xde,0x2c,0xa4,0xec,0x16,0x0f,0x00,0x06,0x8a,0x2d,
+  0x64,0x97,0xf0,0x52,0x8c,0x05,0xab,0xbb,0x2b,0x97,0xbe,0x16,0x7e,0x52,0x12,0x93,
+  0x82,0x82,0xb3,0x19,0xfe,0xe0,0x77,0x21,0x13,0xe2,0x5f,0x89,0xc0,0xbf,0x30,0x11,
+  0x98,0x78,0x81,0x35,0x1b,0x0f,0x45,0x29,0x96,0xb8,0x6c,0xcd,0xe1,0x8d,0xf0,0x47,
+  0x2c,0x9a,0xbe,0x2d,0x63,0xe5,0x7a,0x8f,0x59,0x5c,0x9e,0x3e,0x3c,0xec,0xdf,0xac,
+  0xdc,0x2e,0x3a,0x0b,0xb1,0xcc,0xd8,0x47,0xaf,0x2d,0x34,0x75,0x49,0xdd,0xbf,0xf5,
+  0xff,0xfa,0x6a,0x4c,0x0d,0xfe,0x08,0xb0,0x7c,0x63,0x14,0xa3,0x3a,0xaf,0x46,0x4d,
+  0x6d,0x38,0x1f,0x37,0xf1,0x97,0x51,0x13,0x11,0x4b,0x8a,0x9e,0xf8,0x88,0x54,0xce,
+  0x79,0x23,0x65,0x76,0xbc,0xda,0xef,0xba,0x72,0x98,0x79,0xd0,0x25,0xed,0x9e,0x06,
+  0x71,0x92,0x23,0x5f,0x26,0x2b,0xaf,0xd6,0x78,0x8f,0x42,0x35,0xae,0x82,0x53,0x4a,
+  0x6e,0x73,0x9e,0x34,0x0c,0x2f,0xf5,0x51,0x1a,0x21,0x88,0x11,0xd0,0x75,0xfa,0x12,
+  0xeb,0x93,0xb6,0xe8,0xfd,0x5e,0x42,0x71,0x58,0x43,0x8a,0xa9,0xe6,0x85,0x43,0x3d,
+  0xf5,0xb2,0xea,0x73,0xd6,0xd7,0x17,0x5a,0xd2,0xb8,0x6f,0xb1,0x74,0x59,0x6d,0x47,
+  0x23,0x34,0x7b,0xad,0xd8,0x5e,0xed,0xb6,0x0e,0x46,0x7b,0xbc,0xd4,0x57,0x07,0x40,
+  0xed,0x1e,0xa3,0x1d,0xe8,0x97,0xbd,0x77,0xef,0xaf,0xaf,0x7e,0xb9,0x6c,0x4f,0x4b,
+  0xbf,0xc5,0x3d,0xc7,0x56,0x75,0x51,0xf1,0x0c,0x6b,0x57,0x1f,0xfb,0xf6,0x8e,0xda,
+  0xdf,0xb6,0x2b,0xaa,0x8e,0xd3,0x69,0x39,0x7a,0x3c,0xf8,0xb6,0x96,0x33,0x9b,0x75,
+  0xeb,0x1d,0x1e,0xee,0x1a,0x45,0x97,0xc2,0x96,0x42,0x85,0x2e,0xf4,0xea,0x3b,0x03,
+  0x3b,0x29,0x2c,0x21,0x8a,0xd4,0x17,0x4d,0x7d,0xcc,0x39,0x72,0x08,0xc5,0x79,0x14,
+  0x09,0x90,0x37,0x49,0x28,0xe3,0xf3,0xa3,0x61,0x35,0x55,0xd8,0xe7,0x43,0x68,0xcd,
+  0xce,0x11,0xdc,0x41,0xa0,0xbd,0x51,0x55,0xe0,0xa8,0x5a,0x8f,0xa5,0x75,0xdc,0x26,
+  0xff,0x2a,0x23,0xd3,0xf3,0x82,0x35,0x65,0x0b,0x3d,0x65,0xaf,0xb5,0x12,0xad,0xd3,
+  0x72,0xdc,0x82,0x58,0xc3,0x88,0x42,0x2f,0xf8,0xde,0x6f,0x17,0xd5,0x07,0x3d,0x82,
+  0x56,0xd8,0x95,0x32,0x8a,0xb8,0xf8,0xaf,0xaa,0xb9,0x3c,0x67,0x41,0x22,0x0f,0x7e,
+  0xe5,0xe6,0x0f,0x94,0xbe,0xa6,0x2b,0xef,0x4c,0xef,0xb0,0x05,0x64,0x84,0x03,0x9e,
+  0xf2,0xa2,0x23,0x8a,0x36,0x9d,0xe5,0x32,0x64,0xd9,0x06,0x8a,0xc5,0x77,0xd1,0xcb,
+  0x97,0x2f,0x5e,0x9c,0xb9,0xb4,0xb2,0x64,0x87,0x8e,0x15,0x0e,0x8f,0x8b,0x04,0x1b,
+  0x54,0x4d,0x3c,0x42,0xdd,0x74,0x44,0x11,0x56,0x4f,0x58,0x27,0x98,0x33,0x93,0x7d,
+  0x4b,0x68,0xb8,0xc1,0x95,0xf8,0x32,0x2c,0x0b,0x7d,0x33,0x54,0xef,0xb1,0xa5,0x64,
+  0x6f,0x29,0xfd,0xf4,0x13,0xb5,0xee,0xa5,0xee,0xfb,0xb2,0x63,0x5e,0x0c,0x2e,0x53,
+  0x46,0x1d,0xd2,0xb4,0xf8,0x4a,0x6f,0x70,0x4e,0xda,0x32,0xf9,0xc9,0x28,0x5d,0x54,
+  0x3a,0x8e,0xbe,0x57,0x5a,0xac,0x46,0x48,0x35,0x2e,0x5f,0x65,0x76,0xa1,0x2e,0x81,
+  0xd6,0x00,0xd9,0x5a,0x5d,0x45,0x85,0xa2,0xbe,0xdf,0xab,0x13,0x6f,0xb8,0x51,0x27,
+  0x00,0x17,0x7a,0xf2,0xbe,0xbe,0xcb,0x79,0x78,0xe8,0xbd,0xc6,0xee,0x52,0x6b,0x1a,
+  0xbb,0xc4,0xc9,0x60,0x07,0xc8,0x5d,0x94,0x31,0xbb,0xab,0x99,0xec,0xf7,0xf4,0x2a,
+  0x23,0xe2,0xcd,0xd9,0x00,0x40,0x8d,0x87,0x48,0xe6,0x39,0x15,0xb4,0x91,0x7a,0x71,
+  0xb6,0x9a,0x90,0xfb,0xc0,0x64,0xec,0x45,0x29,0xb6,0x03,0x47,0x9c,0x20,0xd8,0x9c,
+  0x6e,0x5b,0xb5,0xbf,0x9d,0xbd,0x7c,0x96,0x9e,0x86,0x9f,0xd3,0x58,0x6b,0x7e,0x59,
+  0xdc,0xc0,0xce,0xa9,0x1a,0x1e,0x71,0x03,0xa6,0xef,0xa4,0x9b,0x53,0xdb,0x69,0x02,
+  0xef,0xd4,0xd7,0x98,0xd7,0x27,0xc3,0xaf,0x8a,0x5c,0xcb,0xfa,0xad,0x50,0xd4,0xfa,
+  0x0f,0x75,0x3d,0x34,0x7f,0xc9,0x82,0xb8,0x05,0x56,0x0d,0xd8,0x9a,0x54,0x44,0xb5,
+  0x3d,0x96,0x83,0xf6,0x2d,0x78,0x30,0x45,0x5b,0xf7,0xe4,0x74,0xb5,0x5a,0x55,0x04,
+  0x0c,0xbe,0x86,0x7a,0x95,0x45,0x43,0x40,0x75,0x51,0xbd,0x38,0x7d,0x65,0xa0,0xfe,
+  0x07,0x89,0x85,0xe3,0xa8,0x0f,0x18,0x00,0x00,
+};
+static const char websocketJS[] FLASHPROG = "<script src='/static/websocket.js?v=e95f15e3'></script>\n";
+
+// select.js: 380 bytes, 247 gzipped
+static const uint8_t webasset_select_js[] FLASHPROG = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x6d,0x90,0x31,0x6f,0xc3,0x20,
+  0x14,0x84,0xf7,0xfc,0x0a,0x36,0x83,0xd2,0xa2,0xee,0x2e,0x43,0x53,0x65,0xa8,0x14,
+  0x65,0x69,0xb7,0xaa,0xc3,0xc3,0x3c,0x3b,0x48,0x18,0x52,0x78,0xb6,0x64,0x45,0xf9,
+  0xef,0x85,0x10,0xa9,0x1e,0x32,0x81,0xd0,0xdd,0x77,0x77,0xf4,0x93,0xef,0xc8,0x06,
+  0xcf,0xc2,0x19,0xfd,0x17,0x68,0x87,0xdc,0xc3,0x88,0xe2,0xb2,0x61,0x6c,0x86,0xc8,
+  0xce,0xe0,0x31,0x29,0x13,0xba,0x69,0x44,0x4f,0x72,0x40,0xda,0x3b,0x2c,0xd7,0xb4,
+  0x5b,0xde,0x1d,0xa4,0x74,0xcc,0x6a,0xde,0x10,0xe8,0xe7,0x22,0x6d,0x44,0x9b,0x8d,
+  0x7d,0x88,0xbc,0x98,0xad,0x7a,0x69,0xed,0xeb,0x0d,0x21,0x1d,0xfa,0x81,0x4e,0xad,
+  0xdd,0x6e,0xc5,0xed,0xe1,0xdb,0xfe,0xc8,0xae,0x00,0x0e,0x36,0x91,0x8c,0x38,0x86,
+  0x39,0x73,0x20,0x97,0x99,0xef,0x94,0x42,0x20,0x88,0x39,0xf2,0x51,0xfe,0x6e,0xf9,
+  0x30,0xb5,0x6a,0xd1,0xda,0x9e,0x57,0xa9,0xa8,0xc7,0x0a,0x0d,0xc6,0x3c,0xe2,0xea,
+  0xd5,0xaa,0xdf,0x09,0xe3,0xf2,0x89,0x0e,0x3b,0x0a,0xf1,0xcd,0x39,0xde,0xc8,0x2c,
+  0xf0,0x30,0x33,0x3d,0x11,0x05,0x5f,0x7d,0xc5,0x23,0xf3,0xb4,0x3d,0x74,0x27,0xde,
+  0xdf,0xff,0x8d,0x6b,0x71,0xd1,0xab,0x34,0x0a,0xc3,0xe0,0xfe,0x87,0x3c,0x69,0x69,
+  0x80,0x20,0xe5,0x46,0xd9,0xae,0x94,0xaa,0x8d,0xaf,0x19,0x78,0xdd,0xfc,0x01,0x07,
+  0x31,0x8e,0xf6,0x7c,0x01,0x00,0x00,
+};
+static const char selectJS[] FLASHPROG = "<script src='/static/select.js?v=ec9bd0ea'></script>\n";
+
+// refresh.js: 5044 bytes, 1467 gzipped
+static const uint8_t webasset_refresh_js[] FLASHPROG = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xbd,0x58,0x5b,0x6f,0xdb,0x36,
+  0x14,0x7e,0xef,0xaf,0xe0,0x30,0x20,0x94,0x16,0x5b,0x55,0xda,0xa2,0x18,0x6a,0x68,
+  0x45,0xdb,0x04,0x6b,0xb1,0x74,0x1d,0x9a,0x00,0x1b,0x10,0xe4,0x81,0x96,0xa8,0x98,
+  0xb5,0x4c,0xaa,0x24,0x6d,0xc7,0x0b,0xf4,0xdf,0x77,0x48,0xea,0x42,0xc9,0x97,0x24,
+  0x5d,0xb7,0x87,0x36,0x0e,0x79,0xf8,0x9d,0xcb,0x77,0x6e,0xce,0x8a,0x48,0xc4,0xd4,
+  0x59,0xc6,0x34,0xe3,0x37,0x49,0x4e,0x0a,0x45,0x27,0x4f,0x32,0x91,0x2e,0x17,0x94,
+  0xeb,0x68,0x2a,0xb2,0x4d,0x24,0x78,0x21,0x48,0x96,0xe4,0x4b,0x9e,0x6a,0x26,0x78,
+  0x10,0xde,0x3d,0x41,0x48,0x94,0x94,0x5f,0x92,0x69,0x41,0x03,0xfc,0x9e,0x12,0x5d,
+  0x2e,0x17,0x25,0x0e,0x27,0x70,0xd1,0xbe,0xbd,0xa1,0xfa,0xac,0xa0,0xe6,0xe3,0xdb,
+  0xcd,0x87,0x2c,0xc0,0x69,0xc1,0x70,0x18,0xad,0x48,0xb1,0xa4,0x09,0xc6,0x46,0x54,
+  0x69,0x22,0xf5,0x9f,0x74,0xaa,0x44,0x3a,0xa7,0x5a,0x05,0xf6,0xfd,0x42,0x70,0xa6,
+  0x85,0x84,0xe3,0x0b,0x7b,0xec,0x4e,0x25,0xcd,0x25,0x55,0x33,0xa7,0x11,0x4e,0xaa,
+  0xc9,0x93,0x15,0x58,0x9e,0x91,0xa2,0x20,0xea,0x4d,0xc1,0x88,0x75,0x61,0x60,0xe3,
+  0x96,0x5f,0x08,0x99,0x47,0x24,0xcb,0x64,0xa2,0x67,0x4c,0x19,0x13,0xdf,0x68,0x2d,
+  0xd9,0x74,0xa9,0xc1,0x8f,0x8c,0x68,0x32,0x36,0x97,0x54,0x29,0xe7,0x8b,0x95,0x36,
+  0xe0,0x4e,0x9c,0x71,0x4e,0xe5,0x25,0xbd,0xd5,0x91,0x5a,0x4e,0x15,0xbc,0xe3,0x37,
+  0x41,0x3c,0x7a,0x1e,0xb7,0xb2,0xb7,0x33,0x99,0x70,0xba,0x46,0x7f,0x7d,0x3c,0x7f,
+  0xaf,0x75,0xf9,0x99,0x7e,0x5d,0x52,0x55,0x7b,0x00,0x77,0x91,0x09,0x5a,0x80,0x7f,
+  0x3d,0xbb,0xc4,0x23,0xfc,0xd4,0xd9,0x6e,0xe1,0x5f,0xe3,0x63,0xa3,0xf7,0x18,0x27,
+  0xf0,0xc1,0x1c,0x8c,0xb4,0x5c,0xd2,0xf6,0x99,0xa2,0x3c,0xab,0x9d,0x6e,0x1c,0x84,
+  0x80,0xa8,0x94,0xf0,0x53,0x8b,0xe1,0xbc,0x7d,0xb4,0x01,0x06,0xc0,0x19,0x81,0xfb,
+  0xfa,0xb6,0x09,0x1f,0x84,0xbf,0xda,0xb2,0xcc,0x37,0x6c,0x21,0x56,0xb4,0x36,0xcc,
+  0x78,0xe5,0xa8,0xc8,0x83,0x1f,0x52,0xc1,0x73,0x26,0x17,0x01,0xfe,0x6c,0x45,0x10,
+  0x3c,0x56,0x42,0xa2,0xc6,0xf7,0xd7,0xe8,0x12,0x82,0x0c,0xf1,0x56,0x02,0xa5,0x05,
+  0x25,0x52,0x21,0xa6,0x15,0xe0,0x69,0xc2,0x38,0xcd,0xd0,0xe2,0xab,0xd6,0xc8,0xa6,
+  0x4f,0x84,0xc3,0x10,0x8e,0x97,0x92,0x7f,0x53,0xe0,0x9d,0x85,0xce,0xf3,0x2e,0xf2,
+  0x27,0xdf,0x37,0x08,0x3c,0xa3,0xd2,0x05,0xc1,0xc9,0x67,0x6d,0x18,0x82,0xec,0xe8,
+  0x28,0xbb,0xc2,0x27,0x6b,0x26,0x29,0xbe,0x3e,0x3a,0x7a,0x23,0x25,0xd9,0x44,0x4c,
+  0xd9,0x9f,0x41,0x77,0x13,0x0e,0x9d,0xd4,0xd3,0x64,0x6f,0x71,0x39,0x6f,0x6c,0x74,
+  0x4c,0xee,0xea,0xa9,0x4b,0xd6,0xf7,0x97,0x1f,0xcf,0xeb,0x62,0xeb,0x80,0xa3,0x5c,
+  0xc8,0x33,0x92,0xce,0x82,0xd6,0x37,0xa6,0xe9,0xc2,0xda,0xe7,0x14,0x49,0xb1,0xee,
+  0x34,0xa5,0x12,0xca,0x9b,0xd6,0xca,0x02,0xac,0xa5,0x2b,0x0d,0x27,0xa9,0x3e,0x9c,
+  0x26,0xe6,0xf1,0x15,0xbe,0xb0,0x64,0xe2,0x6b,0x77,0x67,0xfc,0x34,0xe7,0xd1,0x1f,
+  0x10,0x31,0x78,0x17,0x02,0x64,0xa4,0xf4,0xa6,0xa0,0x40,0x05,0x49,0x99,0xde,0x24,
+  0x38,0x8e,0x5e,0x62,0x27,0xdd,0xbe,0x1e,0xe1,0x4b,0xba,0x28,0xa9,0x24,0xe0,0x36,
+  0x85,0xdf,0x6c,0x61,0xef,0x32,0x78,0x5e,0x5b,0xeb,0xac,0x48,0x69,0x51,0xec,0x37,
+  0x38,0x6b,0x0c,0x46,0x56,0x30,0x62,0x59,0x52,0xeb,0xfb,0x70,0x3a,0xc6,0xc7,0xe0,
+  0xc2,0x31,0x86,0x9f,0xf3,0x46,0x08,0x6c,0x9f,0x27,0x49,0x52,0x2b,0x6f,0x15,0x39,
+  0x55,0x19,0x5b,0xed,0xd5,0x04,0x77,0x9d,0x2a,0x64,0x44,0x23,0x0d,0xcd,0xe2,0x9d,
+  0xe0,0x1a,0xee,0x5d,0x9c,0xe6,0xd7,0x7d,0x81,0x14,0x58,0x53,0xe7,0x4c,0xe9,0x08,
+  0xd2,0x30,0xc0,0xb6,0xf8,0xc7,0x14,0xba,0xd6,0x10,0x29,0x75,0x28,0xa6,0xa1,0x99,
+  0x7c,0x4a,0xb0,0x49,0x56,0xdc,0x97,0x51,0xfb,0xdb,0xd9,0xc8,0xb2,0xe1,0xdc,0x1e,
+  0x20,0x83,0xc8,0xd9,0x0a,0xa0,0x8d,0x15,0x14,0x72,0x26,0xc0,0x39,0x38,0x08,0x4f,
+  0xbc,0xd4,0xef,0x3a,0xa9,0x51,0x3b,0xa9,0xee,0x85,0x98,0x16,0x4b,0xa0,0x73,0xd0,
+  0x9e,0xbd,0x57,0x96,0x09,0x52,0x42,0x59,0x66,0xef,0x66,0xac,0xc8,0x02,0x80,0x69,
+  0xaf,0x2b,0x44,0xa1,0x5d,0xa3,0x3b,0x2b,0xb4,0x2b,0x84,0x55,0x2d,0x68,0xb2,0xca,
+  0x07,0x31,0x0f,0x6a,0x94,0xca,0xcf,0x52,0x0d,0x09,0xa5,0xde,0x3d,0x2c,0x4b,0x3a,
+  0xe1,0xdd,0x99,0x72,0x61,0xef,0xf1,0x9e,0x3c,0x6f,0xb2,0xc5,0x43,0x71,0x69,0x9f,
+  0x8a,0x42,0xc8,0x04,0x83,0x39,0xc1,0x78,0x9c,0x11,0x7e,0x43,0xe5,0xe8,0xc7,0xfc,
+  0xc5,0x8b,0xe7,0xcf,0x5f,0x86,0x2d,0x8d,0xde,0xab,0x41,0x62,0x88,0x3c,0x2f,0xa0,
+  0x0b,0x8e,0xb3,0x25,0x14,0x07,0x70,0xd2,0xa5,0x07,0x98,0x60,0x2d,0x38,0x27,0x4a,
+  0x5f,0x50,0xca,0x2f,0x28,0xa4,0x4a,0xa6,0x7e,0x49,0xe2,0xd0,0x83,0x33,0xc9,0x00,
+  0xe9,0x11,0xd5,0x38,0x17,0x8c,0xa7,0x34,0x39,0x85,0x08,0x44,0x5c,0xac,0x83,0x70,
+  0xbc,0x0b,0xe2,0xa7,0x93,0x38,0x8e,0xeb,0x68,0x0e,0x43,0xe3,0xb3,0x02,0xd5,0xb9,
+  0x20,0xfa,0x93,0x43,0x3e,0xad,0x0d,0x0c,0xfc,0xb0,0x8c,0x76,0xc1,0xd7,0x1e,0x0c,
+  0x39,0xec,0x94,0x78,0x0c,0x12,0x9b,0x88,0x0f,0x64,0xd0,0xb6,0x30,0xdb,0xe3,0xdf,
+  0x6a,0xbe,0x57,0x1e,0x8a,0x44,0x77,0x71,0x6c,0xe5,0x7b,0x9e,0xd5,0x93,0x0a,0x0f,
+  0x65,0x2c,0x39,0xbf,0x93,0x05,0x94,0xe1,0x54,0x73,0x04,0xff,0xc6,0x37,0x33,0xa1,
+  0xf4,0x96,0x60,0xcd,0xbd,0x52,0x66,0x6b,0x48,0x70,0x09,0x5c,0x42,0x11,0xbd,0x7a,
+  0x56,0xde,0xa2,0x9f,0xcb,0xdb,0x49,0x0e,0x7a,0xc6,0x8a,0xfd,0x4d,0x5f,0x9d,0x9c,
+  0xc0,0xaf,0x33,0xca,0x6e,0x66,0xfa,0xd5,0x33,0xb8,0x9e,0x6c,0x41,0x09,0x0e,0x0b,
+  0x54,0x3a,0xef,0x0f,0x24,0x6f,0xd4,0x42,0x76,0xd6,0x33,0x09,0x79,0xe1,0xea,0x85,
+  0xb6,0x05,0xdb,0x13,0xfa,0xee,0x59,0x2d,0x00,0x63,0xa4,0xf7,0x5e,0xac,0xed,0x45,
+  0x65,0x87,0x1d,0x51,0x1b,0x9e,0x22,0x6f,0xe4,0xd9,0xe9,0xe8,0xcf,0x3c,0x5b,0x0d,
+  0x5a,0x6e,0xee,0x9a,0x5a,0x69,0xdb,0x88,0x37,0xd9,0x1a,0xbe,0x54,0x42,0xd6,0x84,
+  0x69,0x94,0x53,0x0d,0x9d,0x1e,0x3f,0xfd,0xa2,0x3a,0x76,0x6c,0xe7,0xad,0xef,0x41,
+  0x32,0x32,0x77,0x41,0xcb,0xdc,0xf6,0xa8,0xb5,0x46,0xa6,0xc4,0x00,0xd1,0xf0,0xae,
+  0xda,0x6b,0xec,0xff,0x68,0x26,0xc0,0x9a,0xb9,0x1f,0xcd,0xea,0x65,0x79,0x6b,0xee,
+  0xb7,0x37,0x61,0x6f,0xb6,0x1d,0x1a,0xfa,0x90,0x2f,0x6a,0x46,0x0e,0x0d,0x7d,0xdb,
+  0xa0,0x5b,0xe4,0x7d,0x83,0x7f,0x40,0xf3,0x74,0x09,0xff,0x7f,0x86,0xb6,0x60,0x6e,
+  0x61,0x24,0x8b,0x92,0xa5,0xb0,0x71,0xb5,0x5d,0xbf,0xf2,0x1d,0xba,0xc2,0x0d,0x3a,
+  0x82,0x14,0x97,0x64,0xe7,0x46,0x33,0x14,0xf9,0x66,0x17,0x1b,0x97,0xb6,0x21,0xff,
+  0x63,0xdf,0x44,0x69,0x30,0x49,0x71,0xd8,0xbd,0x4e,0xea,0x7b,0x7a,0xd8,0xa1,0x7e,
+  0x57,0x27,0xf7,0x15,0x4e,0x97,0xab,0x2a,0xde,0xce,0x52,0x15,0x3f,0xdc,0x35,0x15,
+  0xdf,0x9f,0x9b,0x2a,0x3e,0xb8,0x8e,0x3e,0x6e,0x25,0x6d,0xa4,0x4b,0x21,0x75,0xb3,
+  0x97,0xc6,0xf6,0x37,0xec,0xed,0x5d,0xa0,0x2f,0x30,0x52,0x73,0xc4,0x38,0x72,0xba,
+  0xc0,0xe3,0x4f,0xd3,0x2f,0x34,0xd5,0xd1,0x8c,0xa8,0x4f,0x6b,0x67,0xc2,0x68,0x1e,
+  0x7a,0x56,0x3c,0x72,0xd5,0xec,0xad,0x9b,0x2a,0x36,0x36,0xc0,0x0a,0x61,0x7e,0xf4,
+  0xb7,0xcd,0x56,0xee,0xe0,0xaa,0x78,0x70,0xd5,0xb1,0x94,0x56,0xed,0xc7,0x3d,0x4d,
+  0xdb,0x5f,0x8a,0x7a,0x59,0x6e,0xbf,0x1c,0xe9,0x19,0x95,0x8b,0xa3,0x23,0xbd,0x29,
+  0xa9,0xc8,0x91,0x77,0x66,0x36,0x61,0x61,0x43,0x83,0x1f,0xcc,0x7b,0xfb,0xf8,0x3e,
+  0xfa,0x5b,0x26,0xe8,0xc6,0x70,0xe1,0xa9,0xdd,0x41,0x89,0x77,0x3b,0x82,0x07,0xe1,
+  0xbf,0xca,0x10,0x9e,0x1e,0x66,0x91,0xa7,0x86,0x38,0x50,0x63,0x3e,0xf9,0xd4,0x98,
+  0xa3,0x1e,0x92,0xbe,0x07,0x49,0x37,0x48,0xc0,0xbb,0x09,0x2f,0x36,0x27,0x3e,0xa2,
+  0xe7,0xd7,0x15,0x88,0x5d,0x47,0x46,0xaa,0xaf,0x63,0x75,0x8f,0x8e,0x95,0xa7,0xc3,
+  0xc6,0x1c,0x9b,0xa3,0x83,0x4a,0xac,0x58,0xa7,0x65,0x98,0x5e,0x3c,0x0d,0x27,0xc3,
+  0x33,0xbd,0xe3,0x6c,0x95,0x7a,0x81,0x3d,0x94,0x79,0x55,0x9b,0x78,0x15,0x6a,0x27,
+  0x33,0xec,0x81,0x4a,0xc0,0x82,0x44,0xa5,0x84,0x4c,0x80,0xef,0xde,0x95,0xff,0x25,
+  0xba,0xdf,0xc6,0x58,0xf6,0x1b,0x90,0xde,0xfc,0xa1,0xe3,0x21,0x6c,0x5b,0x76,0x4c,
+  0xef,0x73,0xf5,0x64,0x01,0x6c,0x4d,0x3d,0xbe,0x01,0x3c,0xa2,0xf4,0x9b,0xa2,0xb7,
+  0x9a,0xfd,0x5a,0x3f,0x5c,0xe5,0x7b,0xeb,0xdb,0x46,0xce,0xed,0x21,0x46,0xc8,0x6c,
+  0x5e,0xff,0x00,0xda,0x4d,0xb2,0xf4,0xb4,0x13,0x00,0x00,
+};
+static const char refreshJS[] FLASHPROG = "<script src='/static/refresh.js?v=ea5997a2'></script>\n";
+
+// consoletoggles.js: 2468 bytes, 930 gzipped
+static const uint8_t webasset_consoletoggles_js[] FLASHPROG = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xc5,0x56,0xc1,0x72,0xdb,0x36,
+  0x10,0xbd,0xeb,0x2b,0xb6,0xb9,0x90,0x9c,0xc8,0x54,0xd3,0xa3,0x3d,0xba,0xa4,0x71,
+  0x26,0x99,0xb1,0x26,0x53,0xdb,0x3d,0x74,0x3a,0x9d,0x0e,0x44,0xae,0x44,0xc4,0x10,
+  0xc0,0x02,0x4b,0xd9,0x6a,0xe2,0x7f,0xef,0x2e,0x01,0x4a,0x74,0x2d,0xa5,0x9e,0x5c,
+  0xaa,0x83,0x44,0x02,0xbb,0x6f,0x77,0xdf,0xbe,0x05,0x34,0x9b,0xc1,0x35,0xae,0x3c,
+  0x86,0x06,0x96,0x8e,0x1a,0xa8,0x9c,0x0d,0xce,0x20,0x90,0x5b,0xaf,0x0d,0x06,0x58,
+  0x79,0xb7,0x01,0x6a,0x10,0x8c,0xde,0x22,0xd4,0xb8,0xd5,0x15,0x42,0x20,0x45,0x58,
+  0x4e,0x66,0x33,0xb8,0x6d,0x86,0xc5,0x2c,0x80,0xef,0x2c,0xe9,0x0d,0xc2,0xca,0xa8,
+  0x75,0x00,0xe5,0xb1,0x77,0x0c,0xae,0xf3,0xec,0xe3,0x56,0x40,0xbe,0xa3,0xe6,0x5c,
+  0x16,0x77,0xc0,0x11,0x91,0xc0,0x59,0x7e,0x58,0x3a,0x47,0x1c,0x4f,0xe0,0xc4,0xfe,
+  0x55,0x1f,0x92,0x43,0x78,0x7a,0x05,0x6c,0x44,0xda,0x0a,0x9a,0xad,0x7b,0xc4,0x95,
+  0xd1,0x6d,0x8b,0x35,0x2c,0x77,0x30,0x8b,0x39,0x1a,0xb7,0xee,0x77,0xd3,0x6b,0x83,
+  0x0f,0x75,0xb7,0x69,0xfb,0xec,0xae,0x51,0xd5,0xec,0x0d,0xb3,0x35,0xd2,0x01,0x69,
+  0x45,0xe8,0x01,0xb7,0xe8,0x77,0x50,0x35,0xca,0xae,0x11,0xee,0x10,0xdb,0x10,0x93,
+  0xbd,0xd7,0x54,0x35,0x5c,0xb7,0xb6,0x10,0x76,0xb6,0x02,0x7e,0x6f,0x64,0x47,0xe0,
+  0x52,0xf5,0xda,0x06,0x62,0x60,0xa9,0xa8,0xdf,0x55,0x90,0xb7,0x2e,0x04,0xbd,0x34,
+  0x3b,0x49,0xdb,0x60,0x01,0x4b,0xef,0xee,0x03,0xfa,0xb3,0xa0,0x6b,0x84,0x4a,0x31,
+  0x62,0x39,0x59,0x75,0xb6,0x22,0xdd,0x57,0xdc,0xf3,0xfd,0x73,0x64,0xfa,0x36,0x12,
+  0x9d,0x17,0xf0,0x65,0x02,0xbc,0x47,0x9d,0xb7,0xb0,0x42,0xce,0x22,0xcf,0xc6,0x79,
+  0x67,0x05,0x6f,0x03,0x94,0x9c,0x8b,0xcd,0x07,0xac,0x9c,0x81,0x5a,0xc6,0xe1,0x90,
+  0x5f,0x06,0xdf,0x61,0xa9,0xfc,0x1c,0xd8,0xa0,0xb8,0x80,0xc7,0xa3,0x9e,0xb5,0x22,
+  0x15,0x63,0xca,0x67,0xab,0x3c,0x6c,0xfe,0x22,0xba,0xb4,0x6a,0x69,0x98,0xde,0x39,
+  0xf4,0x06,0x25,0x93,0xbb,0xe0,0x65,0x98,0xcf,0xe7,0x90,0x61,0xdc,0xcc,0xe0,0xeb,
+  0x57,0x78,0xb6,0xfb,0xa6,0xb8,0x18,0x61,0xa5,0x2e,0x1c,0x81,0xfb,0x10,0x77,0x4e,
+  0x23,0x8e,0x0d,0x0e,0xa0,0xb5,0xab,0xba,0x0d,0x5a,0x2a,0x99,0x92,0x4b,0x83,0xf2,
+  0xf8,0x76,0xf7,0xb1,0xce,0x33,0xc9,0xfa,0xca,0xad,0x23,0x8d,0x59,0x51,0x32,0xd7,
+  0xd5,0x5d,0x1f,0x72,0x54,0xcf,0x7f,0xa2,0xa4,0x7c,0x8f,0xa0,0x3c,0xad,0x24,0x02,
+  0x0d,0x8c,0x56,0x4a,0xda,0xb4,0xa7,0x14,0xbd,0x3f,0x30,0x9a,0x06,0xa9,0xe4,0x45,
+  0xe7,0xf3,0xec,0xbd,0xd2,0x42,0x04,0xb9,0xd8,0xdb,0xbd,0xb0,0xcf,0xb3,0x29,0x88,
+  0xdf,0x00,0x7c,0x31,0x79,0x9c,0x1c,0xa4,0xa2,0xad,0xa6,0x13,0x3a,0x39,0xaa,0xa1,
+  0xde,0x5b,0xc6,0xb2,0x5f,0x80,0xc5,0x2f,0xb7,0xb7,0xc0,0x94,0x4e,0x45,0xc1,0xa2,
+  0x8c,0x33,0x2f,0xc2,0xa5,0xe6,0xe9,0x24,0xf3,0x88,0x8e,0xc4,0x2f,0xd8,0x06,0x2b,
+  0x0a,0x83,0xec,0x55,0x45,0x9d,0x32,0xa2,0xab,0xce,0x48,0xce,0xc0,0x6a,0xd7,0x7d,
+  0x7a,0xb9,0x78,0xa1,0xad,0x5b,0xa7,0x2d,0xf5,0xa3,0x19,0xa7,0x48,0x0e,0x00,0xae,
+  0xd0,0x6f,0xd3,0x08,0x14,0x23,0xf5,0xc7,0x29,0x5d,0xc4,0xae,0xa5,0x6a,0x06,0xb9,
+  0xef,0x07,0xfa,0xb8,0xd8,0xa3,0xc8,0x8f,0x17,0xfe,0x3d,0x3d,0xb9,0x94,0x9f,0x98,
+  0x90,0x94,0x35,0xb0,0xf5,0xb4,0x25,0xdf,0xe0,0x7a,0xd4,0xb1,0x03,0xe7,0x83,0x7c,
+  0x5f,0x40,0x7b,0x1e,0x10,0x9f,0xf2,0xf1,0x9c,0xa8,0x04,0x77,0x94,0xa8,0x24,0xcd,
+  0xff,0x85,0xac,0x14,0xfb,0x7b,0xb8,0xda,0x57,0x58,0xbb,0x7b,0x6b,0x9c,0xaa,0x93,
+  0x75,0xaa,0x51,0x8e,0x0f,0xc2,0x07,0x3e,0x55,0x4e,0x8f,0x6b,0x65,0x34,0x0f,0xe9,
+  0x56,0x99,0x0e,0x05,0x5a,0xaf,0x20,0xff,0x41,0x7c,0x8a,0x74,0x08,0x5e,0x24,0x9c,
+  0xa5,0x71,0x4b,0xc6,0xb1,0x78,0x0f,0x6f,0xf9,0x31,0xff,0x5d,0x8c,0xfe,0x98,0x32,
+  0x35,0xb4,0x6b,0xf1,0x1c,0x32,0x79,0x9f,0xb5,0x46,0x69,0x9b,0xf5,0xe9,0x45,0xb7,
+  0xce,0x1b,0xf6,0xfa,0xf5,0xfa,0xaa,0xac,0xb8,0x73,0x84,0x9f,0x96,0x9f,0x79,0x20,
+  0xf8,0x3d,0x17,0xc0,0xbd,0x99,0x1a,0xa7,0x18,0x2d,0x53,0x96,0x79,0xa6,0xb2,0xbd,
+  0x99,0x75,0xf7,0x29,0x87,0x77,0x6c,0x91,0xef,0xd7,0x79,0xc2,0xe6,0xb2,0x29,0xd5,
+  0xbd,0xef,0x8c,0xf9,0x0d,0x95,0xcf,0x63,0x63,0x5e,0x43,0x76,0x96,0xf1,0xf7,0x0d,
+  0x79,0x26,0x3b,0x4f,0x46,0x0b,0x67,0xa9,0xc9,0x8b,0xd7,0x6f,0x8a,0xb2,0x55,0xf5,
+  0x8d,0xdc,0x90,0xf9,0x4f,0xd3,0xec,0xc7,0xec,0x5b,0x4e,0x31,0xe6,0x49,0x8f,0x3f,
+  0x9f,0x7b,0x7c,0xe0,0x0b,0x3b,0x9c,0x76,0xf9,0x57,0x4e,0xda,0x76,0x84,0x2f,0x36,
+  0xbf,0x41,0x96,0x55,0x7d,0xcc,0x5c,0x58,0x51,0x65,0xc3,0x02,0x62,0x56,0xb8,0x01,
+  0xf1,0x7d,0x90,0x08,0xaf,0xf1,0x19,0xad,0x43,0xa3,0x36,0xce,0x9e,0x25,0x69,0xf6,
+  0xd5,0x32,0x8b,0x5c,0x46,0x49,0x0f,0x94,0x45,0x17,0xd6,0x46,0x75,0x17,0x59,0x96,
+  0x0e,0x7a,0xdc,0xba,0xbb,0x51,0x07,0x19,0x7a,0x3f,0xb2,0x1f,0xf9,0x78,0xd5,0xca,
+  0xe8,0xbf,0x51,0xfe,0x89,0xb4,0x8a,0xff,0x0a,0x48,0xb0,0xc9,0xbe,0xa9,0xaa,0xae,
+  0x2f,0xb7,0xfc,0x70,0xa5,0xf9,0xca,0xb7,0xc8,0x63,0xf0,0xee,0xd3,0x82,0xe5,0x4a,
+  0xb2,0xc6,0x96,0x7c,0x75,0x4d,0x61,0x3c,0x72,0x49,0x8c,0x2f,0xbd,0xad,0x86,0x69,
+  0x3b,0x76,0xce,0x4b,0x01,0x8f,0x13,0x11,0xe5,0x3f,0xc1,0x1c,0xbd,0x24,0xa4,0x09,
+  0x00,0x00,
+};
+static const char consoleTogglesJS[] FLASHPROG = "<script src='/static/consoletoggles.js?v=557a9ee4'></script>\n";
+
+// settings.js: 490 bytes, 245 gzipped
+static const uint8_t webasset_settings_js[] FLASHPROG = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xa5,0x8f,0xc1,0x6a,0xc3,0x30,
+  0x0c,0x86,0xef,0x79,0x8a,0xdc,0xec,0x6c,0xe0,0x7a,0x0c,0x76,0x58,0x09,0x83,0xb1,
+  0x42,0x0b,0xcb,0xa9,0x85,0x1d,0x8b,0x63,0xab,0xb1,0x89,0x2b,0x07,0x5b,0x69,0x08,
+  0x63,0xef,0xbe,0x36,0xac,0x3b,0x6c,0x10,0x06,0xbb,0x09,0xf1,0x7f,0xfa,0x7e,0x1d,
+  0x7a,0xd4,0xe4,0x02,0xe6,0x5b,0x1b,0x86,0xb5,0x33,0xf0,0xa2,0xbc,0x57,0x69,0xa7,
+  0x6a,0x0f,0x5c,0xd7,0xc5,0x7b,0x96,0xe7,0x26,0xe8,0xfe,0x08,0x48,0xa2,0x01,0x5a,
+  0x79,0xb8,0x8c,0xcf,0xe3,0xc6,0x70,0x66,0xa6,0x6c,0x02,0x22,0x87,0x4d,0x62,0x85,
+  0x48,0x34,0x7a,0x10,0xc6,0xa5,0xce,0xab,0xb1,0xd4,0xb5,0xd0,0x16,0x74,0x0b,0xe6,
+  0x89,0xd5,0x3e,0xe8,0x96,0x3d,0x32,0x0c,0x08,0x6c,0x99,0x7d,0x64,0x87,0x9f,0xe2,
+  0xad,0xfc,0x9b,0x34,0xc9,0x7f,0x0a,0xb5,0x55,0xd8,0x40,0xe5,0xf0,0x4d,0x11,0xf1,
+  0x2e,0x44,0x9a,0x84,0x27,0x15,0xf3,0xae,0x6b,0x07,0x5b,0xce,0xa8,0xf7,0x53,0x62,
+  0xcf,0x6e,0x27,0x4c,0x9c,0x94,0xef,0x61,0xf9,0x05,0x3b,0x24,0x88,0xe7,0xcd,0x2c,
+  0x7f,0x0d,0xfd,0x3e,0x31,0x47,0x1d,0x1d,0x0e,0xe7,0xb2,0xdf,0x90,0x43,0x84,0xb8,
+  0xde,0x55,0xaf,0x65,0xa5,0xc8,0x8a,0x18,0x7a,0x34,0x9c,0xdf,0x3f,0x48,0x79,0x73,
+  0x27,0xa5,0x5c,0x4c,0x2d,0x8b,0xc5,0x55,0x56,0x5c,0xfe,0xff,0x04,0xb1,0x98,0xa6,
+  0x24,0xea,0x01,0x00,0x00,
+};
+static const char settingsJS[] FLASHPROG = "<script src='/static/settings.js?v=1b339543'></script>\n";
+
+// changewifissid.js: 128 bytes, 103 gzipped
+static const uint8_t webasset_changewifissid_js[] FLASHPROG = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x4b,0x2b,0xcd,0x4b,0x2e,0xc9,
+  0xcc,0xcf,0x53,0x48,0xce,0x48,0xcc,0x4b,0x4f,0x2d,0xcf,0x4c,0xcb,0x2c,0x2e,0xce,
+  0x4c,0xd1,0xd0,0xac,0xe6,0x52,0x50,0x48,0xc9,0x4f,0x2e,0xcd,0x4d,0xcd,0x2b,0xd1,
+  0x4b,0x4f,0x2d,0x71,0xcd,0x49,0x05,0x31,0x9d,0x2a,0x3d,0x53,0x34,0xd4,0x41,0xca,
+  0xe2,0x41,0xea,0xe2,0x33,0x53,0xd4,0x35,0xf5,0xca,0x12,0x73,0x4a,0x53,0x6d,0x89,
+  0x50,0x5d,0x9c,0x9a,0x93,0x9a,0x5c,0x02,0xd3,0x61,0xcd,0x55,0xcb,0x05,0x00,0xdf,
+  0x0d,0xcb,0x09,0x80,0x00,0x00,0x00,
+};
+static const char changewifissidJS[] FLASHPROG = "<script src='/static/changewifissid.js?v=a877890c'></script>\n";
+
+// populatescanwifi.js: 796 bytes, 416 gzipped
+static const uint8_t webasset_populatescanwifi_js[] FLASHPROG = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x8d,0x52,0x4d,0x4f,0xc3,0x30,
+  0x0c,0xbd,0xf3,0x2b,0x72,0x5a,0x32,0x6d,0x2a,0x13,0x1f,0xa7,0x29,0x97,0xc1,0xc4,
+  0x87,0x06,0x48,0xb4,0x12,0xdc,0xa6,0xd0,0xb8,0x34,0xa2,0x4d,0x4b,0xe2,0x0e,0x26,
+  0xb4,0xff,0x8e,0xd3,0x56,0x65,0xec,0x80,0xc8,0x21,0xaa,0xe3,0xe7,0xf7,0x9e,0x5d,
+  0x6f,0x94,0x63,0x0e,0x32,0x07,0x3e,0x7f,0x32,0x99,0x89,0x53,0x65,0x65,0xd6,0xd8,
+  0x14,0x4d,0x65,0xc5,0xf8,0xeb,0x88,0xb1,0x0d,0x21,0x3c,0x14,0x52,0x57,0x69,0x53,
+  0x82,0xc5,0xe8,0x15,0x70,0x59,0x40,0xf8,0x5c,0x6c,0x6f,0xb4,0xe0,0x1f,0x54,0xb7,
+  0xf6,0xde,0xe8,0x35,0xc1,0x20,0x45,0x3e,0x9e,0xf7,0x65,0x0e,0xde,0xa5,0x85,0x0f,
+  0xf6,0x7c,0xb7,0xba,0x46,0xac,0x1f,0xe1,0xbd,0x01,0x8f,0xa2,0xcd,0x53,0x2e,0xaa,
+  0xac,0x03,0xa5,0xb7,0x1e,0x15,0x42,0x9a,0x2b,0xfb,0x0a,0x07,0xda,0x8c,0x99,0x4c,
+  0x04,0x64,0x8b,0x8b,0x03,0x4e,0x4a,0x79,0x36,0x1a,0x85,0xb7,0x50,0xd6,0x78,0x8a,
+  0x4f,0x66,0xb3,0x1e,0xdd,0xc9,0x16,0xc6,0xa3,0xbc,0x8d,0x1f,0xee,0xa3,0x5a,0x39,
+  0x0f,0x3d,0x81,0xaf,0x2b,0xeb,0x21,0x81,0x4f,0x6c,0xf5,0xc3,0x21,0xbf,0x91,0xb1,
+  0x16,0xdc,0x75,0x72,0xb7,0x92,0x9c,0xcf,0xf7,0x48,0x34,0x64,0x3f,0x2d,0xa7,0xa4,
+  0x8f,0xd0,0x77,0x2d,0x78,0x55,0x07,0x8b,0x7c,0xe0,0x21,0x6c,0xb4,0x51,0x45,0x03,
+  0x81,0x23,0x04,0x48,0x2a,0x92,0xc7,0xed,0x38,0x58,0x1c,0xdf,0x5c,0x76,0xcf,0xdd,
+  0x7c,0x40,0x4b,0x74,0x0d,0xb4,0x2f,0xb9,0xd1,0x1a,0x6c,0x17,0xef,0x99,0x52,0x75,
+  0x0d,0x56,0x5f,0xe4,0xa6,0xd0,0x82,0x60,0x83,0x50,0xe8,0x2c,0xca,0x2a,0xb7,0x54,
+  0x69,0x2e,0x86,0x51,0x19,0x84,0x72,0x18,0x40,0xe7,0x9e,0x1c,0xfe,0xdb,0x3d,0x0b,
+  0xe8,0xde,0x7f,0xa0,0x8a,0xc2,0xbf,0xfc,0x9d,0x6c,0xfb,0x19,0x72,0x13,0xce,0x04,
+  0x9f,0xb4,0xa1,0xa3,0x98,0x42,0xbd,0x28,0xc7,0xfc,0xa7,0xe4,0xb0,0x05,0xa2,0x18,
+  0xd4,0x76,0xbf,0xa6,0xef,0x71,0x5b,0x40,0xa4,0x8d,0xaf,0x0b,0xb5,0x95,0xfc,0xa5,
+  0xa8,0xd2,0xb7,0x9e,0x68,0x47,0xf7,0x6e,0xd8,0x14,0x22,0x13,0xfc,0x6a,0x99,0xf0,
+  0x29,0x3f,0x0e,0x0b,0xe7,0x69,0x51,0xf9,0x34,0xcc,0x6d,0xd8,0x26,0x4f,0x7a,0xdd,
+  0x6e,0x79,0xc0,0xc4,0x94,0x50,0x35,0x28,0x0e,0x76,0x7b,0x7a,0x3a,0xa3,0x43,0x20,
+  0x62,0xfe,0x03,0x75,0xde,0x62,0xbe,0x01,0xf2,0x4f,0x5f,0x5c,0x1c,0x03,0x00,0x00,
+};
+static const char populatescanwifiJS[] FLASHPROG = "<script src='/static/populatescanwifi.js?v=d422efee'></script>\n";
+
+// rules.js: 13646 bytes, 3364 gzipped
+static const uint8_t webasset_rules_js[] FLASHPROG = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xed,0x5b,0xdd,0x76,0xdb,0x36,
+  0x12,0xbe,0xef,0x53,0xc0,0x6a,0x6a,0x92,0xb1,0x44,0xd9,0xdd,0x9b,0xae,0x65,0x3b,
+  0x4d,0x1d,0xe7,0x34,0xa7,0x89,0xdd,0x63,0x3b,0xed,0xd9,0x95,0x95,0x73,0x28,0x12,
+  0xb2,0x58,0x93,0x04,0x4b,0x40,0x71,0xbc,0xb5,0x9f,0x62,0x6f,0xf7,0xe9,0xf6,0x49,
+  0x76,0x06,0x3f,0x24,0xf8,0x23,0x59,0x75,0x9c,0xa4,0x17,0x9b,0x44,0x3f,0x24,0x07,
+  0x33,0x83,0x6f,0x06,0x33,0x83,0x81,0x12,0xb2,0x8c,0x0b,0xf2,0xd3,0xd1,0x3f,0x7e,
+  0x3d,0x39,0x7d,0x71,0x46,0xf6,0xc9,0xd8,0x61,0x99,0xd3,0x77,0xc4,0x9c,0xe2,0x07,
+  0xcd,0x22,0x78,0x8f,0x67,0xf8,0x35,0xe1,0x54,0x7f,0xc8,0xeb,0xe3,0xb7,0xaf,0x5f,
+  0x3b,0x93,0xd1,0x57,0xa1,0xe4,0x70,0xf2,0xf3,0xd1,0xe9,0xf3,0xf3,0x93,0x53,0xc5,
+  0x62,0x73,0x13,0x08,0x6e,0x6f,0xe1,0x6d,0x7f,0x1f,0xde,0x0e,0xf0,0x6d,0x0f,0xdf,
+  0x36,0xe4,0x25,0x5e,0xc1,0x6b,0x0b,0x5e,0x03,0x78,0x3d,0x85,0xd7,0x10,0x5e,0xdf,
+  0xc0,0xeb,0x1d,0x8e,0xa9,0xd8,0xbe,0x7c,0x7b,0x7c,0x78,0xfe,0xea,0xe4,0x58,0xb1,
+  0x0d,0x59,0x90,0x50,0x1e,0xa2,0x1a,0x69,0xf0,0x01,0xdf,0x63,0x54,0x32,0xe6,0x9c,
+  0x0a,0xf8,0x2c,0xd8,0x42,0xaa,0x3b,0x4b,0x18,0x2b,0xe0,0x33,0xa4,0x71,0x02,0x1f,
+  0xf0,0xf0,0x3c,0x4e,0x29,0xde,0xc9,0x8b,0x38,0x43,0x4a,0x60,0x1e,0x06,0xf8,0xe5,
+  0x32,0x8f,0x19,0x4a,0xfb,0x6a,0xb6,0xc8,0x42,0x11,0xb3,0x8c,0xcc,0xe3,0xcb,0x79,
+  0x02,0x2f,0x71,0xba,0x00,0x59,0xae,0x47,0xfe,0xf8,0x8a,0x10,0xa5,0x0c,0x8d,0x62,
+  0xc1,0x0a,0xd0,0x24,0x62,0xe1,0x22,0xa5,0x99,0xf0,0x2f,0xa9,0x38,0x4a,0x28,0x7e,
+  0xfd,0xe1,0xe6,0x55,0xe4,0x3a,0x05,0x8e,0x71,0xbc,0x51,0x39,0x24,0x5c,0x14,0x9c,
+  0x15,0x3f,0x33,0x0e,0xa3,0x78,0xf0,0x9e,0x1e,0x9a,0xeb,0x18,0x85,0xb9,0x8a,0xa3,
+  0xa4,0x87,0x7f,0x09,0x15,0x44,0xd0,0x0f,0x02,0x68,0xd5,0x03,0x1f,0xaf,0x0e,0x59,
+  0x26,0x40,0xc0,0x48,0x13,0xcc,0x45,0x9a,0x00,0x81,0xe3,0x98,0x1b,0x31,0x5c,0x6d,
+  0x6b,0x0e,0xd7,0xf3,0x38,0xa1,0x6e,0x4c,0xf6,0x24,0x1f,0x3f,0xa1,0xd9,0xa5,0x98,
+  0xab,0x29,0x28,0xe2,0x34,0x10,0xe1,0x9c,0x46,0x30,0x64,0x16,0x80,0x21,0x47,0xf2,
+  0x81,0x7c,0x1b,0x0e,0xc9,0x21,0x4b,0x71,0x2a,0x5c,0x5e,0xc7,0x33,0x57,0xf2,0xe0,
+  0x8b,0x29,0x17,0x85,0x1b,0xf7,0xbf,0xf5,0xc8,0xfe,0x3e,0x08,0x1e,0x0e,0x1d,0xc3,
+  0x51,0xf1,0x04,0x1f,0x01,0x7e,0x92,0x38,0xce,0x22,0xfa,0xe1,0x64,0xe6,0x3a,0x17,
+  0x60,0x17,0x12,0x7b,0x23,0x4d,0x06,0xcc,0x24,0x15,0x8c,0x1f,0xec,0x78,0xf6,0x08,
+  0xa5,0xa2,0xa1,0x93,0x93,0xdb,0x02,0x21,0x7b,0x3c,0x0f,0x32,0x12,0x26,0x01,0xe7,
+  0xfb,0xbd,0x50,0xe9,0xd5,0x3b,0x70,0xc8,0x16,0x01,0xfb,0x07,0x39,0xfd,0x11,0x08,
+  0x6d,0xfd,0xe2,0xec,0x12,0x54,0x04,0xbe,0x9e,0x07,0x34,0xce,0xde,0x10,0xc7,0x1f,
+  0x38,0xa5,0x7c,0x84,0x34,0x8b,0xcc,0x65,0x85,0x82,0x28,0x16,0x1a,0x84,0xbb,0x1a,
+  0x14,0x67,0x92,0x65,0x89,0xc4,0x86,0x19,0xb1,0xb9,0x49,0xa4,0xd8,0x71,0x3c,0x91,
+  0xb3,0xe9,0x39,0x3d,0x72,0x7b,0x4b,0xec,0x5b,0x4e,0xcf,0xf1,0x2a,0x80,0x94,0x1b,
+  0xfc,0xbe,0x60,0x82,0xea,0x29,0x03,0xdd,0xa8,0x85,0x5e,0x0c,0x5a,0xef,0x98,0xdb,
+  0xca,0x8a,0xf8,0xa0,0x66,0x47,0x14,0x2e,0x19,0xc0,0x93,0x09,0xd9,0x00,0x51,0x92,
+  0x6d,0x25,0xab,0x34,0x9a,0xa2,0x90,0xca,0x5c,0x5c,0x38,0x12,0xef,0xad,0xad,0x51,
+  0x49,0x55,0xbb,0xbc,0xab,0x9b,0xa8,0xe1,0x39,0x35,0xd2,0x6e,0xeb,0x28,0xf4,0x3f,
+  0xa7,0x71,0x8e,0x17,0xe9,0x94,0x16,0x9d,0xc6,0x19,0x5e,0x44,0x43,0x58,0x35,0x5c,
+  0x18,0x2b,0x79,0x5d,0xbe,0x1a,0xaf,0x81,0xf4,0x70,0x7c,0x11,0xf9,0x13,0x9b,0x19,
+  0x82,0xea,0xad,0x05,0x49,0x26,0x15,0x54,0x90,0x74,0xe2,0xf0,0x28,0x30,0xfc,0x44,
+  0x6f,0xae,0x59,0x11,0x75,0xe3,0x30,0x0e,0x06,0xff,0x7a,0x3e,0xf8,0xe7,0x64,0x29,
+  0x1a,0x33,0x56,0xb8,0x88,0xc8,0x15,0x61,0xb3,0x32,0xfe,0x77,0xf8,0x52,0x15,0x00,
+  0xae,0x4a,0xaf,0x40,0xcf,0xba,0x92,0x6b,0x21,0x86,0xaf,0xdb,0xb8,0x02,0x36,0x86,
+  0x17,0xd7,0x35,0x59,0x83,0x1d,0x94,0x26,0x69,0xb6,0xcc,0xc8,0x83,0x7d,0x1b,0xe4,
+  0xae,0x51,0x25,0x29,0x0c,0xb6,0x95,0x59,0x86,0xf4,0x95,0xc2,0x40,0x41,0x7d,0xd5,
+  0x05,0xab,0x82,0x16,0x06,0x5e,0x35,0x62,0xcd,0x32,0x90,0xd5,0x9f,0x69,0x41,0x83,
+  0xab,0xea,0xc6,0x5d,0x6d,0xb5,0xd4,0xed,0xf0,0x52,0xa7,0x8e,0x8f,0x34,0xc4,0x0c,
+  0x0d,0x51,0xe6,0xbb,0x95,0x96,0x98,0xe9,0xa9,0x6c,0xed,0x28,0x5b,0xcc,0xb6,0x1c,
+  0xd7,0x59,0xc7,0x1e,0xeb,0x40,0x6a,0x32,0xa1,0xc2,0x74,0x66,0x61,0xea,0xb6,0x41,
+  0x35,0x9a,0xd8,0xe1,0xeb,0xd1,0x80,0xfd,0x91,0x06,0x22,0x5f,0xa4,0x39,0xc9,0x83,
+  0x22,0x48,0x39,0x71,0xbf,0xf7,0xba,0x20,0xae,0x05,0xdf,0xef,0x3b,0x93,0xd3,0xba,
+  0xe1,0xb5,0x01,0xda,0xfa,0x2b,0x3e,0x10,0x03,0xa9,0xe4,0xa7,0x5e,0xf3,0x2f,0x02,
+  0x41,0xb1,0x98,0x29,0x21,0xf9,0xe6,0x7e,0x48,0xbe,0xf9,0x32,0x90,0xe4,0xb4,0x08,
+  0x21,0x6b,0x7f,0x1e,0x5c,0xce,0xe7,0xb4,0x48,0x19,0x17,0x81,0x28,0x91,0x79,0x76,
+  0x3f,0x32,0xcf,0xbe,0x0c,0x32,0xbf,0x2f,0x60,0x10,0xac,0xb0,0xcf,0xe5,0x32,0x09,
+  0x88,0x25,0x9c,0x66,0x50,0x79,0xf2,0x65,0x98,0x54,0xc1,0xe5,0x3b,0x5d,0xe7,0x45,
+  0x7c,0xe7,0xbb,0xe9,0xb7,0xdb,0x5f,0x2f,0xc5,0xe8,0xbb,0xb5,0xb2,0xe8,0xf6,0xe0,
+  0xef,0xcf,0x07,0x2f,0x83,0xc1,0xec,0x81,0xb9,0x54,0xab,0xf1,0xa9,0x51,0xfa,0x25,
+  0x28,0xe2,0x60,0x0a,0xd5,0x3b,0x71,0xbf,0x26,0x01,0x4c,0xe5,0x89,0x77,0x6f,0xf1,
+  0xe7,0x7c,0xed,0xb4,0x8a,0xbf,0x27,0x8e,0xf7,0x45,0x7c,0xea,0xbd,0xd6,0xff,0x53,
+  0xe3,0x74,0x02,0xcb,0x3a,0x80,0xad,0x09,0xe0,0x04,0x94,0xe1,0x15,0x49,0x58,0x76,
+  0x49,0x0b,0xc2,0x32,0x80,0x6e,0x16,0x17,0x5c,0xb4,0x70,0x6b,0x16,0xc3,0xe0,0x86,
+  0x82,0x46,0x27,0x39,0xee,0x89,0xca,0x6d,0xa3,0xcf,0x93,0x38,0xa4,0xae,0xe7,0xe3,
+  0x53,0xd7,0x0d,0xfa,0x53,0x70,0xc3,0x03,0x32,0x35,0xd8,0x0c,0x48,0x60,0xca,0x8f,
+  0x51,0x23,0x71,0x32,0x4c,0x9c,0x25,0xd3,0x95,0x89,0x93,0xd5,0x4a,0x18,0xb6,0x4e,
+  0x3a,0x64,0x7a,0xc2,0xad,0x02,0x97,0x79,0x2b,0xcb,0x0d,0xf6,0xa9,0xca,0x8d,0x17,
+  0x74,0x16,0x2c,0x12,0xd8,0x5a,0xce,0x21,0x7a,0x84,0x82,0x16,0xcb,0xf1,0x36,0x33,
+  0x6a,0x94,0xe5,0x58,0x7f,0x94,0x0e,0x60,0x1c,0x0b,0x85,0xdc,0xa9,0x5d,0xa4,0xde,
+  0x7c,0xc6,0x59,0x46,0x8b,0x1f,0xcf,0xdf,0xbc,0x06,0x7d,0x91,0x13,0xd2,0x15,0xe0,
+  0x9a,0xac,0xe8,0xde,0xc6,0xf6,0xab,0xdd,0x2e,0xb0,0xbf,0xb3,0xf6,0xd4,0x0d,0xf9,
+  0x4a,0xc1,0x82,0x8a,0x45,0x91,0x29,0x57,0x2d,0x68,0x9e,0x04,0x60,0xfe,0xe1,0x78,
+  0x73,0xef,0x60,0x32,0xbc,0xec,0x93,0x14,0xad,0xef,0xfe,0xe1,0x6c,0x3a,0xbb,0xce,
+  0x66,0x90,0xe6,0x23,0xd9,0x33,0x80,0xef,0x89,0x18,0xc9,0x16,0x02,0x7c,0xbd,0x84,
+  0xaf,0x77,0xe3,0x14,0x56,0x48,0x5d,0x5c,0xd7,0x46,0x3b,0xb1,0x37,0xf2,0x9c,0xe2,
+  0x16,0xfa,0x1a,0x76,0xab,0xec,0x1a,0xf7,0xf0,0x67,0x34,0xa1,0x72,0xa8,0x2b,0x71,
+  0x01,0x2c,0x81,0xc2,0x2f,0x02,0xf0,0xec,0x43,0xb6,0xc8,0x84,0xf4,0x96,0x6d,0xcf,
+  0xa8,0x9c,0x2d,0x92,0xa4,0xda,0xe2,0x4b,0x32,0xdc,0xde,0xc3,0x10,0xe0,0x75,0x8a,
+  0x97,0xcf,0x85,0xbb,0x6d,0x75,0x01,0x72,0x40,0x2c,0x28,0xf4,0x33,0x20,0x95,0x43,
+  0xfc,0x10,0x96,0x0e,0x95,0xb7,0x94,0xd8,0x1a,0x95,0xcf,0xa5,0x4e,0xc7,0x2c,0xa2,
+  0xba,0x01,0xc0,0x71,0x12,0x5d,0x74,0xe2,0x28,0x8b,0x5c,0xc5,0x12,0x96,0x32,0x52,
+  0x07,0x31,0x58,0xae,0x4f,0xca,0x7b,0x27,0xb3,0x19,0x90,0x79,0xa3,0x0a,0xf5,0x3a,
+  0x0f,0xc1,0xd4,0x7e,0x17,0x96,0x9f,0x71,0x5a,0x1b,0xcf,0x25,0x46,0x4f,0xfa,0x24,
+  0x67,0x7a,0xbd,0x01,0x64,0x39,0x36,0x39,0x00,0x27,0x44,0xc7,0x40,0x35,0x5a,0x17,
+  0x72,0x5c,0xc7,0xe8,0xd0,0x1a,0x6e,0xd5,0xd0,0x50,0x23,0x33,0x80,0xe0,0x4c,0x04,
+  0x10,0x6a,0xf6,0xc9,0x98,0x26,0x13,0x43,0x8e,0xf7,0xfb,0x10,0x04,0x16,0x59,0x04,
+  0x8f,0x0b,0x61,0xf7,0x34,0xea,0x96,0x29,0xdb,0x35,0x21,0xac,0x32,0x61,0x43,0x5e,
+  0x18,0x08,0x25,0x07,0x39,0xa5,0x6d,0xeb,0x41,0xc8,0x20,0x75,0xe6,0x9c,0xba,0xb8,
+  0x5c,0xbd,0x5a,0x8f,0x65,0xc3,0x12,0x8c,0x79,0x01,0xb5,0x01,0x51,0xa5,0xb2,0x7e,
+  0xce,0x72,0xb7,0x2a,0xb8,0x01,0x1f,0x7c,0xe4,0xe3,0xdb,0xf9,0x4d,0x4e,0x25,0x52,
+  0x7f,0x6b,0x46,0xc6,0x0c,0xdb,0x3d,0x16,0x0a,0x15,0x22,0x5b,0x92,0x73,0x23,0xa4,
+  0x68,0xd0,0xf7,0xf6,0xeb,0x03,0xed,0xa8,0xd6,0x98,0xa0,0xc2,0x0c,0x07,0x0d,0x2a,
+  0xe6,0x5e,0x15,0x77,0x6a,0x68,0xda,0x31,0xca,0x04,0x24,0xdb,0x46,0x35,0xa1,0x3a,
+  0x88,0x10,0x6c,0x0f,0xd6,0xf2,0x5f,0xac,0x51,0xf1,0x43,0xc0,0x2d,0x42,0x7f,0xe6,
+  0x8d,0x69,0xe8,0xa6,0xd5,0x60,0x60,0x2b,0x6e,0x01,0xb9,0xe0,0x73,0xb7,0xc1,0xc1,
+  0x8e,0x60,0x77,0xcd,0xf0,0x25,0xd7,0x2e,0x4d,0xd9,0x7b,0xfa,0x3c,0x49,0xa4,0xb1,
+  0xb9,0xb2,0x36,0x3e,0x08,0xa2,0x48,0xd9,0x5f,0x22,0xd3,0x08,0x1c,0x8b,0x3c,0x02,
+  0xff,0x78,0x0d,0xab,0x47,0xb7,0x18,0x3e,0xb6,0xfd,0x97,0x54,0xac,0x56,0x8d,0x43,
+  0xb2,0x81,0x6a,0x1a,0xb4,0x86,0xf3,0xce,0x6e,0xa0,0xcf,0xf3,0x24,0x16,0xb2,0xcf,
+  0xd6,0xa0,0x37,0xd6,0x91,0x63,0x2d,0xa4,0xbb,0xda,0x87,0x26,0x83,0xa2,0x8d,0x76,
+  0x46,0xf0,0xb1,0xb7,0x5f,0xf1,0x18,0x61,0x6e,0x30,0x26,0x31,0x99,0x04,0xeb,0x18,
+  0x14,0x3a,0xaa,0xe0,0xb6,0xe6,0x68,0x6b,0x58,0x26,0x0d,0x1b,0xe0,0xf7,0x41,0x12,
+  0x23,0xc4,0x8f,0xd2,0x5b,0x85,0xb0,0x84,0x79,0x70,0xc5,0x10,0x2d,0x0e,0x4b,0x6d,
+  0x45,0x5c,0x6b,0xcd,0xaa,0x15,0xdb,0x81,0x2d,0xc4,0xc2,0xd4,0x35,0xcb,0x1d,0x13,
+  0x2b,0x92,0x1a,0x24,0x14,0xa3,0x5a,0x72,0x74,0xf6,0xa2,0xf8,0x7d,0x55,0x88,0x95,
+  0x32,0x67,0x94,0x46,0x53,0x0c,0x5c,0xd7,0x41,0x91,0xc9,0x1e,0x99,0x9c,0x37,0x81,
+  0xc0,0x4b,0x68,0x9a,0x8b,0x1b,0x7f,0x6f,0x08,0x23,0x4d,0xf1,0x50,0x85,0x4c,0x8d,
+  0xac,0x46,0xa6,0x28,0x98,0x74,0x9f,0xf1,0xa4,0x52,0x5e,0x73,0x6c,0xde,0x9e,0x26,
+  0x2c,0xbc,0x2a,0x83,0xe5,0xc4,0xb2,0x7b,0x98,0xd0,0x20,0x3b,0x54,0x53,0xc6,0xe9,
+  0x54,0x29,0xf7,0x02,0xfe,0xfa,0x4f,0x9f,0x0c,0x2f,0xd3,0x3e,0xb8,0x85,0x02,0xc8,
+  0x26,0x36,0xdf,0xab,0x11,0xce,0xf8,0x9d,0x33,0x79,0xea,0x60,0x9a,0x76,0x7a,0x3d,
+  0xc7,0xab,0x9e,0xf4,0xc6,0xef,0x7a,0x93,0xa7,0xbd,0xf2,0xc9,0xc8,0x9e,0x88,0xf1,
+  0xe6,0x8a,0x63,0xc3,0x89,0x2d,0x8f,0xd4,0x4e,0x25,0x33,0x41,0x79,0xb1,0x57,0x77,
+  0x6a,0x73,0xbf,0xf2,0xd2,0x4a,0x8e,0x59,0x00,0x63,0x4d,0xa3,0x5b,0xae,0x8a,0x00,
+  0xed,0x9b,0xca,0x32,0x0c,0x9f,0x5a,0xe6,0xd6,0x45,0x16,0x9a,0x5c,0xd3,0x78,0x38,
+  0x44,0xc4,0xd9,0xc2,0x6e,0x95,0xeb,0x8c,0x06,0x9b,0x4d,0xe9,0x6b,0x5c,0xc6,0x4a,
+  0x49,0xae,0x67,0x34,0x1c,0xdd,0x5e,0x4c,0xf1,0x04,0xe5,0x62,0x3a,0xf4,0xfc,0x34,
+  0xc8,0x5d,0x8e,0xe5,0x0c,0xd7,0xa2,0x3c,0x7f,0x16,0x27,0x50,0xb8,0xe9,0xbb,0xb6,
+  0x68,0x33,0x7f,0x2e,0x52,0x21,0xcb,0xda,0x52,0x48,0x15,0x1c,0x41,0xbd,0xe1,0x3b,
+  0x96,0x5d,0xf0,0x2d,0xbd,0x55,0x40,0xe2,0x5a,0x6b,0xa7,0x72,0x03,0x15,0x3d,0xff,
+  0x10,0x90,0x72,0x76,0x89,0x3c,0xd9,0x91,0x73,0xde,0x2d,0x31,0x85,0x6d,0xc9,0x9d,
+  0xd7,0x8c,0xf2,0x32,0x88,0x4b,0x31,0xf1,0xec,0x01,0x62,0xf0,0x78,0xa8,0x2d,0xa6,
+  0x4f,0xe6,0x01,0x3f,0x02,0xce,0xbb,0x2a,0x4f,0xaf,0x12,0xab,0x0e,0x99,0x56,0x88,
+  0x06,0x2a,0x4b,0xba,0xde,0x23,0xc8,0x2a,0x0d,0x77,0x64,0xd5,0xa3,0x71,0x8b,0x6a,
+  0xb0,0x33,0xf1,0x51,0x4f,0xd9,0x40,0x47,0x55,0xeb,0x9b,0x00,0xb5,0xda,0xd4,0x7c,
+  0x1c,0xcc,0x04,0x04,0xcb,0x7e,0xd7,0xb8,0xda,0x8e,0x2c,0xfa,0x77,0x49,0x4f,0x69,
+  0xd8,0x83,0x8a,0x46,0xcc,0xd9,0x42,0x1f,0xac,0xc0,0x8a,0x24,0x3d,0xb8,0xeb,0x58,
+  0x29,0xf5,0xae,0x9c,0xd6,0x7d,0x5a,0x69,0x78,0x3e,0x4e,0x9f,0x60,0x06,0x8e,0xa5,
+  0x2e,0xeb,0x6a,0xac,0xc4,0xfa,0xc9,0x5f,0x1a,0xe7,0xbf,0x0c,0xca,0x6f,0x20,0xf2,
+  0xc7,0x79,0x42,0x8d,0x5a,0xb0,0x5a,0x61,0xb3,0x91,0xd2,0x65,0xea,0xd8,0x22,0xd6,
+  0xd4,0xab,0xb5,0x37,0x5c,0x61,0xb8,0x2c,0x7a,0x80,0xdd,0x1e,0x68,0x86,0x2c,0xea,
+  0xb0,0x82,0x14,0xb1,0xf6,0xbc,0x55,0x49,0xbc,0xde,0x26,0xf7,0x50,0xf6,0x16,0x10,
+  0xdf,0x34,0xe6,0x1c,0x65,0x71,0x9a,0xc6,0x50,0x8f,0x43,0xe8,0x85,0xda,0xf5,0xf0,
+  0xe4,0xf4,0xf4,0xe8,0xf0,0xfc,0xe8,0x05,0xf9,0xe5,0xe8,0xf4,0xec,0xd5,0xc9,0xb1,
+  0x15,0x97,0x59,0x11,0x5f,0x9e,0x97,0x11,0x3e,0x6c,0xe4,0x99,0x32,0x21,0xd4,0xc2,
+  0x3e,0xc0,0x65,0x0f,0x83,0x82,0x7e,0xc3,0xba,0xf6,0x39,0x56,0xc4,0xfc,0x57,0x98,
+  0xbe,0x2b,0x8f,0x3f,0xdb,0x75,0x3b,0x8d,0xf8,0x99,0x51,0x10,0xa4,0xd6,0x46,0x03,
+  0x76,0x7a,0xec,0xc8,0x91,0x27,0x22,0x16,0x3a,0x1d,0x7f,0x96,0x8c,0x95,0x07,0xf2,
+  0x0f,0x1f,0x8e,0x07,0xf9,0x38,0x7a,0xf5,0x60,0x1b,0x04,0xb9,0x6e,0xe5,0xa1,0xff,
+  0x03,0x86,0x81,0xb4,0x7b,0x47,0x6d,0x0c,0xdf,0xb9,0x2c,0xbb,0x8d,0x67,0xb7,0x2a,
+  0x78,0x79,0x17,0x5c,0xbb,0xb3,0xc5,0xaf,0xf4,0x97,0x2a,0xf9,0xd5,0xd1,0xb6,0xfd,
+  0xd9,0x54,0x45,0xf7,0x2f,0xe4,0xa6,0x53,0x39,0xcb,0xb7,0x13,0x9d,0x4b,0xe9,0xa0,
+  0x5a,0x48,0xca,0x05,0xa0,0xc2,0x4d,0x18,0x97,0x2e,0x67,0x51,0x63,0xea,0x9f,0xaa,
+  0x3e,0x96,0x8c,0x85,0x20,0x5c,0x29,0x23,0xd5,0x9a,0xfa,0xf2,0x2b,0xdc,0xf4,0x8c,
+  0xfc,0xda,0x7a,0x7c,0x6b,0x78,0x4a,0x8e,0x2e,0xf7,0x76,0xe5,0x30,0x23,0xca,0xff,
+  0x8d,0xc5,0x99,0x0b,0xa9,0xd6,0xf1,0xbc,0x51,0xab,0x7b,0x23,0xcb,0xd1,0xd7,0x31,
+  0x17,0x7a,0x2f,0xa4,0x0b,0xe8,0x81,0x94,0x80,0x83,0xd4,0xa5,0x2c,0x57,0x1d,0xab,
+  0xd8,0xd5,0x1a,0xb4,0xe7,0xd9,0xe2,0x0b,0x5b,0xa9,0x3a,0x53,0x6f,0xf4,0xe0,0x0a,
+  0x59,0x32,0xe8,0x1d,0xec,0x71,0x51,0xb0,0xec,0xf2,0xe0,0x48,0x2a,0xb1,0xbb,0x37,
+  0xd4,0xd7,0x7b,0xd3,0x42,0xb5,0xdf,0x94,0x72,0x6a,0xe2,0xf2,0xa6,0x6e,0xc2,0x95,
+  0x65,0x74,0x95,0x08,0x4a,0x67,0xf8,0x73,0x53,0xb1,0x00,0xf9,0xc8,0x62,0xdf,0x4c,
+  0xe6,0x57,0xad,0x48,0x7b,0x3a,0xa5,0x8a,0xf7,0x4f,0xe8,0x33,0x28,0xce,0x17,0x61,
+  0x48,0x39,0xaf,0x14,0xff,0xef,0x7f,0xfe,0x4d,0xaa,0x1d,0x8b,0x1c,0xb2,0x51,0x9b,
+  0xc3,0x31,0x23,0xfc,0x26,0x13,0xc1,0x07,0xb3,0x49,0x89,0xa8,0xa0,0xa1,0x00,0xd7,
+  0xb4,0x27,0xd0,0xea,0xcd,0x3d,0xce,0xee,0x0f,0x6f,0x9c,0x2f,0xfb,0xb5,0x4c,0x7d,
+  0x0f,0x07,0x09,0xe5,0x2d,0x60,0x38,0xa3,0x90,0xb7,0x64,0x16,0x23,0xf4,0x03,0xa4,
+  0x84,0x30,0x86,0x1d,0x13,0x8b,0x6e,0x64,0x8d,0x5f,0xb0,0x04,0xf7,0x1f,0x48,0x02,
+  0x41,0x1e,0xd5,0x54,0x22,0xfb,0x1a,0xfa,0x94,0x42,0xf2,0x8b,0x60,0x05,0xfe,0x7c,
+  0x72,0x76,0xee,0xf4,0xd5,0xae,0x98,0x06,0x11,0x6c,0x7b,0x77,0xcb,0x10,0xe4,0x68,
+  0xf1,0x03,0xec,0xf1,0x40,0x9c,0x71,0x82,0x1c,0xe5,0x48,0xa0,0x87,0x1f,0x06,0xd7,
+  0xd7,0xd7,0x03,0xc8,0x69,0xe9,0x60,0x51,0x80,0x53,0x62,0x6a,0x8a,0x1c,0x15,0x6e,
+  0x14,0x3f,0x54,0x66,0x57,0xaf,0xcc,0x7d,0xe9,0xef,0x92,0xe8,0xed,0xe9,0xab,0x43,
+  0x96,0xe6,0x2c,0x03,0xce,0x6e,0x39,0x6f,0xec,0xb3,0xdf,0xe1,0x9b,0x8f,0xa9,0xc1,
+  0x35,0x08,0xbb,0x60,0x7a,0x20,0xad,0x2a,0x9c,0x78,0x46,0xca,0x7b,0x3e,0xbb,0xaa,
+  0xe2,0x25,0xa0,0x72,0x4a,0x13,0x16,0x44,0x04,0x18,0x90,0x3c,0xb8,0xa4,0x44,0x80,
+  0x41,0xe7,0xec,0x5a,0x5a,0x29,0x52,0x10,0x9b,0x26,0x8d,0xea,0xdc,0x41,0x20,0x92,
+  0x93,0xf1,0xe7,0x05,0x9d,0xa1,0x53,0x0d,0x15,0x4a,0x9d,0xed,0x9f,0x20,0xa1,0x05,
+  0xa4,0xdd,0x97,0x41,0x9c,0x00,0x37,0xe4,0x0d,0x6c,0x89,0x65,0x49,0x1d,0x67,0xe5,
+  0x24,0x42,0x2c,0x2a,0xaa,0x59,0x80,0x43,0xd9,0x01,0x96,0x25,0xd4,0x97,0x3e,0xe6,
+  0x3a,0x32,0x36,0x20,0x2b,0x0c,0xe0,0x92,0xd9,0x2e,0x18,0x09,0xe9,0x15,0x4b,0x2d,
+  0xb5,0x4d,0xa6,0x64,0xde,0x35,0x7a,0x3e,0xb8,0x1b,0x2d,0x6c,0x8f,0x84,0xd0,0x01,
+  0x12,0x67,0x71,0x91,0xba,0xce,0x73,0xf0,0xfb,0x1b,0xb6,0x80,0xa5,0xa1,0xbf,0x5c,
+  0x07,0x99,0xc0,0x99,0xc8,0x51,0x20,0x2a,0x51,0xac,0x9f,0x91,0xf3,0x79,0xcc,0x49,
+  0x18,0x64,0x19,0x03,0x9f,0xa2,0x10,0xa3,0x23,0x30,0x97,0x5f,0x95,0x0a,0x0f,0xf0,
+  0x73,0xd2,0xe1,0xd7,0x65,0xeb,0xc6,0xfa,0xa9,0x12,0x82,0x8a,0x16,0x94,0x2d,0x05,
+  0xcb,0x68,0x4a,0x24,0xfa,0xdb,0x8b,0x40,0x04,0xb2,0x61,0x77,0x4d,0x5e,0xea,0x4b,
+  0x53,0xf9,0x98,0xc7,0x3e,0x78,0x2a,0x64,0x6d,0xa3,0x40,0xd9,0x0a,0x30,0xfb,0xd2,
+  0xa5,0xeb,0xa2,0x7b,0x65,0x18,0x5f,0x36,0xec,0x95,0xb1,0xd5,0xd1,0xd0,0x3d,0xfe,
+  0xba,0xc2,0x63,0xd7,0x74,0xc3,0x8e,0x3a,0xb4,0xe5,0x8a,0xca,0x80,0x35,0xb4,0xcb,
+  0xdc,0xaf,0xd5,0x5c,0xee,0x91,0x4b,0x7c,0x52,0xf2,0x5c,0xe2,0x95,0x0d,0xbf,0xac,
+  0x93,0x96,0xab,0xc1,0x2b,0x03,0x66,0xe9,0x20,0x10,0xe1,0x8f,0xde,0xc3,0x17,0x0c,
+  0xf7,0x14,0xa2,0xb9,0xeb,0xbc,0x38,0x79,0xa3,0xbd,0xe1,0x35,0x2c,0x5e,0x08,0x21,
+  0x7d,0x52,0x2a,0xf9,0xe0,0xa0,0x8a,0x99,0x5f,0xfd,0x18,0xb1,0x9e,0x6a,0xea,0xbe,
+  0xb7,0x32,0xd0,0x96,0x63,0xda,0x2a,0x5f,0xd1,0x1b,0x30,0x5b,0x66,0x6b,0x5a,0xb3,
+  0xb7,0x4b,0x7d,0x20,0x51,0x27,0xa8,0x47,0xc0,0xb7,0xa8,0xed,0x16,0xa9,0x9f,0x17,
+  0x14,0x19,0xea,0xa3,0x2f,0x7b,0x13,0xb1,0xd6,0xe9,0x82,0x4d,0xba,0xf2,0xb8,0xc6,
+  0x26,0x5c,0xd5,0x7c,0x2d,0x4f,0x56,0xb7,0xfb,0x04,0x98,0x34,0x4e,0x46,0x3c,0xaf,
+  0xd9,0xd9,0xb2,0xf9,0x86,0x8b,0xa2,0x90,0xe0,0x34,0xba,0x54,0xbc,0x3a,0xea,0xdc,
+  0x99,0x34,0x07,0xe1,0x0f,0x2b,0x33,0xf1,0x06,0x3d,0x12,0x37,0x35,0x15,0x0b,0x5f,
+  0x6e,0xc6,0x60,0x37,0x38,0xbe,0x10,0x64,0xf2,0x74,0x68,0x89,0x93,0x9d,0x5d,0x39,
+  0x0e,0x0f,0xa0,0x2d,0x06,0xcf,0xec,0xab,0xf1,0xf6,0x84,0xec,0x96,0x41,0xa5,0xd5,
+  0x24,0xd3,0x6a,0xda,0x12,0x6d,0x8b,0x9b,0x53,0xd6,0x8a,0xb8,0xb5,0x65,0xa9,0x6f,
+  0x38,0xb5,0x42,0x78,0xcc,0x7a,0x21,0x9c,0xf6,0x66,0xd0,0x1c,0x59,0x44,0x60,0x41,
+  0x51,0x1d,0x7d,0xb5,0x50,0x44,0x73,0x1c,0xab,0x0e,0x65,0xe3,0x78,0xe7,0x5c,0x3f,
+  0x91,0xe8,0x43,0x0e,0x55,0x12,0x2d,0x06,0x4a,0x40,0x0c,0xc1,0xa5,0x50,0x84,0x86,
+  0x57,0x8b,0xc6,0x9c,0x9b,0x3c,0xc7,0xa6,0xca,0x4a,0xb2,0xa3,0x2c,0x5a,0x4a,0xb4,
+  0xf4,0x3c,0xa2,0x7a,0xdc,0x3a,0x95,0x28,0xcf,0xa4,0x1b,0xbf,0x46,0xae,0x9e,0x74,
+  0x9c,0x55,0x74,0xfd,0xa4,0xb3,0x5a,0x57,0xe7,0xc1,0xf4,0x8b,0xae,0xaa,0x47,0xb4,
+  0xab,0x70,0xfe,0x6f,0xce,0x1f,0xa0,0x64,0xe7,0x79,0x10,0xd2,0x9a,0x51,0xff,0x84,
+  0xe1,0xee,0x39,0xe5,0x7e,0x70,0xdc,0x44,0xc8,0x7e,0xa0,0xb3,0xf2,0xc0,0xf8,0x81,
+  0x21,0x74,0x59,0x38,0x6e,0xb2,0x7f,0xc4,0x50,0x8b,0x95,0xdf,0xb2,0xc8,0xba,0xf5,
+  0x64,0x28,0x9b,0x2f,0xf5,0x83,0xe1,0xa8,0xd1,0x4d,0x5b,0xb1,0xa4,0xaa,0x5e,0xd1,
+  0xf5,0x2b,0x13,0x94,0x6d,0x69,0x35,0x40,0xec,0x07,0x95,0xaa,0x1d,0xdc,0x70,0x36,
+  0xe5,0x79,0x6d,0x13,0x99,0x72,0x64,0x9b,0x5d,0x9b,0xd3,0x54,0x8e,0xd4,0x50,0xdd,
+  0x67,0xb0,0x52,0x6c,0x87,0x4a,0xb2,0x03,0xbd,0x0e,0x9f,0x25,0xfa,0xd6,0x58,0x76,
+  0x56,0x21,0x96,0xaa,0x5b,0x16,0x9e,0x5b,0x95,0x68,0x9b,0xc5,0xea,0x9f,0xac,0x54,
+  0x00,0x5a,0xac,0xba,0x34,0x59,0xbe,0x74,0x57,0x2e,0xde,0x56,0x9b,0xd3,0xae,0xaa,
+  0x97,0xd6,0x4b,0x71,0x96,0x2f,0x04,0x54,0x4b,0x75,0xa1,0x7a,0x68,0xb7,0x26,0x4b,
+  0x74,0x80,0x62,0xd2,0xb3,0xff,0x7b,0x4b,0xc7,0x52,0x7b,0xbc,0x1f,0xc6,0x6c,0x7f,
+  0x89,0x5f,0xc5,0xdc,0x57,0xdd,0x7e,0xce,0xdf,0xcc,0xfc,0x0f,0xf7,0x92,0xe5,0x78,
+  0x4e,0x35,0x00,0x00,
+};
+static const char rulesJS[] FLASHPROG = "<script src='/static/rules.js?v=78118bd0'></script>\n";
+
+static const webAssetStruct webAssets[] FLASHPROG = {
+  { "/static/heishamon.css", "text/css", "ad358e1f", webasset_heishamon_css, sizeof(webasset_heishamon_css) },
+  { "/static/menu.js", "application/javascript", "1a832117", webasset_menu_js, sizeof(webasset_menu_js) },
+  { "/static/websocket.js", "application/javascript", "e95f15e3", webasset_websocket_js, sizeof(webasset_websocket_js) },
+  { "/static/select.js", "application/javascript", "ec9bd0ea", webasset_select_js, sizeof(webasset_select_js) },
+  { "/static/refresh.js", "application/javascript", "ea5997a2", webasset_refresh_js, sizeof(webasset_refresh_js) },
+  { "/static/consoletoggles.js", "application/javascript", "557a9ee4", webasset_consoletoggles_js, sizeof(webasset_consoletoggles_js) },
+  { "/static/settings.js", "application/javascript", "1b339543", webasset_settings_js, sizeof(webasset_settings_js) },
+  { "/static/changewifissid.js", "application/javascript", "a877890c", webasset_changewifissid_js, sizeof(webasset_changewifissid_js) },
+  { "/static/populatescanwifi.js", "application/javascript", "d422efee", webasset_populatescanwifi_js, sizeof(webasset_populatescanwifi_js) },
+  { "/static/rules.js", "application/javascript", "78118bd0", webasset_rules_js, sizeof(webasset_rules_js) },
+};
+
+#define NUMBER_OF_WEBASSETS (sizeof(webAssets) / sizeof(webAssets[0]))
+
+#endif
@@ -3,7 +3,11 @@
 #include "version.h"
 #include "htmlcode.h"
 #include "commands.h"
+#include "persist.h"
+#include "settingsstore.h"
 #include "src/common/progmem.h"
+#include "src/common/stricmp.h"
+#include "src/common/strnstr.h"
 #include "src/common/webserver.h"
 #include "src/common/timerqueue.h"
 
@@ -180,99 +184,46 @@ void ntpReload(settingsStruct *heishamonSettings) {
   sntp_init();
 }
 
+// The binary settings file is read first, the json file of older firmware
+// only when there is none, it is converted on the first boot
 void loadSettings(settingsStruct *heishamonSettings) {
-  //read configuration from FS json
   log_message(_F("mounting FS..."));
 
-  if (LittleFS.begin()) {
+  if (persistMount()) {
     log_message(_F("mounted file system"));
-    if (LittleFS.exists("/config.json")) {
-      //file exists, reading and loading
-      log_message(_F("reading config file"));
-      File configFile = LittleFS.open("/config.json", "r");
-      if (configFile) {
-        log_message(_F("opened config file"));
-        size_t size = configFile.size();
-        // Allocate a buffer to store contents of the file.
-        std::unique_ptr<char[]> buf(new char[size]);
-
-        configFile.readBytes(buf.get(), size);
-        JsonDocument jsonDoc;
-        DeserializationError error = deserializeJson(jsonDoc, buf.get());
-        char log_msg[1024];
-        serializeJson(jsonDoc, log_msg);
-        log_message(log_msg);
-        if (!error) {
-          log_message(_F("parsed json"));
-          //read updated parameters, make sure no overflow
-          if ( jsonDoc[F("wifi_ssid")] ) strlcpy(heishamonSettings->wifi_ssid, jsonDoc[F("wifi_ssid")], sizeof(heishamonSettings->wifi_ssid));
-          if ( jsonDoc[F("wifi_password")] ) strlcpy(heishamonSettings->wifi_password, jsonDoc[F("wifi_password")], sizeof(heishamonSettings->wifi_password));
-          if ( jsonDoc[F("wifi_hostname")] ) strlcpy(heishamonSettings->wifi_hostname, jsonDoc[F("wifi_hostname")], sizeof(heishamonSettings->wifi_hostname));
-          if ( jsonDoc[F("ota_password")] ) strlcpy(heishamonSettings->ota_password, jsonDoc[F("ota_password")], sizeof(heishamonSettings->ota_password));
-          if ( jsonDoc[F("mqtt_topic_base")] ) strlcpy(heishamonSettings->mqtt_topic_base, jsonDoc[F("mqtt_topic_base")], sizeof(heishamonSettings->mqtt_topic_base));
-          if ( jsonDoc[F("mqtt_server")] ) strlcpy(heishamonSettings->mqtt_server, jsonDoc[F("mqtt_server")], sizeof(heishamonSettings->mqtt_server));
-          if ( jsonDoc[F("mqtt_port")] ) strlcpy(heishamonSettings->mqtt_port, jsonDoc[F("mqtt_port")], sizeof(heishamonSettings->mqtt_port));
-          if ( jsonDoc[F("mqtt_username")] ) strlcpy(heishamonSettings->mqtt_username, jsonDoc[F("mqtt_username")], sizeof(heishamonSettings->mqtt_username));
-          if ( jsonDoc[F("mqtt_password")] ) strlcpy(heishamonSettings->mqtt_password, jsonDoc[F("mqtt_password")], sizeof(heishamonSettings->mqtt_password));
-          if ( jsonDoc[F("ntp_servers")] ) strlcpy(heishamonSettings->ntp_servers, jsonDoc[F("ntp_servers")], sizeof(heishamonSettings->ntp_servers));
-          if ( jsonDoc[F("timezone")]) heishamonSettings->timezone = jsonDoc[F("timezone")];
-#ifdef TLS_SUPPORT
-          heishamonSettings->mqtt_tls_enabled = ( jsonDoc[F("mqtt_tls_enabled")] == "enabled" ) ? true : false; 
-#endif
-          heishamonSettings->force_rules = ( jsonDoc[F("force_rules")] == "enabled" ) ? true : false;
-          heishamonSettings->use_1wire = ( jsonDoc[F("use_1wire")] == "enabled" ) ? true : false;
-          heishamonSettings->use_s0 = ( jsonDoc[F("use_s0")] == "enabled" ) ? true : false;
-          heishamonSettings->hotspot = ( jsonDoc[F("hotspot")] == "disabled" ) ? false : true; //default to true if not found in settings
-          heishamonSettings->listenonly = ( jsonDoc[F("listenonly")] == "enabled" ) ? true : false;
-          heishamonSettings->logMqtt = ( jsonDoc[F("logMqtt")] == "enabled" ) ? true : false;
-          heishamonSettings->logHexdump = ( jsonDoc[F("logHexdump")] == "enabled" ) ? true : false;
-          heishamonSettings->logSerial1 = ( jsonDoc[F("logSerial1")] == "enabled" ) ? true : false;
-          heishamonSettings->optionalPCB = ( jsonDoc[F("optionalPCB")] == "enabled" ) ? true : false;
-          heishamonSettings->opentherm = ( jsonDoc[F("opentherm")] == "enabled" ) ? true : false;
-#ifdef ESP32          
-          heishamonSettings->proxy = ( jsonDoc[F("proxy")] == "enabled" ) ? true : false;
-#endif          
-          if ( jsonDoc[F("waitTime")]) heishamonSettings->waitTime = jsonDoc[F("waitTime")];
-          if (heishamonSettings->waitTime < 5) heishamonSettings->waitTime = 5;
-          if ( jsonDoc[F("waitDallasTime")]) heishamonSettings->waitDallasTime = jsonDoc[F("waitDallasTime")];
-          if (heishamonSettings->waitDallasTime < 5) heishamonSettings->waitDallasTime = 5;
-          if ( jsonDoc[F("dallasResolution")]) heishamonSettings->dallasResolution = jsonDoc[F("dallasResolution")];
-          if ((heishamonSettings->dallasResolution < 9) || (heishamonSettings->dallasResolution > 12) ) heishamonSettings->dallasResolution = 12;
-          if ( jsonDoc[F("updateAllTime")]) heishamonSettings->updateAllTime = jsonDoc[F("updateAllTime")];
-          if (heishamonSettings->updateAllTime < heishamonSettings->waitTime) heishamonSettings->updateAllTime = heishamonSettings->waitTime;
-          if ( jsonDoc[F("updataAllDallasTime")]) heishamonSettings->updataAllDallasTime = jsonDoc[F("updataAllDallasTime")];
-          if (heishamonSettings->updataAllDallasTime < heishamonSettings->waitDallasTime) heishamonSettings->updataAllDallasTime = heishamonSettings->waitDallasTime;
-          //if (jsonDoc[F("s0_1_gpio")]) heishamonSettings->s0Settings[0].gpiopin = jsonDoc[F("s0_1_gpio")];
-          if (jsonDoc[F("s0_1_ppkwh")]) heishamonSettings->s0Settings[0].ppkwh = jsonDoc[F("s0_1_ppkwh")];
-          if (jsonDoc[F("s0_1_interval")]) heishamonSettings->s0Settings[0].lowerPowerInterval = jsonDoc[F("s0_1_interval")];
-          if (jsonDoc[F("s0_1_minpulsewidth")]) heishamonSettings->s0Settings[0].minimalPulseWidth = jsonDoc[F("s0_1_minpulsewidth")];
-          if (jsonDoc[F("s0_1_maxpulsewidth")]) heishamonSettings->s0Settings[0].maximalPulseWidth = jsonDoc[F("s0_1_maxpulsewidth")];
-          //if (jsonDoc[F("s0_2_gpio")]) heishamonSettings->s0Settings[1].gpiopin = jsonDoc[F("s0_2_gpio")];
-          if (jsonDoc[F("s0_2_ppkwh")]) heishamonSettings->s0Settings[1].ppkwh = jsonDoc[F("s0_2_ppkwh")];
-          if (jsonDoc[F("s0_2_interval")] ) heishamonSettings->s0Settings[1].lowerPowerInterval = jsonDoc[F("s0_2_interval")];
-          if (jsonDoc[F("s0_2_minpulsewidth")]) heishamonSettings->s0Settings[1].minimalPulseWidth = jsonDoc[F("s0_2_minpulsewidth")];
-          if (jsonDoc[F("s0_2_maxpulsewidth")]) heishamonSettings->s0Settings[1].maximalPulseWidth = jsonDoc[F("s0_2_maxpulsewidth")];
-          ntpReload(heishamonSettings);
-        } else {
-          log_message(_F("Failed to load json config, forcing config reset."));
-          WiFi.persistent(true);
-          WiFi.disconnect();
-          WiFi.persistent(false);
-        }
-        configFile.close();
+    unsigned long start = micros();
+    if (settingsLoad(heishamonSettings)) {
+      char log_msg[64];
+      sprintf_P(log_msg, PSTR("loaded settings in %lu us"), micros() - start);
+      log_message(log_msg);
+    } else if (LittleFS.exists(SETTINGS_JSON_FILE)) {
+      log_message(_F("reading json config file"));
+      File configFile = LittleFS.open(SETTINGS_JSON_FILE, "r");
+      JsonDocument jsonDoc;
+      DeserializationError error = deserializeJson(jsonDoc, configFile);
+      configFile.close();
+      if (!error) {
+        log_message(_F("parsed json, converting it to the settings file"));
+        settingsFromJson(jsonDoc, heishamonSettings);
+        settingsValidate(heishamonSettings);
+        settingsSave(heishamonSettings);
+      } else {
+        log_message(_F("Failed to load json config, forcing config reset."));
+        WiFi.persistent(true);
+        WiFi.disconnect();
+        WiFi.persistent(false);
       }
-    }
-    else {
-      log_message(_F("No config.json exists! Forcing a config reset."));
+    } else {
+      log_message(_F("No config file exists! Forcing a config reset."));
       WiFi.persistent(true);
       WiFi.disconnect();
       WiFi.persistent(false);
     }
+    settingsValidate(heishamonSettings);
+    ntpReload(heishamonSettings);
   } else {
     log_message(_F("failed to mount FS"));
   }
-  //end read
-
 }
 
 void setupWifi(settingsStruct *heishamonSettings) {
@@ -387,104 +338,12 @@ int handleReboot(struct webserver_t *client) {
   return 0;
 }
 
-void settingsToJson(JsonDocument &jsonDoc, settingsStruct *heishamonSettings) {
-  //set jsonDoc with current settings
-  jsonDoc[F("wifi_hostname")] = heishamonSettings->wifi_hostname;
-  jsonDoc[F("wifi_password")] = heishamonSettings->wifi_password;
-  jsonDoc[F("wifi_ssid")] = heishamonSettings->wifi_ssid;
-  jsonDoc[F("ota_password")] = heishamonSettings->ota_password;
-  jsonDoc[F("mqtt_topic_base")] = heishamonSettings->mqtt_topic_base;
-  jsonDoc[F("mqtt_server")] = heishamonSettings->mqtt_server;
-  jsonDoc[F("mqtt_port")] = heishamonSettings->mqtt_port;
-  jsonDoc[F("mqtt_username")] = heishamonSettings->mqtt_username;
-  jsonDoc[F("mqtt_password")] = heishamonSettings->mqtt_password;
-  jsonDoc[F("ntp_servers")] = heishamonSettings->ntp_servers;
-  jsonDoc[F("timezone")] = heishamonSettings->timezone;
-#ifdef TLS_SUPPORT
-  if (heishamonSettings->mqtt_tls_enabled) {
-    jsonDoc[F("mqtt_tls_enabled")] = "enabled";
-  } else {
-    jsonDoc[F("mqtt_tls_enabled")] = "disabled";
-  }
-#endif
-  if (heishamonSettings->use_1wire) {
-    jsonDoc[F("use_1wire")] = "enabled";
-  } else {
-    jsonDoc[F("use_1wire")] = "disabled";
-  }
-  if (heishamonSettings->use_s0) {
-    jsonDoc[F("use_s0")] = "enabled";
-  } else {
-    jsonDoc[F("use_s0")] = "disabled";
-  }
-  if (heishamonSettings->hotspot) {
-    jsonDoc[F("hotspot")] = "enabled";
-  } else {
-    jsonDoc[F("hotspot")] = "disabled";
-  }
-  if (heishamonSettings->listenonly) {
-    jsonDoc[F("listenonly")] = "enabled";
-  } else {
-    jsonDoc[F("listenonly")] = "disabled";
-  }  if (heishamonSettings->force_rules) {
-    jsonDoc[F("force_rules")] = "enabled";
-  } else {
-    jsonDoc[F("force_rules")] = "disabled";
-  }
-  if (heishamonSettings->logMqtt) {
-    jsonDoc[F("logMqtt")] = "enabled";
-  } else {
-    jsonDoc[F("logMqtt")] = "disabled";
-  }
-  if (heishamonSettings->logHexdump) {
-    jsonDoc[F("logHexdump")] = "enabled";
-  } else {
-    jsonDoc[F("logHexdump")] = "disabled";
-  }
-  if (heishamonSettings->logSerial1) {
-    jsonDoc[F("logSerial1")] = "enabled";
-  } else {
-    jsonDoc[F("logSerial1")] = "disabled";
-  }
-  if (heishamonSettings->optionalPCB) {
-    jsonDoc[F("optionalPCB")] = "enabled";
-  } else {
-    jsonDoc[F("optionalPCB")] = "disabled";
-  }
-  if (heishamonSettings->opentherm) {
-    jsonDoc[F("opentherm")] = "enabled";
-  } else {
-    jsonDoc[F("opentherm")] = "disabled";
-  }
-#ifdef ESP32  
-  if (heishamonSettings->proxy) {
-    jsonDoc[F("proxy")] = "enabled";
-  } else {
-    jsonDoc[F("proxy")] = "disabled";
-  }
-#endif 
-  jsonDoc[F("waitTime")] = heishamonSettings->waitTime;
-  jsonDoc[F("waitDallasTime")] = heishamonSettings->waitDallasTime;
-  jsonDoc[F("dallasResolution")] = heishamonSettings->dallasResolution;
-  jsonDoc[F("updateAllTime")] = heishamonSettings->updateAllTime;
-  jsonDoc[F("updataAllDallasTime")] = heishamonSettings->updataAllDallasTime;
-  jsonDoc[F("s0_1_ppkwh")] = heishamonSettings->s0Settings[0].ppkwh;
-  jsonDoc[F("s0_1_interval")] = heishamonSettings->s0Settings[0].lowerPowerInterval;
-  jsonDoc[F("s0_1_minpulsewidth")] = heishamonSettings->s0Settings[0].minimalPulseWidth;
-  jsonDoc[F("s0_1_maxpulsewidth")] = heishamonSettings->s0Settings[0].maximalPulseWidth;
-  jsonDoc[F("s0_2_ppkwh")] = heishamonSettings->s0Settings[1].ppkwh;
-  jsonDoc[F("s0_2_interval")] = heishamonSettings->s0Settings[1].lowerPowerInterval;
-  jsonDoc[F("s0_2_minpulsewidth")] = heishamonSettings->s0Settings[1].minimalPulseWidth;
-  jsonDoc[F("s0_2_maxpulsewidth")] = heishamonSettings->s0Settings[1].maximalPulseWidth;  
-}
-
+// The file is read back right after, so it is written now, but only if changed
 void saveJsonToFile(JsonDocument &jsonDoc, const char* filename) {
-  if (LittleFS.begin()) {
-    File configFile = LittleFS.open(filename, "w");
-    if (configFile) {
-      serializeJson(jsonDoc, configFile);
-      configFile.close();
-    }
+  String json;
+  serializeJson(jsonDoc, json);
+  if (persistWrite(filename, json.c_str(), json.length(), 0)) {
+    persistFlush(filename);
   }
 }
 
@@ -572,222 +431,77 @@ static bool processCAtmp_to_CAPEM(String &outMsg) {
 }
 #endif
 
-bool passwordWasChanged(const char *returned) {
-    for (size_t i = 0; i < strlen(returned); i++) {
-        if (returned[i] != '*') return true;
-    }
-    return false;
-}
-
 int saveSettings(struct webserver_t *client, settingsStruct *heishamonSettings) {
-  const char *wifi_ssid = NULL;
-  const char *wifi_password = NULL;
-  const char *mqtt_password = NULL;
-  const char *new_ota_password = NULL;
-  const char *current_ota_password = NULL;
-
+  struct websettings_t *form = (struct websettings_t *)client->userdata;
   bool reconnectWiFi = false;
   bool wrongPassword = false;
-  JsonDocument jsonDoc;
-
-  settingsToJson(jsonDoc, heishamonSettings); //stores current settings in a json document
-
-  jsonDoc[F("force_rules")] = String("disabled");
-  jsonDoc[F("hotspot")] = String("disabled");
-  jsonDoc[F("listenonly")] = String("disabled");
-  jsonDoc[F("logMqtt")] = String("disabled");
-  jsonDoc[F("logHexdump")] = String("disabled");
-  jsonDoc[F("logSerial1")] = String("disabled");
-  jsonDoc[F("optionalPCB")] = String("disabled");
-  jsonDoc[F("opentherm")] = String("disabled");
-
-#ifdef ESP32  
-  jsonDoc[F("proxy")] = String("disabled");
-#endif  
-#ifdef TLS_SUPPORT
-  jsonDoc[F("mqtt_tls_enabled")] = String("disabled");
-#endif
 
-  jsonDoc[F("use_1wire")] = String("disabled");
-  jsonDoc[F("use_s0")] = String("disabled");
-
-  struct websettings_t *tmp = (struct websettings_t *)client->userdata;
-  while (tmp) {
-    if (strcmp(tmp->name.c_str(), "wifi_hostname") == 0) {
-      jsonDoc[F("wifi_hostname")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "mqtt_topic_base") == 0) {
-      jsonDoc[F("mqtt_topic_base")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "mqtt_server") == 0) {
-      jsonDoc[F("mqtt_server")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "mqtt_port") == 0) {
-      jsonDoc[F("mqtt_port")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "mqtt_username") == 0) {
-      jsonDoc[F("mqtt_username")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "mqtt_password") == 0) {
-      mqtt_password = tmp->value.c_str();
-    } else if (strcmp(tmp->name.c_str(), "use_1wire") == 0) {
-      jsonDoc[F("use_1wire")] = tmp->value;
-#ifdef TLS_SUPPORT
-    } else if (strcmp(tmp->name.c_str(), "mqtt_tls_enabled") == 0) {
-    jsonDoc[F("mqtt_tls_enabled")] = tmp->value;
-#endif
-    } else if (strcmp(tmp->name.c_str(), "use_s0") == 0) {
-      jsonDoc[F("use_s0")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "hotspot") == 0) {
-      jsonDoc[F("hotspot")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "listenonly") == 0) {
-      jsonDoc[F("listenonly")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "force_rules") == 0) {
-      jsonDoc[F("force_rules")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "logMqtt") == 0) {
-      jsonDoc[F("logMqtt")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "logHexdump") == 0) {
-      jsonDoc[F("logHexdump")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "logSerial1") == 0) {
-      jsonDoc[F("logSerial1")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "optionalPCB") == 0) {
-      jsonDoc[F("optionalPCB")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "opentherm") == 0) {
-      jsonDoc[F("opentherm")] = tmp->value;
-#ifdef ESP32      
-    } else if (strcmp(tmp->name.c_str(), "proxy") == 0) {
-      jsonDoc[F("proxy")] = tmp->value;
-#endif      
-    } else if (strcmp(tmp->name.c_str(), "ntp_servers") == 0) {
-      jsonDoc[F("ntp_servers")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "timezone") == 0) {
-      jsonDoc[F("timezone")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "waitTime") == 0) {
-      jsonDoc[F("waitTime")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "waitDallasTime") == 0) {
-      jsonDoc[F("waitDallasTime")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "updateAllTime") == 0) {
-      jsonDoc[F("updateAllTime")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "dallasResolution") == 0) {
-      jsonDoc[F("dallasResolution")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "updataAllDallasTime") == 0) {
-      jsonDoc[F("updataAllDallasTime")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "wifi_ssid") == 0) {
-      wifi_ssid = tmp->value.c_str();
-    } else if (strcmp(tmp->name.c_str(), "wifi_password") == 0) {
-      wifi_password = tmp->value.c_str();
-    } else if (strcmp(tmp->name.c_str(), "new_ota_password") == 0) {
-      new_ota_password = tmp->value.c_str();
-    } else if (strcmp(tmp->name.c_str(), "current_ota_password") == 0) {
-      current_ota_password = tmp->value.c_str();
-    } else if (strcmp(tmp->name.c_str(), "s0_1_ppkwh") == 0) {
-      jsonDoc[F("s0_1_ppkwh")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "s0_1_interval") == 0) {
-      jsonDoc[F("s0_1_interval")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "s0_1_minpulsewidth") == 0) {
-      jsonDoc[F("s0_1_minpulsewidth")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "s0_1_maxpulsewidth") == 0) {
-      jsonDoc[F("s0_1_maxpulsewidth")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "s0_2_ppkwh") == 0) {
-      jsonDoc[F("s0_2_ppkwh")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "s0_2_ppkwh") == 0) {
-      jsonDoc[F("s0_2_ppkwh")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "s0_2_interval") == 0) {
-      jsonDoc[F("s0_2_interval")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "s0_2_minpulsewidth") == 0) {
-      jsonDoc[F("s0_2_minpulsewidth")] = tmp->value;
-    } else if (strcmp(tmp->name.c_str(), "s0_2_maxpulsewidth") == 0) {
-      jsonDoc[F("s0_2_maxpulsewidth")] = tmp->value;
+  client->userdata = NULL;
+  if (form != NULL) {
+    settingsKeepUnchanged(&form->settings, heishamonSettings);
+    if (strlen(form->new_ota_password) > 0 && strlen(form->current_ota_password) > 0) {
+      if (strcmp(heishamonSettings->ota_password, form->current_ota_password) == 0) {
+        strlcpy(form->settings.ota_password, form->new_ota_password, sizeof(form->settings.ota_password));
+      } else {
+        wrongPassword = true;
+      }
     }
-    tmp = tmp->next;
-  }
-
-  if (new_ota_password != NULL && strlen(new_ota_password) > 0 && current_ota_password != NULL && strlen(current_ota_password) > 0) {
-    if (strcmp(heishamonSettings->ota_password, current_ota_password) == 0) {
-      jsonDoc[F("ota_password")] = new_ota_password;
-    } else {
-      wrongPassword = true;
+    if ((strcmp(form->settings.wifi_ssid, heishamonSettings->wifi_ssid) != 0) || (strcmp(form->settings.wifi_password, heishamonSettings->wifi_password) != 0)) {
+      reconnectWiFi = true;
     }
-  }
-
-  if (wifi_ssid != NULL && strlen(wifi_ssid) > 0) {
-    if (strcmp(jsonDoc[F("wifi_ssid")], wifi_ssid) != 0) reconnectWiFi = true;
-    jsonDoc[F("wifi_ssid")] = wifi_ssid; 
-  }
 
-  if (wifi_password != NULL && passwordWasChanged(wifi_password)) {
-    reconnectWiFi = true;
-    jsonDoc[F("wifi_password")] = wifi_password;
-  }
-
-  if (mqtt_password != NULL && passwordWasChanged(mqtt_password) ) {
-    jsonDoc[F("mqtt_password")] = mqtt_password;
-  }
-
-  saveJsonToFile(jsonDoc, "/config.json"); //save to config file
-  loadSettings(heishamonSettings); //load config file to current settings
-
-  while (client->userdata) {
-    tmp = (struct websettings_t *)client->userdata;
-    client->userdata = ((struct websettings_t *)(client->userdata))->next;
-    delete tmp;
+    *heishamonSettings = form->settings;
+    delete form;
+    settingsValidate(heishamonSettings);
+    settingsSave(heishamonSettings);
+    ntpReload(heishamonSettings);
   }
 
   if (wrongPassword) {
-    client->route = 111;
+    client->route = ROUTE_SAVESETTINGS_WRONGPASSWORD;
     return 0;
   }
 
   if (reconnectWiFi) {
-    client->route = 112;
+    client->route = ROUTE_SAVESETTINGS_RECONNECTWIFI;
     return 0;
   }
 
-  client->route = 113;
+  client->route = ROUTE_SAVESETTINGS_DONE;
   return 0;
 }
 
-int cacheSettings(struct webserver_t *client, struct arguments_t * args) {
-  struct websettings_t *tmp = (struct websettings_t *)client->userdata;
-  while (tmp) {
-    /*
-        this part is useless as websettings is always NULL at start of a new POST
-        it will only interrate over already POSTed args which are pushed on the list below
-        we only need to find the tail of the list
-        /
-
-      if (strcmp(tmp->name.c_str(), (char *)args->name) == 0) {
-        char *cpy = (char *)malloc(args->len + 1);
-        memset(cpy, 0, args->len + 1);
-        memcpy(cpy, args->value, args->len);
-        tmp->value += cpy;
-        free(cpy);
-        break;
-      }
-    */
-    tmp = tmp->next;
-  }
-  if (tmp == NULL) {
-    websettings_t *node = new websettings_t;
-    if (node == NULL) {
-      Serial1.printf("Out of memory %s:#%d\n", __FUNCTION__, __LINE__);
-      ESP.restart();
-      exit(-1);
-    }
-    node->next = NULL;
-    node->name += (char *)args->name;
-    if (args->value != NULL) {
-      char *cpy = (char *)malloc(args->len + 1);
-      if (node == NULL) {
-        Serial1.printf("Out of memory %s:#%d\n", __FUNCTION__, __LINE__);
-        ESP.restart();
-        exit(-1);
-      }
-      memset(cpy, 0, args->len + 1);
-      strncpy(cpy, (char *)args->value, args->len);
-      node->value += cpy;
-      free(cpy);
+// The posted fields are applied to a copy of the settings as they arrive,
+// saveSettings takes the copy over once the whole form is read
+int cacheSettings(struct webserver_t *client, struct arguments_t * args, settingsStruct *heishamonSettings) {
+  struct websettings_t *form = (struct websettings_t *)client->userdata;
+  if (form == NULL) {
+    form = new websettings_t;
+    if (form == NULL) {
+      log_message(_F("Out of memory for the settings form"));
+      return -1;
     }
-
-    node->next = (struct websettings_t *)client->userdata;
-    client->userdata = node;
+    form->settings = *heishamonSettings;
+    settingsClearCheckboxes(&form->settings);
+    form->new_ota_password[0] = '\0';
+    form->current_ota_password[0] = '\0';
+    form->last[0] = '\0';
+    client->userdata = form;
   }
 
+  const char *name = (const char *)args->name;
+  const char *value = (args->value != NULL) ? (const char *)args->value : "";
+  size_t len = (args->value != NULL) ? args->len : 0;
+  bool append = (strcmp(form->last, name) == 0); //the next part of a long value
+  strlcpy(form->last, name, sizeof(form->last));
+
+  if (strcmp_P(name, PSTR("new_ota_password")) == 0) {
+    strlcpy(form->new_ota_password, value, min(len + 1, sizeof(form->new_ota_password)));
+  } else if (strcmp_P(name, PSTR("current_ota_password")) == 0) {
+    strlcpy(form->current_ota_password, value, min(len + 1, sizeof(form->current_ota_password)));
+  } else {
+    settingsSet(&form->settings, name, value, len, append);
+  }
   return 0;
 }
 
@@ -936,7 +650,7 @@ int handleWifiScan(struct webserver_t *client) {
 #endif
   if (client->content == 0) {
     webserver_send(client, 200, (char *)"application/json", 0);
-    if (LittleFS.begin()) {
+    if (persistMount()) {
       File scanfile = LittleFS.open("/wifiscan.json", "r");
       if (scanfile) {
         size_t size = scanfile.size();
@@ -1229,7 +943,7 @@ int showRules(struct webserver_t *client) {
     webserver_send_content_P(client, webCSS, strlen_P(webCSS));
     webserver_send_content_P(client, webBodyStart, strlen_P(webBodyStart));
     webserver_send_content_P(client, showRulesPage1, strlen_P(showRulesPage1));
-    if (LittleFS.begin()) {
+    if (persistMount()) {
       client->userdata = new fs::File(LittleFS.open("/rules.txt", "r"));
     }
   } else if (client->userdata != NULL) {
@@ -1420,3 +1134,49 @@ int showFirmwareFail(struct webserver_t *client) {
   }
   return 0;
 }
+
+const void *findWebAsset(const char *path) {
+  for (uint8_t i = 0; i < NUMBER_OF_WEBASSETS; i++) {
+    webAssetStruct tmp;
+    memcpy_P(&tmp, &webAssets[i], sizeof(tmp));
+    if (strcmp(path, tmp.path) == 0) {
+      return &webAssets[i];
+    }
+  }
+  return NULL;
+}
+
+// true if the browser sent an If-None-Match header matching the ETag of this asset
+bool webAssetNotModified(const void *asset, struct arguments_t *args) {
+  if ((asset == NULL) || (args->value == NULL) || (stricmp((char *)args->name, "If-None-Match") != 0)) {
+    return false;
+  }
+  webAssetStruct tmp;
+  memcpy_P(&tmp, asset, sizeof(tmp));
+  return strnstr(args->value, tmp.etag, args->len) != NULL;
+}
+
+int webAssetHeaders(struct webserver_t *client, struct header_t *header) {
+  webAssetStruct tmp;
+  memcpy_P(&tmp, client->userdata, sizeof(tmp));
+  if (client->route == ROUTE_WEBASSET) {
+    header->ptr += sprintf_P((char *)header->buffer, PSTR("Content-Encoding: gzip\r\nCache-Control: public, max-age=31536000, immutable\r\nETag: \"%s\"\r\n"), tmp.etag);
+  } else {
+    header->ptr += sprintf_P((char *)header->buffer, PSTR("Cache-Control: public, max-age=31536000, immutable\r\nETag: \"%s\"\r\n"), tmp.etag);
+  }
+  return 0;
+}
+
+int handleWebAsset(struct webserver_t *client) {
+  if (client->content == 0) {
+    webAssetStruct tmp;
+    memcpy_P(&tmp, client->userdata, sizeof(tmp));
+    if (client->route == ROUTE_WEBASSET) {
+      webserver_send(client, 200, tmp.mimetype, tmp.len);
+      webserver_send_content_P(client, (PGM_P)tmp.data, tmp.len);
+    } else {
+      webserver_send(client, 304, tmp.mimetype, 0);
+    }
+  }
+  return 0;
+}
@@ -13,6 +13,7 @@
 #include <ArduinoJson.h>
 #include <LittleFS.h>
 #include "src/common/webserver.h"
+#include "webroutes.h"
 #include "dallas.h"
 #include "s0.h"
 #include "HeishaOT.h"
@@ -31,7 +32,9 @@ void log_message(char* string);
 static IPAddress apIP(192, 168, 4, 1);
 
 struct settingsStruct {
-  uint16_t waitTime = 5; // how often data is read from heatpump
+  uint16_t waitTime = 5; // how often data is read from heatpump while it is running
+  uint16_t waitTimeIdle = 15; // how often data is read from heatpump while it is idle
+  uint16_t waitTimeExtra = 0; // how often the extra data block is read, 0 follows the data reads
   uint16_t waitDallasTime = 5; // how often temps are read from 1wire
   uint16_t dallasResolution = 12; // dallas temp resolution (9 to 12)
   uint16_t updateAllTime = 300; // how often all data is resend to mqtt
@@ -63,9 +66,13 @@ struct settingsStruct {
   bool use_s0 = false; //s0 enabled?
   bool logMqtt = false; //log to mqtt from start
   bool logHexdump = false; //log hexdump from start
+  bool recordFrames = false; //record the raw heatpump frames to flash
+  char historyTopics[64] = "TOP5,TOP6,TOP8"; //topics kept in the on-device history
+  bool historyFlush = false; //keep the 15 minute history over a reboot
   bool logSerial1 = true; //log to serial1 (gpio2) from start
   bool opentherm = false; //opentherm enable flag
   bool hotspot = true; //enable wifi hotspot when wifi is not connected
+  bool fastBoot = false; //poll the heatpump before the network is up, 1wire scan, rules and ntp wait for the first read
 #ifdef ESP32
   bool proxy = true; //cztaw proxy port enable flag
 #endif
@@ -73,10 +80,12 @@ struct settingsStruct {
   gpioSettingsStruct gpioSettings;
 };
 
+// A posted settings form, applied to a copy of the settings
 struct websettings_t {
-  String name;
-  String value;
-  struct websettings_t *next;
+  settingsStruct settings;
+  char new_ota_password[40];
+  char current_ota_password[40];
+  char last[32]; // name of the previous field, long values arrive in parts
 };
 
 void setupConditionals();
@@ -95,7 +104,6 @@ int handleJsonOutput(struct webserver_t *client, char* actData, char* actDataExt
 int handleFactoryReset(struct webserver_t *client);
 int handleReboot(struct webserver_t *client);
 int handleDebug(struct webserver_t *client, char *hex, byte hex_len);
-void settingsToJson(JsonDocument  &jsonDoc, settingsStruct *heishamonSettings);
 void saveJsonToFile(JsonDocument  &jsonDoc, const char *filename);
 void loadSettings(settingsStruct *heishamonSettings);
 int getSettings(struct webserver_t *client, settingsStruct *heishamonSettings);
@@ -105,12 +113,16 @@ int handleSettings(struct webserver_t *client);
 int saveSettings(struct webserver_t *client, settingsStruct *heishamonSettings);
 int settingsReconnectWifi(struct webserver_t *client, settingsStruct *heishamonSettings);
 int settingsNewPassword(struct webserver_t *client, settingsStruct *heishamonSettings);
-int cacheSettings(struct webserver_t *client, struct arguments_t * args);
+int cacheSettings(struct webserver_t *client, struct arguments_t * args, settingsStruct *heishamonSettings);
 int handleWifiScan(struct webserver_t *client);
 int showRules(struct webserver_t *client);
 int showFirmware(struct webserver_t *client);
 int showFirmwareSuccess(struct webserver_t *client);
 int showFirmwareFail(struct webserver_t *client);
+const void *findWebAsset(const char *path);
+bool webAssetNotModified(const void *asset, struct arguments_t *args);
+int webAssetHeaders(struct webserver_t *client, struct header_t *header);
+int handleWebAsset(struct webserver_t *client);
 #ifdef TLS_SUPPORT 
 int handleCACert(struct webserver_t *client);
 int showCACert(struct webserver_t *client);
@@ -0,0 +1,52 @@
+#include "webroutes.h"
+
+void buildWebRouteIndex(const webRouteStruct *routes, uint8_t count, webRouteIndexStruct *index) {
+  index->count = count;
+  index->prefix = WEBROUTE_NONE;
+  memset(index->bucket, WEBROUTE_NONE, sizeof(index->bucket));
+  memset(index->next, WEBROUTE_NONE, sizeof(index->next));
+
+  // backwards, so every chain keeps the order of the table
+  for (int16_t i = count - 1; i >= 0; i--) {
+    if (pgm_read_byte(&routes[i].methods) == WEBROUTE_INTERNAL) {
+      continue;
+    }
+    if (pgm_read_byte(&routes[i].flags) & WEBROUTE_PREFIX) {
+      index->next[i] = index->prefix;
+      index->prefix = i;
+    } else {
+      uint8_t b = pgm_read_dword(&routes[i].hash) & (WEBROUTE_BUCKETS - 1);
+      index->next[i] = index->bucket[b];
+      index->bucket[b] = i;
+    }
+  }
+}
+
+// Match the request uri against the routes in its hash bucket, prefix routes
+// are a fallback when no exact path matches.
+uint8_t findWebRoute(const webRouteStruct *routes, const webRouteIndexStruct *index, uint8_t method, const char *uri) {
+  uint32_t hash = webRouteHash(uri);
+  uint8_t mask = (method == 1) ? WEBROUTE_POST : WEBROUTE_GET;
+
+  for (uint8_t i = index->bucket[hash & (WEBROUTE_BUCKETS - 1)]; i != WEBROUTE_NONE; i = index->next[i]) {
+    if ((pgm_read_byte(&routes[i].methods) & mask) && (pgm_read_dword(&routes[i].hash) == hash) && (strcmp_P(uri, routes[i].path) == 0)) {
+      return i;
+    }
+  }
+  for (uint8_t i = index->prefix; i != WEBROUTE_NONE; i = index->next[i]) {
+    if ((pgm_read_byte(&routes[i].methods) & mask) && (strncmp_P(uri, routes[i].path, strlen_P(routes[i].path)) == 0)) {
+      return i;
+    }
+  }
+  return WEBROUTE_NONE;
+}
+
+// Only needed when a handler moved the client to another route.
+uint8_t findWebRouteById(const webRouteStruct *routes, uint8_t count, uint8_t route) {
+  for (uint8_t i = 0; i < count; i++) {
+    if (pgm_read_byte(&routes[i].route) == route) {
+      return i;
+    }
+  }
+  return WEBROUTE_NONE;
+}
@@ -0,0 +1,101 @@
+#ifndef _WEBROUTES_H_
+#define _WEBROUTES_H_
+
+#include <Arduino.h>
+#include "src/common/webserver.h"
+
+// Route ids stored in webserver_t.route. A handler can move a client to another
+// route while the request is running (e.g. after saving the settings).
+enum webRouteId {
+  ROUTE_NOTFOUND = 0,
+  ROUTE_ROOT = 1,
+  ROUTE_TOGGLELOG = 2,
+  ROUTE_TOGGLEHEXDUMP = 3,
+  ROUTE_JSON = 20,
+  ROUTE_REBOOT = 30,
+  ROUTE_DEBUG = 40,
+  ROUTE_WIFISCAN = 50,
+  ROUTE_DALLASALIAS = 60,
+  ROUTE_CAPTIVEPORTAL = 80,
+  ROUTE_CAPTIVEPORTAL_APPLE = 81,
+  ROUTE_FACTORYRESET = 90,
+  ROUTE_COMMAND = 100,
+  ROUTE_SAVESETTINGS = 110,
+  ROUTE_SAVESETTINGS_WRONGPASSWORD = 111,
+  ROUTE_SAVESETTINGS_RECONNECTWIFI = 112,
+  ROUTE_SAVESETTINGS_DONE = 113,
+  ROUTE_SETTINGS = 120,
+  ROUTE_GETSETTINGS = 130,
+  ROUTE_FIRMWARE = 140,
+  ROUTE_FIRMWARE_UPLOAD = 150,
+  ROUTE_RULES = 160,
+  ROUTE_CACERT_UPLOAD = 165,
+  ROUTE_CACERT = 166,
+  ROUTE_SAVERULES = 170,
+  ROUTE_SCANDALLAS = 180,
+  ROUTE_REMOVEDALLAS = 190,
+  ROUTE_METRICS = 195,
+  ROUTE_RAWFRAMES = 196,
+  ROUTE_HISTORY = 197,
+  ROUTE_OPENTHERM_TRACE = 198,
+  ROUTE_WEBASSET = 200,
+  ROUTE_WEBASSET_NOTMODIFIED = 201,
+};
+
+// accepted request methods, a route without methods is only reachable by id
+#define WEBROUTE_GET      0x01
+#define WEBROUTE_POST     0x02
+#define WEBROUTE_ANY      (WEBROUTE_GET | WEBROUTE_POST)
+#define WEBROUTE_INTERNAL 0x00
+
+// route flags
+#define WEBROUTE_PREFIX   0x01 // path matches every uri starting with it
+#define WEBROUTE_CORS     0x02 // add Access-Control-Allow-Origin to the response header
+
+#define WEBROUTE_PATH_LEN 21
+
+// Called with the same steps as the webserver callback, starting with
+// WEBSERVER_CLIENT_REQUEST_URI once the route is matched.
+typedef int8_t (webRouteHandler_t)(struct webserver_t *client, void *dat);
+
+struct webRouteStruct {
+  uint32_t hash;
+  char path[WEBROUTE_PATH_LEN];
+  uint8_t methods;
+  uint8_t route;
+  uint8_t flags;
+  webRouteHandler_t *handler;
+};
+
+// FNV-1a, evaluated at compile time for the route table and at runtime for the request uri
+constexpr uint32_t webRouteHash(const char *str) {
+  uint32_t hash = 2166136261UL;
+  while (*str != 0) {
+    hash = (hash ^ (uint8_t)*str++) * 16777619UL;
+  }
+  return hash;
+}
+
+#define WEBROUTE(path, methods, route, flags, handler) \
+  { webRouteHash(path), path, methods, route, flags, handler }
+
+#define WEBROUTE_BUCKETS 16 // uri hash buckets, a power of two
+#define WEBROUTE_MAX 64 // routes in one table
+#define WEBROUTE_NONE 0xFF // no route in a bucket or chain
+
+// Built once from the route table so a request uri is only compared with the
+// routes in its hash bucket. Every route is in one chain of next[], the prefix
+// routes in their own chain.
+struct webRouteIndexStruct {
+  uint8_t count;
+  uint8_t prefix;
+  uint8_t bucket[WEBROUTE_BUCKETS];
+  uint8_t next[WEBROUTE_MAX];
+};
+
+void buildWebRouteIndex(const webRouteStruct *routes, uint8_t count, webRouteIndexStruct *index);
+// both return the position in the route table or WEBROUTE_NONE
+uint8_t findWebRoute(const webRouteStruct *routes, const webRouteIndexStruct *index, uint8_t method, const char *uri);
+uint8_t findWebRouteById(const webRouteStruct *routes, uint8_t count, uint8_t route);
+
+#endif
@@ -0,0 +1,3 @@
+function changewifissid(){
+  document.getElementById('wifi_ssid_id').value=document.getElementById('wifi_ssid_select').value;
+}
@@ -0,0 +1,69 @@
+// Refresh both console toggles from the live device state.
+// The device's runtime flags are the source of truth: they reset on reboot to
+// the "from start" settings and are flipped by /togglelog and /togglehexdump.
+// Reading /getsettings after every change keeps the switches in sync with the
+// device instead of with a (possibly stale) browser-side cache.
+function refreshConsoleToggles() {
+  return fetch('/getsettings')
+    .then(function(response) { return response.json(); })
+    .then(function(data) {
+      var mqttEnabled = (data.logMqtt === 'enabled' || data.logMqtt === 1);
+      var hexdumpEnabled = (data.logHexdump === 'enabled' || data.logHexdump === 1);
+      document.getElementById('mqttLogToggle').checked = mqttEnabled;
+      document.getElementById('hexdumpToggle').checked = hexdumpEnabled;
+    })
+    .catch(function(err) {
+      console.error('Failed to fetch settings:', err);
+    });
+}
+
+function initConsoleToggles() {
+  refreshConsoleToggles();
+}
+
+// Toggle MQTT log, then re-read the device state so the switch reflects the
+// actual resulting position (the endpoint flips the flag server-side).
+function toggleMqttLog() {
+  fetch('/togglelog')
+    .then(function() { refreshConsoleToggles(); })
+    .catch(function(err) {
+      console.error('Error toggling MQTT log:', err);
+      refreshConsoleToggles();
+    });
+}
+
+// Toggle Hexdump log, then re-read the device state (see toggleMqttLog).
+function toggleHexdump() {
+  fetch('/togglehexdump')
+    .then(function() { refreshConsoleToggles(); })
+    .catch(function(err) {
+      console.error('Error toggling hexdump:', err);
+      refreshConsoleToggles();
+    });
+}
+
+function downloadConsole() {
+  var text = document.getElementById('cli').value;
+  if (!text) return;
+  var blob = new Blob([text], { type: 'text/plain' });
+  var url = URL.createObjectURL(blob);
+  var a = document.createElement('a');
+  var now = new Date();
+  var ts = now.getFullYear()
+    + '-' + String(now.getMonth()+1).padStart(2,'0')
+    + '-' + String(now.getDate()).padStart(2,'0')
+    + '_' + String(now.getHours()).padStart(2,'0')
+    + String(now.getMinutes()).padStart(2,'0')
+    + String(now.getSeconds()).padStart(2,'0');
+  a.href = url;
+  a.download = 'heishamon-console-' + ts + '.txt';
+  a.click();
+  URL.revokeObjectURL(url);
+}
+
+// Initialize on page load
+document.addEventListener('DOMContentLoaded', function() {
+  if (document.getElementById('mqttLogToggle')) {
+    initConsoleToggles();
+  }
+});
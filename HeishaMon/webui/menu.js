@@ -0,0 +1,69 @@
+function toggleMenu(){
+  var m=document.getElementById('sideMenu');
+  var o=document.getElementById('menuOverlay');
+  m.classList.toggle('open');
+  o.classList.toggle('open');
+}
+function closeMenu(){
+  document.getElementById('sideMenu').classList.remove('open');
+  document.getElementById('menuOverlay').classList.remove('open');
+}
+
+function setCookie(name, value, days) {
+  var expires = "";
+  if (days) {
+    var date = new Date();
+    date.setTime(date.getTime() + (days * 24 * 60 * 60 * 1000));
+    expires = "; expires=" + date.toUTCString();
+  }
+  document.cookie = name + "=" + (value || "") + expires + "; path=/";
+}
+
+function getCookie(name) {
+  var nameEQ = name + "=";
+  var ca = document.cookie.split(';');
+  for(var i = 0; i < ca.length; i++) {
+    var c = ca[i];
+    while (c.charAt(0) == ' ') c = c.substring(1, c.length);
+    if (c.indexOf(nameEQ) == 0) return c.substring(nameEQ.length, c.length);
+  }
+  return null;
+}
+
+function toggleDarkMode() {
+  var toggle = document.getElementById('darkModeToggle');
+  var html = document.documentElement;
+  
+  if (toggle.checked) {
+    html.classList.add('dark-mode');
+    setCookie('darkMode', 'true', 365);
+  } else {
+    html.classList.remove('dark-mode');
+    setCookie('darkMode', 'false', 365);
+  }
+}
+
+function initDarkMode() {
+  var darkMode = getCookie('darkMode');
+  var toggle = document.getElementById('darkModeToggle');
+  var html = document.documentElement;
+  
+  // Remove the temporary loading class
+  html.classList.remove('dark-mode-loading');
+  
+  // Apply proper dark mode
+  if (darkMode === 'true') {
+    html.classList.add('dark-mode');
+    if (toggle) toggle.checked = true;
+  } else {
+    html.classList.remove('dark-mode');
+    if (toggle) toggle.checked = false;
+  }
+}
+
+// Initialize immediately when DOM is ready
+if (document.readyState === 'loading') {
+  document.addEventListener('DOMContentLoaded', initDarkMode);
+} else {
+  initDarkMode();
+}
@@ -0,0 +1,24 @@
+var refreshWifiScan=function(){
+  var sel=document.getElementById('wifi_ssid_select');
+  var req=new XMLHttpRequest();
+  req.onreadystatechange=function(){
+    if(req.readyState===4&&req.status===200){
+      var list=JSON.parse(req.responseText);
+      sel.innerHTML='';
+      var def=document.createElement('option');
+      def.value='';def.text='Select SSID';def.selected=true;def.hidden=true;
+      sel.appendChild(def);
+      list.forEach(function(item){
+        var opt=document.createElement('option');
+        opt.value=item.ssid;
+        opt.text=item.ssid+' ('+item.rssi+' dBm)';
+        sel.appendChild(opt);
+      });
+      sel.style.display='block';
+    }
+  };
+  req.open('GET','/wifiscan',true);
+  req.send();
+  setTimeout(refreshWifiScan,30000);
+};
+setTimeout(refreshWifiScan,500);
@@ -0,0 +1,135 @@
+var isEditing=false;
+document.body.onload=function(){
+  openTable('Heatpump');
+  document.getElementById('cli').value='';
+  startWebsockets();
+  monitorWebSocket();
+  refreshTable();
+};
+var dallasAliasEdit=function(){
+  isEditing=false;
+  var addr=this.getAttribute('data-address');
+  var alias=this.innerText.substring(0,30);
+  var xhr=new XMLHttpRequest();
+  xhr.open('GET','/dallasalias?'+addr+'='+alias,true);
+  xhr.send();
+};
+function rescanDallas(){
+  var xhr=new XMLHttpRequest();
+  xhr.open('GET','/scandallas',true);
+  xhr.onload=function(){refreshTable();};
+  xhr.send();
+}
+function removeDallas(addr){
+  if(!confirm('Remove sensor '+addr+'? This also clears its retained mqtt value.'))return;
+  var xhr=new XMLHttpRequest();
+  xhr.open('GET','/removedallas?'+addr+'=1',true);
+  xhr.onload=function(){refreshTable();};
+  xhr.send();
+}
+function renderDallasTable(d){
+  if(!(d&&d['1wire']&&Array.isArray(d['1wire'])))return;
+  var tb=document.getElementById('dallasvalues');tb.innerHTML='';
+  d['1wire'].forEach(function(item){
+    var row=document.createElement('tr');
+    var sID=item['Sensor'];
+    if(!item.Present)row.style.opacity='0.6';
+    ['Sensor','Temperature','Alias'].forEach(function(k){
+      var cell=document.createElement('td');
+      cell.id='SensorID-'+sID+'-'+k;
+      if(k==='Alias'){
+        var div=document.createElement('div');
+        div.textContent=item[k];
+        div.classList.add('alias-edit');
+        div.contentEditable='true';
+        div.setAttribute('data-address',item.Sensor);
+        div.addEventListener('focus',function(){isEditing=true;});
+        div.addEventListener('blur',dallasAliasEdit);
+        cell.appendChild(div);
+      } else {cell.textContent=item[k];}
+      row.appendChild(cell);
+    });
+    var statusCell=document.createElement('td');
+    statusCell.id='SensorID-'+sID+'-Status';
+    if(!item.Present){
+      statusCell.style.color='var(--danger,#f44336)';
+      statusCell.classList.add('offline-duration');
+      if(item.LastSeenSeconds>=0)statusCell.dataset.offlineSince=Date.now()-item.LastSeenSeconds*1000;
+    }
+    statusCell.textContent=formatOfflineDuration(item.Present,item.LastSeenSeconds);
+    row.appendChild(statusCell);
+    var actionCell=document.createElement('td');
+    var removeBtn=document.createElement('button');
+    removeBtn.textContent='Remove';
+    removeBtn.className='btn btn-ghost';
+    removeBtn.style.cssText='padding:2px 8px;font-size:11px;height:22px;';
+    removeBtn.onclick=function(){removeDallas(sID);};
+    actionCell.appendChild(removeBtn);
+    row.appendChild(actionCell);
+    tb.appendChild(row);
+  });
+}
+async function refreshDallasTable(){
+  try{
+    if(isEditing)return;
+    var res=await fetch('/json');
+    var d=await res.json();
+    renderDallasTable(d);
+  }catch(e){}
+}
+async function refreshTable(){
+  try{
+    if(isEditing)return;
+    var res=await fetch('/json');
+    var d=await res.json();
+    if(d&&d.heatpump&&Array.isArray(d.heatpump)){
+      var tb=document.getElementById('heishavalues');tb.innerHTML='';
+      d.heatpump.forEach(function(item){tb.appendChild(buildRow(item,'Topic'));});
+    }
+    if(d&&d['heatpump extra']&&Array.isArray(d['heatpump extra'])){
+      var tb=document.getElementById('heishavalues');
+      d['heatpump extra'].forEach(function(item){tb.appendChild(buildRow(item,'Topic'));});
+    }
+    if(d&&d['heatpump optional']&&Array.isArray(d['heatpump optional'])){
+      var tb=document.getElementById('heishavalues');
+      d['heatpump optional'].forEach(function(item){tb.appendChild(buildRow(item,'Topic'));});
+    }
+    renderDallasTable(d);
+    if(d&&d.s0&&Array.isArray(d.s0)){
+      var tb=document.getElementById('s0values');tb.innerHTML='';
+      d.s0.forEach(function(item){
+        var row=document.createElement('tr');
+        var port=item['S0 port'];
+        for(var k in item){if(Object.hasOwn(item,k)){
+          var cell=document.createElement('td');
+          cell.id='s0port-'+port+'-'+k;
+          cell.textContent=item[k];
+          row.appendChild(cell);
+        }}
+        tb.appendChild(row);
+      });
+    }
+    if(d&&d.opentherm&&typeof d.opentherm==='object'){
+      var tb=document.getElementById('openthermvalues');tb.innerHTML='';
+      for(var key in d.opentherm){if(Object.hasOwn(d.opentherm,key)){
+        var row=document.createElement('tr');
+        var nc=document.createElement('td');nc.id=key;nc.textContent=key;
+        var tc=document.createElement('td');tc.id=key+'-type';tc.textContent=d.opentherm[key].type;
+        var vc=document.createElement('td');vc.id=key+'-value';vc.textContent=d.opentherm[key].value;
+        row.appendChild(nc);row.appendChild(tc);row.appendChild(vc);
+        tb.appendChild(row);
+      }}
+    }
+  } catch(e){console.error(e);}
+}
+function buildRow(item,idKey){
+  var row=document.createElement('tr');
+  var topic=item[idKey];
+  for(var k in item){if(Object.hasOwn(item,k)){
+    var cell=document.createElement('td');
+    cell.id=topic+'-'+k;
+    cell.textContent=item[k];
+    row.appendChild(cell);
+  }}
+  return row;
+}
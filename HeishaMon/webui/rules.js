@@ -0,0 +1,422 @@
+const KEYWORDS = ['on','then','end','if','else','elseif','NULL'];
+const OPERATORS = ['&&','||','==','>=','<=','!=','>','<','+','-','*','/','%','^','='];
+const FUNCTIONS = ['coalesce','max','min','isset','round','floor','ceil','setTimer','print','concat','gpio'];
+
+function highlightRules() {
+  const editor = document.getElementById('rules');
+  const cursorPos = saveCursorPosition(editor);
+  
+  let text = editor.textContent;
+  let html = '';
+  let i = 0;
+  
+  while(i < text.length) {
+    let matched = false;
+    
+    // Comments
+    if(text.substr(i,2) === '//') {
+      let end = text.indexOf('\n', i);
+      if(end === -1) end = text.length;
+      html += '<span class="comment">' + escapeHtml(text.substring(i,end)) + '</span>';
+      i = end;
+      matched = true;
+    }
+    
+    // Strings
+    if(!matched && (text[i] === "'" || text[i] === '"')) {
+      const quote = text[i];
+      let end = i + 1;
+      while(end < text.length && text[end] !== quote) {
+        if(text[end] === '\\') end++;
+        end++;
+      }
+      if(end < text.length) end++;
+      html += '<span class="string">' + escapeHtml(text.substring(i,end)) + '</span>';
+      i = end;
+      matched = true;
+    }
+    
+    // Numbers
+    if(!matched && /\d/.test(text[i])) {
+      let end = i;
+      while(end < text.length && /[\d.]/.test(text[end])) end++;
+      html += '<span class="number">' + text.substring(i,end) + '</span>';
+      i = end;
+      matched = true;
+    }
+    
+    // Keywords
+    if(!matched && /[a-zA-Z]/.test(text[i])) {
+      for(let k of KEYWORDS) {
+        if(text.substr(i,k.length) === k && (i===0 || !/\w/.test(text[i-1])) && (i+k.length>=text.length || !/\w/.test(text[i+k.length]))) {
+          html += '<span class="keyword">' + k + '</span>';
+          i += k.length;
+          matched = true;
+          break;
+        }
+      }
+    }
+    
+    // Functions
+    if(!matched && /[a-zA-Z]/.test(text[i])) {
+      for(let f of FUNCTIONS) {
+        if(text.substr(i,f.length+1) === f+'(' && (i===0 || !/\w/.test(text[i-1]))) {
+          html += '<span class="function">' + f + '</span>(';
+          i += f.length + 1;
+          matched = true;
+          break;
+        }
+      }
+    }
+    
+    // Heatpump params (@)
+    if(!matched && text[i] === '@') {
+      let end = i + 1;
+      while(end < text.length && /\w/.test(text[end])) end++;
+      html += '<span class="at-param">' + text.substring(i,end) + '</span>';
+      i = end;
+      matched = true;
+    }
+    
+    // DateTime params (%)
+    if(!matched && text[i] === '%') {
+      let end = i + 1;
+      while(end < text.length && /\w/.test(text[end])) end++;
+      html += '<span class="percent-param">' + text.substring(i,end) + '</span>';
+      i = end;
+      matched = true;
+    }
+    
+    // Thermostat params (?)
+    if(!matched && text[i] === '?') {
+      let end = i + 1;
+      while(end < text.length && /\w/.test(text[end])) end++;
+      html += '<span class="question-param">' + text.substring(i,end) + '</span>';
+      i = end;
+      matched = true;
+    }
+    
+    // Dallas sensors
+    if(!matched && text.substr(i,8) === 'ds18b20#') {
+      let end = i + 8;
+      while(end < text.length && /[0-9A-Fa-f]/.test(text[end])) end++;
+      html += '<span class="ds18b20">' + text.substring(i,end) + '</span>';
+      i = end;
+      matched = true;
+    }
+    
+    // Variables (# and $)
+    if(!matched && (text[i] === '#' || text[i] === '$')) {
+      let end = i + 1;
+      while(end < text.length && /\w/.test(text[end])) end++;
+      html += '<span class="variable">' + text.substring(i,end) + '</span>';
+      i = end;
+      matched = true;
+    }
+    
+    // Operators (check longer ones first)
+    if(!matched) {
+      const sortedOps = OPERATORS.slice().sort((a,b) => b.length - a.length);
+      for(let o of sortedOps) {
+        if(text.substr(i,o.length) === o) {
+          html += '<span class="operator">' + escapeHtml(o) + '</span>';
+          i += o.length;
+          matched = true;
+          break;
+        }
+      }
+    }
+    
+    // Default character
+    if(!matched) {
+      html += escapeHtml(text[i]);
+      i++;
+    }
+  }
+  
+  editor.innerHTML = html;
+  restoreCursorPosition(editor, cursorPos);
+}
+
+function escapeHtml(text) {
+  return text.replace(/[&<>]/g, m => ({'&':'&amp;','<':'&lt;','>':'&gt;'}[m]));
+}
+
+function saveCursorPosition(el) {
+  const sel = window.getSelection();
+  if(sel.rangeCount === 0) return null;
+  const range = sel.getRangeAt(0);
+  const preCaretRange = range.cloneRange();
+  preCaretRange.selectNodeContents(el);
+  preCaretRange.setEnd(range.endContainer, range.endOffset);
+  return preCaretRange.toString().length;
+}
+
+function restoreCursorPosition(el, pos) {
+  if(pos === null) return;
+  const sel = window.getSelection();
+  let charCount = 0;
+  const nodeStack = [el];
+  let node, foundStart = false;
+  const range = document.createRange();
+  range.setStart(el, 0);
+  range.collapse(true);
+  
+  while(!foundStart && (node = nodeStack.pop())) {
+    if(node.nodeType === 3) {
+      const nextCharCount = charCount + node.length;
+      if(pos <= nextCharCount) {
+        range.setStart(node, pos - charCount);
+        foundStart = true;
+      }
+      charCount = nextCharCount;
+    } else {
+      let i = node.childNodes.length;
+      while(i--) {
+        nodeStack.push(node.childNodes[i]);
+      }
+    }
+  }
+  
+  sel.removeAllRanges();
+  sel.addRange(range);
+}
+
+function updateLineNumbers() {
+  const editor = document.getElementById('rules');
+  const lineNumbers = document.getElementById('line-numbers');
+  const lines = editor.textContent.split('\n');
+  const lineCount = lines.length;
+  
+  let html = '';
+  for(let i = 1; i <= lineCount; i++) {
+    html += i + '\n';
+  }
+  
+  lineNumbers.textContent = html;
+}
+
+function validateRules() {
+  const editor = document.getElementById('rules');
+  const result = document.getElementById('validation-result');
+  const code = editor.textContent.trim();
+  
+  if(!code) {
+    result.innerHTML = '<div class="validation-feedback warning">Rules are empty.</div>';
+    return;
+  }
+  
+  const errors = [];
+  const warnings = [];
+  const blockStack = [];
+  
+  let cleanCode = code.replace(/\/\/.*$/gm, '');
+  cleanCode = cleanCode.replace(/'[^']*'/g, '""').replace(/"[^"]*"/g, '""');
+  
+  const lines = cleanCode.split('\n');
+  
+  for(let lineNum = 0; lineNum < lines.length; lineNum++) {
+    const line = lines[lineNum];
+    const trimmed = line.trim();
+    
+    if(!trimmed) continue;
+    
+    const statements = trimmed.split(/;|\bthen\b/).map(s => s.trim()).filter(s => s);
+    
+    for(let stmt of statements) {
+      if(/^on\s+/.test(stmt)) {
+        blockStack.push({type: 'on', line: lineNum + 1});
+      }
+      else if(/^if\s+/.test(stmt)) {
+        blockStack.push({type: 'if', line: lineNum + 1, hasElse: false});
+      }
+      else if(/^elseif\s+/.test(stmt)) {
+        if(blockStack.length === 0 || blockStack[blockStack.length-1].type !== 'if') {
+          errors.push('Line ' + (lineNum+1) + ': "elseif" without matching "if"');
+        } else if(blockStack[blockStack.length-1].hasElse) {
+          errors.push('Line ' + (lineNum+1) + ': "elseif" after "else"');
+        }
+      }
+      else if(/^else$/.test(stmt)) {
+        if(blockStack.length === 0 || blockStack[blockStack.length-1].type !== 'if') {
+          errors.push('Line ' + (lineNum+1) + ': "else" without matching "if"');
+        } else if(blockStack[blockStack.length-1].hasElse) {
+          errors.push('Line ' + (lineNum+1) + ': Multiple "else" for same "if"');
+        } else {
+          blockStack[blockStack.length-1].hasElse = true;
+        }
+      }
+      else if(/^end$/.test(stmt)) {
+        if(blockStack.length === 0) {
+          errors.push('Line ' + (lineNum+1) + ': "end" without matching block');
+        } else {
+          blockStack.pop();
+        }
+      }
+    }
+    
+    // Check for missing semicolons - CORRECTED VERSION
+    const origTrimmed = code.split('\n')[lineNum].trim();
+    if(origTrimmed && !origTrimmed.startsWith('//')) {
+      const needsSemicolon = !origTrimmed.endsWith(';') && 
+                             !origTrimmed.endsWith('then') && 
+                             !origTrimmed.endsWith('end') &&
+                             origTrimmed !== 'else' &&
+                             origTrimmed !== 'end' &&
+                             !/^(on|if|elseif)\s/.test(origTrimmed);
+      
+      if(needsSemicolon) {
+        warnings.push('Line ' + (lineNum+1) + ': Missing semicolon');
+      }
+    }
+  }
+  
+  if(blockStack.length > 0) {
+    const unclosed = blockStack.map(b => b.type + ' (line ' + b.line + ')');
+    errors.push('Unclosed block(s): ' + unclosed.join(', '));
+  }
+  
+  editor.classList.remove('rules-error', 'rules-valid');
+  
+  if(errors.length > 0) {
+    editor.classList.add('rules-error');
+    result.innerHTML = '<div class="validation-feedback error"><strong>Errors:</strong><br>' + errors.join('<br>') + '</div>';
+  } else if(warnings.length > 0) {
+    editor.classList.add('rules-valid');
+    result.innerHTML = '<div class="validation-feedback warning"><strong>Warnings:</strong><br>' + warnings.join('<br>') + '</div>';
+  } else {
+    editor.classList.add('rules-valid');
+    result.innerHTML = '<div class="validation-feedback success"><strong>✓ Rules are valid!</strong><br>No syntax errors detected.</div>';
+  }
+}
+
+function saveRules() {
+  const editor = document.getElementById('rules');
+  const rulesText = editor.textContent.trim();
+  
+  // Use fetch with explicit body control
+  fetch('/saverules', {
+    method: 'POST',
+    headers: {
+      'Content-Type': 'application/x-www-form-urlencoded'
+    },
+    body: 'rules=' + encodeURIComponent(rulesText)
+  })
+  .then(function(response) {
+    if (response.ok) {
+      // Reload the page to show saved rules
+      window.location.href = '/rules';
+    } else {
+      alert('Failed to save rules');
+    }
+  })
+  .catch(function(err) {
+    console.error('Error saving rules:', err);
+    alert('Error saving rules');
+  });
+}
+
+function clearRules() {
+  if(confirm('Are you sure you want to clear all rules? This cannot be undone.')) {
+    const editor = document.getElementById('rules');
+    editor.textContent = '';
+    
+    // Save the empty rules
+    const formData = new FormData();
+    formData.append('rules', '');
+    
+    fetch('/saverules', {
+      method: 'POST',
+      body: formData
+    })
+    .then(function(response) {
+      if (response.ok) {
+        window.location.href = '/rules';
+      } else {
+        alert('Failed to clear rules');
+      }
+    })
+    .catch(function(err) {
+      console.error('Error clearing rules:', err);
+      alert('Error clearing rules');
+    });
+  }
+}
+
+document.addEventListener('DOMContentLoaded', function() {
+  const editor = document.getElementById('rules');
+  if(editor) {
+    editor.textContent = editor.textContent.trim();
+    editor.addEventListener('keydown', function(e) {
+      if(e.key === 'Enter') {
+        e.preventDefault();
+        const sel = window.getSelection();
+        const range = sel.getRangeAt(0);
+        const lines = editor.textContent.substring(0, getCursorPosition()).split('\n');
+        const currentLine = lines[lines.length - 1];
+        const indentMatch = currentLine.match(/^[\t ]*/);
+        let indent = indentMatch ? indentMatch[0] : '';
+        const trimmedLine = currentLine.trim();
+        if(trimmedLine.endsWith('then')) {
+          indent += '\t';
+        }
+        range.deleteContents();
+        const textNode = document.createTextNode('\n' + indent);
+        range.insertNode(textNode);
+        range.setStartAfter(textNode);
+        range.setEndAfter(textNode);
+        sel.removeAllRanges();
+        sel.addRange(range);
+        highlightRules();
+        updateLineNumbers();
+      }
+      if(e.key === 'Tab') {
+        e.preventDefault();
+        const sel = window.getSelection();
+        const range = sel.getRangeAt(0);
+        range.deleteContents();
+        const textNode = document.createTextNode('\t');
+        range.insertNode(textNode);
+        range.setStartAfter(textNode);
+        range.setEndAfter(textNode);
+        sel.removeAllRanges();
+        sel.addRange(range);
+        highlightRules();
+        updateLineNumbers();
+      }
+      if(e.key === 'Backspace') {
+        const sel = window.getSelection();
+        if(sel.rangeCount === 0) return;
+        const range = sel.getRangeAt(0);
+        const textBeforeCursor = editor.textContent.substring(0, getCursorPosition());
+        const lines = textBeforeCursor.split('\n');
+        const currentLine = lines[lines.length - 1];
+        if(currentLine.match(/^[\t ]+$/) && range.collapsed) {
+          e.preventDefault();
+          const newIndent = currentLine.substring(0, currentLine.length - 1);
+          const lineStart = textBeforeCursor.length - currentLine.length;
+          const beforeLine = editor.textContent.substring(0, lineStart);
+          const afterLine = editor.textContent.substring(textBeforeCursor.length);
+          editor.textContent = beforeLine + newIndent + afterLine;
+          restoreCursorPosition(editor, lineStart + newIndent.length);
+          highlightRules();
+          updateLineNumbers();
+        }
+      }
+    });
+    
+    editor.addEventListener('input', highlightRules);
+    highlightRules();
+    updateLineNumbers();
+  }
+});
+
+function getCursorPosition() {
+  const sel = window.getSelection();
+  if(sel.rangeCount === 0) return 0;
+  const range = sel.getRangeAt(0);
+  const preCaretRange = range.cloneRange();
+  preCaretRange.selectNodeContents(document.getElementById('rules'));
+  preCaretRange.setEnd(range.endContainer, range.endOffset);
+  return preCaretRange.toString().length;
+}
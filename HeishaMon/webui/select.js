@@ -0,0 +1,8 @@
+function openTable(name){
+  var panes=document.getElementsByClassName('tab-pane');
+  for(var i=0;i<panes.length;i++)panes[i].classList.remove('active');
+  var target=document.getElementById(name);
+  if(target)target.classList.add('active');
+  var tabs=document.querySelectorAll('.tabnav button');
+  tabs.forEach(function(b){b.classList.toggle('active',b.dataset.tab===name);});
+}
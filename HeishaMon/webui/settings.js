@@ -0,0 +1,11 @@
+function ShowHideDallasTable(cb){
+  document.getElementById('dallassettings').style.display=cb.checked?'block':'none';
+}
+function ShowHideS0Table(cb){
+  document.getElementById('s0settings').style.display=cb.checked?'block':'none';
+}
+function changeMinWatt(port){
+  var ppkwh=document.getElementById('s0_ppkwh_'+port).value;
+  var interval=document.getElementById('s0_interval_'+port).value;
+  document.getElementById('s0_minwatt_'+port).innerHTML=Math.round((3600*1000/ppkwh)/interval);
+}
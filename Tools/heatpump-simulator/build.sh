@@ -0,0 +1,25 @@
+#!/bin/bash
+# Build the host-side heatpump simulator.
+# Links the frame parser (HeishaMon/serialframer.cpp) and the raw frame
+# recording format (HeishaMon/rawframes.cpp) of the firmware with
+# simulator.cpp. Requires g++.
+#
+# ./build.sh          optimized build
+# ./build.sh asan     address/undefined sanitizer build
+set -e
+
+DIR="$(cd "$(dirname "$0")" && pwd)"
+SRC="$DIR/../../HeishaMon"
+
+if [ "$1" = "asan" ]; then
+  FLAGS="-O1 -g -fsanitize=address,undefined -fno-omit-frame-pointer"
+else
+  FLAGS="-O2 -g"
+fi
+
+g++ -std=gnu++17 -Wall -pthread \
+  -I "$DIR/shim" -I "$SRC" $FLAGS $CXXFLAGS \
+  "$DIR/simulator.cpp" "$SRC/serialframer.cpp" "$SRC/rawframes.cpp" \
+  -o "$DIR/heatpump-simulator"
+
+echo "built: $DIR/heatpump-simulator"
@@ -0,0 +1,15 @@
+/*
+ * Host shim for the firmware sources the simulator links (serialframer.cpp,
+ * rawframes.cpp).
+ */
+#ifndef _HEATPUMP_SIMULATOR_ARDUINO_H_
+#define _HEATPUMP_SIMULATOR_ARDUINO_H_
+
+#include <stdint.h>
+#include <string.h>
+
+typedef uint8_t byte;
+
+unsigned long millis(void);
+
+#endif
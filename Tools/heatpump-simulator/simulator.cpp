@@ -0,0 +1,869 @@
+/*
+ * Host-side Panasonic heatpump simulator.
+ *
+ * Speaks the 0x71/0x31/0xF1 framing on a pseudo terminal, so anything that
+ * opens a serial port (a host build, a USB-serial adapter bridged with socat,
+ * a test script) can talk to it like to the heatpump:
+ *   - 0x71 0x6c 0x01 0x10 query: 203 byte main data block;
+ *   - 0x71 0x6c 0x01 0x21 query: 203 byte extra data block (K/L series);
+ *   - 0xF1 0x6c 0x01 0x10 write: settings are applied to the state, the
+ *     answer is the main data block like the real unit gives;
+ *   - 0xF1 0x11 0x01 0x50 optional PCB frame: 20 byte optional PCB answer;
+ *   - 0x31 initial query: short 0x31 answer.
+ *
+ * The state is not static: the compressor runs in cycles, a defrost is done
+ * while it runs and the water temperatures follow. Answers can be delayed,
+ * paced at 9600 baud and damaged (noise before the frame, flipped or dropped
+ * bytes, no answer at all) at configurable rates.
+ *
+ * A second pty can act as CZ-TAW1 for the proxy port of the ESP32 firmware.
+ * It polls like the CZ-TAW1 does and records the answer latency.
+ *
+ * The frame parser of the firmware (HeishaMon/serialframer.cpp) is linked
+ * in and used on both ends, so the `bench` command gives a reproducible
+ * good-read and latency baseline for the serial path.
+ *
+ * Raw frames recorded by the firmware (/rawframes, HeishaMon/rawframes.cpp)
+ * can be dumped as hex and replayed: the answers then follow the recorded
+ * data blocks instead of the model.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "serialframer.h"
+#include "rawframes.h"
+
+#define DATASIZE 203
+#define OPTDATASIZE 20
+#define QUERYSIZE 110
+#define SERIALTIMEOUT 2000 // same as the firmware
+#define BYTE_TIME_US(baud) (11 * 1000000 / (baud)) // 8E1
+
+/*
+ * Clock
+ */
+static uint64_t now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint64_t start_us = now_us();
+
+unsigned long millis(void) {
+  return (unsigned long)((now_us() - start_us) / 1000);
+}
+
+static volatile sig_atomic_t stop = 0;
+
+static void on_signal(int sig) {
+  stop = 1;
+}
+
+/*
+ * Options
+ */
+struct options_t {
+  unsigned int latency = 80; // ms before the heatpump starts answering
+  unsigned int jitter = 40; // ms added at random to the latency
+  unsigned int baud = 9600; // 0 writes the answer at once
+  double noise = 0; // chance of junk bytes before an answer
+  double corrupt = 0; // chance of one flipped byte in an answer
+  double drop = 0; // chance of one missing byte in an answer
+  double silent = 0; // chance of no answer at all
+  bool extra = true; // model with extra data block
+  unsigned int cycle = 600; // s the compressor runs and rests, 0 keeps it running
+  unsigned int defrost = 1800; // s of running between defrosts, 0 disables
+  unsigned int cztaw1 = 0; // ms between CZ-TAW1 queries on the proxy pty, 0 disables
+  unsigned int report = 10; // s between status lines
+  unsigned int seed = 1;
+  const char *link = NULL;
+  const char *proxylink = NULL;
+  const char *replay = NULL; // recording the answers follow
+};
+
+static struct options_t opts;
+
+static double rnd(void) {
+  return (double)rand() / ((double)RAND_MAX + 1);
+}
+
+static byte checksum(const byte *data, int len) {
+  byte chk = 0;
+  for (int i = 0; i < len; i++) {
+    chk += data[i];
+  }
+  return (chk ^ 0xFF) + 1;
+}
+
+/*
+ * Heatpump state
+ */
+
+// main block captured from a WH-MDC05F3E5, see Tools/chksumChecker.js
+static const char sampleMain[] =
+  "71c801105655624900050000000000000000000019151155165e550509000000000000000000808f808ab27171979900000000000000000000008085158a8585d07b781f7e1f1f79798d8d9e96718fb7a37b8f8e85808f8a949e8a8a949e82908b056578c10b00000000000000005556552153155a051212190000000000000000e2ce0d718172ce0c9281b000aa7cabb032329cb632323280b7afcd9aac79807780ff9101295900003b0b1c51590136790101c30200dd02000500000100000601010101010a1400000077";
+
+// bytes holding more than one setting, each mask is written separately
+// (same table as writeFields in HeishaMon/commands.cpp)
+static const struct {
+  byte pos;
+  byte masks[3];
+} writeFields[] = {
+  { 4, { 0x03, 0x30, 0xC0 } },
+  { 5, { 0x30, 0xC0, 0x00 } },
+  { 6, { 0x3F, 0xC0, 0x00 } },
+  { 7, { 0x07, 0x38, 0x00 } },
+  { 8, { 0x01, 0x02, 0x04 } },
+  { 26, { 0x03, 0x0C, 0x00 } },
+};
+
+struct heatpump_t {
+  byte main[DATASIZE];
+  byte extra[DATASIZE];
+  byte opt[OPTDATASIZE];
+  uint64_t cycleStart;
+  bool running;
+  bool defrosting;
+  uint64_t runStart;
+  uint64_t lastUpdate;
+  double outlet;
+  double inlet;
+  uint32_t heatConsumption;
+  uint32_t heatProduction;
+};
+
+static struct heatpump_t hp;
+
+/*
+ * Recordings of the firmware
+ */
+struct recorded_t {
+  unsigned long time; // ms since the first record
+  bool tx;
+  std::vector<byte> frame;
+};
+
+static std::vector<struct recorded_t> recording;
+static size_t replayPos = 0;
+static uint64_t replayStart = 0;
+
+// Decodes all segments of a download, printing them if dump is set. The
+// times continue over a reboot between segments.
+static bool load_recording(const char *path, bool dump) {
+  FILE *f = fopen(path, "rb");
+  if (f == NULL) {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    return false;
+  }
+  std::vector<byte> data;
+  byte buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    data.insert(data.end(), buf, buf + n);
+  }
+  fclose(f);
+
+  static struct rawFramesStruct state;
+  struct rawFramesHeaderStruct header;
+  unsigned long offset = 0;
+  unsigned long last = 0;
+  bool first = true;
+  unsigned long first_time = 0;
+  unsigned long bytes = 0;
+  unsigned long segments = 0;
+  size_t pos = 0;
+  while (pos < data.size()) {
+    if (rawFramesParseHeader(&data[pos], (int)(data.size() - pos), &header)) {
+      if (!first && (header.millis + offset < last)) {
+        offset = last - header.millis; // rebooted, keep the time going
+      }
+      rawFramesReset(&state, header.millis);
+      segments++;
+      pos += RAWFRAMES_HEADER_SIZE;
+      if (dump) {
+        printf("# segment %u millis %u unix time %u\n", header.sequence, header.millis, header.unixTime);
+      }
+      continue;
+    }
+    if (segments == 0) {
+      fprintf(stderr, "%s: no segment header\n", path);
+      return false;
+    }
+    bool tx;
+    byte frame[RAWFRAMES_MAX_FRAME];
+    int length;
+    unsigned long time;
+    int used = rawFramesDecode(&state, &data[pos], (int)(data.size() - pos), &tx, frame, &length, &time);
+    if (used <= 0) {
+      fprintf(stderr, "%s: %s record at %zu\n", path, used == 0 ? "truncated" : "invalid", pos);
+      break;
+    }
+    pos += used;
+    time += offset;
+    if (first) {
+      first_time = time;
+      first = false;
+    }
+    last = time;
+    bytes += length;
+    recording.push_back({ time - first_time, tx, std::vector<byte>(frame, frame + length) });
+    if (dump) {
+      printf("%lu %s ", time, tx ? "tx" : "rx");
+      for (int i = 0; i < length; i++) {
+        printf("%02x", frame[i]);
+      }
+      printf("\n");
+    }
+  }
+  if (dump) {
+    printf("# %zu frames in %lu segments, %lu frame bytes in %zu bytes (%.1f%%)\n", recording.size(), segments, bytes, data.size(), bytes ? 100.0 * data.size() / bytes : 0);
+  }
+  return !recording.empty();
+}
+
+// Sets the data blocks to the recorded answers up to now, from the start
+// again after the last one
+static void replay_update(void) {
+  uint64_t now = now_us();
+  if (replayPos >= recording.size()) {
+    replayPos = 0;
+    replayStart = now;
+  }
+  unsigned long elapsed = (unsigned long)((now - replayStart) / 1000);
+  while ((replayPos < recording.size()) && (recording[replayPos].time <= elapsed)) {
+    const struct recorded_t *r = &recording[replayPos++];
+    const byte *frame = r->frame.data();
+    if (r->tx || (frame[0] != 0x71) || (r->frame.size() < 4)) {
+      continue;
+    }
+    if ((r->frame.size() == DATASIZE) && (frame[3] == 0x10)) {
+      memcpy(hp.main, frame, DATASIZE);
+    } else if ((r->frame.size() == DATASIZE) && (frame[3] == 0x21)) {
+      memcpy(hp.extra, frame, DATASIZE);
+    } else if (r->frame.size() == OPTDATASIZE) {
+      memcpy(hp.opt, frame, OPTDATASIZE);
+    }
+  }
+}
+
+static void hp_init(void) {
+  for (int i = 0; i < DATASIZE; i++) {
+    unsigned int v;
+    sscanf(&sampleMain[i * 2], "%2x", &v);
+    hp.main[i] = v;
+  }
+  hp.main[199] = opts.extra ? 3 : 0; // byte 0xc7 tells the firmware the extra block exists
+
+  memset(hp.extra, 0, sizeof(hp.extra));
+  hp.extra[0] = 0x71;
+  hp.extra[1] = 0xc8;
+  hp.extra[2] = 0x01;
+  hp.extra[3] = 0x21;
+
+  memset(hp.opt, 0, sizeof(hp.opt));
+  hp.opt[0] = 0x71;
+  hp.opt[1] = OPTDATASIZE - 3;
+  hp.opt[2] = 0x01;
+  hp.opt[3] = 0x50;
+
+  hp.cycleStart = now_us();
+  hp.running = true;
+  hp.defrosting = false;
+  hp.runStart = hp.cycleStart;
+  hp.lastUpdate = hp.cycleStart;
+  hp.outlet = hp.main[144] - 128;
+  hp.inlet = hp.main[143] - 128;
+  hp.heatConsumption = 0;
+  hp.heatProduction = 0;
+}
+
+static void put16(byte *data, int pos, uint32_t value) {
+  value += 1; // getUintt16 subtracts 1
+  data[pos] = value & 0xFF;
+  data[pos + 1] = (value >> 8) & 0xFF;
+}
+
+// Advance the simulated heatpump to now
+static void hp_update(void) {
+  if (!recording.empty()) {
+    replay_update();
+    return;
+  }
+  uint64_t now = now_us();
+  double dt = (now - hp.lastUpdate) / 1e6;
+  hp.lastUpdate = now;
+
+  if (opts.cycle > 0) {
+    uint64_t phase = ((now - hp.cycleStart) / 1000000) % (2 * opts.cycle);
+    bool running = phase < opts.cycle;
+    if (running && !hp.running) {
+      hp.runStart = now;
+    }
+    hp.running = running;
+  }
+  hp.defrosting = false;
+  if (hp.running && (opts.defrost > 0)) {
+    uint64_t ran = (now - hp.runStart) / 1000000;
+    hp.defrosting = (ran > opts.defrost) && ((ran % (opts.defrost + 60)) >= opts.defrost);
+  }
+
+  double target = hp.running ? (hp.defrosting ? 20 : 45) : 25;
+  hp.outlet += (target - hp.outlet) * std::min(1.0, dt / 120);
+  hp.inlet += (hp.outlet - 5 - hp.inlet) * std::min(1.0, dt / 60);
+
+  byte freq = hp.running ? (hp.defrosting ? 60 : 42) : 0;
+  hp.main[166] = freq + 1; //TOP8 compressor frequency
+  hp.main[111] = (hp.main[111] & ~0x0C) | ((hp.defrosting ? 2 : 1) << 2); //TOP26 defrost state
+  hp.main[143] = (byte)(hp.inlet + 128); //TOP5 inlet
+  hp.main[144] = (byte)(hp.outlet + 128); //TOP6 outlet
+
+  // power in watts, as the extra block reports it
+  double power = hp.running ? (hp.defrosting ? 1800 : 1200) : 15;
+  hp.heatConsumption = (uint32_t)(power);
+  hp.heatProduction = hp.running && !hp.defrosting ? (uint32_t)(power * 3.8) : 0;
+  put16(hp.extra, 14, hp.heatConsumption); //XTOP0
+  put16(hp.extra, 20, hp.heatProduction); //XTOP3
+}
+
+// Settings of a write frame change the state like on the real unit: 0 means
+// no change, bytes with more than one setting are applied per field
+static void hp_write(const byte *frame) {
+  for (int pos = 4; pos < QUERYSIZE; pos++) {
+    byte value = frame[pos];
+    if (value == 0) {
+      continue;
+    }
+    bool fields = false;
+    for (unsigned int i = 0; i < sizeof(writeFields) / sizeof(writeFields[0]); i++) {
+      if (writeFields[i].pos != pos) {
+        continue;
+      }
+      fields = true;
+      for (int j = 0; j < 3; j++) {
+        byte mask = writeFields[i].masks[j];
+        if (value & mask) {
+          hp.main[pos] = (hp.main[pos] & ~mask) | (value & mask);
+        }
+      }
+    }
+    if (!fields) {
+      hp.main[pos] = value;
+    }
+  }
+}
+
+/*
+ * Output with latency, pacing and faults
+ */
+struct output_t {
+  int fd;
+  std::vector<byte> queue;
+  uint64_t due = 0; // when the next byte may be written
+};
+
+static struct {
+  unsigned long main, extra, writes, opt, init, unknown;
+  unsigned long noise, corrupt, drop, silent;
+} counters;
+
+// Queue a frame, the checksum byte is filled in. Answers of the heatpump get
+// its reaction time and the configured faults.
+static void send_frame(struct output_t *out, const byte *frame, int len, bool heatpump) {
+  std::vector<byte> bytes(frame, frame + len);
+  bytes[len - 1] = checksum(frame, len - 1);
+
+  uint64_t delay = 0;
+  if (heatpump) {
+    delay = (uint64_t)(opts.latency + (opts.jitter ? rand() % opts.jitter : 0)) * 1000;
+    if (rnd() < opts.silent) {
+      counters.silent++;
+      return;
+    }
+    if (rnd() < opts.corrupt) {
+      bytes[rand() % len] ^= 1 << (rand() % 8);
+      counters.corrupt++;
+    }
+    if (rnd() < opts.drop) {
+      bytes.erase(bytes.begin() + (rand() % len));
+      counters.drop++;
+    }
+    if (rnd() < opts.noise) {
+      int n = 1 + rand() % 4;
+      for (int i = 0; i < n; i++) {
+        bytes.insert(bytes.begin(), (byte)rand());
+      }
+      counters.noise++;
+    }
+  }
+
+  uint64_t now = now_us();
+  if (out->queue.empty() || (out->due < now + delay)) {
+    out->due = now + delay;
+  }
+  out->queue.insert(out->queue.end(), bytes.begin(), bytes.end());
+}
+
+static void flush_output(struct output_t *out) {
+  uint64_t now = now_us();
+  while (!out->queue.empty() && (now >= out->due)) {
+    size_t n = out->queue.size();
+    if (opts.baud > 0) {
+      n = std::min(n, (size_t)(1 + (now - out->due) / BYTE_TIME_US(opts.baud)));
+    }
+    ssize_t w = write(out->fd, out->queue.data(), n);
+    if (w <= 0) {
+      return;
+    }
+    out->queue.erase(out->queue.begin(), out->queue.begin() + w);
+    out->due += opts.baud > 0 ? (uint64_t)w * BYTE_TIME_US(opts.baud) : 0;
+  }
+}
+
+static uint64_t output_wait_us(struct output_t *out) {
+  if (out->queue.empty()) {
+    return UINT64_MAX;
+  }
+  uint64_t now = now_us();
+  return out->due > now ? out->due - now : 0;
+}
+
+static void handle_request(struct output_t *out, const byte *frame, int len) {
+  hp_update();
+  if ((frame[0] == 0x71) && (len == QUERYSIZE + 1) && (frame[3] == 0x10)) {
+    counters.main++;
+    send_frame(out, hp.main, DATASIZE, true);
+  } else if ((frame[0] == 0x71) && (len == QUERYSIZE + 1) && (frame[3] == 0x21)) {
+    counters.extra++;
+    if (opts.extra) {
+      send_frame(out, hp.extra, DATASIZE, true);
+    }
+  } else if ((frame[0] == 0xF1) && (len == QUERYSIZE + 1) && (frame[1] == 0x6c)) {
+    counters.writes++;
+    hp_write(frame);
+    send_frame(out, hp.main, DATASIZE, true);
+  } else if ((frame[0] == 0xF1) && (len == OPTDATASIZE) && (frame[1] == 0x11)) {
+    counters.opt++;
+    memcpy(&hp.opt[4], &frame[4], OPTDATASIZE - 5);
+    send_frame(out, hp.opt, OPTDATASIZE, true);
+  } else if (frame[0] == 0x31) {
+    counters.init++;
+    static const byte answer[] = { 0x31, 0x05, 0x01, 0x10, 0x00, 0x00, 0x00, 0x00 };
+    send_frame(out, answer, sizeof(answer), true);
+  } else {
+    counters.unknown++;
+  }
+}
+
+/*
+ * CZ-TAW1 on the proxy pty
+ */
+struct cztaw1_t {
+  struct output_t out;
+  struct serialFramerStruct framer;
+  uint64_t lastQuery = 0;
+  uint64_t sent = 0; // 0 when no answer is expected
+  unsigned long queries = 0;
+  unsigned long answers = 0;
+  unsigned long timeouts = 0;
+  unsigned long bad = 0;
+  std::vector<unsigned long> latency; // ms
+};
+
+static void cztaw1_poll(struct cztaw1_t *cz) {
+  uint64_t now = now_us();
+  if (cz->sent && ((now - cz->sent) / 1000 > SERIALTIMEOUT)) {
+    cz->timeouts++;
+    cz->sent = 0;
+    serialFramerReset(&cz->framer);
+  }
+  if (cz->sent || ((now - cz->lastQuery) / 1000 < opts.cztaw1)) {
+    return;
+  }
+  // the CZ-TAW1 alternates main and extra queries and sometimes writes a setting
+  byte query[QUERYSIZE + 1] = { 0x71, 0x6c, 0x01, 0x10 };
+  if (cz->queries % 10 == 9) {
+    query[0] = 0xF1;
+    query[7] = (cz->queries % 20 == 19) ? 0x09 : 0x11; // quiet mode off/1
+  } else if (opts.extra && (cz->queries % 2 == 1)) {
+    query[3] = 0x21;
+  }
+  cz->queries++;
+  cz->lastQuery = now;
+  cz->sent = now;
+  send_frame(&cz->out, query, sizeof(query), false);
+}
+
+static void cztaw1_read(struct cztaw1_t *cz, const byte *buf, int len) {
+  for (int i = 0; i < len; i++) {
+    serialFramerPut(&cz->framer, buf[i]);
+    byte result;
+    while ((result = serialFramerParse(&cz->framer, SERIAL_FRAMER_STRICT)) != SERIAL_FRAME_INCOMPLETE) {
+      if (result != SERIAL_FRAME_OK) {
+        cz->bad++;
+        continue;
+      }
+      if (cz->sent) {
+        cz->latency.push_back((now_us() - cz->sent) / 1000);
+        cz->answers++;
+        cz->sent = 0;
+      }
+      serialFramerConsume(&cz->framer);
+    }
+  }
+}
+
+static void latency_summary(std::vector<unsigned long> &v, char *out, size_t size) {
+  if (v.empty()) {
+    snprintf(out, size, "-");
+    return;
+  }
+  std::vector<unsigned long> s = v;
+  std::sort(s.begin(), s.end());
+  unsigned long long sum = 0;
+  for (unsigned long x : s) {
+    sum += x;
+  }
+  snprintf(out, size, "avg %llu p95 %lu max %lu ms", sum / s.size(), s[(s.size() * 95) / 100 == s.size() ? s.size() - 1 : (s.size() * 95) / 100], s.back());
+}
+
+/*
+ * pty
+ */
+static int open_pty(const char *link, char *name, size_t size) {
+  int fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if ((fd < 0) || (grantpt(fd) != 0) || (unlockpt(fd) != 0) || (ptsname_r(fd, name, size) != 0)) {
+    perror("pty");
+    exit(1);
+  }
+  // raw on the slave side, the firmware side sees plain bytes. The slave stays
+  // open so the master neither hangs up nor loses data between clients.
+  int slave = open(name, O_RDWR | O_NOCTTY);
+  struct termios tio;
+  tcgetattr(slave, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(slave, TCSANOW, &tio);
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  if (link != NULL) {
+    unlink(link);
+    if (symlink(name, link) != 0) {
+      perror("symlink");
+      exit(1);
+    }
+  }
+  return fd;
+}
+
+static void print_status(struct cztaw1_t *cz) {
+  hp_update();
+  printf("%6lus  %-8s main %lu extra %lu write %lu opt %lu init %lu unknown %lu  faults noise %lu corrupt %lu drop %lu silent %lu",
+    millis() / 1000, hp.defrosting ? "defrost" : (hp.running ? "running" : "idle"),
+    counters.main, counters.extra, counters.writes, counters.opt, counters.init, counters.unknown,
+    counters.noise, counters.corrupt, counters.drop, counters.silent);
+  if (cz != NULL) {
+    char lat[96];
+    latency_summary(cz->latency, lat, sizeof(lat));
+    printf("  | cztaw1 queries %lu answers %lu timeouts %lu bad %lu latency %s", cz->queries, cz->answers, cz->timeouts, cz->bad, lat);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+
+// Simulator loop on the heatpump pty and, if enabled, the CZ-TAW1 pty
+static void run(int fd, int proxyfd) {
+  struct output_t out;
+  out.fd = fd;
+  struct serialFramerStruct framer;
+  struct cztaw1_t cz;
+  cz.out.fd = proxyfd;
+  uint64_t lastReport = now_us();
+
+  while (!stop) {
+    struct pollfd fds[2];
+    int nfds = 1;
+    fds[0].fd = fd;
+    fds[0].events = POLLIN;
+    if (proxyfd >= 0) {
+      fds[1].fd = proxyfd;
+      fds[1].events = POLLIN;
+      nfds = 2;
+    }
+    uint64_t wait = std::min(output_wait_us(&out), (uint64_t)10000);
+    if (proxyfd >= 0) {
+      wait = std::min(wait, output_wait_us(&cz.out));
+    }
+    poll(fds, nfds, (int)(wait / 1000));
+
+    byte buf[256];
+    if (fds[0].revents & POLLIN) {
+      ssize_t len = read(fd, buf, sizeof(buf));
+      for (ssize_t i = 0; i < len; i++) {
+        serialFramerPut(&framer, buf[i]);
+        byte result;
+        while ((result = serialFramerParse(&framer, SERIAL_FRAMER_WRITES)) != SERIAL_FRAME_INCOMPLETE) {
+          if (result == SERIAL_FRAME_OK) {
+            handle_request(&out, framer.data, framer.frameLength);
+            serialFramerConsume(&framer);
+          }
+        }
+      }
+    }
+    if ((proxyfd >= 0) && (fds[1].revents & POLLIN)) {
+      ssize_t len = read(proxyfd, buf, sizeof(buf));
+      if (len > 0) {
+        cztaw1_read(&cz, buf, len);
+      }
+    }
+    if (proxyfd >= 0) {
+      cztaw1_poll(&cz);
+      flush_output(&cz.out);
+    }
+    flush_output(&out);
+
+    if ((opts.report > 0) && ((now_us() - lastReport) / 1000000 >= opts.report)) {
+      lastReport = now_us();
+      print_status(proxyfd >= 0 ? &cz : NULL);
+    }
+  }
+  print_status(proxyfd >= 0 ? &cz : NULL);
+}
+
+/*
+ * bench: poll the simulator through the pty like the firmware does
+ */
+
+// the parser readSerial() used before the framer: drop everything on an error
+struct legacy_t {
+  byte data[255];
+  int length = 0;
+  unsigned long good = 0;
+};
+
+static void legacy_put(struct legacy_t *l, byte value) {
+  l->data[l->length++] = value;
+  if (l->length > 3) {
+    if (((l->data[0] != 0x71) && (l->data[0] != 0x31)) || (l->data[2] != 0x01) || (l->length > l->data[1] + 3) || (l->length >= 255)) {
+      l->length = 0;
+      return;
+    }
+    if (l->length == l->data[1] + 3) {
+      byte chk = 0;
+      for (int i = 0; i < l->length; i++) {
+        chk += l->data[i];
+      }
+      if (chk == 0) {
+        l->good++;
+      }
+      l->length = 0;
+    }
+  }
+}
+
+static int bench(unsigned long count) {
+  char name[64];
+  int fd = open_pty(opts.link, name, sizeof(name));
+  int client = open(name, O_RDWR | O_NOCTTY);
+  if (client < 0) {
+    perror(name);
+    return 1;
+  }
+  struct termios tio;
+  tcgetattr(client, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(client, TCSANOW, &tio);
+
+  opts.report = 0;
+  std::thread sim(run, fd, -1);
+
+  struct serialFramerStruct framer;
+  struct legacy_t legacy;
+  unsigned long good = 0, timeouts = 0, badcrc = 0, badheader = 0, badlength = 0;
+  std::vector<unsigned long> latency;
+  uint64_t started = now_us();
+
+  for (unsigned long n = 0; (n < count) && !stop; n++) {
+    byte query[QUERYSIZE + 1] = { 0x71, 0x6c, 0x01, 0x10 };
+    if (n % 10 == 9) {
+      query[0] = 0xF1;
+      query[7] = 0x11;
+    } else if (opts.extra && (n % 3 == 2)) {
+      query[3] = 0x21;
+    }
+    query[QUERYSIZE] = checksum(query, QUERYSIZE);
+    if (write(client, query, sizeof(query)) != sizeof(query)) {
+      perror("write");
+      break;
+    }
+
+    // wait for one answer like readHeatpump(): a frame, or SERIALTIMEOUT
+    uint64_t sent = now_us();
+    bool answered = false;
+    while (!answered && !stop && ((now_us() - sent) / 1000 < SERIALTIMEOUT)) {
+      struct pollfd pfd = { client, POLLIN, 0 };
+      if (poll(&pfd, 1, 10) <= 0) {
+        continue;
+      }
+      byte buf[256];
+      ssize_t len = read(client, buf, sizeof(buf));
+      for (ssize_t i = 0; (i < len) && !answered; i++) {
+        legacy_put(&legacy, buf[i]);
+        serialFramerPut(&framer, buf[i]);
+        byte result;
+        while ((result = serialFramerParse(&framer, SERIAL_FRAMER_STRICT)) != SERIAL_FRAME_INCOMPLETE) {
+          if (result == SERIAL_FRAME_OK) {
+            good++;
+            latency.push_back((now_us() - sent) / 1000);
+            serialFramerConsume(&framer);
+            answered = true;
+            break;
+          } else if (result == SERIAL_FRAME_BADCRC) {
+            badcrc++;
+            answered = true; // the firmware clears sending on a complete frame
+            break;
+          } else if (result == SERIAL_FRAME_BADLENGTH) {
+            badlength++;
+          } else {
+            badheader++;
+          }
+        }
+      }
+    }
+    if (!answered) {
+      timeouts++;
+      serialFramerReset(&framer);
+      legacy.length = 0;
+    }
+  }
+  double seconds = (now_us() - started) / 1e6;
+  stop = 1;
+  sim.join();
+
+  char lat[96];
+  latency_summary(latency, lat, sizeof(lat));
+  printf("queries %lu in %.1fs  good %lu (%.1f%%)  bad crc %lu  bad header %lu  bad length %lu  timeouts %lu  resyncs %lu\n",
+    count, seconds, good, 100.0 * good / count, badcrc, badheader, badlength, timeouts, framer.resyncs);
+  printf("latency %s\n", lat);
+  printf("drop-on-error parser: good %lu (%.1f%%)\n", legacy.good, 100.0 * legacy.good / count);
+  printf("faults injected: noise %lu corrupt %lu drop %lu silent %lu\n", counters.noise, counters.corrupt, counters.drop, counters.silent);
+  close(client);
+  close(fd);
+  // every frame without a damaging fault must be read, noise alone must not cost one
+  return (good + counters.corrupt + counters.drop + counters.silent >= count) ? 0 : 3;
+}
+
+static void usage(void) {
+  fprintf(stderr,
+    "usage: heatpump-simulator [options] [serve | bench [count] | dump <file>]\n"
+    "  --link <path>       symlink to the heatpump pty\n"
+    "  --latency <ms>      answer delay (%u)\n"
+    "  --jitter <ms>       random extra delay (%u)\n"
+    "  --baud <n>          pace answers at this rate, 0 = at once (%u)\n"
+    "  --noise <p>         chance of junk bytes before an answer\n"
+    "  --corrupt <p>       chance of a flipped bit in an answer\n"
+    "  --drop <p>          chance of a missing byte in an answer\n"
+    "  --silent <p>        chance of no answer\n"
+    "  --no-extra          model without extra data block\n"
+    "  --cycle <s>         compressor on/off period, 0 = always on (%u)\n"
+    "  --defrost <s>       running time between defrosts, 0 = never (%u)\n"
+    "  --cztaw1 <ms>       act as CZ-TAW1 on a second pty, query interval\n"
+    "  --proxy-link <path> symlink to the CZ-TAW1 pty\n"
+    "  --report <s>        status line interval (%u)\n"
+    "  --seed <n>          random seed (%u)\n"
+    "  --replay <file>     answer with the data blocks of a recording\n",
+    opts.latency, opts.jitter, opts.baud, opts.cycle, opts.defrost, opts.report, opts.seed);
+}
+
+int main(int argc, char **argv) {
+  int i = 1;
+  for (; i < argc; i++) {
+    const char *arg = argv[i];
+    if (strncmp(arg, "--", 2) != 0) {
+      break;
+    }
+    if (strcmp(arg, "--no-extra") == 0) {
+      opts.extra = false;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      usage();
+      return 2;
+    }
+    const char *val = argv[++i];
+    if (strcmp(arg, "--link") == 0) opts.link = val;
+    else if (strcmp(arg, "--proxy-link") == 0) opts.proxylink = val;
+    else if (strcmp(arg, "--latency") == 0) opts.latency = atoi(val);
+    else if (strcmp(arg, "--jitter") == 0) opts.jitter = atoi(val);
+    else if (strcmp(arg, "--baud") == 0) opts.baud = atoi(val);
+    else if (strcmp(arg, "--noise") == 0) opts.noise = atof(val);
+    else if (strcmp(arg, "--corrupt") == 0) opts.corrupt = atof(val);
+    else if (strcmp(arg, "--drop") == 0) opts.drop = atof(val);
+    else if (strcmp(arg, "--silent") == 0) opts.silent = atof(val);
+    else if (strcmp(arg, "--cycle") == 0) opts.cycle = atoi(val);
+    else if (strcmp(arg, "--defrost") == 0) opts.defrost = atoi(val);
+    else if (strcmp(arg, "--cztaw1") == 0) opts.cztaw1 = atoi(val);
+    else if (strcmp(arg, "--report") == 0) opts.report = atoi(val);
+    else if (strcmp(arg, "--seed") == 0) opts.seed = atoi(val);
+    else if (strcmp(arg, "--replay") == 0) opts.replay = val;
+    else {
+      usage();
+      return 2;
+    }
+  }
+  srand(opts.seed);
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+  hp_init();
+
+  const char *cmd = (i < argc) ? argv[i] : "serve";
+  if (strcmp(cmd, "dump") == 0) {
+    if (i + 1 >= argc) {
+      usage();
+      return 2;
+    }
+    return load_recording(argv[i + 1], true) ? 0 : 1;
+  }
+  if (opts.replay != NULL) {
+    if (!load_recording(opts.replay, false)) {
+      return 1;
+    }
+    replayStart = now_us();
+    replay_update();
+  }
+  if (strcmp(cmd, "bench") == 0) {
+    return bench((i + 1 < argc) ? strtoul(argv[i + 1], NULL, 10) : 200);
+  }
+  if (strcmp(cmd, "serve") != 0) {
+    usage();
+    return 2;
+  }
+
+  char name[64];
+  int fd = open_pty(opts.link, name, sizeof(name));
+  printf("heatpump pty: %s%s%s\n", name, opts.link ? " -> " : "", opts.link ? opts.link : "");
+  int proxyfd = -1;
+  if (opts.cztaw1 > 0) {
+    char proxyname[64];
+    proxyfd = open_pty(opts.proxylink, proxyname, sizeof(proxyname));
+    printf("cztaw1 pty: %s%s%s\n", proxyname, opts.proxylink ? " -> " : "", opts.proxylink ? opts.proxylink : "");
+  }
+  fflush(stdout);
+  run(fd, proxyfd);
+  if (opts.link) unlink(opts.link);
+  if (opts.proxylink) unlink(opts.proxylink);
+  return 0;
+}
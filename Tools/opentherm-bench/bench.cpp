@@ -0,0 +1,547 @@
+/*
+ * Host-side OpenTherm test bench.
+ *
+ * Runs the OpenTherm slave of the firmware against recorded thermostat
+ * requests. The library (HeishaMon/src/opentherm/opentherm.cpp), the request
+ * handler (HeishaMon/HeishaOT.cpp) and the frame trace (HeishaMon/ottrace.cpp)
+ * are linked in unchanged:
+ *   - replay: every request is clocked in as manchester edges on the input
+ *     pin, loop() runs HeishaOTLoop() on a simulated clock and the answer the
+ *     timer interrupt clocks out on the output pin is decoded again. The
+ *     answers can be written to a file and compared with an earlier run.
+ *   - bench: processOTRequest() is called directly on the real clock to
+ *     measure the handler per data id.
+ *
+ * A trace holds one frame per line, as logged by an OpenTherm Gateway:
+ *   [time] T80000200
+ * T lines are requests of the thermostat, all other lines are skipped. The
+ * time is ms or hh:mm:ss.ffffff and gives the gap between requests, without
+ * it the requests are 1 s apart.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+
+#include <chrono>
+#include <vector>
+
+#include "src/opentherm/opentherm.h"
+#include "HeishaOT.h"
+#include "ottrace.h"
+
+#define OT_IN_PIN inOTPin
+#define OT_OUT_PIN outOTPin
+#define HALF_BIT_US OT_HALF_BIT_TIME
+
+extern OpenTherm ot;
+extern unsigned long otResponse;
+void mqttOTCallback(char* topic, char* value);
+void processOTRequest(unsigned long request, OpenThermResponseStatus status);
+
+static struct {
+  unsigned loop = 5; // ms between loop() runs
+  double stall = 0; // chance a loop() run blocks
+  unsigned stallTime = 900; // ms
+  double corrupt = 0; // chance a request gets a flipped bit on the line
+  unsigned seed = 1;
+  const char *expect = NULL;
+  const char *output = NULL;
+  bool verbose = false;
+  std::vector<const char *> values; // name=value as received from MQTT
+} opts;
+
+/*
+ * Clock, pins and timer1 for the shim
+ */
+static bool realClock = false;
+static uint64_t simUs = 0;
+
+static uint64_t realUs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+unsigned long micros(void) {
+  return realClock ? realUs() : simUs;
+}
+
+unsigned long millis(void) {
+  return micros() / 1000;
+}
+
+void delay(unsigned long ms) {
+  if (!realClock) {
+    simUs += (uint64_t)ms * 1000;
+  }
+}
+
+static int inLevel = LOW;
+static void (*pinInterrupt)(void) = NULL;
+static std::vector<uint8_t> outWrites; // levels written to the output pin
+static void (*timerInterrupt)(void) = NULL;
+static bool timerEnabled = false;
+static uint64_t timerNext = 0;
+static bool frameSent = false; // a frame was clocked out, see timer1_disable
+static unsigned long lineFrame = 0;
+
+int digitalRead(uint8_t pin) {
+  return (pin == OT_IN_PIN) ? inLevel : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin == OT_OUT_PIN) {
+    outWrites.push_back(value);
+  }
+}
+
+void attachInterrupt(int interrupt, void (*handler)(void), int mode) {
+  if (interrupt == OT_IN_PIN) {
+    pinInterrupt = handler;
+  }
+}
+
+void detachInterrupt(int interrupt) {
+  if (interrupt == OT_IN_PIN) {
+    pinInterrupt = NULL;
+  }
+}
+
+void timer1_attachInterrupt(void (*handler)(void)) {
+  timerInterrupt = handler;
+}
+
+void timer1_enable(uint8_t divider, uint8_t edge, uint8_t reload) {
+  timerEnabled = true;
+  timerNext = simUs + HALF_BIT_US;
+}
+
+void timer1_write(uint32_t ticks) {
+}
+
+// Called after the stop bit, the last OT_FRAME_HALF_BITS writes are the frame.
+// The active level is LOW, a 1 bit is active first and idle second.
+void timer1_disable(void) {
+  timerEnabled = false;
+  if (outWrites.size() < OT_FRAME_HALF_BITS) {
+    return;
+  }
+  const uint8_t *half = &outWrites[outWrites.size() - OT_FRAME_HALF_BITS];
+  unsigned long frame = 0;
+  bool valid = true;
+  for (int bit = 0; bit < OT_FRAME_HALF_BITS / 2; bit++) {
+    bool one = (half[2 * bit] == LOW);
+    valid = valid && (half[2 * bit] != half[2 * bit + 1]);
+    if ((bit > 0) && (bit < OT_FRAME_HALF_BITS / 2 - 1)) {
+      frame = (frame << 1) | one;
+    } else {
+      valid = valid && one; // start and stop bit
+    }
+  }
+  frameSent = true;
+  lineFrame = valid ? frame : 0;
+  outWrites.clear();
+}
+
+/*
+ * Firmware functions HeishaOT.cpp calls
+ */
+static unsigned long logLines = 0;
+static unsigned long publishes = 0;
+static unsigned long events = 0;
+
+void log_message(char *string) {
+  logLines++;
+  if (opts.verbose) {
+    printf("%9.3f log %s\n", simUs / 1000.0, string);
+  }
+}
+
+void mqttPublish(char *topic, char *subtopic, char *value) {
+  publishes++;
+  if (opts.verbose) {
+    printf("%9.3f mqtt %s/%s %s\n", simUs / 1000.0, topic, subtopic, value);
+  }
+}
+
+void mqttPublish(char *topic, char *subtopic, char *value, bool retain) {
+  mqttPublish(topic, subtopic, value);
+}
+
+void rules_event_cb(const char *prefix, const char *name) {
+  events++;
+}
+
+void websocket_write_all(char *data, uint16_t data_len) {
+}
+
+void webserver_send_content(struct webserver_t *client, char *buf, uint16_t len) {
+  fwrite(buf, 1, len, stdout);
+}
+
+void webserver_send_content_P(struct webserver_t *client, PGM_P buf, uint16_t len) {
+  fwrite(buf, 1, len, stdout);
+}
+
+/*
+ * Trace
+ */
+struct requestStruct {
+  uint64_t time; // us since the first request
+  unsigned long frame;
+};
+
+// ms or hh:mm:ss.ffffff, returns false if the token is no time
+static bool parseTime(const char *token, uint64_t *us) {
+  unsigned h, m;
+  double s;
+  if (sscanf(token, "%u:%u:%lf", &h, &m, &s) == 3) {
+    *us = ((uint64_t)h * 3600 + m * 60) * 1000000 + (uint64_t)(s * 1000000);
+    return true;
+  }
+  char *end;
+  double ms = strtod(token, &end);
+  if ((end != token) && (*end == '\0')) {
+    *us = (uint64_t)(ms * 1000);
+    return true;
+  }
+  return false;
+}
+
+static bool loadTrace(const char *path, std::vector<requestStruct> &requests) {
+  FILE *f = fopen(path, "r");
+  if (f == NULL) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return false;
+  }
+  char line[256];
+  uint64_t first = 0;
+  bool timed = false;
+  while (fgets(line, sizeof(line), f) != NULL) {
+    if (line[0] == '#') {
+      continue;
+    }
+    uint64_t time = 0;
+    bool hasTime = false;
+    char *frame = NULL;
+    for (char *token = strtok(line, " \t\r\n"); token != NULL; token = strtok(NULL, " \t\r\n")) {
+      if ((token[0] == 'T') && (strlen(token) == 9) && (strspn(token + 1, "0123456789abcdefABCDEF") == 8)) {
+        frame = token + 1;
+      } else if (!hasTime) {
+        hasTime = parseTime(token, &time);
+      }
+    }
+    if (frame == NULL) {
+      continue;
+    }
+    requestStruct request;
+    request.frame = strtoul(frame, NULL, 16);
+    if (requests.empty()) {
+      timed = hasTime;
+      first = time;
+    }
+    if (timed && hasTime && (time > first)) {
+      request.time = time - first;
+    } else {
+      request.time = requests.size() * 1000000ULL;
+    }
+    if (!requests.empty() && (request.time <= requests.back().time + 100000)) {
+      request.time = requests.back().time + 100000; // keep the frames and the answer delay apart
+    }
+    requests.push_back(request);
+  }
+  fclose(f);
+  if (requests.empty()) {
+    fprintf(stderr, "no T lines in %s\n", path);
+    return false;
+  }
+  return true;
+}
+
+static void setValues(void) {
+  for (const char *value : opts.values) {
+    char name[64];
+    const char *eq = strchr(value, '=');
+    if ((eq == NULL) || ((size_t)(eq - value) >= sizeof(name))) {
+      continue;
+    }
+    snprintf(name, sizeof(name), "%.*s", (int)(eq - value), value);
+    mqttOTCallback(name, (char *)eq + 1);
+  }
+}
+
+static void printIdStats(bool handler) {
+  printf("  id  requests  answered  late  latency avg/max ms  handler avg/max us\n");
+  for (int i = 0; (i < OTTRACE_IDS) && (otTraceStats.ids[i].id >= 0); i++) {
+    otTraceIdStruct *ids = &otTraceStats.ids[i];
+    printf("%4d %9lu %9lu %5lu %10lu /%5u", ids->id, ids->requests, ids->answered, ids->late,
+           ids->answered ? ids->latencySum / ids->answered : 0, ids->latencyMax);
+    if (handler) {
+      printf(" %12lu /%5u", ids->requests ? ids->handlerSum / ids->requests : 0, ids->handlerMax);
+    }
+    printf("\n");
+  }
+}
+
+/*
+ * replay: requests on the line, simulated clock
+ */
+static uint64_t loopNext = 0;
+static PubSubClient mqttClient;
+
+// Runs interrupts and loop() up to until
+static void runUntil(uint64_t until, std::vector<std::pair<uint64_t, int>> &edges, size_t &edge, unsigned long *sent) {
+  while (true) {
+    uint64_t next = until;
+    int what = 0;
+    if ((edge < edges.size()) && (edges[edge].first <= next)) {
+      next = edges[edge].first;
+      what = 1;
+    }
+    if (timerEnabled && (timerNext <= next)) {
+      next = timerNext;
+      what = 2;
+    }
+    if (loopNext <= next) {
+      next = loopNext;
+      what = 3;
+    }
+    simUs = next;
+    if (what == 0) {
+      return;
+    } else if (what == 1) {
+      inLevel = edges[edge++].second;
+      if (pinInterrupt != NULL) pinInterrupt();
+    } else if (what == 2) {
+      timerNext += HALF_BIT_US;
+      if (timerInterrupt != NULL) timerInterrupt();
+    } else {
+      if ((otResponse != 0) && ot.isReady()) {
+        *sent = otResponse; // HeishaOTLoop() sends it now
+      }
+      HeishaOTLoop(NULL, mqttClient, NULL);
+      bool stall = (opts.stall > 0) && ((double)rand() / RAND_MAX < opts.stall);
+      loopNext = simUs + 1000ULL * (stall ? opts.stallTime : opts.loop);
+    }
+  }
+}
+
+// manchester edges of a frame with start and stop bit, a 1 bit is high first
+static void frameEdges(unsigned long frame, uint64_t start, std::vector<std::pair<uint64_t, int>> &edges) {
+  uint64_t bits = (1ULL << 33) | ((uint64_t)frame << 1) | 1ULL;
+  int level = LOW;
+  for (int half = 0; half < OT_FRAME_HALF_BITS; half++) {
+    bool one = (bits >> (33 - half / 2)) & 1;
+    int next = ((half & 1) == 0) == one ? HIGH : LOW;
+    if (next != level) {
+      edges.push_back(std::make_pair(start + (uint64_t)half * HALF_BIT_US, next));
+      level = next;
+    }
+  }
+  if (level != LOW) {
+    edges.push_back(std::make_pair(start + (uint64_t)OT_FRAME_HALF_BITS * HALF_BIT_US, LOW));
+  }
+}
+
+// The clock does not change the answer of a read, the date and time do
+static bool sameAnswer(unsigned long request, unsigned long expected, unsigned long answer) {
+  uint8_t id = (request >> 16) & 0xFF;
+  if ((id >= OpenThermMessageID::DayTime) && (id <= OpenThermMessageID::Year)) {
+    //message type and data id only, the parity bit follows the data
+    return (expected & 0x7FFF0000UL) == (answer & 0x7FFF0000UL);
+  }
+  return expected == answer;
+}
+
+static int replay(std::vector<requestStruct> &requests) {
+  HeishaOTSetup(); //includes the 1 s activateBoiler() delay
+  setValues();
+  FILE *expect = NULL;
+  FILE *output = NULL;
+  if ((opts.expect != NULL) && ((expect = fopen(opts.expect, "r")) == NULL)) {
+    fprintf(stderr, "cannot open %s\n", opts.expect);
+    return 2;
+  }
+  if ((opts.output != NULL) && ((output = fopen(opts.output, "w")) == NULL)) {
+    fprintf(stderr, "cannot create %s\n", opts.output);
+    return 2;
+  }
+
+  uint64_t start = simUs + 100000;
+  loopNext = simUs;
+  unsigned long corrupted = 0;
+  unsigned long unanswered = 0;
+  unsigned long lineErrors = 0;
+  unsigned long mismatches = 0;
+  for (size_t i = 0; i < requests.size(); i++) {
+    unsigned long frame = requests[i].frame;
+    if ((opts.corrupt > 0) && ((double)rand() / RAND_MAX < opts.corrupt)) {
+      frame ^= 1UL << (rand() % 32);
+      corrupted++;
+    }
+    std::vector<std::pair<uint64_t, int>> edges;
+    frameEdges(frame, start + requests[i].time, edges);
+    uint64_t until = (i + 1 < requests.size()) ? start + requests[i + 1].time : start + requests[i].time + 2000000;
+    size_t edge = 0;
+    unsigned long sent = 0;
+    frameSent = false;
+    runUntil(until, edges, edge, &sent);
+
+    unsigned long answer = frameSent ? lineFrame : 0;
+    if (frameSent && (answer != sent)) {
+      lineErrors++; // the frame on the output pin is not the one handed to sendResponse()
+      printf("line error: T%08lX sent %08lX, decoded %08lX\n", frame, sent, answer);
+    }
+    if (!frameSent) {
+      unanswered++;
+    }
+    char line[32];
+    if (frameSent) {
+      snprintf(line, sizeof(line), "T%08lX B%08lX", frame, answer);
+    } else {
+      snprintf(line, sizeof(line), "T%08lX -", frame);
+    }
+    if (output != NULL) {
+      fprintf(output, "%s\n", line);
+    }
+    if (opts.verbose) {
+      printf("%9.3f %s\n", simUs / 1000.0, line);
+    }
+    if (expect != NULL) {
+      char want[64];
+      unsigned long wantRequest = 0;
+      unsigned long wantAnswer = 0;
+      bool ok = fgets(want, sizeof(want), expect) != NULL;
+      int fields = ok ? sscanf(want, "T%lx B%lx", &wantRequest, &wantAnswer) : 0;
+      ok = ok && (fields >= 1) && (wantRequest == frame);
+      if (ok) {
+        ok = frameSent ? ((fields == 2) && sameAnswer(frame, wantAnswer, answer)) : (fields == 1);
+      }
+      if (!ok) {
+        mismatches++;
+        printf("differs: %s, expected %s", line, want);
+      }
+    }
+  }
+  if (expect != NULL) fclose(expect);
+  if (output != NULL) fclose(output);
+
+  printf("requests %zu, corrupted %lu, answered %lu, not answered %lu\n", requests.size(), corrupted, requests.size() - unanswered, unanswered);
+  printf("trace: invalid %lu, timeouts %lu, dropped %lu, late %lu, untracked %lu\n",
+         otTraceStats.invalid, otTraceStats.timeouts, otTraceStats.dropped, otTraceStats.late, otTraceStats.untracked);
+  printf("log lines %lu, mqtt publishes %lu, rule events %lu\n", logLines, publishes, events);
+  printIdStats(false);
+  if (lineErrors > 0) {
+    printf("%lu answers were not clocked out as sent\n", lineErrors);
+  }
+  if (opts.expect != NULL) {
+    printf("%lu answers differ from %s\n", mismatches, opts.expect);
+  }
+  return ((lineErrors > 0) || (mismatches > 0)) ? 1 : 0;
+}
+
+/*
+ * bench: the handler alone, real clock
+ */
+static int bench(std::vector<requestStruct> &requests, unsigned long rounds) {
+  HeishaOTSetup();
+  setValues();
+  realClock = true;
+  auto begin = std::chrono::steady_clock::now();
+  for (unsigned long r = 0; r < rounds; r++) {
+    for (requestStruct &request : requests) {
+      processOTRequest(request.frame, ot.isValidRequest(request.frame) ? OpenThermResponseStatus::SUCCESS : OpenThermResponseStatus::INVALID);
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  unsigned long count = rounds * requests.size();
+  printf("%lu requests in %.3f s, %.2f us per request\n", count, seconds, seconds * 1e6 / count);
+  printf("handler max %u us, log lines %lu, mqtt publishes %lu, rule events %lu\n", otTraceStats.handlerMax, logLines, publishes, events);
+  printIdStats(true);
+  return 0;
+}
+
+static void usage(void) {
+  fprintf(stderr,
+          "usage: opentherm-bench [options] replay <trace>\n"
+          "       opentherm-bench [options] bench <trace> [rounds]\n"
+          "       opentherm-bench [options] json <trace>\n"
+          "options:\n"
+          "  --loop <ms>         time between loop() runs (5)\n"
+          "  --stall <p>         chance a loop() run blocks (0)\n"
+          "  --stall-time <ms>   time a blocked loop() run takes (900)\n"
+          "  --corrupt <p>       chance of a flipped bit in a request (0)\n"
+          "  --seed <n>          random seed (1)\n"
+          "  --set <name=value>  set an OpenTherm value as MQTT does, repeatable\n"
+          "  --output <file>     write the requests and answers\n"
+          "  --expect <file>     compare the answers with an earlier --output\n"
+          "  --verbose           print the log, MQTT and every frame\n");
+}
+
+int main(int argc, char **argv) {
+  int i = 1;
+  for (; i < argc; i++) {
+    const char *arg = argv[i];
+    if (strncmp(arg, "--", 2) != 0) {
+      break;
+    }
+    if (strcmp(arg, "--verbose") == 0) {
+      opts.verbose = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      usage();
+      return 2;
+    }
+    const char *val = argv[++i];
+    if (strcmp(arg, "--loop") == 0) opts.loop = atoi(val);
+    else if (strcmp(arg, "--stall") == 0) opts.stall = atof(val);
+    else if (strcmp(arg, "--stall-time") == 0) opts.stallTime = atoi(val);
+    else if (strcmp(arg, "--corrupt") == 0) opts.corrupt = atof(val);
+    else if (strcmp(arg, "--seed") == 0) opts.seed = atoi(val);
+    else if (strcmp(arg, "--set") == 0) opts.values.push_back(val);
+    else if (strcmp(arg, "--output") == 0) opts.output = val;
+    else if (strcmp(arg, "--expect") == 0) opts.expect = val;
+    else {
+      usage();
+      return 2;
+    }
+  }
+  if (i + 1 >= argc) {
+    usage();
+    return 2;
+  }
+  srand(opts.seed);
+  if (opts.loop == 0) {
+    opts.loop = 1;
+  }
+  const char *cmd = argv[i];
+  std::vector<requestStruct> requests;
+  if (!loadTrace(argv[i + 1], requests)) {
+    return 2;
+  }
+  if (strcmp(cmd, "replay") == 0) {
+    return replay(requests);
+  }
+  if (strcmp(cmd, "bench") == 0) {
+    return bench(requests, (i + 2 < argc) ? strtoul(argv[i + 2], NULL, 10) : 1000);
+  }
+  if (strcmp(cmd, "json") == 0) {
+    int result = replay(requests);
+    printf("{");
+    String text = otTraceJsonStats();
+    fwrite(text.c_str(), 1, text.length(), stdout);
+    printf(",\"frames\":[");
+    unsigned long count = otTraceCount();
+    text = otTraceJsonFrames(count > OTTRACE_SIZE ? count - OTTRACE_SIZE : 0, count);
+    fwrite(text.c_str(), 1, text.length(), stdout);
+    printf("]}\n");
+    return result;
+  }
+  usage();
+  return 2;
+}
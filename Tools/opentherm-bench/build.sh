@@ -0,0 +1,27 @@
+#!/bin/bash
+# Build the host-side OpenTherm test bench.
+# Links the OpenTherm library (HeishaMon/src/opentherm/opentherm.cpp), the
+# request handler (HeishaMon/HeishaOT.cpp) and the frame trace
+# (HeishaMon/ottrace.cpp) of the firmware with bench.cpp. Requires g++.
+#
+# ./build.sh          optimized build
+# ./build.sh asan     address/undefined sanitizer build
+set -e
+
+DIR="$(cd "$(dirname "$0")" && pwd)"
+SRC="$DIR/../../HeishaMon"
+
+if [ "$1" = "asan" ]; then
+  FLAGS="-O1 -g -fsanitize=address,undefined -fno-omit-frame-pointer"
+else
+  FLAGS="-O2 -g"
+fi
+
+# the ESP8266 timer1 code path of the library, with the pins of the bench
+g++ -std=gnu++17 -Wall -DinOTPin=4 -DoutOTPin=5 \
+  -I "$DIR/shim" -I "$SRC" $FLAGS $CXXFLAGS \
+  "$DIR/bench.cpp" "$SRC/HeishaOT.cpp" "$SRC/ottrace.cpp" \
+  "$SRC/src/opentherm/opentherm.cpp" "$SRC/src/common/stricmp.cpp" \
+  -o "$DIR/opentherm-bench"
+
+echo "built: $DIR/opentherm-bench"
@@ -0,0 +1,80 @@
+/*
+ * Host shim for the firmware sources the OpenTherm bench links
+ * (HeishaOT.cpp, ottrace.cpp, src/opentherm/opentherm.cpp).
+ * The OpenTherm input pin, the output pin and timer1 are simulated by
+ * bench.cpp, the clock is simulated too unless the bench selects the real one.
+ */
+#ifndef _OPENTHERM_BENCH_ARDUINO_H_
+#define _OPENTHERM_BENCH_ARDUINO_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define CHANGE 3
+
+#define IRAM_ATTR
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(x) (x)
+#define F(x) (x)
+#define FPSTR(x) (x)
+#define sprintf_P sprintf
+#define strcpy_P strcpy
+#define memcpy_P memcpy
+#define strcmp_P strcmp
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+
+#define TIM_DIV16 1
+#define TIM_EDGE 0
+#define TIM_LOOP 1
+
+unsigned long micros(void);
+unsigned long millis(void);
+void delay(unsigned long ms);
+static inline void yield(void) {}
+static inline void noInterrupts(void) {}
+static inline void interrupts(void) {}
+
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+static inline void pinMode(uint8_t pin, uint8_t mode) {}
+static inline int digitalPinToInterrupt(int pin) { return pin; }
+void attachInterrupt(int interrupt, void (*handler)(void), int mode);
+void detachInterrupt(int interrupt);
+
+void timer1_attachInterrupt(void (*handler)(void));
+void timer1_enable(uint8_t divider, uint8_t edge, uint8_t reload);
+void timer1_write(uint32_t ticks);
+void timer1_disable(void);
+
+class String {
+  public:
+    String() {}
+    String(const char *str) : s(str) {}
+    String &operator=(const char *str) { s = str; return *this; }
+    String &operator+=(const String &str) { s += str.s; return *this; }
+    String &operator+=(const char *str) { s += str; return *this; }
+    String &operator+=(char c) { s += c; return *this; }
+    String &operator+=(int n) { s += std::to_string(n); return *this; }
+    String &operator+=(unsigned int n) { s += std::to_string(n); return *this; }
+    String &operator+=(long n) { s += std::to_string(n); return *this; }
+    String &operator+=(unsigned long n) { s += std::to_string(n); return *this; }
+    void reserve(size_t size) { s.reserve(size); }
+    size_t length() const { return s.length(); }
+    const char *c_str() const { return s.c_str(); }
+  private:
+    std::string s;
+};
+
+#endif
@@ -0,0 +1,10 @@
+/*
+ * Host shim, HeishaOT.h only passes the client by reference.
+ */
+#ifndef _OPENTHERM_BENCH_PUBSUBCLIENT_H_
+#define _OPENTHERM_BENCH_PUBSUBCLIENT_H_
+
+class PubSubClient {
+};
+
+#endif
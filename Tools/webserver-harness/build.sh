@@ -0,0 +1,33 @@
+#!/bin/bash
+# Build the host-side webserver harness.
+# Compiles the real firmware webserver (HeishaMon/src/common/webserver.cpp,
+# its __linux__ branch) for the host and links it with harness.cpp.
+# Requires g++.
+#
+# ./build.sh          optimized build for benchmarks
+# ./build.sh asan     address/undefined sanitizer build for fuzzing
+#
+# Extra compiler flags can be passed via CXXFLAGS, e.g. to match the ESP32
+# buffer size: CXXFLAGS=-DWEBSERVER_BUFFER_SIZE=512 ./build.sh
+set -e
+
+DIR="$(cd "$(dirname "$0")" && pwd)"
+SRC="$DIR/../../HeishaMon/src/common"
+
+# default to the ESP8266 buffer size, the tighter of the two targets
+FLAGS="-DWEBSERVER_BUFFER_SIZE=128"
+if [ "$1" = "asan" ]; then
+  FLAGS="$FLAGS -O1 -g -fsanitize=address,undefined -fno-omit-frame-pointer"
+else
+  FLAGS="$FLAGS -O2 -g"
+fi
+
+g++ -std=gnu++17 -Wall -Wno-unused-variable -Wno-unused-but-set-variable -Wno-return-type -Wno-register \
+  -I "$DIR/shim" -I "$SRC" $FLAGS $CXXFLAGS \
+  "$DIR/harness.cpp" \
+  "$SRC/webserver.cpp" "$SRC/base64.cpp" "$SRC/sha1.cpp" \
+  "$SRC/strnstr.cpp" "$SRC/strncasestr.cpp" \
+  -Wl,--wrap=malloc,--wrap=free,--wrap=realloc,--wrap=strdup \
+  -o "$DIR/webserver-harness"
+
+echo "built: $DIR/webserver-harness"
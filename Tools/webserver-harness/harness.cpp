@@ -0,0 +1,876 @@
+/*
+ * Host-side load and fuzz harness for the firmware webserver.
+ *
+ * Links the real HeishaMon/src/common/webserver.cpp (its __linux__ branch)
+ * and drives the sync WiFiClient code path that the firmware uses, through
+ * one of two backends:
+ *   - replay: request bytes come from memory and are handed to the server in
+ *     chunks of a configurable size, responses are captured or counted;
+ *   - socket: a plain TCP listener, so curl, ab, wrk or a browser can be
+ *     pointed at it.
+ *
+ * The request callback mirrors the shape of webserver_cb() in HeishaMon.ino
+ * for the routes that matter for performance: /json (many small
+ * webserver_send_content(_P) fragments, 5 topics per content step), websocket
+ * broadcast via websocket_write_all() and multipart /firmware uploads.
+ *
+ * All heap traffic of the webserver is counted by wrapping malloc/free
+ * (see build.sh), which gives bytes copied into the send list per response
+ * and the peak heap per client.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <malloc.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include <string>
+#include <utility>
+
+#include "webserver.h"
+#include "unittest.h"
+
+int http_parse_request(struct webserver_t *client, uint8_t **buf, uint16_t *len);
+
+/*
+ * Clock
+ */
+static uint64_t now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint64_t start_us = 0;
+
+unsigned long millis(void) {
+  return (unsigned long)((now_us() - start_us) / 1000);
+}
+
+void log_message(char *string) {
+}
+
+/*
+ * lwIP stubs, only referenced by the async code path
+ */
+int tcp_write(tcp_pcb *pcb, const void *buf, uint16_t len, uint8_t flags) {
+  abort();
+}
+
+uint16_t tcp_write_P(tcp_pcb *pcb, PGM_P buf, uint16_t len, uint8_t flags) {
+  abort();
+}
+
+int tcp_output(tcp_pcb *pcb) {
+  abort();
+}
+
+uint16_t tcp_sndbuf(tcp_pcb *pcb) {
+  abort();
+}
+
+void tcp_recved(tcp_pcb *pcb, uint16_t len) {
+  abort();
+}
+
+void pbuf_free(struct pbuf *p) {
+  abort();
+}
+
+/*
+ * Heap accounting, build.sh links with -Wl,--wrap for these. Only calls made
+ * from the firmware objects and from this file are wrapped; the harness
+ * itself only allocates through operator new, so the counters see exactly
+ * what the webserver allocates.
+ */
+static struct {
+  size_t base;
+  size_t cur;
+  size_t peak;
+  uint64_t calls;
+  uint64_t bytes;
+} heap;
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+static void heap_add(void *ptr, size_t size) {
+  heap.cur += malloc_usable_size(ptr);
+  if(heap.cur > heap.peak) {
+    heap.peak = heap.cur;
+  }
+  heap.calls++;
+  heap.bytes += size;
+}
+
+void *__wrap_malloc(size_t size) {
+  void *ptr = __real_malloc(size);
+  if(ptr != NULL) {
+    heap_add(ptr, size);
+  }
+  return ptr;
+}
+
+void __wrap_free(void *ptr) {
+  if(ptr != NULL) {
+    heap.cur -= malloc_usable_size(ptr);
+  }
+  __real_free(ptr);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  if(ptr != NULL) {
+    heap.cur -= malloc_usable_size(ptr);
+  }
+  void *ret = __real_realloc(ptr, size);
+  if(ret != NULL) {
+    heap_add(ret, size);
+  }
+  return ret;
+}
+
+char *__wrap_strdup(const char *str) {
+  size_t len = strlen(str) + 1;
+  char *ret = (char *)__wrap_malloc(len);
+  if(ret != NULL) {
+    memcpy(ret, str, len);
+  }
+  return ret;
+}
+}
+
+static void heap_reset_counters(void) {
+  heap.peak = heap.cur;
+  heap.calls = 0;
+  heap.bytes = 0;
+}
+
+/*
+ * Connection backends
+ */
+typedef struct conn_t {
+  int fd;
+  std::string in;
+  size_t inpos;
+  size_t chunk;
+  uint8_t hungup;
+  uint8_t capture;
+  std::string out;
+  uint64_t outbytes;
+  uint64_t writes;
+} conn_t;
+
+static conn_t conns[WEBSERVER_MAX_CLIENTS];
+static WiFiClient wifi[WEBSERVER_MAX_CLIENTS];
+
+static int conn_write(int n, const unsigned char *buf, int len) {
+  conn_t *c = &conns[n];
+  if(len <= 0) {
+    return 0;
+  }
+  c->writes++;
+  c->outbytes += len;
+  if(c->fd >= 0) {
+    int done = 0;
+    while(done < len) {
+      ssize_t r = send(c->fd, &buf[done], len - done, MSG_NOSIGNAL);
+      if(r <= 0) {
+        if(r < 0 && errno == EINTR) {
+          continue;
+        }
+        c->hungup = 1;
+        return -1;
+      }
+      done += r;
+    }
+  } else if(c->capture == 1) {
+    c->out.append((const char *)buf, len);
+  }
+  return len;
+}
+
+static int conn_read(int n, uint8_t *buf, int size) {
+  conn_t *c = &conns[n];
+  if(c->fd >= 0) {
+    ssize_t r = recv(c->fd, buf, size, MSG_DONTWAIT);
+    if(r == 0) {
+      c->hungup = 1;
+    }
+    return r > 0 ? r : 0;
+  }
+  size_t len = c->in.size() - c->inpos;
+  if(len > (size_t)size) {
+    len = size;
+  }
+  if(len > c->chunk) {
+    len = c->chunk;
+  }
+  memcpy(buf, &c->in[c->inpos], len);
+  c->inpos += len;
+  return len;
+}
+
+static int conn_available(int n) {
+  conn_t *c = &conns[n];
+  if(c->fd >= 0) {
+    uint8_t b;
+    ssize_t r = recv(c->fd, &b, 1, MSG_DONTWAIT | MSG_PEEK);
+    if(r == 0) {
+      c->hungup = 1;
+    }
+    return r > 0;
+  }
+  return c->inpos < c->in.size();
+}
+
+static int conn_connected(int n) {
+  return conns[n].hungup == 0;
+}
+
+static void conn_stop(int n) {
+  conn_t *c = &conns[n];
+  if(c->fd >= 0) {
+    close(c->fd);
+    c->fd = -1;
+  }
+  c->hungup = 1;
+}
+
+template<int N> struct slot {
+  static int write(const unsigned char *buf, int len) { return conn_write(N, buf, len); }
+  static int write_P(const char *buf, int len) { return conn_write(N, (const unsigned char *)buf, len); }
+  static int available(void) { return conn_available(N); }
+  static int connected(void) { return conn_connected(N); }
+  static void stop(void) { conn_stop(N); }
+  static int read(uint8_t *buf, int size) { return conn_read(N, buf, size); }
+};
+
+template<size_t... I> static void init_slots(std::index_sequence<I...>) {
+  ((wifi[I] = WiFiClient{ &slot<I>::write, &slot<I>::write_P, &slot<I>::available,
+                          &slot<I>::connected, &slot<I>::stop, &slot<I>::read }), ...);
+}
+
+/*
+ * Hand a new connection to a free client slot, the same way webserver_loop()
+ * does after sync_server.accept() on the device.
+ */
+static int attach(int fd, const std::string &in, size_t chunk, uint8_t capture) {
+  for(int i = 0; i < WEBSERVER_MAX_CLIENTS; i++) {
+    if(clients[i].data.step == 0) {
+      conn_t *c = &conns[i];
+      c->fd = fd;
+      c->in = in;
+      c->inpos = 0;
+      c->chunk = chunk;
+      c->hungup = 0;
+      c->capture = capture;
+      c->out.clear();
+      c->outbytes = 0;
+      c->writes = 0;
+
+      webserver_reset_client(&clients[i].data);
+      clients[i].data.client = &wifi[i];
+      clients[i].data.async = 0;
+      clients[i].data.lastseen = millis();
+      clients[i].data.step = WEBSERVER_CLIENT_CONNECTING;
+      return i;
+    }
+  }
+  return -1;
+}
+
+static uint8_t busy(void) {
+  for(int i = 0; i < WEBSERVER_MAX_CLIENTS; i++) {
+    if(clients[i].data.step != 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Run the webserver until every replay connection is closed. A replay peer
+ * that has sent everything and gets no further response within a few passes
+ * hangs up, which is what a real client does on a stalled request. Returns
+ * the number of loop passes, or -1 if a slot never closed.
+ */
+static int pump(int max_passes) {
+  int passes = 0;
+  uint64_t lastout[WEBSERVER_MAX_CLIENTS] = { 0 };
+  int idle[WEBSERVER_MAX_CLIENTS] = { 0 };
+
+  while(busy()) {
+    webserver_loop();
+    if(++passes > max_passes) {
+      return -1;
+    }
+    for(int i = 0; i < WEBSERVER_MAX_CLIENTS; i++) {
+      conn_t *c = &conns[i];
+      if(clients[i].data.step == 0 || c->fd >= 0) {
+        continue;
+      }
+      if(c->inpos == c->in.size() && c->outbytes == lastout[i]) {
+        if(++idle[i] > 4) {
+          c->hungup = 1;
+        }
+      } else {
+        idle[i] = 0;
+      }
+      lastout[i] = c->outbytes;
+    }
+  }
+  return passes;
+}
+
+/*
+ * Request callback
+ */
+#define NUMBER_OF_TOPICS 140
+
+static struct {
+  uint64_t upload_bytes;
+  uint64_t ws_text;
+  uint64_t responses;
+} stats;
+
+static int json_output(struct webserver_t *client) {
+  if(client->content == 0) {
+    webserver_send(client, 200, (char *)"application/json", 0);
+    webserver_send_content_P(client, PSTR("{\"heatpump\":["), 13);
+  } else if((client->content - 1) < NUMBER_OF_TOPICS) {
+    uint8_t maxTopics = client->content + 4;
+    for(uint8_t topic = client->content - 1; topic < NUMBER_OF_TOPICS && topic < maxTopics; topic++) {
+      char str[32];
+      webserver_send_content_P(client, PSTR("{\"Topic\":\"TOP"), 13);
+      snprintf(str, sizeof(str), "%d", topic);
+      webserver_send_content(client, str, strlen(str));
+      webserver_send_content_P(client, PSTR("\",\"Name\":\""), 10);
+      snprintf(str, sizeof(str), "Synthetic_Topic_%d", topic);
+      webserver_send_content(client, str, strlen(str));
+      webserver_send_content_P(client, PSTR("\",\"Value\":"), 10);
+      snprintf(str, sizeof(str), "%d", (topic * 7) % 61 - 10);
+      webserver_send_content(client, str, strlen(str));
+      webserver_send_content_P(client, PSTR(",\"Description\":\"value\"}"), 23);
+      if(topic < NUMBER_OF_TOPICS - 1) {
+        webserver_send_content_P(client, PSTR(","), 1);
+      }
+    }
+    client->content = maxTopics;
+  } else if((client->content - 1) == NUMBER_OF_TOPICS) {
+    webserver_send_content_P(client, PSTR("]}"), 2);
+  }
+  return 0;
+}
+
+static int8_t harness_cb(struct webserver_t *client, void *dat) {
+  switch(client->step) {
+    case WEBSERVER_CLIENT_REQUEST_METHOD: {
+      if(strcmp((char *)dat, "POST") == 0) {
+        client->route = 110;
+      }
+      return 0;
+    } break;
+    case WEBSERVER_CLIENT_REQUEST_URI: {
+      if(strcmp((char *)dat, "/json") == 0) {
+        client->route = 20;
+      } else if(strcmp((char *)dat, "/ws") == 0) {
+        client->route = 30;
+      } else if(client->route == 110) {
+        if(strcmp((char *)dat, "/firmware") == 0) {
+          client->route = 150;
+        } else if(strcmp((char *)dat, "/savesettings") != 0) {
+          return -1;
+        }
+      } else {
+        client->route = 0;
+      }
+      return 0;
+    } break;
+    case WEBSERVER_CLIENT_ARGS: {
+      struct arguments_t *args = (struct arguments_t *)dat;
+      if(client->route == 150 && strcmp((char *)args->name, "firmware") == 0) {
+        stats.upload_bytes += args->len;
+      }
+      return 0;
+    } break;
+    case WEBSERVER_CLIENT_HEADER: {
+      return 0;
+    } break;
+    case WEBSERVER_CLIENT_WEBSOCKET_TEXT: {
+      stats.ws_text++;
+      return 0;
+    } break;
+    case WEBSERVER_CLIENT_WRITE: {
+      switch(client->route) {
+        case 20: {
+          return json_output(client);
+        } break;
+        case 110:
+        case 150: {
+          if(client->content == 0) {
+            webserver_send(client, 200, (char *)"text/plain", 2);
+            webserver_send_content_P(client, PSTR("OK"), 2);
+          }
+          return 0;
+        } break;
+        default: {
+          if(client->content == 0) {
+            webserver_send(client, 404, (char *)"text/plain", 9);
+            webserver_send_content_P(client, PSTR("Not Found"), 9);
+          }
+          return 0;
+        } break;
+      }
+    } break;
+    case WEBSERVER_CLIENT_CREATE_HEADER: {
+      return 0;
+    } break;
+    case WEBSERVER_CLIENT_CLOSE: {
+      stats.responses++;
+      return 0;
+    } break;
+  }
+  return 0;
+}
+
+/*
+ * Request builders
+ */
+static std::string json_request(void) {
+  return "GET /json HTTP/1.1\r\nHost: heishamon.local\r\nUser-Agent: harness\r\nAccept: */*\r\n\r\n";
+}
+
+static std::string websocket_request(void) {
+  return "GET /ws HTTP/1.1\r\nHost: heishamon.local\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+         "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n";
+}
+
+static std::string websocket_frame(uint8_t opcode, const std::string &payload) {
+  static const uint8_t mask[4] = { 0x12, 0x34, 0x56, 0x78 };
+  std::string f;
+  f += (char)(0x80 | opcode);
+  if(payload.size() <= 125) {
+    f += (char)(0x80 | payload.size());
+  } else {
+    f += (char)(0x80 | 126);
+    f += (char)(payload.size() >> 8);
+    f += (char)(payload.size() & 0xff);
+  }
+  f.append((const char *)mask, 4);
+  for(size_t i = 0; i < payload.size(); i++) {
+    f += (char)(payload[i] ^ mask[i % 4]);
+  }
+  return f;
+}
+
+static std::string upload_request(size_t size) {
+  const char *boundary = "----HarnessBoundary7MA4YWxkTrZu0gW";
+  std::string body;
+  body += "--"; body += boundary; body += "\r\n";
+  body += "Content-Disposition: form-data; name=\"md5\"\r\n\r\n";
+  body += "0123456789abcdef0123456789abcdef\r\n";
+  body += "--"; body += boundary; body += "\r\n";
+  body += "Content-Disposition: form-data; name=\"firmware\"; filename=\"HeishaMon.bin\"\r\n";
+  body += "Content-Type: application/octet-stream\r\n\r\n";
+  uint32_t x = 0x12345678;
+  for(size_t i = 0; i < size; i++) {
+    x = x * 1103515245 + 12345;
+    body += (char)(x >> 16);
+  }
+  body += "\r\n--"; body += boundary; body += "--\r\n";
+
+  std::string req = "POST /firmware HTTP/1.1\r\nHost: heishamon.local\r\n";
+  req += "Content-Type: multipart/form-data; boundary="; req += boundary; req += "\r\n";
+  req += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+  return req + body;
+}
+
+static std::string form_request(void) {
+  std::string body = "wifi_hostname=HeishaMon&mqtt_server=192.168.1.2&mqtt_port=1883&waitTime=5&use_s0=enabled";
+  return "POST /savesettings HTTP/1.1\r\nHost: heishamon.local\r\n"
+         "Content-Type: application/x-www-form-urlencoded\r\n"
+         "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}
+
+/*
+ * bench
+ */
+static void print_result(const char *name, uint64_t n, const char *unit, uint64_t us,
+                         uint64_t wire, uint64_t writes, int clients_used) {
+  double secs = us / 1e6;
+  printf("%-10s %8llu %-5s %10.0f %s/s  wire %8.0f B/%s  writes %6.1f/%s  "
+         "alloc %8.0f B/%s in %5.1f calls  peak heap %6zu B (%zu B/client + %zu B client struct)\n",
+         name, (unsigned long long)n, unit, n / secs, unit,
+         (double)wire / n, unit, (double)writes / n, unit,
+         (double)heap.bytes / n, unit, (double)heap.calls / n,
+         heap.peak - heap.base, (heap.peak - heap.base) / (clients_used > 0 ? clients_used : 1), sizeof(webserver_t));
+}
+
+/*
+ * Collect and clear the output counters of all slots
+ */
+static uint64_t total_out(uint64_t *writes) {
+  uint64_t out = 0;
+  *writes = 0;
+  for(int i = 0; i < WEBSERVER_MAX_CLIENTS; i++) {
+    out += conns[i].outbytes;
+    *writes += conns[i].writes;
+    conns[i].outbytes = 0;
+    conns[i].writes = 0;
+  }
+  return out;
+}
+
+static int bench_json(int requests, size_t chunk) {
+  std::string req = json_request();
+  uint64_t wire = 0, writes = 0, w = 0;
+  heap_reset_counters();
+  uint64_t t = now_us();
+  for(int done = 0; done < requests; ) {
+    int n = 0;
+    for(int i = 0; i < WEBSERVER_MAX_CLIENTS && done + n < requests; i++, n++) {
+      attach(-1, req, chunk, 0);
+    }
+    if(pump(1000000) < 0) {
+      fprintf(stderr, "json: client did not finish\n");
+      return -1;
+    }
+    wire += total_out(&w);
+    writes += w;
+    done += n;
+  }
+  print_result("json", requests, "req", now_us() - t, wire, writes, WEBSERVER_MAX_CLIENTS);
+  return 0;
+}
+
+static int bench_websocket(int broadcasts, size_t msglen) {
+  std::string msg(msglen, 'x');
+  for(int i = 0; i < WEBSERVER_MAX_CLIENTS; i++) {
+    attach(-1, websocket_request(), WEBSERVER_READ_SIZE, 0);
+  }
+  for(int pass = 0; pass < 100; pass++) {
+    webserver_loop();
+  }
+  for(int i = 0; i < WEBSERVER_MAX_CLIENTS; i++) {
+    if(clients[i].data.is_websocket == 0 || clients[i].data.step != WEBSERVER_CLIENT_WEBSOCKET) {
+      fprintf(stderr, "websocket: handshake failed on slot %d\n", i);
+      return -1;
+    }
+    conns[i].outbytes = 0;
+    conns[i].writes = 0;
+  }
+
+  uint64_t writes = 0;
+  heap_reset_counters();
+  uint64_t t = now_us();
+  for(int b = 0; b < broadcasts; b++) {
+    websocket_write_all((char *)msg.c_str(), msg.size());
+    uint8_t sending = 1;
+    while(sending) {
+      webserver_loop();
+      sending = 0;
+      for(int i = 0; i < WEBSERVER_MAX_CLIENTS; i++) {
+        if(clients[i].data.step == WEBSERVER_CLIENT_SENDING) {
+          sending = 1;
+        }
+      }
+    }
+  }
+  uint64_t us = now_us() - t;
+  uint64_t wire = total_out(&writes);
+  print_result("websocket", broadcasts, "bcast", us, wire, writes, WEBSERVER_MAX_CLIENTS);
+
+  for(int i = 0; i < WEBSERVER_MAX_CLIENTS; i++) {
+    conns[i].hungup = 1;
+  }
+  pump(1000);
+  total_out(&writes);
+  return 0;
+}
+
+static int bench_upload(int uploads, size_t size, size_t chunk) {
+  std::string req = upload_request(size);
+  uint64_t wire = 0, writes = 0, w = 0;
+  heap_reset_counters();
+  uint64_t t = now_us();
+  for(int u = 0; u < uploads; u++) {
+    stats.upload_bytes = 0;
+    attach(-1, req, chunk, 0);
+    if(pump(10000000) < 0) {
+      fprintf(stderr, "upload: client did not finish\n");
+      return -1;
+    }
+    if(stats.upload_bytes != size) {
+      fprintf(stderr, "upload: received %llu of %zu firmware bytes\n",
+              (unsigned long long)stats.upload_bytes, size);
+      return -1;
+    }
+    wire += total_out(&w);
+    writes += w;
+  }
+  uint64_t us = now_us() - t;
+  print_result("upload", uploads, "req", us, wire, writes, 1);
+  printf("%-10s %8.2f MB/s firmware payload in %zu byte segments\n", "",
+         (double)size * uploads / us, chunk);
+  return 0;
+}
+
+/*
+ * fuzz
+ */
+static uint32_t rnd_state = 1;
+
+static uint32_t rnd(void) {
+  rnd_state ^= rnd_state << 13;
+  rnd_state ^= rnd_state >> 17;
+  rnd_state ^= rnd_state << 5;
+  return rnd_state;
+}
+
+static std::string mutate(std::string s) {
+  int n = 1 + rnd() % 4;
+  for(int m = 0; m < n && s.size() > 0; m++) {
+    size_t pos = rnd() % s.size();
+    switch(rnd() % 7) {
+      case 0: {
+        s[pos] ^= 1 << (rnd() % 8);
+      } break;
+      case 1: {
+        s[pos] = rnd();
+      } break;
+      case 2: {
+        std::string ins;
+        size_t len = 1 + rnd() % 64;
+        for(size_t i = 0; i < len; i++) {
+          ins += (char)rnd();
+        }
+        s.insert(pos, ins);
+      } break;
+      case 3: {
+        s.erase(pos, 1 + rnd() % 32);
+      } break;
+      case 4: {
+        size_t len = 1 + rnd() % 256;
+        s.insert(pos, s.substr(pos, len));
+      } break;
+      case 5: {
+        s.resize(pos);
+      } break;
+      case 6: {
+        static const char *tokens[] = {
+          "\r\n", "\r\n\r\n", ": ", "=", "&", "%", "%2", "--", "boundary=",
+          "Content-Length: 4294967295", "Content-Length: -1", "Content-Length: 0",
+          "Sec-WebSocket-Key: ", "Content-Type: multipart/form-data",
+          "Content-Disposition: form-data; name=\"", "\x81\xfe\xff\xff", "\x89\x80"
+        };
+        s.insert(pos, tokens[rnd() % (sizeof(tokens) / sizeof(tokens[0]))]);
+      } break;
+    }
+  }
+  return s;
+}
+
+/*
+ * Write the inputs of the current iteration to fuzz-<slot>-<chunk>.bin so
+ * a failure can be reproduced with the replay command
+ */
+static void fuzz_save(void) {
+  for(int i = 0; i < WEBSERVER_MAX_CLIENTS; i++) {
+    if(conns[i].in.size() == 0) {
+      continue;
+    }
+    char name[64];
+    snprintf(name, sizeof(name), "fuzz-%d-%zu.bin", i, conns[i].chunk);
+    FILE *fp = fopen(name, "wb");
+    if(fp != NULL) {
+      fwrite(conns[i].in.data(), 1, conns[i].in.size(), fp);
+      fclose(fp);
+      fprintf(stderr, "fuzz: saved %s\n", name);
+    }
+  }
+}
+
+static void fuzz_timeout(int sig) {
+  fprintf(stderr, "fuzz: webserver_loop() did not return\n");
+  fuzz_save();
+  _exit(4);
+}
+
+static int fuzz(int iterations, uint32_t seed) {
+  std::string seeds[] = {
+    json_request(),
+    form_request(),
+    upload_request(3000),
+    websocket_request() + websocket_frame(0x1, "{\"cmd\":\"hello\"}") +
+      websocket_frame(0x9, "") + websocket_frame(0x1, std::string(300, 'a')) + websocket_frame(0x8, ""),
+  };
+  rnd_state = seed != 0 ? seed : 1;
+  signal(SIGALRM, fuzz_timeout);
+
+  for(int it = 0; it < iterations; it++) {
+    int n = 1 + rnd() % WEBSERVER_MAX_CLIENTS;
+    for(int i = 0; i < WEBSERVER_MAX_CLIENTS; i++) {
+      conns[i].in.clear();
+    }
+    for(int i = 0; i < n; i++) {
+      std::string in = mutate(seeds[rnd() % (sizeof(seeds) / sizeof(seeds[0]))]);
+      attach(-1, in, 1 + rnd() % (WEBSERVER_READ_SIZE), 0);
+    }
+    alarm(5);
+    if(pump(200000) < 0) {
+      fprintf(stderr, "fuzz: iteration %d (seed %u) left a client open\n", it, seed);
+      fuzz_save();
+      return -1;
+    }
+    alarm(0);
+    if(heap.cur != heap.base) {
+      fprintf(stderr, "fuzz: iteration %d (seed %u) leaked %zu heap bytes\n", it, seed, heap.cur - heap.base);
+      fuzz_save();
+      return -1;
+    }
+  }
+  printf("fuzz: %d iterations, %llu responses, seed %u\n", iterations,
+         (unsigned long long)stats.responses, seed);
+  return 0;
+}
+
+/*
+ * replay / serve
+ */
+static int replay(const char *file, size_t chunk) {
+  FILE *fp = fopen(file, "rb");
+  if(fp == NULL) {
+    perror(file);
+    return -1;
+  }
+  std::string in;
+  char buf[4096];
+  size_t n = 0;
+  while((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+    in.append(buf, n);
+  }
+  fclose(fp);
+
+  int i = attach(-1, in, chunk, 1);
+  if(pump(10000000) < 0) {
+    fprintf(stderr, "replay: client did not finish\n");
+    return -1;
+  }
+  fwrite(conns[i].out.data(), 1, conns[i].out.size(), stdout);
+  return 0;
+}
+
+static volatile sig_atomic_t running = 1;
+
+static void stop_serving(int sig) {
+  running = 0;
+}
+
+static int serve(int port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  int one = 1;
+  struct sockaddr_in addr;
+
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, WEBSERVER_MAX_CLIENTS) < 0) {
+    perror("bind");
+    return -1;
+  }
+  fcntl(fd, F_SETFL, O_NONBLOCK);
+  signal(SIGINT, stop_serving);
+  printf("serving on port %d: /json, /ws (broadcast every second), POST /firmware\n", port);
+
+  unsigned long lastbroadcast = 0;
+  uint64_t t = now_us();
+  heap_reset_counters();
+  while(running) {
+    int c = accept(fd, NULL, NULL);
+    if(c >= 0) {
+      setsockopt(c, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      if(attach(c, "", 0, 0) < 0) {
+        close(c);
+      }
+    }
+    webserver_loop();
+    if(millis() - lastbroadcast > 1000) {
+      char msg[64];
+      int len = snprintf(msg, sizeof(msg), "{\"uptime\":%lu}", millis() / 1000);
+      websocket_write_all(msg, len);
+      lastbroadcast = millis();
+    }
+    if(!busy()) {
+      usleep(1000);
+    }
+  }
+  uint64_t us = now_us() - t;
+  printf("\n%llu responses in %.1fs, %llu firmware bytes, %llu websocket messages, peak heap %zu B\n",
+         (unsigned long long)stats.responses, us / 1e6, (unsigned long long)stats.upload_bytes,
+         (unsigned long long)stats.ws_text, heap.peak - heap.base);
+  close(fd);
+  return 0;
+}
+
+static void usage(const char *name) {
+  fprintf(stderr,
+    "usage: %s bench [json|websocket|upload|all] [count]\n"
+    "       %s fuzz [iterations] [seed]\n"
+    "       %s replay <request-file> [chunk]\n"
+    "       %s serve [port]\n", name, name, name, name);
+}
+
+int main(int argc, char **argv) {
+  start_us = now_us() - 1000;
+  init_slots(std::make_index_sequence<WEBSERVER_MAX_CLIENTS>{});
+  webserver_start(80, &harness_cb, 0);
+  /*
+   * The shared read buffer is allocated once by webserver_start(),
+   * everything above it is per client
+   */
+  heap.base = heap.cur;
+
+  if(argc < 2) {
+    usage(argv[0]);
+    return 1;
+  }
+  if(strcmp(argv[1], "bench") == 0) {
+    const char *what = argc > 2 ? argv[2] : "all";
+    int count = argc > 3 ? atoi(argv[3]) : 0;
+    int all = strcmp(what, "all") == 0;
+    printf("WEBSERVER_BUFFER_SIZE %d, WEBSERVER_MAX_CLIENTS %d, WEBSERVER_MAX_SENDLIST %d\n",
+           WEBSERVER_BUFFER_SIZE, WEBSERVER_MAX_CLIENTS, WEBSERVER_MAX_SENDLIST);
+    if((all || strcmp(what, "json") == 0) && bench_json(count > 0 ? count : 2000, MTU_SIZE) != 0) {
+      return 3;
+    }
+    if((all || strcmp(what, "websocket") == 0) && bench_websocket(count > 0 ? count : 20000, 256) != 0) {
+      return 3;
+    }
+    if((all || strcmp(what, "upload") == 0) && bench_upload(count > 0 ? count : 20, 512 * 1024, MTU_SIZE) != 0) {
+      return 3;
+    }
+    return 0;
+  } else if(strcmp(argv[1], "fuzz") == 0) {
+    return fuzz(argc > 2 ? atoi(argv[2]) : 10000, argc > 3 ? strtoul(argv[3], NULL, 10) : 1) == 0 ? 0 : 3;
+  } else if(strcmp(argv[1], "replay") == 0 && argc > 2) {
+    return replay(argv[2], argc > 3 ? atoi(argv[3]) : MTU_SIZE) == 0 ? 0 : 3;
+  } else if(strcmp(argv[1], "serve") == 0) {
+    return serve(argc > 2 ? atoi(argv[2]) : 8080) == 0 ? 0 : 3;
+  }
+  usage(argv[0]);
+  return 1;
+}
@@ -0,0 +1,31 @@
+/*
+ * Host shim for the __linux__ branch of src/common/webserver.cpp.
+ * Maps the Arduino PROGMEM helpers onto libc and declares the few lwIP
+ * functions the async code path references. The harness only drives the
+ * sync (WiFiClient) path, so the lwIP stubs are never expected to run.
+ */
+#ifndef _WEBSERVER_HARNESS_UNITTEST_H_
+#define _WEBSERVER_HARNESS_UNITTEST_H_
+
+#include <stdint.h>
+
+#define PSTR(x) (x)
+#define memcmp_P memcmp
+#define memcpy_P memcpy
+#define snprintf_P snprintf
+#define strncpy_P strncpy
+#define strstr_P strstr
+
+#define TCP_WRITE_FLAG_COPY 0x01
+#define TCP_WRITE_FLAG_MORE 0x02
+
+unsigned long millis(void);
+
+int tcp_write(tcp_pcb *pcb, const void *buf, uint16_t len, uint8_t flags);
+uint16_t tcp_write_P(tcp_pcb *pcb, PGM_P buf, uint16_t len, uint8_t flags);
+int tcp_output(tcp_pcb *pcb);
+uint16_t tcp_sndbuf(tcp_pcb *pcb);
+void tcp_recved(tcp_pcb *pcb, uint16_t len);
+void pbuf_free(struct pbuf *p);
+
+#endif
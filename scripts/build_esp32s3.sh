@@ -1,4 +1,5 @@
 #!/usr/bin/env bash
+python3 "$(dirname "$0")/build_webui.py" || exit 1
 cd HeishaMon
 arduino-cli compile --output-dir . \
   --fqbn=esp32:esp32:esp32s3:CDCOnBoot=cdc,PSRAM=enabled,PartitionScheme=min_spiffs \
@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+# Generate HeishaMon/webassets.h from the static web UI files in HeishaMon/webui.
+# Every file is gzipped and embedded as a PROGMEM blob which the webserver
+# serves from /static/<file> with Content-Encoding: gzip, an ETag and a long
+# lived Cache-Control. The <link>/<script> tags the pages use to reference the
+# assets carry the ETag as version so a firmware update busts the browser cache.
+#
+# Run this after changing anything in HeishaMon/webui (the build scripts and the
+# CI workflow do it before compiling). The output is deterministic.
+import gzip
+import hashlib
+import os
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'HeishaMon')
+WEBUI = os.path.join(ROOT, 'webui')
+OUTPUT = os.path.join(ROOT, 'webassets.h')
+
+# (file in webui/, variable name of the reference tag used by htmlcode.h)
+ASSETS = [
+  ('heishamon.css',       'webCSS'),
+  ('menu.js',             'menuJS'),
+  ('websocket.js',        'websocketJS'),
+  ('select.js',           'selectJS'),
+  ('refresh.js',          'refreshJS'),
+  ('consoletoggles.js',   'consoleTogglesJS'),
+  ('settings.js',         'settingsJS'),
+  ('changewifissid.js',   'changewifissidJS'),
+  ('populatescanwifi.js', 'populatescanwifiJS'),
+  ('rules.js',            'rulesJS'),
+]
+
+MIMETYPES = {
+  '.css': 'text/css',
+  '.js': 'application/javascript',
+}
+
+# must match the array sizes of webAssetStruct below
+MAX_PATH = 32
+MAX_MIMETYPE = 24
+
+
+def c_array(data):
+  lines = []
+  for i in range(0, len(data), 16):
+    lines.append('  ' + ','.join('0x%02x' % b for b in data[i:i + 16]) + ',')
+  return '\n'.join(lines)
+
+
+def main():
+  out = []
+  out.append('// Generated by scripts/build_webui.py from the files in webui/. Do not edit.')
+  out.append('#ifndef _WEBASSETS_H_')
+  out.append('#define _WEBASSETS_H_')
+  out.append('')
+  out.append('struct webAssetStruct {')
+  out.append('  char path[%d];' % MAX_PATH)
+  out.append('  char mimetype[%d];' % MAX_MIMETYPE)
+  out.append('  char etag[9];')
+  out.append('  const uint8_t *data;')
+  out.append('  uint16_t len;')
+  out.append('};')
+  out.append('')
+
+  table = []
+  total_raw = 0
+  total_gz = 0
+  for filename, tagname in ASSETS:
+    raw = open(os.path.join(WEBUI, filename), 'rb').read()
+    gz = gzip.compress(raw, compresslevel=9, mtime=0)
+    if len(gz) > 32767:
+      sys.exit('%s: gzipped size %d does not fit a webserver sendlist entry' % (filename, len(gz)))
+    etag = hashlib.sha1(raw).hexdigest()[:8]
+    path = '/static/' + filename
+    mimetype = MIMETYPES[os.path.splitext(filename)[1]]
+    if len(path) >= MAX_PATH:
+      sys.exit('%s: path too long' % filename)
+    blob = 'webasset_' + filename.replace('.', '_')
+    total_raw += len(raw)
+    total_gz += len(gz)
+
+    out.append('// %s: %d bytes, %d gzipped' % (filename, len(raw), len(gz)))
+    out.append('static const uint8_t %s[] FLASHPROG = {' % blob)
+    out.append(c_array(gz))
+    out.append('};')
+    if mimetype == 'text/css':
+      out.append('static const char %s[] FLASHPROG = "<link rel=\'stylesheet\' href=\'%s?v=%s\'>\\n";' % (tagname, path, etag))
+    else:
+      out.append('static const char %s[] FLASHPROG = "<script src=\'%s?v=%s\'></script>\\n";' % (tagname, path, etag))
+    out.append('')
+    table.append('  { "%s", "%s", "%s", %s, sizeof(%s) },' % (path, mimetype, etag, blob, blob))
+
+  out.append('static const webAssetStruct webAssets[] FLASHPROG = {')
+  out.extend(table)
+  out.append('};')
+  out.append('')
+  out.append('#define NUMBER_OF_WEBASSETS (sizeof(webAssets) / sizeof(webAssets[0]))')
+  out.append('')
+  out.append('#endif')
+  out.append('')
+
+  with open(OUTPUT, 'w') as f:
+    f.write('\n'.join(out))
+  print('webassets.h: %d assets, %d bytes, %d gzipped' % (len(ASSETS), total_raw, total_gz))
+
+
+if __name__ == '__main__':
+  main()